@@ -6,14 +6,14 @@
 #include <chrono>
 #include <iomanip>
 #include <sstream>
-#include <mutex>
+#include "ProfiledMutex.h"
 
 namespace tools
 {
     void ConsoleLogger::log(const std::string& message, LogLevel level)
     {
-        static std::mutex logMutex; // Mutex for thread safety
-        std::lock_guard<std::mutex> lock(logMutex); // Lock the mutex
+        static ProfiledMutex logMutex("ConsoleLogger::log"); // Mutex for thread safety
+        std::lock_guard<ProfiledMutex> lock(logMutex); // Lock the mutex
         if( level >= verbosityLevel )
         {
             std::string timestamp = getCurrentTime();
@@ -0,0 +1,134 @@
+#include "ProfiledMutex.h"
+#include <map>
+#include <memory>
+
+namespace tools
+{
+    namespace
+    {
+        /**
+         * @brief Counters of all lock names. Intentionally leaked so static mutexes can unlock during shutdown.
+         */
+        struct LockRegistry
+        {
+            std::mutex mutex;
+            std::map<std::string, std::unique_ptr<LockCounters>> counters;
+        };
+
+        LockRegistry& registry()
+        {
+            static LockRegistry* instance = new LockRegistry();
+            return *instance;
+        }
+
+        uint64_t toNanoseconds(std::chrono::steady_clock::duration duration)
+        {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+        }
+
+        void updateMax(std::atomic<uint64_t>& maximum, uint64_t value)
+        {
+            uint64_t current = maximum.load(std::memory_order_relaxed);
+            while( value > current && !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed) )
+            {
+            }
+        }
+
+        LockCounters& countersFor(const char* name)
+        {
+            LockRegistry& locks = registry();
+            std::lock_guard<std::mutex> guard(locks.mutex);
+            auto& counters = locks.counters[name];
+            if( !counters )
+            {
+                counters = std::make_unique<LockCounters>();
+            }
+            return *counters;
+        }
+    }
+
+    ProfiledMutex::ProfiledMutex(const char* name) : m_counters(countersFor(name))
+    {
+    }
+
+    void ProfiledMutex::lock()
+    {
+        if( m_mutex.try_lock() )
+        {
+            acquired(std::chrono::steady_clock::duration::zero(), false);
+            return;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        m_mutex.lock();
+        acquired(std::chrono::steady_clock::now() - start, true);
+    }
+
+    bool ProfiledMutex::try_lock()
+    {
+        if( !m_mutex.try_lock() )
+        {
+            return false;
+        }
+        acquired(std::chrono::steady_clock::duration::zero(), false);
+        return true;
+    }
+
+    void ProfiledMutex::unlock()
+    {
+        const uint64_t held = toNanoseconds(std::chrono::steady_clock::now() - m_acquiredAt);
+        m_counters.totalHoldNs.fetch_add(held, std::memory_order_relaxed);
+        updateMax(m_counters.maxHoldNs, held);
+        m_mutex.unlock();
+    }
+
+    void ProfiledMutex::acquired(std::chrono::steady_clock::duration waited, bool contended)
+    {
+        m_acquiredAt = std::chrono::steady_clock::now();
+        m_counters.acquisitions.fetch_add(1, std::memory_order_relaxed);
+        if( contended )
+        {
+            const uint64_t wait = toNanoseconds(waited);
+            m_counters.contentions.fetch_add(1, std::memory_order_relaxed);
+            m_counters.totalWaitNs.fetch_add(wait, std::memory_order_relaxed);
+            updateMax(m_counters.maxWaitNs, wait);
+        }
+    }
+
+    std::vector<LockStats> ProfiledMutex::snapshot()
+    {
+        LockRegistry& locks = registry();
+        std::lock_guard<std::mutex> guard(locks.mutex);
+
+        std::vector<LockStats> result;
+        result.reserve(locks.counters.size());
+        for( const auto& [name, counters] : locks.counters )
+        {
+            LockStats stats;
+            stats.name = name;
+            stats.acquisitions = counters->acquisitions.load(std::memory_order_relaxed);
+            stats.contentions = counters->contentions.load(std::memory_order_relaxed);
+            stats.totalWaitNs = counters->totalWaitNs.load(std::memory_order_relaxed);
+            stats.maxWaitNs = counters->maxWaitNs.load(std::memory_order_relaxed);
+            stats.totalHoldNs = counters->totalHoldNs.load(std::memory_order_relaxed);
+            stats.maxHoldNs = counters->maxHoldNs.load(std::memory_order_relaxed);
+            result.push_back(stats);
+        }
+        return result;
+    }
+
+    void ProfiledMutex::resetAll()
+    {
+        LockRegistry& locks = registry();
+        std::lock_guard<std::mutex> guard(locks.mutex);
+        for( auto& [name, counters] : locks.counters )
+        {
+            counters->acquisitions = 0;
+            counters->contentions = 0;
+            counters->totalWaitNs = 0;
+            counters->maxWaitNs = 0;
+            counters->totalHoldNs = 0;
+            counters->maxHoldNs = 0;
+        }
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * @file ProfiledMutex.h
+ * @brief Defines the ProfiledMutex class, a mutex that records how long threads wait for it and hold it.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace tools
+{
+    /**
+     * @brief Snapshot of the statistics of a named lock.
+     */
+    struct LockStats
+    {
+        std::string name;               /**< Name of the lock. */
+        uint64_t acquisitions = 0;      /**< Number of times the lock was taken. */
+        uint64_t contentions = 0;       /**< Number of acquisitions that had to wait for another thread. */
+        uint64_t totalWaitNs = 0;       /**< Total time spent waiting for the lock, in nanoseconds. */
+        uint64_t maxWaitNs = 0;         /**< Longest single wait, in nanoseconds. */
+        uint64_t totalHoldNs = 0;       /**< Total time the lock was held, in nanoseconds. */
+        uint64_t maxHoldNs = 0;         /**< Longest single hold, in nanoseconds. */
+    };
+
+    /**
+     * @brief Counters shared by all mutexes with the same name.
+     */
+    struct LockCounters
+    {
+        std::atomic<uint64_t> acquisitions{ 0 };
+        std::atomic<uint64_t> contentions{ 0 };
+        std::atomic<uint64_t> totalWaitNs{ 0 };
+        std::atomic<uint64_t> maxWaitNs{ 0 };
+        std::atomic<uint64_t> totalHoldNs{ 0 };
+        std::atomic<uint64_t> maxHoldNs{ 0 };
+    };
+
+    /**
+     * @brief A std::mutex replacement that profiles contention per named lock.
+     *
+     * Meets the Lockable requirements, so it works with std::lock_guard and std::unique_lock, and with
+     * std::condition_variable_any in place of std::condition_variable. A lock is first attempted without blocking;
+     * only acquisitions that fail it count as contended and are timed. Statistics are kept per name for the lifetime
+     * of the process, so instances created and destroyed repeatedly, such as per script run, add up under one entry.
+     */
+    class ProfiledMutex
+    {
+    public:
+        /**
+         * @brief Constructs a mutex reporting under the given name.
+         * @param name Name of the lock, shared by all instances guarding the same kind of data.
+         */
+        explicit ProfiledMutex(const char* name);
+
+        ProfiledMutex(const ProfiledMutex&) = delete;
+        ProfiledMutex& operator=(const ProfiledMutex&) = delete;
+
+        /**
+         * @brief Locks the mutex, timing the wait if another thread holds it.
+         */
+        void lock();
+
+        /**
+         * @brief Tries to lock the mutex without blocking.
+         * @return True if the mutex was locked, false otherwise.
+         */
+        bool try_lock();
+
+        /**
+         * @brief Unlocks the mutex and records how long it was held.
+         */
+        void unlock();
+
+        /**
+         * @brief Gets the statistics of all named locks, sorted by name.
+         * @return The statistics.
+         */
+        static std::vector<LockStats> snapshot();
+
+        /**
+         * @brief Clears the statistics of all named locks.
+         */
+        static void resetAll();
+
+    private:
+        /**
+         * @brief Records an acquisition and starts timing the hold.
+         * @param waited Time spent waiting for the lock.
+         * @param contended True if the lock was held by another thread.
+         */
+        void acquired(std::chrono::steady_clock::duration waited, bool contended);
+
+        std::mutex m_mutex; /**< The underlying mutex. */
+        LockCounters& m_counters; /**< Counters of the lock name. */
+        std::chrono::steady_clock::time_point m_acquiredAt; /**< When the current owner took the lock. */
+    };
+}
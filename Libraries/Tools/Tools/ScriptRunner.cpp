@@ -188,13 +188,13 @@ namespace tools
 
     void ScriptRunner::setOutputCallback(OutputCallback callback)
     {
-        std::lock_guard<std::mutex> lock(output_mutex);
+        std::lock_guard<ProfiledMutex> lock(output_mutex);
         output_callback = std::move(callback);
     }
 
     std::vector<std::string> ScriptRunner::getOutput()
     {
-        std::lock_guard<std::mutex> lock(output_mutex);
+        std::lock_guard<ProfiledMutex> lock(output_mutex);
         return output;
     }
 
@@ -217,7 +217,7 @@ namespace tools
                 {
                     buffer[read] = '\0';  // Null-terminate the buffer
                     {
-                        std::lock_guard<std::mutex> lock(output_mutex);
+                        std::lock_guard<ProfiledMutex> lock(output_mutex);
                         std::string outputbuffer(buffer);
                         output.push_back(outputbuffer);
                         if( output_callback )
@@ -242,7 +242,7 @@ namespace tools
         }
 
         {
-            std::lock_guard<std::mutex> lock(output_mutex);
+            std::lock_guard<ProfiledMutex> lock(output_mutex);
             output_thread_done = true;
         }
         cv.notify_all();
@@ -278,7 +278,7 @@ namespace tools
         }
         if( hChildStd_OUT_Rd != NULL )
         {
-            std::unique_lock<std::mutex> lock(output_mutex);
+            std::unique_lock<ProfiledMutex> lock(output_mutex);
             cv.wait(lock, [this] { return output_thread_done; });
             CloseHandle(hChildStd_OUT_Rd);
             hChildStd_OUT_Rd = NULL;
@@ -299,7 +299,7 @@ namespace tools
 
     void ScriptRunner::clearOutput()
     {
-        std::lock_guard<std::mutex> lock(output_mutex);
+        std::lock_guard<ProfiledMutex> lock(output_mutex);
         output.clear();
         if( output_callback )
         {
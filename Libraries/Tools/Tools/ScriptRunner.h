@@ -13,6 +13,7 @@
 #include <vector>
 #include <thread>
 #include <mutex>
+#include "ProfiledMutex.h"
 #include <atomic>
 #include <windows.h>
 #include <condition_variable>
@@ -98,8 +99,8 @@ namespace tools
         std::thread script_thread; ///< Thread for running the script.
         std::thread input_thread; ///< Thread for sending input to the script.
         std::thread output_thread; ///< Thread for fetching output from the script.
-        std::mutex output_mutex; ///< Mutex for protecting access to the output.
-        std::condition_variable cv; ///< Condition variable for synchronizing output handling.
+        ProfiledMutex output_mutex{ "ScriptRunner::output_mutex" }; ///< Mutex for protecting access to the output.
+        std::condition_variable_any cv; ///< Condition variable for synchronizing output handling.
         std::atomic<bool> script_running; ///< Flag indicating if a script is running.
         std::atomic<bool> fetch_output; ///< Flag indicating if output should be fetched.
         std::atomic<bool> stop_script_flag; ///< Flag indicating if the script should be stopped.
@@ -0,0 +1,349 @@
+#include "gtest/gtest.h"
+#include "Application/ApplicationDatabase.h"
+#include "Application/ApplicationSettings.h"
+#include "Application/JapaneseSqlFunctions.h"
+#include "Tools/Logger.h"
+#include <Libraries/SQLite3/sqlite3.h>
+#include <algorithm>
+#include <filesystem>
+#include <memory>
+
+using namespace tadaima;
+using namespace tadaima::application;
+
+class ApplicationDatabaseTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        removeFiles();
+        database = std::make_unique<ApplicationDatabase>(files, logger);
+    }
+
+    void TearDown() override
+    {
+        database.reset();
+        removeFiles();
+    }
+
+    void removeFiles()
+    {
+        std::filesystem::remove(files.deckPath);
+        std::filesystem::remove(files.progressPath);
+    }
+
+    // Reopens the files, for example after writing a deck of an older layout
+    void reopen(bool readOnlyDeck)
+    {
+        database.reset();
+        files.readOnlyDeck = readOnlyDeck;
+        database = std::make_unique<ApplicationDatabase>(files, logger);
+    }
+
+    // Runs SQL on a file outside of the tested connection
+    static bool execute(const std::string& path, const std::string& sql)
+    {
+        sqlite3* file = nullptr;
+        const bool executed = sqlite3_open(path.c_str(), &file) == SQLITE_OK && sqlite3_exec(file, sql.c_str(), 0, 0, 0) == SQLITE_OK;
+        sqlite3_close(file);
+        return executed;
+    }
+
+    // Counts the rows of a table in a file, -1 if the table is missing
+    static int countRows(const std::string& path, const std::string& table)
+    {
+        sqlite3* file = nullptr;
+        sqlite3_stmt* stmt = nullptr;
+        int count = -1;
+        if( sqlite3_open(path.c_str(), &file) == SQLITE_OK && sqlite3_prepare_v2(file, ("SELECT COUNT(*) FROM " + table + ";").c_str(), -1, &stmt, 0) == SQLITE_OK &&
+            sqlite3_step(stmt) == SQLITE_ROW )
+        {
+            count = sqlite3_column_int(stmt, 0);
+        }
+        sqlite3_finalize(stmt);
+        sqlite3_close(file);
+        return count;
+    }
+
+    // Writes a deck of the first release, which held the progress tables too and none of the later word columns
+    bool writeLegacyDeck()
+    {
+        return execute(files.deckPath,
+            "CREATE TABLE lessons (id INTEGER PRIMARY KEY AUTOINCREMENT, main_name TEXT NOT NULL, sub_name TEXT NOT NULL);"
+            "CREATE TABLE words (id INTEGER PRIMARY KEY AUTOINCREMENT, lesson_id INTEGER, kana TEXT NOT NULL, translation TEXT NOT NULL, romaji TEXT, example_sentence TEXT);"
+            "CREATE TABLE tags (id INTEGER PRIMARY KEY AUTOINCREMENT, word_id INTEGER, tag TEXT NOT NULL);"
+            "CREATE TABLE settings (key TEXT PRIMARY KEY, value TEXT NOT NULL);"
+            "CREATE TABLE reviews (id INTEGER PRIMARY KEY AUTOINCREMENT, word_id INTEGER NOT NULL, timestamp INTEGER NOT NULL, correct INTEGER NOT NULL);"
+            "CREATE TABLE memory_state (word_id INTEGER PRIMARY KEY, stability REAL NOT NULL, difficulty REAL NOT NULL, last_review INTEGER NOT NULL, "
+            "review_count INTEGER NOT NULL, lapses INTEGER NOT NULL);"
+            "INSERT INTO lessons (main_name, sub_name) VALUES ('Animals', 'Pets');"
+            "INSERT INTO words (lesson_id, kana, translation, romaji, example_sentence) VALUES (1, 'ねこ', 'cat', 'neko', 'ねこがいます。');"
+            "INSERT INTO tags (word_id, tag) VALUES (1, 'animal');"
+            "INSERT INTO settings (key, value) VALUES ('userName', 'Learner');"
+            "INSERT INTO reviews (word_id, timestamp, correct) VALUES (1, 1000, 0), (1, 2000, 1);"
+            "INSERT INTO memory_state VALUES (1, 2.5, 5.0, 2000, 2, 1);");
+    }
+
+    // Checks the content and progress of the legacy deck as the application reads it
+    void expectLegacyData()
+    {
+        const std::vector<Lesson> lessons = database->getAllLessons();
+        ASSERT_EQ(lessons.size(), 1u);
+        ASSERT_EQ(lessons[0].words.size(), 1u);
+        const Word& word = lessons[0].words[0];
+        EXPECT_EQ(word.kana, "ねこ");
+        EXPECT_EQ(word.tags, std::vector<std::string>{ "animal" });
+        EXPECT_TRUE(word.kanji.empty());
+        EXPECT_EQ(word.frequencyRank, 0);
+        EXPECT_EQ(database->findSimilarWords("ねこ", 0, 5).size(), 1u);
+
+        EXPECT_EQ(database->loadSettings().userName, "Learner");
+        EXPECT_EQ(database->getReviews().size(), 2u);
+        const review::MemoryState state = database->getMemoryState(word.id);
+        EXPECT_EQ(state.reviewCount, 2);
+        EXPECT_DOUBLE_EQ(state.stability, 2.5);
+    }
+
+    // Lesson words come in the order of the kana index, the tests compare them by ID
+    std::vector<Word> wordsInLesson(int lessonId) const
+    {
+        std::vector<Word> words = database->getWordsInLesson(lessonId);
+        std::sort(words.begin(), words.end(), [](const Word& left, const Word& right) { return left.id < right.id; });
+        return words;
+    }
+
+    int addReviewedWord(int lessonId, const std::string& kana, int64_t timestamp)
+    {
+        const int wordId = database->addWord(lessonId, Word{ 0, kana, "translation", "", "", {} });
+        database->addReview({ wordId, timestamp, false });
+
+        review::MemoryState state;
+        state.wordId = wordId;
+        state.stability = 1.0;
+        state.difficulty = 5.0;
+        state.lastReview = timestamp;
+        state.reviewCount = 1;
+        state.lapses = 1;
+        database->saveMemoryState(state);
+        return wordId;
+    }
+
+    tools::Logger logger;
+    DatabaseFiles files{ (std::filesystem::temp_directory_path() / "tadaima_test_deck.db").string(),
+        (std::filesystem::temp_directory_path() / "tadaima_test_progress.db").string() };
+    std::unique_ptr<ApplicationDatabase> database;
+};
+
+TEST_F(ApplicationDatabaseTest, DeletedLessonLeavesTheForecastInput)
+{
+    const int keptLesson = database->addLesson("Kept", "Lesson");
+    const int deletedLesson = database->addLesson("Deleted", "Lesson");
+    const int keptWord = addReviewedWord(keptLesson, "ねこ", 1000);
+    const int deletedWord = addReviewedWord(deletedLesson, "いぬ", 2000);
+    database->addTag(deletedWord, "leech");
+    database->addConfusion({ keptWord, deletedWord, 1, 2000 });
+
+    ASSERT_EQ(database->getMemoryStates().size(), 2u);
+    ASSERT_TRUE(database->deleteLesson(deletedLesson));
+
+    const auto states = database->getMemoryStates();
+    ASSERT_EQ(states.size(), 1u);
+    EXPECT_EQ(states[0].wordId, keptWord);
+
+    const auto reviews = database->getReviews();
+    ASSERT_EQ(reviews.size(), 1u);
+    EXPECT_EQ(reviews[0].wordId, keptWord);
+
+    EXPECT_TRUE(database->getConfusions().empty());
+    EXPECT_TRUE(database->getWords({ deletedWord }).empty());
+    EXPECT_EQ(database->getMemoryState(deletedWord).reviewCount, 0);
+}
+
+TEST_F(ApplicationDatabaseTest, CopiedWordsGetIdsAfterTheHighestUsedId)
+{
+    const int source = database->addLesson("Source", "Lesson");
+    const int target = database->addLesson("Target", "Lesson");
+    const int cat = database->addWord(source, Word{ 0, "ねこ", "cat", "neko", "", {} });
+    const int dog = database->addWord(source, Word{ 0, "いぬ", "dog", "inu", "", {} });
+    const int deleted = database->addWord(source, Word{ 0, "とり", "bird", "tori", "", {} });
+    database->addTag(cat, "animal");
+    database->addTag(cat, "pet");
+    ASSERT_TRUE(database->deleteWords({ deleted }));
+
+    // The ID of the deleted word is not reused, as AUTOINCREMENT would not reuse it either
+    ASSERT_TRUE(database->copyWords({ dog, cat }, target));
+    const std::vector<Word> copies = wordsInLesson(target);
+    ASSERT_EQ(copies.size(), 2u);
+    EXPECT_EQ(copies[0].id, deleted + 1); // Copies are numbered in the order of their originals
+    EXPECT_EQ(copies[0].kana, "ねこ");
+    EXPECT_EQ(copies[0].tags, (std::vector<std::string>{ "animal", "pet" }));
+    EXPECT_EQ(copies[1].id, deleted + 2);
+    EXPECT_EQ(copies[1].kana, "いぬ");
+    EXPECT_TRUE(copies[1].tags.empty());
+
+    EXPECT_EQ(database->getWordsInLesson(source).size(), 2u);
+    EXPECT_EQ(database->addWord(source, Word{ 0, "うま", "horse", "uma", "", {} }), deleted + 3);
+}
+
+TEST_F(ApplicationDatabaseTest, MovedWordsKeepTheirIdAndTags)
+{
+    const int source = database->addLesson("Source", "Lesson");
+    const int target = database->addLesson("Target", "Lesson");
+    const int cat = database->addWord(source, Word{ 0, "ねこ", "cat", "neko", "", {} });
+    const int dog = database->addWord(source, Word{ 0, "いぬ", "dog", "inu", "", {} });
+    const int water = database->addWord(target, Word{ 0, "みず", "water", "mizu", "", {} });
+    database->addTag(cat, "animal");
+
+    ASSERT_TRUE(database->moveWords({ cat, water }, target));
+
+    const std::vector<Word> moved = wordsInLesson(target);
+    ASSERT_EQ(moved.size(), 2u);
+    EXPECT_EQ(moved[0].id, cat);
+    EXPECT_EQ(moved[0].tags, std::vector<std::string>{ "animal" });
+    EXPECT_EQ(moved[1].id, water);
+
+    const std::vector<Word> kept = wordsInLesson(source);
+    ASSERT_EQ(kept.size(), 1u);
+    EXPECT_EQ(kept[0].id, dog);
+}
+
+TEST_F(ApplicationDatabaseTest, RetaggedWordsGainAndLoseTagsOnce)
+{
+    const int lesson = database->addLesson("Lesson", "Tags");
+    const int cat = database->addWord(lesson, Word{ 0, "ねこ", "cat", "neko", "", {} });
+    const int dog = database->addWord(lesson, Word{ 0, "いぬ", "dog", "inu", "", {} });
+    database->addTag(cat, "animal");
+    database->addTag(cat, "old");
+    database->addTag(dog, "old");
+
+    ASSERT_TRUE(database->retagWords({ cat, dog }, { "animal", "pet" }, { "old" }));
+
+    const std::vector<Word> words = database->getWords({ cat, dog });
+    ASSERT_EQ(words.size(), 2u);
+    EXPECT_EQ(words[0].tags, (std::vector<std::string>{ "animal", "pet" }));
+    EXPECT_EQ(words[1].tags, (std::vector<std::string>{ "animal", "pet" }));
+}
+
+TEST_F(ApplicationDatabaseTest, DeletedWordsLeaveNoProgress)
+{
+    const int lesson = database->addLesson("Lesson", "Delete");
+    const int kept = addReviewedWord(lesson, "ねこ", 1000);
+    const int deleted = addReviewedWord(lesson, "いぬ", 2000);
+    database->addTag(deleted, "animal");
+    database->addConfusion({ kept, deleted, 1, 2000 });
+
+    ASSERT_TRUE(database->deleteWords({ deleted }));
+
+    EXPECT_EQ(database->getWordsInLesson(lesson).size(), 1u);
+    EXPECT_EQ(database->getReviews().size(), 1u);
+    EXPECT_EQ(database->getMemoryStates().size(), 1u);
+    EXPECT_TRUE(database->getConfusions().empty());
+}
+
+TEST_F(ApplicationDatabaseTest, ProgressIsWrittenToItsOwnFile)
+{
+    const int lesson = database->addLesson("Lesson", "Progress");
+    addReviewedWord(lesson, "ねこ", 1000);
+    database.reset();
+
+    EXPECT_EQ(countRows(files.progressPath, "reviews"), 1);
+    EXPECT_EQ(countRows(files.progressPath, "memory_state"), 1);
+    EXPECT_EQ(countRows(files.deckPath, "words"), 1);
+    EXPECT_EQ(countRows(files.deckPath, "reviews"), -1);
+    EXPECT_EQ(countRows(files.progressPath, "words"), -1);
+}
+
+TEST_F(ApplicationDatabaseTest, LegacyDeckMovesItsProgressOut)
+{
+    database.reset();
+    removeFiles();
+    ASSERT_TRUE(writeLegacyDeck());
+    reopen(false);
+
+    expectLegacyData();
+    EXPECT_EQ(countRows(files.deckPath, "reviews"), -1);
+    EXPECT_EQ(countRows(files.deckPath, "memory_state"), -1);
+    EXPECT_EQ(countRows(files.progressPath, "reviews"), 2);
+
+    // Opening the converted files again keeps the data
+    reopen(false);
+    expectLegacyData();
+}
+
+TEST_F(ApplicationDatabaseTest, ReadOnlyLegacyDeckIsReadThroughDefaults)
+{
+    database.reset();
+    removeFiles();
+    ASSERT_TRUE(writeLegacyDeck());
+    reopen(true);
+
+    expectLegacyData();
+    EXPECT_EQ(database->addLesson("New", "Lesson"), -1);
+
+    // The deck is left untouched and its progress is copied only once
+    reopen(true);
+    expectLegacyData();
+    EXPECT_EQ(countRows(files.deckPath, "reviews"), 2);
+    EXPECT_EQ(countRows(files.progressPath, "reviews"), 2);
+}
+
+TEST_F(ApplicationDatabaseTest, SimilarWordsIgnoreScriptAndKeepGojuonOrder)
+{
+    const int lesson = database->addLesson("Lesson", "Similar");
+    const int deletedLesson = database->addLesson("Deleted", "Similar");
+    database->addWord(lesson, Word{ 0, "ネコ", "cat", "neko", "", {} });
+    database->addWord(lesson, Word{ 0, "ねこ", "cat", "neko", "", {} });
+    database->addWord(lesson, Word{ 0, "ねご", "typo", "nego", "", {} });
+    database->addWord(lesson, Word{ 0, "こねこ", "kitten", "koneko", "", {} });
+    database->addWord(lesson, Word{ 0, "いぬ", "dog", "inu", "", {} });
+    database->addWord(deletedLesson, Word{ 0, "ねこ", "orphan", "neko", "", {} });
+    ASSERT_TRUE(database->deleteLesson(deletedLesson));
+
+    // Equal distances are ordered hiragana first, and words starting with another kana are no candidates
+    std::vector<Word> words = database->findSimilarWords("ｎｅｋｏ", 1, 10);
+    ASSERT_EQ(words.size(), 3u);
+    EXPECT_EQ(words[0].kana, "ねこ");
+    EXPECT_EQ(words[1].kana, "ネコ");
+    EXPECT_EQ(words[2].kana, "ねご");
+
+    words = database->findSimilarWords("ネコ", 0, 10);
+    ASSERT_EQ(words.size(), 2u);
+    EXPECT_EQ(words[0].kana, "ねこ");
+    EXPECT_EQ(words[1].kana, "ネコ");
+
+    EXPECT_EQ(database->findSimilarWords("ねこ", 1, 1).size(), 1u);
+    EXPECT_TRUE(database->findSimilarWords("ぬこ", 0, 10).empty());
+}
+
+TEST(JapaneseSqlFunctionsTest, CollationsAndFunctionsRunInQueries)
+{
+    sqlite3* db = nullptr;
+    ASSERT_EQ(sqlite3_open(":memory:", &db), SQLITE_OK);
+    ASSERT_TRUE(registerJapaneseSqlFunctions(db));
+    ASSERT_EQ(sqlite3_exec(db, "CREATE TABLE words (kana TEXT);"
+        "INSERT INTO words VALUES ('カサ'), ('あめ'), ('ばし'), ('はし'), ('ｶｻ');", 0, 0, 0), SQLITE_OK);
+
+    auto column = [db](const char* sql)
+        {
+            std::vector<std::string> values;
+            sqlite3_stmt* stmt = nullptr;
+            if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
+            {
+                while( sqlite3_step(stmt) == SQLITE_ROW )
+                {
+                    const unsigned char* text = sqlite3_column_text(stmt, 0);
+                    values.push_back(text ? reinterpret_cast<const char*>(text) : "NULL");
+                }
+            }
+            sqlite3_finalize(stmt);
+            return values;
+        };
+
+    EXPECT_EQ(column("SELECT kana FROM words WHERE kana = 'かさ' COLLATE KANA;"), (std::vector<std::string>{ "カサ", "ｶｻ" }));
+    EXPECT_EQ(column("SELECT DISTINCT kana COLLATE KANA FROM words ORDER BY rowid;").size(), 4u);
+    EXPECT_EQ(column("SELECT kana FROM words WHERE kana NOT LIKE 'ｶ%' ORDER BY kana COLLATE GOJUON;"), (std::vector<std::string>{ "あめ", "カサ", "はし", "ばし" }));
+    EXPECT_EQ(column("SELECT normalize_japanese('ｶｻ') || ' ' || to_hiragana('カサ') || ' ' || to_romaji('カサ') || ' ' || edit_distance('かさ', 'かし');"),
+        std::vector<std::string>{ "かさ かさ kasa 1" });
+    EXPECT_EQ(column("SELECT to_romaji(NULL);"), std::vector<std::string>{ "NULL" });
+    sqlite3_close(db);
+}
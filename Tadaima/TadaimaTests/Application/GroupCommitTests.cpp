@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "Application/GroupCommit.h"
+#include "../LessonManager/MockDatabase.h"
+#include <stdexcept>
+
+using namespace tadaima;
+using namespace tadaima::application;
+using namespace std::chrono_literals;
+using ::testing::InSequence;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+class GroupCommitTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ON_CALL(database, beginTransaction()).WillByDefault(Return(true));
+        ON_CALL(database, commitTransaction()).WillByDefault(Return(true));
+    }
+
+    NiceMock<MockDatabase> database;
+    GroupCommit groupCommit{ database, GroupCommitOptions{ 50, 3 } };
+    GroupCommit::Clock::time_point start = GroupCommit::Clock::now();
+};
+
+TEST_F(GroupCommitTest, WaitsForTheWindowOfTheOldestMutation)
+{
+    std::vector<int> applied;
+    groupCommit.enqueue("first", [&] { applied.push_back(1); return true; }, start);
+    groupCommit.enqueue("second", [&] { applied.push_back(2); return true; }, start + 30ms);
+
+    EXPECT_EQ(groupCommit.timeUntilDue(start + 10ms), GroupCommit::Clock::duration(40ms));
+    EXPECT_TRUE(groupCommit.commitDue(start + 10ms).empty());
+    EXPECT_TRUE(applied.empty());
+
+    EXPECT_CALL(database, beginTransaction()).Times(3);
+    EXPECT_CALL(database, commitTransaction()).Times(3);
+    const auto results = groupCommit.commitDue(start + 50ms);
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].name, "first");
+    EXPECT_EQ(results[1].name, "second");
+    EXPECT_EQ(applied, (std::vector<int>{ 1, 2 }));
+    EXPECT_FALSE(groupCommit.timeUntilDue(start + 50ms).has_value());
+}
+
+TEST_F(GroupCommitTest, CommitsAtTheSizeLimitWithoutWaiting)
+{
+    EXPECT_FALSE(groupCommit.enqueue("1", [] { return true; }, start));
+    EXPECT_FALSE(groupCommit.enqueue("2", [] { return true; }, start));
+    EXPECT_TRUE(groupCommit.enqueue("3", [] { return true; }, start));
+    groupCommit.enqueue("4", [] { return true; }, start);
+
+    EXPECT_EQ(groupCommit.timeUntilDue(start), GroupCommit::Clock::duration::zero());
+    EXPECT_EQ(groupCommit.commitDue(start).size(), 3u);
+    EXPECT_EQ(groupCommit.pendingCount(), 1u);
+    EXPECT_EQ(groupCommit.commitAll().size(), 1u);
+}
+
+TEST_F(GroupCommitTest, RollsBackOnlyTheFailingMutation)
+{
+    groupCommit.enqueue("kept", [] { return true; }, start);
+    groupCommit.enqueue("failed", [] { return false; }, start);
+    groupCommit.enqueue("thrown", []() -> bool { throw std::runtime_error("broken"); }, start);
+
+    {
+        InSequence sequence;
+        EXPECT_CALL(database, beginTransaction());
+        EXPECT_CALL(database, beginTransaction());
+        EXPECT_CALL(database, commitTransaction());
+        EXPECT_CALL(database, beginTransaction());
+        EXPECT_CALL(database, rollbackTransaction());
+        EXPECT_CALL(database, beginTransaction());
+        EXPECT_CALL(database, rollbackTransaction());
+        EXPECT_CALL(database, commitTransaction());
+    }
+    const auto results = groupCommit.commitAll();
+
+    ASSERT_EQ(results.size(), 3u);
+    EXPECT_TRUE(results[0].success);
+    EXPECT_FALSE(results[1].success);
+    EXPECT_FALSE(results[2].success);
+}
+
+TEST_F(GroupCommitTest, ReportsEveryMutationAsFailedWhenTheGroupCannotCommit)
+{
+    groupCommit.enqueue("first", [] { return true; }, start);
+    groupCommit.enqueue("second", [] { return true; }, start);
+
+    EXPECT_CALL(database, commitTransaction()).WillOnce(Return(true)).WillOnce(Return(true)).WillOnce(Return(false));
+    EXPECT_CALL(database, rollbackTransaction()).Times(1);
+    const auto results = groupCommit.commitAll();
+
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_FALSE(results[0].success);
+    EXPECT_FALSE(results[1].success);
+}
+
+TEST_F(GroupCommitTest, ZeroWindowCommitsAtOnce)
+{
+    groupCommit.setOptions(GroupCommitOptions{ 0, 3 });
+    groupCommit.enqueue("now", [] { return true; }, start);
+
+    EXPECT_EQ(groupCommit.commitDue(start).size(), 1u);
+}
@@ -0,0 +1,156 @@
+#include "gtest/gtest.h"
+#include "Application/MaintenanceScheduler.h"
+#include <stdexcept>
+#include <thread>
+
+using namespace tadaima;
+using namespace tadaima::application;
+using namespace std::chrono_literals;
+
+class MaintenanceSchedulerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        scheduler.noteActivity(start);
+    }
+
+    MaintenanceTask task(const std::string& name, std::chrono::seconds interval, std::vector<MaintenanceStatus> statuses)
+    {
+        return { name, interval, [this, name, statuses, step = std::size_t{ 0 }](const MaintenanceBudget&) mutable
+            {
+                steps.push_back(name);
+                return statuses[std::min(step++, statuses.size() - 1)];
+            } };
+    }
+
+    static constexpr int64_t DAY = 24 * 60 * 60;
+
+    MaintenanceScheduler scheduler{ MaintenanceOptions{ 1000, 20, 0 } };
+    MaintenanceScheduler::Clock::time_point start = MaintenanceScheduler::Clock::now();
+    int64_t wallTime = 100 * DAY;
+    std::vector<std::string> steps;
+};
+
+TEST_F(MaintenanceSchedulerTest, WaitsUntilTheUserIsIdle)
+{
+    scheduler.addTask(task("analyze", 24h, { MaintenanceStatus::Done }), 0);
+
+    EXPECT_EQ(scheduler.timeUntilStep(start + 400ms, wallTime), MaintenanceScheduler::Clock::duration(600ms));
+    EXPECT_FALSE(scheduler.runStep(start + 400ms, wallTime));
+    EXPECT_TRUE(steps.empty());
+
+    const auto result = scheduler.runStep(start + 1s, wallTime);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result->task, "analyze");
+    EXPECT_EQ(result->status, MaintenanceStatus::Done);
+    EXPECT_EQ(scheduler.lastRun("analyze"), wallTime);
+}
+
+TEST_F(MaintenanceSchedulerTest, SkipsTasksUntilTheirIntervalPassed)
+{
+    scheduler.addTask(task("optimize", 24h, { MaintenanceStatus::Done }), wallTime - DAY / 2);
+    scheduler.addTask(task("vacuum", 24h, { MaintenanceStatus::Done }), wallTime - DAY);
+
+    EXPECT_EQ(scheduler.runStep(start + 1s, wallTime)->task, "vacuum");
+    EXPECT_FALSE(scheduler.timeUntilStep(start + 1s, wallTime));
+    EXPECT_FALSE(scheduler.runStep(start + 1s, wallTime));
+
+    EXPECT_EQ(scheduler.runStep(start + 1s, wallTime + DAY / 2)->task, "optimize");
+    EXPECT_EQ(steps, (std::vector<std::string>{ "vacuum", "optimize" }));
+}
+
+TEST_F(MaintenanceSchedulerTest, ContinuesTheStartedTaskFirst)
+{
+    scheduler.addTask(task("analyze", 24h, { MaintenanceStatus::Pending, MaintenanceStatus::Pending, MaintenanceStatus::Done }), 0);
+    scheduler.addTask(task("vacuum", 24h, { MaintenanceStatus::Done }), 0);
+
+    for( int step = 0; step < 4; ++step )
+    {
+        scheduler.runStep(start + 1s, wallTime);
+    }
+    EXPECT_EQ(steps, (std::vector<std::string>{ "analyze", "analyze", "analyze", "vacuum" }));
+}
+
+TEST_F(MaintenanceSchedulerTest, InterruptedTaskResumesWhenIdleAgain)
+{
+    scheduler.addTask(task("integrity check", 24h, { MaintenanceStatus::Interrupted, MaintenanceStatus::Done }), 0);
+    scheduler.addTask(task("vacuum", 24h, { MaintenanceStatus::Done }), 0);
+
+    EXPECT_EQ(scheduler.runStep(start + 1s, wallTime)->status, MaintenanceStatus::Interrupted);
+    EXPECT_EQ(scheduler.lastRun("integrity check"), 0);
+
+    scheduler.noteActivity(start + 2s);
+    EXPECT_FALSE(scheduler.runStep(start + 2500ms, wallTime));
+
+    const auto result = scheduler.runStep(start + 3s, wallTime);
+    EXPECT_EQ(result->task, "integrity check");
+    EXPECT_EQ(result->status, MaintenanceStatus::Done);
+}
+
+TEST_F(MaintenanceSchedulerTest, ActivityInterruptsTheRunningStep)
+{
+    std::atomic<bool> started = false;
+    // The step ignores its deadline, only the activity can end it
+    scheduler.addTask({ "vacuum", 24h, [&started](const MaintenanceBudget& budget)
+        {
+            started = true;
+            while( !(budget.interrupted && budget.interrupted->load()) )
+            {
+                std::this_thread::yield();
+            }
+            return MaintenanceStatus::Interrupted;
+        } }, 0);
+
+    std::thread user([&]
+        {
+            while( !started )
+            {
+                std::this_thread::yield();
+            }
+            scheduler.noteActivity();
+        });
+    const auto result = scheduler.runStep(MaintenanceScheduler::Clock::now() + 1s, wallTime);
+    user.join();
+
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result->status, MaintenanceStatus::Interrupted);
+}
+
+TEST_F(MaintenanceSchedulerTest, FailedTaskWaitsForItsInterval)
+{
+    scheduler.addTask({ "fts merge", 24h, [](const MaintenanceBudget&) -> MaintenanceStatus { throw std::runtime_error("disk I/O error"); } }, 0);
+
+    EXPECT_EQ(scheduler.runStep(start + 1s, wallTime)->status, MaintenanceStatus::Failed);
+    EXPECT_EQ(scheduler.lastRun("fts merge"), wallTime);
+    EXPECT_FALSE(scheduler.runStep(start + 2s, wallTime + 60));
+}
+
+TEST_F(MaintenanceSchedulerTest, TimedOutStepIsRepeatedWithALongerBudget)
+{
+    std::vector<std::chrono::milliseconds> budgets;
+    scheduler.addTask({ "integrity check", 24h, [&budgets, this](const MaintenanceBudget& budget)
+        {
+            budgets.push_back(std::chrono::round<std::chrono::milliseconds>(budget.deadline - (start + 1s)));
+            return budgets.size() < 3 ? MaintenanceStatus::TimedOut : MaintenanceStatus::Done;
+        } }, 0);
+
+    EXPECT_EQ(scheduler.runStep(start + 1s, wallTime)->status, MaintenanceStatus::TimedOut);
+    EXPECT_EQ(scheduler.lastRun("integrity check"), 0);
+    EXPECT_EQ(scheduler.runStep(start + 1s, wallTime)->status, MaintenanceStatus::TimedOut);
+    EXPECT_EQ(scheduler.runStep(start + 1s, wallTime)->status, MaintenanceStatus::Done);
+    EXPECT_EQ(scheduler.lastRun("integrity check"), wallTime);
+    EXPECT_EQ(budgets, (std::vector<std::chrono::milliseconds>{ 20ms, 40ms, 80ms }));
+}
+
+TEST_F(MaintenanceSchedulerTest, TaskFailsOnceTheLongestBudgetTimedOut)
+{
+    MaintenanceScheduler limited{ MaintenanceOptions{ 1000, 20, 0, 50 } };
+    limited.noteActivity(start);
+    limited.addTask({ "vacuum conversion", 24h, [](const MaintenanceBudget&) { return MaintenanceStatus::TimedOut; }, 30ms }, 0);
+
+    // 30 ms, then the longest budget of 50 ms
+    EXPECT_EQ(limited.runStep(start + 1s, wallTime)->status, MaintenanceStatus::TimedOut);
+    EXPECT_EQ(limited.runStep(start + 1s, wallTime)->status, MaintenanceStatus::Failed);
+    EXPECT_EQ(limited.lastRun("vacuum conversion"), wallTime);
+}
@@ -12,6 +12,7 @@ namespace tadaima
         {
         public:
             MOCK_METHOD(void, setEvent, (ApplicationEvent, const std::vector<Lesson>&), ());
+            MOCK_METHOD(void, noteUserActivity, (), ());
         };
     }
 }
@@ -12,6 +12,7 @@ namespace tadaima
         {
         public:
             MOCK_METHOD(void, addListener, (gui::widget::Type, std::function<void(const gui::widget::WidgetEvent*)>), ());
+            MOCK_METHOD(void, setActivityListener, (std::function<void()>), ());
             MOCK_METHOD(void, initializeWidget, (gui::widget::Type, const tools::DataPackage&), ());
         };
     }
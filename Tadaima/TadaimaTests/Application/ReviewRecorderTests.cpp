@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "Application/ReviewRecorder.h"
+#include "review/LeechDetector.h"
+#include "review/MemoryModel.h"
+#include "Tools/Logger.h"
+#include "../LessonManager/MockDatabase.h"
+
+using namespace tadaima;
+using namespace tadaima::application;
+using ::testing::_;
+using ::testing::NiceMock;
+using ::testing::Return;
+
+class ReviewRecorderTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ON_CALL(database, beginTransaction()).WillByDefault(Return(true));
+        ON_CALL(database, commitTransaction()).WillByDefault(Return(true));
+        ON_CALL(database, addReview(_)).WillByDefault(Return(true));
+        ON_CALL(database, addConfusion(_)).WillByDefault(Return(true));
+        ON_CALL(database, saveMemoryState(_)).WillByDefault(Return(true));
+    }
+
+    static review::ReviewRecord wrongAnswer(int wordId, int chosenWordId)
+    {
+        review::ReviewRecord record;
+        record.wordId = wordId;
+        record.timestamp = 1000;
+        record.correct = false;
+        record.chosenWordId = chosenWordId;
+        return record;
+    }
+
+    NiceMock<MockDatabase> database;
+    review::MemoryModel memoryModel;
+    review::LeechDetector leechDetector{ review::LeechOptions{ 1, 0 } };
+    tools::Logger logger;
+    ReviewRecorder recorder{ database, memoryModel, leechDetector, logger };
+};
+
+TEST_F(ReviewRecorderTest, CountsAPickedAnswerOfAnotherWordAsConfusion)
+{
+    EXPECT_CALL(database, addConfusion(_)).WillOnce([](const review::Confusion& confusion)
+        {
+            EXPECT_EQ(confusion.targetId, 1);
+            EXPECT_EQ(confusion.chosenId, 2);
+            return true;
+        });
+
+    const RecordedReviews recorded = recorder.record({ wrongAnswer(1, 2) });
+
+    EXPECT_EQ(recorded.stored, 1u);
+    EXPECT_TRUE(recorded.confused);
+}
+
+TEST_F(ReviewRecorderTest, TypedAnswersUpdateTheMemoryStateWithoutConfusion)
+{
+    EXPECT_CALL(database, addConfusion(_)).Times(0);
+    EXPECT_CALL(database, saveMemoryState(_)).Times(1);
+    EXPECT_CALL(database, addTag(1, review::LeechDetector::LEECH_TAG)).Times(1);
+
+    const RecordedReviews recorded = recorder.record({ wrongAnswer(1, -1) });
+
+    EXPECT_FALSE(recorded.confused);
+    EXPECT_EQ(recorded.leeches, std::vector<int>{ 1 });
+}
+
+TEST_F(ReviewRecorderTest, SkipsReviewsWhichCannotBeStored)
+{
+    EXPECT_CALL(database, addReview(_)).WillOnce(Return(false));
+    EXPECT_CALL(database, saveMemoryState(_)).Times(0);
+
+    const RecordedReviews recorded = recorder.record({ wrongAnswer(1, 2), wrongAnswer(-1, 2) });
+
+    EXPECT_EQ(recorded.stored, 0u);
+    EXPECT_FALSE(recorded.confused);
+}
+
+TEST_F(ReviewRecorderTest, RollsBackAReviewWhoseMemoryStateIsNotSaved)
+{
+    EXPECT_CALL(database, saveMemoryState(_)).WillOnce(Return(false));
+    EXPECT_CALL(database, addTag(_, _)).Times(0);
+    EXPECT_CALL(database, commitTransaction()).Times(0);
+    EXPECT_CALL(database, rollbackTransaction()).Times(1);
+
+    const RecordedReviews recorded = recorder.record({ wrongAnswer(1, 2) });
+
+    EXPECT_EQ(recorded.stored, 0u);
+    EXPECT_FALSE(recorded.confused);
+    EXPECT_TRUE(recorded.leeches.empty());
+}
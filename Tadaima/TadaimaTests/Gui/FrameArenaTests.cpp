@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include "gui/FrameArena.h"
+#include <memory_resource>
+#include <string>
+
+using namespace tadaima::gui;
+
+namespace
+{
+    // Counts the blocks an arena takes from the heap so the tests can check a frame takes none.
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        std::size_t allocations = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            allocations++;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* memory, std::size_t bytes, std::size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(memory, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    void drawFrame(FrameArena& arena, const std::string& userName, const std::vector<std::string>& options)
+    {
+        EXPECT_STREQ(arena.format("Ohayou, {}!", userName), ("Ohayou, " + userName + "!").c_str());
+        for( std::size_t index = 0; index < options.size(); ++index )
+        {
+            const char* label = arena.format("{}) {}", static_cast<char>('a' + index), options[index]);
+            EXPECT_EQ(label[0], static_cast<char>('a' + index));
+        }
+        EXPECT_STREQ(arena.copy("script.py"), "script.py");
+        arena.reset();
+    }
+}
+
+TEST(FrameArenaTest, FormatsNullTerminatedText)
+{
+    FrameArena arena(64);
+    const char* first = arena.format("{} + {} = {}", 1, 2, 3);
+    const char* second = arena.copy("kana");
+
+    EXPECT_STREQ(first, "1 + 2 = 3");
+    EXPECT_STREQ(second, "kana");
+    EXPECT_EQ(arena.used(), 15u);
+
+    arena.reset();
+    EXPECT_EQ(arena.used(), 0u);
+}
+
+TEST(FrameArenaTest, OverflowGrowsBlockOnReset)
+{
+    FrameArena arena(16);
+    const std::string longText(100, 'x');
+    const char* text = arena.format("{}{}", longText, 42);
+
+    EXPECT_EQ(std::string(text), longText + "42");
+    EXPECT_STREQ(arena.copy("still valid"), "still valid");
+    EXPECT_EQ(std::string(text), longText + "42");
+
+    arena.reset();
+    EXPECT_GE(arena.capacity(), 103u + 12u);
+}
+
+TEST(FrameArenaTest, SteadyStateFramesDoNotAllocate)
+{
+    CountingResource resource;
+    FrameArena arena(32, &resource);
+    const std::string userName = "Tadaima";
+    std::vector<std::string> options;
+    for( int index = 0; index < 4; ++index )
+    {
+        options.push_back("option number " + std::to_string(index) + " with a long enough translation");
+    }
+
+    // The first frame overflows the small block and grows it.
+    drawFrame(arena, userName, options);
+
+    const std::size_t before = resource.allocations;
+    for( int frame = 0; frame < 100; ++frame )
+    {
+        arena.format("Ohayou, {}!", userName);
+        for( std::size_t index = 0; index < options.size(); ++index )
+        {
+            arena.format("{}) {}", static_cast<char>('a' + index), options[index]);
+        }
+        arena.copy("script.py");
+        arena.reset();
+    }
+    EXPECT_EQ(resource.allocations - before, 0u);
+    EXPECT_EQ(arena.used(), 0u);
+}
@@ -83,6 +83,20 @@ namespace tadaima
                 auto retrievedLessonPackages = package.get<std::vector<LessonPackage>>(LessonPackageKey::LessonsPackage);
                 ASSERT_TRUE(retrievedLessonPackages.empty());
             }
+
+            TEST_F(LessonDataPackageTest, PartialPackageListsChangedLessons)
+            {
+                EXPECT_FALSE(package.isChange());
+
+                Lesson lesson{ 2, "MainName2", "SubName2", {} };
+                LessonDataPackage changes({ lesson }, { 2, 5 });
+
+                EXPECT_TRUE(changes.isChange());
+                EXPECT_EQ(changes.decodeChangedLessonIds(), (std::vector<int>{ 2, 5 }));
+                auto decodedLessons = changes.decode();
+                ASSERT_EQ(decodedLessons.size(), 1);
+                EXPECT_EQ(decodedLessons[0].id, 2);
+            }
         } // namespace widget
     } // namespace gui
 } // namespace tadaima
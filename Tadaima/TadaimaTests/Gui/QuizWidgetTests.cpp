@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "gui/Widgets/QuizWidget.h"
+#include "gui/FrameArena.h"
+#include "tools/AllocationTracker.h"
+#include "Tools/Logger.h"
+#include "imgui.h"
+#include <string>
+#include <vector>
+
+using namespace tadaima;
+using namespace tadaima::gui;
+
+namespace
+{
+    // Runs ImGui without a renderer: the font atlas is built once and the draw data of each frame is dropped.
+    class HeadlessImGui
+    {
+    public:
+        HeadlessImGui()
+        {
+            ImGui::CreateContext();
+            ImGuiIO& io = ImGui::GetIO();
+            io.IniFilename = nullptr;
+            io.DisplaySize = ImVec2(1280.0f, 720.0f);
+            unsigned char* pixels = nullptr;
+            int width = 0;
+            int height = 0;
+            io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+        }
+
+        ~HeadlessImGui()
+        {
+            ImGui::DestroyContext();
+        }
+
+        template<typename Draw>
+        void frame(Draw draw)
+        {
+            ImGui::GetIO().DeltaTime = 1.0f / 60.0f;
+            ImGui::NewFrame();
+            draw();
+            ImGui::Render();
+            FrameArena::frame().reset();
+        }
+    };
+
+    std::vector<Lesson> makeLessons()
+    {
+        Lesson lesson{ 1, "Main Name", "Sub Name", {} };
+        for( int id = 1; id <= 8; ++id )
+        {
+            lesson.words.push_back(Word{ id, "kana" + std::to_string(id), "a translation long enough to leave the small string buffer " + std::to_string(id), "romaji" + std::to_string(id), "", {} });
+        }
+        return { lesson };
+    }
+}
+
+TEST(QuizWidgetTest, DrawDoesNotAllocateAfterWarmUp)
+{
+    if( !AllocationTracker::ENABLED )
+    {
+        GTEST_SKIP() << "Built without TADAIMA_TRACK_ALLOCATIONS.";
+    }
+
+    tools::Logger logger;
+    HeadlessImGui imgui;
+    widget::QuizWidget widget(quiz::makeMultipleChoiceSession<quiz::TranslationField, quiz::RomajiField, quiz::SequentialSelection>, makeLessons(), logger);
+    bool open = true;
+
+    // The first frames create the window and grow the frame arena.
+    for( int frame = 0; frame < 3; ++frame )
+    {
+        imgui.frame([&]() { widget.draw(&open); });
+    }
+
+    const AllocationStats before = AllocationTracker::stats(AllocationTag::Gui);
+    for( int frame = 0; frame < 100; ++frame )
+    {
+        AllocationScope scope(AllocationTag::Gui);
+        imgui.frame([&]() { widget.draw(&open); });
+    }
+    const AllocationStats after = AllocationTracker::stats(AllocationTag::Gui);
+
+    EXPECT_EQ(after.allocations - before.allocations, 0u);
+    EXPECT_TRUE(open);
+}
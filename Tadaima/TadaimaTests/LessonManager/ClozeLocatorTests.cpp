@@ -0,0 +1,65 @@
+﻿#include "gtest/gtest.h"
+#include "lessons/ClozeLocator.h"
+
+using namespace tadaima;
+
+TEST(ClozeLocatorTest, PrefersTheKanjiThenTheKanaThenTheRomaji)
+{
+    Word kanji{ 1, "みず", "", "mizu", "みずと水をください。", {} };
+    kanji.kanji = "水";
+    ClozeLocator::locate(kanji);
+    EXPECT_EQ(ClozeLocator::answer(kanji), "水");
+    EXPECT_EQ(ClozeLocator::blank(kanji), "みずと____をください。");
+
+    Word kana{ 1, "みず", "", "mizu", "みずをください。", {} };
+    kana.kanji = "水";
+    ClozeLocator::locate(kana);
+    EXPECT_EQ(kana.clozeStart, 0);
+    EXPECT_EQ(ClozeLocator::answer(kana), "みず");
+
+    Word romaji{ 1, "ねこ", "", "neko", "I saw a Neko today.", {} };
+    ClozeLocator::locate(romaji);
+    EXPECT_EQ(ClozeLocator::answer(romaji), "Neko");
+    EXPECT_EQ(ClozeLocator::blank(romaji), "I saw a ____ today.");
+}
+
+TEST(ClozeLocatorTest, FindsInflectedFormsByTheirStem)
+{
+    Word verb{ 1, "たべる", "", "taberu", "毎日りんごを食べます。", {} };
+    verb.kanji = "食べる";
+    ClozeLocator::locate(verb);
+    EXPECT_EQ(ClozeLocator::answer(verb), "食べ");
+    EXPECT_EQ(ClozeLocator::blank(verb), "毎日りんごを____ます。");
+
+    // A single remaining character would match almost anywhere
+    Word shortWord{ 1, "みる", "", "miru", "みたいです。", {} };
+    shortWord.kanji = "見る";
+    ClozeLocator::locate(shortWord);
+    EXPECT_FALSE(ClozeLocator::hasCloze(shortWord));
+}
+
+TEST(ClozeLocatorTest, WordsMissingFromTheirSentenceHaveNoCloze)
+{
+    Word unlocated{ 1, "とり", "", "tori", "空が青い。", {} };
+    unlocated.kanji = "鳥";
+    EXPECT_EQ(unlocated.clozeLength, -1);
+    EXPECT_FALSE(ClozeLocator::hasCloze(unlocated));
+
+    ClozeLocator::locate(unlocated);
+    EXPECT_EQ(unlocated.clozeStart, -1);
+    EXPECT_EQ(unlocated.clozeLength, 0);
+    EXPECT_TRUE(ClozeLocator::blank(unlocated).empty());
+
+    Word noSentence{ 1, "いぬ", "", "inu", "", {} };
+    noSentence.kanji = "犬";
+    ClozeLocator::locate(noSentence);
+    EXPECT_FALSE(ClozeLocator::hasCloze(noSentence));
+
+    // A span stored for an older sentence must not be cut out of a shorter one
+    Word stale{ 1, "いぬ", "", "inu", "犬", {} };
+    stale.kanji = "犬";
+    stale.clozeStart = 10;
+    stale.clozeLength = 3;
+    EXPECT_FALSE(ClozeLocator::hasCloze(stale));
+    EXPECT_TRUE(ClozeLocator::answer(stale).empty());
+}
@@ -0,0 +1,184 @@
+#include "gtest/gtest.h"
+#include "lessons/DeckPack.h"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+using namespace tadaima;
+
+namespace
+{
+    const char* BASE_PATH = "deck_base.tdeck";
+    const char* NEXT_PATH = "deck_next.tdeck";
+    const char* DELTA_PATH = "deck_delta.tdeck";
+    const char* MERGED_PATH = "deck_merged.tdeck";
+
+    std::vector<Lesson> makeDeck(int lessonCount, int wordsPerLesson)
+    {
+        std::vector<Lesson> lessons;
+        for( int l = 0; l < lessonCount; ++l )
+        {
+            Lesson lesson;
+            lesson.mainName = "Core";
+            lesson.subName = "Part " + std::to_string(l);
+            for( int w = 0; w < wordsPerLesson; ++w )
+            {
+                const std::string suffix = std::to_string(l) + "_" + std::to_string(w);
+                lesson.words.push_back(Word(0, "kana" + suffix, "translation" + suffix, "romaji" + suffix, "", { "tag" + std::to_string(w % 3) }));
+            }
+            lessons.push_back(lesson);
+        }
+        return lessons;
+    }
+
+    class DeckPackTest : public ::testing::Test
+    {
+    protected:
+        void TearDown() override
+        {
+            for( const char* path : { BASE_PATH, NEXT_PATH, DELTA_PATH, MERGED_PATH } )
+            {
+                std::remove(path);
+            }
+        }
+    };
+}
+
+TEST_F(DeckPackTest, RoundTripKeepsLessonsAndWords)
+{
+    const std::vector<Lesson> lessons = makeDeck(3, 100);
+    ASSERT_TRUE(DeckPack::write(BASE_PATH, "Core 2k", lessons));
+
+    DeckPack pack;
+    ASSERT_TRUE(pack.open(BASE_PATH));
+    EXPECT_EQ(pack.name(), "Core 2k");
+    EXPECT_FALSE(pack.isDelta());
+
+    const std::vector<Lesson> decoded = pack.lessons();
+    ASSERT_EQ(decoded.size(), lessons.size());
+    for( std::size_t i = 0; i < lessons.size(); ++i )
+    {
+        EXPECT_EQ(decoded[i].mainName, lessons[i].mainName);
+        EXPECT_EQ(decoded[i].subName, lessons[i].subName);
+        EXPECT_EQ(decoded[i].words, lessons[i].words);
+    }
+}
+
+TEST_F(DeckPackTest, DeltaCarriesOnlyChangedChunks)
+{
+    std::vector<Lesson> lessons = makeDeck(20, 1000);
+    ASSERT_TRUE(DeckPack::write(BASE_PATH, "Core 20k", lessons));
+    DeckPack base;
+    ASSERT_TRUE(base.open(BASE_PATH));
+
+    lessons[4].words[500].translation = "fixed";
+    lessons[12].words.insert(lessons[12].words.begin() + 10, Word(0, "new", "word", "nyu", "", {}));
+    ASSERT_TRUE(DeckPack::write(DELTA_PATH, "Core 20k", lessons, &base));
+
+    DeckPack delta;
+    ASSERT_TRUE(delta.open(DELTA_PATH));
+    EXPECT_TRUE(delta.isDelta());
+    EXPECT_LT(std::filesystem::file_size(DELTA_PATH) * 10, std::filesystem::file_size(BASE_PATH));
+
+    const DeckUpdate update = delta.update(&base);
+    ASSERT_EQ(update.changedLessons.size(), 2u);
+    EXPECT_EQ(update.changedLessons[0].subName, "Part 4");
+    EXPECT_EQ(update.changedLessons[0].words, lessons[4].words);
+    EXPECT_EQ(update.changedLessons[1].words, lessons[12].words);
+    EXPECT_TRUE(update.removedLessons.empty());
+    EXPECT_LT(update.changedChunks * 20, delta.chunkCount());
+}
+
+TEST_F(DeckPackTest, MaterializedDeltaMatchesFullPack)
+{
+    std::vector<Lesson> lessons = makeDeck(4, 300);
+    ASSERT_TRUE(DeckPack::write(BASE_PATH, "Deck", lessons));
+    DeckPack base;
+    ASSERT_TRUE(base.open(BASE_PATH));
+
+    lessons.pop_back();
+    lessons[0].words.pop_back();
+    ASSERT_TRUE(DeckPack::write(DELTA_PATH, "Deck", lessons, &base));
+    ASSERT_TRUE(DeckPack::write(NEXT_PATH, "Deck", lessons));
+
+    DeckPack delta;
+    DeckPack next;
+    ASSERT_TRUE(delta.open(DELTA_PATH));
+    ASSERT_TRUE(next.open(NEXT_PATH));
+    EXPECT_EQ(delta.version(), next.version());
+
+    const DeckUpdate update = delta.update(&base);
+    ASSERT_EQ(update.removedLessons.size(), 1u);
+    EXPECT_EQ(update.removedLessons[0].subName, "Part 3");
+
+    ASSERT_TRUE(delta.materialize(MERGED_PATH, &base));
+    DeckPack merged;
+    ASSERT_TRUE(merged.open(MERGED_PATH));
+    EXPECT_FALSE(merged.isDelta());
+    EXPECT_EQ(merged.version(), next.version());
+    EXPECT_EQ(merged.lessons().size(), 3u);
+}
+
+TEST_F(DeckPackTest, DeltaNeedsMatchingBase)
+{
+    std::vector<Lesson> lessons = makeDeck(2, 50);
+    ASSERT_TRUE(DeckPack::write(BASE_PATH, "Deck", lessons));
+    DeckPack base;
+    ASSERT_TRUE(base.open(BASE_PATH));
+
+    lessons[1].words[0].kana = "changed";
+    ASSERT_TRUE(DeckPack::write(DELTA_PATH, "Deck", lessons, &base));
+    ASSERT_TRUE(DeckPack::write(NEXT_PATH, "Deck", lessons));
+
+    DeckPack delta;
+    DeckPack other;
+    ASSERT_TRUE(delta.open(DELTA_PATH));
+    ASSERT_TRUE(other.open(NEXT_PATH));
+    EXPECT_THROW(delta.lessons(), std::runtime_error);
+    EXPECT_THROW(delta.update(&other), std::runtime_error);
+}
+
+TEST_F(DeckPackTest, DetectsCorruptedChunks)
+{
+    ASSERT_TRUE(DeckPack::write(BASE_PATH, "Deck", makeDeck(1, 20)));
+    {
+        std::fstream file(BASE_PATH, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-3, std::ios::end);
+        file.put('#');
+    }
+
+    DeckPack pack;
+    ASSERT_TRUE(pack.open(BASE_PATH));
+    EXPECT_THROW(pack.lessons(), std::runtime_error);
+}
+
+TEST_F(DeckPackTest, RejectsCorruptCountsAndOffsets)
+{
+    // Overwrites a field of the file, the header is 64 bytes and the chunk table follows the names 8-byte aligned
+    auto patch = [](std::streamoff position, auto value)
+        {
+            std::fstream file(BASE_PATH, std::ios::in | std::ios::out | std::ios::binary);
+            file.seekp(position);
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        };
+    auto namesSize = []
+        {
+            uint32_t size = 0;
+            std::ifstream file(BASE_PATH, std::ios::binary);
+            file.seekg(56);
+            file.read(reinterpret_cast<char*>(&size), sizeof(size));
+            return size;
+        };
+
+    ASSERT_TRUE(DeckPack::write(BASE_PATH, "Deck", makeDeck(2, 5)));
+    patch(12, uint32_t(0xFFFFFFFF)); // Lesson count
+    DeckPack pack;
+    EXPECT_FALSE(pack.open(BASE_PATH));
+
+    ASSERT_TRUE(DeckPack::write(BASE_PATH, "Deck", makeDeck(2, 5)));
+    const std::streamoff firstEntry = (64 + namesSize() + 7) / 8 * 8;
+    patch(firstEntry + 32, uint64_t(0xFFFFFFFFFFFFFFF0)); // Offset wrapping around with the size of the payload
+    EXPECT_FALSE(pack.open(BASE_PATH));
+    EXPECT_FALSE(pack.isOpen());
+}
@@ -0,0 +1,144 @@
+﻿#include "gtest/gtest.h"
+#include "lessons/FrequencyTable.h"
+#include "tools/JapaneseText.h"
+#include <cstdio>
+#include <sstream>
+
+using namespace tadaima;
+
+namespace
+{
+    const char* TABLE_PATH = "frequency_test.bin";
+
+    class FrequencyTableTest : public ::testing::Test
+    {
+    protected:
+        void TearDown() override
+        {
+            table.close();
+            std::remove(TABLE_PATH);
+        }
+
+        bool build(const std::string& list)
+        {
+            std::istringstream input(list);
+            return FrequencyTable::build(input, TABLE_PATH) > 0 && table.open(TABLE_PATH);
+        }
+
+        FrequencyTable table;
+    };
+}
+
+TEST(JapaneseTextTest, NormalizeFoldsScriptsAndWidth)
+{
+    EXPECT_EQ(normalizeJapanese("カタカナ"), "かたかな");
+    EXPECT_EQ(normalizeJapanese("ｶﾞｯｺｳ"), "がっこう");
+    EXPECT_EQ(normalizeJapanese("ＡＢＣ　"), "abc");
+    EXPECT_EQ(normalizeJapanese("  学校 "), "学校");
+}
+
+TEST(JapaneseTextTest, HashIsStableForNormalizedText)
+{
+    EXPECT_EQ(hashText(normalizeJapanese("ネコ")), hashText("ねこ"));
+    EXPECT_NE(hashText("ねこ"), hashText("いぬ"));
+}
+
+TEST(JapaneseTextTest, HiraganaKeepsOtherCharacters)
+{
+    EXPECT_EQ(toHiragana("ｶﾞｯｺｳ と Tokyo"), "がっこう と Tokyo");
+    EXPECT_EQ(toHiragana("コーヒー"), "こーひー");
+}
+
+TEST(JapaneseTextTest, RomajiFollowsHepburn)
+{
+    EXPECT_EQ(toRomaji("きょうと"), "kyouto");
+    EXPECT_EQ(toRomaji("しゃしん"), "shashin");
+    EXPECT_EQ(toRomaji("マッチ"), "matchi");
+    EXPECT_EQ(toRomaji("ざっし"), "zasshi");
+    EXPECT_EQ(toRomaji("きんえん"), "kin'en");
+    EXPECT_EQ(toRomaji("コーヒー"), "koohii");
+    EXPECT_EQ(toRomaji("ファイル"), "fairu");
+    EXPECT_EQ(toRomaji("ほんを 読む"), "honwo 読mu");
+}
+
+TEST(JapaneseTextTest, GojuonOrderIgnoresScriptFirst)
+{
+    EXPECT_LT(compareGojuon("あめ", "カサ"), 0);
+    EXPECT_LT(compareGojuon("はし", "ばし"), 0);
+    EXPECT_LT(compareGojuon("ばか", "はし"), 0);
+    EXPECT_LT(compareGojuon("かあど", "カード"), 0);
+    EXPECT_LT(compareGojuon("カード", "かいだん"), 0);
+    EXPECT_NE(compareGojuon("ねこ", "ネコ"), 0);
+    EXPECT_EQ(compareGojuon("ネコ", "ネコ"), 0);
+}
+
+TEST(JapaneseTextTest, EditDistanceCountsCharacters)
+{
+    EXPECT_EQ(editDistance("たべる", "たべる"), 0u);
+    EXPECT_EQ(editDistance("たべる", "たべた"), 1u);
+    EXPECT_EQ(editDistance("のむ", "よむよ"), 2u);
+    EXPECT_EQ(editDistance("", "ねこ"), 2u);
+}
+
+TEST_F(FrequencyTableTest, RanksFollowListOrder)
+{
+    ASSERT_TRUE(build("# comment\nの\nに\nねこ\n"));
+
+    EXPECT_EQ(table.size(), 3u);
+    EXPECT_EQ(table.rank("の"), 1);
+    EXPECT_EQ(table.rank("ネコ"), 3);
+    EXPECT_EQ(table.rank("いぬ"), FrequencyTable::UNKNOWN_RANK);
+}
+
+TEST_F(FrequencyTableTest, RanksFollowCountsWhenAllLinesHaveThem)
+{
+    ASSERT_TRUE(build("ねこ\t50\nいぬ\t900\nとり\t120\n"));
+
+    EXPECT_EQ(table.rank("いぬ"), 1);
+    EXPECT_EQ(table.rank("とり"), 2);
+    EXPECT_EQ(table.rank("ねこ"), 3);
+}
+
+TEST_F(FrequencyTableTest, WordRankUsesBestSpelling)
+{
+    ASSERT_TRUE(build("食べる\nたべる\nねこ\n猫\n"));
+
+    Word eat{ 1, "たべる", "", "", "", {} };
+    eat.kanji = "食べる";
+    Word cat{ 2, "ねこ", "", "", "", {} };
+    cat.kanji = "猫";
+    Word dog{ 3, "いぬ", "", "", "", {} };
+    dog.kanji = "犬";
+
+    EXPECT_EQ(table.rank(eat), 1);
+    EXPECT_EQ(table.rank(cat), 3);
+    EXPECT_EQ(table.rank(dog), FrequencyTable::UNKNOWN_RANK);
+}
+
+TEST_F(FrequencyTableTest, RejectsEmptyListAndInvalidFile)
+{
+    std::istringstream input("# only a comment\n");
+    EXPECT_EQ(FrequencyTable::build(input, TABLE_PATH), 0u);
+    EXPECT_FALSE(table.open("missing_frequency_table.bin"));
+    EXPECT_EQ(table.rank("ねこ"), FrequencyTable::UNKNOWN_RANK);
+}
+
+TEST_F(FrequencyTableTest, AnnotatesLessonsAndOrdersByFrequency)
+{
+    ASSERT_TRUE(build("いぬ\nねこ\n"));
+
+    Lesson lesson;
+    lesson.words = { Word{ 1, "とり", "", "", "", {} }, Word{ 2, "ねこ", "", "", "", {} }, Word{ 3, "イヌ", "", "", "", {} } };
+    std::vector<Lesson> lessons{ lesson };
+    table.annotate(lessons);
+
+    std::vector<Word> words = lessons.front().words;
+    EXPECT_EQ(words[0].frequencyRank, FrequencyTable::UNKNOWN_RANK);
+    EXPECT_EQ(words[1].frequencyRank, 2);
+    EXPECT_EQ(words[2].frequencyRank, 1);
+
+    std::stable_sort(words.begin(), words.end(), FrequencyTable::isMoreCommon);
+    EXPECT_EQ(words[0].id, 3);
+    EXPECT_EQ(words[1].id, 2);
+    EXPECT_EQ(words[2].id, 1);
+}
@@ -0,0 +1,75 @@
+﻿#include "gtest/gtest.h"
+#include "lessons/KanjiIndex.h"
+#include <sstream>
+
+using namespace tadaima;
+
+namespace
+{
+    std::vector<Lesson> makeLibrary()
+    {
+        Lesson food;
+        food.id = 1;
+        food.words = { Word{ 1, "たべる", "", "", "", {} }, Word{ 2, "しょくじ", "", "", "", {} }, Word{ 3, "のみもの", "", "", "", {} } };
+        food.words[0].kanji = "食べる";
+        food.words[1].kanji = "食事";
+        food.words[2].kanji = "飲み物";
+
+        Lesson verbs;
+        verbs.id = 2;
+        verbs.words = { Word{ 4, "飲む", "", "", "", {} }, Word{ 5, "ありがとう", "", "", "", {} }, Word{ 6, "じこ", "", "", "", {} } };
+        verbs.words[2].kanji = "事故";
+        return { food, verbs };
+    }
+}
+
+TEST(KanjiIndexTest, FindsWordsContainingKanji)
+{
+    KanjiIndex index;
+    index.build(makeLibrary());
+
+    EXPECT_EQ(index.findWords("食"), (std::vector<int>{ 1, 2 }));
+    EXPECT_EQ(index.findWords("飲"), (std::vector<int>{ 3, 4 }));
+    EXPECT_EQ(index.findWords("事"), (std::vector<int>{ 2, 6 }));
+    EXPECT_TRUE(index.findWords("水").empty());
+    EXPECT_TRUE(index.findWords("たべる").empty());
+}
+
+TEST(KanjiIndexTest, IntersectsSeveralKanji)
+{
+    KanjiIndex index;
+    index.build(makeLibrary());
+
+    EXPECT_EQ(index.findWords("食事"), (std::vector<int>{ 2 }));
+    EXPECT_EQ(index.findWords("事 食"), (std::vector<int>{ 2 }));
+    EXPECT_TRUE(index.findWords("食飲").empty());
+}
+
+TEST(KanjiIndexTest, FindsWordsByRadicals)
+{
+    std::istringstream table("# KRADFILE\n食 : 人 良\n飲 : 人 欠 食\n事 : 一 口 亅\n故 : 古 攵\n");
+
+    KanjiIndex index;
+    EXPECT_FALSE(index.hasRadicals());
+    EXPECT_EQ(index.loadRadicals(table), 4u);
+    EXPECT_TRUE(index.hasRadicals());
+    index.build(makeLibrary());
+
+    EXPECT_EQ(index.kanjiWithRadicals("人"), (std::vector<char32_t>{ U'食', U'飲' }));
+    EXPECT_EQ(index.findWordsByRadicals("人"), (std::vector<int>{ 1, 2, 3, 4 }));
+    EXPECT_EQ(index.findWordsByRadicals("人 欠"), (std::vector<int>{ 3, 4 }));
+    EXPECT_EQ(index.findWordsByRadicals("口"), (std::vector<int>{ 2, 6 }));
+    EXPECT_TRUE(index.findWordsByRadicals("欠 口").empty());
+    EXPECT_TRUE(index.findWordsByRadicals("水").empty());
+}
+
+TEST(KanjiIndexTest, RebuildReplacesIndex)
+{
+    KanjiIndex index;
+    index.build(makeLibrary());
+    EXPECT_EQ(index.kanjiCount(), 5u);
+
+    index.build({});
+    EXPECT_EQ(index.kanjiCount(), 0u);
+    EXPECT_TRUE(index.wordsWithKanji(U'食').empty());
+}
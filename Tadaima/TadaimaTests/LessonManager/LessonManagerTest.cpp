@@ -2,6 +2,7 @@
 #include "gmock/gmock.h"
 #include "lessons/LessonManager.h"
 #include "MockDatabase.h"
+#include "Application/GroupCommit.h"
 
 using namespace tadaima;
 using ::testing::_;
@@ -81,7 +82,7 @@ TEST_F(LessonManagerTest, AddLessons)
     EXPECT_CALL(mockDatabase, addWord(3, word2)).WillOnce(Return(4));
     EXPECT_CALL(mockDatabase, addTag(4, "tag2"));
 
-    lessonManager.addLessons(lessons);
+    EXPECT_TRUE(lessonManager.addLessons(lessons));
 }
 
 TEST_F(LessonManagerTest, RenameLessons)
@@ -91,10 +92,20 @@ TEST_F(LessonManagerTest, RenameLessons)
 
     std::vector<Lesson> lessons = { lesson1, lesson2 };
 
-    EXPECT_CALL(mockDatabase, updateLesson(1, "Main Name 1", "Sub Name 1"));
-    EXPECT_CALL(mockDatabase, updateLesson(2, "Main Name 2", "Sub Name 2"));
+    EXPECT_CALL(mockDatabase, updateLesson(1, "Main Name 1", "Sub Name 1")).WillOnce(Return(true));
+    EXPECT_CALL(mockDatabase, updateLesson(2, "Main Name 2", "Sub Name 2")).WillOnce(Return(true));
 
-    lessonManager.renameLessons(lessons);
+    EXPECT_TRUE(lessonManager.renameLessons(lessons));
+}
+
+TEST_F(LessonManagerTest, RenameLessonsReportsFailureAndContinues)
+{
+    std::vector<Lesson> lessons = { Lesson{ 1, "Main Name 1", "Sub Name 1", {} }, Lesson{ 2, "Main Name 2", "Sub Name 2", {} } };
+
+    EXPECT_CALL(mockDatabase, updateLesson(1, "Main Name 1", "Sub Name 1")).WillOnce(Return(false));
+    EXPECT_CALL(mockDatabase, updateLesson(2, "Main Name 2", "Sub Name 2")).WillOnce(Return(true));
+
+    EXPECT_FALSE(lessonManager.renameLessons(lessons));
 }
 
 TEST_F(LessonManagerTest, GetAllLessons)
@@ -161,9 +172,91 @@ TEST_F(LessonManagerTest, EditALesson)
 
     std::vector<Lesson> lessons = { lesson1, lesson2 };
 
-    EXPECT_CALL(mockDatabase, editLesson(lesson1));
-    EXPECT_CALL(mockDatabase, editLesson(lesson2));
+    EXPECT_CALL(mockDatabase, editLesson(lesson1)).WillOnce(Return(1));
+    EXPECT_CALL(mockDatabase, editLesson(lesson2)).WillOnce(Return(2));
 
-    lessonManager.editLessons(lessons);
+    EXPECT_TRUE(lessonManager.editLessons(lessons));
 }
 
+TEST_F(LessonManagerTest, GroupCommitReportsLessonCreatedByAnEdit)
+{
+    Lesson lesson{ 0, "Main Name", "Sub Name", { Word{ 0, "kana", "translation", "romaji", "example", {} } } };
+    application::GroupCommit groupCommit{ mockDatabase };
+
+    EXPECT_CALL(mockDatabase, beginTransaction()).WillRepeatedly(Return(true));
+    EXPECT_CALL(mockDatabase, commitTransaction()).WillRepeatedly(Return(true));
+    EXPECT_CALL(mockDatabase, editLesson(lesson)).WillOnce(Return(9));
+
+    groupCommit.enqueue("OnLessonEdited", [&] { return lessonManager.editLessons({ lesson }); });
+    const auto results = groupCommit.commitAll();
+
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_TRUE(results[0].success);
+    EXPECT_EQ(lessonManager.takeChangedLessons(), (std::vector<int>{ 9 }));
+}
+
+
+TEST_F(LessonManagerTest, MoveWordsToExistingLesson)
+{
+    std::vector<int> wordIds = { 3, 5, 8 };
+    Lesson target{ 4, "Main Name", "Sub Name", {} };
+
+    EXPECT_CALL(mockDatabase, addLesson(_, _)).Times(0);
+    EXPECT_CALL(mockDatabase, moveWords(wordIds, 4)).WillOnce(Return(true));
+
+    EXPECT_TRUE(lessonManager.moveWords(wordIds, target));
+}
+
+TEST_F(LessonManagerTest, CopyWordsCreatesTargetLesson)
+{
+    std::vector<int> wordIds = { 3, 5 };
+    WordOperation operation;
+    operation.type = WordOperation::Type::Copy;
+    operation.wordIds = wordIds;
+    operation.target.mainName = "Main Name";
+    operation.target.subName = "Sub Name";
+
+    EXPECT_CALL(mockDatabase, addLesson("Main Name", "Sub Name")).WillOnce(Return(7));
+    EXPECT_CALL(mockDatabase, copyWords(wordIds, 7)).WillOnce(Return(true));
+
+    EXPECT_TRUE(lessonManager.applyWordOperation(operation));
+}
+
+TEST_F(LessonManagerTest, MoveWordsFailsWithoutTargetLesson)
+{
+    Lesson target{ 0, "Main Name", "Sub Name", {} };
+
+    EXPECT_CALL(mockDatabase, addLesson("Main Name", "Sub Name")).WillOnce(Return(-1));
+    EXPECT_CALL(mockDatabase, moveWords(_, _)).Times(0);
+
+    EXPECT_FALSE(lessonManager.moveWords({ 1 }, target));
+}
+
+TEST_F(LessonManagerTest, DeleteAndRetagWords)
+{
+    std::vector<int> wordIds = { 1, 2 };
+    std::vector<std::string> added = { "added" };
+    std::vector<std::string> removed = { "removed" };
+
+    EXPECT_CALL(mockDatabase, deleteWords(wordIds)).WillOnce(Return(true));
+    EXPECT_CALL(mockDatabase, retagWords(wordIds, added, removed)).WillOnce(Return(false));
+
+    EXPECT_TRUE(lessonManager.deleteWords(wordIds));
+    EXPECT_FALSE(lessonManager.retagWords(wordIds, added, removed));
+}
+
+TEST_F(LessonManagerTest, TakeChangedLessonsListsTouchedLessonsOnce)
+{
+    std::vector<int> wordIds = { 3, 5 };
+    Lesson target{ 4, "Main Name", "Sub Name", {} };
+
+    EXPECT_CALL(mockDatabase, getLessonIdsOfWords(wordIds)).WillOnce(Return(std::vector<int>{ 2, 1 }));
+    EXPECT_CALL(mockDatabase, moveWords(wordIds, 4)).WillOnce(Return(true));
+    EXPECT_CALL(mockDatabase, updateLesson(2, "Main Name", "Other Name")).WillOnce(Return(true));
+
+    EXPECT_TRUE(lessonManager.moveWords(wordIds, target));
+    EXPECT_TRUE(lessonManager.renameLessons({ Lesson{ 2, "Main Name", "Other Name", {} } }));
+
+    EXPECT_EQ(lessonManager.takeChangedLessons(), (std::vector<int>{ 1, 2, 4 }));
+    EXPECT_TRUE(lessonManager.takeChangedLessons().empty());
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include "lessons/LessonSerializer.h"
+#include <sstream>
+
+using namespace tadaima;
+
+namespace
+{
+    std::vector<Lesson> sampleLessons()
+    {
+        Lesson greetings;
+        greetings.mainName = "Basics";
+        greetings.subName = "Greetings";
+        greetings.words.push_back(Word{ -1, "ohayou", "good morning", "ohayou", "Say \"hi\", then\nbow", { "greeting", "daily" } });
+
+        Lesson food;
+        food.mainName = "Basics";
+        food.subName = "Food";
+        food.words.push_back(Word{ -1, "mizu", "water", "mizu", "", {} });
+        food.words.back().kanji = "K";
+        return { greetings, food };
+    }
+}
+
+TEST(LessonSerializerTest, CsvRoundTripKeepsEveryField)
+{
+    std::stringstream stream;
+    ASSERT_TRUE(LessonSerializer::writeCsv(stream, sampleLessons()));
+
+    std::vector<Lesson> lessons;
+    ASSERT_TRUE(LessonSerializer::readCsv(stream, lessons));
+    EXPECT_EQ(lessons, sampleLessons());
+}
+
+TEST(LessonSerializerTest, CsvRowsOfTheSameLessonAreMerged)
+{
+    std::istringstream input(std::string(LessonSerializer::CSV_HEADER) + "\n"
+        "A,B,a,,a,one,,\n"
+        "C,D,c,,c,three,,x\n"
+        "A,B,b,,b,two,,\n");
+
+    std::vector<Lesson> lessons;
+    ASSERT_TRUE(LessonSerializer::readCsv(input, lessons));
+    ASSERT_EQ(lessons.size(), 2u);
+    ASSERT_EQ(lessons[0].words.size(), 2u);
+    EXPECT_EQ(lessons[0].words[1].translation, "two");
+    EXPECT_EQ(lessons[1].words[0].tags, std::vector<std::string>{ "x" });
+}
+
+TEST(LessonSerializerTest, CsvRejectsUnknownHeaderAndShortRows)
+{
+    std::vector<Lesson> lessons;
+    std::istringstream wrongHeader("name,kana\nA,a\n");
+    EXPECT_FALSE(LessonSerializer::readCsv(wrongHeader, lessons));
+
+    std::istringstream shortRow(std::string(LessonSerializer::CSV_HEADER) + "\nA,B,a\n");
+    EXPECT_FALSE(LessonSerializer::readCsv(shortRow, lessons));
+}
+
+TEST(LessonSerializerTest, XmlRoundTripKeepsNamesAndSpellings)
+{
+    std::stringstream stream;
+    ASSERT_TRUE(LessonSerializer::writeXml(stream, sampleLessons()));
+
+    std::vector<Lesson> lessons;
+    ASSERT_TRUE(LessonSerializer::readXml(stream, lessons));
+    ASSERT_EQ(lessons.size(), 2u);
+    EXPECT_EQ(lessons[1].subName, "Food");
+    EXPECT_EQ(lessons[1].words[0].kanji, "K");
+    EXPECT_EQ(lessons[0].words[0].translation, "good morning");
+    EXPECT_TRUE(lessons[0].words[0].exampleSentence.empty());
+}
+
+TEST(LessonSerializerTest, XmlSkipsRepeatedLessons)
+{
+    std::istringstream input(
+        "<lessons>"
+        "<lesson name=\"A\"><subname name=\"B\"><word kana=\"a\" /></subname></lesson>"
+        "<lesson name=\"A\"><subname name=\"B\"><word kana=\"b\" /></subname></lesson>"
+        "</lessons>");
+
+    std::vector<Lesson> lessons;
+    ASSERT_TRUE(LessonSerializer::readXml(input, lessons));
+    ASSERT_EQ(lessons.size(), 1u);
+    EXPECT_EQ(lessons[0].words[0].kana, "a");
+}
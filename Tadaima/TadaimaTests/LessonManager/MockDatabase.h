@@ -8,16 +8,36 @@ class MockDatabase : public tadaima::Database
 {
 public:
     MOCK_METHOD(int, addLesson, (const std::string& mainName, const std::string& subName), (override));
-    MOCK_METHOD(bool, editLesson, (const tadaima::Lesson& lesson), (override));
+    MOCK_METHOD(int, editLesson, (const tadaima::Lesson& lesson), (override));
     MOCK_METHOD(int, addWord, (int lessonId, const tadaima::Word& word), (override));
     MOCK_METHOD(void, addTag, (int wordId, const std::string& tag), (override));
-    MOCK_METHOD(void, updateLesson, (int lessonId, const std::string& newMainName, const std::string& newSubName), (override));
+    MOCK_METHOD(bool, updateLesson, (int lessonId, const std::string& newMainName, const std::string& newSubName), (override));
     MOCK_METHOD(void, updateWord, (int wordId, const tadaima::Word& updatedWord), (override));
-    MOCK_METHOD(void, deleteLesson, (int lessonId), (override));
+    MOCK_METHOD(bool, deleteLesson, (int lessonId), (override));
     MOCK_METHOD(void, deleteWord, (int wordId), (override));
+    MOCK_METHOD(bool, moveWords, (const std::vector<int>& wordIds, int lessonId), (override));
+    MOCK_METHOD(bool, copyWords, (const std::vector<int>& wordIds, int lessonId), (override));
+    MOCK_METHOD(bool, deleteWords, (const std::vector<int>& wordIds), (override));
+    MOCK_METHOD(bool, retagWords, (const std::vector<int>& wordIds, const std::vector<std::string>& addedTags, const std::vector<std::string>& removedTags), (override));
     MOCK_METHOD(std::vector<std::string>, getLessonNames, (), (const, override));
     MOCK_METHOD(std::vector<tadaima::Word>, getWordsInLesson, (int lessonId), (const, override));
+    MOCK_METHOD(std::vector<tadaima::Word>, getWords, (const std::vector<int>& wordIds), (const, override));
     MOCK_METHOD(std::vector<tadaima::Lesson>, getAllLessons, (), (const, override));
+    MOCK_METHOD(std::vector<tadaima::Lesson>, getLessons, (const std::vector<int>& lessonIds), (const, override));
+    MOCK_METHOD(std::vector<int>, getLessonIdsOfWords, (const std::vector<int>& wordIds), (const, override));
+    MOCK_METHOD(void, forEachWord, (const std::vector<int>& lessonIds, (const std::function<void(const tadaima::Lesson&, const tadaima::Word&)>& visitor)), (const, override));
     MOCK_METHOD(void, saveSettings, (const tadaima::application::ApplicationSettings& settings), (override));
     MOCK_METHOD(tadaima::application::ApplicationSettings, loadSettings, (), (override));
+    MOCK_METHOD(bool, addReview, (const tadaima::review::ReviewRecord& record), (override));
+    MOCK_METHOD(std::vector<tadaima::review::ReviewRecord>, getReviews, (), (const, override));
+    MOCK_METHOD(bool, addConfusion, (const tadaima::review::Confusion& confusion), (override));
+    MOCK_METHOD(std::vector<tadaima::review::Confusion>, getConfusions, (), (const, override));
+    MOCK_METHOD(bool, updateFrequencyRanks, ((const std::vector<std::pair<int, int>>& ranks)), (override));
+    MOCK_METHOD(bool, saveMemoryState, (const tadaima::review::MemoryState& state), (override));
+    MOCK_METHOD(bool, saveMemoryStates, (const std::vector<tadaima::review::MemoryState>& states), (override));
+    MOCK_METHOD(tadaima::review::MemoryState, getMemoryState, (int wordId), (const, override));
+    MOCK_METHOD(std::vector<tadaima::review::MemoryState>, getMemoryStates, (), (const, override));
+    MOCK_METHOD(bool, beginTransaction, (), (override));
+    MOCK_METHOD(bool, commitTransaction, (), (override));
+    MOCK_METHOD(void, rollbackTransaction, (), (override));
 };
@@ -0,0 +1,89 @@
+﻿#include "gtest/gtest.h"
+#include "lessons/TrigramIndex.h"
+
+using namespace tadaima;
+
+namespace
+{
+    std::vector<Lesson> makeLibrary()
+    {
+        Lesson animals;
+        animals.id = 1;
+        animals.words = { Word{ 1, "ねこ", "cat", "neko", "", {} }, Word{ 2, "いぬ", "dog", "inu", "", {} }, Word{ 3, "こねこ", "kitten", "koneko", "", {} } };
+
+        Lesson drinks;
+        drinks.id = 2;
+        drinks.words = { Word{ 4, "コーヒー", "coffee", "koohii", "", {} }, Word{ 5, "おちゃ", "green tea", "ocha", "", {} }, Word{ 6, "みず", "Water", "mizu", "", {} } };
+        return { animals, drinks };
+    }
+}
+
+TEST(TrigramIndexTest, FindsSubstringsOfEveryField)
+{
+    TrigramIndex index;
+    index.build(makeLibrary());
+
+    EXPECT_EQ(index.find("ko"), (std::vector<int>{ 1, 3, 4 }));
+    EXPECT_EQ(index.find("neko"), (std::vector<int>{ 1, 3 }));
+    EXPECT_EQ(index.find("tea"), (std::vector<int>{ 5 }));
+    EXPECT_EQ(index.find("ねこ"), (std::vector<int>{ 1, 3 }));
+    EXPECT_TRUE(index.find("tac").empty());
+    EXPECT_TRUE(index.find("").empty());
+}
+
+TEST(TrigramIndexTest, LongQueriesKeepTheirOrder)
+{
+    TrigramIndex index;
+    index.build(makeLibrary());
+
+    EXPECT_EQ(index.find("green tea"), (std::vector<int>{ 5 }));
+    EXPECT_EQ(index.find("kitten"), (std::vector<int>{ 3 }));
+    EXPECT_TRUE(index.find("tea green").empty());
+    EXPECT_TRUE(index.find("cattle").empty());
+}
+
+TEST(TrigramIndexTest, NormalizesScriptCaseAndWidth)
+{
+    TrigramIndex index;
+    index.build(makeLibrary());
+
+    EXPECT_EQ(index.find("ネコ"), (std::vector<int>{ 1, 3 }));
+    EXPECT_EQ(index.find("こーひー"), (std::vector<int>{ 4 }));
+    EXPECT_EQ(index.find("WAT"), (std::vector<int>{ 6 }));
+    EXPECT_EQ(index.find("ｃｏｆｆｅｅ"), (std::vector<int>{ 4 }));
+}
+
+TEST(TrigramIndexTest, UpdateReindexesOnlyChangedWords)
+{
+    TrigramIndex index;
+    std::vector<Lesson> library = makeLibrary();
+    index.build(library);
+    EXPECT_EQ(index.update(library), 0u);
+
+    library[0].words[1].translation = "hound";
+    library[1].words.pop_back();
+    library[1].words.push_back(library[0].words[0]);
+    library[0].words.erase(library[0].words.begin());
+    library[1].words.push_back(Word{ 7, "ぎゅうにゅう", "milk", "gyuunyuu", "", {} });
+
+    EXPECT_EQ(index.update(library), 3u);
+    EXPECT_EQ(index.wordCount(), 6u);
+    EXPECT_TRUE(index.find("dog").empty());
+    EXPECT_EQ(index.find("hound"), (std::vector<int>{ 2 }));
+    EXPECT_EQ(index.find("milk"), (std::vector<int>{ 7 }));
+    EXPECT_TRUE(index.find("water").empty());
+    EXPECT_EQ(index.find("cat"), (std::vector<int>{ 1 }));
+}
+
+TEST(TrigramIndexTest, RemovedWordsLeaveNoGrams)
+{
+    TrigramIndex index;
+    index.build(makeLibrary());
+    const std::size_t grams = index.gramCount();
+
+    index.addWord(Word{ 8, "じゅーす", "juice", "juusu", "", {} });
+    EXPECT_GT(index.gramCount(), grams);
+    index.removeWord(8);
+    EXPECT_EQ(index.gramCount(), grams);
+    EXPECT_TRUE(index.find("juice").empty());
+}
@@ -0,0 +1,87 @@
+#include "gui/quiz/AdaptiveSelector.h"
+#include <gtest/gtest.h>
+#include <random>
+
+using namespace tadaima::gui::quiz;
+
+TEST(AdaptiveSelectorTest, FindWalksTheCumulativeWeights)
+{
+    AdaptiveSelector selector(5);
+    const uint32_t fresh = AdaptiveSelector::errorWeight(0, 0);
+    selector.retire(2);
+
+    EXPECT_EQ(selector.totalWeight(), 4 * fresh);
+    EXPECT_EQ(selector.find(0), 0);
+    EXPECT_EQ(selector.find(fresh - 1), 0);
+    EXPECT_EQ(selector.find(fresh), 1);
+    // The retired card has an empty range, so its point belongs to the next card
+    EXPECT_EQ(selector.find(2 * fresh), 3);
+    EXPECT_EQ(selector.find(4 * fresh - 1), 4);
+}
+
+TEST(AdaptiveSelectorTest, AnsweredCardsAreHeldBackForAFewQuestions)
+{
+    AdaptiveSelector selector(AdaptiveSelector::RECENT_CARDS + 2);
+    selector.recordAnswer(0, false);
+    EXPECT_EQ(selector.weight(0), AdaptiveSelector::errorWeight(0, 1) / AdaptiveSelector::RECENT_DIVISOR);
+
+    for( std::size_t card = 1; card < AdaptiveSelector::RECENT_CARDS; ++card )
+    {
+        selector.recordAnswer(card, true);
+        EXPECT_LT(selector.weight(0), AdaptiveSelector::errorWeight(0, 0));
+    }
+    selector.recordAnswer(AdaptiveSelector::RECENT_CARDS, true);
+    EXPECT_EQ(selector.weight(0), AdaptiveSelector::errorWeight(0, 1));
+    EXPECT_GT(selector.weight(0), AdaptiveSelector::errorWeight(0, 0));
+
+    uint64_t total = 0;
+    for( std::size_t card = 0; card < selector.size(); ++card )
+    {
+        total += selector.weight(card);
+    }
+    EXPECT_EQ(selector.totalWeight(), total);
+}
+
+TEST(AdaptiveSelectorTest, WeakCardsAreDrawnInProportionToTheirWeight)
+{
+    AdaptiveSelector selector(4);
+    selector.setAttempts(0, 0, 8);
+    for( std::size_t card = 1; card < 4; ++card )
+    {
+        selector.setAttempts(card, 8, 0);
+    }
+
+    std::mt19937 generator(7);
+    std::vector<int> draws(4, 0);
+    constexpr int DRAWS = 20000;
+    for( int draw = 0; draw < DRAWS; ++draw )
+    {
+        ++draws[selector.next(generator)];
+    }
+
+    const double expected = static_cast<double>(selector.weight(0)) / selector.totalWeight();
+    EXPECT_NEAR(static_cast<double>(draws[0]) / DRAWS, expected, 0.02);
+    EXPECT_GT(draws[0], 2 * (draws[1] + draws[2] + draws[3]));
+}
+
+TEST(AdaptiveSelectorTest, RetiredCardsAreNeverDrawn)
+{
+    AdaptiveSelector selector(100);
+    for( std::size_t card = 0; card < 100; ++card )
+    {
+        if( card != 41 )
+        {
+            selector.retire(card);
+        }
+    }
+
+    std::mt19937 generator(3);
+    for( int draw = 0; draw < 100; ++draw )
+    {
+        EXPECT_EQ(selector.next(generator), 41);
+    }
+
+    selector.retire(41);
+    EXPECT_EQ(selector.totalWeight(), 0);
+    EXPECT_EQ(selector.next(generator), AdaptiveSelector::NONE);
+}
@@ -0,0 +1,75 @@
+﻿#include "gui/quiz/ClozeQuiz.h"
+#include "lessons/ClozeLocator.h"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <stdexcept>
+
+using namespace tadaima;
+using namespace tadaima::gui::quiz;
+
+namespace
+{
+    std::vector<Lesson> makeLessons()
+    {
+        Lesson lesson;
+        lesson.id = 1;
+        lesson.words = { Word{ 1, "たべる", "to eat", "taberu", "毎日りんごを食べます。", {} }, Word{ 2, "みず", "water", "mizu", "みずをください。", {} },
+            Word{ 3, "とり", "bird", "tori", "空が青い。", {} } };
+        lesson.words[0].kanji = "食べる";
+        return { lesson };
+    }
+}
+
+TEST(ClozeQuizTest, AsksOnlyWordsFoundInTheirSentences)
+{
+    ClozeQuiz quiz(makeLessons(), QuizOrder::Random, 7);
+    quiz.start();
+    EXPECT_EQ(quiz.questionCount(), 2);
+
+    std::vector<int> asked;
+    while( !quiz.isFinished() )
+    {
+        const ClozeCard& card = quiz.currentCard();
+        asked.push_back(card.wordId);
+        EXPECT_NE(card.sentence.find(ClozeLocator::BLANK), std::string::npos);
+        EXPECT_EQ(card.sentence.find(card.answer), std::string::npos);
+        EXPECT_TRUE(quiz.submit(card.answer));
+    }
+    std::sort(asked.begin(), asked.end());
+    EXPECT_EQ(asked, (std::vector<int>{ 1, 2 }));
+    EXPECT_EQ(quiz.correctCount(), 2);
+}
+
+TEST(ClozeQuizTest, AcceptsEverySpellingOfTheWord)
+{
+    std::vector<Lesson> lessons = makeLessons();
+    lessons[0].words.resize(1);
+    for( const std::string answer : { "食べ", "食べる", "たべる", "タベル", " TABERU " } )
+    {
+        ClozeQuiz quiz(lessons, QuizOrder::Random, 1);
+        quiz.start();
+        EXPECT_TRUE(quiz.submit(answer)) << answer;
+    }
+
+    ClozeQuiz quiz(lessons, QuizOrder::Random, 1);
+    quiz.start();
+    EXPECT_FALSE(quiz.submit("のむ"));
+    EXPECT_TRUE(quiz.isFinished());
+    EXPECT_EQ(quiz.correctCount(), 0);
+}
+
+TEST(ClozeQuizTest, UsesStoredSpansWithoutSearching)
+{
+    std::vector<Lesson> lessons = makeLessons();
+    lessons[0].words.resize(1);
+
+    // A stored span is trusted, so a deliberately shifted one shows that the sentence is not searched again
+    lessons[0].words[0].clozeStart = 0;
+    lessons[0].words[0].clozeLength = 6;
+    ClozeQuiz quiz(lessons, QuizOrder::Adaptive, 3);
+    quiz.start();
+    EXPECT_EQ(quiz.currentCard().answer, "毎日");
+
+    lessons[0].words[0].clozeLength = 0;
+    EXPECT_THROW(ClozeQuiz(lessons, QuizOrder::Random, 3), std::invalid_argument);
+}
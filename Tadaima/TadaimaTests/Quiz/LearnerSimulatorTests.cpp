@@ -0,0 +1,89 @@
+#include "gui/quiz/LearnerSimulator.h"
+#include <gtest/gtest.h>
+#include <set>
+#include <stdexcept>
+
+using namespace tadaima;
+using namespace tadaima::gui::quiz;
+
+namespace
+{
+    SimulationOptions smallSimulation()
+    {
+        SimulationOptions options;
+        options.learners = 20;
+        options.deckSize = 250;
+        options.answersPerLearner = 50;
+        return options;
+    }
+}
+
+TEST(LearnerSimulatorTest, GeneratesDeckInLessons)
+{
+    const std::vector<Lesson> deck = LearnerSimulator::generateDeck(250, 3, 7);
+    ASSERT_EQ(deck.size(), 3u);
+    EXPECT_EQ(deck.back().words.size(), 50u);
+
+    std::set<std::string> answers;
+    std::set<int> ranks;
+    for( const auto& lesson : deck )
+    {
+        for( const auto& word : lesson.words )
+        {
+            answers.insert(word.translation);
+            ranks.insert(word.frequencyRank);
+        }
+    }
+    EXPECT_EQ(answers.size(), 3u);
+    EXPECT_EQ(ranks.size(), 250u);
+    EXPECT_EQ(LearnerSimulator::generateDeck(250, 3, 7), deck);
+}
+
+TEST(LearnerSimulatorTest, MeasuresBothEngines)
+{
+    const SimulationReport report = LearnerSimulator(smallSimulation()).run();
+
+    EXPECT_FALSE(report.stalled);
+    for( const auto* engine : { &report.vocabulary, &report.multipleChoice } )
+    {
+        EXPECT_EQ(engine->answers, 20u * 50u);
+        EXPECT_EQ(engine->answer.samples, engine->answers);
+        EXPECT_EQ(engine->setup.samples, 20u);
+        EXPECT_LE(engine->answer.p50Us, engine->answer.p99Us);
+        EXPECT_LE(engine->answer.p99Us, engine->answer.maxUs);
+        EXPECT_GT(engine->scaling, 0.0);
+        EXPECT_EQ(engine->invalidOptionSets, 0u);
+        EXPECT_EQ(engine->unfinishedQuizzes, 0u);
+    }
+}
+
+TEST(LearnerSimulatorTest, FewDistinctAnswersKeepOptionsValid)
+{
+    SimulationOptions options = smallSimulation();
+    options.distinctAnswers = 3;
+    const SimulationReport report = LearnerSimulator(options).run();
+
+    EXPECT_FALSE(report.stalled);
+    EXPECT_EQ(report.multipleChoice.invalidOptionSets, 0u);
+    EXPECT_EQ(report.multipleChoice.answers, 20u * 50u);
+}
+
+TEST(LearnerSimulatorTest, AccurateLearnersAnswerMoreOftenRight)
+{
+    SimulationOptions options = smallSimulation();
+    options.accuracy = 0.2;
+    const SimulationReport weak = LearnerSimulator(options).run();
+    options.accuracy = 1.0;
+    options.familiarity = 1.0;
+    const SimulationReport strong = LearnerSimulator(options).run();
+
+    EXPECT_GT(strong.vocabulary.correct, weak.vocabulary.correct * 2);
+    EXPECT_GT(strong.multipleChoice.correct, weak.multipleChoice.correct);
+}
+
+TEST(LearnerSimulatorTest, RejectsEmptySimulation)
+{
+    SimulationOptions options = smallSimulation();
+    options.deckSize = 0;
+    EXPECT_THROW(LearnerSimulator simulator(options), std::invalid_argument);
+}
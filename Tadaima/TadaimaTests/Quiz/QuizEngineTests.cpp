@@ -0,0 +1,90 @@
+﻿#include "gui/quiz/QuizEngine.h"
+#include <gtest/gtest.h>
+
+using namespace tadaima;
+using namespace tadaima::gui::quiz;
+
+namespace
+{
+    std::vector<Word> makeWords()
+    {
+        return { Word{ 1, "ねこ", "cat", "neko", "", {} }, Word{ 2, "いぬ", "dog", "inu", "", {} }, Word{ 3, "とり", "bird", "tori", "", {} } };
+    }
+
+    // Ends the quiz once every word was answered right, like a drill
+    class DrillScoring
+    {
+    public:
+        void reset(std::size_t wordCount) { m_right.assign(wordCount, false); m_correct = 0; }
+        void record(std::size_t index, bool correct) { m_correct += correct && !m_right[index] ? 1 : 0; m_right[index] = m_right[index] || correct; }
+        bool isComplete(std::size_t) const { return m_correct == m_right.size(); }
+        std::size_t correctCount() const { return m_correct; }
+
+    private:
+        std::vector<bool> m_right;
+        std::size_t m_correct = 0;
+    };
+}
+
+TEST(QuizEngineTest, FieldPoliciesFollowTheWordType)
+{
+    const Word word = makeWords().front();
+    EXPECT_EQ(wordField(word, WordType::BaseWord), "cat");
+    EXPECT_EQ(wordField(word, WordType::Kana), "ねこ");
+    EXPECT_EQ(wordField(word, WordType::Romaji), "neko");
+    EXPECT_EQ(withField(WordType::Kana, [](auto field) { return decltype(field)::TYPE; }), WordType::Kana);
+}
+
+TEST(QuizEngineTest, SequentialSessionAsksEveryWordOnce)
+{
+    QuizEngine<KanaField, RomajiField, SequentialSelection> engine(makeWords(), 1);
+    engine.start();
+
+    EXPECT_EQ(engine.prompt(), "ねこ");
+    EXPECT_TRUE(engine.submit("neko"));
+    EXPECT_EQ(engine.expectedAnswer(), "inu");
+    EXPECT_FALSE(engine.submit("wrong"));
+    EXPECT_EQ(engine.currentWord().id, 3);
+    EXPECT_TRUE(engine.submit("tori"));
+
+    EXPECT_TRUE(engine.isFinished());
+    EXPECT_EQ(engine.asked(), 3);
+    EXPECT_EQ(engine.scoring().correctCount(), 2);
+
+    engine.start();
+    EXPECT_FALSE(engine.isFinished());
+    EXPECT_EQ(engine.scoring().correctCount(), 0);
+}
+
+TEST(QuizEngineTest, ScoringPolicyDecidesWhenTheQuizEnds)
+{
+    QuizEngine<TranslationField, KanaField, SequentialSelection, DrillScoring> engine(makeWords(), 1);
+    engine.start();
+
+    // The dog is answered wrong once, so the selection comes back to it after the first pass
+    const std::vector<std::string> answers = { "ねこ", "wrong", "とり", "ねこ", "いぬ" };
+    for( const auto& answer : answers )
+    {
+        ASSERT_FALSE(engine.isFinished());
+        engine.submit(answer);
+    }
+    EXPECT_TRUE(engine.isFinished());
+    EXPECT_EQ(engine.asked(), 5);
+}
+
+TEST(QuizEngineTest, MasteryScoringRetiresLearntWords)
+{
+    QuizEngine<KanaField, RomajiField, RandomSelection, MasteryScoring> engine(makeWords(), 7, MasteryScoring(2));
+    engine.start();
+
+    // Every word needs two correct answers; a learnt word is never drawn again
+    std::vector<int> correct(3, 0);
+    while( !engine.isFinished() )
+    {
+        ASSERT_LT(correct[engine.currentIndex()], 2);
+        ++correct[engine.currentIndex()];
+        engine.submit(engine.expectedAnswer());
+    }
+    EXPECT_EQ(engine.asked(), 6);
+    EXPECT_EQ(engine.scoring().learntCount(), 3);
+}
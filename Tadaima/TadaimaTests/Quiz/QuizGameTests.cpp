@@ -3,6 +3,7 @@
 #include "gui/quiz/MultipleChoiceQuiz.h"
 #include "Tools/Logger.h"
 #include "gui/quiz/QuizType.h"
+#include <set>
 
 using namespace tadaima;
 using namespace tadaima::gui::quiz;
@@ -29,14 +30,14 @@ protected:
 TEST_F(QuizGameTest, InitializeQuizGame)
 {
 
-    MultipleChoiceQuiz quizGame(quiz::WordType::BaseWord, quiz::WordType::Romaji, lessons, logger);
+    MultipleChoiceQuiz quizGame(makeMultipleChoiceSession<TranslationField, RomajiField, SequentialSelection>, lessons, logger);
     quizGame.start();
     EXPECT_EQ(quizGame.getCurrentOptions().size(), 4);
 }
 
 TEST_F(QuizGameTest, StartQuiz)
 {
-    MultipleChoiceQuiz quizGame(quiz::WordType::BaseWord, quiz::WordType::Romaji, lessons, logger);
+    MultipleChoiceQuiz quizGame(makeMultipleChoiceSession<TranslationField, RomajiField, SequentialSelection>, lessons, logger);
     quizGame.start();
     EXPECT_FALSE(quizGame.isFinished());
     EXPECT_EQ(quizGame.getCurrentOptions().size(), 4);
@@ -44,7 +45,7 @@ TEST_F(QuizGameTest, StartQuiz)
 
 TEST_F(QuizGameTest, AdvanceQuiz)
 {
-    MultipleChoiceQuiz quizGame(quiz::WordType::BaseWord, quiz::WordType::Romaji, lessons, logger);
+    MultipleChoiceQuiz quizGame(makeMultipleChoiceSession<TranslationField, RomajiField, SequentialSelection>, lessons, logger);
     quizGame.start();
     quizGame.advance('a');
     EXPECT_EQ(quizGame.getCurrentOptions().size(), 4);
@@ -52,7 +53,7 @@ TEST_F(QuizGameTest, AdvanceQuiz)
 
 TEST_F(QuizGameTest, QuizFinished)
 {
-    MultipleChoiceQuiz quizGame(quiz::WordType::BaseWord, quiz::WordType::Romaji, lessons, logger);
+    MultipleChoiceQuiz quizGame(makeMultipleChoiceSession<TranslationField, RomajiField, SequentialSelection>, lessons, logger);
     quizGame.start();
     for( size_t i = 0; i < lessons.size(); ++i )
     {
@@ -60,3 +61,85 @@ TEST_F(QuizGameTest, QuizFinished)
     }
     EXPECT_TRUE(quizGame.isFinished());
 }
+
+TEST_F(QuizGameTest, FewDistinctAnswersGiveDistinctOptions)
+{
+    std::vector<Lesson> sameAnswers = { Lesson{ 1, "Main Name", "Sub Name", {} } };
+    for( int id = 1; id <= 6; ++id )
+    {
+        sameAnswers.front().words.push_back(Word{ id, "kana" + std::to_string(id), id % 2 == 0 ? "even" : "odd", "romaji", "", {} });
+    }
+
+    MultipleChoiceQuiz quizGame(makeMultipleChoiceSession<KanaField, TranslationField, SequentialSelection>, sameAnswers, logger);
+    quizGame.start();
+    while( !quizGame.isFinished() )
+    {
+        const std::vector<std::string> options = quizGame.getCurrentOptions();
+        ASSERT_EQ(options.size(), MultipleChoiceQuiz::OPTION_COUNT);
+        EXPECT_EQ(std::set<std::string>(options.begin(), options.end()).size(), options.size());
+        EXPECT_EQ(std::count(options.begin(), options.end(), quizGame.getCurrentWordId() % 2 == 0 ? "even" : "odd"), 1);
+        quizGame.advance(static_cast<char>('a' + quizGame.getCorrectAnswerIndex()));
+    }
+    EXPECT_NE(quizGame.getResults().find("6 out of 6"), std::string::npos);
+}
+
+TEST_F(QuizGameTest, AdaptiveOrderKeepsTheSessionLength)
+{
+    MultipleChoiceQuiz quizGame(makeMultipleChoiceSession<TranslationField, RomajiField, AdaptiveSelection>, lessons, logger, QuizOrder::Adaptive);
+    quizGame.start();
+
+    // Words are drawn again after wrong answers, so every question may ask any word
+    for( int question = 0; question < quizGame.getTotalQuestions(); ++question )
+    {
+        ASSERT_FALSE(quizGame.isFinished());
+        const int wordId = quizGame.getCurrentWordId();
+        EXPECT_TRUE(wordId == 1 || wordId == 2);
+        const std::vector<std::string> options = quizGame.getCurrentOptions();
+        EXPECT_EQ(options[quizGame.getCorrectAnswerIndex()], "romaji" + std::to_string(wordId));
+        quizGame.advance(static_cast<char>('a' + (quizGame.getCorrectAnswerIndex() + 1) % 4));
+    }
+    EXPECT_TRUE(quizGame.isFinished());
+    EXPECT_EQ(quizGame.getCurrentWordId(), -1);
+}
+
+TEST_F(QuizGameTest, ConfusedWordsAreOfferedAsDistractors)
+{
+    std::vector<Lesson> deck = { Lesson{ 1, "Main Name", "Sub Name", {} } };
+    for( int id = 1; id <= 40; ++id )
+    {
+        deck.front().words.push_back(Word{ id, "kana" + std::to_string(id), "translation" + std::to_string(id), "romaji", "", {} });
+    }
+
+    // Every word was mixed up with the two words after it; 40 is mixed up with a word outside the quiz
+    review::ConfusionTable confusions;
+    for( int id = 1; id < 40; ++id )
+    {
+        confusions.record(id, id % 40 + 1, 100);
+        confusions.record(id, (id + 1) % 40 + 1, 100);
+    }
+    confusions.record(40, 99, 100);
+
+    MultipleChoiceQuiz quizGame(makeMultipleChoiceSession<KanaField, TranslationField, SequentialSelection>, deck, logger, QuizOrder::Random, &confusions);
+    quizGame.start();
+    while( !quizGame.isFinished() )
+    {
+        const int wordId = quizGame.getCurrentWordId();
+        const std::vector<std::string> options = quizGame.getCurrentOptions();
+        std::set<int> optionWords;
+        for( std::size_t option = 0; option < options.size(); ++option )
+        {
+            const int optionWordId = quizGame.getOptionWordId(static_cast<char>('a' + option));
+            EXPECT_EQ(options[option], "translation" + std::to_string(optionWordId));
+            optionWords.insert(optionWordId);
+        }
+
+        EXPECT_EQ(quizGame.getOptionWordId(static_cast<char>('a' + quizGame.getCorrectAnswerIndex())), wordId);
+        if( wordId < 40 )
+        {
+            EXPECT_TRUE(optionWords.count(wordId % 40 + 1));
+            EXPECT_TRUE(optionWords.count((wordId + 1) % 40 + 1));
+        }
+        EXPECT_FALSE(optionWords.count(99));
+        quizGame.advance(static_cast<char>('a' + quizGame.getCorrectAnswerIndex()));
+    }
+}
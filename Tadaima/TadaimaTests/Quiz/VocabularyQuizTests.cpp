@@ -14,14 +14,27 @@ public:
     }
 };
 
-std::vector<QuizWord> convertWordsToQuizWords(const std::vector<Word>& words)
+// Words are asked in their order and answered in romaji
+using OrderedQuiz = VocabularyEngine<TranslationField, RomajiField, SequentialSelection>;
+
+std::vector<Word> makeWords(int count)
 {
-    std::vector<QuizWord> quizWords;
-    for( const auto& word : words )
+    std::vector<Word> words;
+    for( int i = 1; i <= count; ++i )
     {
-        quizWords.push_back(QuizWord(word.id, word.romaji));
+        words.push_back(Word{ i, "", "", "w" + std::to_string(i), "", {} });
     }
-    return quizWords;
+    return words;
+}
+
+template<typename Quiz>
+std::unique_ptr<VocabularyQuiz> restoreSnapshot(const VocabularyQuiz& quiz, const std::string& buffer)
+{
+    binary::Reader reader(buffer);
+    auto restored = std::make_unique<Quiz>(quiz.getWords(), 1);
+    restored->restore(reader);
+    EXPECT_TRUE(reader.atEnd());
+    return restored;
 }
 
 TEST(VocabularyQuizTest, InitializeQuiz)
@@ -30,12 +43,10 @@ TEST(VocabularyQuizTest, InitializeQuiz)
     Word word1{ 1, "ka", "a", "a", "Example sentence 1", {"tag1"} };
     Word word2{ 2, "ki", "i", "i", "Example sentence 2", {"tag2"} };
 
-    // Convert to QuizWords
     std::vector<Word> words = { word1, word2 };
-    std::vector<QuizWord> flashcards = convertWordsToQuizWords(words);
 
     // Initialize the quiz with required correct answers set to 3
-    VocabularyQuiz quiz(flashcards, 3, false);
+    OrderedQuiz quiz(words, 3);
 
     // Check initial state
     EXPECT_FALSE(quiz.isQuizComplete());
@@ -47,53 +58,51 @@ TEST(VocabularyQuizTest, AdvanceQuiz)
     Word word1{ 1, "ka", "a", "a", "Example sentence 1", {"tag1"} };
     Word word2{ 2, "ki", "i", "i", "Example sentence 2", {"tag2"} };
 
-    // Convert to QuizWords
     std::vector<Word> words = { word1, word2 };
-    std::vector<QuizWord> flashcards = convertWordsToQuizWords(words);
 
     // Initialize the quiz with required correct answers set to 3 and shuffling disabled
-    VocabularyQuiz quiz(flashcards, 2, false);
+    OrderedQuiz quiz(words, 2);
 
     // Advance the quiz with correct and incorrect answers
     quiz.advance("wrong"); // Incorrect answer for word1
-    EXPECT_EQ(quiz.getStatistics().at(1).badAttempts, 1);
-    EXPECT_EQ(quiz.getStatistics().at(1).learnt, false);
+    EXPECT_EQ(quiz.getStatistics().at(0).badAttempts, 1);
+    EXPECT_EQ(quiz.getStatistics().at(0).learnt, false);
 
     quiz.advance("wrong"); // Incorrect answer for word2
-    EXPECT_EQ(quiz.getStatistics().at(2).badAttempts, 1);
-    EXPECT_EQ(quiz.getStatistics().at(2).learnt, false);
-
-    quiz.advance("a"); // Correct answer for word1
     EXPECT_EQ(quiz.getStatistics().at(1).badAttempts, 1);
     EXPECT_EQ(quiz.getStatistics().at(1).learnt, false);
 
-    quiz.advance("i"); // Correct answer for word2
-    EXPECT_EQ(quiz.getStatistics().at(2).badAttempts, 1);
-    EXPECT_EQ(quiz.getStatistics().at(2).learnt, false);
-
     quiz.advance("a"); // Correct answer for word1
+    EXPECT_EQ(quiz.getStatistics().at(0).badAttempts, 1);
+    EXPECT_EQ(quiz.getStatistics().at(0).learnt, false);
+
+    quiz.advance("i"); // Correct answer for word2
     EXPECT_EQ(quiz.getStatistics().at(1).badAttempts, 1);
     EXPECT_EQ(quiz.getStatistics().at(1).learnt, false);
 
+    quiz.advance("a"); // Correct answer for word1
+    EXPECT_EQ(quiz.getStatistics().at(0).badAttempts, 1);
+    EXPECT_EQ(quiz.getStatistics().at(0).learnt, false);
+
     quiz.advance("wrong"); // Incorrect answer for word2
-    EXPECT_EQ(quiz.getStatistics().at(2).badAttempts, 2);
-    EXPECT_EQ(quiz.getStatistics().at(2).learnt, false);
+    EXPECT_EQ(quiz.getStatistics().at(1).badAttempts, 2);
+    EXPECT_EQ(quiz.getStatistics().at(1).learnt, false);
 
     quiz.advance("a"); // Correct answer for word1
-    EXPECT_EQ(quiz.getStatistics().at(1).badAttempts, 1);
-    EXPECT_EQ(quiz.getStatistics().at(1).learnt, true);
+    EXPECT_EQ(quiz.getStatistics().at(0).badAttempts, 1);
+    EXPECT_EQ(quiz.getStatistics().at(0).learnt, true);
 
     quiz.advance("i"); // Correct answer for word2
-    EXPECT_EQ(quiz.getStatistics().at(2).badAttempts, 2);
-    EXPECT_EQ(quiz.getStatistics().at(2).learnt, false);
+    EXPECT_EQ(quiz.getStatistics().at(1).badAttempts, 2);
+    EXPECT_EQ(quiz.getStatistics().at(1).learnt, false);
 
     quiz.advance("i"); // Correct answer for word2
-    EXPECT_EQ(quiz.getStatistics().at(2).badAttempts, 2);
-    EXPECT_EQ(quiz.getStatistics().at(2).learnt, false);
+    EXPECT_EQ(quiz.getStatistics().at(1).badAttempts, 2);
+    EXPECT_EQ(quiz.getStatistics().at(1).learnt, false);
 
     quiz.advance("i"); // Correct answer for word2
-    EXPECT_EQ(quiz.getStatistics().at(2).badAttempts, 2);
-    EXPECT_EQ(quiz.getStatistics().at(2).learnt, true);
+    EXPECT_EQ(quiz.getStatistics().at(1).badAttempts, 2);
+    EXPECT_EQ(quiz.getStatistics().at(1).learnt, true);
 }
 
 TEST(VocabularyQuizTest, QuizCompletion)
@@ -102,12 +111,10 @@ TEST(VocabularyQuizTest, QuizCompletion)
     Word word1{ 1, "ka", "a", "a", "Example sentence 1", {"tag1"} };
     Word word2{ 2, "ki", "i", "i", "Example sentence 2", {"tag2"} };
 
-    // Convert to QuizWords
     std::vector<Word> words = { word1, word2 };
-    std::vector<QuizWord> flashcards = convertWordsToQuizWords(words);
 
     // Initialize the quiz with required correct answers set to 3 and shuffling disabled
-    VocabularyQuiz quiz(flashcards, 3, false);
+    OrderedQuiz quiz(words, 3);
 
     // Simulate correct answers to complete the quiz
     for( int i = 0; i < 3; ++i )
@@ -125,12 +132,10 @@ TEST(VocabularyQuizTest, DecrementOnIncorrectAnswer)
     Word word1{ 1, "ka", "a", "a", "Example sentence 1", {"tag1"} };
     Word word2{ 2, "ki", "i", "i", "Example sentence 2", {"tag2"} };
 
-    // Convert to QuizWords
     std::vector<Word> words = { word1, word2 };
-    std::vector<QuizWord> flashcards = convertWordsToQuizWords(words);
 
     // Initialize the quiz with required correct answers set to 3 and shuffling disabled
-    VocabularyQuiz quiz(flashcards, 3, false);
+    OrderedQuiz quiz(words, 3);
 
     // Answer correctly twice
     quiz.advance("a"); // Correct answer for word1
@@ -140,19 +145,19 @@ TEST(VocabularyQuizTest, DecrementOnIncorrectAnswer)
 
     // Answer incorrectly and check the decrement
     quiz.advance("wrong"); // Incorrect answer for word1
+    EXPECT_EQ(quiz.getStatistics().at(0).badAttempts, 1);
+    EXPECT_EQ(quiz.getStatistics().at(0).learnt, false);
+    quiz.advance("wrong"); // Incorrect answer for word2
     EXPECT_EQ(quiz.getStatistics().at(1).badAttempts, 1);
     EXPECT_EQ(quiz.getStatistics().at(1).learnt, false);
-    quiz.advance("wrong"); // Incorrect answer for word2
-    EXPECT_EQ(quiz.getStatistics().at(2).badAttempts, 1);
-    EXPECT_EQ(quiz.getStatistics().at(2).learnt, false);
 
     // Answer correctly again
     quiz.advance("a"); // Correct answer for word1
     quiz.advance("i"); // Correct answer for word2
+    EXPECT_EQ(quiz.getStatistics().at(0).badAttempts, 1);
+    EXPECT_EQ(quiz.getStatistics().at(0).learnt, false);
     EXPECT_EQ(quiz.getStatistics().at(1).badAttempts, 1);
     EXPECT_EQ(quiz.getStatistics().at(1).learnt, false);
-    EXPECT_EQ(quiz.getStatistics().at(2).badAttempts, 1);
-    EXPECT_EQ(quiz.getStatistics().at(2).learnt, false);
 }
 
 TEST(VocabularyQuizTest, NoDecrementBelowZero)
@@ -161,12 +166,10 @@ TEST(VocabularyQuizTest, NoDecrementBelowZero)
     Word word1{ 1, "ka", "a", "a", "Example sentence 1", {"tag1"} };
     Word word2{ 2, "ki", "i", "i", "Example sentence 2", {"tag2"} };
 
-    // Convert to QuizWords
     std::vector<Word> words = { word1, word2 };
-    std::vector<QuizWord> flashcards = convertWordsToQuizWords(words);
 
     // Initialize the quiz with required correct answers set to 3 and shuffling disabled
-    VocabularyQuiz quiz(flashcards, 3, false);
+    OrderedQuiz quiz(words, 3);
 
     // Answer incorrectly multiple times
     for( int i = 0; i < 5; ++i )
@@ -176,11 +179,11 @@ TEST(VocabularyQuizTest, NoDecrementBelowZero)
     }
 
     // Check that the correct answers count does not go below zero
-    EXPECT_EQ(quiz.getStatistics().at(1).badAttempts, 5);
-    EXPECT_EQ(quiz.getStatistics().at(1).learnt, false);
+    EXPECT_EQ(quiz.getStatistics().at(0).badAttempts, 5);
+    EXPECT_EQ(quiz.getStatistics().at(0).learnt, false);
     quiz.advance("a"); // Correct answer for word1
-    EXPECT_EQ(quiz.getStatistics().at(1).badAttempts, 5);
-    EXPECT_EQ(quiz.getStatistics().at(1).learnt, false);
+    EXPECT_EQ(quiz.getStatistics().at(0).badAttempts, 5);
+    EXPECT_EQ(quiz.getStatistics().at(0).learnt, false);
 }
 
 TEST(VocabularyQuizTest, CompletionWithMixedAnswers)
@@ -189,12 +192,10 @@ TEST(VocabularyQuizTest, CompletionWithMixedAnswers)
     Word word1{ 1, "ka", "a", "a", "Example sentence 1", {"tag1"} };
     Word word2{ 2, "ki", "i", "i", "Example sentence 2", {"tag2"} };
 
-    // Convert to QuizWords
     std::vector<Word> words = { word1, word2 };
-    std::vector<QuizWord> flashcards = convertWordsToQuizWords(words);
 
     // Initialize the quiz with required correct answers set to 3 and shuffling disabled
-    VocabularyQuiz quiz(flashcards, 2, false);
+    OrderedQuiz quiz(words, 2);
 
     // Answer with a mix of correct and incorrect answers
     quiz.advance("wrong"); // Incorrect answer for word1
@@ -208,8 +209,128 @@ TEST(VocabularyQuizTest, CompletionWithMixedAnswers)
     quiz.advance("a"); // Correct answer for word2
 
     EXPECT_TRUE(quiz.isQuizComplete());
+    EXPECT_EQ(quiz.getStatistics().at(0).badAttempts, 1);
+    EXPECT_EQ(quiz.getStatistics().at(0).learnt, true);
     EXPECT_EQ(quiz.getStatistics().at(1).badAttempts, 1);
     EXPECT_EQ(quiz.getStatistics().at(1).learnt, true);
-    EXPECT_EQ(quiz.getStatistics().at(2).badAttempts, 1);
-    EXPECT_EQ(quiz.getStatistics().at(2).learnt, true);
+}
+
+TEST(VocabularyQuizTest, SnapshotRestoresShuffledSession)
+{
+    using ShuffledQuiz = VocabularyEngine<TranslationField, RomajiField, RandomSelection>;
+    ShuffledQuiz quiz(makeWords(1000), 2);
+    for( int i = 0; i < 300; ++i )
+    {
+        quiz.advance(i % 3 == 0 ? std::string("wrong") : quiz.getExpectedAnswer());
+    }
+
+    std::string buffer;
+    quiz.serialize(buffer);
+    std::unique_ptr<VocabularyQuiz> restored = restoreSnapshot<ShuffledQuiz>(quiz, buffer);
+
+    EXPECT_EQ(restored->getNumberOflashcards(), quiz.getNumberOflashcards());
+    EXPECT_EQ(restored->getLearntWords(), quiz.getLearntWords());
+    EXPECT_EQ(restored->getCurrentWord().id, quiz.getCurrentWord().id);
+    ASSERT_EQ(restored->getStatistics().size(), quiz.getStatistics().size());
+    for( std::size_t index = 0; index < quiz.getStatistics().size(); ++index )
+    {
+        EXPECT_EQ(restored->getStatistics()[index].goodAttempts, quiz.getStatistics()[index].goodAttempts);
+        EXPECT_EQ(restored->getStatistics()[index].badAttempts, quiz.getStatistics()[index].badAttempts);
+        EXPECT_EQ(restored->getStatistics()[index].learnt, quiz.getStatistics()[index].learnt);
+    }
+
+    std::string again;
+    restored->serialize(again);
+    EXPECT_EQ(again, buffer);
+}
+
+TEST(VocabularyQuizTest, SnapshotContinuesInOrder)
+{
+    std::vector<Word> words = { Word{ 1, "ka", "a", "a", "", {} }, Word{ 2, "ki", "i", "i", "", {} }, Word{ 3, "ku", "u", "u", "", {} } };
+    OrderedQuiz quiz(words, 1);
+    quiz.advance("a");
+    quiz.advance("wrong");
+
+    std::string buffer;
+    quiz.serialize(buffer);
+    std::unique_ptr<VocabularyQuiz> restored = restoreSnapshot<OrderedQuiz>(quiz, buffer);
+
+    const std::vector<std::string> answers = { "u", "i", "i" };
+    for( const auto& answer : answers )
+    {
+        EXPECT_EQ(restored->getCurrentWord().id, quiz.getCurrentWord().id);
+        EXPECT_EQ(restored->advance(answer), quiz.advance(answer));
+    }
+    EXPECT_EQ(restored->isQuizComplete(), quiz.isQuizComplete());
+}
+
+TEST(VocabularyQuizTest, TruncatedSnapshotIsRejected)
+{
+    OrderedQuiz quiz(makeWords(2), 2);
+    quiz.advance("w1");
+
+    std::string buffer;
+    quiz.serialize(buffer);
+    buffer.resize(buffer.size() - 3);
+
+    binary::Reader reader(buffer);
+    OrderedQuiz restored(quiz.getWords(), 2);
+    EXPECT_THROW(restored.restore(reader), std::runtime_error);
+}
+
+TEST(VocabularyQuizTest, SnapshotOfOtherWordsIsRejected)
+{
+    OrderedQuiz quiz(makeWords(3), 2);
+    quiz.advance("w1");
+
+    std::string buffer;
+    quiz.serialize(buffer);
+
+    binary::Reader reader(buffer);
+    OrderedQuiz restored(makeWords(2), 2);
+    EXPECT_THROW(restored.restore(reader), std::runtime_error);
+}
+
+TEST(VocabularyQuizTest, OrderedQuizSkipsLearntWords)
+{
+    std::vector<Word> words = { Word{ 1, "", "", "a", "", {} }, Word{ 2, "", "", "i", "", {} }, Word{ 3, "", "", "u", "", {} } };
+    OrderedQuiz quiz(words, 1);
+
+    EXPECT_TRUE(quiz.advance("a"));
+    EXPECT_FALSE(quiz.advance("wrong"));
+    EXPECT_TRUE(quiz.advance("u"));
+    EXPECT_EQ(quiz.getLearntWords(), 2);
+
+    // Only the word answered wrong is left, so it is asked until it is learnt
+    EXPECT_EQ(quiz.getCurrentWord().id, 2);
+    EXPECT_TRUE(quiz.advance("i"));
+    EXPECT_EQ(quiz.getCurrentWord().id, 2);
+    EXPECT_TRUE(quiz.advance("i"));
+    EXPECT_TRUE(quiz.isQuizComplete());
+    EXPECT_THROW(quiz.getCurrentWord(), std::invalid_argument);
+}
+
+TEST(VocabularyQuizTest, AdaptiveQuizNeverAsksLearntWords)
+{
+    using AdaptiveQuiz = VocabularyEngine<TranslationField, RomajiField, AdaptiveSelection>;
+    AdaptiveQuiz quiz(makeWords(30), 2);
+
+    // Word 1 is answered wrong until the others are learnt
+    for( int answer = 0; answer < 1000 && !quiz.isQuizComplete(); ++answer )
+    {
+        ASSERT_FALSE(quiz.getStatistics()[quiz.getCurrentIndex()].learnt);
+        quiz.advance(quiz.getCurrentWord().id == 1 && quiz.getLearntWords() < 29 ? std::string("wrong") : quiz.getExpectedAnswer());
+
+        if( answer == 20 )
+        {
+            std::string buffer;
+            quiz.serialize(buffer);
+            std::unique_ptr<VocabularyQuiz> restored = restoreSnapshot<AdaptiveQuiz>(quiz, buffer);
+            std::string again;
+            restored->serialize(again);
+            EXPECT_EQ(again, buffer);
+            EXPECT_EQ(restored->getCurrentWord().id, quiz.getCurrentWord().id);
+        }
+    }
+    EXPECT_TRUE(quiz.isQuizComplete());
 }
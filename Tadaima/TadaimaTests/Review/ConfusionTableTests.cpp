@@ -0,0 +1,77 @@
+#include "gtest/gtest.h"
+#include "review/ConfusionTable.h"
+
+using namespace tadaima::review;
+
+TEST(ConfusionTableTest, CountsPicksMostFrequentFirst)
+{
+    ConfusionTable table;
+    table.record(1, 2, 10);
+    table.record(1, 3, 20);
+    table.record(1, 3, 30);
+    table.record(4, 2, 40);
+    table.record(1, 1, 50);
+    table.record(1, -1, 50);
+
+    const std::vector<Confusion>& confusions = table.confusedWith(1);
+    ASSERT_EQ(confusions.size(), 2);
+    EXPECT_EQ(confusions[0].chosenId, 3);
+    EXPECT_EQ(confusions[0].count, 2);
+    EXPECT_EQ(confusions[0].lastSeen, 30);
+    EXPECT_EQ(confusions[1].chosenId, 2);
+    EXPECT_TRUE(table.confusedWith(2).empty());
+    EXPECT_EQ(table.size(), 3);
+
+    const std::vector<Confusion> top = table.mostConfused(2);
+    ASSERT_EQ(top.size(), 2);
+    EXPECT_EQ(top[0].chosenId, 3);
+    EXPECT_EQ(top[1].targetId, 4);
+}
+
+TEST(ConfusionTableTest, NewPairReplacesTheLeastFrequentAndOldest)
+{
+    ConfusionTable table;
+    for( int chosen = 0; chosen < static_cast<int>(ConfusionTable::MAX_PER_WORD); ++chosen )
+    {
+        table.record(100, chosen, chosen);
+        table.record(100, chosen, chosen);
+    }
+    table.record(100, 0, 50);
+
+    // Chosen word 1 has the lowest count and the oldest pick of the words picked twice
+    table.record(100, 42, 60);
+    const std::vector<Confusion>& confusions = table.confusedWith(100);
+    ASSERT_EQ(confusions.size(), ConfusionTable::MAX_PER_WORD);
+    EXPECT_EQ(confusions.front().chosenId, 0);
+    EXPECT_EQ(confusions.back().chosenId, 42);
+    for( const auto& confusion : confusions )
+    {
+        EXPECT_NE(confusion.chosenId, 1);
+    }
+    EXPECT_EQ(table.size(), ConfusionTable::MAX_PER_WORD);
+}
+
+TEST(ConfusionTableTest, LoadKeepsTheSamePairsAsRecording)
+{
+    ConfusionTable recorded;
+    for( int pick = 0; pick < 40; ++pick )
+    {
+        recorded.record(pick % 3, 10 + pick % 11, pick);
+    }
+
+    ConfusionTable loaded;
+    loaded.load(recorded.pairs());
+    EXPECT_EQ(loaded.size(), recorded.size());
+    for( int target = 0; target < 3; ++target )
+    {
+        const std::vector<Confusion>& expected = recorded.confusedWith(target);
+        const std::vector<Confusion>& actual = loaded.confusedWith(target);
+        ASSERT_EQ(actual.size(), expected.size());
+        EXPECT_LE(actual.size(), ConfusionTable::MAX_PER_WORD);
+        for( std::size_t index = 0; index < actual.size(); ++index )
+        {
+            EXPECT_EQ(actual[index].chosenId, expected[index].chosenId);
+            EXPECT_EQ(actual[index].count, expected[index].count);
+        }
+    }
+}
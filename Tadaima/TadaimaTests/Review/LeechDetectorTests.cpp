@@ -0,0 +1,61 @@
+#include "gtest/gtest.h"
+#include "review/LeechDetector.h"
+
+using namespace tadaima::review;
+
+namespace
+{
+    MemoryState withLapses(int lapses)
+    {
+        MemoryState state;
+        state.wordId = 1;
+        state.lapses = lapses;
+        state.reviewCount = lapses * 2;
+        return state;
+    }
+}
+
+TEST(LeechDetectorTest, FlagsWordWhenLapsesReachThreshold)
+{
+    LeechDetector detector({ 3, 0 });
+
+    EXPECT_FALSE(detector.becameLeech(withLapses(1), withLapses(2)));
+    EXPECT_TRUE(detector.becameLeech(withLapses(2), withLapses(3)));
+    EXPECT_FALSE(detector.becameLeech(withLapses(3), withLapses(4)));
+    EXPECT_TRUE(detector.isLeech(withLapses(4)));
+    EXPECT_FALSE(detector.isLeech(withLapses(2)));
+}
+
+TEST(LeechDetectorTest, SuccessfulReviewNeverFlags)
+{
+    LeechDetector detector({ 3, 1 });
+
+    EXPECT_FALSE(detector.becameLeech(withLapses(3), withLapses(3)));
+    EXPECT_FALSE(detector.becameLeech(withLapses(5), withLapses(5)));
+}
+
+TEST(LeechDetectorTest, FlagsAgainEveryRepeatInterval)
+{
+    LeechDetector detector({ 4, 2 });
+
+    std::vector<int> flagged;
+    for( int lapses = 1; lapses <= 10; ++lapses )
+    {
+        if( detector.becameLeech(withLapses(lapses - 1), withLapses(lapses)) )
+        {
+            flagged.push_back(lapses);
+        }
+    }
+
+    EXPECT_EQ(flagged, std::vector<int>({ 4, 6, 8, 10 }));
+}
+
+TEST(LeechDetectorTest, ClampsInvalidThresholds)
+{
+    LeechDetector detector({ 0, -3 });
+
+    EXPECT_EQ(detector.getOptions().lapseThreshold, 1);
+    EXPECT_EQ(detector.getOptions().repeatInterval, 0);
+    EXPECT_TRUE(detector.becameLeech(withLapses(0), withLapses(1)));
+    EXPECT_FALSE(detector.becameLeech(withLapses(1), withLapses(2)));
+}
@@ -0,0 +1,126 @@
+#include "gtest/gtest.h"
+#include "review/ParameterOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace tadaima::review;
+
+namespace
+{
+    std::vector<ReviewRecord> simulateHistory(const MemoryModelParameters& parameters, int words, int reviewsPerWord, unsigned int seed)
+    {
+        MemoryModel model(parameters);
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+        std::vector<ReviewRecord> reviews;
+        for( int wordId = 1; wordId <= words; ++wordId )
+        {
+            MemoryState state;
+            int64_t timestamp = 1700000000;
+            for( int review = 0; review < reviewsPerWord; ++review )
+            {
+                const double elapsedDays = static_cast<double>(timestamp - state.lastReview) / MemoryModel::SECONDS_PER_DAY;
+                const bool correct = review == 0 ? uniform(rng) < 0.8 : uniform(rng) < model.retrievability(state, elapsedDays);
+
+                ReviewRecord record{ wordId, timestamp, correct };
+                reviews.push_back(record);
+                model.applyReview(state, record);
+                timestamp += static_cast<int64_t>(model.nextInterval(state) * MemoryModel::SECONDS_PER_DAY * (0.5 + uniform(rng)));
+            }
+        }
+        return reviews;
+    }
+
+    double replayLoss(const std::vector<ReviewRecord>& reviews, const MemoryModelParameters& parameters)
+    {
+        MemoryModel model(parameters);
+        MemoryState state;
+        double loss = 0.0;
+        int predictions = 0;
+        for( const auto& record : reviews )
+        {
+            if( record.wordId != state.wordId )
+            {
+                state = MemoryState();
+            }
+            else
+            {
+                const double elapsedDays = static_cast<double>(record.timestamp - state.lastReview) / MemoryModel::SECONDS_PER_DAY;
+                const double probability = std::clamp(model.retrievability(state, elapsedDays), 1e-6, 1.0 - 1e-6);
+                loss -= record.correct ? std::log(probability) : std::log(1.0 - probability);
+                predictions++;
+            }
+            model.applyReview(state, record);
+        }
+        return loss / predictions;
+    }
+
+    MemoryModelParameters trueParameters()
+    {
+        MemoryModelParameters parameters;
+        parameters.initialStability = 3.0;
+        parameters.growthRate = 1.5;
+        parameters.stabilityDecay = 0.3;
+        parameters.retrievabilityGain = 1.5;
+        parameters.lapseFactor = 0.2;
+        return parameters;
+    }
+}
+
+TEST(ParameterOptimizerTest, LossMatchesMemoryModelReplay)
+{
+    auto reviews = simulateHistory(trueParameters(), 200, 8, 1);
+    MemoryModelParameters parameters;
+
+    EXPECT_NEAR(ParameterOptimizer(1).loss(reviews, parameters), replayLoss(reviews, parameters), 1e-9);
+}
+
+TEST(ParameterOptimizerTest, EmptyHistoryKeepsParameters)
+{
+    MemoryModelParameters initial;
+    OptimizationResult result = ParameterOptimizer(1).fit({}, initial);
+
+    EXPECT_EQ(result.predictions, 0u);
+    EXPECT_DOUBLE_EQ(result.parameters.growthRate, initial.growthRate);
+}
+
+TEST(ParameterOptimizerTest, FitApproachesLossOfTrueParameters)
+{
+    auto reviews = simulateHistory(trueParameters(), 2000, 8, 2);
+    MemoryModelParameters initial;
+    initial.desiredRetention = 0.85;
+
+    OptimizationResult result = ParameterOptimizer(1).fit(reviews, initial);
+    const double trueLoss = ParameterOptimizer(1).loss(reviews, trueParameters());
+
+    EXPECT_LT(result.finalLoss, result.initialLoss);
+    EXPECT_LT(result.finalLoss, trueLoss + 0.005);
+    EXPECT_NEAR(result.parameters.lapseFactor, 0.2, 0.1);
+    EXPECT_DOUBLE_EQ(result.parameters.desiredRetention, 0.85);
+}
+
+TEST(ParameterOptimizerTest, ResultDoesNotDependOnThreadCount)
+{
+    auto reviews = simulateHistory(trueParameters(), 3000, 6, 3);
+    OptimizerOptions options;
+    options.iterations = 20;
+
+    OptimizationResult single = ParameterOptimizer(1).fit(reviews, MemoryModelParameters(), options);
+    OptimizationResult parallel = ParameterOptimizer(4).fit(reviews, MemoryModelParameters(), options);
+
+    EXPECT_NEAR(single.finalLoss, parallel.finalLoss, 1e-9);
+    EXPECT_NEAR(single.parameters.growthRate, parallel.parameters.growthRate, 1e-6);
+}
+
+TEST(ParameterOptimizerTest, CancelStopsFitting)
+{
+    auto reviews = simulateHistory(trueParameters(), 100, 5, 4);
+    std::atomic<bool> cancel = true;
+
+    OptimizationResult result = ParameterOptimizer(1).fit(reviews, MemoryModelParameters(), OptimizerOptions(), nullptr, &cancel);
+
+    EXPECT_TRUE(result.cancelled);
+    EXPECT_EQ(result.iterations, 0);
+}
@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+#include "review/MemoryModel.h"
+#include "review/RetentionForecaster.h"
+
+using namespace tadaima::review;
+
+namespace
+{
+    std::vector<MemoryState> makeStates(int count, int64_t now)
+    {
+        MemoryModel model;
+        std::vector<MemoryState> states;
+        for( int i = 0; i < count; ++i )
+        {
+            MemoryState state;
+            state.wordId = i + 1;
+            model.applyReview(state, { state.wordId, now - static_cast<int64_t>(MemoryModel::SECONDS_PER_DAY) * (i % 7 + 2), i % 5 != 0 });
+            states.push_back(state);
+        }
+        return states;
+    }
+}
+
+TEST(MemoryModelTest, RetrievabilityDecaysOverTime)
+{
+    MemoryModel model;
+    MemoryState state;
+    model.applyReview(state, true, 0.0);
+
+    EXPECT_DOUBLE_EQ(model.retrievability(state, 0.0), 1.0);
+    EXPECT_NEAR(model.retrievability(state, state.stability), 0.9, 1e-9);
+    EXPECT_GT(model.retrievability(state, 1.0), model.retrievability(state, 10.0));
+}
+
+TEST(MemoryModelTest, SuccessIncreasesStabilityAndFailureDecreasesIt)
+{
+    MemoryModel model;
+    MemoryState state;
+    model.applyReview(state, true, 0.0);
+
+    double stability = state.stability;
+    model.applyReview(state, true, stability);
+    EXPECT_GT(state.stability, stability);
+    EXPECT_EQ(state.reviewCount, 2);
+
+    stability = state.stability;
+    model.applyReview(state, false, stability);
+    EXPECT_LT(state.stability, stability);
+    EXPECT_EQ(state.lapses, 1);
+}
+
+TEST(RetentionForecasterTest, ForecastHasRequestedLength)
+{
+    const int64_t now = 1700000000;
+    ForecastOptions options;
+    options.days = 14;
+    options.seed = 42;
+
+    Forecast forecast = RetentionForecaster(MemoryModel(), 1).forecast(makeStates(100, now), now, options);
+
+    ASSERT_EQ(forecast.expectedReviews.size(), 14u);
+    ASSERT_EQ(forecast.reviewsLow.size(), 14u);
+    ASSERT_EQ(forecast.reviewsHigh.size(), 14u);
+    ASSERT_EQ(forecast.expectedRetention.size(), 14u);
+    for( int day = 0; day < options.days; ++day )
+    {
+        EXPECT_LE(forecast.reviewsLow[day], forecast.expectedReviews[day]);
+        EXPECT_GE(forecast.reviewsHigh[day], forecast.expectedReviews[day]);
+        EXPECT_GE(forecast.expectedRetention[day], 0.0f);
+        EXPECT_LE(forecast.expectedRetention[day], 1.0f);
+    }
+}
+
+TEST(RetentionForecasterTest, ResultDoesNotDependOnThreadCount)
+{
+    const int64_t now = 1700000000;
+    ForecastOptions options;
+    options.seed = 7;
+
+    auto states = makeStates(2000, now);
+    Forecast single = RetentionForecaster(MemoryModel(), 1).forecast(states, now, options);
+    Forecast parallel = RetentionForecaster(MemoryModel(), 4).forecast(states, now, options);
+
+    EXPECT_EQ(single.expectedReviews, parallel.expectedReviews);
+    EXPECT_EQ(single.reviewsLow, parallel.reviewsLow);
+    EXPECT_EQ(single.reviewsHigh, parallel.reviewsHigh);
+    for( int day = 0; day < options.days; ++day )
+    {
+        EXPECT_NEAR(single.expectedRetention[day], parallel.expectedRetention[day], 1e-5);
+    }
+}
+
+TEST(RetentionForecasterTest, NewWordsAreIntroducedEachDay)
+{
+    ForecastOptions options;
+    options.days = 5;
+    options.newWords = 30;
+    options.newWordsPerDay = 10;
+    options.seed = 1;
+
+    Forecast forecast = RetentionForecaster(MemoryModel(), 1).forecast({}, 1700000000, options);
+
+    EXPECT_GE(forecast.expectedReviews[0], 10.0f);
+    EXPECT_GE(forecast.expectedReviews[1], 10.0f);
+    EXPECT_GE(forecast.expectedReviews[2], 10.0f);
+}
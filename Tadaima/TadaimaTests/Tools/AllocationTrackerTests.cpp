@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "tools/AllocationTracker.h"
+#include <cstdint>
+#include <memory>
+
+using namespace tadaima;
+
+TEST(AllocationTrackerTest, ScopesNestPerThread)
+{
+    EXPECT_EQ(AllocationTracker::currentTag(), AllocationTag::Untagged);
+    {
+        AllocationScope database(AllocationTag::Database);
+        EXPECT_EQ(AllocationTracker::currentTag(), AllocationTag::Database);
+        {
+            AllocationScope packages(AllocationTag::Packages);
+            EXPECT_EQ(AllocationTracker::currentTag(), AllocationTag::Packages);
+        }
+        EXPECT_EQ(AllocationTracker::currentTag(), AllocationTag::Database);
+    }
+    EXPECT_EQ(AllocationTracker::currentTag(), AllocationTag::Untagged);
+}
+
+TEST(AllocationTrackerTest, CountsPerTag)
+{
+    AllocationTracker::reset();
+    AllocationTracker::recordAllocation(AllocationTag::Quiz, 64);
+    AllocationTracker::recordAllocation(AllocationTag::Quiz, 32);
+    AllocationTracker::recordAllocation(AllocationTag::Gui, 16);
+    AllocationTracker::recordFree(AllocationTag::Quiz, 64);
+
+    const AllocationStats quiz = AllocationTracker::stats(AllocationTag::Quiz);
+    EXPECT_EQ(quiz.allocations, 2u);
+    EXPECT_EQ(quiz.bytes, 96u);
+    EXPECT_EQ(quiz.frees, 1u);
+    EXPECT_EQ(quiz.liveBytes(), 32u);
+    EXPECT_EQ(AllocationTracker::stats(AllocationTag::Gui).bytes, 16u);
+    EXPECT_EQ(AllocationTracker::stats(AllocationTag::Dictionary).allocations, 0u);
+
+    if( !AllocationTracker::ENABLED )
+    {
+        EXPECT_EQ(AllocationTracker::total().bytes, 112u);
+    }
+
+    AllocationTracker::reset();
+    EXPECT_EQ(AllocationTracker::stats(AllocationTag::Quiz).allocations, 0u);
+}
+
+TEST(AllocationTrackerTest, ReportListsEveryTag)
+{
+    const std::string report = AllocationTracker::report();
+    for( std::size_t index = 0; index < AllocationTracker::TAG_COUNT; ++index )
+    {
+        EXPECT_NE(report.find(AllocationTracker::tagName(static_cast<AllocationTag>(index))), std::string::npos);
+    }
+}
+
+TEST(AllocationTrackerTest, TracksOperatorNewInScope)
+{
+    if( !AllocationTracker::ENABLED )
+    {
+        GTEST_SKIP() << "Built without TADAIMA_TRACK_ALLOCATIONS.";
+    }
+
+    struct alignas(64) CacheLine
+    {
+        char bytes[64];
+    };
+
+    const AllocationStats before = AllocationTracker::stats(AllocationTag::Dictionary);
+    {
+        AllocationScope scope(AllocationTag::Dictionary);
+        auto plain = std::make_unique<int[]>(10);
+        auto aligned = std::make_unique<CacheLine>();
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(aligned.get()) % alignof(CacheLine), 0u);
+    }
+    const AllocationStats after = AllocationTracker::stats(AllocationTag::Dictionary);
+
+    EXPECT_EQ(after.allocations - before.allocations, 2u);
+    EXPECT_EQ(after.bytes - before.bytes, 10 * sizeof(int) + sizeof(CacheLine));
+    EXPECT_EQ(after.frees - before.frees, 2u);
+    EXPECT_EQ(after.liveBytes(), before.liveBytes());
+}
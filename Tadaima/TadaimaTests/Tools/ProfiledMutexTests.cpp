@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include "Tools/ProfiledMutex.h"
+#include <algorithm>
+#include <condition_variable>
+#include <thread>
+
+using namespace tools;
+
+namespace
+{
+    LockStats statsOf(const std::string& name)
+    {
+        const auto all = ProfiledMutex::snapshot();
+        auto it = std::find_if(all.begin(), all.end(), [&name](const LockStats& stats) { return stats.name == name; });
+        return it == all.end() ? LockStats() : *it;
+    }
+}
+
+TEST(ProfiledMutexTest, CountsAcquisitionsAndHoldTime)
+{
+    ProfiledMutex mutex("ProfiledMutexTest::uncontended");
+    for( int i = 0; i < 3; ++i )
+    {
+        std::lock_guard<ProfiledMutex> lock(mutex);
+    }
+    ASSERT_TRUE(mutex.try_lock());
+    mutex.unlock();
+
+    const LockStats stats = statsOf("ProfiledMutexTest::uncontended");
+    EXPECT_EQ(stats.acquisitions, 4u);
+    EXPECT_EQ(stats.contentions, 0u);
+    EXPECT_EQ(stats.totalWaitNs, 0u);
+    EXPECT_GE(stats.totalHoldNs, stats.maxHoldNs);
+}
+
+TEST(ProfiledMutexTest, RecordsContendedWaits)
+{
+    ProfiledMutex mutex("ProfiledMutexTest::contended");
+    std::unique_lock<ProfiledMutex> held(mutex);
+
+    std::thread waiter([&mutex]
+        {
+            std::lock_guard<ProfiledMutex> lock(mutex);
+        });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    held.unlock();
+    waiter.join();
+
+    const LockStats stats = statsOf("ProfiledMutexTest::contended");
+    EXPECT_EQ(stats.acquisitions, 2u);
+    EXPECT_EQ(stats.contentions, 1u);
+    EXPECT_GT(stats.maxWaitNs, 0u);
+    EXPECT_EQ(stats.totalWaitNs, stats.maxWaitNs);
+    EXPECT_GE(stats.maxHoldNs, 10'000'000u);
+}
+
+TEST(ProfiledMutexTest, SharesStatisticsByNameAndResets)
+{
+    {
+        ProfiledMutex first("ProfiledMutexTest::shared");
+        std::lock_guard<ProfiledMutex> lock(first);
+    }
+    ProfiledMutex second("ProfiledMutexTest::shared");
+    {
+        std::lock_guard<ProfiledMutex> lock(second);
+    }
+    EXPECT_EQ(statsOf("ProfiledMutexTest::shared").acquisitions, 2u);
+
+    ProfiledMutex::resetAll();
+    EXPECT_EQ(statsOf("ProfiledMutexTest::shared").acquisitions, 0u);
+}
+
+TEST(ProfiledMutexTest, WorksWithConditionVariables)
+{
+    ProfiledMutex mutex("ProfiledMutexTest::condition");
+    std::condition_variable_any condition;
+    bool ready = false;
+
+    std::thread producer([&]
+        {
+            std::lock_guard<ProfiledMutex> lock(mutex);
+            ready = true;
+            condition.notify_one();
+        });
+
+    {
+        std::unique_lock<ProfiledMutex> lock(mutex);
+        condition.wait(lock, [&ready] { return ready; });
+        EXPECT_TRUE(ready);
+    }
+    producer.join();
+    EXPECT_GE(statsOf("ProfiledMutexTest::condition").acquisitions, 2u);
+}
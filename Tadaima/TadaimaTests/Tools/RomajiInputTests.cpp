@@ -0,0 +1,54 @@
+﻿#include <gtest/gtest.h>
+#include "tools/RomajiInput.h"
+
+using namespace tadaima;
+
+TEST(RomajiInputTest, ConvertsSyllablesNAndSmallTsu)
+{
+    EXPECT_EQ(RomajiInput::toKana("konnichiwa"), "こんにちわ");
+    EXPECT_EQ(RomajiInput::toKana("konnnichiwa"), "こんにちわ");
+    EXPECT_EQ(RomajiInput::toKana("kan'i"), "かんい");
+    EXPECT_EQ(RomajiInput::toKana("kitte"), "きって");
+    EXPECT_EQ(RomajiInput::toKana("matcha"), "まっちゃ");
+    EXPECT_EQ(RomajiInput::toKana("shinbun"), "しんぶん");
+    EXPECT_EQ(RomajiInput::toKana("kyouto"), "きょうと");
+    EXPECT_EQ(RomajiInput::toKana("sixyo"), "しょ");
+}
+
+TEST(RomajiInputTest, ConvertsLongVowelsAndKatakana)
+{
+    EXPECT_EQ(RomajiInput::toKana("KO-HI-"), "コーヒー");
+    EXPECT_EQ(RomajiInput::toKana("kō"), "こう");
+    EXPECT_EQ(RomajiInput::toKana("okāsan"), "おかあさん");
+    EXPECT_EQ(RomajiInput::toKana("TŌKYŌ"), "トーキョー");
+    EXPECT_EQ(RomajiInput::toKana("PAN"), "パン");
+}
+
+TEST(RomajiInputTest, KeepsPendingLettersUntilTheyAreComplete)
+{
+    RomajiInput::Replacement replacement;
+    EXPECT_FALSE(RomajiInput::convert("ほk", replacement));
+    EXPECT_FALSE(RomajiInput::convert("ほky", replacement));
+    EXPECT_FALSE(RomajiInput::convert("ほn", replacement));
+
+    ASSERT_TRUE(RomajiInput::convert("ほnk", replacement));
+    EXPECT_EQ(replacement.start, std::string("ほ").size());
+    EXPECT_EQ(replacement.length, 1u);
+    EXPECT_EQ(replacement.kana, "ん");
+
+    // Letters further back than MAX_PENDING are not looked at, whatever their number
+    std::string longText;
+    for( int index = 0; index < 500; ++index )
+    {
+        longText += "qv";
+    }
+    longText += "ka";
+    ASSERT_TRUE(RomajiInput::convert(longText, replacement));
+    EXPECT_EQ(replacement.start, 1000u);
+    EXPECT_EQ(replacement.length, 2u);
+    EXPECT_EQ(replacement.kana, "か");
+
+    ASSERT_TRUE(RomajiInput::finish("ほn", replacement));
+    EXPECT_EQ(replacement.kana, "ん");
+    EXPECT_FALSE(RomajiInput::finish("ほん", replacement));
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "tools/ZipWriter.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+
+using namespace tadaima;
+
+namespace
+{
+    const char* ARCHIVE_PATH = "zip_test.zip";
+    const char* SOURCE_PATH = "zip_test_source.bin";
+
+    std::string readFile(const char* path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    uint32_t read32(const std::string& data, std::size_t offset)
+    {
+        return uint32_t(uint8_t(data[offset])) | (uint32_t(uint8_t(data[offset + 1])) << 8) |
+            (uint32_t(uint8_t(data[offset + 2])) << 16) | (uint32_t(uint8_t(data[offset + 3])) << 24);
+    }
+
+    uint16_t read16(const std::string& data, std::size_t offset)
+    {
+        return uint16_t(uint8_t(data[offset]) | (uint8_t(data[offset + 1]) << 8));
+    }
+
+    class ZipWriterTest : public ::testing::Test
+    {
+    protected:
+        void TearDown() override
+        {
+            std::remove(ARCHIVE_PATH);
+            std::remove(SOURCE_PATH);
+        }
+    };
+}
+
+TEST_F(ZipWriterTest, WritesStoredEntriesWithChecksums)
+{
+    ZipWriter writer;
+    ASSERT_TRUE(writer.open(ARCHIVE_PATH));
+    ASSERT_TRUE(writer.addEntry("media", "{}"));
+    ASSERT_TRUE(writer.addEntry("hello.txt", "The quick brown fox jumps over the lazy dog"));
+    ASSERT_TRUE(writer.close());
+
+    const std::string archive = readFile(ARCHIVE_PATH);
+    ASSERT_GE(archive.size(), 22u);
+
+    // First local header
+    EXPECT_EQ(read32(archive, 0), 0x04034B50u);
+    EXPECT_EQ(read16(archive, 8), 0u); // Stored
+    EXPECT_EQ(read32(archive, 18), 2u);
+    EXPECT_EQ(read32(archive, 22), 2u);
+    EXPECT_EQ(archive.substr(30, 5), "media");
+    EXPECT_EQ(archive.substr(35, 2), "{}");
+
+    // Second local header carries the well known CRC-32 of the pangram
+    EXPECT_EQ(read32(archive, 37), 0x04034B50u);
+    EXPECT_EQ(read32(archive, 37 + 14), 0x414FA339u);
+
+    // End of central directory
+    const std::size_t end = archive.size() - 22;
+    EXPECT_EQ(read32(archive, end), 0x06054B50u);
+    EXPECT_EQ(read16(archive, end + 10), 2u);
+    const uint32_t directoryOffset = read32(archive, end + 16);
+    EXPECT_EQ(read32(archive, directoryOffset), 0x02014B50u);
+    EXPECT_EQ(read32(archive, end + 12), end - directoryOffset);
+}
+
+TEST_F(ZipWriterTest, StreamsFilesInBlocks)
+{
+    std::string content;
+    for( int i = 0; i < 200000; ++i )
+    {
+        content += static_cast<char>(i * 31 % 251);
+    }
+    {
+        std::ofstream source(SOURCE_PATH, std::ios::binary);
+        source.write(content.data(), content.size());
+    }
+
+    ZipWriter writer;
+    ASSERT_TRUE(writer.open(ARCHIVE_PATH));
+    ASSERT_TRUE(writer.addFile("data.bin", SOURCE_PATH));
+    ASSERT_TRUE(writer.close());
+
+    const std::string archive = readFile(ARCHIVE_PATH);
+    EXPECT_EQ(read32(archive, 22), content.size());
+    EXPECT_EQ(archive.substr(30 + 8, content.size()), content);
+}
+
+TEST_F(ZipWriterTest, FailsForMissingSource)
+{
+    ZipWriter writer;
+    ASSERT_TRUE(writer.open(ARCHIVE_PATH));
+    EXPECT_FALSE(writer.addFile("missing", "zip_test_missing.bin"));
+}
@@ -11,17 +11,25 @@
 #include "Tools/Logger.h"
 #include "ApplicationDatabase.h"
 #include "ApplicationSettings.h"
+#include "review/RetentionForecaster.h"
+#include <algorithm>
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace tadaima
 {
     namespace application
     {
-        Application::Application(tools::Logger& logger, EventBridge& eventBridge)
+        Application::Application(tools::Logger& logger, EventBridge& eventBridge, const DatabaseFiles& databaseFiles)
             : m_running(false),
-            m_database("lessons.db", logger),
+            m_database(databaseFiles, logger),
             m_lessonManager(m_database),
+            m_groupCommit(m_database),
             m_eventBridge(eventBridge),
-            m_logger(logger)
+            m_logger(logger),
+            m_reviewRecorder(m_database, m_memoryModel, m_leechDetector, logger)
         {
         }
 
@@ -39,62 +47,110 @@ namespace tadaima
 
         void Application::runThread()
         {
-            std::unique_lock<std::mutex> lock(mtx);
+            std::unique_lock<tools::ProfiledMutex> lock(mtx);
 
             while( m_running )
             {
-                m_threadRaise.wait_for(lock, std::chrono::milliseconds(100));
+                // Sleep until the next lesson change or maintenance step is due, bounded so other events are picked up too
+                const auto wallTime = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+                const auto timeout = std::min<GroupCommit::Clock::duration>({ m_groupCommit.timeUntilDue().value_or(std::chrono::milliseconds(100)),
+                    m_maintenance.timeUntilStep(MaintenanceScheduler::Clock::now(), wallTime).value_or(std::chrono::milliseconds(100)), std::chrono::milliseconds(100) });
+                m_threadRaise.wait_for(lock, timeout);
+
+                if( m_running )
+                {
+                    // Other events may read the lessons, so queued changes are committed before them to keep the order
+                    commitLessonMutations(m_event.anyEventChanged());
+                }
 
                 if( m_running && m_event.anyEventChanged() )
                 {
                     try
                     {
-                        if( m_event.isEventOccurred(ApplicationEvent::OnLessonCreated) )
+                        if( m_event.isEventOccurred(ApplicationEvent::OnSettingsChanged) )
                         {
-                            std::vector<Lesson> lessons = m_event.getEventData<std::vector<Lesson>>(ApplicationEvent::OnLessonCreated);
-                            m_logger.log("OnLessonCreated event occurred. Lessons added: " + lessonsToString(lessons), tools::LogLevel::INFO);
-                            m_lessonManager.addLessons(lessons);
-                            m_eventBridge.initializeGui(m_lessonManager.getAllLessons());
-                            m_event.clearEvent(ApplicationEvent::OnLessonCreated);
+                            ApplicationSettings applicationSettings = m_event.getEventData<ApplicationSettings>(ApplicationEvent::OnSettingsChanged);
+                            m_logger.log("OnSettingsChanged event occurred", tools::LogLevel::INFO);
+                            m_logger.log(applicationSettings.toString(), tools::LogLevel::INFO);
+                            const int leechThreshold = m_leechDetector.getOptions().lapseThreshold;
+                            applySettings(applicationSettings);
+                            m_database.saveSettings(applicationSettings);
+                            m_eventBridge.initializeSettings(applicationSettings);
+                            m_event.clearEvent(ApplicationEvent::OnSettingsChanged);
+                            if( m_leechDetector.getOptions().lapseThreshold != leechThreshold )
+                            {
+                                tagLeeches();
+                            }
                         }
 
-                        if( m_event.isEventOccurred(ApplicationEvent::OnLessonUpdate) )
+                        if( m_event.isEventOccurred(ApplicationEvent::OnWordReviewed) )
                         {
-                            std::vector<Lesson> lessons = m_event.getEventData<std::vector<Lesson>>(ApplicationEvent::OnLessonUpdate);
-                            m_logger.log("OnLessonUpdate event occurred. Lessons updated: " + lessonsToString(lessons), tools::LogLevel::INFO);
-                            m_lessonManager.renameLessons(lessons);
-                            m_eventBridge.initializeGui(m_lessonManager.getAllLessons());
-                            m_event.clearEvent(ApplicationEvent::OnLessonUpdate);
+                            m_event.clearEvent(ApplicationEvent::OnWordReviewed);
+                            std::vector<review::ReviewRecord> reviews;
+                            {
+                                std::lock_guard<tools::ProfiledMutex> reviewsLock(m_reviewsMutex);
+                                reviews.swap(m_pendingReviews);
+                            }
+                            m_logger.log("OnWordReviewed event occurred. Reviews stored: " + std::to_string(reviews.size()), tools::LogLevel::INFO);
+                            storeReviews(reviews);
 
+                            // A forecast simulates the whole library, so it waits until the learner pauses instead of following every answer
+                            m_forecastStale = true;
+                            m_lastReview = std::chrono::steady_clock::now();
                         }
 
-                        if( m_event.isEventOccurred(ApplicationEvent::OnLessonDelete) )
+                        if( m_event.isEventOccurred(ApplicationEvent::OnForecastRequested) )
                         {
-                            std::vector<Lesson> lessons = m_event.getEventData<std::vector<Lesson>>(ApplicationEvent::OnLessonDelete);
-                            m_logger.log("OnLessonDelete event occurred. Lessons deleted: " + lessonsToString(lessons), tools::LogLevel::INFO);
-                            m_lessonManager.removeLessons(lessons);
-                            m_eventBridge.initializeGui(m_lessonManager.getAllLessons());
-                            m_event.clearEvent(ApplicationEvent::OnLessonDelete);
+                            m_forecastOptions = m_event.getEventData<review::ForecastOptions>(ApplicationEvent::OnForecastRequested);
+                            m_logger.log("OnForecastRequested event occurred", tools::LogLevel::INFO);
+                            m_event.clearEvent(ApplicationEvent::OnForecastRequested);
+                            updateForecast();
                         }
 
-                        if( m_event.isEventOccurred(ApplicationEvent::OnLessonEdited) )
+                        if( m_event.isEventOccurred(ApplicationEvent::OnMemoryModelFitRequested) )
                         {
-                            std::vector<Lesson> lessons = m_event.getEventData<std::vector<Lesson>>(ApplicationEvent::OnLessonEdited);
-                            m_logger.log("OnLessonEdited event occurred. Lessons deleted: " + lessonsToString(lessons), tools::LogLevel::INFO);
-                            m_lessonManager.editLessons(lessons);
-                            m_eventBridge.initializeGui(m_lessonManager.getAllLessons());
-                            m_event.clearEvent(ApplicationEvent::OnLessonEdited);
+                            review::MemoryModelParameters parameters = m_event.getEventData<review::MemoryModelParameters>(ApplicationEvent::OnMemoryModelFitRequested);
+                            m_logger.log("OnMemoryModelFitRequested event occurred", tools::LogLevel::INFO);
+                            m_event.clearEvent(ApplicationEvent::OnMemoryModelFitRequested);
+                            startMemoryModelFit(parameters);
                         }
 
-                        if( m_event.isEventOccurred(ApplicationEvent::OnSettingsChanged) )
+                        if( m_event.isEventOccurred(ApplicationEvent::OnMemoryModelFitted) )
                         {
-                            ApplicationSettings applicationSettings = m_event.getEventData<ApplicationSettings>(ApplicationEvent::OnSettingsChanged);
-                            m_logger.log("OnSettingsChanged event occurred", tools::LogLevel::INFO);
+                            ApplicationSettings applicationSettings = m_database.loadSettings();
+                            applicationSettings.memoryModel = m_event.getEventData<review::MemoryModelParameters>(ApplicationEvent::OnMemoryModelFitted);
+                            m_event.clearEvent(ApplicationEvent::OnMemoryModelFitted);
+                            m_logger.log("OnMemoryModelFitted event occurred", tools::LogLevel::INFO);
                             m_logger.log(applicationSettings.toString(), tools::LogLevel::INFO);
                             applySettings(applicationSettings);
                             m_database.saveSettings(applicationSettings);
                             m_eventBridge.initializeSettings(applicationSettings);
-                            m_event.clearEvent(ApplicationEvent::OnSettingsChanged);
+                            rebuildMemoryStates();
+                            updateForecast();
+                        }
+
+                        if( m_event.isEventOccurred(ApplicationEvent::OnFrequencyListImported) )
+                        {
+                            std::string path = m_event.getEventData<std::string>(ApplicationEvent::OnFrequencyListImported);
+                            m_logger.log("OnFrequencyListImported event occurred. Path: " + path, tools::LogLevel::INFO);
+                            m_event.clearEvent(ApplicationEvent::OnFrequencyListImported);
+                            importFrequencyList(path);
+                        }
+
+                        if( m_event.isEventOccurred(ApplicationEvent::OnDeckImported) )
+                        {
+                            std::string path = m_event.getEventData<std::string>(ApplicationEvent::OnDeckImported);
+                            m_logger.log("OnDeckImported event occurred. Path: " + path, tools::LogLevel::INFO);
+                            m_event.clearEvent(ApplicationEvent::OnDeckImported);
+                            importDeck(path);
+                        }
+
+                        if( m_event.isEventOccurred(ApplicationEvent::OnDeckExportRequested) )
+                        {
+                            DeckExportRequest request = m_event.getEventData<DeckExportRequest>(ApplicationEvent::OnDeckExportRequested);
+                            m_logger.log("OnDeckExportRequested event occurred. Path: " + request.path, tools::LogLevel::INFO);
+                            m_event.clearEvent(ApplicationEvent::OnDeckExportRequested);
+                            exportDeck(request);
                         }
                     }
                     catch( const std::exception& ex )
@@ -106,14 +162,139 @@ namespace tadaima
                         m_logger.log("Unexpected exception caught during event handling", tools::LogLevel::PROBLEM);
                     }
                 }
+
+                // Maintenance only uses the connection while nothing else waits for it
+                if( m_running && !m_event.anyEventChanged() && m_groupCommit.pendingCount() == 0 )
+                {
+                    if( m_forecastStale && std::chrono::steady_clock::now() - m_lastReview >= FORECAST_DELAY )
+                    {
+                        updateForecast();
+                    }
+                    runMaintenanceStep();
+                }
+            }
+
+            // Changes still waiting for their window are saved before the application closes
+            commitLessonMutations(true);
+        }
+
+        bool Application::queueLessonMutation(ApplicationEvent event, const std::vector<Lesson>& lessons)
+        {
+            if( event != ApplicationEvent::OnLessonCreated && event != ApplicationEvent::OnLessonUpdate &&
+                event != ApplicationEvent::OnLessonDelete && event != ApplicationEvent::OnLessonEdited )
+            {
+                return false;
+            }
+
+            const std::string name = eventToString(event) + ": " + lessonsToString(lessons);
+            m_groupCommit.enqueue(name, [this, event, changed = lessons]() mutable { return applyLessonMutation(event, changed); });
+            m_logger.log("Event queued: " + name, tools::LogLevel::DEBUG);
+            return true;
+        }
+
+        void Application::queueWordOperation(ApplicationEvent event, const WordOperation& operation)
+        {
+            static const char* const typeNames[] = { "move", "copy", "delete", "retag" };
+            const std::string name = std::format("{}: {} of {} words", eventToString(event), typeNames[static_cast<int>(operation.type)], operation.wordIds.size());
+            m_groupCommit.enqueue(name, [this, operation]() { return m_lessonManager.applyWordOperation(operation); });
+            m_logger.log("Event queued: " + name, tools::LogLevel::DEBUG);
+        }
+
+        bool Application::applyLessonMutation(ApplicationEvent event, std::vector<Lesson>& lessons)
+        {
+            switch( event )
+            {
+                case ApplicationEvent::OnLessonCreated:
+                    m_frequencyTable.annotate(lessons);
+                    return m_lessonManager.addLessons(lessons);
+                case ApplicationEvent::OnLessonUpdate:
+                    return m_lessonManager.renameLessons(lessons);
+                case ApplicationEvent::OnLessonDelete:
+                    return m_lessonManager.removeLessons(lessons);
+                case ApplicationEvent::OnLessonEdited:
+                    m_frequencyTable.annotate(lessons);
+                    return m_lessonManager.editLessons(lessons);
+                default:
+                    return false;
+            }
+        }
+
+        void Application::commitLessonMutations(bool all)
+        {
+            const std::vector<GroupCommitResult> results = all ? m_groupCommit.commitAll() : m_groupCommit.commitDue();
+            if( results.empty() )
+            {
+                return;
+            }
+
+            std::size_t failed = 0;
+            for( const auto& result : results )
+            {
+                if( result.success )
+                {
+                    m_logger.log(result.name + " committed.", tools::LogLevel::INFO);
+                }
+                else
+                {
+                    ++failed;
+                    m_logger.log(result.name + " failed and was rolled back.", tools::LogLevel::PROBLEM);
+                }
+            }
+            m_logger.log(std::format("Group commit of {} lesson changes, {} failed.", results.size(), failed), tools::LogLevel::INFO);
+            m_eventBridge.reportLessonChanges(results);
+
+            // Only the touched lessons are read again, the GUI keeps the rest of the library
+            const std::vector<int> changedLessons = m_lessonManager.takeChangedLessons();
+            m_eventBridge.refreshLessons(m_lessonManager.getLessons(changedLessons), changedLessons);
+        }
+
+        void Application::noteUserActivity()
+        {
+            m_maintenance.noteActivity();
+        }
+
+        void Application::runMaintenanceStep()
+        {
+            const auto wallTime = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            const std::optional<MaintenanceStepResult> result = m_maintenance.runStep(MaintenanceScheduler::Clock::now(), wallTime);
+            if( !result )
+            {
+                return;
+            }
+
+            switch( result->status )
+            {
+                case MaintenanceStatus::Done:
+                    m_logger.log("Database maintenance " + result->task + " completed.", tools::LogLevel::INFO);
+                    m_database.saveMaintenanceRun(result->task, wallTime);
+                    break;
+                case MaintenanceStatus::Failed:
+                    m_logger.log("Database maintenance " + result->task + " failed.", tools::LogLevel::WARNING);
+                    m_database.saveMaintenanceRun(result->task, wallTime);
+                    break;
+                case MaintenanceStatus::Interrupted:
+                    m_logger.log("Database maintenance " + result->task + " yielded to the user.", tools::LogLevel::DEBUG);
+                    break;
+                case MaintenanceStatus::TimedOut:
+                    m_logger.log("Database maintenance " + result->task + " is repeated with a longer step.", tools::LogLevel::DEBUG);
+                    break;
+                default:
+                    break;
             }
         }
 
         void Application::stopThread()
         {
+            m_optimizerCancel = true;
+            if( m_optimizerThread.joinable() )
+            {
+                m_optimizerThread.join();
+            }
+
             if( m_running )
             {
                 m_running = false;
+                m_maintenance.noteActivity();
                 m_threadRaise.notify_one();
                 if( workerThread.joinable() )
                 {
@@ -127,14 +308,401 @@ namespace tadaima
         {
             auto settings = m_database.loadSettings();
             applySettings(settings);
+            if( m_frequencyTable.open(FREQUENCY_TABLE_PATH) )
+            {
+                m_logger.log("Frequency table loaded with " + std::to_string(m_frequencyTable.size()) + " words.", tools::LogLevel::INFO);
+            }
             m_eventBridge.initializeGui(m_lessonManager.getAllLessons());
             m_eventBridge.initializeSettings(settings);
+            setEvent(ApplicationEvent::OnForecastRequested, m_forecastOptions);
+            updateConfusions();
+
+            const auto maintenanceRuns = m_database.loadMaintenanceRuns();
+            for( auto& task : m_database.maintenanceTasks() )
+            {
+                auto it = maintenanceRuns.find(task.name);
+                m_maintenance.addTask(std::move(task), it != maintenanceRuns.end() ? it->second : 0);
+            }
 
             m_logger.log("Application initialized.", tools::LogLevel::INFO);
         }
 
+        void Application::storeReviews(const std::vector<review::ReviewRecord>& reviews)
+        {
+            const RecordedReviews recorded = m_reviewRecorder.record(reviews);
+            if( !recorded.leeches.empty() )
+            {
+                m_eventBridge.initializeGui(m_lessonManager.getAllLessons());
+            }
+            if( recorded.confused )
+            {
+                updateConfusions();
+            }
+        }
+
+        void Application::tagLeeches()
+        {
+            std::vector<int> wordIds;
+            std::unordered_set<int> leeches;
+            for( const auto& state : m_database.getMemoryStates() )
+            {
+                wordIds.push_back(state.wordId);
+                if( m_leechDetector.isLeech(state) )
+                {
+                    leeches.insert(state.wordId);
+                }
+            }
+
+            // Words under a raised threshold lose the tag again, only words whose tag is wrong are retagged
+            std::vector<int> tagged;
+            std::vector<int> untagged;
+            for( const Word& word : m_database.getWords(wordIds) )
+            {
+                const bool hasTag = std::find(word.tags.begin(), word.tags.end(), review::LeechDetector::LEECH_TAG) != word.tags.end();
+                const bool isLeech = leeches.count(word.id) > 0;
+                if( isLeech && !hasTag )
+                {
+                    tagged.push_back(word.id);
+                }
+                else if( !isLeech && hasTag )
+                {
+                    untagged.push_back(word.id);
+                }
+            }
+            if( !tagged.empty() )
+            {
+                m_lessonManager.retagWords(tagged, { review::LeechDetector::LEECH_TAG }, {});
+            }
+            if( !untagged.empty() )
+            {
+                m_lessonManager.retagWords(untagged, {}, { review::LeechDetector::LEECH_TAG });
+            }
+
+            m_logger.log(std::format("Leech threshold changed, words over it: {}, newly tagged: {}, untagged: {}", leeches.size(), tagged.size(), untagged.size()), tools::LogLevel::INFO);
+            if( !tagged.empty() || !untagged.empty() )
+            {
+                m_eventBridge.initializeGui(m_lessonManager.getAllLessons());
+            }
+        }
+
+        void Application::startMemoryModelFit(const review::MemoryModelParameters& initial)
+        {
+            if( m_optimizerRunning )
+            {
+                m_logger.log("Memory model is already being fitted.", tools::LogLevel::WARNING);
+                return;
+            }
+
+            if( m_optimizerThread.joinable() )
+            {
+                m_optimizerThread.join();
+            }
+
+            m_optimizerRunning = true;
+            m_optimizerCancel = false;
+            m_optimizerThread = std::thread(&Application::runMemoryModelFit, this, m_database.getReviews(), initial);
+        }
+
+        void Application::runMemoryModelFit(std::vector<review::ReviewRecord> reviews, review::MemoryModelParameters initial)
+        {
+            m_logger.log("Fitting memory model to " + std::to_string(reviews.size()) + " reviews.", tools::LogLevel::INFO);
+            const auto start = std::chrono::steady_clock::now();
+
+            review::ParameterOptimizer optimizer;
+            review::OptimizationResult result = optimizer.fit(reviews, initial, review::OptimizerOptions(),
+                [this](float progress, double loss)
+                {
+                    m_eventBridge.initializeOptimization(true, progress, loss);
+                }, &m_optimizerCancel);
+
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+            m_logger.log(std::format("Memory model fitted in {} ms and {} iterations, log loss {:.5f} -> {:.5f}.",
+                elapsed, result.iterations, result.initialLoss, result.finalLoss), tools::LogLevel::INFO);
+
+            if( !result.cancelled && result.predictions > 0 )
+            {
+                setEvent(ApplicationEvent::OnMemoryModelFitted, result.parameters);
+            }
+
+            m_eventBridge.initializeOptimization(false, 1.0f, result.finalLoss);
+            m_optimizerRunning = false;
+        }
+
+        void Application::rebuildMemoryStates()
+        {
+            std::vector<review::MemoryState> states;
+            for( const auto& record : m_database.getReviews() )
+            {
+                if( states.empty() || states.back().wordId != record.wordId )
+                {
+                    states.emplace_back();
+                }
+                m_memoryModel.applyReview(states.back(), record);
+            }
+            m_database.saveMemoryStates(states);
+        }
+
+        void Application::importFrequencyList(const std::string& path)
+        {
+            std::ifstream input(path, std::ios::binary);
+            if( !input )
+            {
+                m_logger.log("Frequency list " + path + " could not be opened.", tools::LogLevel::PROBLEM);
+                return;
+            }
+
+            // The mapping has to be released before the table file can be replaced
+            m_frequencyTable.close();
+            const std::size_t count = FrequencyTable::build(input, FREQUENCY_TABLE_PATH);
+            if( count == 0 || !m_frequencyTable.open(FREQUENCY_TABLE_PATH) )
+            {
+                m_logger.log("Frequency list " + path + " contains no usable words.", tools::LogLevel::PROBLEM);
+                m_frequencyTable.open(FREQUENCY_TABLE_PATH);
+                return;
+            }
+            m_logger.log("Frequency table built with " + std::to_string(count) + " words.", tools::LogLevel::INFO);
+
+            std::vector<std::pair<int, int>> ranks;
+            for( const auto& lesson : m_lessonManager.getAllLessons() )
+            {
+                for( const auto& word : lesson.words )
+                {
+                    const int rank = m_frequencyTable.rank(word);
+                    if( rank != word.frequencyRank )
+                    {
+                        ranks.emplace_back(word.id, rank);
+                    }
+                }
+            }
+            m_database.updateFrequencyRanks(ranks);
+            m_eventBridge.initializeGui(m_lessonManager.getAllLessons());
+
+            ApplicationSettings settings = m_database.loadSettings();
+            settings.frequencyListPath = path;
+            m_database.saveSettings(settings);
+            m_eventBridge.initializeSettings(settings);
+        }
+
+        void Application::importDeck(const std::string& path)
+        {
+            DeckPack pack;
+            if( !pack.open(path) )
+            {
+                m_logger.log("Deck pack " + path + " is not valid.", tools::LogLevel::PROBLEM);
+                return;
+            }
+
+            const std::string installedPath = installedDeckPath(pack.name());
+            DeckPack installed;
+            const bool hasInstalled = installed.open(installedPath);
+            if( hasInstalled && installed.version() == pack.version() )
+            {
+                m_logger.log("Deck " + pack.name() + " is up to date.", tools::LogLevel::INFO);
+                return;
+            }
+
+            const DeckUpdate update = pack.update(hasInstalled ? &installed : nullptr);
+            m_logger.log(std::format("Deck {}: {} of {} chunks changed, {} lessons updated, {} removed.", pack.name(),
+                update.changedChunks, pack.chunkCount(), update.changedLessons.size(), update.removedLessons.size()), tools::LogLevel::INFO);
+
+            std::vector<Lesson> existingLessons = m_lessonManager.getAllLessons();
+            auto findExisting = [&existingLessons](const Lesson& lesson) -> const Lesson*
+                {
+                    auto it = std::find_if(existingLessons.begin(), existingLessons.end(), [&lesson](const Lesson& existing)
+                        {
+                            return existing.mainName == lesson.mainName && existing.subName == lesson.subName;
+                        });
+                    return it != existingLessons.end() ? &*it : nullptr;
+                };
+
+            // Words are matched by content so their IDs, and the review history attached to them, survive the update
+            std::vector<Lesson> addedLessons;
+            std::vector<Lesson> editedLessons;
+            for( Lesson lesson : update.changedLessons )
+            {
+                const Lesson* existing = findExisting(lesson);
+                if( existing == nullptr )
+                {
+                    addedLessons.push_back(lesson);
+                    continue;
+                }
+
+                std::unordered_multimap<std::string, int> wordIds;
+                for( const auto& word : existing->words )
+                {
+                    wordIds.emplace(word.kana + '\t' + word.translation, word.id);
+                }
+                for( auto& word : lesson.words )
+                {
+                    auto it = wordIds.find(word.kana + '\t' + word.translation);
+                    if( it != wordIds.end() )
+                    {
+                        word.id = it->second;
+                        wordIds.erase(it);
+                    }
+                }
+                lesson.id = existing->id;
+                editedLessons.push_back(lesson);
+            }
+
+            std::vector<Lesson> removedLessons;
+            for( const auto& lesson : update.removedLessons )
+            {
+                if( const Lesson* existing = findExisting(lesson) )
+                {
+                    removedLessons.push_back(*existing);
+                }
+            }
+
+            m_frequencyTable.annotate(addedLessons);
+            m_frequencyTable.annotate(editedLessons);
+            m_lessonManager.addLessons(addedLessons);
+            m_lessonManager.editLessons(editedLessons);
+            m_lessonManager.removeLessons(removedLessons);
+
+            // The new version becomes the base for the next delta pack of this deck
+            std::error_code error;
+            std::filesystem::create_directories(DECKS_DIRECTORY, error);
+            const std::string temporaryPath = installedPath + ".tmp";
+            const bool materialized = pack.materialize(temporaryPath, hasInstalled ? &installed : nullptr);
+            installed.close();
+            pack.close();
+            if( materialized )
+            {
+                std::filesystem::rename(temporaryPath, installedPath, error);
+            }
+            if( !materialized || error )
+            {
+                m_logger.log("Deck " + installedPath + " could not be stored, the next update will need a full pack.", tools::LogLevel::WARNING);
+            }
+
+            m_eventBridge.initializeGui(m_lessonManager.getAllLessons());
+        }
+
+        void Application::exportDeck(const DeckExportRequest& request)
+        {
+            if( request.path.ends_with(AnkiExporter::FILE_EXTENSION) )
+            {
+                exportAnkiPackage(request);
+                return;
+            }
+
+            const std::unordered_set<int> lessonIds(request.lessonIds.begin(), request.lessonIds.end());
+            std::vector<Lesson> lessons;
+            for( const auto& lesson : m_lessonManager.getAllLessons() )
+            {
+                if( lessonIds.count(lesson.id) > 0 )
+                {
+                    lessons.push_back(lesson);
+                }
+            }
+
+            if( lessons.empty() || !DeckPack::write(request.path, request.name, lessons) )
+            {
+                m_logger.log("Deck pack " + request.path + " could not be written.", tools::LogLevel::PROBLEM);
+                return;
+            }
+
+            const std::string installedPath = installedDeckPath(request.name);
+            DeckPack previous;
+            if( previous.open(installedPath) )
+            {
+                std::filesystem::path deltaPath(request.path);
+                deltaPath.replace_extension(std::string(".delta") + DeckPack::FILE_EXTENSION);
+                if( DeckPack::write(deltaPath.string(), request.name, lessons, &previous) )
+                {
+                    m_logger.log("Delta deck pack written to " + deltaPath.string() + ".", tools::LogLevel::INFO);
+                }
+                previous.close();
+            }
+
+            std::error_code error;
+            std::filesystem::create_directories(DECKS_DIRECTORY, error);
+            std::filesystem::copy_file(request.path, installedPath, std::filesystem::copy_options::overwrite_existing, error);
+            m_logger.log("Deck " + request.name + " exported to " + request.path + ".", tools::LogLevel::INFO);
+        }
+
+        void Application::exportAnkiPackage(const DeckExportRequest& request)
+        {
+            AnkiExporter exporter;
+            if( request.lessonIds.empty() || !exporter.begin(request.path) )
+            {
+                m_logger.log("Anki package " + request.path + " could not be created.", tools::LogLevel::PROBLEM);
+                return;
+            }
+
+            bool failed = false;
+            m_database.forEachWord(request.lessonIds, [&](const Lesson& lesson, const Word& word)
+                {
+                    failed = failed || !exporter.addWord(lesson, word);
+                });
+
+            if( failed || !exporter.finish() )
+            {
+                exporter.cancel();
+                m_logger.log("Anki package " + request.path + " could not be written.", tools::LogLevel::PROBLEM);
+                return;
+            }
+            m_logger.log("Exported " + std::to_string(exporter.noteCount()) + " notes to Anki package " + request.path + ".", tools::LogLevel::INFO);
+        }
+
+        std::string Application::installedDeckPath(const std::string& name) const
+        {
+            std::string fileName = name.empty() ? "deck" : name;
+            for( char& character : fileName )
+            {
+                if( std::string_view("<>:\"/\\|?*").find(character) != std::string_view::npos || static_cast<unsigned char>(character) < 0x20 )
+                {
+                    character = '_';
+                }
+            }
+            return (std::filesystem::path(DECKS_DIRECTORY) / (fileName + DeckPack::FILE_EXTENSION)).string();
+        }
+
+        void Application::updateForecast()
+        {
+            const auto now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            review::RetentionForecaster forecaster(m_memoryModel);
+            m_forecastStale = false;
+            m_eventBridge.initializeForecast(forecaster.forecast(m_database.getMemoryStates(), now, m_forecastOptions));
+        }
+
+        void Application::updateConfusions()
+        {
+            const std::vector<review::Confusion> confusions = m_database.getConfusions();
+            const std::size_t shown = std::min(SHOWN_CONFUSIONS, confusions.size());
+
+            std::vector<int> wordIds;
+            wordIds.reserve(shown * 2);
+            for( std::size_t index = 0; index < shown; ++index )
+            {
+                wordIds.push_back(confusions[index].targetId);
+                wordIds.push_back(confusions[index].chosenId);
+            }
+            std::unordered_map<int, Word> words;
+            for( Word& word : m_database.getWords(wordIds) )
+            {
+                const int id = word.id;
+                words.emplace(id, std::move(word));
+            }
+
+            std::vector<std::string> descriptions;
+            descriptions.reserve(shown);
+            for( std::size_t index = 0; index < shown; ++index )
+            {
+                const Word& target = words[confusions[index].targetId];
+                const Word& chosen = words[confusions[index].chosenId];
+                descriptions.push_back(std::format("{} ({}) mistaken for {} ({}): {}x", target.kana, target.translation, chosen.kana, chosen.translation, confusions[index].count));
+            }
+            m_eventBridge.initializeConfusions(confusions, descriptions);
+        }
+
         void Application::applySettings(ApplicationSettings& settings)
         {
+            m_memoryModel = review::MemoryModel(settings.memoryModel);
+            m_leechDetector = review::LeechDetector(settings.leech);
+            m_groupCommit.setOptions(settings.groupCommit);
+
             auto hwnd = GetConsoleWindow();
             auto option = settings.showLogs ? SW_SHOW : SW_HIDE;
             ShowWindow(hwnd, option);
@@ -163,6 +731,22 @@ namespace tadaima
                     return "OnLessonDelete";
                 case ApplicationEvent::OnSettingsChanged:
                     return "OnSettingschanged";
+                case ApplicationEvent::OnWordReviewed:
+                    return "OnWordReviewed";
+                case ApplicationEvent::OnForecastRequested:
+                    return "OnForecastRequested";
+                case ApplicationEvent::OnMemoryModelFitRequested:
+                    return "OnMemoryModelFitRequested";
+                case ApplicationEvent::OnMemoryModelFitted:
+                    return "OnMemoryModelFitted";
+                case ApplicationEvent::OnFrequencyListImported:
+                    return "OnFrequencyListImported";
+                case ApplicationEvent::OnDeckImported:
+                    return "OnDeckImported";
+                case ApplicationEvent::OnDeckExportRequested:
+                    return "OnDeckExportRequested";
+                case ApplicationEvent::OnWordsChanged:
+                    return "OnWordsChanged";
                 default:
                     return "UnknownEvent";
             }
@@ -11,13 +11,27 @@
 
 #include <string>
 #include <thread>
+#include <chrono>
 #include <atomic>
 #include <mutex>
+#include <condition_variable>
+#include <type_traits>
 #include "ApplicationDatabase.h"
 #include "Lessons/LessonManager.h"
 #include "Tools/EventsData.h"
 #include "bridge/EventBridge.h"
 #include "Tools/Logger.h"
+#include "Tools/ProfiledMutex.h"
+#include "GroupCommit.h"
+#include "MaintenanceScheduler.h"
+#include "ReviewRecorder.h"
+#include "review/MemoryModel.h"
+#include "review/RetentionForecaster.h"
+#include "review/ParameterOptimizer.h"
+#include "review/LeechDetector.h"
+#include "lessons/FrequencyTable.h"
+#include "lessons/DeckPack.h"
+#include "lessons/AnkiExporter.h"
 
 namespace tools { class Logger; }
 namespace tadaima
@@ -36,6 +50,10 @@ namespace tadaima
         class Application
         {
         public:
+            static constexpr const char* FREQUENCY_TABLE_PATH = "frequency.bin"; /**< Path of the binary word frequency table. */
+            static constexpr const char* DECKS_DIRECTORY = "decks"; /**< Directory with the last known version of every shared deck. */
+            static constexpr std::size_t SHOWN_CONFUSIONS = 10; /**< Number of confusions described on the dashboard. */
+            static constexpr std::chrono::seconds FORECAST_DELAY{ 10 }; /**< Time without reviews after which a stale forecast is computed again. */
 
             /**
              * @brief Constructor.
@@ -44,8 +62,9 @@ namespace tadaima
              *
              * @param logger Reference to a Logger instance for logging.
              * @param eventBridge Reference to an EventBridge instance for event handling.
+             * @param databaseFiles The deck and the progress database of the profile.
              */
-            Application(tools::Logger& logger, EventBridge& eventBridge);
+            Application(tools::Logger& logger, EventBridge& eventBridge, const DatabaseFiles& databaseFiles = {});
 
             /**
              * @brief Destructor.
@@ -68,11 +87,20 @@ namespace tadaima
              */
             void Initialize();
 
+            /**
+             * @brief Reports input of the user, which postpones database maintenance and interrupts a running step.
+             *
+             * May be called from any thread.
+             */
+            void noteUserActivity();
+
             /**
              * @brief Sets an event with the given data.
              *
              * This template method sets an application event with the provided data and notifies
-             * the worker thread.
+             * the worker thread. Reviews are queued rather than replaced, so answers given while the
+             * worker is busy are not lost. Lesson and word changes are queued for the group commit, which
+             * saves edits made in quick succession in one transaction.
              *
              * @tparam DataType The type of the data associated with the event.
              * @param event The application event to set.
@@ -81,9 +109,31 @@ namespace tadaima
             template<typename DataType>
             void setEvent(ApplicationEvent event, const DataType& data)
             {
-                m_event.setEvent(event, data);
-                m_threadRaise.notify_one();
-                m_logger.log("Event set: " + eventToString(event), tools::LogLevel::DEBUG);
+                m_maintenance.noteActivity();
+                if constexpr( std::is_same_v<DataType, WordOperation> )
+                {
+                    queueWordOperation(event, data);
+                    m_threadRaise.notify_one();
+                }
+                else
+                {
+                    if constexpr( std::is_same_v<DataType, std::vector<review::ReviewRecord>> )
+                    {
+                        std::lock_guard<tools::ProfiledMutex> reviewsLock(m_reviewsMutex);
+                        m_pendingReviews.insert(m_pendingReviews.end(), data.begin(), data.end());
+                    }
+                    if constexpr( std::is_same_v<DataType, std::vector<Lesson>> )
+                    {
+                        if( queueLessonMutation(event, data) )
+                        {
+                            m_threadRaise.notify_one();
+                            return;
+                        }
+                    }
+                    m_event.setEvent(event, data);
+                    m_threadRaise.notify_one();
+                    m_logger.log("Event set: " + eventToString(event), tools::LogLevel::DEBUG);
+                }
             }
 
         private:
@@ -111,6 +161,128 @@ namespace tadaima
              */
             std::string eventToString(ApplicationEvent event);
 
+            /**
+             * @brief Stores the given reviews through the review recorder and refreshes what they changed in the GUI.
+             *
+             * @param reviews The reviews to store.
+             */
+            void storeReviews(const std::vector<review::ReviewRecord>& reviews);
+
+            /**
+             * @brief Queues a change of lessons for the group commit.
+             *
+             * @param event The event carrying the change.
+             * @param lessons The changed lessons.
+             * @return True if the event changes lessons and was queued, false if it is handled as a regular event.
+             */
+            bool queueLessonMutation(ApplicationEvent event, const std::vector<Lesson>& lessons);
+
+            /**
+             * @brief Queues a change of a selection of words for the group commit.
+             *
+             * The change shares the queue with the lesson changes, so both are applied in the order they were made.
+             *
+             * @param event The event carrying the change.
+             * @param operation The change to apply.
+             */
+            void queueWordOperation(ApplicationEvent event, const WordOperation& operation);
+
+            /**
+             * @brief Applies a queued change of lessons to the database.
+             *
+             * @param event The event carrying the change.
+             * @param lessons The changed lessons.
+             * @return True if every lesson was stored, false otherwise.
+             */
+            bool applyLessonMutation(ApplicationEvent event, std::vector<Lesson>& lessons);
+
+            /**
+             * @brief Commits queued lesson changes, reports the outcome of each and refreshes the lesson tree.
+             *
+             * @param all Commits everything queued instead of only a group whose window has passed.
+             */
+            void commitLessonMutations(bool all);
+
+            /**
+             * @brief Runs one step of database maintenance if the user is idle and persists completed tasks.
+             */
+            void runMaintenanceStep();
+
+            /**
+             * @brief Tags every word which is a leech under the current thresholds and untags every word which is not.
+             *
+             * Only run when the thresholds change, the reviews themselves are checked one by one in storeReviews.
+             */
+            void tagLeeches();
+
+            /**
+             * @brief Computes a review forecast for the whole library and sends it to the GUI.
+             */
+            void updateForecast();
+
+            /**
+             * @brief Sends the stored confusions and descriptions of the most frequent ones to the GUI.
+             */
+            void updateConfusions();
+
+            /**
+             * @brief Starts fitting of the memory model parameters to the review history in the background.
+             *
+             * @param initial The parameters the fitting starts from.
+             */
+            void startMemoryModelFit(const review::MemoryModelParameters& initial);
+
+            /**
+             * @brief Background job fitting the memory model parameters.
+             *
+             * @param reviews The review history ordered by word and time.
+             * @param initial The parameters the fitting starts from.
+             */
+            void runMemoryModelFit(std::vector<review::ReviewRecord> reviews, review::MemoryModelParameters initial);
+
+            /**
+             * @brief Replays the review history with the current memory model and stores the resulting memory states.
+             */
+            void rebuildMemoryStates();
+
+            /**
+             * @brief Builds the frequency table from a word frequency list and ranks all stored words.
+             *
+             * @param path The path to the tab separated frequency list.
+             */
+            void importFrequencyList(const std::string& path);
+
+            /**
+             * @brief Imports a deck pack, applying only the lessons which changed since the installed version.
+             *
+             * @param path The path to the full or delta deck pack.
+             */
+            void importDeck(const std::string& path);
+
+            /**
+             * @brief Exports lessons as a full deck pack, and as a delta pack against the previous export of the deck.
+             *
+             * Paths with the Anki package extension are exported by exportAnkiPackage instead.
+             *
+             * @param request The path, deck name and lessons to export.
+             */
+            void exportDeck(const DeckExportRequest& request);
+
+            /**
+             * @brief Exports lessons as an Anki package, streaming the words from the database.
+             *
+             * @param request The path and lessons to export.
+             */
+            void exportAnkiPackage(const DeckExportRequest& request);
+
+            /**
+             * @brief Gets the path of the last known version of a deck.
+             *
+             * @param name The name of the deck.
+             * @return The path of the deck pack in the decks directory.
+             */
+            std::string installedDeckPath(const std::string& name) const;
+
             /**
              * @brief Worker thread function.
              *
@@ -128,17 +300,31 @@ namespace tadaima
 
             ApplicationDatabase m_database; /**< Database for managing lessons. */
             LessonManager m_lessonManager; /**< Manager for handling lesson operations. */
+            GroupCommit m_groupCommit; /**< Queue sharing transactions between lesson changes made in quick succession. */
+            MaintenanceScheduler m_maintenance; /**< Runs analyze, vacuum and integrity checks of the databases while the user is idle. */
             EventBridge& m_eventBridge; /**< Reference to the EventBridge for event handling. */
             tools::Logger& m_logger; /**< Reference to the Logger instance for logging. */
 
-            tools::EventsData<std::vector<Lesson>, ApplicationSettings> m_event; /**< Event data structure. */
+            tools::EventsData<std::vector<Lesson>, ApplicationSettings, std::vector<review::ReviewRecord>, review::ForecastOptions, review::MemoryModelParameters, std::string, DeckExportRequest> m_event; /**< Event data structure. */
+            review::MemoryModel m_memoryModel; /**< Model used to track how well words are remembered. */
+            review::LeechDetector m_leechDetector; /**< Detector of the words the learner keeps failing. */
+            ReviewRecorder m_reviewRecorder; /**< Stores reviews with the memory states, leech tags and confusions they change. */
+            review::ForecastOptions m_forecastOptions; /**< Options of the last requested forecast. */
+            bool m_forecastStale = false; /**< Flag telling that reviews were stored since the last forecast. */
+            std::chrono::steady_clock::time_point m_lastReview; /**< Time the last reviews were stored. */
+            std::vector<review::ReviewRecord> m_pendingReviews; /**< Reviews waiting to be stored by the worker thread. */
+            tools::ProfiledMutex m_reviewsMutex{ "Application::m_reviewsMutex" }; /**< Mutex guarding the pending reviews. */
+            std::thread m_optimizerThread; /**< Thread fitting the memory model in the background. */
+            std::atomic<bool> m_optimizerRunning = false; /**< Flag telling if the memory model is being fitted. */
+            std::atomic<bool> m_optimizerCancel = false; /**< Flag requesting the fitting to stop. */
+            FrequencyTable m_frequencyTable; /**< Ranks of words in the imported frequency list. */
 
             gui::Gui* m_gui = nullptr; /**< Pointer to the GUI instance. */
             std::thread workerThread; /**< Worker thread for background tasks. */
             std::atomic<bool> m_running; /**< Atomic flag to control the worker thread's execution. */
             std::string m_newDirectory; /**< The path to the new directory. */
-            std::condition_variable m_threadRaise; /**< Condition variable for thread synchronization. */
-            std::mutex mtx; /**< Mutex for thread synchronization. */
+            std::condition_variable_any m_threadRaise; /**< Condition variable for thread synchronization. */
+            tools::ProfiledMutex mtx{ "Application::mtx" }; /**< Mutex for thread synchronization. */
         };
     }
 }
@@ -1,24 +1,181 @@
 #include "ApplicationDatabase.h"
-#include <iostream>
+#include <algorithm>
+#include <format>
+#include <memory>
 #include <Libraries/SQLite3/sqlite3.h>
 #include "Tools/Logger.h"
+#include "tools/AllocationTracker.h"
+#include "tools/JapaneseText.h"
+#include "QueryProfiler.h"
+#include "JapaneseSqlFunctions.h"
 #include "ApplicationSettings.h"
+#include "review/ConfusionTable.h"
+#include "lessons/ClozeLocator.h"
 
 namespace tadaima
 {
     namespace application
     {
-        ApplicationDatabase::ApplicationDatabase(const std::string& dbPath, tools::Logger& logger)
-            : db(nullptr), m_logger(logger)
+        namespace
         {
-            if( sqlite3_open(dbPath.c_str(), &db) )
+            constexpr int MAINTENANCE_PROGRESS_OPCODES = 1000; // Virtual machine instructions between two checks for user activity
+            constexpr int ANALYSIS_LIMIT = 1000; // Index entries sampled by ANALYZE
+            constexpr int VACUUM_PAGES = 64; // Pages freed by one incremental vacuum
+            constexpr int FTS_MERGE_PAGES = 64; // Pages written by one FTS5 merge
+            constexpr double VACUUM_CONVERSION_SHARE = 0.2; // Free share of a database which is worth a full VACUUM
+            constexpr long long VACUUM_PAGES_PER_MS = 50; // Used pages a full VACUUM is assumed to copy per millisecond
+            constexpr std::chrono::milliseconds VACUUM_CONVERSION_BUDGET{ 5000 }; // Idle time a step of the conversion to incremental vacuum may take
+            constexpr std::chrono::milliseconds INTEGRITY_CHECK_BUDGET{ 1000 }; // Idle time a step of the integrity check may take
+            constexpr long long NO_VACUUM = 0; // Value of PRAGMA auto_vacuum without auto vacuum
+            constexpr long long INCREMENTAL_VACUUM = 2; // Value of PRAGMA auto_vacuum with incremental vacuum
+            constexpr const char* MAINTENANCE_KEY_PREFIX = "maintenance.";
+
+            /**
+             * @brief Position of a maintenance task walking over tables.
+             */
+            struct MaintenanceProgress
+            {
+                std::vector<std::pair<std::string, std::string>> tables; /**< Schema and name of the tables. */
+                std::size_t cursor = 0; /**< Next table. */
+                bool failed = false; /**< True if a table failed. */
+            };
+
+            /**
+             * @brief Runs a statement per table from the cursor on until the budget is used up.
+             * @param progress The tables and the cursor, reset once the last table is done.
+             * @param budget The budget of the step.
+             * @param run Runs the statements of a table, Pending, Interrupted and TimedOut keep the cursor on the table.
+             * @return Done or Failed after the last table, Pending, Interrupted or TimedOut otherwise.
+             */
+            MaintenanceStatus stepThroughTables(MaintenanceProgress& progress, const MaintenanceBudget& budget,
+                const std::function<MaintenanceStatus(const std::string&, const std::string&)>& run)
+            {
+                while( progress.cursor < progress.tables.size() )
+                {
+                    if( budget.exhausted() )
+                    {
+                        return MaintenanceStatus::Pending;
+                    }
+                    const auto& [schema, table] = progress.tables[progress.cursor];
+                    const MaintenanceStatus status = run(schema, table);
+                    if( status == MaintenanceStatus::Pending || status == MaintenanceStatus::Interrupted || status == MaintenanceStatus::TimedOut )
+                    {
+                        return status;
+                    }
+                    progress.failed = progress.failed || status == MaintenanceStatus::Failed;
+                    ++progress.cursor;
+                }
+
+                const bool failed = progress.failed;
+                progress.cursor = 0;
+                progress.failed = false;
+                return failed ? MaintenanceStatus::Failed : MaintenanceStatus::Done;
+            }
+
+            std::string quoteIdentifier(const std::string& identifier)
+            {
+                std::string quoted = "\"";
+                for( char character : identifier )
+                {
+                    quoted += character == '"' ? "\"\"" : std::string(1, character);
+                }
+                return quoted + "\"";
+            }
+
+            std::string toJsonArray(const std::vector<int>& values)
+            {
+                std::string json = "[";
+                for( std::size_t i = 0; i < values.size(); ++i )
+                {
+                    json += (i == 0 ? "" : ",") + std::to_string(values[i]);
+                }
+                return json + "]";
+            }
+
+            std::string toJsonArray(const std::vector<std::string>& values)
+            {
+                std::string json = "[";
+                for( std::size_t i = 0; i < values.size(); ++i )
+                {
+                    json += (i == 0 ? "\"" : ",\"");
+                    for( char character : values[i] )
+                    {
+                        if( character == '"' || character == '\\' )
+                        {
+                            json += '\\';
+                            json += character;
+                        }
+                        else if( static_cast<unsigned char>(character) < 0x20 )
+                        {
+                            json += std::format("\\u{:04x}", static_cast<int>(character));
+                        }
+                        else
+                        {
+                            json += character;
+                        }
+                    }
+                    json += '"';
+                }
+                return json + "]";
+            }
+
+            // Binds the span of the word in its example sentence, located from the stored text rather than trusted from the caller
+            void bindCloze(sqlite3_stmt* stmt, int index, const Word& word)
+            {
+                Word located(word);
+                ClozeLocator::locate(located);
+                sqlite3_bind_int(stmt, index, located.clozeStart);
+                sqlite3_bind_int(stmt, index + 1, located.clozeLength);
+            }
+
+            // Binds the normalized kana the words are indexed by, so lookups need no collation stored in the deck
+            void bindKanaKey(sqlite3_stmt* stmt, int index, const Word& word)
+            {
+                const std::string key = normalizeJapanese(word.kana);
+                sqlite3_bind_text(stmt, index, key.c_str(), static_cast<int>(key.size()), SQLITE_TRANSIENT);
+            }
+
+            // First characters of the kana keys a lookup narrows its candidates to through the kana index: the first character
+            // of kana input, or every hiragana whose romaji starts with the first letter of romaji input
+            std::vector<std::string> kanaKeyPrefixes(const std::string& query, bool romaji)
+            {
+                if( !romaji )
+                {
+                    const unsigned char lead = static_cast<unsigned char>(query.front());
+                    const std::size_t length = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+                    return { query.substr(0, length) };
+                }
+
+                const bool vowel = std::string_view("aiueo").find(query.front()) != std::string_view::npos;
+                std::vector<std::string> prefixes;
+                for( char32_t code = U'\u3041'; code <= U'\u3096'; ++code )
+                {
+                    const std::string kana = { static_cast<char>(0xE0 | (code >> 12)), static_cast<char>(0x80 | ((code >> 6) & 0x3F)), static_cast<char>(0x80 | (code & 0x3F)) };
+                    const std::string spelling = toRomaji(kana);
+                    if( code == U'\u3063' ? !vowel : !spelling.empty() && spelling.front() == query.front() ) // っ doubles the next consonant
+                    {
+                        prefixes.push_back(kana);
+                    }
+                }
+                return prefixes;
+            }
+        }
+
+        ApplicationDatabase::ApplicationDatabase(const DatabaseFiles& files, tools::Logger& logger)
+            : db(nullptr), m_readOnlyDeck(files.readOnlyDeck), m_logger(logger), m_profiler(logger)
+        {
+            if( sqlite3_open_v2(files.progressPath.c_str(), &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_URI, nullptr) )
             {
                 m_logger.log("Database: Can't open database: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
             }
             else
             {
-                m_logger.log("Database: Opened database successfully at " + dbPath, tools::LogLevel::INFO);
-                if( initDatabase() )
+                m_logger.log("Database: Opened database successfully at " + files.progressPath, tools::LogLevel::INFO);
+                if( !registerJapaneseSqlFunctions(db) )
+                {
+                    m_logger.log("Database: Can't register Japanese collations: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                }
+                if( attachDeck(files) && initDatabase() )
                 {
                     m_logger.log("Database: Initialized database successfully.", tools::LogLevel::INFO);
                 }
@@ -26,6 +183,7 @@ namespace tadaima
                 {
                     m_logger.log("Database: Failed to initialize database.", tools::LogLevel::PROBLEM);
                 }
+                m_profiler.attach(db);
             }
         }
 
@@ -33,6 +191,7 @@ namespace tadaima
         {
             if( db )
             {
+                m_profiler.detach();
                 sqlite3_close(db);
                 m_logger.log("Database: Closed database connection.", tools::LogLevel::INFO);
             }
@@ -41,56 +200,355 @@ namespace tadaima
         bool ApplicationDatabase::initDatabase()
         {
             const char* createLessonsTable =
-                "CREATE TABLE IF NOT EXISTS lessons ("
+                "CREATE TABLE IF NOT EXISTS content.lessons ("
                 "id INTEGER PRIMARY KEY AUTOINCREMENT, "
                 "main_name TEXT NOT NULL, "
                 "sub_name TEXT NOT NULL);";
             const char* createWordsTable =
-                "CREATE TABLE IF NOT EXISTS words ("
+                "CREATE TABLE IF NOT EXISTS content.words ("
                 "id INTEGER PRIMARY KEY AUTOINCREMENT, "
                 "lesson_id INTEGER, "
                 "kana TEXT NOT NULL, "
                 "translation TEXT NOT NULL, "
                 "romaji TEXT, "
                 "example_sentence TEXT, "
+                "frequency_rank INTEGER NOT NULL DEFAULT 0, "
+                "kanji TEXT NOT NULL DEFAULT '', "
+                "cloze_start INTEGER NOT NULL DEFAULT -1, "
+                "cloze_length INTEGER NOT NULL DEFAULT -1, "
+                "kana_key TEXT NOT NULL DEFAULT '', "
                 "FOREIGN KEY(lesson_id) REFERENCES lessons(id));";
             const char* createTagsTable =
-                "CREATE TABLE IF NOT EXISTS tags ("
+                "CREATE TABLE IF NOT EXISTS content.tags ("
                 "id INTEGER PRIMARY KEY AUTOINCREMENT, "
                 "word_id INTEGER, "
                 "tag TEXT NOT NULL, "
-                "FOREIGN KEY(word_id) REFERENCES words(id));";
+                "FOREIGN KEY(word_id) REFERENCES words(id));"
+                "CREATE INDEX IF NOT EXISTS content.idx_tags_word ON tags(word_id);";
             const char* createSettingsTable =
-                "CREATE TABLE IF NOT EXISTS settings ("
+                "CREATE TABLE IF NOT EXISTS main.settings ("
                 "key TEXT PRIMARY KEY, "
                 "value TEXT NOT NULL);";
 
+            const char* createReviewsTable =
+                "CREATE TABLE IF NOT EXISTS main.reviews ("
+                "id INTEGER PRIMARY KEY AUTOINCREMENT, "
+                "word_id INTEGER NOT NULL, "
+                "timestamp INTEGER NOT NULL, "
+                "correct INTEGER NOT NULL);"
+                "CREATE INDEX IF NOT EXISTS main.idx_reviews_word ON reviews(word_id, timestamp);";
+            const char* createMemoryStateTable =
+                "CREATE TABLE IF NOT EXISTS main.memory_state ("
+                "word_id INTEGER PRIMARY KEY, "
+                "stability REAL NOT NULL, "
+                "difficulty REAL NOT NULL, "
+                "last_review INTEGER NOT NULL, "
+                "review_count INTEGER NOT NULL, "
+                "lapses INTEGER NOT NULL);";
+            const char* createConfusionsTable =
+                "CREATE TABLE IF NOT EXISTS main.confusions ("
+                "target_id INTEGER NOT NULL, "
+                "chosen_id INTEGER NOT NULL, "
+                "count INTEGER NOT NULL, "
+                "last_seen INTEGER NOT NULL, "
+                "PRIMARY KEY(target_id, chosen_id)) WITHOUT ROWID;";
+
+            struct Table
+            {
+                const char* name;
+                const char* sql;
+                bool content;
+            };
+
+            const Table tables[] =
+            {
+                { "lessons", createLessonsTable, true },
+                { "words", createWordsTable, true },
+                { "tags", createTagsTable, true },
+                { "settings", createSettingsTable, false },
+                { "reviews", createReviewsTable, false },
+                { "memory_state", createMemoryStateTable, false },
+                { "confusions", createConfusionsTable, false }
+            };
+
+            // Only applies to files without tables yet, older ones are converted by the vacuum maintenance task
+            sqlite3_exec(db, "PRAGMA main.auto_vacuum = INCREMENTAL;", 0, 0, 0);
+            if( !m_readOnlyDeck )
+            {
+                sqlite3_exec(db, ("PRAGMA " + std::string(CONTENT_SCHEMA) + ".auto_vacuum = INCREMENTAL;").c_str(), 0, 0, 0);
+            }
+
+            for( const auto& [name, sql, content] : tables )
+            {
+                if( content && m_readOnlyDeck )
+                {
+                    continue;
+                }
+
+                char* errMsg = nullptr;
+                if( sqlite3_exec(db, sql, 0, 0, &errMsg) != SQLITE_OK )
+                {
+                    m_logger.log("Database: SQL error while creating " + std::string(name) + " table: " + std::string(errMsg), tools::LogLevel::PROBLEM);
+                    sqlite3_free(errMsg);
+                    return false;
+                }
+            }
+
+            if( !migrateProgress() )
+            {
+                return false;
+            }
+
+            // Columns added after the first release are appended to existing databases, or defaulted on read-only decks
+            if( m_readOnlyDeck )
+            {
+                return defaultMissingColumns();
+            }
+            return addColumnIfMissing(CONTENT_SCHEMA, "words", "frequency_rank", "INTEGER NOT NULL DEFAULT 0")
+                && addColumnIfMissing(CONTENT_SCHEMA, "words", "kanji", "TEXT NOT NULL DEFAULT ''")
+                && addColumnIfMissing(CONTENT_SCHEMA, "words", "cloze_start", "INTEGER NOT NULL DEFAULT -1")
+                && addColumnIfMissing(CONTENT_SCHEMA, "words", "cloze_length", "INTEGER NOT NULL DEFAULT -1")
+                && addColumnIfMissing(CONTENT_SCHEMA, "words", "kana_key", "TEXT NOT NULL DEFAULT ''")
+                && indexKanaKeys()
+                && locateClozes();
+        }
+
+        bool ApplicationDatabase::indexKanaKeys()
+        {
+            // The first release indexed kana with the KANA collation, which other connections to the deck cannot write through.
+            // Those connections leave the key of the words they write empty or stale, so it is refreshed on every start
+            const std::string sql =
+                "DROP INDEX IF EXISTS " + std::string(CONTENT_SCHEMA) + ".idx_words_kana;"
+                "UPDATE " + std::string(CONTENT_SCHEMA) + ".words SET kana_key = normalize_japanese(kana) WHERE kana_key <> normalize_japanese(kana);"
+                "CREATE INDEX IF NOT EXISTS " + std::string(CONTENT_SCHEMA) + ".idx_words_kana_key ON words(lesson_id, kana_key);";
             char* errMsg = nullptr;
-            if( sqlite3_exec(db, createLessonsTable, 0, 0, &errMsg) != SQLITE_OK )
+            if( sqlite3_exec(db, sql.c_str(), 0, 0, &errMsg) != SQLITE_OK )
             {
-                m_logger.log("Database: SQL error while creating lessons table: " + std::string(errMsg), tools::LogLevel::PROBLEM);
+                m_logger.log("Database: SQL error while indexing kana: " + std::string(errMsg), tools::LogLevel::PROBLEM);
                 sqlite3_free(errMsg);
                 return false;
             }
-            if( sqlite3_exec(db, createWordsTable, 0, 0, &errMsg) != SQLITE_OK )
+            return true;
+        }
+
+        bool ApplicationDatabase::locateClozes()
+        {
+            const std::string selectSql = "SELECT id, kana, romaji, example_sentence, kanji FROM " + std::string(CONTENT_SCHEMA) + ".words WHERE cloze_length < 0;";
+            const std::string updateSql = "UPDATE " + std::string(CONTENT_SCHEMA) + ".words SET cloze_start = ?, cloze_length = ? WHERE id = ?;";
+
+            std::vector<Word> words;
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, selectSql.c_str(), -1, &stmt, 0) != SQLITE_OK )
+            {
+                m_logger.log("Database: SQL error while locating clozes: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                return false;
+            }
+            auto columnText = [stmt](int column)
+                {
+                    const unsigned char* text = sqlite3_column_text(stmt, column);
+                    return text ? std::string(reinterpret_cast<const char*>(text)) : std::string();
+                };
+            while( sqlite3_step(stmt) == SQLITE_ROW )
             {
-                m_logger.log("Database: SQL error while creating words table: " + std::string(errMsg), tools::LogLevel::PROBLEM);
-                sqlite3_free(errMsg);
+                Word word;
+                word.id = sqlite3_column_int(stmt, 0);
+                word.kana = columnText(1);
+                word.romaji = columnText(2);
+                word.exampleSentence = columnText(3);
+                word.kanji = columnText(4);
+                words.push_back(std::move(word));
+            }
+            sqlite3_finalize(stmt);
+            if( words.empty() )
+            {
+                return true;
+            }
+
+            bool located = beginTransaction() && sqlite3_prepare_v2(db, updateSql.c_str(), -1, &stmt, 0) == SQLITE_OK;
+            if( located )
+            {
+                for( const auto& word : words )
+                {
+                    bindCloze(stmt, 1, word);
+                    sqlite3_bind_int(stmt, 3, word.id);
+                    located = located && sqlite3_step(stmt) == SQLITE_DONE;
+                    sqlite3_reset(stmt);
+                }
+                sqlite3_finalize(stmt);
+            }
+            if( !located || !commitTransaction() )
+            {
+                m_logger.log("Database: SQL error while locating clozes: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                rollbackTransaction();
+                return false;
+            }
+            m_logger.log("Database: Located " + std::to_string(words.size()) + " words in their example sentences.", tools::LogLevel::INFO);
+            return true;
+        }
+
+        bool ApplicationDatabase::attachDeck(const DatabaseFiles& files)
+        {
+            // The deck is attached through a URI to pass the open mode, so reserved characters of the path are escaped
+            std::string uri = "file:";
+            if( files.deckPath.size() > 1 && files.deckPath[1] == ':' )
+            {
+                uri += '/'; // Drive letter
+            }
+            for( char character : files.deckPath )
+            {
+                switch( character )
+                {
+                case '\\': uri += '/'; break;
+                case '%': uri += "%25"; break;
+                case '?': uri += "%3f"; break;
+                case '#': uri += "%23"; break;
+                default: uri += character; break;
+                }
+            }
+            uri += files.readOnlyDeck ? "?mode=ro&immutable=1" : "?mode=rwc";
+
+            const std::string attachSql = "ATTACH DATABASE ? AS " + std::string(CONTENT_SCHEMA) + ";";
+            sqlite3_stmt* stmt;
+            bool attached = false;
+            if( sqlite3_prepare_v2(db, attachSql.c_str(), -1, &stmt, 0) == SQLITE_OK )
+            {
+                sqlite3_bind_text(stmt, 1, uri.c_str(), -1, SQLITE_STATIC);
+                attached = sqlite3_step(stmt) == SQLITE_DONE;
+                sqlite3_finalize(stmt);
+            }
+            if( !attached )
+            {
+                m_logger.log("Database: Can't attach deck " + files.deckPath + ": " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
                 return false;
             }
-            if( sqlite3_exec(db, createTagsTable, 0, 0, &errMsg) != SQLITE_OK )
+
+            const std::string mmapSql = "PRAGMA " + std::string(CONTENT_SCHEMA) + ".mmap_size = " + std::to_string(DECK_MMAP_SIZE) + ";";
+            sqlite3_exec(db, mmapSql.c_str(), 0, 0, 0);
+            m_logger.log("Database: Attached " + std::string(files.readOnlyDeck ? "read-only " : "") + "deck at " + files.deckPath, tools::LogLevel::INFO);
+            return true;
+        }
+
+        bool ApplicationDatabase::migrateProgress()
+        {
+            const std::string progressFile = sqlite3_db_filename(db, "main");
+            if( !progressFile.empty() && progressFile == sqlite3_db_filename(db, CONTENT_SCHEMA) )
+            {
+                return true; // Both schemas are the same file, the tables are already in place
+            }
+
+            const char* progressTables[] = { "settings", "reviews", "memory_state" };
+            for( const char* table : progressTables )
+            {
+                bool found = false;
+                sqlite3_stmt* stmt;
+                if( sqlite3_prepare_v2(db, "SELECT 1 FROM content.sqlite_master WHERE type = 'table' AND name = ?;", -1, &stmt, 0) == SQLITE_OK )
+                {
+                    sqlite3_bind_text(stmt, 1, table, -1, SQLITE_STATIC);
+                    found = sqlite3_step(stmt) == SQLITE_ROW;
+                    sqlite3_finalize(stmt);
+                }
+                if( !found )
+                {
+                    continue;
+                }
+
+                const std::string name(table);
+                const std::string sql = m_readOnlyDeck
+                    ? "INSERT INTO main." + name + " SELECT * FROM content." + name + " WHERE NOT EXISTS (SELECT 1 FROM main." + name + ");"
+                    : "BEGIN;"
+                      "INSERT OR IGNORE INTO main." + name + " SELECT * FROM content." + name + ";"
+                      "DROP TABLE content." + name + ";"
+                      "COMMIT;";
+                char* errMsg = nullptr;
+                if( sqlite3_exec(db, sql.c_str(), 0, 0, &errMsg) != SQLITE_OK )
+                {
+                    m_logger.log("Database: SQL error while moving " + name + " to the progress database: " + std::string(errMsg), tools::LogLevel::PROBLEM);
+                    sqlite3_free(errMsg);
+                    if( !sqlite3_get_autocommit(db) )
+                    {
+                        sqlite3_exec(db, "ROLLBACK;", 0, 0, 0);
+                    }
+                    return false;
+                }
+                if( !m_readOnlyDeck || sqlite3_changes(db) > 0 )
+                {
+                    m_logger.log("Database: Moved " + name + " from the deck to the progress database.", tools::LogLevel::INFO);
+                }
+            }
+            return true;
+        }
+
+        bool ApplicationDatabase::hasColumn(const std::string& schema, const std::string& table, const std::string& column) const
+        {
+            const std::string infoSql = "PRAGMA " + schema + ".table_info(" + table + ");";
+            sqlite3_stmt* stmt;
+            bool found = false;
+            if( sqlite3_prepare_v2(db, infoSql.c_str(), -1, &stmt, 0) == SQLITE_OK )
+            {
+                while( !found && sqlite3_step(stmt) == SQLITE_ROW )
+                {
+                    found = column == reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+                }
+                sqlite3_finalize(stmt);
+            }
+            return found;
+        }
+
+        bool ApplicationDatabase::addColumnIfMissing(const std::string& schema, const std::string& table, const std::string& column, const std::string& definition)
+        {
+            if( hasColumn(schema, table, column) )
+            {
+                return true;
+            }
+
+            const std::string alterSql = "ALTER TABLE " + schema + "." + table + " ADD COLUMN " + column + " " + definition + ";";
+            char* errMsg = nullptr;
+            if( sqlite3_exec(db, alterSql.c_str(), 0, 0, &errMsg) != SQLITE_OK )
             {
-                m_logger.log("Database: SQL error while creating tags table: " + std::string(errMsg), tools::LogLevel::PROBLEM);
+                m_logger.log("Database: SQL error while adding column " + column + " to " + table + ": " + std::string(errMsg), tools::LogLevel::PROBLEM);
                 sqlite3_free(errMsg);
                 return false;
             }
-            if( sqlite3_exec(db, createSettingsTable, 0, 0, &errMsg) != SQLITE_OK )
+
+            m_logger.log("Database: Added column " + column + " to " + table + ".", tools::LogLevel::INFO);
+            return true;
+        }
+
+        bool ApplicationDatabase::defaultMissingColumns()
+        {
+            // Same defaults as the columns appended to writable decks
+            const std::vector<std::pair<const char*, const char*>> columns = {
+                { "frequency_rank", "0" },
+                { "kanji", "''" },
+                { "cloze_start", "-1" },
+                { "cloze_length", "-1" },
+                { "kana_key", "normalize_japanese(kana)" }
+            };
+
+            std::string defaults;
+            for( const auto& [column, value] : columns )
+            {
+                if( !hasColumn(CONTENT_SCHEMA, "words", column) )
+                {
+                    defaults += ", " + std::string(value) + " AS " + column;
+                }
+            }
+            if( defaults.empty() )
+            {
+                return true;
+            }
+
+            // Unqualified names look in the temp schema first, so every statement reading words sees the view
+            const std::string viewSql = "CREATE TEMP VIEW words AS SELECT *" + defaults + " FROM " + std::string(CONTENT_SCHEMA) + ".words;";
+            char* errMsg = nullptr;
+            if( sqlite3_exec(db, viewSql.c_str(), 0, 0, &errMsg) != SQLITE_OK )
             {
-                m_logger.log("Database: SQL error while creating settings table: " + std::string(errMsg), tools::LogLevel::PROBLEM);
+                m_logger.log("Database: SQL error while reading the words of an older read-only deck: " + std::string(errMsg), tools::LogLevel::PROBLEM);
                 sqlite3_free(errMsg);
                 return false;
             }
 
+            m_logger.log("Database: Read-only deck lacks word columns, using their defaults.", tools::LogLevel::WARNING);
             return true;
         }
 
@@ -119,8 +577,8 @@ namespace tadaima
         int ApplicationDatabase::addWord(int lessonId, const Word& word)
         {
             const char* sql =
-                "INSERT INTO words (lesson_id, kana, translation, romaji, example_sentence) "
-                "VALUES (?, ?, ?, ?, ?);";
+                "INSERT INTO words (lesson_id, kana, translation, romaji, example_sentence, frequency_rank, kanji, cloze_start, cloze_length, kana_key) "
+                "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
             sqlite3_stmt* stmt;
             if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
             {
@@ -129,6 +587,10 @@ namespace tadaima
                 sqlite3_bind_text(stmt, 3, word.translation.c_str(), -1, SQLITE_STATIC);
                 sqlite3_bind_text(stmt, 4, word.romaji.c_str(), -1, SQLITE_STATIC);
                 sqlite3_bind_text(stmt, 5, word.exampleSentence.c_str(), -1, SQLITE_STATIC);
+                sqlite3_bind_int(stmt, 6, word.frequencyRank);
+                sqlite3_bind_text(stmt, 7, word.kanji.c_str(), -1, SQLITE_STATIC);
+                bindCloze(stmt, 8, word);
+                bindKanaKey(stmt, 10, word);
                 if( sqlite3_step(stmt) != SQLITE_DONE )
                 {
                     m_logger.log("Database: SQL error while adding word: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
@@ -145,7 +607,7 @@ namespace tadaima
 
         void ApplicationDatabase::addTag(int wordId, const std::string& tag)
         {
-            const char* sql = "INSERT INTO tags (word_id, tag) VALUES (?, ?);";
+            const char* sql = "INSERT INTO tags (word_id, tag) SELECT ?1, ?2 WHERE NOT EXISTS (SELECT 1 FROM tags WHERE word_id = ?1 AND tag = ?2);";
             sqlite3_stmt* stmt;
             if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
             {
@@ -155,12 +617,15 @@ namespace tadaima
                 {
                     m_logger.log("Database: SQL error while adding tag: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
                 }
+                else if( sqlite3_changes(db) > 0 )
+                {
+                    m_logger.log("Database: Added tag '" + tag + "' to word ID " + std::to_string(wordId), tools::LogLevel::INFO);
+                }
                 sqlite3_finalize(stmt);
-                m_logger.log("Database: Added tag '" + tag + "' to word ID " + std::to_string(wordId), tools::LogLevel::INFO);
             }
         }
 
-        void ApplicationDatabase::updateLesson(int lessonId, const std::string& newMainName, const std::string& newSubName)
+        bool ApplicationDatabase::updateLesson(int lessonId, const std::string& newMainName, const std::string& newSubName)
         {
             const char* sql = "UPDATE lessons SET main_name = ?, sub_name = ? WHERE id = ?;";
             sqlite3_stmt* stmt;
@@ -172,21 +637,28 @@ namespace tadaima
                 if( sqlite3_step(stmt) != SQLITE_DONE )
                 {
                     m_logger.log("Database: SQL error while updating lesson: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                    sqlite3_finalize(stmt);
+                    return false;
                 }
                 sqlite3_finalize(stmt);
                 m_logger.log("Database: Updated lesson ID " + std::to_string(lessonId) + " to mainName: " + newMainName + ", subName: " + newSubName, tools::LogLevel::INFO);
+                return true;
             }
+            return false;
         }
 
-        bool ApplicationDatabase::editLesson(const Lesson& lesson)
+        int ApplicationDatabase::editLesson(const Lesson& lesson)
         {
+            AllocationScope scope(AllocationTag::Database);
             try
             {
                 int lessonId = lesson.id;
 
                 // Start transaction
-                const char* beginTransaction = "BEGIN TRANSACTION;";
-                sqlite3_exec(db, beginTransaction, 0, 0, 0);
+                if( !beginTransaction() )
+                {
+                    return -1;
+                }
 
                 // Check if lesson exists
                 const char* checkLessonSql = "SELECT COUNT(*) FROM lessons WHERE id = ?;";
@@ -220,21 +692,6 @@ namespace tadaima
                         }
                         sqlite3_finalize(updateLessonStmt);
                     }
-
-                    // Delete existing words associated with the lesson
-                    const char* deleteWordsSql = "DELETE FROM words WHERE lesson_id = ?;";
-                    sqlite3_stmt* deleteWordsStmt;
-                    if( sqlite3_prepare_v2(db, deleteWordsSql, -1, &deleteWordsStmt, 0) == SQLITE_OK )
-                    {
-                        sqlite3_bind_int(deleteWordsStmt, 1, lesson.id);
-                        if( sqlite3_step(deleteWordsStmt) != SQLITE_DONE )
-                        {
-                            m_logger.log("Database: SQL error while deleting words: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
-                            sqlite3_finalize(deleteWordsStmt);
-                            throw std::runtime_error("Failed to delete words");
-                        }
-                        sqlite3_finalize(deleteWordsStmt);
-                    }
                 }
                 else
                 {
@@ -247,66 +704,146 @@ namespace tadaima
                     lessonId = newLessonId;
                 }
 
-                // Insert updated words
-                const char* insertWordSql = "INSERT INTO words (lesson_id, kana, translation, romaji, example_sentence) VALUES (?, ?, ?, ?, ?);";
-                sqlite3_stmt* insertWordStmt;
+                // Existing words are updated in place so their IDs, and the review history attached to them, survive the edit.
+                // Only words of this lesson are updated, a stale or foreign ID is stored as a new word instead of moving another lesson's word
+                const char* updateWordSql = "UPDATE words SET kana = ?, translation = ?, romaji = ?, example_sentence = ?, frequency_rank = ?, kanji = ?, cloze_start = ?, cloze_length = ?, kana_key = ? WHERE id = ? AND lesson_id = ?;";
+                const char* insertWordSql = "INSERT INTO words (lesson_id, kana, translation, romaji, example_sentence, frequency_rank, kanji, cloze_start, cloze_length, kana_key) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);";
+                const char* deleteTagsSql = "DELETE FROM tags WHERE word_id = ?;";
+                const char* insertTagSql = "INSERT INTO tags (word_id, tag) VALUES (?, ?);";
+                std::vector<int> keptWordIds;
+
                 for( const auto& word : lesson.words )
                 {
-                    if( sqlite3_prepare_v2(db, insertWordSql, -1, &insertWordStmt, 0) == SQLITE_OK )
+                    int wordId = -1;
+
+                    if( word.id > 0 )
+                    {
+                        sqlite3_stmt* updateWordStmt;
+                        if( sqlite3_prepare_v2(db, updateWordSql, -1, &updateWordStmt, 0) == SQLITE_OK )
+                        {
+                            sqlite3_bind_text(updateWordStmt, 1, word.kana.c_str(), -1, SQLITE_STATIC);
+                            sqlite3_bind_text(updateWordStmt, 2, word.translation.c_str(), -1, SQLITE_STATIC);
+                            sqlite3_bind_text(updateWordStmt, 3, word.romaji.c_str(), -1, SQLITE_STATIC);
+                            sqlite3_bind_text(updateWordStmt, 4, word.exampleSentence.c_str(), -1, SQLITE_STATIC);
+                            sqlite3_bind_int(updateWordStmt, 5, word.frequencyRank);
+                            sqlite3_bind_text(updateWordStmt, 6, word.kanji.c_str(), -1, SQLITE_STATIC);
+                            bindCloze(updateWordStmt, 7, word);
+                            bindKanaKey(updateWordStmt, 9, word);
+                            sqlite3_bind_int(updateWordStmt, 10, word.id);
+                            sqlite3_bind_int(updateWordStmt, 11, lessonId);
+                            if( sqlite3_step(updateWordStmt) != SQLITE_DONE )
+                            {
+                                m_logger.log("Database: SQL error while updating word: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                                sqlite3_finalize(updateWordStmt);
+                                throw std::runtime_error("Failed to update word");
+                            }
+                            if( sqlite3_changes(db) > 0 )
+                            {
+                                wordId = word.id;
+                            }
+                            sqlite3_finalize(updateWordStmt);
+                        }
+
+                        sqlite3_stmt* deleteTagsStmt;
+                        if( wordId != -1 && sqlite3_prepare_v2(db, deleteTagsSql, -1, &deleteTagsStmt, 0) == SQLITE_OK )
+                        {
+                            sqlite3_bind_int(deleteTagsStmt, 1, wordId);
+                            if( sqlite3_step(deleteTagsStmt) != SQLITE_DONE )
+                            {
+                                m_logger.log("Database: SQL error while deleting tags: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                                sqlite3_finalize(deleteTagsStmt);
+                                throw std::runtime_error("Failed to delete tags");
+                            }
+                            sqlite3_finalize(deleteTagsStmt);
+                        }
+                    }
+
+                    sqlite3_stmt* insertWordStmt;
+                    if( wordId == -1 && sqlite3_prepare_v2(db, insertWordSql, -1, &insertWordStmt, 0) == SQLITE_OK )
                     {
                         sqlite3_bind_int(insertWordStmt, 1, lessonId);
                         sqlite3_bind_text(insertWordStmt, 2, word.kana.c_str(), -1, SQLITE_STATIC);
                         sqlite3_bind_text(insertWordStmt, 3, word.translation.c_str(), -1, SQLITE_STATIC);
                         sqlite3_bind_text(insertWordStmt, 4, word.romaji.c_str(), -1, SQLITE_STATIC);
                         sqlite3_bind_text(insertWordStmt, 5, word.exampleSentence.c_str(), -1, SQLITE_STATIC);
+                        sqlite3_bind_int(insertWordStmt, 6, word.frequencyRank);
+                        sqlite3_bind_text(insertWordStmt, 7, word.kanji.c_str(), -1, SQLITE_STATIC);
+                        bindCloze(insertWordStmt, 8, word);
+                        bindKanaKey(insertWordStmt, 10, word);
                         if( sqlite3_step(insertWordStmt) != SQLITE_DONE )
                         {
                             m_logger.log("Database: SQL error while inserting word: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
                             sqlite3_finalize(insertWordStmt);
                             throw std::runtime_error("Failed to insert word");
                         }
-                        int wordId = static_cast<int>(sqlite3_last_insert_rowid(db));
+                        wordId = static_cast<int>(sqlite3_last_insert_rowid(db));
                         sqlite3_finalize(insertWordStmt);
+                    }
 
-                        // Insert tags for the word
-                        const char* insertTagSql = "INSERT INTO tags (word_id, tag) VALUES (?, ?);";
-                        sqlite3_stmt* insertTagStmt;
-                        for( const auto& tag : word.tags )
+                    if( wordId == -1 )
+                    {
+                        throw std::runtime_error("Failed to store word");
+                    }
+                    keptWordIds.push_back(wordId);
+
+                    // Insert tags for the word
+                    sqlite3_stmt* insertTagStmt;
+                    for( const auto& tag : word.tags )
+                    {
+                        if( sqlite3_prepare_v2(db, insertTagSql, -1, &insertTagStmt, 0) == SQLITE_OK )
                         {
-                            if( sqlite3_prepare_v2(db, insertTagSql, -1, &insertTagStmt, 0) == SQLITE_OK )
+                            sqlite3_bind_int(insertTagStmt, 1, wordId);
+                            sqlite3_bind_text(insertTagStmt, 2, tag.c_str(), -1, SQLITE_STATIC);
+                            if( sqlite3_step(insertTagStmt) != SQLITE_DONE )
                             {
-                                sqlite3_bind_int(insertTagStmt, 1, wordId);
-                                sqlite3_bind_text(insertTagStmt, 2, tag.c_str(), -1, SQLITE_STATIC);
-                                if( sqlite3_step(insertTagStmt) != SQLITE_DONE )
-                                {
-                                    m_logger.log("Database: SQL error while inserting tag: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
-                                    sqlite3_finalize(insertTagStmt);
-                                    throw std::runtime_error("Failed to insert tag");
-                                }
+                                m_logger.log("Database: SQL error while inserting tag: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
                                 sqlite3_finalize(insertTagStmt);
+                                throw std::runtime_error("Failed to insert tag");
                             }
+                            sqlite3_finalize(insertTagStmt);
                         }
                     }
                 }
 
+                // Delete words which are no longer part of the lesson, together with everything recorded for them
+                const std::string removedIds = "(SELECT id FROM words WHERE lesson_id = ?2 AND id NOT IN (SELECT value FROM json_each(?1)))";
+                const std::string deleteRemovedSql[] =
+                {
+                    "DELETE FROM tags WHERE word_id IN " + removedIds + ";",
+                    "DELETE FROM reviews WHERE word_id IN " + removedIds + ";",
+                    "DELETE FROM memory_state WHERE word_id IN " + removedIds + ";",
+                    "DELETE FROM confusions WHERE target_id IN " + removedIds + " OR chosen_id IN " + removedIds + ";",
+                    "DELETE FROM words WHERE id IN " + removedIds + ";"
+                };
+                const std::string keptIds = toJsonArray(keptWordIds);
+                for( const auto& sql : deleteRemovedSql )
+                {
+                    if( executeForWords(sql.c_str(), keptIds, [lessonId](sqlite3_stmt* stmt) { sqlite3_bind_int(stmt, 2, lessonId); }) < 0 )
+                    {
+                        m_logger.log("Database: SQL error while deleting words: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                        throw std::runtime_error("Failed to delete words");
+                    }
+                }
+
                 // Commit transaction
-                const char* commitTransaction = "COMMIT;";
-                sqlite3_exec(db, commitTransaction, 0, 0, 0);
-                return true;
+                if( !commitTransaction() )
+                {
+                    throw std::runtime_error("Failed to commit lesson");
+                }
+                return lessonId;
             }
             catch( const std::exception& e )
             {
                 // Rollback transaction in case of error
-                const char* rollbackTransaction = "ROLLBACK;";
-                sqlite3_exec(db, rollbackTransaction, 0, 0, 0);
-                std::cerr << "Error updating lesson: " << e.what() << std::endl;
-                return false;
+                rollbackTransaction();
+                m_logger.log("Database: Error updating lesson: " + std::string(e.what()), tools::LogLevel::PROBLEM);
+                return -1;
             }
         }
 
         void ApplicationDatabase::updateWord(int wordId, const Word& updatedWord)
         {
-            const char* sql = "UPDATE words SET kana = ?, translation = ?, romaji = ?, example_sentence = ? WHERE id = ?;";
+            const char* sql = "UPDATE words SET kana = ?, translation = ?, romaji = ?, example_sentence = ?, frequency_rank = ?, kanji = ?, cloze_start = ?, cloze_length = ?, kana_key = ? WHERE id = ?;";
             sqlite3_stmt* stmt;
             if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
             {
@@ -314,7 +851,11 @@ namespace tadaima
                 sqlite3_bind_text(stmt, 2, updatedWord.translation.c_str(), -1, SQLITE_STATIC);
                 sqlite3_bind_text(stmt, 3, updatedWord.romaji.c_str(), -1, SQLITE_STATIC);
                 sqlite3_bind_text(stmt, 4, updatedWord.exampleSentence.c_str(), -1, SQLITE_STATIC);
-                sqlite3_bind_int(stmt, 5, wordId);
+                sqlite3_bind_int(stmt, 5, updatedWord.frequencyRank);
+                sqlite3_bind_text(stmt, 6, updatedWord.kanji.c_str(), -1, SQLITE_STATIC);
+                bindCloze(stmt, 7, updatedWord);
+                bindKanaKey(stmt, 9, updatedWord);
+                sqlite3_bind_int(stmt, 10, wordId);
                 if( sqlite3_step(stmt) != SQLITE_DONE )
                 {
                     m_logger.log("Database: SQL error while updating word: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
@@ -324,20 +865,44 @@ namespace tadaima
             }
         }
 
-        void ApplicationDatabase::deleteLesson(int lessonId)
+        bool ApplicationDatabase::deleteLesson(int lessonId)
         {
-            const char* sql = "DELETE FROM lessons WHERE id = ?;";
+            if( !beginTransaction() )
+            {
+                return false;
+            }
+
+            // The words go first, together with their tags, reviews, memory states and confusions, so nothing outlives its lesson
+            std::vector<int> wordIds;
+            const char* wordsSql = "SELECT id FROM words WHERE lesson_id = ?;";
             sqlite3_stmt* stmt;
-            if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
+            if( sqlite3_prepare_v2(db, wordsSql, -1, &stmt, 0) == SQLITE_OK )
             {
                 sqlite3_bind_int(stmt, 1, lessonId);
-                if( sqlite3_step(stmt) != SQLITE_DONE )
+                while( sqlite3_step(stmt) == SQLITE_ROW )
                 {
-                    m_logger.log("Database: SQL error while deleting lesson: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                    wordIds.push_back(sqlite3_column_int(stmt, 0));
                 }
                 sqlite3_finalize(stmt);
-                m_logger.log("Database: Deleted lesson ID " + std::to_string(lessonId), tools::LogLevel::INFO);
             }
+
+            const char* sql = "DELETE FROM lessons WHERE id = ?;";
+            bool deleted = deleteWords(wordIds) && sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK;
+            if( deleted )
+            {
+                sqlite3_bind_int(stmt, 1, lessonId);
+                deleted = sqlite3_step(stmt) == SQLITE_DONE;
+                sqlite3_finalize(stmt);
+            }
+
+            if( !deleted || !commitTransaction() )
+            {
+                m_logger.log("Database: SQL error while deleting lesson: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                rollbackTransaction();
+                return false;
+            }
+            m_logger.log("Database: Deleted lesson ID " + std::to_string(lessonId) + " with " + std::to_string(wordIds.size()) + " words", tools::LogLevel::INFO);
+            return true;
         }
 
         void ApplicationDatabase::deleteWord(int wordId)
@@ -356,61 +921,241 @@ namespace tadaima
             }
         }
 
-        std::vector<std::string> ApplicationDatabase::getLessonNames() const
+        bool ApplicationDatabase::moveWords(const std::vector<int>& wordIds, int lessonId)
         {
-            std::vector<std::string> lessonNames;
-            const char* sql = "SELECT main_name, sub_name FROM lessons;";
-            sqlite3_stmt* stmt;
-            if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
+            if( wordIds.empty() )
             {
-                while( sqlite3_step(stmt) == SQLITE_ROW )
-                {
-                    std::string lessonName = std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0))) + " - " + std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)));
-                    lessonNames.push_back(lessonName);
-                }
-                sqlite3_finalize(stmt);
+                return true;
+            }
+
+            const int moved = executeForWords("UPDATE words SET lesson_id = ?2 WHERE id IN (SELECT value FROM json_each(?1));", toJsonArray(wordIds),
+                [lessonId](sqlite3_stmt* stmt) { sqlite3_bind_int(stmt, 2, lessonId); });
+            if( moved < 0 )
+            {
+                m_logger.log("Database: SQL error while moving words: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                return false;
+            }
+            m_logger.log("Database: Moved " + std::to_string(moved) + " words to lesson ID " + std::to_string(lessonId), tools::LogLevel::INFO);
+            return true;
+        }
+
+        bool ApplicationDatabase::copyWords(const std::vector<int>& wordIds, int lessonId)
+        {
+            // Each original is given the ID of its copy up front, after the highest ID the words table ever used, so the
+            // tags can follow their words with a single statement
+            const std::string mapSql =
+                "INSERT INTO temp.copied_words (old_id, new_id) "
+                "SELECT id, (SELECT MAX(last_id) FROM (SELECT MAX(id) AS last_id FROM words UNION ALL "
+                "SELECT seq FROM " + std::string(CONTENT_SCHEMA) + ".sqlite_sequence WHERE name = 'words')) + ROW_NUMBER() OVER (ORDER BY id) "
+                "FROM words WHERE id IN (SELECT value FROM json_each(?1));";
+            const char* copyWordsSql =
+                "INSERT INTO words (id, lesson_id, kana, translation, romaji, example_sentence, frequency_rank, kanji, cloze_start, cloze_length, kana_key) "
+                "SELECT c.new_id, ?2, w.kana, w.translation, w.romaji, w.example_sentence, w.frequency_rank, w.kanji, w.cloze_start, w.cloze_length, w.kana_key "
+                "FROM temp.copied_words c JOIN words w ON w.id = c.old_id ORDER BY c.new_id;";
+            const char* copyTagsSql =
+                "INSERT INTO tags (word_id, tag) SELECT c.new_id, t.tag FROM temp.copied_words c JOIN tags t ON t.word_id = c.old_id ORDER BY t.id;";
+
+            if( wordIds.empty() )
+            {
+                return true;
+            }
+            if( !beginTransaction() )
+            {
+                return false;
+            }
+
+            const std::string ids = toJsonArray(wordIds);
+            int copied = -1;
+            const bool success = sqlite3_exec(db, "DROP TABLE IF EXISTS temp.copied_words;"
+                    "CREATE TEMP TABLE copied_words (old_id INTEGER PRIMARY KEY, new_id INTEGER NOT NULL);", 0, 0, 0) == SQLITE_OK
+                && executeForWords(mapSql.c_str(), ids, {}) >= 0
+                && (copied = executeForWords(copyWordsSql, ids, [lessonId](sqlite3_stmt* stmt) { sqlite3_bind_int(stmt, 2, lessonId); })) >= 0
+                && executeForWords(copyTagsSql, ids, {}) >= 0;
+            if( !success )
+            {
+                m_logger.log("Database: SQL error while copying words: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+            }
+            sqlite3_exec(db, "DROP TABLE IF EXISTS temp.copied_words;", 0, 0, 0);
+
+            if( !success || !commitTransaction() )
+            {
+                rollbackTransaction();
+                return false;
+            }
+            m_logger.log("Database: Copied " + std::to_string(copied) + " words to lesson ID " + std::to_string(lessonId), tools::LogLevel::INFO);
+            return true;
+        }
+
+        bool ApplicationDatabase::deleteWords(const std::vector<int>& wordIds)
+        {
+            if( wordIds.empty() )
+            {
+                return true;
+            }
+            if( !beginTransaction() )
+            {
+                return false;
+            }
+
+            const std::string ids = toJsonArray(wordIds);
+            int deleted = -1;
+            if( executeForWords("DELETE FROM tags WHERE word_id IN (SELECT value FROM json_each(?1));", ids, {}) < 0 ||
+                executeForWords("DELETE FROM reviews WHERE word_id IN (SELECT value FROM json_each(?1));", ids, {}) < 0 ||
+                executeForWords("DELETE FROM memory_state WHERE word_id IN (SELECT value FROM json_each(?1));", ids, {}) < 0 ||
+                executeForWords("DELETE FROM confusions WHERE target_id IN (SELECT value FROM json_each(?1)) OR chosen_id IN (SELECT value FROM json_each(?1));", ids, {}) < 0 ||
+                (deleted = executeForWords("DELETE FROM words WHERE id IN (SELECT value FROM json_each(?1));", ids, {})) < 0 || !commitTransaction() )
+            {
+                m_logger.log("Database: SQL error while deleting words: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                rollbackTransaction();
+                return false;
+            }
+            m_logger.log("Database: Deleted " + std::to_string(deleted) + " words.", tools::LogLevel::INFO);
+            return true;
+        }
+
+        bool ApplicationDatabase::retagWords(const std::vector<int>& wordIds, const std::vector<std::string>& addedTags, const std::vector<std::string>& removedTags)
+        {
+            const char* removeSql = "DELETE FROM tags WHERE word_id IN (SELECT value FROM json_each(?1)) AND tag IN (SELECT value FROM json_each(?2));";
+            const char* addSql =
+                "INSERT INTO tags (word_id, tag) SELECT DISTINCT w.id, t.value FROM words w, json_each(?2) t "
+                "WHERE w.id IN (SELECT value FROM json_each(?1)) AND NOT EXISTS (SELECT 1 FROM tags k WHERE k.word_id = w.id AND k.tag = t.value);";
+
+            if( wordIds.empty() || (addedTags.empty() && removedTags.empty()) )
+            {
+                return true;
+            }
+            if( !beginTransaction() )
+            {
+                return false;
+            }
+
+            const std::string ids = toJsonArray(wordIds);
+            const std::string removed = toJsonArray(removedTags);
+            const std::string added = toJsonArray(addedTags);
+            int removedCount = 0;
+            int addedCount = 0;
+            if( (!removedTags.empty() && (removedCount = executeForWords(removeSql, ids, [&removed](sqlite3_stmt* stmt) { sqlite3_bind_text(stmt, 2, removed.c_str(), -1, SQLITE_STATIC); })) < 0) ||
+                (!addedTags.empty() && (addedCount = executeForWords(addSql, ids, [&added](sqlite3_stmt* stmt) { sqlite3_bind_text(stmt, 2, added.c_str(), -1, SQLITE_STATIC); })) < 0) ||
+                !commitTransaction() )
+            {
+                m_logger.log("Database: SQL error while retagging words: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                rollbackTransaction();
+                return false;
+            }
+            m_logger.log("Database: Retagged " + std::to_string(wordIds.size()) + " words, " + std::to_string(addedCount) + " tags added, " + std::to_string(removedCount) + " removed.", tools::LogLevel::INFO);
+            return true;
+        }
+
+        int ApplicationDatabase::executeForWords(const char* sql, const std::string& wordIds, const std::function<void(sqlite3_stmt*)>& bind)
+        {
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) != SQLITE_OK )
+            {
+                return -1;
+            }
+
+            sqlite3_bind_text(stmt, 1, wordIds.c_str(), -1, SQLITE_STATIC);
+            if( bind )
+            {
+                bind(stmt);
+            }
+            const bool done = sqlite3_step(stmt) == SQLITE_DONE;
+            sqlite3_finalize(stmt);
+            return done ? sqlite3_changes(db) : -1;
+        }
+
+        std::vector<std::string> ApplicationDatabase::getLessonNames() const
+        {
+            std::vector<std::string> lessonNames;
+            const char* sql = "SELECT main_name, sub_name FROM lessons;";
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
+            {
+                while( sqlite3_step(stmt) == SQLITE_ROW )
+                {
+                    std::string lessonName = std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0))) + " - " + std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)));
+                    lessonNames.push_back(lessonName);
+                }
+                sqlite3_finalize(stmt);
             }
             return lessonNames;
         }
 
         std::vector<Word> ApplicationDatabase::getWordsInLesson(int lessonId) const
         {
+            AllocationScope scope(AllocationTag::Database);
             std::vector<Word> words;
-            const char* sql = "SELECT id, kana, translation, romaji, example_sentence FROM words WHERE lesson_id = ?;";
+            const char* sql = "SELECT id, kana, translation, romaji, example_sentence, frequency_rank, kanji, cloze_start, cloze_length FROM words WHERE lesson_id = ?;";
             sqlite3_stmt* stmt;
             if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
             {
                 sqlite3_bind_int(stmt, 1, lessonId);
-                while( sqlite3_step(stmt) == SQLITE_ROW )
+                words = readWords(stmt);
+                sqlite3_finalize(stmt);
+            }
+            return words;
+        }
+
+        std::vector<Word> ApplicationDatabase::getWords(const std::vector<int>& wordIds) const
+        {
+            AllocationScope scope(AllocationTag::Database);
+            std::vector<Word> words;
+            if( wordIds.empty() )
+            {
+                return words;
+            }
+            const char* sql = "SELECT id, kana, translation, romaji, example_sentence, frequency_rank, kanji, cloze_start, cloze_length FROM words WHERE id IN (SELECT value FROM json_each(?1));";
+            const std::string ids = toJsonArray(wordIds);
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
+            {
+                sqlite3_bind_text(stmt, 1, ids.c_str(), -1, SQLITE_STATIC);
+                words = readWords(stmt);
+                sqlite3_finalize(stmt);
+            }
+            else
+            {
+                m_logger.log("Database: SQL error while loading words: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+            }
+            return words;
+        }
+
+        std::vector<Word> ApplicationDatabase::readWords(sqlite3_stmt* stmt) const
+        {
+            std::vector<Word> words;
+            while( sqlite3_step(stmt) == SQLITE_ROW )
+            {
+                Word word;
+                word.id = sqlite3_column_int(stmt, 0);
+                word.kana = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+                word.translation = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+                word.romaji = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+                word.exampleSentence = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4));
+                word.frequencyRank = sqlite3_column_int(stmt, 5);
+                word.kanji = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 6));
+                word.clozeStart = sqlite3_column_int(stmt, 7);
+                word.clozeLength = sqlite3_column_int(stmt, 8);
+
+                // Get tags for this word
+                const char* tagSql = "SELECT tag FROM tags WHERE word_id = ?;";
+                sqlite3_stmt* tagStmt;
+                if( sqlite3_prepare_v2(db, tagSql, -1, &tagStmt, 0) == SQLITE_OK )
                 {
-                    Word word;
-                    word.id = sqlite3_column_int(stmt, 0);
-                    word.kana = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
-                    word.translation = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
-                    word.romaji = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
-                    word.exampleSentence = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 4));
-
-                    // Get tags for this word
-                    const char* tagSql = "SELECT tag FROM tags WHERE word_id = ?;";
-                    sqlite3_stmt* tagStmt;
-                    if( sqlite3_prepare_v2(db, tagSql, -1, &tagStmt, 0) == SQLITE_OK )
+                    sqlite3_bind_int(tagStmt, 1, word.id);
+                    while( sqlite3_step(tagStmt) == SQLITE_ROW )
                     {
-                        sqlite3_bind_int(tagStmt, 1, word.id);
-                        while( sqlite3_step(tagStmt) == SQLITE_ROW )
-                        {
-                            word.tags.push_back(reinterpret_cast<const char*>(sqlite3_column_text(tagStmt, 0)));
-                        }
-                        sqlite3_finalize(tagStmt);
+                        word.tags.push_back(reinterpret_cast<const char*>(sqlite3_column_text(tagStmt, 0)));
                     }
-                    words.push_back(word);
+                    sqlite3_finalize(tagStmt);
                 }
-                sqlite3_finalize(stmt);
+                words.push_back(word);
             }
             return words;
         }
 
         std::vector<Lesson> ApplicationDatabase::getAllLessons() const
         {
+            AllocationScope scope(AllocationTag::Database);
             std::vector<Lesson> lessons;
             const char* sql = "SELECT id, main_name, sub_name FROM lessons;";
             sqlite3_stmt* stmt;
@@ -432,6 +1177,195 @@ namespace tadaima
             return lessons;
         }
 
+        std::vector<Lesson> ApplicationDatabase::getLessons(const std::vector<int>& lessonIds) const
+        {
+            AllocationScope scope(AllocationTag::Database);
+            std::vector<Lesson> lessons;
+            if( lessonIds.empty() )
+            {
+                return lessons;
+            }
+            const char* sql = "SELECT id, main_name, sub_name FROM lessons WHERE id IN (SELECT value FROM json_each(?1)) ORDER BY id;";
+            const std::string ids = toJsonArray(lessonIds);
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
+            {
+                sqlite3_bind_text(stmt, 1, ids.c_str(), -1, SQLITE_STATIC);
+                while( sqlite3_step(stmt) == SQLITE_ROW )
+                {
+                    Lesson lesson;
+                    lesson.id = sqlite3_column_int(stmt, 0);
+                    lesson.mainName = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+                    lesson.subName = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+                    lesson.words = getWordsInLesson(lesson.id);
+                    lessons.push_back(lesson);
+                }
+                sqlite3_finalize(stmt);
+            }
+            else
+            {
+                m_logger.log("Database: SQL error while loading lessons: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+            }
+            return lessons;
+        }
+
+        std::vector<int> ApplicationDatabase::getLessonIdsOfWords(const std::vector<int>& wordIds) const
+        {
+            AllocationScope scope(AllocationTag::Database);
+            std::vector<int> lessonIds;
+            if( wordIds.empty() )
+            {
+                return lessonIds;
+            }
+            const char* sql = "SELECT DISTINCT lesson_id FROM words WHERE id IN (SELECT value FROM json_each(?1));";
+            const std::string ids = toJsonArray(wordIds);
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
+            {
+                sqlite3_bind_text(stmt, 1, ids.c_str(), -1, SQLITE_STATIC);
+                while( sqlite3_step(stmt) == SQLITE_ROW )
+                {
+                    lessonIds.push_back(sqlite3_column_int(stmt, 0));
+                }
+                sqlite3_finalize(stmt);
+            }
+            else
+            {
+                m_logger.log("Database: SQL error while loading the lessons of words: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+            }
+            return lessonIds;
+        }
+
+        void ApplicationDatabase::forEachWord(const std::vector<int>& lessonIds, const std::function<void(const Lesson&, const Word&)>& visitor) const
+        {
+            AllocationScope scope(AllocationTag::Database);
+            std::string sql =
+                "SELECT l.id, l.main_name, l.sub_name, w.id, w.kana, w.translation, w.romaji, w.example_sentence, w.frequency_rank, w.kanji, w.cloze_start, w.cloze_length, "
+                "(SELECT group_concat(tag, char(31)) FROM tags WHERE word_id = w.id) "
+                "FROM words w JOIN lessons l ON l.id = w.lesson_id";
+            if( !lessonIds.empty() )
+            {
+                std::string placeholders;
+                for( size_t i = 0; i < lessonIds.size(); ++i )
+                {
+                    placeholders += (i == 0 ? "?" : ", ?");
+                }
+                sql += " WHERE l.id IN (" + placeholders + ")";
+            }
+            sql += " ORDER BY l.id, w.id;";
+
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, 0) != SQLITE_OK )
+            {
+                m_logger.log("Database: SQL error while reading words: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                return;
+            }
+
+            for( size_t i = 0; i < lessonIds.size(); ++i )
+            {
+                sqlite3_bind_int(stmt, static_cast<int>(i) + 1, lessonIds[i]);
+            }
+
+            auto columnText = [stmt](int column)
+                {
+                    const unsigned char* text = sqlite3_column_text(stmt, column);
+                    return text ? std::string(reinterpret_cast<const char*>(text)) : std::string();
+                };
+
+            Lesson lesson;
+            lesson.id = -1;
+            Word word;
+            while( sqlite3_step(stmt) == SQLITE_ROW )
+            {
+                if( sqlite3_column_int(stmt, 0) != lesson.id )
+                {
+                    lesson.id = sqlite3_column_int(stmt, 0);
+                    lesson.mainName = columnText(1);
+                    lesson.subName = columnText(2);
+                }
+
+                word.id = sqlite3_column_int(stmt, 3);
+                word.kana = columnText(4);
+                word.translation = columnText(5);
+                word.romaji = columnText(6);
+                word.exampleSentence = columnText(7);
+                word.frequencyRank = sqlite3_column_int(stmt, 8);
+                word.kanji = columnText(9);
+                word.clozeStart = sqlite3_column_int(stmt, 10);
+                word.clozeLength = sqlite3_column_int(stmt, 11);
+                word.tags.clear();
+
+                const std::string tags = columnText(12);
+                for( size_t begin = 0; !tags.empty() && begin <= tags.size(); )
+                {
+                    const size_t end = std::min(tags.find('\x1f', begin), tags.size());
+                    word.tags.push_back(tags.substr(begin, end - begin));
+                    begin = end + 1;
+                }
+
+                visitor(lesson, word);
+            }
+            sqlite3_finalize(stmt);
+        }
+
+        std::vector<Word> ApplicationDatabase::findSimilarWords(const std::string& text, int maxDistance, int limit) const
+        {
+            AllocationScope scope(AllocationTag::Database);
+            std::vector<Word> words;
+            const std::string query = normalizeJapanese(text);
+            if( query.empty() )
+            {
+                return words;
+            }
+
+            // Romaji input is matched against the transliterated kana, anything else against the normalized kana
+            const bool romaji = std::all_of(query.begin(), query.end(), [](char character) { return static_cast<unsigned char>(character) < 0x80; });
+            const std::string spelling = romaji ? "to_romaji(w.kana_key)" : "w.kana_key";
+
+            // Candidates sharing the first character are ranges of idx_words_kana_key in every lesson, and only those within
+            // the length window are compared character by character
+            const std::string prefixes = toJsonArray(kanaKeyPrefixes(query, romaji));
+            const std::string sql =
+                "SELECT id, kana, translation, romaji, example_sentence, frequency_rank, kanji, cloze_start, cloze_length FROM ("
+                "SELECT w.*, edit_distance(" + spelling + ", ?1) AS distance FROM json_each(?4) p CROSS JOIN lessons l CROSS JOIN words w "
+                "WHERE w.lesson_id = l.id AND w.kana_key >= p.value AND w.kana_key < p.value || char(1114111) "
+                "AND abs(length(" + spelling + ") - length(?1)) <= ?2) "
+                "WHERE distance <= ?2 ORDER BY distance, kana COLLATE GOJUON LIMIT ?3;";
+
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, 0) != SQLITE_OK )
+            {
+                m_logger.log("Database: SQL error while searching words: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                return words;
+            }
+            sqlite3_bind_text(stmt, 1, query.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_int(stmt, 2, std::max(0, maxDistance));
+            sqlite3_bind_int(stmt, 3, limit);
+            sqlite3_bind_text(stmt, 4, prefixes.c_str(), -1, SQLITE_STATIC);
+
+            auto columnText = [stmt](int column)
+                {
+                    const unsigned char* value = sqlite3_column_text(stmt, column);
+                    return value ? std::string(reinterpret_cast<const char*>(value)) : std::string();
+                };
+            while( sqlite3_step(stmt) == SQLITE_ROW )
+            {
+                Word word;
+                word.id = sqlite3_column_int(stmt, 0);
+                word.kana = columnText(1);
+                word.translation = columnText(2);
+                word.romaji = columnText(3);
+                word.exampleSentence = columnText(4);
+                word.frequencyRank = sqlite3_column_int(stmt, 5);
+                word.kanji = columnText(6);
+                word.clozeStart = sqlite3_column_int(stmt, 7);
+                word.clozeLength = sqlite3_column_int(stmt, 8);
+                words.push_back(word);
+            }
+            sqlite3_finalize(stmt);
+            return words;
+        }
+
         void ApplicationDatabase::saveSettings(const ApplicationSettings& settings)
         {
             m_logger.log("Database: Saving application settings.", tools::LogLevel::INFO);
@@ -459,6 +1393,19 @@ namespace tadaima
             saveSetting("inputWord", settings.inputWord);
             saveSetting("translatedWord", settings.translatedWord);
             saveSetting("showLogs", settings.showLogs ? "true" : "false");
+            saveSetting("frequencyListPath", settings.frequencyListPath);
+            saveSetting("frequencyOrder", settings.frequencyOrder ? "true" : "false");
+            saveSetting("adaptiveOrder", settings.adaptiveOrder ? "true" : "false");
+            saveSetting("memoryInitialStability", std::format("{}", settings.memoryModel.initialStability));
+            saveSetting("memoryGrowthRate", std::format("{}", settings.memoryModel.growthRate));
+            saveSetting("memoryStabilityDecay", std::format("{}", settings.memoryModel.stabilityDecay));
+            saveSetting("memoryRetrievabilityGain", std::format("{}", settings.memoryModel.retrievabilityGain));
+            saveSetting("memoryLapseFactor", std::format("{}", settings.memoryModel.lapseFactor));
+            saveSetting("memoryDesiredRetention", std::format("{}", settings.memoryModel.desiredRetention));
+            saveSetting("leechLapseThreshold", std::to_string(settings.leech.lapseThreshold));
+            saveSetting("leechRepeatInterval", std::to_string(settings.leech.repeatInterval));
+            saveSetting("groupCommitWindowMs", std::to_string(settings.groupCommit.windowMs));
+            saveSetting("groupCommitMaxOperations", std::to_string(settings.groupCommit.maxOperations));
         }
 
         ApplicationSettings ApplicationDatabase::loadSettings()
@@ -483,6 +1430,8 @@ namespace tadaima
                 };
 
             std::string showLogs = "";
+            std::string frequencyOrder = "";
+            std::string adaptiveOrder = "";
             loadSetting("userName", settings.userName);
             loadSetting("dictionaryPath", settings.dictionaryPath);
             loadSetting("QuizzesPath", settings.quizzesPaths);
@@ -490,8 +1439,691 @@ namespace tadaima
             loadSetting("translatedWord", settings.translatedWord);
             loadSetting("showLogs", showLogs);
             settings.showLogs = showLogs == "true" ? true : false;
+            loadSetting("frequencyListPath", settings.frequencyListPath);
+            loadSetting("frequencyOrder", frequencyOrder);
+            settings.frequencyOrder = frequencyOrder == "true";
+            loadSetting("adaptiveOrder", adaptiveOrder);
+            settings.adaptiveOrder = adaptiveOrder == "true";
+
+            auto loadNumber = [&](const char* key, double& value)
+                {
+                    std::string text;
+                    loadSetting(key, text);
+                    try
+                    {
+                        value = text.empty() ? value : std::stod(text);
+                    }
+                    catch( const std::exception& )
+                    {
+                        m_logger.log("Database: Invalid value of setting " + std::string(key) + ": " + text, tools::LogLevel::WARNING);
+                    }
+                };
+
+            loadNumber("memoryInitialStability", settings.memoryModel.initialStability);
+            loadNumber("memoryGrowthRate", settings.memoryModel.growthRate);
+            loadNumber("memoryStabilityDecay", settings.memoryModel.stabilityDecay);
+            loadNumber("memoryRetrievabilityGain", settings.memoryModel.retrievabilityGain);
+            loadNumber("memoryLapseFactor", settings.memoryModel.lapseFactor);
+            loadNumber("memoryDesiredRetention", settings.memoryModel.desiredRetention);
+
+            double leechLapseThreshold = settings.leech.lapseThreshold;
+            double leechRepeatInterval = settings.leech.repeatInterval;
+            loadNumber("leechLapseThreshold", leechLapseThreshold);
+            loadNumber("leechRepeatInterval", leechRepeatInterval);
+            settings.leech.lapseThreshold = static_cast<int>(leechLapseThreshold);
+            settings.leech.repeatInterval = static_cast<int>(leechRepeatInterval);
+
+            double groupCommitWindowMs = settings.groupCommit.windowMs;
+            double groupCommitMaxOperations = settings.groupCommit.maxOperations;
+            loadNumber("groupCommitWindowMs", groupCommitWindowMs);
+            loadNumber("groupCommitMaxOperations", groupCommitMaxOperations);
+            settings.groupCommit.windowMs = static_cast<int>(groupCommitWindowMs);
+            settings.groupCommit.maxOperations = static_cast<int>(groupCommitMaxOperations);
 
             return settings;
         }
+
+        bool ApplicationDatabase::addReview(const review::ReviewRecord& record)
+        {
+            const char* sql = "INSERT INTO reviews (word_id, timestamp, correct) VALUES (?, ?, ?);";
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
+            {
+                sqlite3_bind_int(stmt, 1, record.wordId);
+                sqlite3_bind_int64(stmt, 2, record.timestamp);
+                sqlite3_bind_int(stmt, 3, record.correct ? 1 : 0);
+                if( sqlite3_step(stmt) != SQLITE_DONE )
+                {
+                    m_logger.log("Database: SQL error while adding review: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                    sqlite3_finalize(stmt);
+                    return false;
+                }
+                sqlite3_finalize(stmt);
+                return true;
+            }
+            return false;
+        }
+
+        std::vector<review::ReviewRecord> ApplicationDatabase::getReviews() const
+        {
+            AllocationScope scope(AllocationTag::Database);
+            std::vector<review::ReviewRecord> reviews;
+            const char* sql =
+                "SELECT r.word_id, r.timestamp, r.correct FROM reviews r "
+                "JOIN words w ON w.id = r.word_id JOIN lessons l ON l.id = w.lesson_id ORDER BY r.word_id, r.timestamp;";
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
+            {
+                while( sqlite3_step(stmt) == SQLITE_ROW )
+                {
+                    review::ReviewRecord record;
+                    record.wordId = sqlite3_column_int(stmt, 0);
+                    record.timestamp = sqlite3_column_int64(stmt, 1);
+                    record.correct = sqlite3_column_int(stmt, 2) != 0;
+                    reviews.push_back(record);
+                }
+                sqlite3_finalize(stmt);
+            }
+            return reviews;
+        }
+
+        bool ApplicationDatabase::addConfusion(const review::Confusion& confusion)
+        {
+            // A new pair of a word with a full list first replaces the least frequent and oldest pair, like ConfusionTable
+            const char* evictSql =
+                "DELETE FROM confusions WHERE target_id = ?1 AND chosen_id = ("
+                "SELECT chosen_id FROM confusions WHERE target_id = ?1 ORDER BY count ASC, last_seen ASC LIMIT 1) "
+                "AND NOT EXISTS (SELECT 1 FROM confusions WHERE target_id = ?1 AND chosen_id = ?2) "
+                "AND (SELECT COUNT(*) FROM confusions WHERE target_id = ?1) >= ?3;";
+            const char* upsertSql =
+                "INSERT INTO confusions (target_id, chosen_id, count, last_seen) VALUES (?1, ?2, 1, ?3) "
+                "ON CONFLICT(target_id, chosen_id) DO UPDATE SET count = count + 1, last_seen = MAX(last_seen, excluded.last_seen);";
+
+            if( !beginTransaction() )
+            {
+                return false;
+            }
+
+            bool stored = false;
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, evictSql, -1, &stmt, 0) == SQLITE_OK )
+            {
+                sqlite3_bind_int(stmt, 1, confusion.targetId);
+                sqlite3_bind_int(stmt, 2, confusion.chosenId);
+                sqlite3_bind_int(stmt, 3, static_cast<int>(review::ConfusionTable::MAX_PER_WORD));
+                stored = sqlite3_step(stmt) == SQLITE_DONE;
+                sqlite3_finalize(stmt);
+            }
+            if( stored && sqlite3_prepare_v2(db, upsertSql, -1, &stmt, 0) == SQLITE_OK )
+            {
+                sqlite3_bind_int(stmt, 1, confusion.targetId);
+                sqlite3_bind_int(stmt, 2, confusion.chosenId);
+                sqlite3_bind_int64(stmt, 3, confusion.lastSeen);
+                stored = sqlite3_step(stmt) == SQLITE_DONE;
+                sqlite3_finalize(stmt);
+            }
+
+            if( !stored )
+            {
+                m_logger.log("Database: SQL error while adding confusion: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                rollbackTransaction();
+                return false;
+            }
+            if( !commitTransaction() )
+            {
+                rollbackTransaction();
+                return false;
+            }
+            return true;
+        }
+
+        std::vector<review::Confusion> ApplicationDatabase::getConfusions() const
+        {
+            AllocationScope scope(AllocationTag::Database);
+            std::vector<review::Confusion> confusions;
+            const char* sql =
+                "SELECT c.target_id, c.chosen_id, c.count, c.last_seen FROM confusions c "
+                "JOIN words t ON t.id = c.target_id JOIN words w ON w.id = c.chosen_id "
+                "ORDER BY c.count DESC, c.last_seen DESC;";
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
+            {
+                while( sqlite3_step(stmt) == SQLITE_ROW )
+                {
+                    review::Confusion confusion;
+                    confusion.targetId = sqlite3_column_int(stmt, 0);
+                    confusion.chosenId = sqlite3_column_int(stmt, 1);
+                    confusion.count = sqlite3_column_int(stmt, 2);
+                    confusion.lastSeen = sqlite3_column_int64(stmt, 3);
+                    confusions.push_back(confusion);
+                }
+                sqlite3_finalize(stmt);
+            }
+            return confusions;
+        }
+
+        bool ApplicationDatabase::updateFrequencyRanks(const std::vector<std::pair<int, int>>& ranks)
+        {
+            const char* sql = "UPDATE words SET frequency_rank = ? WHERE id = ?;";
+            sqlite3_stmt* stmt;
+
+            // Without the transaction every update would be committed on its own
+            if( !beginTransaction() )
+            {
+                m_logger.log("Database: Frequency ranks of " + std::to_string(ranks.size()) + " words were not updated.", tools::LogLevel::PROBLEM);
+                return false;
+            }
+            bool updated = sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK;
+            if( updated )
+            {
+                for( const auto& [wordId, rank] : ranks )
+                {
+                    sqlite3_bind_int(stmt, 1, rank);
+                    sqlite3_bind_int(stmt, 2, wordId);
+                    updated = sqlite3_step(stmt) == SQLITE_DONE;
+                    if( !updated )
+                    {
+                        break;
+                    }
+                    sqlite3_reset(stmt);
+                }
+            }
+            if( !updated )
+            {
+                // A partial update would leave the frequency order of the quizzes inconsistent
+                m_logger.log("Database: SQL error while updating frequency rank: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+            }
+            sqlite3_finalize(stmt);
+            if( !updated || !commitTransaction() )
+            {
+                rollbackTransaction();
+                return false;
+            }
+            m_logger.log("Database: Updated frequency ranks of " + std::to_string(ranks.size()) + " words.", tools::LogLevel::INFO);
+            return true;
+        }
+
+        bool ApplicationDatabase::saveMemoryState(const review::MemoryState& state)
+        {
+            return saveMemoryStates({ state });
+        }
+
+        bool ApplicationDatabase::saveMemoryStates(const std::vector<review::MemoryState>& states)
+        {
+            const char* sql =
+                "REPLACE INTO memory_state (word_id, stability, difficulty, last_review, review_count, lapses) "
+                "VALUES (?, ?, ?, ?, ?, ?);";
+            sqlite3_stmt* stmt;
+
+            // Without the transaction every state would be committed on its own
+            if( !beginTransaction() )
+            {
+                m_logger.log("Database: Memory states of " + std::to_string(states.size()) + " words were not saved.", tools::LogLevel::PROBLEM);
+                return false;
+            }
+            bool saved = sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK;
+            if( saved )
+            {
+                for( const auto& state : states )
+                {
+                    sqlite3_bind_int(stmt, 1, state.wordId);
+                    sqlite3_bind_double(stmt, 2, state.stability);
+                    sqlite3_bind_double(stmt, 3, state.difficulty);
+                    sqlite3_bind_int64(stmt, 4, state.lastReview);
+                    sqlite3_bind_int(stmt, 5, state.reviewCount);
+                    sqlite3_bind_int(stmt, 6, state.lapses);
+                    saved = sqlite3_step(stmt) == SQLITE_DONE;
+                    if( !saved )
+                    {
+                        break;
+                    }
+                    sqlite3_reset(stmt);
+                }
+            }
+            if( !saved )
+            {
+                m_logger.log("Database: SQL error while saving memory state: " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+            }
+            sqlite3_finalize(stmt);
+            if( !saved || !commitTransaction() )
+            {
+                rollbackTransaction();
+                return false;
+            }
+            return true;
+        }
+
+        review::MemoryState ApplicationDatabase::getMemoryState(int wordId) const
+        {
+            review::MemoryState state;
+            state.wordId = wordId;
+
+            const char* sql = "SELECT stability, difficulty, last_review, review_count, lapses FROM memory_state WHERE word_id = ?;";
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
+            {
+                sqlite3_bind_int(stmt, 1, wordId);
+                if( sqlite3_step(stmt) == SQLITE_ROW )
+                {
+                    state.stability = sqlite3_column_double(stmt, 0);
+                    state.difficulty = sqlite3_column_double(stmt, 1);
+                    state.lastReview = sqlite3_column_int64(stmt, 2);
+                    state.reviewCount = sqlite3_column_int(stmt, 3);
+                    state.lapses = sqlite3_column_int(stmt, 4);
+                }
+                sqlite3_finalize(stmt);
+            }
+            return state;
+        }
+
+        std::vector<review::MemoryState> ApplicationDatabase::getMemoryStates() const
+        {
+            AllocationScope scope(AllocationTag::Database);
+            std::vector<review::MemoryState> states;
+            const char* sql =
+                "SELECT m.word_id, m.stability, m.difficulty, m.last_review, m.review_count, m.lapses "
+                "FROM memory_state m JOIN words w ON w.id = m.word_id JOIN lessons l ON l.id = w.lesson_id WHERE m.review_count > 0;";
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
+            {
+                while( sqlite3_step(stmt) == SQLITE_ROW )
+                {
+                    review::MemoryState state;
+                    state.wordId = sqlite3_column_int(stmt, 0);
+                    state.stability = sqlite3_column_double(stmt, 1);
+                    state.difficulty = sqlite3_column_double(stmt, 2);
+                    state.lastReview = sqlite3_column_int64(stmt, 3);
+                    state.reviewCount = sqlite3_column_int(stmt, 4);
+                    state.lapses = sqlite3_column_int(stmt, 5);
+                    states.push_back(state);
+                }
+                sqlite3_finalize(stmt);
+            }
+            return states;
+        }
+
+        int ApplicationDatabase::removeDuplicateWords()
+        {
+            const char* collectSql =
+                "DROP TABLE IF EXISTS temp.duplicate_words;"
+                "CREATE TEMP TABLE duplicate_words AS "
+                "SELECT id, keep_id FROM ("
+                "SELECT w.id AS id, (SELECT MIN(k.id) FROM words k WHERE k.lesson_id IS w.lesson_id AND k.kana_key = w.kana_key AND k.kanji = w.kanji "
+                "AND IFNULL(k.romaji, '') = IFNULL(w.romaji, '') AND k.translation = w.translation) AS keep_id FROM words w) "
+                "WHERE id <> keep_id;";
+            const char* mergeSql =
+                "UPDATE reviews SET word_id = (SELECT keep_id FROM duplicate_words d WHERE d.id = reviews.word_id) "
+                "WHERE word_id IN (SELECT id FROM duplicate_words);"
+                "INSERT INTO tags (word_id, tag) SELECT DISTINCT d.keep_id, t.tag FROM tags t JOIN duplicate_words d ON d.id = t.word_id "
+                "WHERE NOT EXISTS (SELECT 1 FROM tags k WHERE k.word_id = d.keep_id AND k.tag = t.tag);"
+                "DELETE FROM tags WHERE word_id IN (SELECT id FROM duplicate_words);"
+                "INSERT INTO confusions (target_id, chosen_id, count, last_seen) "
+                "SELECT IFNULL(t.keep_id, c.target_id), IFNULL(w.keep_id, c.chosen_id), c.count, c.last_seen FROM confusions c "
+                "LEFT JOIN duplicate_words t ON t.id = c.target_id LEFT JOIN duplicate_words w ON w.id = c.chosen_id "
+                "WHERE (t.id IS NOT NULL OR w.id IS NOT NULL) AND IFNULL(t.keep_id, c.target_id) <> IFNULL(w.keep_id, c.chosen_id) "
+                "ON CONFLICT(target_id, chosen_id) DO UPDATE SET count = count + excluded.count, last_seen = MAX(last_seen, excluded.last_seen);"
+                "DELETE FROM confusions WHERE target_id IN (SELECT id FROM duplicate_words) OR chosen_id IN (SELECT id FROM duplicate_words);"
+                "DELETE FROM memory_state WHERE word_id IN (SELECT id FROM duplicate_words);"
+                "DELETE FROM words WHERE id IN (SELECT id FROM duplicate_words);";
+
+            char* errMsg = nullptr;
+            if( sqlite3_exec(db, collectSql, 0, 0, &errMsg) != SQLITE_OK )
+            {
+                m_logger.log("Database: SQL error while collecting duplicate words: " + std::string(errMsg), tools::LogLevel::PROBLEM);
+                sqlite3_free(errMsg);
+                return -1;
+            }
+
+            int count = 0;
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM duplicate_words;", -1, &stmt, 0) == SQLITE_OK )
+            {
+                if( sqlite3_step(stmt) == SQLITE_ROW )
+                {
+                    count = sqlite3_column_int(stmt, 0);
+                }
+                sqlite3_finalize(stmt);
+            }
+
+            if( count > 0 && !beginTransaction() )
+            {
+                count = -1;
+            }
+            else if( count > 0 )
+            {
+                if( sqlite3_exec(db, mergeSql, 0, 0, &errMsg) != SQLITE_OK || !commitTransaction() )
+                {
+                    m_logger.log("Database: SQL error while removing duplicate words: " + std::string(errMsg ? errMsg : sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                    sqlite3_free(errMsg);
+                    rollbackTransaction();
+                    count = -1;
+                }
+            }
+            sqlite3_exec(db, "DROP TABLE IF EXISTS temp.duplicate_words;", 0, 0, 0);
+
+            if( count > 0 )
+            {
+                m_logger.log("Database: Removed " + std::to_string(count) + " duplicate words.", tools::LogLevel::INFO);
+            }
+            return count;
+        }
+
+        bool ApplicationDatabase::beginTransaction()
+        {
+            // Savepoints nest, the outermost one opens a transaction which is committed when it is released
+            char* errMsg = nullptr;
+            if( sqlite3_exec(db, "SAVEPOINT tadaima;", 0, 0, &errMsg) != SQLITE_OK )
+            {
+                m_logger.log("Database: SQL error while starting transaction: " + std::string(errMsg), tools::LogLevel::PROBLEM);
+                sqlite3_free(errMsg);
+                return false;
+            }
+            return true;
+        }
+
+        bool ApplicationDatabase::commitTransaction()
+        {
+            char* errMsg = nullptr;
+            if( sqlite3_exec(db, "RELEASE tadaima;", 0, 0, &errMsg) != SQLITE_OK )
+            {
+                m_logger.log("Database: SQL error while committing transaction: " + std::string(errMsg), tools::LogLevel::PROBLEM);
+                sqlite3_free(errMsg);
+                return false;
+            }
+            return true;
+        }
+
+        void ApplicationDatabase::rollbackTransaction()
+        {
+            sqlite3_exec(db, "ROLLBACK TO tadaima; RELEASE tadaima;", 0, 0, 0);
+        }
+
+        bool ApplicationDatabase::backup(const std::string& path, const std::string& schema) const
+        {
+            sqlite3* target = nullptr;
+            if( sqlite3_open(path.c_str(), &target) != SQLITE_OK )
+            {
+                m_logger.log("Database: Can't open backup file " + path + ": " + std::string(sqlite3_errmsg(target)), tools::LogLevel::PROBLEM);
+                sqlite3_close(target);
+                return false;
+            }
+
+            bool done = false;
+            sqlite3_backup* backup = sqlite3_backup_init(target, "main", db, schema.c_str());
+            if( backup )
+            {
+                done = sqlite3_backup_step(backup, -1) == SQLITE_DONE;
+                sqlite3_backup_finish(backup);
+            }
+            if( !done )
+            {
+                m_logger.log("Database: Backup to " + path + " failed: " + std::string(sqlite3_errmsg(target)), tools::LogLevel::PROBLEM);
+            }
+            sqlite3_close(target);
+            return done;
+        }
+
+        std::vector<MaintenanceTask> ApplicationDatabase::maintenanceTasks()
+        {
+            const std::pair<const char*, bool> tables[] =
+            {
+                { "lessons", true }, { "words", true }, { "tags", true },
+                { "settings", false }, { "reviews", false }, { "memory_state", false }, { "confusions", false }
+            };
+
+            std::vector<std::string> writableSchemas = { "main" };
+            auto analyzed = std::make_shared<MaintenanceProgress>();
+            auto checked = std::make_shared<MaintenanceProgress>();
+            auto vacuumed = std::make_shared<MaintenanceProgress>();
+            auto merged = std::make_shared<MaintenanceProgress>();
+            if( !m_readOnlyDeck )
+            {
+                writableSchemas.push_back(CONTENT_SCHEMA);
+            }
+            for( const auto& [table, content] : tables )
+            {
+                const std::string schema = content ? CONTENT_SCHEMA : "main";
+                checked->tables.emplace_back(schema, table);
+                if( !content || !m_readOnlyDeck )
+                {
+                    analyzed->tables.emplace_back(schema, table);
+                }
+            }
+            for( const auto& schema : writableSchemas )
+            {
+                vacuumed->tables.emplace_back(schema, "");
+            }
+            sqlite3_exec(db, ("PRAGMA analysis_limit = " + std::to_string(ANALYSIS_LIMIT) + ";").c_str(), 0, 0, 0);
+
+            constexpr auto DAY = std::chrono::hours(24);
+            std::vector<MaintenanceTask> tasks;
+            tasks.push_back({ "optimize", std::chrono::duration_cast<std::chrono::seconds>(DAY), [this, writableSchemas](const MaintenanceBudget& budget)
+                {
+                    for( const auto& schema : writableSchemas )
+                    {
+                        const MaintenanceStatus status = runMaintenanceStatement("PRAGMA " + schema + ".optimize;", budget);
+                        if( status != MaintenanceStatus::Done )
+                        {
+                            return status;
+                        }
+                    }
+                    return MaintenanceStatus::Done;
+                } });
+
+            tasks.push_back({ "analyze", std::chrono::duration_cast<std::chrono::seconds>(DAY * 7), [this, analyzed](const MaintenanceBudget& budget)
+                {
+                    return stepThroughTables(*analyzed, budget, [this, &budget](const std::string& schema, const std::string& table)
+                        {
+                            return runMaintenanceStatement("ANALYZE " + schema + "." + table + ";", budget);
+                        });
+                } });
+
+            tasks.push_back({ "vacuum", std::chrono::duration_cast<std::chrono::seconds>(DAY), [this, vacuumed](const MaintenanceBudget& budget)
+                {
+                    return stepThroughTables(*vacuumed, budget, [this, &budget](const std::string& schema, const std::string&)
+                        {
+                            if( pragmaValue(schema, "auto_vacuum") != INCREMENTAL_VACUUM )
+                            {
+                                return MaintenanceStatus::Done;
+                            }
+                            while( pragmaValue(schema, "freelist_count") > 0 )
+                            {
+                                if( budget.exhausted() )
+                                {
+                                    return MaintenanceStatus::Pending;
+                                }
+                                const MaintenanceStatus status = runMaintenanceStatement("PRAGMA " + schema + ".incremental_vacuum(" + std::to_string(VACUUM_PAGES) + ");", budget);
+                                if( status != MaintenanceStatus::Done )
+                                {
+                                    return status;
+                                }
+                            }
+                            return MaintenanceStatus::Done;
+                        });
+                } });
+
+            // Incremental vacuum has to be switched on by rebuilding the file once. The rebuild cannot be split into steps,
+            // so it is only started when the database can be copied within the step, otherwise the step times out at once
+            // and is repeated with a longer budget
+            tasks.push_back({ "vacuum conversion", std::chrono::duration_cast<std::chrono::seconds>(DAY * 7), [this, writableSchemas](const MaintenanceBudget& budget)
+                {
+                    const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(budget.deadline - std::chrono::steady_clock::now());
+                    for( const auto& schema : writableSchemas )
+                    {
+                        const long long pageCount = pragmaValue(schema, "page_count");
+                        const long long freePages = pragmaValue(schema, "freelist_count");
+                        if( pragmaValue(schema, "auto_vacuum") != NO_VACUUM || freePages < pageCount * VACUUM_CONVERSION_SHARE )
+                        {
+                            continue;
+                        }
+                        if( budget.deadline != std::chrono::steady_clock::time_point::max() && (pageCount - freePages) > remaining.count() * VACUUM_PAGES_PER_MS )
+                        {
+                            m_logger.log("Database: Converting " + schema + " to incremental vacuum does not fit into " + std::to_string(remaining.count()) + " ms.", tools::LogLevel::DEBUG);
+                            return MaintenanceStatus::TimedOut;
+                        }
+
+                        m_logger.log("Database: Converting " + schema + " to incremental vacuum, " + std::to_string(freePages) + " pages are free.", tools::LogLevel::INFO);
+                        MaintenanceStatus status = runMaintenanceStatement("PRAGMA " + schema + ".auto_vacuum = INCREMENTAL;", budget);
+                        if( status == MaintenanceStatus::Done )
+                        {
+                            status = runMaintenanceStatement("VACUUM " + schema + ";", budget);
+                        }
+                        if( status != MaintenanceStatus::Done )
+                        {
+                            return status;
+                        }
+                    }
+                    return MaintenanceStatus::Done;
+                }, VACUUM_CONVERSION_BUDGET });
+
+            tasks.push_back({ "fts merge", std::chrono::duration_cast<std::chrono::seconds>(DAY), [this, merged, writableSchemas](const MaintenanceBudget& budget)
+                {
+                    if( merged->cursor == 0 )
+                    {
+                        merged->tables.clear();
+                        for( const auto& schema : writableSchemas )
+                        {
+                            runMaintenanceStatement("SELECT name FROM " + schema + ".sqlite_master WHERE type = 'table' AND sql LIKE 'CREATE VIRTUAL TABLE%USING fts5%';", budget, [&](sqlite3_stmt* stmt)
+                                {
+                                    merged->tables.emplace_back(schema, reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+                                });
+                        }
+                    }
+                    return stepThroughTables(*merged, budget, [this, &budget](const std::string& schema, const std::string& table)
+                        {
+                            const std::string sql = "INSERT INTO " + schema + "." + quoteIdentifier(table) + "(" + quoteIdentifier(table) + ", rank) VALUES('merge', " + std::to_string(FTS_MERGE_PAGES) + ");";
+                            while( true )
+                            {
+                                // A merge which changes fewer than two rows found nothing left to merge
+                                const int changes = sqlite3_total_changes(db);
+                                const MaintenanceStatus status = runMaintenanceStatement(sql, budget);
+                                if( status != MaintenanceStatus::Done || sqlite3_total_changes(db) - changes < 2 )
+                                {
+                                    return status;
+                                }
+                                if( budget.exhausted() )
+                                {
+                                    return MaintenanceStatus::Pending;
+                                }
+                            }
+                        });
+                } });
+
+            tasks.push_back({ "integrity check", std::chrono::duration_cast<std::chrono::seconds>(DAY * 7), [this, checked](const MaintenanceBudget& budget)
+                {
+                    return stepThroughTables(*checked, budget, [this, &budget](const std::string& schema, const std::string& table)
+                        {
+                            std::string problems;
+                            MaintenanceStatus status = runMaintenanceStatement("PRAGMA " + schema + ".integrity_check(" + table + ");", budget, [&problems](sqlite3_stmt* stmt)
+                                {
+                                    const std::string message = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                                    if( message != "ok" )
+                                    {
+                                        problems += (problems.empty() ? "" : "; ") + message;
+                                    }
+                                });
+                            if( status == MaintenanceStatus::Done && !problems.empty() )
+                            {
+                                m_logger.log("Database: Integrity check of " + schema + "." + table + " failed: " + problems, tools::LogLevel::PROBLEM);
+                                status = MaintenanceStatus::Failed;
+                            }
+                            return status;
+                        });
+                }, INTEGRITY_CHECK_BUDGET });
+            return tasks;
+        }
+
+        std::unordered_map<std::string, int64_t> ApplicationDatabase::loadMaintenanceRuns() const
+        {
+            std::unordered_map<std::string, int64_t> runs;
+            const char* sql = "SELECT key, value FROM main.settings WHERE key LIKE 'maintenance.%';";
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
+            {
+                const std::size_t prefixLength = std::string(MAINTENANCE_KEY_PREFIX).size();
+                while( sqlite3_step(stmt) == SQLITE_ROW )
+                {
+                    const std::string key = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+                    runs[key.substr(prefixLength)] = sqlite3_column_int64(stmt, 1);
+                }
+                sqlite3_finalize(stmt);
+            }
+            return runs;
+        }
+
+        void ApplicationDatabase::saveMaintenanceRun(const std::string& task, int64_t time)
+        {
+            const char* sql = "REPLACE INTO main.settings (key, value) VALUES (?, ?);";
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(db, sql, -1, &stmt, 0) == SQLITE_OK )
+            {
+                const std::string key = MAINTENANCE_KEY_PREFIX + task;
+                const std::string value = std::to_string(time);
+                sqlite3_bind_text(stmt, 1, key.c_str(), -1, SQLITE_STATIC);
+                sqlite3_bind_text(stmt, 2, value.c_str(), -1, SQLITE_STATIC);
+                if( sqlite3_step(stmt) != SQLITE_DONE )
+                {
+                    m_logger.log("Database: SQL error while saving maintenance run of " + task + ": " + std::string(sqlite3_errmsg(db)), tools::LogLevel::PROBLEM);
+                }
+                sqlite3_finalize(stmt);
+            }
+        }
+
+        MaintenanceStatus ApplicationDatabase::runMaintenanceStatement(const std::string& sql, const MaintenanceBudget& budget, const std::function<void(sqlite3_stmt*)>& row)
+        {
+            sqlite3_progress_handler(db, MAINTENANCE_PROGRESS_OPCODES, [](void* context) -> int
+                {
+                    return static_cast<const MaintenanceBudget*>(context)->exhausted() ? 1 : 0;
+                }, const_cast<MaintenanceBudget*>(&budget));
+
+            sqlite3_stmt* stmt = nullptr;
+            int result = sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, 0);
+            if( result == SQLITE_OK )
+            {
+                while( (result = sqlite3_step(stmt)) == SQLITE_ROW )
+                {
+                    if( row )
+                    {
+                        row(stmt);
+                    }
+                }
+            }
+            const std::string error = sqlite3_errmsg(db);
+            sqlite3_finalize(stmt);
+            sqlite3_progress_handler(db, 0, nullptr, nullptr);
+
+            if( result == SQLITE_DONE )
+            {
+                return MaintenanceStatus::Done;
+            }
+            if( result == SQLITE_INTERRUPT && budget.interrupted && budget.interrupted->load(std::memory_order_relaxed) )
+            {
+                return MaintenanceStatus::Interrupted;
+            }
+            if( result == SQLITE_INTERRUPT )
+            {
+                // Repeating the statement with the same budget would overrun the deadline again, the scheduler extends it
+                m_logger.log("Database: Maintenance statement (" + sql + ") did not finish within its step.", tools::LogLevel::DEBUG);
+                return MaintenanceStatus::TimedOut;
+            }
+            m_logger.log("Database: SQL error during maintenance (" + sql + "): " + error, tools::LogLevel::PROBLEM);
+            return MaintenanceStatus::Failed;
+        }
+
+        long long ApplicationDatabase::pragmaValue(const std::string& schema, const std::string& pragma) const
+        {
+            const std::string sql = "PRAGMA " + schema + "." + pragma + ";";
+            sqlite3_stmt* stmt;
+            long long value = -1;
+            if( sqlite3_prepare_v2(db, sql.c_str(), -1, &stmt, 0) == SQLITE_OK )
+            {
+                if( sqlite3_step(stmt) == SQLITE_ROW )
+                {
+                    value = sqlite3_column_int64(stmt, 0);
+                }
+                sqlite3_finalize(stmt);
+            }
+            return value;
+        }
     }
 }
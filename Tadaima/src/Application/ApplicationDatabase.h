@@ -5,31 +5,60 @@
 
 #pragma once
 
-#include "Tools/Database.h"
-#include "Lessons/Lesson.h"
+#include "tools/Database.h"
+#include "lessons/Lesson.h"
+#include "QueryProfiler.h"
+#include "MaintenanceScheduler.h"
+#include <unordered_map>
 #include <vector>
 #include <string>
 
 struct sqlite3;
+struct sqlite3_stmt;
 namespace tools { class Logger; }
 
 namespace tadaima
 {
     namespace application
     {
+        /**
+         * @brief Locations of the databases opened by ApplicationDatabase.
+         *
+         * A profile studies exactly one deck at a time. Sharing means many profiles attach the same deck file, not one
+         * profile attaching several decks: the statements rely on unqualified table names resolving to the single
+         * "content" schema, and word IDs are only unique within one deck.
+         */
+        struct DatabaseFiles
+        {
+            static constexpr const char* DEFAULT_DECK_PATH = "lessons.db"; /**< Deck used when none is given. */
+            static constexpr const char* DEFAULT_PROGRESS_PATH = "progress.db"; /**< Progress database used when none is given. */
+
+            std::string deckPath = DEFAULT_DECK_PATH; /**< Content database holding lessons, words and tags. */
+            std::string progressPath = DEFAULT_PROGRESS_PATH; /**< Writable database holding the settings, reviews and memory states of one profile. */
+            bool readOnlyDeck = false; /**< Opens the deck immutable, so it can be shared but not edited. */
+        };
+
         /**
          * @brief The ApplicationDatabase class provides functionality to interact with a SQLite database
          * for managing lessons and words.
+         *
+         * Content and progress are kept in separate files joined on one connection: the progress database of the
+         * profile is the main schema and the deck is attached as the "content" schema and memory mapped. Statements
+         * use unqualified table names, which SQLite resolves in either file, so several profiles can study the same
+         * deck without copying it. A read-only deck is opened immutable, which skips locking and change detection.
          */
         class ApplicationDatabase : public Database
         {
         public:
+            static constexpr const char* CONTENT_SCHEMA = "content"; /**< Schema name of the attached deck. */
+            static constexpr long long DECK_MMAP_SIZE = 256ll * 1024 * 1024; /**< Bytes of the deck mapped into memory. */
+
             /**
              * @brief Constructs an ApplicationDatabase object.
-             * @param dbPath The file path to the SQLite database.
+             * @param files The deck and progress databases to open.
              * @param logger Reference to a Logger instance for logging.
              */
-            ApplicationDatabase(const std::string& dbPath, tools::Logger& logger);
+            ApplicationDatabase(const DatabaseFiles& files, tools::Logger& logger);
 
             /**
              * @brief Destroys the ApplicationDatabase object.
@@ -51,11 +80,11 @@ namespace tadaima
             int addLesson(const std::string& mainName, const std::string& subName) override;
 
             /**
-             * @brief Edits an existing lesson in the database.
+             * @brief Edits an existing lesson in the database, or stores it as a new lesson if it does not exist.
              * @param lesson The lesson to edit.
-             * @return True if the lesson was successfully edited, false otherwise.
+             * @return The ID of the stored lesson, or -1 on failure.
              */
-            bool editLesson(const Lesson& lesson) override;
+            int editLesson(const Lesson& lesson) override;
 
             /**
              * @brief Adds a word to a lesson in the database.
@@ -77,8 +106,9 @@ namespace tadaima
              * @param lessonId The ID of the lesson to update.
              * @param newMainName The new main name of the lesson.
              * @param newSubName The new sub name of the lesson.
+             * @return True if the lesson was updated, false otherwise.
              */
-            void updateLesson(int lessonId, const std::string& newMainName, const std::string& newSubName) override;
+            bool updateLesson(int lessonId, const std::string& newMainName, const std::string& newSubName) override;
 
             /**
              * @brief Updates an existing word in the database.
@@ -88,10 +118,18 @@ namespace tadaima
             void updateWord(int wordId, const Word& updatedWord) override;
 
             /**
-             * @brief Deletes a lesson from the database.
+             * @brief Updates the frequency ranks of many words in a single transaction.
+             * @param ranks Pairs of word ID and frequency rank.
+             * @return True if the ranks were stored in one transaction, false if it could not be started or committed.
+             */
+            bool updateFrequencyRanks(const std::vector<std::pair<int, int>>& ranks) override;
+
+            /**
+             * @brief Deletes a lesson from the database together with its words and everything recorded for them.
              * @param lessonId The ID of the lesson to delete.
+             * @return True if the lesson was deleted, false otherwise.
              */
-            void deleteLesson(int lessonId) override;
+            bool deleteLesson(int lessonId) override;
 
             /**
              * @brief Deletes a word from the database.
@@ -99,6 +137,41 @@ namespace tadaima
              */
             void deleteWord(int wordId) override;
 
+            /**
+             * @brief Moves words to another lesson with one UPDATE.
+             * @param wordIds IDs of the words to move.
+             * @param lessonId The ID of the target lesson.
+             * @return True if the words were moved, false otherwise.
+             */
+            bool moveWords(const std::vector<int>& wordIds, int lessonId) override;
+
+            /**
+             * @brief Copies words and their tags to another lesson with one INSERT per table.
+             *
+             * The copies receive consecutive IDs in the order of the original IDs. The IDs are assigned in a temporary
+             * table before the words are copied, which is how their tags are matched. Repeated and unknown IDs are skipped.
+             * @param wordIds IDs of the words to copy.
+             * @param lessonId The ID of the target lesson.
+             * @return True if the words were copied, false otherwise.
+             */
+            bool copyWords(const std::vector<int>& wordIds, int lessonId) override;
+
+            /**
+             * @brief Deletes words with their tags, reviews, memory states and confusions, with one DELETE per table.
+             * @param wordIds IDs of the words to delete.
+             * @return True if the words were deleted, false otherwise.
+             */
+            bool deleteWords(const std::vector<int>& wordIds) override;
+
+            /**
+             * @brief Removes and adds tags of many words with one DELETE and one INSERT.
+             * @param wordIds IDs of the words to retag.
+             * @param addedTags Tags added to every word which does not have them yet.
+             * @param removedTags Tags removed from every word.
+             * @return True if the tags were changed, false otherwise.
+             */
+            bool retagWords(const std::vector<int>& wordIds, const std::vector<std::string>& addedTags, const std::vector<std::string>& removedTags) override;
+
             /**
              * @brief Retrieves the names of all lessons from the database.
              * @return A vector containing the names of all lessons.
@@ -112,12 +185,53 @@ namespace tadaima
              */
             std::vector<Word> getWordsInLesson(int lessonId) const override;
 
+            /**
+             * @brief Retrieves the words with the given IDs.
+             * @param wordIds The IDs of the words, unknown IDs are skipped.
+             * @return A vector containing the found words in no particular order.
+             */
+            std::vector<Word> getWords(const std::vector<int>& wordIds) const override;
+
             /**
              * @brief Retrieves all lessons from the database.
              * @return A vector containing all lessons.
              */
             std::vector<Lesson> getAllLessons() const override;
 
+            /**
+             * @brief Retrieves the lessons with the given IDs.
+             * @param lessonIds The IDs of the lessons, unknown IDs are skipped.
+             * @return A vector containing the found lessons with their words, ordered by ID.
+             */
+            std::vector<Lesson> getLessons(const std::vector<int>& lessonIds) const override;
+
+            /**
+             * @brief Retrieves the IDs of the lessons holding the given words.
+             * @param wordIds The IDs of the words, unknown IDs are skipped.
+             * @return A vector containing each lesson ID once.
+             */
+            std::vector<int> getLessonIdsOfWords(const std::vector<int>& wordIds) const override;
+
+            /**
+             * @brief Visits words one at a time without loading the lessons into memory.
+             * @param lessonIds IDs of the lessons to visit, or empty to visit every lesson.
+             * @param visitor Called for every word with its lesson, ordered by lesson and word ID.
+             */
+            void forEachWord(const std::vector<int>& lessonIds, const std::function<void(const Lesson&, const Word&)>& visitor) const override;
+
+            /**
+             * @brief Finds the words spelled like a text, closest and then in gojūon order first.
+             *
+             * Kana is compared after normalization, so the script of the text does not matter, and text in romaji is compared
+             * with the transliterated kana of the words. Like a dictionary lookup, only words starting with the same kana are
+             * candidates, so they are read through the kana index instead of comparing every word. Tags are not loaded.
+             * @param text The kana or romaji to look for.
+             * @param maxDistance The largest number of differing characters.
+             * @param limit The largest number of words returned.
+             * @return The matching words.
+             */
+            std::vector<Word> findSimilarWords(const std::string& text, int maxDistance, int limit) const;
+
             /**
              * @brief Saves the application settings to the database.
              * @param settings The application settings to save.
@@ -130,9 +244,217 @@ namespace tadaima
              */
             ApplicationSettings loadSettings();
 
+            /**
+             * @brief Stores a review of a word in the database.
+             * @param record The review to store.
+             * @return True if the review was stored, false otherwise.
+             */
+            bool addReview(const review::ReviewRecord& record) override;
+
+            /**
+             * @brief Retrieves the review history of the words in existing lessons, ordered by word and time.
+             * @return A vector containing all stored reviews.
+             */
+            std::vector<review::ReviewRecord> getReviews() const override;
+
+            /**
+             * @brief Counts a wrong answer picked for a word, keeping only the most frequent confusions of the word.
+             * @param confusion The asked word, the word whose answer was picked and the time of the answer.
+             * @return True if the confusion was stored, false otherwise.
+             */
+            bool addConfusion(const review::Confusion& confusion) override;
+
+            /**
+             * @brief Retrieves the stored confusions, most frequent first.
+             * @return A vector containing all stored confusions.
+             */
+            std::vector<review::Confusion> getConfusions() const override;
+
+            /**
+             * @brief Saves the memory state of a word.
+             * @param state The memory state to save.
+             * @return True if the state was saved, false if the transaction could not be started or committed.
+             */
+            bool saveMemoryState(const review::MemoryState& state) override;
+
+            /**
+             * @brief Saves the memory states of many words in a single transaction.
+             * @param states The memory states to save.
+             * @return True if the states were saved, false if the transaction could not be started or committed.
+             */
+            bool saveMemoryStates(const std::vector<review::MemoryState>& states) override;
+
+            /**
+             * @brief Retrieves the memory state of a word.
+             * @param wordId The ID of the word.
+             * @return The memory state of the word, or an empty state if the word was never reviewed.
+             */
+            review::MemoryState getMemoryState(int wordId) const override;
+
+            /**
+             * @brief Retrieves the memory states of all words in existing lessons which were reviewed at least once.
+             * @return A vector containing the memory states.
+             */
+            std::vector<review::MemoryState> getMemoryStates() const override;
+
+            /**
+             * @brief Opens a savepoint, which starts a transaction unless one is already open.
+             * @return True if the savepoint was opened, false otherwise.
+             */
+            bool beginTransaction() override;
+
+            /**
+             * @brief Releases the innermost savepoint, committing the transaction if it is the outermost one.
+             * @return True if the savepoint was released, false otherwise.
+             */
+            bool commitTransaction() override;
+
+            /**
+             * @brief Rolls back to the innermost savepoint and releases it.
+             */
+            void rollbackTransaction() override;
+
+            /**
+             * @brief Removes words which repeat another word of the same lesson.
+             *
+             * Words with equal kana, kanji, romaji and translation within a lesson are merged into the one with the
+             * lowest ID: their reviews and tags move to it and their memory states are dropped, so the states of the
+             * kept words should be rebuilt from the reviews afterwards. Kana is compared in its normalized form, so
+             * hiragana and katakana spellings of a word are duplicates too.
+             * @return The number of removed words, or -1 if the database could not be updated.
+             */
+            int removeDuplicateWords();
+
+            /**
+             * @brief Copies one of the databases to a file using the SQLite online backup.
+             * @param path Path of the backup, an existing file is replaced.
+             * @param schema "main" for the progress database or CONTENT_SCHEMA for the deck.
+             * @return True if the backup is complete, false otherwise.
+             */
+            bool backup(const std::string& path, const std::string& schema) const;
+
+            /**
+             * @brief Creates the maintenance tasks of both databases for the MaintenanceScheduler.
+             *
+             * The tasks refresh the planner statistics with PRAGMA optimize and a bounded ANALYZE per table, return free
+             * pages with incremental vacuum, merge the segments of FTS5 tables and check every table for corruption.
+             * A running statement is aborted once its step passes the deadline or the user becomes active; a statement
+             * which does not fit into a step is skipped until the task is due again. A deck opened read-only is only
+             * checked. A database created without incremental auto vacuum is converted by one full VACUUM once a fifth of
+             * it is free, which a separate task only starts if the copy is expected to fit into the step.
+             * @return The tasks, which must not outlive the database.
+             */
+            std::vector<MaintenanceTask> maintenanceTasks();
+
+            /**
+             * @brief Loads the times the maintenance tasks last completed.
+             * @return Seconds since the epoch by task name.
+             */
+            std::unordered_map<std::string, int64_t> loadMaintenanceRuns() const;
+
+            /**
+             * @brief Stores the time a maintenance task completed.
+             * @param task Name of the task.
+             * @param time Seconds since the epoch.
+             */
+            void saveMaintenanceRun(const std::string& task, int64_t time);
+
         private:
+
+            /**
+             * @brief Attaches the deck to the connection.
+             * @param files The deck to attach.
+             * @return True if the deck is attached, false otherwise.
+             */
+            bool attachDeck(const DatabaseFiles& files);
+
+            /**
+             * @brief Moves progress tables of databases written before the split from the deck to the progress database.
+             *
+             * Rows are only copied from a read-only deck, and only into an empty table, so a shared deck seeds new
+             * profiles once. A writable deck loses the tables after the copy.
+             * @return True if nothing had to be moved or the move succeeded, false otherwise.
+             */
+            bool migrateProgress();
+
+            /**
+             * @brief Checks if a table has a column.
+             * @param schema The schema of the table.
+             * @param table The name of the table.
+             * @param column The name of the column.
+             * @return True if the column exists, false otherwise.
+             */
+            bool hasColumn(const std::string& schema, const std::string& table, const std::string& column) const;
+
+            /**
+             * @brief Adds a column to an existing table unless it is already there.
+             * @param schema The schema of the table.
+             * @param table The name of the table.
+             * @param column The name of the column.
+             * @param definition The type and constraints of the column.
+             * @return True if the column exists or was added, false otherwise.
+             */
+            bool addColumnIfMissing(const std::string& schema, const std::string& table, const std::string& column, const std::string& definition);
+
+            /**
+             * @brief Fills in the word columns a read-only deck written by an older release lacks.
+             *
+             * The deck cannot be altered, so a temporary view named like the table shadows it and returns the column
+             * defaults instead. Cloze spans stay unlocated and are searched when a quiz loads the words.
+             * @return True if the deck has every column or the view was created, false otherwise.
+             */
+            bool defaultMissingColumns();
+
+            /**
+             * @brief Refreshes the normalized kana of words written without it and indexes the words by it.
+             * @return True if every key is current and the index exists, false otherwise.
+             */
+            bool indexKanaKeys();
+
+            /**
+             * @brief Locates the words stored before cloze spans were kept in their example sentences.
+             * @return True if every word has a span, false otherwise.
+             */
+            bool locateClozes();
+
+            /**
+             * @brief Reads the words a prepared statement returns, together with their tags.
+             * @param stmt The statement, selecting id, kana, translation, romaji, example_sentence, frequency_rank, kanji, cloze_start and cloze_length.
+             * @return The words in the order of the rows.
+             */
+            std::vector<Word> readWords(sqlite3_stmt* stmt) const;
+
+            /**
+             * @brief Runs one statement of a bulk word operation.
+             * @param sql The statement, whose first parameter receives the word IDs to be read with json_each.
+             * @param wordIds The word IDs as a JSON array.
+             * @param bind Binds the remaining parameters, may be empty.
+             * @return The number of changed rows, or -1 if the statement failed.
+             */
+            int executeForWords(const char* sql, const std::string& wordIds, const std::function<void(sqlite3_stmt*)>& bind);
+
+            /**
+             * @brief Runs one maintenance statement, which user activity and the deadline abort.
+             * @param sql The statement.
+             * @param budget The budget whose deadline and interrupt flag abort the statement.
+             * @param row Called for every row of the result, may be empty.
+             * @return Done if the statement completed, Interrupted if user activity aborted it, Failed if it failed or
+             *         ran past the deadline.
+             */
+            MaintenanceStatus runMaintenanceStatement(const std::string& sql, const MaintenanceBudget& budget, const std::function<void(sqlite3_stmt*)>& row = {});
+
+            /**
+             * @brief Reads a single integer pragma.
+             * @param schema The schema.
+             * @param pragma The name of the pragma.
+             * @return The value, or -1 if it could not be read.
+             */
+            long long pragmaValue(const std::string& schema, const std::string& pragma) const;
+
             sqlite3* db; /**< Pointer to the SQLite database. */
+            bool m_readOnlyDeck; /**< Whether the deck was opened immutable. */
             tools::Logger& m_logger; /**< Reference to the Logger instance for logging. */
+            QueryProfiler m_profiler; /**< Times the statements of the connection and logs slow ones. */
         };
     }
 }
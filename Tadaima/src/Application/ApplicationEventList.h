@@ -11,7 +11,15 @@ namespace tadaima
             OnLessonUpdate,
             OnLessonDelete,
             OnLessonEdited,
-            OnSettingsChanged
+            OnSettingsChanged,
+            OnWordReviewed,
+            OnForecastRequested,
+            OnMemoryModelFitRequested,
+            OnMemoryModelFitted,
+            OnFrequencyListImported,
+            OnDeckImported,
+            OnDeckExportRequested,
+            OnWordsChanged
         };
     }
 }
\ No newline at end of file
@@ -7,6 +7,9 @@
 
 #include <format>
 #include <string>
+#include "review/MemoryModel.h"
+#include "review/LeechDetector.h"
+#include "GroupCommit.h"
 
 namespace tadaima
 {
@@ -23,16 +26,27 @@ namespace tadaima
             static constexpr const char* DEFAULT_SCRIPTED_QUIZ_PATH = "scripts/Quizzes";
             static constexpr const char* DEFAULT_INPUT_WORD = "BaseWord";
             static constexpr const char* DEFAULT_TRANSLATED_WORD = "Romaji";
+            static constexpr const char* DEFAULT_FREQUENCY_LIST_PATH = "";
 
             /// Application settings
             std::string userName = DEFAULT_USER_NAME;           /**< The username for the application. */
             std::string dictionaryPath = DEFAULT_DICTIONARY_PATH; /**< The path to the dictionary file. */
             std::string quizzesPaths = DEFAULT_SCRIPTED_QUIZ_PATH; /**< The path to the quizzes directory. */
             bool showLogs = false; /**< Flag to determine if logs should be shown. */
+            std::string frequencyListPath = DEFAULT_FREQUENCY_LIST_PATH; /**< The path to the last imported word frequency list. */
 
             /// Quiz settings
             std::string inputWord = DEFAULT_INPUT_WORD;         /**< The type of input word for the quiz. */
             std::string translatedWord = DEFAULT_TRANSLATED_WORD; /**< The type of translated word for the quiz. */
+            bool frequencyOrder = false; /**< Flag to ask the most common words first instead of shuffling. */
+            bool adaptiveOrder = false; /**< Flag to ask the words answered wrong more often instead of shuffling. */
+
+            /// Review settings
+            review::MemoryModelParameters memoryModel; /**< Parameters of the memory model, fitted to the review history. */
+            review::LeechOptions leech; /**< Thresholds of the leech detection. */
+
+            /// Database settings
+            GroupCommitOptions groupCommit; /**< Window and size limit of the transactions shared by lesson edits. */
 
             /**
              * @brief Converts the application settings to a string representation.
@@ -46,8 +60,16 @@ namespace tadaima
                 log += std::format("  -> Dictionary Path: {}\n", dictionaryPath);
                 log += std::format("  -> Quizzes Path: {}\n", quizzesPaths);
                 log += std::format("  -> Show Logs: {}\n", showLogs ? "true" : "false");
+                log += std::format("  -> Frequency List Path: {}\n", frequencyListPath);
                 log += std::format("  -> Input Word: {}\n", inputWord);
                 log += std::format("  -> Translated Word: {}\n", translatedWord);
+                log += std::format("  -> Frequency Order: {}\n", frequencyOrder ? "true" : "false");
+                log += std::format("  -> Adaptive Order: {}\n", adaptiveOrder ? "true" : "false");
+                log += std::format("  -> Memory Model: S0={:.3f}, growth={:.3f}, decay={:.3f}, gain={:.3f}, lapse={:.3f}, retention={:.2f}\n",
+                    memoryModel.initialStability, memoryModel.growthRate, memoryModel.stabilityDecay,
+                    memoryModel.retrievabilityGain, memoryModel.lapseFactor, memoryModel.desiredRetention);
+                log += std::format("  -> Leech: threshold={}, repeat={}\n", leech.lapseThreshold, leech.repeatInterval);
+                log += std::format("  -> Group Commit: window={} ms, max={}\n", groupCommit.windowMs, groupCommit.maxOperations);
 
                 return log;
             }
@@ -0,0 +1,144 @@
+#include "GroupCommit.h"
+#include "tools/Database.h"
+#include <algorithm>
+#include <exception>
+#include <mutex>
+
+namespace tadaima
+{
+    namespace application
+    {
+        GroupCommit::GroupCommit(Database& database, const GroupCommitOptions& options)
+            : m_database(database), m_options(options)
+        {
+        }
+
+        void GroupCommit::setOptions(const GroupCommitOptions& options)
+        {
+            std::lock_guard<tools::ProfiledMutex> lock(m_mutex);
+            m_options = options;
+        }
+
+        GroupCommitOptions GroupCommit::getOptions() const
+        {
+            std::lock_guard<tools::ProfiledMutex> lock(m_mutex);
+            return m_options;
+        }
+
+        bool GroupCommit::enqueue(std::string name, Mutation mutation, Clock::time_point now)
+        {
+            std::lock_guard<tools::ProfiledMutex> lock(m_mutex);
+            m_queue.push_back({ std::move(name), std::move(mutation), now });
+            return m_queue.size() >= groupLimit();
+        }
+
+        std::optional<GroupCommit::Clock::duration> GroupCommit::timeUntilDue(Clock::time_point now) const
+        {
+            std::lock_guard<tools::ProfiledMutex> lock(m_mutex);
+            if( m_queue.empty() )
+            {
+                return std::nullopt;
+            }
+            if( m_queue.size() >= groupLimit() )
+            {
+                return Clock::duration::zero();
+            }
+
+            const Clock::time_point due = m_queue.front().arrival + std::chrono::milliseconds(std::max(0, m_options.windowMs));
+            return std::max(Clock::duration::zero(), due - now);
+        }
+
+        std::vector<GroupCommitResult> GroupCommit::commitDue(Clock::time_point now)
+        {
+            const std::optional<Clock::duration> remaining = timeUntilDue(now);
+            if( !remaining || *remaining > Clock::duration::zero() )
+            {
+                return {};
+            }
+
+            std::vector<Pending> group = take(groupLimit());
+            return apply(group);
+        }
+
+        std::vector<GroupCommitResult> GroupCommit::commitAll()
+        {
+            std::vector<Pending> group = take(pendingCount());
+            return apply(group);
+        }
+
+        std::size_t GroupCommit::pendingCount() const
+        {
+            std::lock_guard<tools::ProfiledMutex> lock(m_mutex);
+            return m_queue.size();
+        }
+
+        std::vector<GroupCommit::Pending> GroupCommit::take(std::size_t count)
+        {
+            std::lock_guard<tools::ProfiledMutex> lock(m_mutex);
+            const std::size_t taken = std::min(count, m_queue.size());
+            std::vector<Pending> group(std::make_move_iterator(m_queue.begin()), std::make_move_iterator(m_queue.begin() + taken));
+            m_queue.erase(m_queue.begin(), m_queue.begin() + taken);
+            return group;
+        }
+
+        std::vector<GroupCommitResult> GroupCommit::apply(std::vector<Pending>& group)
+        {
+            std::vector<GroupCommitResult> results;
+            if( group.empty() )
+            {
+                return results;
+            }
+
+            results.reserve(group.size());
+            if( !m_database.beginTransaction() )
+            {
+                for( const auto& pending : group )
+                {
+                    results.push_back({ pending.name, false });
+                }
+                return results;
+            }
+
+            for( auto& pending : group )
+            {
+                bool success = m_database.beginTransaction();
+                if( success )
+                {
+                    try
+                    {
+                        success = pending.mutation();
+                    }
+                    catch( const std::exception& )
+                    {
+                        success = false;
+                    }
+
+                    if( success )
+                    {
+                        success = m_database.commitTransaction();
+                    }
+                    if( !success )
+                    {
+                        m_database.rollbackTransaction();
+                    }
+                }
+                results.push_back({ std::move(pending.name), success });
+            }
+
+            if( !m_database.commitTransaction() )
+            {
+                m_database.rollbackTransaction();
+                for( auto& result : results )
+                {
+                    result.success = false;
+                }
+            }
+            return results;
+        }
+
+        std::size_t GroupCommit::groupLimit() const
+        {
+            return static_cast<std::size_t>(std::max(1, m_options.maxOperations));
+        }
+    }
+}
@@ -0,0 +1,149 @@
+/**
+ * @file GroupCommit.h
+ * @brief Declares the GroupCommit class which collects database mutations into shared transactions.
+ */
+
+#pragma once
+
+#include "Tools/ProfiledMutex.h"
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace tadaima
+{
+    class Database;
+
+    namespace application
+    {
+        /**
+         * @brief Tuning of the group commit.
+         */
+        struct GroupCommitOptions
+        {
+            static constexpr int DEFAULT_WINDOW_MS = 50; /**< Default time a mutation waits for others. */
+            static constexpr int DEFAULT_MAX_OPERATIONS = 256; /**< Default number of mutations per transaction. */
+
+            int windowMs = DEFAULT_WINDOW_MS; /**< Milliseconds a mutation waits for others to share its transaction, 0 commits at once. */
+            int maxOperations = DEFAULT_MAX_OPERATIONS; /**< Number of mutations which are committed without waiting for the window. */
+        };
+
+        /**
+         * @brief Outcome of one mutation of a group.
+         */
+        struct GroupCommitResult
+        {
+            std::string name;   /**< Description of the mutation. */
+            bool success;       /**< True if the mutation was committed, false if it was rolled back. */
+        };
+
+        /**
+         * @brief The GroupCommit class coalesces mutations arriving in quick succession into one transaction.
+         *
+         * Mutations are queued from any thread and applied in order by the thread calling commitDue(), once the oldest
+         * one has waited for the window or the queue holds the maximum number of operations. The group shares one
+         * transaction, so bursts of small edits cost one journal sync instead of one each. Every mutation still runs in
+         * its own nested transaction: a failing one is rolled back alone and reported, the others are kept.
+         */
+        class GroupCommit
+        {
+        public:
+            using Clock = std::chrono::steady_clock;
+            using Mutation = std::function<bool()>; /**< Applies a change and tells whether it succeeded. */
+
+            /**
+             * @brief Constructs an empty group commit.
+             * @param database Database the transactions are opened on.
+             * @param options Window and size limit of a group.
+             */
+            explicit GroupCommit(Database& database, const GroupCommitOptions& options = {});
+
+            /**
+             * @brief Changes the window and size limit, applying to mutations already queued as well.
+             * @param options The new options.
+             */
+            void setOptions(const GroupCommitOptions& options);
+
+            /**
+             * @brief Gets the window and size limit.
+             * @return The options.
+             */
+            GroupCommitOptions getOptions() const;
+
+            /**
+             * @brief Queues a mutation.
+             * @param name Description of the mutation for the results.
+             * @param mutation The mutation. It runs on the thread which commits the group.
+             * @param now Time the mutation arrived.
+             * @return True if the queue reached the size limit and should be committed right away.
+             */
+            bool enqueue(std::string name, Mutation mutation, Clock::time_point now = Clock::now());
+
+            /**
+             * @brief Gets the time until the queued mutations are due.
+             * @param now The current time.
+             * @return Zero if a group is due, the remaining window otherwise, or nothing if the queue is empty.
+             */
+            std::optional<Clock::duration> timeUntilDue(Clock::time_point now = Clock::now()) const;
+
+            /**
+             * @brief Applies one group if it is due.
+             * @param now The current time.
+             * @return Results of the applied mutations in queue order, empty if no group was due.
+             */
+            std::vector<GroupCommitResult> commitDue(Clock::time_point now = Clock::now());
+
+            /**
+             * @brief Applies all queued mutations without waiting for the window.
+             * @return Results of the applied mutations in queue order.
+             */
+            std::vector<GroupCommitResult> commitAll();
+
+            /**
+             * @brief Gets the number of queued mutations.
+             * @return The number of mutations.
+             */
+            std::size_t pendingCount() const;
+
+        private:
+            /**
+             * @brief A queued mutation.
+             */
+            struct Pending
+            {
+                std::string name;           /**< Description of the mutation. */
+                Mutation mutation;          /**< The mutation. */
+                Clock::time_point arrival;  /**< Time the mutation was queued. */
+            };
+
+            /**
+             * @brief Takes mutations from the front of the queue.
+             * @param count Maximum number of mutations.
+             * @return The mutations in queue order.
+             */
+            std::vector<Pending> take(std::size_t count);
+
+            /**
+             * @brief Applies mutations in one transaction, each in a nested one.
+             * @param group The mutations.
+             * @return Results of the mutations.
+             */
+            std::vector<GroupCommitResult> apply(std::vector<Pending>& group);
+
+            /**
+             * @brief Gets the size limit of a group, at least one.
+             * @return The number of mutations.
+             */
+            std::size_t groupLimit() const;
+
+            Database& m_database; /**< Database the transactions are opened on. */
+            GroupCommitOptions m_options; /**< Window and size limit of a group. */
+            std::deque<Pending> m_queue; /**< Mutations waiting for their group. */
+            mutable tools::ProfiledMutex m_mutex{ "GroupCommit" }; /**< Guards the options and the queue. */
+        };
+    }
+}
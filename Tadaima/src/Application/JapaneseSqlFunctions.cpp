@@ -0,0 +1,93 @@
+#include "JapaneseSqlFunctions.h"
+#include <Libraries/SQLite3/sqlite3.h>
+#include "tools/JapaneseText.h"
+#include <string>
+#include <string_view>
+
+namespace tadaima
+{
+    namespace application
+    {
+        namespace
+        {
+            std::string_view argumentText(sqlite3_value* value)
+            {
+                return { reinterpret_cast<const char*>(sqlite3_value_text(value)), static_cast<std::size_t>(sqlite3_value_bytes(value)) };
+            }
+
+            bool anyNull(int argc, sqlite3_value** argv)
+            {
+                for( int i = 0; i < argc; ++i )
+                {
+                    if( sqlite3_value_type(argv[i]) == SQLITE_NULL )
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            template<std::string(*Convert)(std::string_view)>
+            void convertText(sqlite3_context* context, int argc, sqlite3_value** argv)
+            {
+                if( anyNull(argc, argv) )
+                {
+                    sqlite3_result_null(context);
+                    return;
+                }
+                const std::string result = Convert(argumentText(argv[0]));
+                sqlite3_result_text(context, result.data(), static_cast<int>(result.size()), SQLITE_TRANSIENT);
+            }
+
+            void editDistanceFunction(sqlite3_context* context, int argc, sqlite3_value** argv)
+            {
+                if( anyNull(argc, argv) )
+                {
+                    sqlite3_result_null(context);
+                    return;
+                }
+                sqlite3_result_int64(context, static_cast<sqlite3_int64>(editDistance(argumentText(argv[0]), argumentText(argv[1]))));
+            }
+
+            int compareKana(void*, int lhsSize, const void* lhs, int rhsSize, const void* rhs)
+            {
+                return normalizeJapanese({ static_cast<const char*>(lhs), static_cast<std::size_t>(lhsSize) })
+                    .compare(normalizeJapanese({ static_cast<const char*>(rhs), static_cast<std::size_t>(rhsSize) }));
+            }
+
+            int compareGojuonOrder(void*, int lhsSize, const void* lhs, int rhsSize, const void* rhs)
+            {
+                return compareGojuon({ static_cast<const char*>(lhs), static_cast<std::size_t>(lhsSize) },
+                    { static_cast<const char*>(rhs), static_cast<std::size_t>(rhsSize) });
+            }
+        }
+
+        bool registerJapaneseSqlFunctions(sqlite3* db)
+        {
+            constexpr int flags = SQLITE_UTF8 | SQLITE_DETERMINISTIC | SQLITE_INNOCUOUS;
+
+            struct Function
+            {
+                const char* name;
+                int arguments;
+                void (*call)(sqlite3_context*, int, sqlite3_value**);
+            };
+
+            const Function functions[] =
+            {
+                { "normalize_japanese", 1, &convertText<normalizeJapanese> },
+                { "to_hiragana", 1, &convertText<toHiragana> },
+                { "to_romaji", 1, &convertText<toRomaji> },
+                { "edit_distance", 2, &editDistanceFunction }
+            };
+
+            bool registered = sqlite3_create_collation(db, KANA_COLLATION, SQLITE_UTF8, nullptr, &compareKana) == SQLITE_OK
+                && sqlite3_create_collation(db, GOJUON_COLLATION, SQLITE_UTF8, nullptr, &compareGojuonOrder) == SQLITE_OK;
+            for( const auto& [name, arguments, call] : functions )
+            {
+                registered = registered && sqlite3_create_function_v2(db, name, arguments, flags, nullptr, call, nullptr, nullptr, nullptr) == SQLITE_OK;
+            }
+            return registered;
+        }
+    }
+}
@@ -0,0 +1,29 @@
+/**
+ * @file JapaneseSqlFunctions.h
+ * @brief Declares the Japanese aware collations and SQL functions of the database connection.
+ */
+
+#pragma once
+
+struct sqlite3;
+
+namespace tadaima
+{
+    namespace application
+    {
+        static constexpr const char* KANA_COLLATION = "KANA"; /**< Collation comparing normalized text, so hiragana, katakana and width variants are equal. */
+        static constexpr const char* GOJUON_COLLATION = "GOJUON"; /**< Collation sorting in gojūon order, hiragana and katakana spellings together. */
+
+        /**
+         * @brief Registers the Japanese collations and functions on a connection.
+         *
+         * Besides the collations, the functions normalize_japanese(text), to_hiragana(text), to_romaji(text) and
+         * edit_distance(text, text) are registered. They are deterministic, so they can be used in indexes on expressions,
+         * and return NULL for NULL arguments. Schemas using them can only be written by connections which registered them.
+         *
+         * @param db The connection.
+         * @return True if everything was registered, false otherwise.
+         */
+        bool registerJapaneseSqlFunctions(sqlite3* db);
+    }
+}
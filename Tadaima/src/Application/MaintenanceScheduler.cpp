@@ -0,0 +1,121 @@
+#include "MaintenanceScheduler.h"
+#include <algorithm>
+#include <exception>
+#include <mutex>
+
+namespace tadaima
+{
+    namespace application
+    {
+        MaintenanceScheduler::MaintenanceScheduler(const MaintenanceOptions& options)
+            : m_options(options), m_lastActivity(Clock::now().time_since_epoch().count())
+        {
+        }
+
+        void MaintenanceScheduler::addTask(MaintenanceTask task, int64_t lastRun)
+        {
+            std::lock_guard<tools::ProfiledMutex> lock(m_mutex);
+            const std::chrono::milliseconds budget = task.stepBudget > std::chrono::milliseconds::zero() ? task.stepBudget : std::chrono::milliseconds(m_options.stepBudgetMs);
+            m_tasks.push_back({ std::move(task), lastRun, budget });
+        }
+
+        void MaintenanceScheduler::noteActivity(Clock::time_point now)
+        {
+            m_lastActivity.store(now.time_since_epoch().count(), std::memory_order_relaxed);
+            m_interrupted.store(true, std::memory_order_relaxed);
+        }
+
+        std::optional<MaintenanceScheduler::Clock::duration> MaintenanceScheduler::timeUntilStep(Clock::time_point now, int64_t wallTime) const
+        {
+            {
+                std::lock_guard<tools::ProfiledMutex> lock(m_mutex);
+                if( !nextTask(wallTime) )
+                {
+                    return std::nullopt;
+                }
+            }
+
+            const Clock::time_point lastActivity{ Clock::duration(m_lastActivity.load(std::memory_order_relaxed)) };
+            const Clock::time_point due = std::max(lastActivity + std::chrono::milliseconds(std::max(0, m_options.idleDelayMs)),
+                m_lastStep + std::chrono::milliseconds(std::max(0, m_options.stepPauseMs)));
+            return std::max(Clock::duration::zero(), due - now);
+        }
+
+        std::optional<MaintenanceStepResult> MaintenanceScheduler::runStep(Clock::time_point now, int64_t wallTime)
+        {
+            const std::optional<Clock::duration> remaining = timeUntilStep(now, wallTime);
+            if( !remaining || *remaining > Clock::duration::zero() )
+            {
+                return std::nullopt;
+            }
+
+            std::size_t index = 0;
+            std::chrono::milliseconds stepBudget{ 0 };
+            {
+                std::lock_guard<tools::ProfiledMutex> lock(m_mutex);
+                index = *nextTask(wallTime);
+                m_current = index;
+                stepBudget = std::max(std::chrono::milliseconds(1), m_tasks[index].budget);
+            }
+            MaintenanceTask::Step& step = m_tasks[index].task.step;
+
+            // Only activity from now on interrupts the step; activity just before it is caught by the idle check above
+            m_interrupted.store(false, std::memory_order_relaxed);
+            const MaintenanceBudget budget{ now + stepBudget, &m_interrupted };
+            MaintenanceStatus status = MaintenanceStatus::Failed;
+            try
+            {
+                status = step(budget);
+            }
+            catch( const std::exception& )
+            {
+                status = MaintenanceStatus::Failed;
+            }
+            m_lastStep = Clock::now();
+
+            std::lock_guard<tools::ProfiledMutex> lock(m_mutex);
+            if( status == MaintenanceStatus::TimedOut )
+            {
+                // A timeout does not complete the task, it is repeated with a longer budget until the longest one did not suffice
+                const std::chrono::milliseconds longest(std::max(1, m_options.maxStepBudgetMs));
+                if( stepBudget >= longest )
+                {
+                    status = MaintenanceStatus::Failed;
+                }
+                else
+                {
+                    m_tasks[index].budget = std::min(longest, stepBudget * 2);
+                }
+            }
+            if( status == MaintenanceStatus::Done || status == MaintenanceStatus::Failed )
+            {
+                m_tasks[index].lastRun = wallTime;
+                m_current.reset();
+            }
+            return MaintenanceStepResult{ m_tasks[index].task.name, status };
+        }
+
+        int64_t MaintenanceScheduler::lastRun(const std::string& name) const
+        {
+            std::lock_guard<tools::ProfiledMutex> lock(m_mutex);
+            auto it = std::find_if(m_tasks.begin(), m_tasks.end(), [&name](const ScheduledTask& scheduled) { return scheduled.task.name == name; });
+            return it != m_tasks.end() ? it->lastRun : 0;
+        }
+
+        std::optional<std::size_t> MaintenanceScheduler::nextTask(int64_t wallTime) const
+        {
+            if( m_current )
+            {
+                return m_current;
+            }
+            for( std::size_t index = 0; index < m_tasks.size(); ++index )
+            {
+                if( wallTime - m_tasks[index].lastRun >= m_tasks[index].task.interval.count() )
+                {
+                    return index;
+                }
+            }
+            return std::nullopt;
+        }
+    }
+}
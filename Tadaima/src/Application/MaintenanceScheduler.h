@@ -0,0 +1,174 @@
+/**
+ * @file MaintenanceScheduler.h
+ * @brief Declares the MaintenanceScheduler class which runs database maintenance in small steps while the user is idle.
+ */
+
+#pragma once
+
+#include "Tools/ProfiledMutex.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace tadaima
+{
+    namespace application
+    {
+        /**
+         * @brief Outcome of one maintenance step.
+         */
+        enum class MaintenanceStatus : uint8_t
+        {
+            Done,           /**< The task is complete until its interval passes again. */
+            Pending,        /**< The step used up its budget, the task continues with the next step. */
+            Interrupted,    /**< The user became active, the step is repeated once the user is idle again. */
+            TimedOut,       /**< A statement did not finish within the budget, the step is repeated with a longer budget. */
+            Failed          /**< The task failed and is not retried before its interval passes. */
+        };
+
+        /**
+         * @brief Limits of a single maintenance step.
+         */
+        struct MaintenanceBudget
+        {
+            std::chrono::steady_clock::time_point deadline; /**< Time the step should return by. */
+            const std::atomic<bool>* interrupted = nullptr; /**< Set when the user becomes active. */
+
+            /**
+             * @brief Checks if the step has to return.
+             * @return True if the deadline passed or the user became active.
+             */
+            bool exhausted() const
+            {
+                return (interrupted && interrupted->load(std::memory_order_relaxed)) || std::chrono::steady_clock::now() >= deadline;
+            }
+        };
+
+        /**
+         * @brief A maintenance job split into bounded steps.
+         */
+        struct MaintenanceTask
+        {
+            using Step = std::function<MaintenanceStatus(const MaintenanceBudget&)>; /**< Does a part of the task and tells how far it got. */
+
+            std::string name;               /**< Name of the task, used to persist its last run. */
+            std::chrono::seconds interval;  /**< Time between two complete runs. */
+            Step step;                      /**< Does the next part of the task. */
+            std::chrono::milliseconds stepBudget{ 0 }; /**< Time the steps of the task may take, zero for the step budget of the scheduler. */
+        };
+
+        /**
+         * @brief Tuning of the maintenance scheduler.
+         */
+        struct MaintenanceOptions
+        {
+            static constexpr int DEFAULT_IDLE_DELAY_MS = 30000; /**< Default time without activity before maintenance starts. */
+            static constexpr int DEFAULT_STEP_BUDGET_MS = 20; /**< Default time a single step may take. */
+            static constexpr int DEFAULT_STEP_PAUSE_MS = 10; /**< Default pause between two steps. */
+            static constexpr int DEFAULT_MAX_STEP_BUDGET_MS = 60000; /**< Default longest budget of a step repeated after timeouts. */
+
+            int idleDelayMs = DEFAULT_IDLE_DELAY_MS; /**< Milliseconds without user activity before maintenance starts. */
+            int stepBudgetMs = DEFAULT_STEP_BUDGET_MS; /**< Milliseconds a single step may take. */
+            int stepPauseMs = DEFAULT_STEP_PAUSE_MS; /**< Milliseconds between two steps, so queued events are picked up. */
+            int maxStepBudgetMs = DEFAULT_MAX_STEP_BUDGET_MS; /**< Milliseconds a step may take at most once its budget grew after timeouts. */
+        };
+
+        /**
+         * @brief Outcome of a step run by the scheduler.
+         */
+        struct MaintenanceStepResult
+        {
+            std::string task;           /**< Name of the task. */
+            MaintenanceStatus status;   /**< Outcome of the step. */
+        };
+
+        /**
+         * @brief The MaintenanceScheduler class decides when and which maintenance step runs.
+         *
+         * Steps only run once no activity was reported for the idle delay, one at a time and never longer than the step
+         * budget. Reporting activity raises the interrupt flag, which the running step polls and returns on at once; the
+         * interrupted task resumes when the user is idle again. A task whose step timed out is repeated with twice the budget,
+         * which it keeps for later runs, and only fails once the longest budget did not suffice either; activity still
+         * interrupts such long steps at once. Tasks are due when their interval passed since their last complete run,
+         * given in seconds since the epoch so it can be persisted, and run in the order they were added.
+         * The steps run on the thread calling runStep(); activity may be reported from any thread.
+         */
+        class MaintenanceScheduler
+        {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            /**
+             * @brief Constructs a scheduler without tasks.
+             * @param options Idle delay and step limits.
+             */
+            explicit MaintenanceScheduler(const MaintenanceOptions& options = {});
+
+            /**
+             * @brief Adds a task.
+             * @param task The task.
+             * @param lastRun Seconds since the epoch of the last complete run, 0 if it never ran.
+             */
+            void addTask(MaintenanceTask task, int64_t lastRun);
+
+            /**
+             * @brief Reports user activity, which interrupts the running step and restarts the idle delay.
+             * @param now Time of the activity.
+             */
+            void noteActivity(Clock::time_point now = Clock::now());
+
+            /**
+             * @brief Gets the time until the next step may run.
+             * @param now The current time.
+             * @param wallTime The current time in seconds since the epoch.
+             * @return Zero if a step may run, the remaining delay otherwise, or nothing if no task is due.
+             */
+            std::optional<Clock::duration> timeUntilStep(Clock::time_point now, int64_t wallTime) const;
+
+            /**
+             * @brief Runs one step of the current or the next due task if the user is idle.
+             * @param now The current time.
+             * @param wallTime The current time in seconds since the epoch, recorded as last run of completed tasks.
+             * @return The outcome of the step, or nothing if no step ran.
+             */
+            std::optional<MaintenanceStepResult> runStep(Clock::time_point now, int64_t wallTime);
+
+            /**
+             * @brief Gets the time a task last completed.
+             * @param name Name of the task.
+             * @return Seconds since the epoch, 0 if the task never ran or is unknown.
+             */
+            int64_t lastRun(const std::string& name) const;
+
+        private:
+            /**
+             * @brief A task with its schedule.
+             */
+            struct ScheduledTask
+            {
+                MaintenanceTask task;   /**< The task. */
+                int64_t lastRun;        /**< Seconds since the epoch of the last complete run. */
+                std::chrono::milliseconds budget; /**< Time the next step may take. */
+            };
+
+            /**
+             * @brief Finds the task the next step belongs to.
+             * @param wallTime The current time in seconds since the epoch.
+             * @return Index of the task, or nothing if no task is due.
+             */
+            std::optional<std::size_t> nextTask(int64_t wallTime) const;
+
+            MaintenanceOptions m_options; /**< Idle delay and step limits. */
+            std::deque<ScheduledTask> m_tasks; /**< Tasks in the order they run, a deque so a running step stays valid while tasks are added. */
+            std::optional<std::size_t> m_current; /**< Task which has started and not completed yet. */
+            std::atomic<Clock::rep> m_lastActivity; /**< Time of the last activity. */
+            Clock::time_point m_lastStep; /**< Time the last step returned. */
+            std::atomic<bool> m_interrupted = false; /**< Raised by activity, polled by the running step. */
+            mutable tools::ProfiledMutex m_mutex{ "MaintenanceScheduler" }; /**< Guards the tasks and the current task. */
+        };
+    }
+}
@@ -0,0 +1,273 @@
+#include "QueryProfiler.h"
+#include "JapaneseSqlFunctions.h"
+#include <Libraries/SQLite3/sqlite3.h>
+#include "Tools/Logger.h"
+#include <algorithm>
+#include <cctype>
+
+namespace tadaima
+{
+    namespace application
+    {
+        namespace
+        {
+            /**
+             * @brief Statistics of all statements. Intentionally leaked so connections closed during shutdown can still report.
+             */
+            struct QueryRegistry
+            {
+                std::mutex mutex;
+                std::unordered_map<std::string, QueryStats> queries;
+            };
+
+            QueryRegistry& registry()
+            {
+                static QueryRegistry* instance = new QueryRegistry();
+                return *instance;
+            }
+
+            std::size_t bucketOf(uint64_t durationNs)
+            {
+                const auto& limits = QueryProfiler::BUCKET_LIMITS_NS;
+                return static_cast<std::size_t>(std::upper_bound(limits.begin(), limits.end(), durationNs) - limits.begin());
+            }
+        }
+
+        QueryProfiler::QueryProfiler(tools::Logger& logger, std::chrono::nanoseconds slowQueryThreshold)
+            : m_logger(logger), m_slowQueryNs(slowQueryThreshold.count())
+        {
+        }
+
+        QueryProfiler::~QueryProfiler()
+        {
+            detach();
+            if( m_explainDb )
+            {
+                sqlite3_close(m_explainDb);
+            }
+        }
+
+        void QueryProfiler::attach(sqlite3* db)
+        {
+            detach();
+            m_db = db;
+            m_schemas.clear();
+            m_tempViews.clear();
+            if( m_db )
+            {
+                sqlite3_stmt* stmt;
+                if( sqlite3_prepare_v2(m_db, "PRAGMA database_list;", -1, &stmt, 0) == SQLITE_OK )
+                {
+                    while( sqlite3_step(stmt) == SQLITE_ROW )
+                    {
+                        const char* name = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+                        const char* file = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2));
+                        if( name && file && *file != '\0' )
+                        {
+                            m_schemas.emplace_back(name, file);
+                        }
+                    }
+                    sqlite3_finalize(stmt);
+                }
+                // The schema keeps the statement without TEMP, which would create the view in the read-only main database
+                if( sqlite3_prepare_v2(m_db, "SELECT 'CREATE TEMP ' || substr(sql, 8) FROM temp.sqlite_master WHERE type = 'view' AND sql IS NOT NULL;", -1, &stmt, 0) == SQLITE_OK )
+                {
+                    while( sqlite3_step(stmt) == SQLITE_ROW )
+                    {
+                        m_tempViews.emplace_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+                    }
+                    sqlite3_finalize(stmt);
+                }
+                sqlite3_trace_v2(m_db, SQLITE_TRACE_STMT | SQLITE_TRACE_PROFILE, &QueryProfiler::onTrace, this);
+            }
+        }
+
+        void QueryProfiler::detach()
+        {
+            if( m_db )
+            {
+                sqlite3_trace_v2(m_db, 0, nullptr, nullptr);
+                m_db = nullptr;
+                std::lock_guard<std::mutex> guard(m_runningMutex);
+                m_running.clear();
+            }
+        }
+
+        std::vector<QueryStats> QueryProfiler::topQueries(std::size_t count)
+        {
+            QueryRegistry& queries = registry();
+            std::vector<QueryStats> result;
+            {
+                std::lock_guard<std::mutex> guard(queries.mutex);
+                result.reserve(queries.queries.size());
+                for( const auto& [sql, stats] : queries.queries )
+                {
+                    result.push_back(stats);
+                }
+            }
+
+            const std::size_t kept = std::min(count, result.size());
+            std::partial_sort(result.begin(), result.begin() + kept, result.end(), [](const QueryStats& lhs, const QueryStats& rhs) { return lhs.totalNs > rhs.totalNs; });
+            result.resize(kept);
+            return result;
+        }
+
+        void QueryProfiler::reset()
+        {
+            QueryRegistry& queries = registry();
+            std::lock_guard<std::mutex> guard(queries.mutex);
+            queries.queries.clear();
+        }
+
+        std::string QueryProfiler::normalize(const std::string& sql)
+        {
+            std::string normalized;
+            normalized.reserve(sql.size());
+            for( char character : sql )
+            {
+                if( std::isspace(static_cast<unsigned char>(character)) )
+                {
+                    if( !normalized.empty() && normalized.back() != ' ' )
+                    {
+                        normalized += ' ';
+                    }
+                }
+                else if( character == '?' && (normalized.ends_with("?, ") || normalized.ends_with("?,")) )
+                {
+                    normalized.resize(normalized.rfind('?') + 1); // Fold parameter lists
+                }
+                else
+                {
+                    normalized += character;
+                }
+            }
+            while( !normalized.empty() && (normalized.back() == ' ' || normalized.back() == ';') )
+            {
+                normalized.pop_back();
+            }
+            return normalized;
+        }
+
+        int QueryProfiler::onTrace(unsigned type, void* context, void* statement, void* data)
+        {
+            QueryProfiler& profiler = *static_cast<QueryProfiler*>(context);
+            sqlite3_stmt* stmt = static_cast<sqlite3_stmt*>(statement);
+            if( type == SQLITE_TRACE_STMT )
+            {
+                // Also raised for every trigger program of the statement, the first event marks the start
+                std::lock_guard<std::mutex> guard(profiler.m_runningMutex);
+                profiler.m_running.try_emplace(stmt, Clock::now());
+            }
+            else if( type == SQLITE_TRACE_PROFILE )
+            {
+                int64_t durationNs = *static_cast<sqlite3_int64*>(data);
+                {
+                    std::lock_guard<std::mutex> guard(profiler.m_runningMutex);
+                    const auto running = profiler.m_running.find(stmt);
+                    if( running != profiler.m_running.end() )
+                    {
+                        durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - running->second).count();
+                        profiler.m_running.erase(running);
+                    }
+                }
+                profiler.record(stmt, durationNs);
+            }
+            return 0;
+        }
+
+        void QueryProfiler::record(sqlite3_stmt* statement, int64_t durationNs)
+        {
+            const char* text = sqlite3_sql(statement);
+            if( text == nullptr )
+            {
+                return;
+            }
+
+            const std::string sql = normalize(text);
+            const uint64_t duration = static_cast<uint64_t>(std::max<int64_t>(durationNs, 0));
+            // Reset the counters so reused prepared statements report each execution separately
+            const uint64_t vmSteps = static_cast<uint64_t>(sqlite3_stmt_status(statement, SQLITE_STMTSTATUS_VM_STEP, 1));
+            const uint64_t fullScanSteps = static_cast<uint64_t>(sqlite3_stmt_status(statement, SQLITE_STMTSTATUS_FULLSCAN_STEP, 1));
+
+            {
+                QueryRegistry& queries = registry();
+                std::lock_guard<std::mutex> guard(queries.mutex);
+                QueryStats& stats = queries.queries[sql];
+                if( stats.sql.empty() )
+                {
+                    stats.sql = sql;
+                }
+                stats.calls++;
+                stats.totalNs += duration;
+                stats.maxNs = std::max(stats.maxNs, duration);
+                stats.vmSteps += vmSteps;
+                stats.fullScanSteps += fullScanSteps;
+                stats.histogram[bucketOf(duration)]++;
+            }
+
+            if( durationNs >= m_slowQueryNs )
+            {
+                const std::string plan = explain(text);
+                m_logger.log("Database: Slow query (" + std::to_string(durationNs / 1'000'000) + " ms, " + std::to_string(vmSteps) + " steps): " + sql +
+                    (plan.empty() ? std::string() : "\n" + plan), tools::LogLevel::WARNING);
+            }
+        }
+
+        std::string QueryProfiler::explain(const std::string& sql)
+        {
+            if( m_explainDb == nullptr )
+            {
+                // Databases attached to a read-only connection are read-only as well
+                if( m_schemas.empty() || m_schemas.front().first != "main" || sqlite3_open_v2(m_schemas.front().second.c_str(), &m_explainDb, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK )
+                {
+                    sqlite3_close(m_explainDb);
+                    m_explainDb = nullptr;
+                    return {};
+                }
+                // Queries using the Japanese collations and functions can only be planned where they are defined
+                registerJapaneseSqlFunctions(m_explainDb);
+                for( std::size_t index = 1; index < m_schemas.size(); ++index )
+                {
+                    sqlite3_stmt* attach;
+                    if( sqlite3_prepare_v2(m_explainDb, ("ATTACH DATABASE ? AS \"" + m_schemas[index].first + "\";").c_str(), -1, &attach, 0) == SQLITE_OK )
+                    {
+                        sqlite3_bind_text(attach, 1, m_schemas[index].second.c_str(), -1, SQLITE_STATIC);
+                        sqlite3_step(attach);
+                        sqlite3_finalize(attach);
+                    }
+                }
+                // Views shadowing tables, like the words of an older read-only deck, change the plan and the columns a query may use
+                for( const auto& view : m_tempViews )
+                {
+                    char* errMsg = nullptr;
+                    if( sqlite3_exec(m_explainDb, view.c_str(), 0, 0, &errMsg) != SQLITE_OK )
+                    {
+                        m_logger.log("Database: Can't recreate a temporary view for query plans: " + std::string(errMsg), tools::LogLevel::WARNING);
+                        sqlite3_free(errMsg);
+                    }
+                }
+            }
+
+            std::string plan;
+            sqlite3_stmt* stmt;
+            if( sqlite3_prepare_v2(m_explainDb, ("EXPLAIN QUERY PLAN " + sql).c_str(), -1, &stmt, 0) == SQLITE_OK )
+            {
+                std::unordered_map<int, int> depths; // Plan step ID to indentation
+                while( sqlite3_step(stmt) == SQLITE_ROW )
+                {
+                    const int id = sqlite3_column_int(stmt, 0);
+                    const int depth = depths.count(sqlite3_column_int(stmt, 1)) ? depths[sqlite3_column_int(stmt, 1)] + 1 : 1;
+                    depths[id] = depth;
+                    const unsigned char* detail = sqlite3_column_text(stmt, 3);
+                    plan += std::string(depth * 2, ' ') + (detail ? reinterpret_cast<const char*>(detail) : "") + "\n";
+                }
+                sqlite3_finalize(stmt);
+            }
+            if( !plan.empty() )
+            {
+                plan.pop_back();
+            }
+            return plan;
+        }
+    }
+}
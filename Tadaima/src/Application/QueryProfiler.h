@@ -0,0 +1,139 @@
+/**
+ * @file QueryProfiler.h
+ * @brief Declares the QueryProfiler class which times the SQL statements of a database connection.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct sqlite3;
+struct sqlite3_stmt;
+namespace tools { class Logger; }
+
+namespace tadaima
+{
+    namespace application
+    {
+        /**
+         * @brief Statistics of one normalized SQL statement.
+         */
+        struct QueryStats
+        {
+            static constexpr std::size_t BUCKET_COUNT = 8; /**< Number of histogram buckets. */
+
+            std::string sql;                /**< Normalized text of the statement. */
+            uint64_t calls = 0;             /**< Number of executions. */
+            uint64_t totalNs = 0;           /**< Total execution time in nanoseconds. */
+            uint64_t maxNs = 0;             /**< Longest execution in nanoseconds. */
+            uint64_t vmSteps = 0;           /**< Virtual machine steps of all executions. */
+            uint64_t fullScanSteps = 0;     /**< Steps spent scanning tables without an index. */
+            std::array<uint64_t, BUCKET_COUNT> histogram{}; /**< Executions per duration bucket, see QueryProfiler::BUCKET_LIMITS_NS. */
+        };
+
+        /**
+         * @brief The QueryProfiler class collects per-statement timings through sqlite3_trace_v2.
+         *
+         * Every finished statement is recorded under its normalized text: whitespace is collapsed and lists of bound
+         * parameters are folded, so "IN (?, ?, ?)" of any length counts as one query. Statements slower than the
+         * threshold are logged as warnings together with their EXPLAIN QUERY PLAN, which is taken on a separate
+         * read-only connection because the traced connection must not be used from inside the callback. Statistics
+         * are shared by all profilers of the process, like the other diagnostics. Durations are measured with the steady
+         * clock between the start and end events of a statement, since the time SQLite reports is only as precise as
+         * its VFS clock, which is milliseconds on common platforms.
+         */
+        class QueryProfiler
+        {
+        public:
+            static constexpr std::chrono::milliseconds DEFAULT_SLOW_QUERY_THRESHOLD{ 50 }; /**< Default duration of a slow query. */
+            static constexpr std::array<uint64_t, QueryStats::BUCKET_COUNT - 1> BUCKET_LIMITS_NS =
+            {
+                100'000, 500'000, 1'000'000, 5'000'000, 10'000'000, 50'000'000, 100'000'000
+            }; /**< Exclusive upper bounds of all histogram buckets but the last one, in nanoseconds. */
+
+            /**
+             * @brief Constructs a profiler.
+             * @param logger Logger slow queries are reported to.
+             * @param slowQueryThreshold Executions taking at least this long are logged with their plan.
+             */
+            explicit QueryProfiler(tools::Logger& logger, std::chrono::nanoseconds slowQueryThreshold = DEFAULT_SLOW_QUERY_THRESHOLD);
+
+            /**
+             * @brief Detaches the profiler and closes the connection used for query plans.
+             */
+            ~QueryProfiler();
+
+            QueryProfiler(const QueryProfiler&) = delete;
+            QueryProfiler& operator=(const QueryProfiler&) = delete;
+
+            /**
+             * @brief Starts profiling a connection.
+             * @param db The connection. It must outlive the profiler or be detached first. Databases attached to it
+             * and temporary views created on it before this call are recreated on the query plan connection as well.
+             */
+            void attach(sqlite3* db);
+
+            /**
+             * @brief Stops profiling the attached connection.
+             */
+            void detach();
+
+            /**
+             * @brief Gets the statements with the highest total execution time.
+             * @param count Maximum number of statements.
+             * @return The statistics, slowest first.
+             */
+            static std::vector<QueryStats> topQueries(std::size_t count);
+
+            /**
+             * @brief Clears the statistics of all statements.
+             */
+            static void reset();
+
+            /**
+             * @brief Normalizes a statement so that executions differing only in layout or list lengths match.
+             * @param sql The SQL text.
+             * @return The normalized text.
+             */
+            static std::string normalize(const std::string& sql);
+
+        private:
+            /**
+             * @brief Receives the trace events of the attached connection.
+             */
+            static int onTrace(unsigned type, void* context, void* statement, void* data);
+
+            /**
+             * @brief Records a finished statement.
+             * @param statement The statement.
+             * @param durationNs Its execution time in nanoseconds.
+             */
+            void record(sqlite3_stmt* statement, int64_t durationNs);
+
+            /**
+             * @brief Gets the query plan of a statement from the read-only connection.
+             * @param sql The SQL text.
+             * @return One line per plan step, or an empty string if the plan is unavailable.
+             */
+            std::string explain(const std::string& sql);
+
+            using Clock = std::chrono::steady_clock;
+
+            tools::Logger& m_logger; /**< Logger slow queries are reported to. */
+            const int64_t m_slowQueryNs; /**< Threshold of slow queries in nanoseconds. */
+            sqlite3* m_db = nullptr; /**< The profiled connection. */
+            sqlite3* m_explainDb = nullptr; /**< Read-only connection used for query plans, opened on the first slow query. */
+            std::vector<std::pair<std::string, std::string>> m_schemas; /**< Names and files of the databases of the connection, main first. */
+            std::vector<std::string> m_tempViews; /**< Statements creating the temporary views of the connection. */
+            std::mutex m_runningMutex; /**< Guards m_running. */
+            std::unordered_map<sqlite3_stmt*, Clock::time_point> m_running; /**< Start times of the statements being executed. */
+        };
+    }
+}
@@ -0,0 +1,65 @@
+#include "ReviewRecorder.h"
+#include "tools/Database.h"
+#include "review/MemoryModel.h"
+#include "review/LeechDetector.h"
+#include "Tools/Logger.h"
+#include <string>
+
+namespace tadaima
+{
+    namespace application
+    {
+        ReviewRecorder::ReviewRecorder(Database& database, const review::MemoryModel& memoryModel, const review::LeechDetector& leechDetector, tools::Logger& logger)
+            : m_database(database), m_memoryModel(memoryModel), m_leechDetector(leechDetector), m_logger(logger)
+        {
+        }
+
+        RecordedReviews ReviewRecorder::record(const std::vector<review::ReviewRecord>& reviews)
+        {
+            RecordedReviews recorded;
+            for( const auto& record : reviews )
+            {
+                // The review, its confusion and the memory state are stored together, so the scheduler never sees one without the other
+                if( record.wordId < 0 || !m_database.beginTransaction() )
+                {
+                    m_logger.log("Review of word " + std::to_string(record.wordId) + " could not be stored.", tools::LogLevel::WARNING);
+                    continue;
+                }
+
+                bool stored = m_database.addReview(record);
+                const bool confused = stored && !record.correct && record.chosenWordId >= 0 && record.chosenWordId != record.wordId;
+                if( confused )
+                {
+                    stored = m_database.addConfusion(review::Confusion{ record.wordId, record.chosenWordId, 1, record.timestamp });
+                }
+
+                const review::MemoryState previous = m_database.getMemoryState(record.wordId);
+                review::MemoryState state = previous;
+                m_memoryModel.applyReview(state, record);
+                stored = stored && m_database.saveMemoryState(state);
+
+                const bool becameLeech = stored && m_leechDetector.becameLeech(previous, state);
+                if( becameLeech )
+                {
+                    m_database.addTag(record.wordId, review::LeechDetector::LEECH_TAG);
+                }
+
+                if( !stored || !m_database.commitTransaction() )
+                {
+                    m_database.rollbackTransaction();
+                    m_logger.log("Review of word " + std::to_string(record.wordId) + " could not be stored.", tools::LogLevel::WARNING);
+                    continue;
+                }
+
+                ++recorded.stored;
+                recorded.confused = recorded.confused || confused;
+                if( becameLeech )
+                {
+                    m_logger.log("Word " + std::to_string(record.wordId) + " became a leech after " + std::to_string(state.lapses) + " lapses.", tools::LogLevel::INFO);
+                    recorded.leeches.push_back(record.wordId);
+                }
+            }
+            return recorded;
+        }
+    }
+}
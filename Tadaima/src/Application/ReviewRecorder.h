@@ -0,0 +1,67 @@
+/**
+ * @file ReviewRecorder.h
+ * @brief Declares the ReviewRecorder class which stores quiz answers with everything derived from them.
+ */
+
+#pragma once
+
+#include "review/Review.h"
+#include <cstddef>
+#include <vector>
+
+namespace tools { class Logger; }
+namespace tadaima
+{
+    class Database;
+    namespace review { class MemoryModel; class LeechDetector; }
+
+    namespace application
+    {
+        /**
+         * @brief What storing a batch of reviews changed.
+         */
+        struct RecordedReviews
+        {
+            std::size_t stored = 0; /**< Number of reviews which were stored. */
+            std::vector<int> leeches; /**< IDs of the words which became leeches and were tagged. */
+            bool confused = false; /**< True if a wrong answer was counted as a confusion. */
+        };
+
+        /**
+         * @brief The ReviewRecorder class stores reviews and updates the memory state, leech tag and confusions of the words.
+         *
+         * The application and the command line interface both store their answers through it, so reviews given in either
+         * produce the same data. The memory model and leech detector are referenced, so changed settings apply at once.
+         */
+        class ReviewRecorder
+        {
+        public:
+            /**
+             * @brief Constructs a recorder.
+             * @param database Database the reviews are stored in.
+             * @param memoryModel Model updating the memory state of a reviewed word.
+             * @param leechDetector Detector deciding whether a review turned a word into a leech.
+             * @param logger Logger for reviews which could not be stored and new leeches.
+             */
+            ReviewRecorder(Database& database, const review::MemoryModel& memoryModel, const review::LeechDetector& leechDetector, tools::Logger& logger);
+
+            /**
+             * @brief Stores reviews one by one.
+             *
+             * Wrong answers which picked the answer of another word are counted as confusions. Words whose failure counter
+             * reaches the leech threshold are tagged as leeches. Each review is written in one transaction with its
+             * confusion, memory state and leech tag, and rolled back as a whole if any of them fails.
+             *
+             * @param reviews The reviews to store, reviews of unknown words and failed reviews are skipped and logged.
+             * @return What was changed.
+             */
+            RecordedReviews record(const std::vector<review::ReviewRecord>& reviews);
+
+        private:
+            Database& m_database; /**< Database the reviews are stored in. */
+            const review::MemoryModel& m_memoryModel; /**< Model updating the memory states. */
+            const review::LeechDetector& m_leechDetector; /**< Detector of new leeches. */
+            tools::Logger& m_logger; /**< Logger for failures and new leeches. */
+        };
+    }
+}
@@ -0,0 +1,83 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <cstring>
+
+namespace tadaima
+{
+    namespace gui
+    {
+        FrameArena::FrameArena(std::size_t capacity, std::pmr::memory_resource* upstream)
+            : m_upstream(upstream), m_capacity(std::max<std::size_t>(capacity, 1)), m_overflow(upstream)
+        {
+            m_block = static_cast<char*>(m_upstream->allocate(m_capacity, 1));
+        }
+
+        FrameArena::~FrameArena()
+        {
+            releaseOverflow();
+            m_upstream->deallocate(m_block, m_capacity, 1);
+        }
+
+        FrameArena& FrameArena::frame()
+        {
+            static FrameArena arena;
+            return arena;
+        }
+
+        char* FrameArena::allocate(std::size_t size)
+        {
+            if( size <= m_capacity - m_used )
+            {
+                char* memory = m_block + m_used;
+                m_used += size;
+                return memory;
+            }
+
+            char* memory = static_cast<char*>(m_upstream->allocate(size, 1));
+            m_overflow.emplace_back(memory, size);
+            m_overflowSize += size;
+            return memory;
+        }
+
+        const char* FrameArena::copy(std::string_view text)
+        {
+            char* memory = allocate(text.size() + 1);
+            std::memcpy(memory, text.data(), text.size());
+            memory[text.size()] = '\0';
+            return memory;
+        }
+
+        void FrameArena::reset()
+        {
+            if( m_overflowSize > 0 )
+            {
+                const std::size_t capacity = std::max(m_capacity * 2, m_used + m_overflowSize);
+                releaseOverflow();
+                m_upstream->deallocate(m_block, m_capacity, 1);
+                m_block = static_cast<char*>(m_upstream->allocate(capacity, 1));
+                m_capacity = capacity;
+            }
+            m_used = 0;
+        }
+
+        void FrameArena::releaseOverflow()
+        {
+            for( const auto& [memory, size] : m_overflow )
+            {
+                m_upstream->deallocate(memory, size, 1);
+            }
+            m_overflow.clear();
+            m_overflowSize = 0;
+        }
+
+        std::size_t FrameArena::used() const
+        {
+            return m_used + m_overflowSize;
+        }
+
+        std::size_t FrameArena::capacity() const
+        {
+            return m_capacity;
+        }
+    }
+}
@@ -0,0 +1,145 @@
+/**
+ * @file FrameArena.h
+ * @brief Declares the FrameArena class which holds transient strings built while drawing a frame.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <format>
+#include <memory_resource>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tadaima
+{
+    namespace gui
+    {
+        /**
+         * @brief The FrameArena class is a linear allocator for text that lives only until the frame is rendered.
+         *
+         * Allocations bump a pointer inside one block and are released all at once by reset(), which the GUI calls
+         * after ImGui::Render(). When a frame needs more than the block holds, the extra text goes to overflow
+         * blocks and the next reset() grows the block to fit, so steady-state frames do no heap allocations. Blocks are
+         * taken from an upstream memory resource, the heap unless another one is given.
+         */
+        class FrameArena
+        {
+        public:
+            static constexpr std::size_t DEFAULT_CAPACITY = 16 * 1024; /**< Initial size of the block in bytes. */
+
+            /**
+             * @brief Constructs a FrameArena object.
+             * @param capacity Initial size of the block in bytes.
+             * @param upstream The memory resource blocks are allocated from.
+             */
+            explicit FrameArena(std::size_t capacity = DEFAULT_CAPACITY, std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+
+            /**
+             * @brief Destroys the FrameArena object and returns its blocks to the upstream resource.
+             */
+            ~FrameArena();
+
+            FrameArena(const FrameArena&) = delete;
+            FrameArena& operator=(const FrameArena&) = delete;
+
+            /**
+             * @brief Gets the arena of the GUI thread.
+             * @return A reference to the arena.
+             */
+            static FrameArena& frame();
+
+            /**
+             * @brief Allocates uninitialized bytes valid until the next reset().
+             * @param size Number of bytes.
+             * @return Pointer to the bytes.
+             */
+            char* allocate(std::size_t size);
+
+            /**
+             * @brief Copies text into the arena.
+             * @param text The text to copy.
+             * @return The null-terminated copy.
+             */
+            const char* copy(std::string_view text);
+
+            /**
+             * @brief Formats text directly into the arena.
+             * @param format The format string.
+             * @param args The values to format.
+             * @return The null-terminated text.
+             */
+            template<typename... Args>
+            const char* format(std::format_string<const Args&...> format, const Args&... args)
+            {
+                char* text = m_block + m_used;
+                const std::size_t available = m_capacity - m_used;
+                const std::size_t size = static_cast<std::size_t>(std::format_to_n(text, available > 0 ? available - 1 : 0, format, args...).size);
+                if( size < available )
+                {
+                    m_used += size + 1;
+                }
+                else
+                {
+                    text = allocate(size + 1);
+                    std::format_to_n(text, size, format, args...);
+                }
+                text[size] = '\0';
+                return text;
+            }
+
+            /**
+             * @brief Releases everything allocated since the last reset and grows the block if it overflowed.
+             */
+            void reset();
+
+            /**
+             * @brief Gets the number of bytes allocated since the last reset.
+             * @return The number of bytes.
+             */
+            std::size_t used() const;
+
+            /**
+             * @brief Gets the size of the block.
+             * @return The size in bytes.
+             */
+            std::size_t capacity() const;
+
+        private:
+            /**
+             * @brief Returns the overflow allocations to the upstream resource.
+             */
+            void releaseOverflow();
+
+            std::pmr::memory_resource* m_upstream; /**< The resource blocks are allocated from. */
+            char* m_block = nullptr; /**< The block allocations are taken from. */
+            std::size_t m_capacity = 0; /**< Size of the block. */
+            std::size_t m_used = 0; /**< Bytes taken from the block. */
+            std::pmr::vector<std::pair<char*, std::size_t>> m_overflow; /**< Allocations which did not fit into the block, with their sizes. */
+            std::size_t m_overflowSize = 0; /**< Bytes in the overflow allocations. */
+        };
+
+        /**
+         * @brief Formats text into the arena of the current frame.
+         * @param format The format string.
+         * @param args The values to format.
+         * @return The null-terminated text, valid until the frame is rendered.
+         */
+        template<typename... Args>
+        const char* frameFormat(std::format_string<const Args&...> format, const Args&... args)
+        {
+            return FrameArena::frame().format<Args...>(format, args...);
+        }
+
+        /**
+         * @brief Copies text into the arena of the current frame.
+         * @param text The text to copy.
+         * @return The null-terminated copy, valid until the frame is rendered.
+         */
+        inline const char* frameText(std::string_view text)
+        {
+            return FrameArena::frame().copy(text);
+        }
+    }
+}
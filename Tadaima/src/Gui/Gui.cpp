@@ -10,8 +10,10 @@
 #include "Widgets/LessonTreeViewWidget.h"
 #include "Widgets/MenuBarWidget.h"
 #include "Widgets/MainDashboardWidget.h"
+#include "FrameArena.h"
 #include "resources/IconsFontAwesome4.h"
 #include "tools/SystemTools.h"
+#include "tools/AllocationTracker.h"
 #include "imgui.h"
 #include "imgui_impl_dx11.h"
 #include "imgui_impl_win32.h"
@@ -47,6 +49,7 @@ namespace tadaima
             {
                 value->setObserver(std::bind(&Gui::handleWidgetEvent, this, std::placeholders::_1));
             }
+            m_quizManager.setObserver(std::bind(&Gui::handleWidgetEvent, this, std::placeholders::_1));
         }
 
         void Gui::initialize()
@@ -107,6 +110,11 @@ namespace tadaima
             dispatcher.addListener(widget, listener);
         }
 
+        void Gui::setActivityListener(std::function<void()> listener)
+        {
+            m_activityListener = std::move(listener);
+        }
+
         LRESULT WINAPI WndProc(HWND hWnd, UINT msg, WPARAM wParam, LPARAM lParam)
         {
             if( ImGui_ImplWin32_WndProcHandler(hWnd, msg, wParam, lParam) )
@@ -197,6 +205,7 @@ namespace tadaima
             bool done = false;
             while( !done )
             {
+                AllocationScope frameScope(AllocationTag::Gui);
                 bool showLessonTreeView = true;
 
                 // Poll and handle messages (inputs, window resize, etc.)
@@ -208,6 +217,9 @@ namespace tadaima
                     ::DispatchMessage(&msg);
                     if( msg.message == WM_QUIT )
                         done = true;
+                    const bool input = (msg.message >= WM_KEYFIRST && msg.message <= WM_KEYLAST) || (msg.message >= WM_MOUSEFIRST && msg.message <= WM_MOUSELAST);
+                    if( input && m_activityListener )
+                        m_activityListener();
                 }
                 if( done )
                     break;
@@ -274,6 +286,7 @@ namespace tadaima
 
                 // Rendering
                 ImGui::Render();
+                FrameArena::frame().reset();
                 const float clear_color_with_alpha[4] = { clear_color.x * clear_color.w, clear_color.y * clear_color.w, clear_color.z * clear_color.w, clear_color.w };
                 g_pd3dDeviceContext->OMSetRenderTargets(1, &g_mainRenderTargetView, nullptr);
                 g_pd3dDeviceContext->ClearRenderTargetView(g_mainRenderTargetView, clear_color_with_alpha);
@@ -352,7 +365,9 @@ namespace tadaima
         {
             try
             {
-                if( data.getEventType() == tadaima::gui::widget::LessonTreeViewWidget::LessonTreeViewWidgetEvent::OnPlayMultipleChoiceQuiz )
+                const bool isLessonTreeViewEvent = data.getWidget().getType() == widget::Type::LessonTreeView;
+
+                if( isLessonTreeViewEvent && data.getEventType() == tadaima::gui::widget::LessonTreeViewWidget::LessonTreeViewWidgetEvent::OnPlayMultipleChoiceQuiz )
                 {
                     widget::LessonDataPackage* package = dynamic_cast<widget::LessonDataPackage*>(data.getEventData());
                     if( nullptr != package )
@@ -360,7 +375,7 @@ namespace tadaima
                         m_quizManager.startQuiz(quiz::QuizType::MultipleChoiceQuiz, package->decode());
                     }
                 }
-                else if( data.getEventType() == tadaima::gui::widget::LessonTreeViewWidget::LessonTreeViewWidgetEvent::OnPlayVocabularyQuiz )
+                else if( isLessonTreeViewEvent && data.getEventType() == tadaima::gui::widget::LessonTreeViewWidget::LessonTreeViewWidgetEvent::OnPlayVocabularyQuiz )
                 {
                     widget::LessonDataPackage* package = dynamic_cast<widget::LessonDataPackage*>(data.getEventData());
                     if( nullptr != package )
@@ -368,6 +383,14 @@ namespace tadaima
                         m_quizManager.startQuiz(quiz::QuizType::VocabularyQuiz, package->decode());
                     }
                 }
+                else if( isLessonTreeViewEvent && data.getEventType() == tadaima::gui::widget::LessonTreeViewWidget::LessonTreeViewWidgetEvent::OnPlayClozeQuiz )
+                {
+                    widget::LessonDataPackage* package = dynamic_cast<widget::LessonDataPackage*>(data.getEventData());
+                    if( nullptr != package )
+                    {
+                        m_quizManager.startQuiz(quiz::QuizType::ClozeQuiz, package->decode());
+                    }
+                }
                 else
                 {
                     dispatcher.emit(data.getWidget().getType(), &data);
@@ -9,6 +9,7 @@
 #include "Widgets/WidgetTypes.h"
 #include "Tools/EventDispatcher.h"
 #include <d3d11.h>
+#include <functional>
 #include <memory>
 #include <map>
 #include "quiz/QuizManagerWidget.h"
@@ -57,6 +58,13 @@ namespace tadaima
              */
             void addListener(widget::Type widget, EventListener listener);
 
+            /**
+             * @brief Sets the function called for every keyboard and mouse input.
+             *
+             * @param listener The function, called on the GUI thread.
+             */
+            void setActivityListener(std::function<void()> listener);
+
             /**
              * @brief Initializes a widget with provided data.
              *
@@ -120,6 +128,7 @@ namespace tadaima
             tools::Logger& m_logger; /**< Reference to the Logger instance for logging. */
             std::map<widget::Type, std::unique_ptr<widget::Widget>> m_widgets; ///< Vector of widgets.
             config m_guiConfig; ///< Configuration for the GUI.
+            std::function<void()> m_activityListener; ///< Called for every keyboard and mouse input.
         };
     }
 }
@@ -2,8 +2,10 @@
 
 #include "ApplicationSettingsWidget.h"
 #include "packages/SettingsDataPackage.h"
+#include "packages/OptimizationDataPackage.h"
 #include "imgui.h"
 #include "Tools/Logger.h"
+#include <algorithm>
 
 namespace tadaima
 {
@@ -66,6 +68,12 @@ namespace tadaima
                     package.set(SettingsPackageKey::AskedWordType, static_cast<quiz::WordType>(m_inputOption));
                     package.set(SettingsPackageKey::AnswerWordType, static_cast<quiz::WordType>(m_translationOption));
                     package.set(SettingsPackageKey::ShowLogs, m_showlogs);
+                    package.set(SettingsPackageKey::MemoryModel, m_memoryModel);
+                    package.set(SettingsPackageKey::FrequencyListPath, std::string(m_frequencyListPath));
+                    package.set(SettingsPackageKey::FrequencyOrder, m_frequencyOrder);
+                    package.set(SettingsPackageKey::AdaptiveOrder, m_adaptiveOrder);
+                    package.set(SettingsPackageKey::Leech, m_leech);
+                    package.set(SettingsPackageKey::GroupCommit, m_groupCommit);
 
                     emitEvent(WidgetEvent(*this, ApplicationSettingsWidgetEvent::OnSettingsChanged, &package));
                 }
@@ -79,8 +87,39 @@ namespace tadaima
                 }
             }
 
+            void ApplicationSettingsWidget::FitMemoryModel()
+            {
+                m_logger.log("ApplicationSettingsWidget::FitMemoryModel: fitting memory model.", tools::LogLevel::INFO);
+
+                SettingsDataPackage package;
+                package.set(SettingsPackageKey::MemoryModel, m_memoryModel);
+
+                m_fitting = true;
+                m_fitProgress = 0.0f;
+                emitEvent(WidgetEvent(*this, ApplicationSettingsWidgetEvent::OnMemoryModelFitRequested, &package));
+            }
+
+            void ApplicationSettingsWidget::ImportFrequencyList()
+            {
+                m_logger.log("ApplicationSettingsWidget::ImportFrequencyList: importing " + std::string(m_frequencyListPath) + ".", tools::LogLevel::INFO);
+
+                SettingsDataPackage package;
+                package.set(SettingsPackageKey::FrequencyListPath, std::string(m_frequencyListPath));
+
+                emitEvent(WidgetEvent(*this, ApplicationSettingsWidgetEvent::OnFrequencyListImport, &package));
+            }
+
             void ApplicationSettingsWidget::initialize(const tools::DataPackage& r_package)
             {
+                const OptimizationDataPackage* optimizationPackage = dynamic_cast<const OptimizationDataPackage*>(&r_package);
+                if( optimizationPackage )
+                {
+                    m_fitting = optimizationPackage->get<bool>(OptimizationPackageKey::Running);
+                    m_fitProgress = optimizationPackage->get<float>(OptimizationPackageKey::Progress);
+                    m_fitLoss = optimizationPackage->get<float>(OptimizationPackageKey::Loss);
+                    return;
+                }
+
                 try
                 {
                     const SettingsDataPackage* package = dynamic_cast<const SettingsDataPackage*>(&r_package);
@@ -99,9 +138,18 @@ namespace tadaima
                         memcpy(m_dictionaryPath, dictionaryPath.c_str(), dictionaryPath.size());
                         memcpy(m_scriptPaths, quizzesScripts.c_str(), quizzesScripts.size());
 
+                        const std::string frequencyListPath = package->get<std::string>(SettingsPackageKey::FrequencyListPath);
+                        memset(m_frequencyListPath, 0, sizeof(m_frequencyListPath));
+                        memcpy(m_frequencyListPath, frequencyListPath.c_str(), std::min(frequencyListPath.size(), sizeof(m_frequencyListPath) - 1));
+
                         m_inputOption = package->get<quiz::WordType>(SettingsPackageKey::AskedWordType);
                         m_translationOption = package->get<quiz::WordType>(SettingsPackageKey::AnswerWordType);
                         m_showlogs = package->get<bool>(SettingsPackageKey::ShowLogs);
+                        m_memoryModel = package->get<review::MemoryModelParameters>(SettingsPackageKey::MemoryModel);
+                        m_frequencyOrder = package->get<bool>(SettingsPackageKey::FrequencyOrder);
+                        m_adaptiveOrder = package->get<bool>(SettingsPackageKey::AdaptiveOrder);
+                        m_leech = package->get<review::LeechOptions>(SettingsPackageKey::Leech);
+                        m_groupCommit = package->get<application::GroupCommitOptions>(SettingsPackageKey::GroupCommit);
 
                         m_logger.log("ApplicationSettingsWidget: Initialized.", tools::LogLevel::INFO);
                     }
@@ -121,7 +169,7 @@ namespace tadaima
                 if( *p_open )
                 {
                     Open();
-                    ImGui::SetNextWindowSize(ImVec2(550, 280), ImGuiCond_Always);  // Adjust size as needed
+                    ImGui::SetNextWindowSize(ImVec2(550, 340), ImGuiCond_Always);  // Adjust size as needed
                     ImGui::PushStyleColor(ImGuiCol_PopupBg, ImVec4(0.98f, 0.92f, 0.84f, 1.0f)); // Light peach background
                     ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10, 10)); // Add padding
 
@@ -154,6 +202,16 @@ namespace tadaima
                                 ImGui::Checkbox("Show Logs", &m_showlogs);
                                 ShowFieldHelp("Enable or disable logging.");
 
+                                ImGui::InputText("##FrequencyListPath", m_frequencyListPath, IM_ARRAYSIZE(m_frequencyListPath));
+                                ImGui::SameLine();
+                                if( ImGui::Button("Import") )
+                                {
+                                    ImportFrequencyList();
+                                }
+                                ImGui::SameLine();
+                                ImGui::Text("Word frequency list");
+                                ShowFieldHelp("Tab separated list of words, most common first, optionally with their counts. Every word gets its frequency rank.");
+
                                 ImGui::Spacing();
                                 ImGui::Separator();
                                 ImGui::Spacing();
@@ -186,6 +244,12 @@ namespace tadaima
                                 ImGui::Combo("##translation_type", &m_translationOption, translationOptions, IM_ARRAYSIZE(translationOptions));
                                 ShowFieldHelp("Choose how you want the words to be translated during the quiz.");
 
+                                ImGui::Checkbox("Most common words first", &m_frequencyOrder);
+                                ShowFieldHelp("Ask the words in order of their frequency rank instead of shuffling them. Needs an imported frequency list.");
+
+                                ImGui::Checkbox("Repeat weak words more often", &m_adaptiveOrder);
+                                ShowFieldHelp("Draw the next word by its share of wrong answers, so words you keep failing come up more often. Takes precedence over the frequency order.");
+
                                 ImGui::Spacing();
                                 ImGui::Separator();
                                 ImGui::Spacing();
@@ -193,6 +257,12 @@ namespace tadaima
                                 ImGui::EndTabItem();
                             }
 
+                            if( ImGui::BeginTabItem("Review Settings") )
+                            {
+                                DrawReviewSettings();
+                                ImGui::EndTabItem();
+                            }
+
                             ImGui::EndTabBar();
                         }
 
@@ -216,6 +286,66 @@ namespace tadaima
                 }
             }
 
+            void ApplicationSettingsWidget::DrawReviewSettings()
+            {
+                // Review Settings Section
+                ImGui::TextColored(ImVec4(0.8f, 0.2f, 0.2f, 1.0f), "Review Settings");
+                ImGui::Separator();
+                ImGui::Spacing();
+
+                float desiredRetention = static_cast<float>(m_memoryModel.desiredRetention);
+                if( ImGui::SliderFloat("Desired retention", &desiredRetention, 0.7f, 0.97f, "%.2f") )
+                {
+                    m_memoryModel.desiredRetention = desiredRetention;
+                }
+                ShowFieldHelp("Probability of remembering a word at which it is scheduled for review. Higher values mean more reviews.");
+
+                ImGui::Text("Initial stability: %.2f days", m_memoryModel.initialStability);
+                ImGui::Text("Growth rate: %.3f, stability decay: %.3f", m_memoryModel.growthRate, m_memoryModel.stabilityDecay);
+                ImGui::Text("Retrievability gain: %.3f, lapse factor: %.3f", m_memoryModel.retrievabilityGain, m_memoryModel.lapseFactor);
+
+                ImGui::BeginDisabled(m_fitting);
+                if( ImGui::Button("Fit to my reviews", ImVec2(160, 0)) )
+                {
+                    FitMemoryModel();
+                }
+                ImGui::EndDisabled();
+                ShowFieldHelp("Adjusts the memory model to your review history. Runs in the background.");
+
+                if( m_fitting )
+                {
+                    ImGui::SameLine();
+                    ImGui::ProgressBar(m_fitProgress, ImVec2(-1.0f, 0.0f));
+                }
+                else if( m_fitLoss > 0.0f )
+                {
+                    ImGui::SameLine();
+                    ImGui::Text("Log loss: %.4f", m_fitLoss);
+                }
+
+                ImGui::Spacing();
+                ImGui::Separator();
+                ImGui::Spacing();
+
+                ImGui::SliderInt("Leech threshold", &m_leech.lapseThreshold, 2, 20);
+                ShowFieldHelp("Number of failed reviews after which a word is tagged as a leech and listed under Leeches.");
+                ImGui::SliderInt("Leech repeat", &m_leech.repeatInterval, 0, 10);
+                ShowFieldHelp("Number of further failures after which a leech is tagged again if you cleared its tag. 0 tags it only once.");
+
+                ImGui::Spacing();
+                ImGui::Separator();
+                ImGui::Spacing();
+
+                ImGui::SliderInt("Commit window [ms]", &m_groupCommit.windowMs, 0, 1000);
+                ShowFieldHelp("Lesson edits made within this time are saved in one transaction. 0 saves every edit on its own.");
+                ImGui::SliderInt("Edits per commit", &m_groupCommit.maxOperations, 1, 1024);
+                ShowFieldHelp("Number of lesson edits which are saved at once without waiting for the window.");
+
+                ImGui::Spacing();
+                ImGui::Separator();
+                ImGui::Spacing();
+            }
+
             void ApplicationSettingsWidget::ShowFieldHelp(const char* desc)
             {
                 if( ImGui::IsItemHovered() )
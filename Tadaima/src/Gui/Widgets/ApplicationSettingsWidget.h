@@ -8,6 +8,9 @@
 #include "Widget.h"
 #include <string>
 #include <quiz/QuizType.h>
+#include "review/MemoryModel.h"
+#include "review/LeechDetector.h"
+#include "Application/GroupCommit.h"
 
 namespace tools { class Logger; }
 
@@ -29,7 +32,9 @@ namespace tadaima
                  */
                 enum ApplicationSettingsWidgetEvent : uint8_t
                 {
-                    OnSettingsChanged /**< Event triggered when settings are changed. */
+                    OnSettingsChanged,          /**< Event triggered when settings are changed. */
+                    OnMemoryModelFitRequested,  /**< Event triggered when the user asks to fit the memory model to the review history. */
+                    OnFrequencyListImport       /**< Event triggered when the user imports a word frequency list. */
                 };
 
                 /**
@@ -62,6 +67,21 @@ namespace tadaima
                  */
                 void ApplySettings();
 
+                /**
+                 * @brief Requests fitting of the memory model parameters to the review history.
+                 */
+                void FitMemoryModel();
+
+                /**
+                 * @brief Requests import of the word frequency list at the entered path.
+                 */
+                void ImportFrequencyList();
+
+                /**
+                 * @brief Draws the review settings tab.
+                 */
+                void DrawReviewSettings();
+
                 /**
                  * @brief Converts a string to a WordType.
                  * @param str The string to convert.
@@ -95,6 +115,15 @@ namespace tadaima
                 int m_inputOption = quiz::WordType::BaseWord; /**< Input option for word type. */
                 int m_translationOption = quiz::WordType::Romaji; /**< Translation option for word type. */
                 bool m_showlogs = false;
+                char m_frequencyListPath[260] = ""; /**< Path to the word frequency list. */
+                bool m_frequencyOrder = false; /**< Ask the most common words first. */
+                bool m_adaptiveOrder = false; /**< Ask the words answered wrong more often. */
+                review::MemoryModelParameters m_memoryModel; /**< Parameters of the memory model. */
+                review::LeechOptions m_leech; /**< Thresholds of the leech detection. */
+                application::GroupCommitOptions m_groupCommit; /**< Window and size limit of the transactions shared by lesson edits. */
+                bool m_fitting = false; /**< True while the memory model is being fitted. */
+                float m_fitProgress = 0.0f; /**< Progress of the memory model fitting. */
+                float m_fitLoss = 0.0f; /**< Mean log loss reached by the memory model fitting. */
             };
         }
     }
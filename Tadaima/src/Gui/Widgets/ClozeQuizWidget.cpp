@@ -0,0 +1,101 @@
+#include "ClozeQuizWidget.h"
+#include <chrono>
+#include <cstring>
+#include "imgui.h"
+#include "packages/ReviewDataPackage.h"
+#include "tools/Logger.h"
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace widget
+        {
+            ClozeQuizWidget::ClozeQuizWidget(const std::vector<Lesson>& lessons, tools::Logger& logger, quiz::QuizOrder order)
+                : m_logger(logger), m_quiz(lessons, order)
+            {
+                m_quiz.start();
+                m_logger.log("ClozeQuiz started with " + std::to_string(m_quiz.questionCount()) + " sentences.", tools::LogLevel::INFO);
+            }
+
+            void ClozeQuizWidget::emitReview(int wordId, bool correct)
+            {
+                review::ReviewRecord record;
+                record.wordId = wordId;
+                record.timestamp = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+                record.correct = correct;
+
+                ReviewDataPackage package({ record });
+                emitEvent(WidgetEvent(*this, ClozeQuizWidgetEvent::OnWordReviewed, &package));
+            }
+
+            void ClozeQuizWidget::submitAnswer()
+            {
+                const quiz::ClozeCard card = m_quiz.currentCard();
+                m_lastCorrect = m_quiz.submit(m_userInput);
+                m_feedback = m_lastCorrect ? "Correct: " + card.answer : "The answer was " + card.answer + " (" + card.translation + ")";
+                emitReview(card.wordId, m_lastCorrect);
+                std::memset(m_userInput, 0, sizeof(m_userInput));
+                m_focusInput = true;
+            }
+
+            void ClozeQuizWidget::draw(bool* p_open)
+            {
+                ImGui::SetNextWindowSize(ImVec2(600, 300), ImGuiCond_FirstUseEver);
+                ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.98f, 0.92f, 0.84f, 1.0f)); // Light peach background
+                ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10, 10)); // Add padding
+
+                if( ImGui::Begin("Cloze Quiz", p_open, ImGuiWindowFlags_NoCollapse) )
+                {
+                    ImGui::TextWrapped("Fill in the blank with the missing word.");
+
+                    if( !m_quiz.isFinished() )
+                    {
+                        const quiz::ClozeCard& card = m_quiz.currentCard();
+                        ImGui::Separator();
+                        ImGui::TextWrapped("%s", card.sentence.c_str());
+                        ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "%s", card.translation.c_str());
+
+                        ImGui::Spacing();
+                        if( m_focusInput )
+                        {
+                            ImGui::SetKeyboardFocusHere();
+                            m_focusInput = false;
+                        }
+                        if( ImGui::InputText("##ClozeAnswer", m_userInput, sizeof(m_userInput), ImGuiInputTextFlags_EnterReturnsTrue) )
+                        {
+                            submitAnswer();
+                        }
+
+                        ImGui::Text("Progress: %d/%d", static_cast<int>(m_quiz.asked()) + 1, static_cast<int>(m_quiz.questionCount()));
+                    }
+                    else
+                    {
+                        ImGui::Text("%s", m_quiz.getResults().c_str());
+                        if( ImGui::Button("Restart", ImVec2(550, 0)) )
+                        {
+                            m_quiz.start();
+                            m_feedback.clear();
+                            m_focusInput = true;
+                        }
+                    }
+
+                    if( !m_feedback.empty() )
+                    {
+                        const ImVec4 color = m_lastCorrect ? ImVec4(0.0f, 0.6f, 0.0f, 1.0f) : ImVec4(0.8f, 0.2f, 0.2f, 1.0f);
+                        ImGui::TextColored(color, "%s", m_feedback.c_str());
+                    }
+
+                    if( ImGui::Button("Close", ImVec2(550, 0)) )
+                    {
+                        *p_open = false;
+                    }
+                }
+
+                ImGui::End();
+                ImGui::PopStyleColor();  // Restore previous style
+                ImGui::PopStyleVar();  // Restore previous padding
+            }
+        }
+    }
+}
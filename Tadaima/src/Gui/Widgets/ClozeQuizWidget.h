@@ -0,0 +1,78 @@
+/**
+ * @file ClozeQuizWidget.h
+ * @brief Declares the ClozeQuizWidget class asking words blanked in their example sentences.
+ */
+
+#pragma once
+
+#include "Widget.h"
+#include "quiz/ClozeQuiz.h"
+#include "quiz/QuizType.h"
+#include "lessons/Lesson.h"
+#include <string>
+#include <vector>
+
+namespace tools { class Logger; }
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace widget
+        {
+            /**
+             * @class ClozeQuizWidget
+             * @brief Shows an example sentence with a blank and checks the word typed into it.
+             *
+             * An answer moves on to the next sentence at once, the verdict on the previous one stays visible below it.
+             */
+            class ClozeQuizWidget : public Widget
+            {
+            public:
+
+                /**
+                 * @brief Enum representing events emitted by the ClozeQuizWidget.
+                 */
+                enum ClozeQuizWidgetEvent : uint8_t
+                {
+                    OnWordReviewed  /**< Event emitted when the user answered a question. */
+                };
+
+                /**
+                 * @brief Constructs a ClozeQuizWidget object.
+                 * @param lessons Vector of lessons to initialize the quiz with.
+                 * @param logger Reference to a Logger instance for logging.
+                 * @param order The order in which the words are asked.
+                 * @throws std::invalid_argument If no word appears in its example sentence.
+                 */
+                ClozeQuizWidget(const std::vector<Lesson>& lessons, tools::Logger& logger, quiz::QuizOrder order = quiz::QuizOrder::Random);
+
+                /**
+                 * @brief Draws the quiz widget on the screen.
+                 * @param p_open Pointer to a boolean indicating if the widget should remain open.
+                 */
+                void draw(bool* p_open = nullptr) override;
+
+            private:
+                /**
+                 * @brief Judges the typed answer, emits its review and asks the next question.
+                 */
+                void submitAnswer();
+
+                /**
+                 * @brief Emits the review of a word so it can be stored in the review history.
+                 * @param wordId The ID of the reviewed word.
+                 * @param correct True if the answer was correct.
+                 */
+                void emitReview(int wordId, bool correct);
+
+                tools::Logger& m_logger; /**< Reference to the Logger instance for logging. */
+                quiz::ClozeQuiz m_quiz; /**< Questions and answers of the quiz. */
+                char m_userInput[256] = {}; /**< Text typed into the blank. */
+                std::string m_feedback; /**< Verdict on the previous answer. */
+                bool m_lastCorrect = false; /**< True if the previous answer was correct. */
+                bool m_focusInput = true; /**< True if the input field takes the keyboard focus in the next frame. */
+            };
+        }
+    }
+}
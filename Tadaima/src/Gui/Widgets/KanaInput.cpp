@@ -0,0 +1,61 @@
+#include "KanaInput.h"
+#include <cstring>
+#include <string>
+#include "tools/RomajiInput.h"
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace widget
+        {
+            namespace
+            {
+                // Replaces the romaji before the cursor, unless the kana would not fit into the buffer
+                int convertRomaji(ImGuiInputTextCallbackData* data)
+                {
+                    RomajiInput::Replacement replacement;
+                    if( !RomajiInput::convert(std::string_view(data->Buf, static_cast<std::size_t>(data->CursorPos)), replacement) )
+                    {
+                        return 0;
+                    }
+                    const int start = static_cast<int>(replacement.start);
+                    const int length = static_cast<int>(replacement.length);
+                    const int kanaLength = static_cast<int>(replacement.kana.size());
+                    if( data->BufTextLen - length + kanaLength >= data->BufSize )
+                    {
+                        return 0;
+                    }
+                    data->DeleteChars(start, length);
+                    data->InsertChars(start, replacement.kana.c_str(), replacement.kana.c_str() + kanaLength);
+                    return 0;
+                }
+
+                void finishRomaji(char* buffer, std::size_t size)
+                {
+                    std::string text(buffer);
+                    RomajiInput::Replacement replacement;
+                    if( !RomajiInput::finish(text, replacement) )
+                    {
+                        return;
+                    }
+                    text.replace(replacement.start, replacement.length, replacement.kana);
+                    if( text.size() < size )
+                    {
+                        std::memcpy(buffer, text.c_str(), text.size() + 1);
+                    }
+                }
+            }
+
+            bool inputKana(const char* label, char* buffer, std::size_t size, ImGuiInputTextFlags flags)
+            {
+                const bool result = ImGui::InputText(label, buffer, size, flags | ImGuiInputTextFlags_CallbackEdit, convertRomaji);
+                if( (result && (flags & ImGuiInputTextFlags_EnterReturnsTrue)) || ImGui::IsItemDeactivatedAfterEdit() )
+                {
+                    finishRomaji(buffer, size);
+                }
+                return result;
+            }
+        }
+    }
+}
@@ -0,0 +1,31 @@
+/**
+ * @file KanaInput.h
+ * @brief Declares an ImGui text input converting typed romaji to kana.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include "imgui.h"
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace widget
+        {
+            /**
+             * @brief Shows a text input whose romaji is turned into kana while it is typed, so no IME is needed.
+             *
+             * Works like ImGui::InputText. The romaji before the cursor is converted by RomajiInput on every edit, and a
+             * trailing "n" becomes ん when the input returns true on Enter or loses the focus.
+             * @param label The ImGui label of the input.
+             * @param buffer The text buffer.
+             * @param size The size of the buffer in bytes.
+             * @param flags The ImGui input flags.
+             * @return The value returned by ImGui::InputText.
+             */
+            bool inputKana(const char* label, char* buffer, std::size_t size, ImGuiInputTextFlags flags = 0);
+        }
+    }
+}
@@ -7,6 +7,7 @@
 #include <sstream>
 #include <stdexcept>
 #include "packages/SettingsDataPackage.h"
+#include "KanaInput.h"
 #include "Tools/Logger.h"
 
 namespace tadaima
@@ -25,6 +26,7 @@ namespace tadaima
                 std::memset(m_translationBuffer, 0, sizeof(m_translationBuffer));
                 std::memset(m_romajiBuffer, 0, sizeof(m_romajiBuffer));
                 std::memset(m_kanaBuffer, 0, sizeof(m_kanaBuffer));
+                std::memset(m_kanjiBuffer, 0, sizeof(m_kanjiBuffer));
                 std::memset(m_exampleSentenceBuffer, 0, sizeof(m_exampleSentenceBuffer));
                 std::memset(m_tagBuffer, 0, sizeof(m_tagBuffer));
             }
@@ -83,6 +85,7 @@ namespace tadaima
                             Word translatedWord = m_dictionary.getTranslation(m_translationBuffer);
                             std::strncpy(m_romajiBuffer, translatedWord.romaji.c_str(), sizeof(m_romajiBuffer));
                             std::strncpy(m_kanaBuffer, translatedWord.kana.c_str(), sizeof(m_kanaBuffer));
+                            std::strncpy(m_kanjiBuffer, translatedWord.kanji.c_str(), sizeof(m_kanjiBuffer));
                             m_logger.log("Translated: ");
                             m_logger.log(" ->: " + translatedWord.translation);
                             m_logger.log(" ->: " + translatedWord.romaji);
@@ -100,9 +103,17 @@ namespace tadaima
                     ImGui::SameLine();
                     ImGui::Text("Romaji");
 
-                    ImGui::InputText("##Kana", m_kanaBuffer, sizeof(m_kanaBuffer));
+                    inputKana("##Kana", m_kanaBuffer, sizeof(m_kanaBuffer));
                     ImGui::SameLine();
                     ImGui::Text("Kana");
+                    if( ImGui::IsItemHovered() )
+                    {
+                        ImGui::SetTooltip("Type romaji to enter kana, e.g., konnichiwa or KO-HI- for katakana");
+                    }
+
+                    ImGui::InputText("##Kanji", m_kanjiBuffer, sizeof(m_kanjiBuffer));
+                    ImGui::SameLine();
+                    ImGui::Text("Kanji");
 
                     ImGui::InputText("##ExampleSentence", m_exampleSentenceBuffer, sizeof(m_exampleSentenceBuffer));
                     ImGui::SameLine();
@@ -126,6 +137,7 @@ namespace tadaima
                         {
                             Word newWord;
                             newWord.kana = std::string(m_kanaBuffer);
+                            newWord.kanji = std::string(m_kanjiBuffer);
                             newWord.translation = std::string(m_translationBuffer);
                             newWord.romaji = std::string(m_romajiBuffer);
                             newWord.exampleSentence = std::string(m_exampleSentenceBuffer);
@@ -146,6 +158,7 @@ namespace tadaima
 
                             // Clear the word input fields for the next word
                             std::memset(m_kanaBuffer, 0, sizeof(m_kanaBuffer));
+                            std::memset(m_kanjiBuffer, 0, sizeof(m_kanjiBuffer));
                             std::memset(m_translationBuffer, 0, sizeof(m_translationBuffer));
                             std::memset(m_romajiBuffer, 0, sizeof(m_romajiBuffer));
                             std::memset(m_exampleSentenceBuffer, 0, sizeof(m_exampleSentenceBuffer));
@@ -163,6 +176,7 @@ namespace tadaima
                             {
                                 Word updatedWord;
                                 updatedWord.kana = std::string(m_kanaBuffer);
+                                updatedWord.kanji = std::string(m_kanjiBuffer);
                                 updatedWord.translation = std::string(m_translationBuffer);
                                 updatedWord.romaji = std::string(m_romajiBuffer);
                                 updatedWord.exampleSentence = std::string(m_exampleSentenceBuffer);
@@ -181,6 +195,7 @@ namespace tadaima
 
                                 // Clear the word input fields
                                 std::memset(m_kanaBuffer, 0, sizeof(m_kanaBuffer));
+                                std::memset(m_kanjiBuffer, 0, sizeof(m_kanjiBuffer));
                                 std::memset(m_translationBuffer, 0, sizeof(m_translationBuffer));
                                 std::memset(m_romajiBuffer, 0, sizeof(m_romajiBuffer));
                                 std::memset(m_exampleSentenceBuffer, 0, sizeof(m_exampleSentenceBuffer));
@@ -196,6 +211,7 @@ namespace tadaima
                             m_selectedWordIndex = -1; // Reset selection after removal
                             // Clear the word input fields
                             std::memset(m_kanaBuffer, 0, sizeof(m_kanaBuffer));
+                            std::memset(m_kanjiBuffer, 0, sizeof(m_kanjiBuffer));
                             std::memset(m_translationBuffer, 0, sizeof(m_translationBuffer));
                             std::memset(m_romajiBuffer, 0, sizeof(m_romajiBuffer));
                             std::memset(m_exampleSentenceBuffer, 0, sizeof(m_exampleSentenceBuffer));
@@ -222,6 +238,7 @@ namespace tadaima
                             // Fill the input fields with the selected word's data
                             m_selectedWordIndex = static_cast<int>(index);
                             std::strncpy(m_kanaBuffer, word.kana.c_str(), sizeof(m_kanaBuffer));
+                            std::strncpy(m_kanjiBuffer, word.kanji.c_str(), sizeof(m_kanjiBuffer));
                             std::strncpy(m_translationBuffer, word.translation.c_str(), sizeof(m_translationBuffer));
                             std::strncpy(m_romajiBuffer, word.romaji.c_str(), sizeof(m_romajiBuffer));
                             std::strncpy(m_exampleSentenceBuffer, word.exampleSentence.c_str(), sizeof(m_exampleSentenceBuffer));
@@ -270,6 +287,7 @@ namespace tadaima
                         std::memset(m_mainNameBuffer, 0, sizeof(m_mainNameBuffer));
                         std::memset(m_subNameBuffer, 0, sizeof(m_subNameBuffer));
                         std::memset(m_kanaBuffer, 0, sizeof(m_kanaBuffer));
+                        std::memset(m_kanjiBuffer, 0, sizeof(m_kanjiBuffer));
                         std::memset(m_translationBuffer, 0, sizeof(m_translationBuffer));
                         std::memset(m_romajiBuffer, 0, sizeof(m_romajiBuffer));
                         std::memset(m_exampleSentenceBuffer, 0, sizeof(m_exampleSentenceBuffer));
@@ -294,6 +312,7 @@ namespace tadaima
                     m_selectedWordIndex = -1;
                     // Clear the word input fields
                     std::memset(m_kanaBuffer, 0, sizeof(m_kanaBuffer));
+                    std::memset(m_kanjiBuffer, 0, sizeof(m_kanjiBuffer));
                     std::memset(m_translationBuffer, 0, sizeof(m_translationBuffer));
                     std::memset(m_romajiBuffer, 0, sizeof(m_romajiBuffer));
                     std::memset(m_exampleSentenceBuffer, 0, sizeof(m_exampleSentenceBuffer));
@@ -306,6 +325,7 @@ namespace tadaima
                     std::memset(m_mainNameBuffer, 0, sizeof(m_mainNameBuffer));
                     std::memset(m_subNameBuffer, 0, sizeof(m_subNameBuffer));
                     std::memset(m_kanaBuffer, 0, sizeof(m_kanaBuffer));
+                    std::memset(m_kanjiBuffer, 0, sizeof(m_kanjiBuffer));
                     std::memset(m_translationBuffer, 0, sizeof(m_translationBuffer));
                     std::memset(m_romajiBuffer, 0, sizeof(m_romajiBuffer));
                     std::memset(m_exampleSentenceBuffer, 0, sizeof(m_exampleSentenceBuffer));
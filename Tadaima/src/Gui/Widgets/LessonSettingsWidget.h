@@ -53,6 +53,7 @@ namespace tadaima
                 char m_mainNameBuffer[50] = ""; ///< Buffer for the lesson main name.
                 char m_subNameBuffer[50] = "";  ///< Buffer for the lesson sub name.
                 char m_kanaBuffer[50] = ""; ///< Buffer for word kana.
+                char m_kanjiBuffer[50] = ""; ///< Buffer for word kanji.
                 char m_translationBuffer[50] = ""; ///< Buffer for word translation.
                 char m_romajiBuffer[50] = ""; ///< Buffer for word romaji.
                 char m_exampleSentenceBuffer[100] = ""; ///< Buffer for example sentence.
@@ -3,9 +3,16 @@
 #include "imgui.h"
 #include <map>
 #include <unordered_set>
+#include <algorithm>
+#include <iterator>
 #include "ImGuiFileDialog.h"
-#include "Tools/pugixml.hpp"
+#include "lessons/LessonSerializer.h"
 #include "Tools/Logger.h"
+#include "packages/DeckDataPackage.h"
+#include "lessons/DeckPack.h"
+#include "lessons/AnkiExporter.h"
+#include "FrameArena.h"
+#include "packages/CommitResultDataPackage.h"
 
 namespace tadaima
 {
@@ -17,6 +24,10 @@ namespace tadaima
             LessonTreeViewWidget::LessonTreeViewWidget(tools::Logger& logger)
                 : Widget(Type::LessonTreeView), m_lessonSettingsWidget(logger), m_logger(logger)
             {
+                if( m_kanjiIndex.loadRadicals(KanjiIndex::RADICAL_TABLE_PATH) )
+                {
+                    m_logger.log("Radical table loaded.");
+                }
                 m_logger.log("LessonTreeViewWidget created.");
             }
 
@@ -26,9 +37,9 @@ namespace tadaima
                 const LessonDataPackage* package = dynamic_cast<const LessonDataPackage*>(&r_package);
                 if( package )
                 {
+                    std::vector<Lesson> allLessons = package->isChange() ? mergeChangedLessons(*package) : package->decode();
                     m_cashedLessons.clear();
                     std::map<std::string, LessonGroup> lessonMap;
-                    auto allLessons = package->decode();
 
                     for( const auto& lesson : allLessons )
                     {
@@ -40,12 +51,75 @@ namespace tadaima
                     {
                         m_cashedLessons.push_back(pair.second);
                     }
+
+                    m_kanjiIndex.build(allLessons);
+                    updateKanjiSearch();
+
+                    // Refreshes only reindex the edited words, a full build is needed once
+                    if( m_textIndexBuilt )
+                    {
+                        m_textIndex.update(allLessons);
+                    }
+                    else
+                    {
+                        m_textIndex.build(allLessons);
+                        m_textIndexBuilt = true;
+                    }
+                    updateTextFilter();
+                    updateSearchResults();
+
+                    m_leechWords.clear();
+                    for( const auto& lesson : allLessons )
+                    {
+                        for( const auto& word : lesson.words )
+                        {
+                            if( std::find(word.tags.begin(), word.tags.end(), review::LeechDetector::LEECH_TAG) != word.tags.end() )
+                            {
+                                m_leechWords.insert(word.id);
+                            }
+                        }
+                    }
+                }
+
+                const CommitResultDataPackage* results = dynamic_cast<const CommitResultDataPackage*>(&r_package);
+                if( results )
+                {
+                    // Failures stay listed until dismissed, a later successful batch does not hide them
+                    for( const auto& result : results->decode() )
+                    {
+                        if( !result.success )
+                        {
+                            m_failedChanges.push_back(result.name);
+                        }
+                    }
                 }
 
                 m_lessonSettingsWidget.initialize(r_package);
                 m_logger.log("LessonTreeViewWidget initialized.");
             }
 
+            std::vector<Lesson> LessonTreeViewWidget::mergeChangedLessons(const LessonDataPackage& package) const
+            {
+                const std::vector<int> changedIds = package.decodeChangedLessonIds();
+                std::vector<Lesson> lessons = package.decode();
+
+                // Lessons missing from the package were deleted, the others replace their cached copy
+                for( const auto& group : m_cashedLessons )
+                {
+                    for( const auto& lesson : group.subLessons )
+                    {
+                        if( std::find(changedIds.begin(), changedIds.end(), lesson.id) == changedIds.end() )
+                        {
+                            lessons.push_back(lesson);
+                        }
+                    }
+                }
+
+                // Keeps the order of a full load, which reads the lessons by ID
+                std::sort(lessons.begin(), lessons.end(), [](const Lesson& lhs, const Lesson& rhs) { return lhs.id < rhs.id; });
+                return lessons;
+            }
+
             Lesson LessonTreeViewWidget::copyWordsToNewLesson(const std::unordered_set<int>& wordIds)
             {
                 m_logger.log("Copying words to a new lesson.");
@@ -92,10 +166,13 @@ namespace tadaima
                         WordDataPackage wordPackage(word.id);
                         wordPackage.set(LessonWordDataKey::id, word.id);
                         wordPackage.set(LessonWordDataKey::Kana, word.kana);
+                        wordPackage.set(LessonWordDataKey::Kanji, word.kanji);
                         wordPackage.set(LessonWordDataKey::Translation, word.translation);
                         wordPackage.set(LessonWordDataKey::Romaji, word.romaji);
                         wordPackage.set(LessonWordDataKey::ExampleSentence, word.exampleSentence);
                         wordPackage.set(LessonWordDataKey::Tags, word.tags);
+                        wordPackage.set(LessonWordDataKey::ClozeStart, word.clozeStart);
+                        wordPackage.set(LessonWordDataKey::ClozeLength, word.clozeLength);
                         wordPackages.push_back(wordPackage);
                     }
 
@@ -124,10 +201,13 @@ namespace tadaima
                     WordDataPackage wordPackage(word.id);
                     wordPackage.set(LessonWordDataKey::id, word.id);
                     wordPackage.set(LessonWordDataKey::Kana, word.kana);
+                    wordPackage.set(LessonWordDataKey::Kanji, word.kanji);
                     wordPackage.set(LessonWordDataKey::Translation, word.translation);
                     wordPackage.set(LessonWordDataKey::Romaji, word.romaji);
                     wordPackage.set(LessonWordDataKey::ExampleSentence, word.exampleSentence);
                     wordPackage.set(LessonWordDataKey::Tags, word.tags);
+                    wordPackage.set(LessonWordDataKey::ClozeStart, word.clozeStart);
+                    wordPackage.set(LessonWordDataKey::ClozeLength, word.clozeLength);
                     wordPackages.push_back(wordPackage);
                 }
 
@@ -208,7 +288,7 @@ namespace tadaima
                     m_logger.log("Import button clicked.");
                     IGFD::FileDialogConfig config;
                     ImGui::SetNextWindowSize(ImVec2(500, 400), ImGuiCond_Always);
-                    ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey", "Choose File", ".xml", config);
+                    ImGuiFileDialog::Instance()->OpenDialog("ChooseFileDlgKey", "Choose File", ".xml,.csv,.tdeck", config);
                 }
 
                 if( ImGuiFileDialog::Instance()->Display("ChooseFileDlgKey") )
@@ -217,10 +297,19 @@ namespace tadaima
                     {
                         std::string filePath = ImGuiFileDialog::Instance()->GetFilePathName();
                         m_logger.log("File selected: " + filePath);
-                        auto lessons = parseLessons(filePath);
-                        auto package = createLessonDataPackageFromLessons(lessons);
-                        emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnLessonCreated, &package));
-                        m_logger.log("New lesson imported.");
+                        if( filePath.ends_with(DeckPack::FILE_EXTENSION) )
+                        {
+                            DeckDataPackage package(filePath);
+                            emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnDeckImport, &package));
+                            m_logger.log("Deck pack import requested.");
+                        }
+                        else
+                        {
+                            auto lessons = parseLessons(filePath);
+                            auto package = createLessonDataPackageFromLessons(lessons);
+                            emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnLessonCreated, &package));
+                            m_logger.log("New lesson imported.");
+                        }
                     }
                     ImGuiFileDialog::Instance()->Close();
                 }
@@ -230,6 +319,280 @@ namespace tadaima
                 ImGui::PopStyleVar();
             }
 
+            void LessonTreeViewWidget::drawKanjiSearch()
+            {
+                ImGui::SetNextItemWidth(160.0f);
+                bool changed = ImGui::InputTextWithHint("##KanjiSearch", m_searchByRadicals ? "Radicals" : "Kanji", m_kanjiSearchBuffer, sizeof(m_kanjiSearchBuffer));
+
+                if( m_kanjiIndex.hasRadicals() )
+                {
+                    ImGui::SameLine();
+                    changed |= ImGui::Checkbox("Radicals", &m_searchByRadicals);
+                }
+
+                if( changed )
+                {
+                    updateKanjiSearch();
+                    updateSearchResults();
+                }
+            }
+
+            void LessonTreeViewWidget::drawTextFilter()
+            {
+                ImGui::SameLine();
+                ImGui::SetNextItemWidth(200.0f);
+                // Filtering on every keystroke stays cheap because the index answers without scanning the words
+                if( ImGui::InputTextWithHint("##TextFilter", "Filter", m_textFilterBuffer, sizeof(m_textFilterBuffer)) )
+                {
+                    updateTextFilter();
+                    updateSearchResults();
+                }
+
+                if( m_searchActive )
+                {
+                    ImGui::SameLine();
+                    ImGui::Text("%zu words", m_searchResults.size());
+                }
+            }
+
+            void LessonTreeViewWidget::updateKanjiSearch()
+            {
+                const std::string_view query(m_kanjiSearchBuffer);
+                m_kanjiSearchResults = m_searchByRadicals ? m_kanjiIndex.findWordsByRadicals(query) : m_kanjiIndex.findWords(query);
+                std::sort(m_kanjiSearchResults.begin(), m_kanjiSearchResults.end());
+            }
+
+            void LessonTreeViewWidget::updateTextFilter()
+            {
+                m_textFilterResults = m_textIndex.find(m_textFilterBuffer);
+            }
+
+            void LessonTreeViewWidget::updateSearchResults()
+            {
+                const bool kanjiActive = m_kanjiSearchBuffer[0] != '\0';
+                const bool textActive = m_textFilterBuffer[0] != '\0';
+                m_searchActive = kanjiActive || textActive;
+
+                m_searchResults.clear();
+                if( kanjiActive && textActive )
+                {
+                    std::set_intersection(m_kanjiSearchResults.begin(), m_kanjiSearchResults.end(), m_textFilterResults.begin(), m_textFilterResults.end(), std::back_inserter(m_searchResults));
+                }
+                else if( m_searchActive )
+                {
+                    m_searchResults = kanjiActive ? m_kanjiSearchResults : m_textFilterResults;
+                }
+
+                // Resolved once per change, so drawing the tree only looks up lesson IDs
+                m_searchLessons.clear();
+                for( const auto& lessonGroup : m_cashedLessons )
+                {
+                    for( const auto& lesson : lessonGroup.subLessons )
+                    {
+                        if( std::any_of(lesson.words.begin(), lesson.words.end(), [this](const Word& word) { return isWordShown(word.id); }) )
+                        {
+                            m_searchLessons.insert(lesson.id);
+                        }
+                    }
+                }
+                m_searchChanged = m_searchActive;
+            }
+
+            bool LessonTreeViewWidget::matchesSearch(const Lesson& lesson) const
+            {
+                return !m_searchActive || m_searchLessons.contains(lesson.id);
+            }
+
+            bool LessonTreeViewWidget::isWordShown(int wordId) const
+            {
+                return !m_searchActive || std::binary_search(m_searchResults.begin(), m_searchResults.end(), wordId);
+            }
+
+            void LessonTreeViewWidget::drawFailedChanges()
+            {
+                if( m_failedChanges.empty() )
+                {
+                    return;
+                }
+
+                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.3f, 0.3f, 1.0f));
+                for( const auto& name : m_failedChanges )
+                {
+                    ImGui::TextWrapped(ICON_FA_EXCLAMATION_CIRCLE " Not saved: %s", name.c_str());
+                }
+                ImGui::PopStyleColor();
+
+                if( ImGui::SmallButton(ICON_FA_TIMES " Dismiss###DismissFailedChanges") )
+                {
+                    m_failedChanges.clear();
+                }
+            }
+
+            void LessonTreeViewWidget::drawLeeches()
+            {
+                if( m_leechWords.empty() )
+                {
+                    return;
+                }
+
+                ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.6f, 0.0f, 1.0f));
+                const bool open = ImGui::TreeNodeEx(frameFormat(ICON_FA_EXCLAMATION_TRIANGLE " Leeches ({})###Leeches", m_leechWords.size()), ImGuiTreeNodeFlags_SpanAvailWidth);
+                ImGui::PopStyleColor();
+
+                if( ImGui::IsItemClicked(1) )
+                {
+                    ImGui::OpenPopup("LeechesContextMenu");
+                }
+
+                if( ImGui::BeginPopup("LeechesContextMenu") )
+                {
+                    if( ImGui::BeginMenu(ICON_FA_PLAY "Play") )
+                    {
+                        // The lesson is only copied once a quiz is picked, not on every frame the menu is open
+                        auto createLeechesPackage = [this]()
+                        {
+                            Lesson leeches = copyWordsToNewLesson(m_leechWords);
+                            leeches.mainName = "Leeches";
+                            leeches.subName = "Leeches";
+                            return createLessonDataPackageFromLesson(leeches);
+                        };
+
+                        if( ImGui::MenuItem("vocabulary quiz") )
+                        {
+                            auto package = createLeechesPackage();
+                            emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnPlayVocabularyQuiz, &package));
+                        }
+
+                        if( ImGui::MenuItem("multiple choice quiz") )
+                        {
+                            auto package = createLeechesPackage();
+                            emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnPlayMultipleChoiceQuiz, &package));
+                        }
+
+                        if( ImGui::MenuItem("cloze quiz") )
+                        {
+                            auto package = createLeechesPackage();
+                            emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnPlayClozeQuiz, &package));
+                        }
+
+                        ImGui::EndMenu();
+                    }
+
+                    if( ImGui::MenuItem(ICON_FA_TIMES " Clear all leech tags") )
+                    {
+                        clearLeechTags(m_leechWords);
+                    }
+
+                    ImGui::EndPopup();
+                }
+
+                if( !open )
+                {
+                    return;
+                }
+
+                std::unordered_set<int> clearedWords;
+                for( const auto& lessonGroup : m_cashedLessons )
+                {
+                    for( const auto& lesson : lessonGroup.subLessons )
+                    {
+                        for( const auto& word : lesson.words )
+                        {
+                            if( !m_leechWords.contains(word.id) )
+                            {
+                                continue;
+                            }
+
+                            ImGui::PushID(word.id);
+                            const std::string& lessonName = lesson.subName.empty() ? lesson.mainName : lesson.subName;
+                            if( word.kanji.empty() )
+                            {
+                                ImGui::Text(" %s - %s [%s]", word.translation.c_str(), word.kana.c_str(), lessonName.c_str());
+                            }
+                            else
+                            {
+                                ImGui::Text(" %s - %s (%s) [%s]", word.translation.c_str(), word.kanji.c_str(), word.kana.c_str(), lessonName.c_str());
+                            }
+
+                            if( ImGui::IsItemClicked(1) )
+                            {
+                                ImGui::OpenPopup("LeechContextMenu");
+                            }
+
+                            if( ImGui::BeginPopup("LeechContextMenu") )
+                            {
+                                if( ImGui::MenuItem(ICON_FA_TIMES " Clear leech tag") )
+                                {
+                                    clearedWords.insert(word.id);
+                                }
+                                ImGui::EndPopup();
+                            }
+                            ImGui::PopID();
+                        }
+                    }
+                }
+                ImGui::TreePop();
+
+                if( !clearedWords.empty() )
+                {
+                    clearLeechTags(clearedWords);
+                }
+            }
+
+            void LessonTreeViewWidget::clearLeechTags(std::unordered_set<int> wordIds)
+            {
+                m_logger.log("Clearing leech tag of " + std::to_string(wordIds.size()) + " words.");
+
+                std::unordered_set<int> affectedLessonIDs;
+                for( auto& lessonGroup : m_cashedLessons )
+                {
+                    for( auto& lesson : lessonGroup.subLessons )
+                    {
+                        for( auto& word : lesson.words )
+                        {
+                            if( !wordIds.contains(word.id) )
+                            {
+                                continue;
+                            }
+
+                            auto it = std::remove(word.tags.begin(), word.tags.end(), review::LeechDetector::LEECH_TAG);
+                            if( it != word.tags.end() )
+                            {
+                                word.tags.erase(it, word.tags.end());
+                                affectedLessonIDs.insert(lesson.id);
+                            }
+                            m_leechWords.erase(word.id);
+                        }
+                    }
+                }
+
+                if( !affectedLessonIDs.empty() )
+                {
+                    WordOperation operation;
+                    operation.type = WordOperation::Type::Retag;
+                    operation.wordIds.assign(wordIds.begin(), wordIds.end());
+                    operation.removedTags.push_back(review::LeechDetector::LEECH_TAG);
+                    WordOperationDataPackage package(operation);
+                    emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnWordsChanged, &package));
+                }
+            }
+
+            void LessonTreeViewWidget::removeCachedWords(const std::unordered_set<int>& wordIds)
+            {
+                for( auto& lessonGroup : m_cashedLessons )
+                {
+                    for( auto& lesson : lessonGroup.subLessons )
+                    {
+                        std::erase_if(lesson.words, [&wordIds](const Word& word) { return wordIds.contains(word.id); });
+                    }
+                }
+
+                for( const int wordId : wordIds )
+                {
+                    m_textIndex.removeWord(wordId);
+                }
+            }
+
             void LessonTreeViewWidget::drawLessonsTree(std::unordered_set<int>& markedWords, std::unordered_set<int>& lessonsToExport, bool& open_edit_lesson, Lesson& selectedLesson, Lesson& originalLesson, bool& renamePopupOpen, bool& deleteLesson, bool& createNewLessonPopupOpen)
             {
                 const bool ctrlPressed = ImGui::GetIO().KeyCtrl;
@@ -242,13 +605,28 @@ namespace tadaima
                 for( size_t groupIndex = 0; groupIndex < m_cashedLessons.size(); groupIndex++ )
                 {
                     auto& lessonGroup = m_cashedLessons[groupIndex];
+                    if( m_searchActive && std::none_of(lessonGroup.subLessons.begin(), lessonGroup.subLessons.end(), [this](const Lesson& lesson) { return matchesSearch(lesson); }) )
+                    {
+                        continue;
+                    }
+
                     ImGui::PushID(static_cast<int>(groupIndex));
 
+                    if( m_searchChanged )
+                    {
+                        ImGui::SetNextItemOpen(true);
+                    }
+
                     if( ImGui::TreeNode(lessonGroup.mainName.c_str()) )
                     {
                         for( size_t lessonIndex = 0; lessonIndex < lessonGroup.subLessons.size(); lessonIndex++ )
                         {
                             auto& lesson = lessonGroup.subLessons[lessonIndex];
+                            if( !matchesSearch(lesson) )
+                            {
+                                continue;
+                            }
+
                             ImGui::PushID(static_cast<int>(lessonIndex));
                             bool isSelected = m_selectedLessons.find(lesson.id) != m_selectedLessons.end();
 
@@ -257,11 +635,21 @@ namespace tadaima
                                 ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.0f, 1.0f, 0.0f, 1.0f));
                             }
 
+                            if( m_searchChanged )
+                            {
+                                ImGui::SetNextItemOpen(true);
+                            }
+
                             if( ImGui::TreeNodeEx(lesson.subName.empty() ? lesson.mainName.c_str() : lesson.subName.c_str(), ImGuiTreeNodeFlags_SpanAvailWidth | (isSelected ? ImGuiTreeNodeFlags_Selected : 0)) )
                             {
                                 for( size_t wordIndex = 0; wordIndex < lesson.words.size(); wordIndex++ )
                                 {
                                     const auto& word = lesson.words[wordIndex];
+                                    if( !isWordShown(word.id) )
+                                    {
+                                        continue;
+                                    }
+
                                     ImGui::PushID(static_cast<int>(wordIndex));
 
                                     // Check if the word is marked
@@ -271,7 +659,14 @@ namespace tadaima
                                         ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(1.0f, 0.0f, 0.0f, 1.0f)); // Marked words in red
                                     }
 
-                                    ImGui::Text(" %s - %s", word.translation.c_str(), word.kana.c_str());
+                                    if( word.kanji.empty() )
+                                    {
+                                        ImGui::Text(" %s - %s", word.translation.c_str(), word.kana.c_str());
+                                    }
+                                    else
+                                    {
+                                        ImGui::Text(" %s - %s (%s)", word.translation.c_str(), word.kanji.c_str(), word.kana.c_str());
+                                    }
 
                                     // Mark the word if control or shift is pressed and clicked
                                     if( ImGui::IsItemClicked(0) )
@@ -339,52 +734,50 @@ namespace tadaima
                                     {
                                         if( ImGui::BeginMenu(ICON_FA_PLAY "PlayMixedVocabulary") )
                                         {
-                                            auto package = createLessonDataPackageFromLesson(copyWordsToNewLesson(markedWords));
                                             if( ImGui::MenuItem("vocabulary quiz") )
                                             {
+                                                auto package = createLessonDataPackageFromLesson(copyWordsToNewLesson(markedWords));
                                                 emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnPlayVocabularyQuiz, &package));
                                             }
 
                                             if( ImGui::MenuItem("multiple choice quiz") )
                                             {
+                                                auto package = createLessonDataPackageFromLesson(copyWordsToNewLesson(markedWords));
                                                 emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnPlayMultipleChoiceQuiz, &package));
                                             }
 
+                                            if( ImGui::MenuItem("cloze quiz") )
+                                            {
+                                                auto package = createLessonDataPackageFromLesson(copyWordsToNewLesson(markedWords));
+                                                emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnPlayClozeQuiz, &package));
+                                            }
+
                                             ImGui::EndMenu();
                                         }
 
                                         if( ImGui::MenuItem("Move Marked Words to New Lesson") )
                                         {
+                                            m_copyMarkedWords = false;
                                             createNewLessonPopupOpen = true;
                                             ImGui::CloseCurrentPopup();
                                         }
 
-                                        if( ImGui::MenuItem("Delete Marked Words") )
+                                        if( ImGui::MenuItem("Copy Marked Words to New Lesson") )
                                         {
-                                            std::unordered_set<int> affectedLessonIDs;
-                                            // Remove marked words from all lessons
-                                            for( auto& lessonGroupToDelete : m_cashedLessons )
-                                            {
-                                                for( auto& lessonToDelete : lessonGroupToDelete.subLessons )
-                                                {
-                                                    for( int wordID : markedWords )
-                                                    {
-                                                        auto it = std::remove_if(lessonToDelete.words.begin(), lessonToDelete.words.end(), [wordID](const Word& word)
-                                                            {
-                                                                return word.id == wordID;
-                                                            });
-                                                        if( it != lessonToDelete.words.end() )
-                                                        {
-                                                            affectedLessonIDs.insert(lessonToDelete.id);
-                                                            lessonToDelete.words.erase(it, lessonToDelete.words.end());
-                                                        }
-                                                    }
-                                                }
-                                            }
+                                            m_copyMarkedWords = true;
+                                            createNewLessonPopupOpen = true;
+                                            ImGui::CloseCurrentPopup();
+                                        }
 
-                                            auto package = createLessonDataPackageFromSelectedNodes(affectedLessonIDs);
-                                            emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnLessonEdited, &package));
+                                        if( ImGui::MenuItem("Delete Marked Words") )
+                                        {
+                                            WordOperation operation;
+                                            operation.type = WordOperation::Type::Delete;
+                                            operation.wordIds.assign(markedWords.begin(), markedWords.end());
+                                            WordOperationDataPackage package(operation);
+                                            emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnWordsChanged, &package));
 
+                                            removeCachedWords(markedWords);
                                             markedWords.clear();
                                             ImGui::CloseCurrentPopup();
                                         }
@@ -429,6 +822,14 @@ namespace tadaima
                                         emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnPlayMultipleChoiceQuiz, &package));
                                     }
 
+                                    if( ImGui::MenuItem("cloze quiz") )
+                                    {
+                                        auto package = (m_selectedLessons.size() > 0) ?
+                                            createLessonDataPackageFromSelectedNodes(m_selectedLessons) :
+                                            createLessonDataPackageFromLesson(lesson);
+                                        emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnPlayClozeQuiz, &package));
+                                    }
+
                                     ImGui::EndMenu();
                                 }
 
@@ -472,7 +873,7 @@ namespace tadaima
                                     ImGui::CloseCurrentPopup();
                                     IGFD::FileDialogConfig config;
                                     ImGui::SetNextWindowSize(ImVec2(500, 400), ImGuiCond_Always);
-                                    ImGuiFileDialog::Instance()->OpenDialog("SaveFileDlgKey", "Save File", ".xml", config);
+                                    ImGuiFileDialog::Instance()->OpenDialog("SaveFileDlgKey", "Save File", ".xml,.csv,.tdeck,.apkg", config);
                                 }
 
                                 ImGui::EndPopup();
@@ -525,6 +926,21 @@ namespace tadaima
                            // break;
                         }
 
+                        if( rightClickedLessonGroupId >= 0 && ImGui::MenuItem(ICON_FA_ARCHIVE " Export Deck Pack") )
+                        {
+                            m_logger.log("Export lesson group as deck pack selected.");
+                            lessonsToExport.clear();
+                            for( auto& lesson : m_cashedLessons[rightClickedLessonGroupId].subLessons )
+                            {
+                                lessonsToExport.insert(lesson.id);
+                            }
+                            rightClickedLessonGroupId = -1;
+                            ImGui::CloseCurrentPopup();
+                            IGFD::FileDialogConfig config;
+                            ImGui::SetNextWindowSize(ImVec2(500, 400), ImGuiCond_Always);
+                            ImGuiFileDialog::Instance()->OpenDialog("SaveFileDlgKey", "Save File", ".tdeck,.apkg", config);
+                        }
+
                         ImGui::EndPopup();
                     }
 
@@ -534,6 +950,8 @@ namespace tadaima
                 {
                     m_selectedLessons.clear();
                 }
+
+                m_searchChanged = false;
             }
 
             void LessonTreeViewWidget::handleExportLessons(std::unordered_set<int> lessonsToExport)
@@ -544,7 +962,17 @@ namespace tadaima
                     {
                         std::string filePath = ImGuiFileDialog::Instance()->GetFilePathName();
                         m_logger.log("Save file selected: " + filePath);
-                        parseAndExportLessons(filePath, lessonsToExport);
+                        if( (filePath.ends_with(DeckPack::FILE_EXTENSION) || filePath.ends_with(AnkiExporter::FILE_EXTENSION)) && !lessonsToExport.empty() )
+                        {
+                            DeckDataPackage package(filePath);
+                            package.set(DeckPackageKey::Name, findLessonWithId(*lessonsToExport.begin()).mainName);
+                            package.set(DeckPackageKey::LessonIds, std::vector<int>(lessonsToExport.begin(), lessonsToExport.end()));
+                            emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnDeckExport, &package));
+                        }
+                        else
+                        {
+                            parseAndExportLessons(filePath, lessonsToExport);
+                        }
                     }
                     ImGuiFileDialog::Instance()->Close();
                 }
@@ -616,133 +1044,32 @@ namespace tadaima
 
                     if( ImGui::Button("Create") )
                     {
-                        std::string mainName(newLessonMainNameBuffer);
-                        std::string subName(newLessonSubNameBuffer);
-                        Lesson* existingLesson = nullptr;
-
-                        std::vector<Lesson> toEdit;
-
-                        // Check if a lesson with the same name and subname already exists
-                        for( auto& lessonGroup : m_cashedLessons )
-                        {
-                            for( auto& lesson : lessonGroup.subLessons )
-                            {
-                                if( lesson.mainName == mainName && lesson.subName == subName )
-                                {
-                                    existingLesson = &lesson;
-                                    break;
-                                }
-                            }
-                            if( existingLesson )
-                                break;
-                        }
-
-                        if( !existingLesson )
+                        WordOperation operation;
+                        operation.type = m_copyMarkedWords ? WordOperation::Type::Copy : WordOperation::Type::Move;
+                        operation.wordIds.assign(markedWords.begin(), markedWords.end());
+                        operation.target.mainName = newLessonMainNameBuffer;
+                        operation.target.subName = newLessonSubNameBuffer;
+
+                        // Words go to an existing lesson with the same names, otherwise the lesson is created
+                        for( const auto& lessonGroup : m_cashedLessons )
                         {
-                            // Create a new lesson if it doesn't exist
-                            Lesson newLesson;
-                            newLesson.mainName = mainName;
-                            newLesson.subName = subName;
-
-                            for( auto& lessonGroup : m_cashedLessons )
+                            for( const auto& lesson : lessonGroup.subLessons )
                             {
-                                for( auto& lesson : lessonGroup.subLessons )
+                                if( lesson.mainName == operation.target.mainName && lesson.subName == operation.target.subName )
                                 {
-                                    // Find marked words in the current lesson
-                                    for( int wordID : markedWords )
-                                    {
-                                        auto it = std::find_if(lesson.words.begin(), lesson.words.end(), [wordID](const Word& word)
-                                            {
-                                                return word.id == wordID;
-                                            });
-                                        if( it != lesson.words.end() )
-                                        {
-                                            // Check if the word already exists in the new lesson based on content
-                                            auto existingWordIt = std::find_if(newLesson.words.begin(), newLesson.words.end(), [it](const Word& word)
-                                                {
-                                                    return *it == word; // Using operator== to compare content
-                                                });
-                                            if( existingWordIt == newLesson.words.end() )
-                                            {
-                                                newLesson.words.push_back(*it);
-                                                newLesson.words.back().id = 0;
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-
-                            toEdit.push_back(newLesson);
-
-                        }
-                        else
-                        {
-                            // Add or overwrite words in the existing lesson
-                            for( auto& lessonGroup : m_cashedLessons )
-                            {
-                                for( auto& lesson : lessonGroup.subLessons )
-                                {
-                                    // Find marked words in the current lesson
-                                    for( int wordID : markedWords )
-                                    {
-                                        auto it = std::find_if(lesson.words.begin(), lesson.words.end(), [wordID](const Word& word)
-                                            {
-                                                return word.id == wordID;
-                                            });
-                                        if( it != lesson.words.end() )
-                                        {
-                                            // Check if word already exists in the existing lesson based on content
-                                            auto existingWordIt = std::find_if(existingLesson->words.begin(), existingLesson->words.end(), [it](const Word& word)
-                                                {
-                                                    return *it == word; // Using operator== to compare content
-                                                });
-                                            if( existingWordIt != existingLesson->words.end() )
-                                            {
-                                                *existingWordIt = *it; // Overwrite the word
-                                            }
-                                            else
-                                            {
-                                                existingLesson->words.push_back(*it); // Add new word
-                                                existingLesson->words.back().id = 0;
-                                            }
-                                        }
-                                    }
+                                    operation.target.id = lesson.id;
                                 }
                             }
-
-                            toEdit.push_back(*existingLesson);
                         }
 
-                        std::unordered_set<int> affectedLessonIDs;
+                        WordOperationDataPackage package(operation);
+                        emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnWordsChanged, &package));
 
-                        // Remove marked words from all lessons
-                        for( auto& lessonGroupToDelete : m_cashedLessons )
+                        if( !m_copyMarkedWords )
                         {
-                            for( auto& lessonToDelete : lessonGroupToDelete.subLessons )
-                            {
-                                for( int wordID : markedWords )
-                                {
-                                    auto it = std::remove_if(lessonToDelete.words.begin(), lessonToDelete.words.end(), [wordID](const Word& word)
-                                        {
-                                            return word.id == wordID;
-                                        });
-                                    if( it != lessonToDelete.words.end() )
-                                    {
-                                        affectedLessonIDs.insert(lessonToDelete.id);
-                                        lessonToDelete.words.erase(it, lessonToDelete.words.end());
-                                    }
-                                }
-                            }
-                        }
-
-                        for( auto id : affectedLessonIDs )
-                        {
-                            toEdit.push_back(findLessonWithId(id));
+                            removeCachedWords(markedWords);
                         }
 
-                        auto package = createLessonDataPackageFromLessons(toEdit);
-                        emitEvent(WidgetEvent(*this, LessonTreeViewWidgetEvent::OnLessonEdited, &package));
-
                         memset(newLessonSubNameBuffer, 0, sizeof(newLessonSubNameBuffer));
                         ImGui::CloseCurrentPopup();
 
@@ -782,6 +1109,10 @@ namespace tadaima
                     Handle top layer of the tree view. Buttons.
                 */
                 drawTopButtons();
+                drawKanjiSearch();
+                drawTextFilter();
+                drawFailedChanges();
+                drawLeeches();
 
                 /*
                     Draw lessons tree and mark all events that can occur on it.
@@ -821,44 +1152,11 @@ namespace tadaima
             std::vector<Lesson> LessonTreeViewWidget::parseLessons(const std::string& filePath)
             {
                 m_logger.log("Parsing and importing lessons from file: " + filePath);
-                pugi::xml_document doc;
-                pugi::xml_parse_result result = doc.load_file(filePath.c_str());
                 std::vector<Lesson> parsedLessons;
-
-                if( !result )
+                if( !LessonSerializer::read(filePath, parsedLessons) )
                 {
-                    m_logger.log("Error: Could not load XML file!");
-                    return parsedLessons;
-                }
-
-                std::unordered_set<std::string> uniqueLessons; // To track unique lessons
-
-                for( pugi::xml_node lessonNode : doc.child("lessons").children("lesson") )
-                {
-                    std::string lessonName = lessonNode.attribute("name").as_string();
-
-                    for( pugi::xml_node subnameNode : lessonNode.children("subname") )
-                    {
-                        Lesson lesson;
-                        lesson.mainName = lessonName;
-                        lesson.subName = subnameNode.attribute("name").as_string();
-                        std::string uniqueKey = lesson.mainName + ":" + lesson.subName;
-
-                        if( uniqueLessons.find(uniqueKey) == uniqueLessons.end() )
-                        {
-                            for( pugi::xml_node wordNode : subnameNode.children("word") )
-                            {
-                                Word word;
-                                word.translation = wordNode.attribute("translation").as_string();
-                                word.romaji = wordNode.attribute("romaji").as_string();
-                                word.kana = wordNode.attribute("kana").as_string();
-                                lesson.words.push_back(word);
-                            }
-
-                            parsedLessons.push_back(lesson);
-                            uniqueLessons.insert(uniqueKey);
-                        }
-                    }
+                    m_logger.log("Error: Could not load lessons file!");
+                    return {};
                 }
 
                 m_logger.log("Lessons imported from file.");
@@ -869,9 +1167,6 @@ namespace tadaima
             {
                 m_logger.log("Parsing and exporting lessons to file: " + filePath);
 
-                pugi::xml_document doc;
-                pugi::xml_node root = doc.append_child("lessons");
-
                 std::unordered_map<int, Lesson> lessonMap;
 
                 for( const auto& lessonGroup : m_cashedLessons )
@@ -882,31 +1177,19 @@ namespace tadaima
                     }
                 }
 
+                std::vector<Lesson> lessons;
                 for( int id : lessonsToExport )
                 {
                     auto it = lessonMap.find(id);
                     if( it != lessonMap.end() )
                     {
-                        const Lesson& lesson = it->second;
-                        pugi::xml_node lessonNode = root.append_child("lesson");
-                        lessonNode.append_attribute("name") = lesson.mainName.c_str();
-
-                        pugi::xml_node subnameNode = lessonNode.append_child("subname");
-                        subnameNode.append_attribute("name") = lesson.subName.c_str();
-
-                        for( const auto& word : lesson.words )
-                        {
-                            pugi::xml_node wordNode = subnameNode.append_child("word");
-                            wordNode.append_attribute("translation") = word.translation.c_str();
-                            wordNode.append_attribute("romaji") = word.romaji.c_str();
-                            wordNode.append_attribute("kana") = word.kana.c_str();
-                        }
+                        lessons.push_back(it->second);
                     }
                 }
 
-                if( !doc.save_file(filePath.c_str()) )
+                if( !LessonSerializer::write(filePath, lessons) )
                 {
-                    m_logger.log("Error: Could not save XML file!");
+                    m_logger.log("Error: Could not save lessons file!");
                 }
                 else
                 {
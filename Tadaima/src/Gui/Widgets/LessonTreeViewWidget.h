@@ -7,8 +7,12 @@
 
 #include "Widget.h"
 #include "lessons/Lesson.h"
+#include "lessons/KanjiIndex.h"
+#include "lessons/TrigramIndex.h"
+#include "review/LeechDetector.h"
 #include "LessonSettingsWidget.h"
 #include "packages/LessonDataPackage.h"
+#include "packages/WordOperationDataPackage.h"
 #include <unordered_set>
 #include <deque>
 #include <map>
@@ -45,7 +49,11 @@ namespace tadaima
                     OnLessonEdited, /**< Event triggered when a lesson is edited. */
                     OnPlayMultipleChoiceQuiz, /**< Event triggered to play a multiple choice quiz. */
                     OnPlayVocabularyQuiz, /**< Event triggered to play a vocabulary quiz. */
-                    OnQuizSelect
+                    OnPlayClozeQuiz, /**< Event triggered to play a cloze quiz. */
+                    OnQuizSelect,
+                    OnDeckImport, /**< Event triggered when a deck pack is imported. */
+                    OnDeckExport, /**< Event triggered when lessons are exported as a deck pack. */
+                    OnWordsChanged /**< Event triggered when marked words are moved, copied, deleted or retagged. */
                 };
 
                 /**
@@ -59,6 +67,26 @@ namespace tadaima
                  */
                 void drawTopButtons();
 
+                /**
+                 * @brief Draws the search field filtering the tree by kanji or radicals.
+                 */
+                void drawKanjiSearch();
+
+                /**
+                 * @brief Draws the filter field narrowing the tree to words whose translation, kana or romaji contain the text.
+                 */
+                void drawTextFilter();
+
+                /**
+                 * @brief Draws the changes rolled back by group commits, until they are dismissed.
+                 */
+                void drawFailedChanges();
+
+                /**
+                 * @brief Draws the node listing the words tagged as leeches.
+                 */
+                void drawLeeches();
+
                 /**
                  * @brief Handles the tree view for marking words.
                  * @param markedWords Set of marked word IDs.
@@ -135,7 +163,7 @@ namespace tadaima
                 void ShowRenamePopup(bool& renamePopupOpen);
 
                 /**
-                 * @brief Handles moving marked words to a new lesson.
+                 * @brief Handles moving or copying marked words to a new or existing lesson.
                  * @param createNewLessonPopupOpen Boolean reference indicating if the create new lesson popup should be open.
                  * @param markedWords Set of marked word IDs.
                  */
@@ -193,6 +221,54 @@ namespace tadaima
                  */
                 void saveRenamedLesson();
 
+                /**
+                 * @brief Looks up the words matching the search field in the kanji index.
+                 */
+                void updateKanjiSearch();
+
+                /**
+                 * @brief Looks up the words matching the filter field in the text index.
+                 */
+                void updateTextFilter();
+
+                /**
+                 * @brief Combines the kanji search and the text filter into the words and lessons shown in the tree.
+                 */
+                void updateSearchResults();
+
+                /**
+                 * @brief Checks if a lesson has words matching the kanji search and the text filter.
+                 * @param lesson The lesson to check.
+                 * @return True if no search is active or the lesson contains a matching word.
+                 */
+                bool matchesSearch(const Lesson& lesson) const;
+
+                /**
+                 * @brief Checks if a word matches the kanji search and the text filter.
+                 * @param wordId ID of the word to check.
+                 * @return True if no search is active or the word matches.
+                 */
+                bool isWordShown(int wordId) const;
+
+                /**
+                 * @brief Removes the leech tag from the given words and saves the affected lessons.
+                 * @param wordIds IDs of the words to clear.
+                 */
+                void clearLeechTags(std::unordered_set<int> wordIds);
+
+                /**
+                 * @brief Removes words from the cached lessons until the tree is refreshed from the database.
+                 * @param wordIds IDs of the words to remove.
+                 */
+                void removeCachedWords(const std::unordered_set<int>& wordIds);
+
+                /**
+                 * @brief Replaces the cached lessons listed in a partial package with the ones it carries.
+                 * @param package Package with the changed lessons; listed lessons it does not carry were deleted.
+                 * @return Every lesson of the library, ordered by ID.
+                 */
+                std::vector<Lesson> mergeChangedLessons(const LessonDataPackage& package) const;
+
                 /**
                  * @brief Finds a lesson by its ID.
                  * @param id The ID of the lesson to find.
@@ -213,6 +289,22 @@ namespace tadaima
                 char renameSubNameBuffer[256] = ""; /**< Buffer for renaming the sub-name. */
                 char newLessonMainNameBuffer[256] = ""; /**< Buffer for the new lesson's main name. */
                 char newLessonSubNameBuffer[256] = ""; /**< Buffer for the new lesson's sub name. */
+                bool m_copyMarkedWords = false; /**< True if the new lesson popup copies the marked words instead of moving them. */
+
+                KanjiIndex m_kanjiIndex; /**< Index of all words by kanji and radicals. */
+                char m_kanjiSearchBuffer[64] = ""; /**< Buffer for the kanji or radicals to search for. */
+                bool m_searchByRadicals = false; /**< True if the search field holds radicals instead of kanji. */
+                std::vector<int> m_kanjiSearchResults; /**< Sorted IDs of the words matching the kanji search. */
+                TrigramIndex m_textIndex; /**< Index of all words by substrings of their translation, kana and romaji. */
+                bool m_textIndexBuilt = false; /**< True once the text index holds the library and only needs updates. */
+                char m_textFilterBuffer[128] = ""; /**< Buffer for the text to filter by. */
+                std::vector<int> m_textFilterResults; /**< Sorted IDs of the words matching the text filter. */
+                bool m_searchActive = false; /**< True if the tree is filtered by the search results. */
+                bool m_searchChanged = false; /**< True if the tree nodes must be expanded to show new results. */
+                std::vector<int> m_searchResults; /**< Sorted IDs of the words matching every active search. */
+                std::unordered_set<int> m_searchLessons; /**< IDs of the lessons with words matching every active search. */
+                std::unordered_set<int> m_leechWords; /**< IDs of the words tagged as leeches. */
+                std::vector<std::string> m_failedChanges; /**< Names of the changes rolled back since the list was last dismissed. */
             };
         }
     }
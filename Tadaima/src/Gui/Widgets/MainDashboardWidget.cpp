@@ -4,6 +4,10 @@
 #include "imgui.h"
 #include "gui.h"
 #include "packages/SettingsDataPackage.h"
+#include "packages/ForecastDataPackage.h"
+#include "packages/ConfusionDataPackage.h"
+#include "FrameArena.h"
+#include <algorithm>
 
 namespace tadaima
 {
@@ -11,6 +15,10 @@ namespace tadaima
     {
         namespace widget
         {
+            MainDashboardWidget::MainDashboardWidget() : Widget(Type::Dashboard)
+            {
+            }
+
             void MainDashboardWidget::initialize(const tools::DataPackage& r_package)
             {
                 const SettingsDataPackage* package = dynamic_cast<const SettingsDataPackage*>(&r_package);
@@ -18,6 +26,22 @@ namespace tadaima
                 {
                     m_username = package->get<std::string>(SettingsPackageKey::Username);
                 }
+
+                const ForecastDataPackage* forecastPackage = dynamic_cast<const ForecastDataPackage*>(&r_package);
+                if( forecastPackage && forecastPackage->hasForecast() )
+                {
+                    auto forecast = forecastPackage->decodeForecast();
+                    m_expectedReviews = forecast.expectedReviews;
+                    m_reviewsLow = forecast.reviewsLow;
+                    m_reviewsHigh = forecast.reviewsHigh;
+                    m_expectedRetention = forecast.expectedRetention;
+                }
+
+                const ConfusionDataPackage* confusionPackage = dynamic_cast<const ConfusionDataPackage*>(&r_package);
+                if( confusionPackage )
+                {
+                    m_confusions = confusionPackage->decodeDescriptions();
+                }
             }
 
             void MainDashboardWidget::draw(bool* p_open)
@@ -29,7 +53,7 @@ namespace tadaima
                 }
 
                 // Header
-                ImGui::Text((const char*)std::format("Ohayou, {}!", m_username).c_str());
+                ImGui::TextUnformatted(frameFormat("Ohayou, {}!", m_username));
                 ImGui::Text((const char*)u8"I am so lucky to see you again here :-)");
                 ImGui::Text((const char*)u8"Let's learn some new words together!");
                 ImGui::ProgressBar(0.65f, ImVec2(-1.0f, 0.0f), "65% complete");
@@ -38,10 +62,13 @@ namespace tadaima
                 ImGui::Separator();
                 ImGui::Text((const char*)u8"Word of the Day: \"茶\" (ちゃ) - Tea");
 
-                // Performance Graphs
+                // Review forecast
                 ImGui::Separator();
-                ImGui::Text("Performance Graphs:");
-                ImGui::Text("Vocab Acquisition [▓▓▓▓▒▒▒] Pronunciation [▓▓▓▒▒▒▒]");
+                drawForecast();
+
+                // Confused words
+                ImGui::Separator();
+                drawConfusions();
 
                 // Cultural Insight
                 ImGui::Separator();
@@ -49,6 +76,60 @@ namespace tadaima
 
                 ImGui::End();
             }
+
+            void MainDashboardWidget::drawConfusions()
+            {
+                ImGui::Text("Most confused words:");
+
+                if( m_confusions.empty() )
+                {
+                    ImGui::TextDisabled("Wrong answers in multiple choice quizzes are listed here.");
+                    return;
+                }
+
+                for( const auto& confusion : m_confusions )
+                {
+                    ImGui::BulletText("%s", confusion.c_str());
+                }
+            }
+
+            void MainDashboardWidget::drawForecast()
+            {
+                ImGui::Text("Review forecast:");
+
+                if( m_expectedReviews.empty() )
+                {
+                    ImGui::TextDisabled("Answer some quizzes to see how many reviews are ahead of you.");
+                }
+                else
+                {
+                    const int days = static_cast<int>(m_expectedReviews.size());
+                    const float maxReviews = *std::max_element(m_reviewsHigh.begin(), m_reviewsHigh.end());
+
+                    ImGui::PlotHistogram("##ForecastReviews", m_expectedReviews.data(), days, 0, "Reviews per day", 0.0f, std::max(1.0f, maxReviews * 1.1f), ImVec2(-1.0f, 80.0f));
+                    ImGui::PlotLines("##ForecastRetention", m_expectedRetention.data(), days, 0, "Retention", 0.0f, 1.0f, ImVec2(-1.0f, 60.0f));
+
+                    ImGui::Text("Today: %.0f reviews (%.0f - %.0f)", m_expectedReviews.front(), m_reviewsLow.front(), m_reviewsHigh.front());
+                    ImGui::Text("Expected retention after %d days: %.1f%%", days, m_expectedRetention.back() * 100.0f);
+                }
+
+                ImGui::SliderInt("Days", &m_forecastDays, 7, 365);
+                ImGui::InputInt("New words", &m_newWords, 50);
+                ImGui::InputInt("New words per day", &m_newWordsPerDay, 5);
+                m_newWords = std::max(0, m_newWords);
+                m_newWordsPerDay = std::max(1, m_newWordsPerDay);
+
+                if( ImGui::Button("Forecast") )
+                {
+                    review::ForecastOptions options;
+                    options.days = m_forecastDays;
+                    options.newWords = m_newWords;
+                    options.newWordsPerDay = m_newWordsPerDay;
+
+                    ForecastDataPackage package(options);
+                    emitEvent(WidgetEvent(*this, MainDashboardWidgetEvent::OnForecastRequested, &package));
+                }
+            }
         }
     }
 }
\ No newline at end of file
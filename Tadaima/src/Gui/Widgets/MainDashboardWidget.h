@@ -5,6 +5,8 @@
 #pragma once
 
 #include "Widget.h"
+#include <string>
+#include <vector>
 
 namespace tadaima
 {
@@ -18,6 +20,20 @@ namespace tadaima
             class MainDashboardWidget : public Widget
             {
             public:
+
+                /**
+                 * @brief Enum representing events emitted by the MainDashboardWidget.
+                 */
+                enum MainDashboardWidgetEvent : uint8_t
+                {
+                    OnForecastRequested     /**< Event emitted when the user asks for a new review forecast. */
+                };
+
+                /**
+                 * @brief Constructs a MainDashboardWidget object.
+                 */
+                MainDashboardWidget();
+
                 /**
                  * @brief Initializes the main dashboard widget.
                  *
@@ -33,7 +49,26 @@ namespace tadaima
                 void draw(bool* p_open) override;
 
             private:
+
+                /**
+                 * @brief Draws the review forecast section.
+                 */
+                void drawForecast();
+
+                /**
+                 * @brief Draws the words the learner mixes up most often.
+                 */
+                void drawConfusions();
+
                 std::string m_username = "Gakusei-dono";
+                std::vector<float> m_expectedReviews; ///< Mean number of reviews per forecast day.
+                std::vector<float> m_reviewsLow; ///< Low percentile of reviews per forecast day.
+                std::vector<float> m_reviewsHigh; ///< High percentile of reviews per forecast day.
+                std::vector<float> m_expectedRetention; ///< Mean retention per forecast day.
+                int m_forecastDays = 30; ///< Number of days to forecast.
+                int m_newWords = 0; ///< Number of new words assumed to be added to the library.
+                int m_newWordsPerDay = 20; ///< Number of new words assumed to be studied per day.
+                std::vector<std::string> m_confusions; ///< Descriptions of the most frequent confusions.
             };
         }
     }
@@ -4,6 +4,10 @@
 #include "gui.h"
 #include "Version.h"
 #include "MenuBarWidget.h"
+#include "tools/AllocationTracker.h"
+#include "Tools/ProfiledMutex.h"
+#include "Application/QueryProfiler.h"
+#include <string>
 
 namespace tadaima
 {
@@ -41,6 +45,166 @@ namespace tadaima
                 ImGui::End();
             }
 
+            void MenuBarWidget::showDiagnosticsWindow(bool* p_open)
+            {
+                if( !ImGui::Begin("Diagnostics", p_open, ImGuiWindowFlags_AlwaysAutoResize) )
+                {
+                    ImGui::End();
+                    return;
+                }
+
+                ImGui::SeparatorText("Allocations");
+                drawAllocations();
+                ImGui::SeparatorText("Locks");
+                drawLocks();
+                ImGui::SeparatorText("Queries");
+                drawQueries();
+
+                ImGui::End();
+            }
+
+            void MenuBarWidget::drawAllocations()
+            {
+                if( !AllocationTracker::ENABLED )
+                {
+                    ImGui::TextUnformatted("Allocation tracking is disabled. Build with TadaimaTrackAllocations=true to enable it.");
+                    return;
+                }
+
+                if( ImGui::BeginTable("AllocationsTable", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg) )
+                {
+                    ImGui::TableSetupColumn("Subsystem");
+                    ImGui::TableSetupColumn("Allocations");
+                    ImGui::TableSetupColumn("Bytes");
+                    ImGui::TableSetupColumn("Live bytes");
+                    ImGui::TableHeadersRow();
+
+                    for( std::size_t index = 0; index < AllocationTracker::TAG_COUNT; ++index )
+                    {
+                        const AllocationTag tag = static_cast<AllocationTag>(index);
+                        const AllocationStats stats = AllocationTracker::stats(tag);
+                        ImGui::TableNextRow();
+                        ImGui::TableNextColumn();
+                        ImGui::TextUnformatted(AllocationTracker::tagName(tag));
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%llu", static_cast<unsigned long long>(stats.allocations));
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%llu", static_cast<unsigned long long>(stats.bytes));
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%lld", static_cast<long long>(stats.liveBytes()));
+                    }
+                    ImGui::EndTable();
+                }
+
+                if( ImGui::Button("Reset allocations") )
+                {
+                    AllocationTracker::reset();
+                }
+            }
+
+            void MenuBarWidget::drawLocks()
+            {
+                if( ImGui::BeginTable("LocksTable", 7, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg) )
+                {
+                    ImGui::TableSetupColumn("Lock");
+                    ImGui::TableSetupColumn("Acquisitions");
+                    ImGui::TableSetupColumn("Contended");
+                    ImGui::TableSetupColumn("Wait total [ms]");
+                    ImGui::TableSetupColumn("Wait max [ms]");
+                    ImGui::TableSetupColumn("Hold total [ms]");
+                    ImGui::TableSetupColumn("Hold max [ms]");
+                    ImGui::TableHeadersRow();
+
+                    constexpr double NS_PER_MS = 1e6;
+                    for( const auto& stats : tools::ProfiledMutex::snapshot() )
+                    {
+                        ImGui::TableNextRow();
+                        ImGui::TableNextColumn();
+                        ImGui::TextUnformatted(stats.name.c_str());
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%llu", static_cast<unsigned long long>(stats.acquisitions));
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%llu", static_cast<unsigned long long>(stats.contentions));
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.3f", stats.totalWaitNs / NS_PER_MS);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.3f", stats.maxWaitNs / NS_PER_MS);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.3f", stats.totalHoldNs / NS_PER_MS);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.3f", stats.maxHoldNs / NS_PER_MS);
+                    }
+                    ImGui::EndTable();
+                }
+
+                if( ImGui::Button("Reset locks") )
+                {
+                    tools::ProfiledMutex::resetAll();
+                }
+            }
+
+            void MenuBarWidget::drawQueries()
+            {
+                constexpr std::size_t SHOWN_QUERIES = 20;
+                constexpr std::size_t SHOWN_SQL_LENGTH = 60;
+                if( ImGui::BeginTable("QueriesTable", 8, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg) )
+                {
+                    ImGui::TableSetupColumn("Query");
+                    ImGui::TableSetupColumn("Calls");
+                    ImGui::TableSetupColumn("Total [ms]");
+                    ImGui::TableSetupColumn("Avg [ms]");
+                    ImGui::TableSetupColumn("Max [ms]");
+                    ImGui::TableSetupColumn("VM steps");
+                    ImGui::TableSetupColumn("Full scan steps");
+                    ImGui::TableSetupColumn("<0.1/0.5/1/5/10/50/100/+ ms");
+                    ImGui::TableHeadersRow();
+
+                    constexpr double NS_PER_MS = 1e6;
+                    for( const auto& stats : application::QueryProfiler::topQueries(SHOWN_QUERIES) )
+                    {
+                        ImGui::TableNextRow();
+                        ImGui::TableNextColumn();
+                        if( stats.sql.size() > SHOWN_SQL_LENGTH )
+                        {
+                            ImGui::TextUnformatted((stats.sql.substr(0, SHOWN_SQL_LENGTH) + "...").c_str());
+                        }
+                        else
+                        {
+                            ImGui::TextUnformatted(stats.sql.c_str());
+                        }
+                        if( ImGui::IsItemHovered() )
+                        {
+                            ImGui::SetTooltip("%s", stats.sql.c_str());
+                        }
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%llu", static_cast<unsigned long long>(stats.calls));
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.3f", stats.totalNs / NS_PER_MS);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.3f", stats.totalNs / NS_PER_MS / stats.calls);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%.3f", stats.maxNs / NS_PER_MS);
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%llu", static_cast<unsigned long long>(stats.vmSteps));
+                        ImGui::TableNextColumn();
+                        ImGui::Text("%llu", static_cast<unsigned long long>(stats.fullScanSteps));
+                        ImGui::TableNextColumn();
+                        std::string histogram;
+                        for( const uint64_t count : stats.histogram )
+                        {
+                            histogram += (histogram.empty() ? "" : "/") + std::to_string(count);
+                        }
+                        ImGui::TextUnformatted(histogram.c_str());
+                    }
+                    ImGui::EndTable();
+                }
+
+                if( ImGui::Button("Reset queries") )
+                {
+                    application::QueryProfiler::reset();
+                }
+            }
+
             void MenuBarWidget::draw([[maybe_unused]] bool* p_open)
             {
                 // Display help message when Help is clicked
@@ -50,6 +214,11 @@ namespace tadaima
                     showAboutWindow(&show_help);
                 }
 
+                if( show_diagnostics )
+                {
+                    showDiagnosticsWindow(&show_diagnostics);
+                }
+
                 if( show_quiz_runner )
                 {
                     m_ScriptQuizRunnerWidget.draw(&show_quiz_runner);
@@ -99,6 +268,10 @@ namespace tadaima
                         {
                             show_help = true;
                         }
+                        if( ImGui::MenuItem("Diagnostics") )
+                        {
+                            show_diagnostics = true;
+                        }
 
                         ImGui::EndMenu();
                     }
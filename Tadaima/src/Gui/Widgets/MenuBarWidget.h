@@ -57,8 +57,30 @@ namespace tadaima
                  */
                 void showAboutWindow(bool* p_open);
 
+                /**
+                 * @brief Displays the diagnostics window with heap allocations per subsystem, lock contention and query times.
+                 * @param p_open Pointer to a boolean indicating whether the window is open.
+                 */
+                void showDiagnosticsWindow(bool* p_open);
+
+                /**
+                 * @brief Draws the heap allocations counted per subsystem.
+                 */
+                void drawAllocations();
+
+                /**
+                 * @brief Draws the wait and hold times of the profiled mutexes.
+                 */
+                void drawLocks();
+
+                /**
+                 * @brief Draws the SQL statements with the highest total execution time.
+                 */
+                void drawQueries();
+
                 bool show_settings = false; /**< Flag to track the settings window state. */
                 bool show_quiz_runner = false; /**< Flag to track the quiz runner window state. */
+                bool show_diagnostics = false; /**< Flag to track the diagnostics window state. */
 
                 ApplicationSettingsWidget m_ApplicationSettingsWidget; /**< The application settings widget. */
                 ScriptQuizRunnerWidget m_ScriptQuizRunnerWidget; /**< The script quiz runner widget. */
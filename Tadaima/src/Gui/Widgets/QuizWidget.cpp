@@ -2,6 +2,8 @@
 #include <thread>
 #include <chrono>
 #include "imgui.h"
+#include "packages/ReviewDataPackage.h"
+#include "FrameArena.h"
 
 namespace tadaima
 {
@@ -9,8 +11,9 @@ namespace tadaima
     {
         namespace widget
         {
-            QuizWidget::QuizWidget(quiz::WordType base, quiz::WordType desired, const std::vector<Lesson>& lessons, tools::Logger& logger)
-                : m_baseWord(base), m_inputWord(desired), m_logger(logger), quizGame(base, desired, lessons, logger)
+            QuizWidget::QuizWidget(quiz::MultipleChoiceQuiz::SessionFactory makeSession, const std::vector<Lesson>& lessons, tools::Logger& logger, quiz::QuizOrder order,
+                const review::ConfusionTable* confusions)
+                : m_logger(logger), quizGame(makeSession, lessons, logger, order, confusions)
             {
                 quizGame.start();
                 bufferedQuestion = quizGame.getCurrentQuestion();
@@ -24,6 +27,18 @@ namespace tadaima
                 correctAnswerIndex = quizGame.getCorrectAnswerIndex();
             }
 
+            void QuizWidget::emitReview(int wordId, bool correct, int chosenWordId)
+            {
+                review::ReviewRecord record;
+                record.wordId = wordId;
+                record.timestamp = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+                record.correct = correct;
+                record.chosenWordId = chosenWordId;
+
+                ReviewDataPackage package({ record });
+                emitEvent(WidgetEvent(*this, QuizWidgetEvent::OnWordReviewed, &package));
+            }
+
             void QuizWidget::draw(bool* p_open)
             {
                 ImGui::SetNextWindowSize(ImVec2(600, 300), ImGuiCond_FirstUseEver);
@@ -34,12 +49,6 @@ namespace tadaima
                 {
                     ImGui::TextWrapped("Welcome to the Quiz Game! Test your knowledge by selecting the correct translation.");
 
-                    if( !highlightCorrectAnswer )
-                    {
-                        bufferedQuestion = quizGame.getCurrentQuestion();
-                        bufferedOptions = quizGame.getCurrentOptions();
-                    }
-
                     if( !quizGame.isFinished() )
                     {
                         ImGui::Separator();
@@ -55,12 +64,12 @@ namespace tadaima
                                 ImVec4 buttonColor = (selectedOption == optionLabel) ? ImVec4(0.0f, 1.0f, 0.0f, 1.0f) : ImVec4(1.0f, 0.0f, 0.0f, 1.0f); // Green if correct, Red if incorrect
                                 ImGui::PushStyleColor(ImGuiCol_Button, buttonColor);
                                 ImGui::PushStyleColor(ImGuiCol_ButtonHovered, buttonColor);
-                                ImGui::Button((std::string(1, optionLabel) + ") " + bufferedOptions[index]).c_str(), ImVec2(550, 0));
+                                ImGui::Button(frameFormat("{}) {}", optionLabel, bufferedOptions[index]), ImVec2(550, 0));
                                 ImGui::PopStyleColor(2);
                             }
                             else
                             {
-                                if( ImGui::Button((std::string(1, optionLabel) + ") " + bufferedOptions[index]).c_str(), ImVec2(550, 0)) )
+                                if( ImGui::Button(frameFormat("{}) {}", optionLabel, bufferedOptions[index]), ImVec2(550, 0)) )
                                 {
                                     if( !highlightCorrectAnswer )
                                     {
@@ -78,6 +87,7 @@ namespace tadaima
                             if( elapsed >= 2 )
                             {
                                 highlightCorrectAnswer = false;
+                                emitReview(quizGame.getCurrentWordId(), selectedOption - 'a' == correctAnswerIndex, quizGame.getOptionWordId(selectedOption));
                                 quizGame.advance(selectedOption);
                                 if( !quizGame.isFinished() )
                                 {
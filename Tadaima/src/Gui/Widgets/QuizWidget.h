@@ -26,14 +26,24 @@ namespace tadaima
             {
             public:
 
+                /**
+                 * @brief Enum representing events emitted by the QuizWidget.
+                 */
+                enum QuizWidgetEvent : uint8_t
+                {
+                    OnWordReviewed  /**< Event emitted when the user answered a question. */
+                };
+
                 /**
                  * @brief Constructs a VocabularyQuizWidget object.
-                 * @param base The base word type for the quiz.
-                 * @param desired The desired word type for the quiz.
+                 * @param makeSession Creates the session of the word types and the order of the quiz.
                  * @param lessons Vector of lessons to initialize the quiz with.
                  * @param logger Reference to a Logger instance for logging.
+                 * @param order The order in which the words are asked.
+                 * @param confusions Words mixed up before, offered as distractors, or nullptr.
                  */
-                QuizWidget(quiz::WordType base, quiz::WordType desired, const std::vector<Lesson>& lessons, tools::Logger& logger);
+                QuizWidget(quiz::MultipleChoiceQuiz::SessionFactory makeSession, const std::vector<Lesson>& lessons, tools::Logger& logger, quiz::QuizOrder order = quiz::QuizOrder::Random,
+                    const review::ConfusionTable* confusions = nullptr);
 
                 /**
                  * @brief Draws the quiz widget on the screen.
@@ -50,11 +60,17 @@ namespace tadaima
                  */
                 void highlightAndAdvance();
 
+                /**
+                 * @brief Emits the review of a word so it can be stored in the review history.
+                 * @param wordId The ID of the reviewed word.
+                 * @param correct True if the answer was correct.
+                 * @param chosenWordId The ID of the word whose answer was picked, or -1.
+                 */
+                void emitReview(int wordId, bool correct, int chosenWordId);
+
                 tools::Logger& m_logger; /**< Reference to the Logger instance for logging. */
                 quiz::MultipleChoiceQuiz quizGame; /**< Instance of QuizGame to manage quiz logic. */
 
-                quiz::WordType m_baseWord; ///< The mother language type.
-                quiz::WordType m_inputWord; ///< The learning language type.
                // bool isQuizWindowOpen = true; /**< Boolean flag to track if the quiz window is open. */
                 bool highlightCorrectAnswer = false; /**< Boolean flag to indicate if the correct answer should be highlighted. */
                 std::chrono::steady_clock::time_point highlightStartTime; /**< Time point for when the highlight started. */
@@ -4,6 +4,7 @@
 #include "Tools/Logger.h"
 #include "imgui.h"
 #include "tools/Dictionary.h"
+#include "FrameArena.h"
 
 namespace tadaima
 {
@@ -16,7 +17,7 @@ namespace tadaima
             {
                 m_scriptRunner.setOutputCallback([this](const std::string& output)
                     {
-                        std::lock_guard<std::mutex> lock(output_mutex);
+                        std::lock_guard<tools::ProfiledMutex> lock(output_mutex);
                         this->output.push_back(output);
                     });
             }
@@ -94,13 +95,13 @@ namespace tadaima
                         ImGui::Separator();
                         for( const auto& script : m_scripts )
                         {
-                            std::string scriptName = getFileName(script);
+                            const char* scriptName = frameText(getFileName(script));
                             if( m_scriptRunner.isScriptRunning() )
                             {
                                 ImGui::BeginDisabled();
                             }
 
-                            if( ImGui::Selectable(scriptName.c_str(), current_script == script, ImGuiSelectableFlags_AllowDoubleClick) )
+                            if( ImGui::Selectable(scriptName, current_script == script, ImGuiSelectableFlags_AllowDoubleClick) )
                             {
                                 if( ImGui::IsMouseDoubleClicked(0) )
                                 {
@@ -110,7 +111,7 @@ namespace tadaima
                                     }
 
                                     current_script = script;
-                                    m_logger.log("Script selected: " + scriptName, tools::LogLevel::INFO);
+                                    m_logger.log(std::string("Script selected: ") + scriptName, tools::LogLevel::INFO);
                                     m_scriptRunner.runScript(script);
                                     if( m_scriptRunner.isScriptRunning() )
                                     {
@@ -121,7 +122,7 @@ namespace tadaima
 
                             if( ImGui::IsItemHovered() )
                             {
-                                ImGui::SetTooltip("%s", scriptName.c_str());
+                                ImGui::SetTooltip("%s", scriptName);
                             }
 
                             if( m_scriptRunner.isScriptRunning() )
@@ -145,7 +146,7 @@ namespace tadaima
                         ImGui::Separator();
                         {
                             ImGui::PushTextWrapPos();
-                            std::lock_guard<std::mutex> lock(output_mutex);
+                            std::lock_guard<tools::ProfiledMutex> lock(output_mutex);
                             for( const auto& line : output )
                             {
                                 ImGui::TextUnformatted(line.c_str());
@@ -198,7 +199,7 @@ namespace tadaima
 
                         if( ImGui::Button("Clear window") )
                         {
-                            std::lock_guard<std::mutex> lock(output_mutex);
+                            std::lock_guard<tools::ProfiledMutex> lock(output_mutex);
                             output.clear();
                         }
 
@@ -222,10 +223,11 @@ namespace tadaima
                 m_scriptRunner.checkScriptCompletion();
             }
 
-            std::string ScriptQuizRunnerWidget::getFileName(const std::string& fullPath)
+            std::string_view ScriptQuizRunnerWidget::getFileName(const std::string& fullPath)
             {
-                std::filesystem::path pathObj(fullPath);
-                return pathObj.filename().string();
+                const std::string_view path(fullPath);
+                const std::size_t separator = path.find_last_of("/\\");
+                return separator == std::string_view::npos ? path : path.substr(separator + 1);
             }
 
             bool ScriptQuizRunnerWidget::isPythonScript(const std::string& path)
@@ -12,7 +12,9 @@
 
 #include "Widget.h"
 #include "Tools/ScriptRunner.h"
+#include "Tools/ProfiledMutex.h"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <atomic>
 
@@ -74,14 +76,14 @@ namespace tadaima
                  * @param fullPath The full file path.
                  * @return The file name extracted from the path.
                  */
-                std::string getFileName(const std::string& fullPath);
+                std::string_view getFileName(const std::string& fullPath);
 
                 std::vector<std::string> m_scripts; ///< List of available scripts.
                 tools::Logger& m_logger; ///< Reference to the logger instance.
                 tools::ScriptRunner m_scriptRunner; ///< Instance of the ScriptRunner for running scripts.
                 std::vector<std::string> output; ///< Output from the running script.
                 std::string current_script; ///< The currently selected script.
-                std::mutex output_mutex; ///< Mutex for protecting access to the output.
+                tools::ProfiledMutex output_mutex{ "ScriptQuizRunnerWidget::output_mutex" }; ///< Mutex for protecting access to the output.
                 std::atomic<bool> send_input_flag; ///< Flag indicating if input should be sent to the script.
                 char user_input[128] = ""; ///< Buffer for user input.
             };
@@ -2,10 +2,18 @@
 #include <algorithm>
 #include "imgui.h"
 #include "packages/SettingsDataPackage.h"
+#include "packages/ReviewDataPackage.h"
+#include "KanaInput.h"
 #include "Lessons/Lesson.h"
+#include "Lessons/FrequencyTable.h"
+#include "quiz/QuizEngine.h"
 #include <stdexcept>
 #include <format>
 #include <random>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 
 namespace tadaima
 {
@@ -13,31 +21,28 @@ namespace tadaima
     {
         namespace widget
         {
-            VocabularyQuizWidget::VocabularyQuizWidget(quiz::WordType base, quiz::WordType desired, const std::vector<Lesson>& lessons, tools::Logger& logger)
-                : m_baseWord(base), m_inputWord(desired), m_lessons(lessons), m_logger(logger), m_correctAnswerMessage("You're answer is ...")
+            VocabularyQuizWidget::VocabularyQuizWidget(quiz::WordType base, quiz::WordType desired, quiz::QuizOrder order, quiz::VocabularyQuiz::Factory makeQuiz,
+                const std::vector<Lesson>& lessons, tools::Logger& logger)
+                : m_logger(logger), m_baseWord(base), m_inputWord(desired), m_order(order), m_correctAnswerMessage("You're answer is ...")
             {
                 try
                 {
                     m_logger.log("Initializing VocabularyQuizWidget...", tools::LogLevel::INFO);
-                    std::vector<quiz::QuizWord> flashcards;
-                    for( const auto& lesson : lessons )
+                    std::vector<Word> words = quiz::collectWords(lessons);
+                    if( quiz::QuizOrder::Frequency == order )
                     {
-                        for( const auto& word : lesson.words )
-                        {
-                            std::string string = getTranslation(word, desired);
-                            if( !string.empty() )
-                            {
-                                flashcards.push_back({ word.id , string });
-                            }
-                        }
+                        std::stable_sort(words.begin(), words.end(), FrequencyTable::isMoreCommon);
                     }
 
-                    if( flashcards.empty() )
+                    // A word without the answer could never be learnt
+                    std::erase_if(words, [desired](const Word& word) { return quiz::wordField(word, desired).empty(); });
+                    if( words.empty() )
                     {
                         throw std::runtime_error("No valid flashcards could be created.");
                     }
 
-                    m_quiz = std::make_unique<quiz::VocabularyQuiz>(flashcards, 2, true);
+                    m_quiz = makeQuiz(std::move(words), REQUIRED_CORRECT_ANSWERS);
+                    m_answersSinceSnapshot = SNAPSHOT_INTERVAL; // Replace the snapshot of a previous quiz on the first frame
                 }
                 catch( const std::exception& e )
                 {
@@ -45,60 +50,133 @@ namespace tadaima
                 }
             }
 
-            tadaima::Word VocabularyQuizWidget::getWordById(int id)
+            VocabularyQuizWidget::VocabularyQuizWidget(tools::Logger& logger)
+                : m_logger(logger), m_baseWord(quiz::WordType::BaseWord), m_inputWord(quiz::WordType::Romaji), m_correctAnswerMessage("You're answer is ...")
             {
-                try
+            }
+
+            VocabularyQuizWidget::~VocabularyQuizWidget()
+            {
+                if( !m_quiz )
                 {
-                    for( const auto& lesson : m_lessons )
-                    {
-                        for( const auto& word : lesson.words )
-                        {
-                            if( id == word.id )
-                            {
-                                return word;
-                            }
-                        }
-                    }
-                    throw std::invalid_argument(std::format("Wrong Id for the word: {}", id));
+                    return;
                 }
-                catch( const std::invalid_argument& e )
+
+                if( m_quiz->isQuizComplete() )
+                {
+                    std::error_code error;
+                    std::filesystem::remove(SNAPSHOT_PATH, error);
+                }
+                else if( !saveSnapshot(SNAPSHOT_PATH) )
                 {
-                    m_logger.log(e.what(), tools::LogLevel::PROBLEM);
-                    throw; // Re-throw to let the caller handle it if necessary
+                    m_logger.log("Quiz snapshot could not be saved.", tools::LogLevel::WARNING);
                 }
             }
 
-            std::string VocabularyQuizWidget::getTranslation(const Word& word, quiz::WordType type) const
+            bool VocabularyQuizWidget::saveSnapshot(const std::string& path) const
             {
-                std::string correctAnswer;
+                if( !m_quiz )
+                {
+                    return false;
+                }
+
+                std::string buffer = "TQSN";
+                binary::appendNumber(buffer, SNAPSHOT_VERSION);
+                binary::appendNumber(buffer, static_cast<uint32_t>(m_baseWord));
+                binary::appendNumber(buffer, static_cast<uint32_t>(m_inputWord));
+                binary::appendNumber(buffer, static_cast<uint32_t>(m_order));
 
-                switch( type )
+                // The words are written in the order of the quiz, which refers to them by index
+                const std::vector<Word>& words = m_quiz->getWords();
+                binary::appendNumber(buffer, static_cast<uint32_t>(words.size()));
+                for( const auto& word : words )
                 {
-                    case quiz::WordType::BaseWord:
-                        correctAnswer = word.translation;
-                        break;
+                    binary::appendNumber(buffer, static_cast<uint32_t>(word.id));
+                    binary::appendString(buffer, word.kana);
+                    binary::appendString(buffer, word.kanji);
+                    binary::appendString(buffer, word.translation);
+                    binary::appendString(buffer, word.romaji);
+                    binary::appendString(buffer, word.exampleSentence);
+                }
+                m_quiz->serialize(buffer);
 
-                    case quiz::WordType::Kana:
-                        correctAnswer = word.kana;
-                        break;
+                const std::string temporaryPath = path + ".tmp";
+                {
+                    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+                    if( !file.write(buffer.data(), buffer.size()) )
+                    {
+                        return false;
+                    }
+                }
 
-                    case quiz::WordType::Romaji:
-                        correctAnswer = word.romaji;
-                        break;
+                std::error_code error;
+                std::filesystem::rename(temporaryPath, path, error);
+                return !error;
+            }
 
-                    default:
-                        m_logger.log(std::format("Wrong type for translation. Value: {}", static_cast<int>(type)), tools::LogLevel::PROBLEM);
-                        break;
+            std::unique_ptr<VocabularyQuizWidget> VocabularyQuizWidget::loadSnapshot(const std::string& path, tools::Logger& logger, FactoryResolver resolveFactory)
+            {
+                std::ifstream file(path, std::ios::binary);
+                if( !file )
+                {
+                    return nullptr;
                 }
+                const std::string buffer((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
 
-                return correctAnswer;
+                try
+                {
+                    binary::Reader reader(buffer);
+                    if( reader.take(4) != "TQSN" || reader.number() != SNAPSHOT_VERSION )
+                    {
+                        throw std::runtime_error("unknown format");
+                    }
+
+                    std::unique_ptr<VocabularyQuizWidget> widget(new VocabularyQuizWidget(logger));
+                    widget->m_baseWord = static_cast<quiz::WordType>(reader.number());
+                    widget->m_inputWord = static_cast<quiz::WordType>(reader.number());
+                    widget->m_order = static_cast<quiz::QuizOrder>(reader.number());
+
+                    std::vector<Word> words;
+                    const uint32_t wordCount = reader.number();
+                    words.reserve(wordCount);
+                    for( uint32_t index = 0; index < wordCount; ++index )
+                    {
+                        Word& word = words.emplace_back();
+                        word.id = static_cast<int>(reader.number());
+                        word.kana = reader.string();
+                        word.kanji = reader.string();
+                        word.translation = reader.string();
+                        word.romaji = reader.string();
+                        word.exampleSentence = reader.string();
+                    }
+
+                    widget->m_quiz = resolveFactory(widget->m_baseWord, widget->m_inputWord, widget->m_order)(std::move(words), REQUIRED_CORRECT_ANSWERS);
+                    widget->m_quiz->restore(reader);
+                    if( !reader.atEnd() || widget->m_quiz->isQuizComplete() )
+                    {
+                        throw std::runtime_error("no quiz in progress");
+                    }
+
+                    logger.log(std::format("Quiz restored with {} flashcards.", widget->m_quiz->getNumberOflashcards()), tools::LogLevel::INFO);
+                    return widget;
+                }
+                catch( const std::exception& e )
+                {
+                    logger.log(std::format("Quiz snapshot {} could not be restored: {}", path, e.what()), tools::LogLevel::WARNING);
+                    return nullptr;
+                }
+            }
+
+            const std::string& VocabularyQuizWidget::getTranslation(const Word& word, quiz::WordType type) const
+            {
+                return quiz::wordField(word, type);
             }
 
             std::string VocabularyQuizWidget::getHint()
             {
                 try
                 {
-                    std::string translation = m_quiz->getCurrentFlashCard().word;
+                    const std::string& translation = m_quiz->getExpectedAnswer();
 
                     if( m_revealedHints.size() >= translation.size() )
                     {
@@ -147,10 +225,10 @@ namespace tadaima
                     int correctAttempts = 0;
                     int incorrectAttempts = 0;
 
-                    for( const auto& entry : m_quiz->getStatistics() )
+                    for( const auto& statistics : m_quiz->getStatistics() )
                     {
-                        correctAttempts += entry.second.goodAttempts;
-                        incorrectAttempts += entry.second.badAttempts;
+                        correctAttempts += statistics.goodAttempts;
+                        incorrectAttempts += statistics.badAttempts;
                     }
 
                     // Net progress is the total correct attempts minus the total incorrect attempts
@@ -169,10 +247,31 @@ namespace tadaima
                 }
             }
 
+            void VocabularyQuizWidget::emitReview(int wordId, bool correct)
+            {
+                review::ReviewRecord record;
+                record.wordId = wordId;
+                record.timestamp = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+                record.correct = correct;
+
+                ReviewDataPackage package({ record });
+                emitEvent(WidgetEvent(*this, VocabularyQuizWidgetEvent::OnWordReviewed, &package));
+                m_answersSinceSnapshot++;
+            }
+
             void VocabularyQuizWidget::draw(bool* p_open)
             {
                 try
                 {
+                    if( m_answersSinceSnapshot >= SNAPSHOT_INTERVAL && m_quiz && !m_quiz->isQuizComplete() )
+                    {
+                        m_answersSinceSnapshot = 0;
+                        if( !saveSnapshot(SNAPSHOT_PATH) )
+                        {
+                            m_logger.log("Quiz snapshot could not be saved.", tools::LogLevel::WARNING);
+                        }
+                    }
+
                     ImGui::SetNextWindowSize(ImVec2(600, 400), ImGuiCond_FirstUseEver);
                     ImGui::PushStyleColor(ImGuiCol_WindowBg, ImVec4(0.98f, 0.92f, 0.84f, 1.0f)); // Light peach background
                     ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10, 10)); // Add padding
@@ -248,9 +347,9 @@ namespace tadaima
 
                             ImGui::Spacing();
 
-                            const auto& flashcard = m_quiz->getCurrentFlashCard();
-                            auto word = getWordById(flashcard.wordId);
-                            auto translate = getTranslation(word, m_baseWord);
+                            const auto& word = m_quiz->getCurrentWord();
+                            const auto& answer = m_quiz->getExpectedAnswer();
+                            const auto& translate = m_quiz->getPrompt();
 
                             ImGui::Text("Word:");
                             ImGui::SameLine();
@@ -261,7 +360,10 @@ namespace tadaima
                                 setFocusOnInputField = false;
                             }
 
-                            if( ImGui::InputText(" ", m_userInput, sizeof(m_userInput), ImGuiInputTextFlags_EnterReturnsTrue) )
+                            const bool answered = m_inputWord == quiz::WordType::Kana
+                                ? inputKana(" ", m_userInput, sizeof(m_userInput), ImGuiInputTextFlags_EnterReturnsTrue)
+                                : ImGui::InputText(" ", m_userInput, sizeof(m_userInput), ImGuiInputTextFlags_EnterReturnsTrue);
+                            if( answered )
                             {
                                 m_translation = word.translation;
                                 m_kana = word.kana;
@@ -269,7 +371,7 @@ namespace tadaima
                                 m_example = word.exampleSentence;
 
                                 m_showCorrectAnswer = true;
-                                m_correctAnswer = flashcard.word;
+                                m_correctAnswer = answer;
 
                                 const bool isCorrect = m_quiz->isCorrect(m_userInput);
 
@@ -304,7 +406,7 @@ namespace tadaima
                             {
                                 if( m_currentHint.empty() )
                                 {
-                                    m_currentHint = std::string(flashcard.word.size(), '*'); // Reset currentHint to asterisks
+                                    m_currentHint = std::string(answer.size(), '*'); // Reset currentHint to asterisks
                                 }
                                 m_currentHint = getHint();
                             }
@@ -322,7 +424,8 @@ namespace tadaima
                                 }
                                 if( ImGui::Button("Correct!") || (focusOnAcceptButton && enterPressed) )
                                 {
-                                    m_quiz->advance(flashcard.word);
+                                    emitReview(word.id, true);
+                                    m_quiz->advance(answer);
                                     memset(m_userInput, 0, sizeof(m_userInput));
                                     m_overrideAnswer = true;
                                     m_correctAnswerMessage = "Your answer has been marked as correct!";
@@ -374,7 +477,8 @@ namespace tadaima
                                 }
                                 if( ImGui::Button("Accept it!") || (focusOnAcceptButton && enterPressed) )
                                 {
-                                    m_quiz->advance(flashcard.word);
+                                    emitReview(word.id, true);
+                                    m_quiz->advance(answer);
                                     memset(m_userInput, 0, sizeof(m_userInput));
                                     m_overrideAnswer = true;
                                     m_correctAnswerMessage = "Your answer has been marked as correct!";
@@ -403,6 +507,7 @@ namespace tadaima
                                     ImGui::SetKeyboardFocusHere();
                                     if( ImGui::Button("Wrong!") || (focusOnWrongButton && enterPressed) )
                                     {
+                                        emitReview(word.id, false);
                                         m_quiz->advance(m_userInput);
                                         memset(m_userInput, 0, sizeof(m_userInput));
                                         m_correctAnswerMessage = "Your answer has been marked as wrong!";
@@ -422,6 +527,7 @@ namespace tadaima
                                 {
                                     if( ImGui::Button("Wrong!") )
                                     {
+                                        emitReview(word.id, false);
                                         m_quiz->advance(m_userInput);
                                         memset(m_userInput, 0, sizeof(m_userInput));
                                         m_correctAnswerMessage = "Your answer has been marked as wrong!";
@@ -443,13 +549,13 @@ namespace tadaima
                             ImGui::Separator();
                             ImGui::Text("Quiz Statistics:");
                             const auto& statistics = m_quiz->getStatistics();
-                            for( const auto& entry : statistics )
+                            const auto& words = m_quiz->getWords();
+                            for( std::size_t index = 0; index < words.size(); ++index )
                             {
-                                auto word = getWordById(entry.first);
-                                auto translate = getTranslation(word, m_baseWord);
+                                const auto& translate = getTranslation(words[index], m_baseWord);
                                 ImGui::Text("Word: %s", translate.c_str());
                                 ImGui::SameLine();
-                                ImGui::Text("Attempts: %d", entry.second.badAttempts); // Assuming badAttempts and goodAttempts exist
+                                ImGui::Text("Attempts: %d", statistics[index].badAttempts);
                             }
                         }
                     }
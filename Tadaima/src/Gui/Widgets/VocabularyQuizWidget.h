@@ -37,14 +37,32 @@ namespace tadaima
             {
             public:
 
+                /**
+                 * @brief Enum representing events emitted by the VocabularyQuizWidget.
+                 */
+                enum VocabularyQuizWidgetEvent : uint8_t
+                {
+                    OnWordReviewed  /**< Event emitted when an answer for a word was accepted or rejected. */
+                };
+
+                static constexpr const char* SNAPSHOT_PATH = "quiz_session.bin"; ///< File holding the snapshot of the unfinished quiz.
+                static constexpr uint32_t SNAPSHOT_VERSION = 2; ///< Version of the snapshot format.
+                static constexpr int SNAPSHOT_INTERVAL = 10; ///< Number of answers after which the snapshot is refreshed.
+                static constexpr int REQUIRED_CORRECT_ANSWERS = 2; ///< Correct answers a word needs beyond its mistakes.
+
+                using FactoryResolver = quiz::VocabularyQuiz::Factory(*)(quiz::WordType, quiz::WordType, quiz::QuizOrder); ///< Finds the instantiation of the word types and the order of a snapshot.
+
                 /**
                  * @brief Constructs a VocabularyQuizWidget object.
                  * @param base The base word type for the quiz.
                  * @param desired The desired word type for the quiz.
+                 * @param order The order in which the words are asked.
+                 * @param makeQuiz Creates the quiz of the word types and the order.
                  * @param lessons Vector of lessons to initialize the quiz with.
                  * @param logger Reference to a Logger instance for logging.
                  */
-                VocabularyQuizWidget(quiz::WordType base, quiz::WordType desired, const std::vector<Lesson>& lessons, tools::Logger& logger);
+                VocabularyQuizWidget(quiz::WordType base, quiz::WordType desired, quiz::QuizOrder order, quiz::VocabularyQuiz::Factory makeQuiz, const std::vector<Lesson>& lessons,
+                    tools::Logger& logger);
 
                 /**
                  * @brief Draws the quiz widget.
@@ -55,14 +73,40 @@ namespace tadaima
                  */
                 void draw(bool* p_open) override;
 
+                /**
+                 * @brief Destroys the widget, saving the snapshot of an unfinished quiz or removing it once the quiz is complete.
+                 */
+                ~VocabularyQuizWidget() override;
+
+                /**
+                 * @brief Writes the full state of the quiz and the words it asks to a binary snapshot.
+                 *
+                 * The file is replaced only after the new snapshot was written completely.
+                 *
+                 * @param path Path of the snapshot.
+                 * @return True if the snapshot was written, false otherwise.
+                 */
+                bool saveSnapshot(const std::string& path) const;
+
+                /**
+                 * @brief Restores a quiz from a snapshot written by saveSnapshot().
+                 *
+                 * The quiz is read in a single pass, the lessons are not needed.
+                 *
+                 * @param path Path of the snapshot.
+                 * @param logger Reference to a Logger instance for logging.
+                 * @param resolveFactory Finds the factory of the word types and the order stored in the snapshot.
+                 * @return The restored widget, or nullptr if the snapshot is missing or invalid.
+                 */
+                static std::unique_ptr<VocabularyQuizWidget> loadSnapshot(const std::string& path, tools::Logger& logger, FactoryResolver resolveFactory);
+
             private:
 
                 /**
-                 * @brief Retrieves a word by its ID.
-                 * @param id The ID of the word to retrieve.
-                 * @return The Word object corresponding to the given ID.
+                 * @brief Constructs an empty widget filled in by loadSnapshot().
+                 * @param logger Reference to a Logger instance for logging.
                  */
-                Word getWordById(int id);
+                explicit VocabularyQuizWidget(tools::Logger& logger);
 
                 /**
                  * @brief Gets the translation of a word.
@@ -70,7 +114,7 @@ namespace tadaima
                  * @param type The type of the word for translation.
                  * @return A string containing the translation.
                  */
-                std::string getTranslation(const Word& word, quiz::WordType type) const;
+                const std::string& getTranslation(const Word& word, quiz::WordType type) const;
 
                 /**
                  * @brief Initializes flashcards from a set of lessons.
@@ -97,10 +141,17 @@ namespace tadaima
                  */
                 float calculateProgress();
 
+                /**
+                 * @brief Emits the review of a word so it can be stored in the review history.
+                 * @param wordId The ID of the reviewed word.
+                 * @param correct True if the answer was accepted as correct.
+                 */
+                void emitReview(int wordId, bool correct);
+
                 tools::Logger& m_logger; ///< Reference to the logger for logging purposes.
                 quiz::WordType m_baseWord; ///< The mother language type.
                 quiz::WordType m_inputWord; ///< The learning language type.
-                std::vector<Lesson> m_lessons; ///< Vector of lessons used to generate flashcards.
+                quiz::QuizOrder m_order = quiz::QuizOrder::Random; ///< The order in which the words are asked.
 
                 std::unique_ptr<quiz::VocabularyQuiz> m_quiz; ///< Unique pointer to the VocabularyQuiz instance.
                 char m_userInput[50] = { 0 }; ///< User input buffer.
@@ -116,6 +167,7 @@ namespace tadaima
 
                 bool m_showCorrectAnswer = false; ///< Boolean indicating whether to show the correct answer.
                 bool m_overrideAnswer = false; ///< Boolean indicating whether to override the incorrect answer as correct.
+                int m_answersSinceSnapshot = 0; ///< Number of answers given since the snapshot was written.
             };
         }
     }
@@ -0,0 +1,54 @@
+/**
+ * @file CommitResultDataPackage.h
+ * @brief Defines the CommitResultDataPackage class carrying the outcome of committed lesson changes.
+ */
+
+#pragma once
+
+#include "PackageType.h"
+#include "Tools/DataPackage.h"
+#include "Application/GroupCommit.h"
+#include <vector>
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace widget
+        {
+            /**
+             * @brief Enum class for package keys used in commit result data packages.
+             */
+            enum class CommitResultPackageKey : uint32_t
+            {
+                Results     /**< Key for the outcome of every change of a group commit, in the order they were made. */
+            };
+
+            /**
+             * @brief Represents a package containing the outcome of the lesson changes committed together.
+             */
+            class CommitResultDataPackage : public tools::ComplexDataPackage<CommitResultPackageKey, std::vector<application::GroupCommitResult>>
+            {
+            public:
+
+                /**
+                 * @brief Constructs a CommitResultDataPackage object.
+                 * @param results The outcome of every change of the group commit.
+                 */
+                explicit CommitResultDataPackage(const std::vector<application::GroupCommitResult>& results) : ComplexDataPackage(PackageType::CommitResults)
+                {
+                    set(CommitResultPackageKey::Results, results);
+                }
+
+                /**
+                 * @brief Gets the outcomes stored in the package.
+                 * @return A vector containing the outcomes.
+                 */
+                std::vector<application::GroupCommitResult> decode() const
+                {
+                    return get<std::vector<application::GroupCommitResult>>(CommitResultPackageKey::Results);
+                }
+            };
+        }
+    }
+}
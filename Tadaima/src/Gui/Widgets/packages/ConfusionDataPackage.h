@@ -0,0 +1,67 @@
+/**
+ * @file ConfusionDataPackage.h
+ * @brief Defines the ConfusionDataPackage class carrying the words mixed up in quizzes.
+ */
+
+#pragma once
+
+#include "PackageType.h"
+#include "Tools/DataPackage.h"
+#include "review/Review.h"
+#include <string>
+#include <vector>
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace widget
+        {
+            /**
+             * @brief Enum class for package keys used in confusion data packages.
+             */
+            enum class ConfusionPackageKey : uint32_t
+            {
+                Confusions,     /**< Key for all stored confusions, most frequent first. */
+                Descriptions    /**< Key for readable descriptions of the most frequent confusions. */
+            };
+
+            /**
+             * @brief Represents a package containing the confusions of the learner.
+             */
+            class ConfusionDataPackage : public tools::ComplexDataPackage<ConfusionPackageKey, std::vector<review::Confusion>, std::vector<std::string>>
+            {
+            public:
+
+                /**
+                 * @brief Constructs a ConfusionDataPackage object.
+                 * @param confusions All stored confusions, most frequent first.
+                 * @param descriptions Descriptions of the first confusions, one per confusion.
+                 */
+                ConfusionDataPackage(const std::vector<review::Confusion>& confusions, const std::vector<std::string>& descriptions) : ComplexDataPackage(PackageType::Confusions)
+                {
+                    set(ConfusionPackageKey::Confusions, confusions);
+                    set(ConfusionPackageKey::Descriptions, descriptions);
+                }
+
+                /**
+                 * @brief Gets the confusions stored in the package.
+                 * @return A vector containing the confusions.
+                 */
+                std::vector<review::Confusion> decode() const
+                {
+                    return get<std::vector<review::Confusion>>(ConfusionPackageKey::Confusions);
+                }
+
+                /**
+                 * @brief Gets the descriptions of the most frequent confusions.
+                 * @return A vector containing the descriptions.
+                 */
+                std::vector<std::string> decodeDescriptions() const
+                {
+                    return get<std::vector<std::string>>(ConfusionPackageKey::Descriptions);
+                }
+            };
+        }
+    }
+}
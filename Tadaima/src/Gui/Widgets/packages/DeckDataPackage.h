@@ -0,0 +1,47 @@
+/**
+ * @file DeckDataPackage.h
+ * @brief Defines the DeckDataPackage class used to import and export deck packs.
+ */
+
+#pragma once
+
+#include "PackageType.h"
+#include "Tools/DataPackage.h"
+#include <string>
+#include <vector>
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace widget
+        {
+            /**
+             * @brief Enum class for package keys used in deck data packages.
+             */
+            enum class DeckPackageKey : uint32_t
+            {
+                Path,       /**< Key for the path of the deck pack. */
+                Name,       /**< Key for the name of the exported deck. */
+                LessonIds   /**< Key for the IDs of the exported lessons. */
+            };
+
+            /**
+             * @brief Represents a package describing a deck pack to import or export.
+             */
+            class DeckDataPackage : public tools::ComplexDataPackage<DeckPackageKey, std::string, std::vector<int>>
+            {
+            public:
+
+                /**
+                 * @brief Constructs a DeckDataPackage object.
+                 * @param path The path of the deck pack.
+                 */
+                explicit DeckDataPackage(const std::string& path) : ComplexDataPackage(PackageType::Deck)
+                {
+                    set(DeckPackageKey::Path, path);
+                }
+            };
+        }
+    }
+}
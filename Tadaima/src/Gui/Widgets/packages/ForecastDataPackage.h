@@ -0,0 +1,106 @@
+/**
+ * @file ForecastDataPackage.h
+ * @brief Defines the ForecastDataPackage class carrying forecast requests and results.
+ */
+
+#pragma once
+
+#include "PackageType.h"
+#include "Tools/DataPackage.h"
+#include "review/RetentionForecaster.h"
+#include <vector>
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace widget
+        {
+            /**
+             * @brief Enum class for package keys used in forecast data packages.
+             */
+            enum class ForecastPackageKey : uint32_t
+            {
+                Days,               /**< Key for the number of forecast days. */
+                NewWords,           /**< Key for the number of new words added to the library. */
+                NewWordsPerDay,     /**< Key for the number of new words introduced per day. */
+                ExpectedReviews,    /**< Key for the mean number of reviews per day. */
+                ReviewsLow,         /**< Key for the low percentile of reviews per day. */
+                ReviewsHigh,        /**< Key for the high percentile of reviews per day. */
+                ExpectedRetention   /**< Key for the mean retention per day. */
+            };
+
+            /**
+             * @brief Represents a package containing either forecast options or a forecast result.
+             */
+            class ForecastDataPackage : public tools::ComplexDataPackage<ForecastPackageKey, int, std::vector<float>>
+            {
+            public:
+
+                /**
+                 * @brief Constructs an empty ForecastDataPackage object.
+                 */
+                ForecastDataPackage() : ComplexDataPackage(PackageType::Forecast) {}
+
+                /**
+                 * @brief Constructs a ForecastDataPackage object with the given forecast options.
+                 * @param options The forecast options stored in the package.
+                 */
+                ForecastDataPackage(const review::ForecastOptions& options) : ComplexDataPackage(PackageType::Forecast)
+                {
+                    set(ForecastPackageKey::Days, options.days);
+                    set(ForecastPackageKey::NewWords, options.newWords);
+                    set(ForecastPackageKey::NewWordsPerDay, options.newWordsPerDay);
+                }
+
+                /**
+                 * @brief Constructs a ForecastDataPackage object with the given forecast result.
+                 * @param forecast The forecast stored in the package.
+                 */
+                ForecastDataPackage(const review::Forecast& forecast) : ComplexDataPackage(PackageType::Forecast)
+                {
+                    set(ForecastPackageKey::ExpectedReviews, forecast.expectedReviews);
+                    set(ForecastPackageKey::ReviewsLow, forecast.reviewsLow);
+                    set(ForecastPackageKey::ReviewsHigh, forecast.reviewsHigh);
+                    set(ForecastPackageKey::ExpectedRetention, forecast.expectedRetention);
+                }
+
+                /**
+                 * @brief Checks if the package contains a forecast result.
+                 * @return True if the package holds a forecast, false if it holds options.
+                 */
+                bool hasForecast() const
+                {
+                    return values.find(ForecastPackageKey::ExpectedReviews) != values.end();
+                }
+
+                /**
+                 * @brief Gets the forecast options stored in the package.
+                 * @return The forecast options.
+                 */
+                review::ForecastOptions decodeOptions() const
+                {
+                    review::ForecastOptions options;
+                    options.days = get<int>(ForecastPackageKey::Days);
+                    options.newWords = get<int>(ForecastPackageKey::NewWords);
+                    options.newWordsPerDay = get<int>(ForecastPackageKey::NewWordsPerDay);
+                    return options;
+                }
+
+                /**
+                 * @brief Gets the forecast result stored in the package.
+                 * @return The forecast.
+                 */
+                review::Forecast decodeForecast() const
+                {
+                    review::Forecast forecast;
+                    forecast.expectedReviews = get<std::vector<float>>(ForecastPackageKey::ExpectedReviews);
+                    forecast.reviewsLow = get<std::vector<float>>(ForecastPackageKey::ReviewsLow);
+                    forecast.reviewsHigh = get<std::vector<float>>(ForecastPackageKey::ReviewsHigh);
+                    forecast.expectedRetention = get<std::vector<float>>(ForecastPackageKey::ExpectedRetention);
+                    return forecast;
+                }
+            };
+        }
+    }
+}
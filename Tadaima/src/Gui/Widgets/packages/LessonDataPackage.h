@@ -7,6 +7,7 @@
 
 #include "PackageType.h"
 #include "Tools/DataPackage.h"
+#include "tools/AllocationTracker.h"
 #include <cstring>
 #include <string>
 #include "lessons/Lesson.h"
@@ -26,7 +27,8 @@ namespace tadaima
             enum class LessonPackageKey : uint32_t
             {
                 Type,
-                LessonsPackage
+                LessonsPackage,
+                ChangedLessonIds    /**< Key for the IDs of every lesson a LessonsChanged package covers. */
             };
 
             /**
@@ -36,7 +38,8 @@ namespace tadaima
             {
                 LessonCreated,
                 LessonModified,
-                LessonDeleted
+                LessonDeleted,
+                LessonsChanged  /**< Only the lessons touched by a batch of changes, the rest of the library is unchanged. */
             };
 
             /**
@@ -60,7 +63,10 @@ namespace tadaima
                 Translation,
                 Romaji,
                 ExampleSentence,
-                Tags
+                Tags,
+                Kanji,
+                ClozeStart,
+                ClozeLength
             };
 
             /**
@@ -76,7 +82,7 @@ namespace tadaima
             /**
              * @brief Represents a package containing lesson data.
              */
-            class LessonDataPackage : public tools::ComplexDataPackage<LessonPackageKey, LessonPackageType, std::vector<LessonPackage>>
+            class LessonDataPackage : public tools::ComplexDataPackage<LessonPackageKey, LessonPackageType, std::vector<LessonPackage>, std::vector<int>>
             {
             public:
 
@@ -88,6 +94,7 @@ namespace tadaima
 
                 LessonDataPackage(const std::vector<Lesson>& lessons)
                 {
+                    AllocationScope scope(AllocationTag::Packages);
                     std::vector<gui::widget::LessonPackage> lessonPackages;
 
                     for( const auto& lesson : lessons )
@@ -104,10 +111,13 @@ namespace tadaima
                             gui::widget::WordDataPackage wordPackage(word.id);
                             wordPackage.set(gui::widget::LessonWordDataKey::id, word.id);
                             wordPackage.set(gui::widget::LessonWordDataKey::Kana, word.kana);
+                            wordPackage.set(gui::widget::LessonWordDataKey::Kanji, word.kanji);
                             wordPackage.set(gui::widget::LessonWordDataKey::Translation, word.translation);
                             wordPackage.set(gui::widget::LessonWordDataKey::Romaji, word.romaji);
                             wordPackage.set(gui::widget::LessonWordDataKey::ExampleSentence, word.exampleSentence);
                             wordPackage.set(gui::widget::LessonWordDataKey::Tags, word.tags);
+                            wordPackage.set(gui::widget::LessonWordDataKey::ClozeStart, word.clozeStart);
+                            wordPackage.set(gui::widget::LessonWordDataKey::ClozeLength, word.clozeLength);
 
                             wordPackages.push_back(wordPackage);
                         }
@@ -119,6 +129,35 @@ namespace tadaima
                     set(gui::widget::LessonPackageKey::LessonsPackage, lessonPackages);
                 }
 
+                /**
+                 * @brief Constructs a package with the lessons touched by a batch of changes.
+                 * @param lessons The touched lessons which still exist.
+                 * @param changedLessonIds IDs of all touched lessons, the ones missing from the lessons were removed.
+                 */
+                LessonDataPackage(const std::vector<Lesson>& lessons, const std::vector<int>& changedLessonIds) : LessonDataPackage(lessons)
+                {
+                    set(gui::widget::LessonPackageKey::Type, LessonPackageType::LessonsChanged);
+                    set(gui::widget::LessonPackageKey::ChangedLessonIds, changedLessonIds);
+                }
+
+                /**
+                 * @brief Checks whether the package only holds the lessons touched by a batch of changes.
+                 * @return True for a package of changed lessons, false for the whole library.
+                 */
+                bool isChange() const
+                {
+                    return get<LessonPackageType>(LessonPackageKey::Type) == LessonPackageType::LessonsChanged;
+                }
+
+                /**
+                 * @brief Gets the IDs of all lessons a package of changed lessons covers.
+                 * @return The lesson IDs, empty for the whole library.
+                 */
+                std::vector<int> decodeChangedLessonIds() const
+                {
+                    return get<std::vector<int>>(LessonPackageKey::ChangedLessonIds);
+                }
+
                 /**
                 * Desc
                 *
@@ -127,6 +166,7 @@ namespace tadaima
                 */
                 std::vector<Lesson> decode() const
                 {
+                    AllocationScope scope(AllocationTag::Packages);
                     std::vector<Lesson> lessons;
                     auto lessonPackages = get<std::vector<LessonPackage>>(LessonPackageKey::LessonsPackage);
 
@@ -143,10 +183,13 @@ namespace tadaima
                             Word word;
                             word.id = wordPackage.get<int>(LessonWordDataKey::id);
                             word.kana = wordPackage.get<std::string>(LessonWordDataKey::Kana);
+                            word.kanji = wordPackage.get<std::string>(LessonWordDataKey::Kanji);
                             word.translation = wordPackage.get<std::string>(LessonWordDataKey::Translation);
                             word.romaji = wordPackage.get<std::string>(LessonWordDataKey::Romaji);
                             word.exampleSentence = wordPackage.get<std::string>(LessonWordDataKey::ExampleSentence);
                             word.tags = wordPackage.get<std::vector<std::string>>(LessonWordDataKey::Tags);
+                            word.clozeStart = wordPackage.get<int>(LessonWordDataKey::ClozeStart);
+                            word.clozeLength = wordPackage.get<int>(LessonWordDataKey::ClozeLength);
 
                             lesson.words.push_back(word);
                         }
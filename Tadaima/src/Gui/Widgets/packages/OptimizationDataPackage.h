@@ -0,0 +1,49 @@
+/**
+ * @file OptimizationDataPackage.h
+ * @brief Defines the OptimizationDataPackage class reporting progress of memory model fitting.
+ */
+
+#pragma once
+
+#include "PackageType.h"
+#include "Tools/DataPackage.h"
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace widget
+        {
+            /**
+             * @brief Enum class for package keys used in optimization data packages.
+             */
+            enum class OptimizationPackageKey : uint32_t
+            {
+                Running,    /**< Key for the flag telling if fitting is in progress. */
+                Progress,   /**< Key for the progress of fitting in range [0, 1]. */
+                Loss        /**< Key for the current mean log loss. */
+            };
+
+            /**
+             * @brief Represents a package with the progress of memory model fitting.
+             */
+            class OptimizationDataPackage : public tools::ComplexDataPackage<OptimizationPackageKey, bool, float>
+            {
+            public:
+
+                /**
+                 * @brief Constructs an OptimizationDataPackage object.
+                 * @param running True if fitting is in progress.
+                 * @param progress Progress of fitting in range [0, 1].
+                 * @param loss The current mean log loss.
+                 */
+                OptimizationDataPackage(bool running, float progress, float loss) : ComplexDataPackage(PackageType::Optimization)
+                {
+                    set(OptimizationPackageKey::Running, running);
+                    set(OptimizationPackageKey::Progress, progress);
+                    set(OptimizationPackageKey::Loss, loss);
+                }
+            };
+        }
+    }
+}
@@ -24,7 +24,14 @@ namespace tadaima
                 VocabularySettings = 3,     ///< ID for the vocabulary settings widget.*/
                 Lessons = 0,
                 Settings = 1,    ///< ID for the application settings widget.
-                None = 2
+                None = 2,
+                Reviews = 3,     ///< ID for the package with answers given during quizzes.
+                Forecast = 4,    ///< ID for the package with the review forecast.
+                Optimization = 5, ///< ID for the package with the progress of memory model fitting.
+                Deck = 6,        ///< ID for the package describing a deck pack to import or export.
+                Words = 7,       ///< ID for the package with a change of marked words.
+                Confusions = 8,  ///< ID for the package with the words mixed up in quizzes.
+                CommitResults = 9 ///< ID for the package with the outcome of committed lesson changes.
             };
 
         }
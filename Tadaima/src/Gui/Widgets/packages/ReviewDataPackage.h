@@ -0,0 +1,59 @@
+/**
+ * @file ReviewDataPackage.h
+ * @brief Defines the ReviewDataPackage class carrying answers given during quizzes.
+ */
+
+#pragma once
+
+#include "PackageType.h"
+#include "Tools/DataPackage.h"
+#include "review/Review.h"
+#include <vector>
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace widget
+        {
+            /**
+             * @brief Enum class for package keys used in review data packages.
+             */
+            enum class ReviewPackageKey : uint32_t
+            {
+                Reviews     /**< Key for the list of reviews. */
+            };
+
+            /**
+             * @brief Represents a package containing reviews of words.
+             */
+            class ReviewDataPackage : public tools::ComplexDataPackage<ReviewPackageKey, std::vector<review::ReviewRecord>>
+            {
+            public:
+
+                /**
+                 * @brief Constructs an empty ReviewDataPackage object.
+                 */
+                ReviewDataPackage() : ComplexDataPackage(PackageType::Reviews) {}
+
+                /**
+                 * @brief Constructs a ReviewDataPackage object with the given reviews.
+                 * @param reviews The reviews stored in the package.
+                 */
+                ReviewDataPackage(const std::vector<review::ReviewRecord>& reviews) : ComplexDataPackage(PackageType::Reviews)
+                {
+                    set(ReviewPackageKey::Reviews, reviews);
+                }
+
+                /**
+                 * @brief Gets the reviews stored in the package.
+                 * @return A vector containing the reviews.
+                 */
+                std::vector<review::ReviewRecord> decode() const
+                {
+                    return get<std::vector<review::ReviewRecord>>(ReviewPackageKey::Reviews);
+                }
+            };
+        }
+    }
+}
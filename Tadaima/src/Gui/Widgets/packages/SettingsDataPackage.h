@@ -11,6 +11,8 @@
 #include <cstring>
 #include <string>
 #include "Application/ApplicationSettings.h"
+#include "review/MemoryModel.h"
+#include "review/LeechDetector.h"
 
 namespace tools { class Logger; }
 
@@ -30,13 +32,19 @@ namespace tadaima
                 QuizzesScriptsPath,     /**< Key for scripted quizes path. */
                 AskedWordType,          /**< Key for input word. */
                 AnswerWordType,         /**< Key for translated word. */
-                ShowLogs                /**< Key for showing console logs */
+                ShowLogs,               /**< Key for showing console logs */
+                MemoryModel,            /**< Key for memory model parameters. */
+                FrequencyListPath,      /**< Key for word frequency list path. */
+                FrequencyOrder,         /**< Key for asking the most common words first. */
+                AdaptiveOrder,          /**< Key for asking the words answered wrong more often. */
+                Leech,                  /**< Key for leech detection thresholds. */
+                GroupCommit             /**< Key for the group commit window and size limit. */
             };
 
             /**
              * @brief Represents a package containing settings data.
              */
-            class SettingsDataPackage : public tools::ComplexDataPackage<SettingsPackageKey, bool, std::string, quiz::WordType>
+            class SettingsDataPackage : public tools::ComplexDataPackage<SettingsPackageKey, bool, std::string, quiz::WordType, review::MemoryModelParameters, review::LeechOptions, application::GroupCommitOptions>
             {
             public:
 
@@ -0,0 +1,53 @@
+/**
+ * @file WordOperationDataPackage.h
+ * @brief Defines the WordOperationDataPackage class carrying a change of a selection of words.
+ */
+
+#pragma once
+
+#include "PackageType.h"
+#include "Tools/DataPackage.h"
+#include "lessons/Lesson.h"
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace widget
+        {
+            /**
+             * @brief Enum class for package keys used in word operation data packages.
+             */
+            enum class WordOperationPackageKey : uint32_t
+            {
+                Operation   /**< Key for the change of the words. */
+            };
+
+            /**
+             * @brief Represents a package asking to move, copy, delete or retag marked words.
+             */
+            class WordOperationDataPackage : public tools::ComplexDataPackage<WordOperationPackageKey, WordOperation>
+            {
+            public:
+
+                /**
+                 * @brief Constructs a WordOperationDataPackage object with the given change.
+                 * @param operation The change stored in the package.
+                 */
+                explicit WordOperationDataPackage(const WordOperation& operation) : ComplexDataPackage(PackageType::Words)
+                {
+                    set(WordOperationPackageKey::Operation, operation);
+                }
+
+                /**
+                 * @brief Gets the change stored in the package.
+                 * @return The change of the words.
+                 */
+                WordOperation decode() const
+                {
+                    return get<WordOperation>(WordOperationPackageKey::Operation);
+                }
+            };
+        }
+    }
+}
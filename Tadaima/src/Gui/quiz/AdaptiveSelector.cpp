@@ -0,0 +1,117 @@
+#include "AdaptiveSelector.h"
+#include <algorithm>
+#include <bit>
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace quiz
+        {
+            AdaptiveSelector::AdaptiveSelector(std::size_t cardCount)
+                : m_cards(cardCount), m_weights(cardCount, errorWeight(0, 0)), m_tree(cardCount + 1, 0)
+            {
+                // Every node passes its sum on to its parent, which builds the tree in linear time
+                for( std::size_t node = 1; node <= cardCount; ++node )
+                {
+                    m_tree[node] += m_weights[node - 1];
+                    const std::size_t parent = node + (node & (~node + 1));
+                    if( parent <= cardCount )
+                    {
+                        m_tree[parent] += m_tree[node];
+                    }
+                    m_totalWeight += m_weights[node - 1];
+                }
+            }
+
+            void AdaptiveSelector::recordAnswer(std::size_t card, bool correct)
+            {
+                CardState& state = m_cards[card];
+                ++(correct ? state.goodAttempts : state.badAttempts);
+                ++state.recent;
+                m_recentCards.push_back(card);
+                refresh(card);
+
+                if( m_recentCards.size() > RECENT_CARDS )
+                {
+                    const std::size_t released = m_recentCards.front();
+                    m_recentCards.pop_front();
+                    --m_cards[released].recent;
+                    refresh(released);
+                }
+            }
+
+            void AdaptiveSelector::setAttempts(std::size_t card, int goodAttempts, int badAttempts)
+            {
+                m_cards[card].goodAttempts = goodAttempts;
+                m_cards[card].badAttempts = badAttempts;
+                refresh(card);
+            }
+
+            void AdaptiveSelector::retire(std::size_t card)
+            {
+                m_cards[card].retired = true;
+                refresh(card);
+            }
+
+            std::size_t AdaptiveSelector::find(uint64_t point) const
+            {
+                // Descends the tree, skipping every subtree whose weights all lie before the point
+                std::size_t node = 0;
+                for( std::size_t step = std::bit_floor(m_cards.size()); step > 0; step >>= 1 )
+                {
+                    if( node + step < m_tree.size() && m_tree[node + step] <= point )
+                    {
+                        node += step;
+                        point -= m_tree[node];
+                    }
+                }
+                return std::min(node, m_cards.size() - 1);
+            }
+
+            uint32_t AdaptiveSelector::weight(std::size_t card) const
+            {
+                return m_weights[card];
+            }
+
+            uint64_t AdaptiveSelector::totalWeight() const
+            {
+                return m_totalWeight;
+            }
+
+            std::size_t AdaptiveSelector::size() const
+            {
+                return m_cards.size();
+            }
+
+            uint32_t AdaptiveSelector::errorWeight(int goodAttempts, int badAttempts)
+            {
+                const int64_t attempts = static_cast<int64_t>(goodAttempts) + badAttempts + 2;
+                return static_cast<uint32_t>(std::max<int64_t>(1, WEIGHT_SCALE * (static_cast<int64_t>(badAttempts) + 1) / attempts));
+            }
+
+            void AdaptiveSelector::refresh(std::size_t card)
+            {
+                const CardState& state = m_cards[card];
+                uint32_t weight = 0;
+                if( !state.retired )
+                {
+                    weight = errorWeight(state.goodAttempts, state.badAttempts);
+                    if( state.recent > 0 )
+                    {
+                        weight = std::max<uint32_t>(1, weight / RECENT_DIVISOR);
+                    }
+                }
+
+                // Unsigned arithmetic wraps, so adding the difference also lowers the sums
+                const uint64_t delta = static_cast<uint64_t>(weight) - m_weights[card];
+                m_weights[card] = weight;
+                m_totalWeight += delta;
+                for( std::size_t node = card + 1; node < m_tree.size(); node += node & (~node + 1) )
+                {
+                    m_tree[node] += delta;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,142 @@
+/**
+ * @file AdaptiveSelector.h
+ * @brief Declares the AdaptiveSelector class which draws quiz cards weighted by their error rate and recency.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <random>
+#include <vector>
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace quiz
+        {
+            /**
+             * @brief The AdaptiveSelector class draws the next card of a quiz with a chance proportional to its weight.
+             *
+             * The weight of a card grows with its share of wrong answers and drops for the cards asked in the last few
+             * questions, so weak words come up more often without being repeated at once. Retired cards are never drawn.
+             * The weights are integers kept in a Fenwick tree, so drawing a card and changing a weight both take
+             * O(log n) and the sums stay exact however many answers are recorded.
+             */
+            class AdaptiveSelector
+            {
+            public:
+                static constexpr std::size_t NONE = static_cast<std::size_t>(-1); /**< Returned when every card is retired. */
+                static constexpr uint32_t WEIGHT_SCALE = 1000; /**< Weight of a card which is always answered wrong. */
+                static constexpr std::size_t RECENT_CARDS = 3; /**< Number of last answered cards which are held back. */
+                static constexpr uint32_t RECENT_DIVISOR = 8; /**< Factor by which the weight of a held back card is reduced. */
+
+                /**
+                 * @brief Constructs a selector over cards which were not asked yet.
+                 * @param cardCount Number of cards.
+                 */
+                explicit AdaptiveSelector(std::size_t cardCount = 0);
+
+                /**
+                 * @brief Counts an answer to a card, updates its weight and holds it back for the next questions.
+                 * @param card Index of the card.
+                 * @param correct True if the answer was correct.
+                 */
+                void recordAnswer(std::size_t card, bool correct);
+
+                /**
+                 * @brief Sets the answer counts of a card without holding it back, to restore a saved quiz.
+                 * @param card Index of the card.
+                 * @param goodAttempts Number of correct answers.
+                 * @param badAttempts Number of wrong answers.
+                 */
+                void setAttempts(std::size_t card, int goodAttempts, int badAttempts);
+
+                /**
+                 * @brief Stops drawing a card, e.g. because its word was learnt.
+                 * @param card Index of the card.
+                 */
+                void retire(std::size_t card);
+
+                /**
+                 * @brief Draws the next card.
+                 * @param generator Random number generator.
+                 * @return Index of the card, or NONE if every card is retired.
+                 */
+                template<typename Generator>
+                std::size_t next(Generator& generator) const
+                {
+                    if( m_totalWeight == 0 )
+                    {
+                        return NONE;
+                    }
+                    return find(std::uniform_int_distribution<uint64_t>(0, m_totalWeight - 1)(generator));
+                }
+
+                /**
+                 * @brief Finds the card whose range of the cumulative weights contains a point.
+                 * @param point A value below totalWeight().
+                 * @return Index of the card.
+                 */
+                std::size_t find(uint64_t point) const;
+
+                /**
+                 * @brief Gets the current weight of a card.
+                 * @param card Index of the card.
+                 * @return The weight, 0 for a retired card.
+                 */
+                uint32_t weight(std::size_t card) const;
+
+                /**
+                 * @brief Gets the sum of all weights.
+                 * @return The total weight.
+                 */
+                uint64_t totalWeight() const;
+
+                /**
+                 * @brief Gets the number of cards.
+                 * @return The number of cards.
+                 */
+                std::size_t size() const;
+
+                /**
+                 * @brief Computes the weight of a card from its answers.
+                 *
+                 * The share of wrong answers is smoothed, so a new card weighs half of WEIGHT_SCALE and a single answer
+                 * does not decide its weight. Every card keeps a weight of at least 1.
+                 *
+                 * @param goodAttempts Number of correct answers.
+                 * @param badAttempts Number of wrong answers.
+                 * @return The weight.
+                 */
+                static uint32_t errorWeight(int goodAttempts, int badAttempts);
+
+            private:
+                /**
+                 * @brief Answer counts of a card.
+                 */
+                struct CardState
+                {
+                    int goodAttempts = 0;   /**< Number of correct answers. */
+                    int badAttempts = 0;    /**< Number of wrong answers. */
+                    uint8_t recent = 0;     /**< Number of times the card is among the last answered cards. */
+                    bool retired = false;   /**< True if the card is never drawn. */
+                };
+
+                /**
+                 * @brief Recomputes the weight of a card from its state.
+                 * @param card Index of the card.
+                 */
+                void refresh(std::size_t card);
+
+                std::vector<CardState> m_cards; /**< State of every card. */
+                std::vector<uint32_t> m_weights; /**< Current weight of every card. */
+                std::vector<uint64_t> m_tree; /**< Fenwick tree of the weights, 1-based. */
+                uint64_t m_totalWeight = 0; /**< Sum of all weights. */
+                std::deque<std::size_t> m_recentCards; /**< Last answered cards, oldest first. */
+            };
+        }
+    }
+}
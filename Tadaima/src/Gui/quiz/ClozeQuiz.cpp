@@ -0,0 +1,131 @@
+#include "ClozeQuiz.h"
+#include "lessons/ClozeLocator.h"
+#include "lessons/FrequencyTable.h"
+#include "tools/JapaneseText.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace quiz
+        {
+            ClozeQuiz::ClozeQuiz(const std::vector<Lesson>& lessons, QuizOrder order, uint32_t seed)
+                : m_engine(std::in_place_type<SequentialEngine>, std::vector<Word>(), seed)
+            {
+                // Spans are stored with the words, only words edited since they were loaded are searched here
+                std::vector<Word> words = collectWords(lessons);
+                for( auto& word : words )
+                {
+                    if( word.clozeLength < 0 )
+                    {
+                        ClozeLocator::locate(word);
+                    }
+                }
+                std::erase_if(words, [](const Word& word) { return !ClozeLocator::hasCloze(word); });
+                if( words.empty() )
+                {
+                    throw std::invalid_argument("No word appears in its example sentence.");
+                }
+
+                std::mt19937 rng(seed);
+                std::shuffle(words.begin(), words.end(), rng);
+                if( QuizOrder::Frequency == order )
+                {
+                    std::stable_sort(words.begin(), words.end(), FrequencyTable::isMoreCommon);
+                }
+                m_cards = makeCards(words);
+
+                if( QuizOrder::Adaptive == order )
+                {
+                    m_engine.emplace<AdaptiveEngine>(std::move(words), rng());
+                }
+                else
+                {
+                    m_engine.emplace<SequentialEngine>(std::move(words), rng());
+                }
+            }
+
+            std::vector<ClozeCard> ClozeQuiz::makeCards(const std::vector<Word>& words)
+            {
+                std::vector<ClozeCard> cards;
+                cards.reserve(words.size());
+                for( const auto& word : words )
+                {
+                    if( !ClozeLocator::hasCloze(word) )
+                    {
+                        continue;
+                    }
+
+                    ClozeCard card;
+                    card.wordId = word.id;
+                    card.sentence = ClozeLocator::blank(word);
+                    card.answer = std::string(ClozeLocator::answer(word));
+                    card.translation = word.translation;
+                    for( std::string_view spelling : { std::string_view(card.answer), std::string_view(word.kana), std::string_view(word.kanji), std::string_view(word.romaji) } )
+                    {
+                        std::string accepted = normalizeJapanese(spelling);
+                        if( !accepted.empty() && std::find(card.accepted.begin(), card.accepted.end(), accepted) == card.accepted.end() )
+                        {
+                            card.accepted.push_back(std::move(accepted));
+                        }
+                    }
+                    cards.push_back(std::move(card));
+                }
+                return cards;
+            }
+
+            void ClozeQuiz::start()
+            {
+                std::visit([](auto& engine) { engine.start(); }, m_engine);
+            }
+
+            bool ClozeQuiz::submit(const std::string& response)
+            {
+                if( isFinished() )
+                {
+                    return false;
+                }
+
+                const std::vector<std::string>& accepted = currentCard().accepted;
+                const bool correct = std::find(accepted.begin(), accepted.end(), normalizeJapanese(response)) != accepted.end();
+                std::visit([correct](auto& engine) { engine.submitOutcome(correct); }, m_engine);
+                return correct;
+            }
+
+            bool ClozeQuiz::isFinished() const
+            {
+                return std::visit([](const auto& engine) { return engine.isFinished(); }, m_engine);
+            }
+
+            const ClozeCard& ClozeQuiz::currentCard() const
+            {
+                return m_cards[std::visit([](const auto& engine) { return engine.currentIndex(); }, m_engine)];
+            }
+
+            std::size_t ClozeQuiz::asked() const
+            {
+                return std::visit([](const auto& engine) { return engine.asked(); }, m_engine);
+            }
+
+            std::size_t ClozeQuiz::correctCount() const
+            {
+                return std::visit([](const auto& engine) { return engine.scoring().correctCount(); }, m_engine);
+            }
+
+            std::size_t ClozeQuiz::questionCount() const
+            {
+                return m_cards.size();
+            }
+
+            std::string ClozeQuiz::getResults() const
+            {
+                std::ostringstream oss;
+                oss << "Quiz finished!\nYou got " << correctCount() << " out of " << questionCount() << " correct!";
+                return oss.str();
+            }
+        }
+    }
+}
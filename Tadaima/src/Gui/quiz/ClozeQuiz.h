@@ -0,0 +1,122 @@
+/**
+ * @file ClozeQuiz.h
+ * @brief Declares the ClozeQuiz class asking words blanked in their example sentences.
+ */
+
+#pragma once
+
+#include "QuizEngine.h"
+#include "QuizType.h"
+#include "lessons/Lesson.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace quiz
+        {
+            /**
+             * @brief A question of a cloze quiz.
+             */
+            struct ClozeCard
+            {
+                int wordId = -1; /**< ID of the blanked word. */
+                std::string sentence; /**< Example sentence with the word replaced by a blank. */
+                std::string answer; /**< Text of the sentence covered by the blank. */
+                std::string translation; /**< Translation of the word, shown as a hint. */
+                std::vector<std::string> accepted; /**< Normalized answers counted as correct. */
+            };
+
+            /**
+             * @class ClozeQuiz
+             * @brief Asks the learner to fill in words blanked in their example sentences.
+             *
+             * Words carry the span of their spelling within the sentence, located by ClozeLocator when they were
+             * stored, so creating the quiz only cuts the sentences; words stored without a span are located once here.
+             * Words whose sentence does not contain them are left out.
+             *
+             * Besides the blanked text, the kana, kanji and romaji of the word are accepted, compared after
+             * normalizeJapanese(). The questions are run by a QuizEngine like in a multiple choice quiz.
+             */
+            class ClozeQuiz
+            {
+            public:
+                /**
+                 * @brief Constructs a cloze quiz; start() asks the first question.
+                 * @param lessons The lessons whose words are asked.
+                 * @param order The order in which the words are asked.
+                 * @param seed Seed of the random number generator.
+                 * @throws std::invalid_argument If no word appears in its example sentence.
+                 */
+                ClozeQuiz(const std::vector<Lesson>& lessons, QuizOrder order = QuizOrder::Random, uint32_t seed = std::random_device{}());
+
+                /**
+                 * @brief Creates the cards of the words which appear in their example sentences.
+                 * @param words The words.
+                 * @return The cards, in the order of the words.
+                 */
+                static std::vector<ClozeCard> makeCards(const std::vector<Word>& words);
+
+                /**
+                 * @brief Starts the quiz over with the first question.
+                 */
+                void start();
+
+                /**
+                 * @brief Answers the current question and moves to the next one.
+                 * @param response The text typed into the blank.
+                 * @return True if the answer was correct.
+                 */
+                bool submit(const std::string& response);
+
+                /**
+                 * @brief Checks if the quiz is over.
+                 * @return True if there is no question left.
+                 */
+                bool isFinished() const;
+
+                /**
+                 * @brief Gets the current question.
+                 * @return The card of the current word.
+                 */
+                const ClozeCard& currentCard() const;
+
+                /**
+                 * @brief Gets the number of answered questions.
+                 * @return The number of answers.
+                 */
+                std::size_t asked() const;
+
+                /**
+                 * @brief Gets the number of correct answers.
+                 * @return The number of correct answers.
+                 */
+                std::size_t correctCount() const;
+
+                /**
+                 * @brief Gets the number of questions of the quiz.
+                 * @return The number of cards.
+                 */
+                std::size_t questionCount() const;
+
+                /**
+                 * @brief Gets a summary of the answers.
+                 * @return The results.
+                 */
+                std::string getResults() const;
+
+            private:
+                using SequentialEngine = QuizEngine<KanaField, KanaField, SequentialSelection>; /**< Engine of shuffled and frequency order. */
+                using AdaptiveEngine = QuizEngine<KanaField, KanaField, AdaptiveSelection>; /**< Engine of adaptive order. */
+
+                std::vector<ClozeCard> m_cards; /**< Cards in the order of the words of the engine. */
+                std::variant<SequentialEngine, AdaptiveEngine> m_engine; /**< Picks the questions and counts the answers. */
+            };
+        }
+    }
+}
@@ -0,0 +1,493 @@
+#include "LearnerSimulator.h"
+#include "MultipleChoiceQuiz.h"
+#include "VocabularyQuiz.h"
+#include "tools/AllocationTracker.h"
+#include "Tools/Logger.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace quiz
+        {
+            namespace
+            {
+                using Clock = std::chrono::steady_clock;
+
+                constexpr std::size_t LESSON_SIZE = 100;
+                constexpr std::size_t COMPLETION_ANSWERS = 2; // Distinct answers of the deck played to the end
+                constexpr double ACCURACY_SPREAD = 0.1;
+                constexpr double MIN_ACCURACY = 0.05;
+                constexpr double PRIOR_STUDY = 3.0; // Forgetting spans within which familiar words were studied
+                constexpr double NS_PER_US = 1000.0;
+                constexpr auto WATCHDOG_INTERVAL = std::chrono::milliseconds(50);
+
+                /**
+                 * @brief A synthetic learner recalling words along an exponential forgetting curve.
+                 */
+                class Learner
+                {
+                public:
+                    Learner(double accuracy, double forgetting, double familiarity, uint32_t seed)
+                        : m_accuracy(accuracy), m_forgetting(forgetting), m_familiarity(familiarity), m_rng(seed)
+                    {
+                    }
+
+                    /**
+                     * @brief Asks the learner for a word, which counts as one question on the forgetting curve.
+                     *
+                     * A word met for the first time was studied before with the chance of the familiarity, at a random
+                     * point up to PRIOR_STUDY forgetting spans ago.
+                     */
+                    bool recalls(int wordId)
+                    {
+                        ++m_clock;
+                        auto it = m_memory.find(wordId);
+                        if( it == m_memory.end() )
+                        {
+                            if( chance() >= m_familiarity )
+                            {
+                                return false;
+                            }
+                            const int64_t studied = m_clock - static_cast<int64_t>(chance() * PRIOR_STUDY * m_forgetting);
+                            it = m_memory.emplace(wordId, Memory{ studied, 0 }).first;
+                        }
+                        const double gap = static_cast<double>(m_clock - it->second.lastSeen);
+                        const double recall = m_accuracy * std::exp(-gap / (m_forgetting * (1 + it->second.successes)));
+                        return chance() < recall;
+                    }
+
+                    /**
+                     * @brief Shows the learner the right answer of a word.
+                     */
+                    void learn(int wordId, bool correct)
+                    {
+                        Memory& memory = m_memory[wordId];
+                        memory.lastSeen = m_clock;
+                        memory.successes += correct ? 1 : 0;
+                    }
+
+                    std::size_t guess(std::size_t options)
+                    {
+                        return std::uniform_int_distribution<std::size_t>(0, options - 1)(m_rng);
+                    }
+
+                private:
+                    /**
+                     * @brief What the learner remembers of a word.
+                     */
+                    struct Memory
+                    {
+                        int64_t lastSeen = 0;
+                        int successes = 0;
+                    };
+
+                    double chance()
+                    {
+                        return std::uniform_real_distribution<double>(0.0, 1.0)(m_rng);
+                    }
+
+                    double m_accuracy;
+                    double m_forgetting;
+                    double m_familiarity;
+                    std::mt19937 m_rng;
+                    int64_t m_clock = 0;
+                    std::unordered_map<int, Memory> m_memory;
+                };
+
+                /**
+                 * @brief Raw measurements of one engine.
+                 */
+                struct Samples
+                {
+                    std::vector<int64_t> setup;
+                    std::vector<int64_t> answer;
+                    std::size_t correct = 0;
+                    std::size_t invalidOptionSets = 0;
+                    uint64_t allocations = 0;
+                    uint64_t allocatedBytes = 0;
+                    uint64_t quizBytes = 0;
+
+                    double meanAnswerNs() const
+                    {
+                        return answer.empty() ? 0.0 : static_cast<double>(std::accumulate(answer.begin(), answer.end(), int64_t{ 0 })) / answer.size();
+                    }
+                };
+
+                /**
+                 * @brief State shared with the worker thread, which outlives the simulator if an engine never returns.
+                 */
+                struct SharedState
+                {
+                    SimulationOptions options;
+                    SimulationReport report;
+                    std::atomic<uint64_t> progress{ 0 };
+                    std::atomic<const char*> engine{ "" };
+                    tools::Logger logger;
+                };
+
+                int64_t elapsedNs(Clock::time_point start)
+                {
+                    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+                }
+
+                LatencyStats summarize(std::vector<int64_t> samples)
+                {
+                    LatencyStats stats;
+                    stats.samples = samples.size();
+                    if( samples.empty() )
+                    {
+                        return stats;
+                    }
+                    std::sort(samples.begin(), samples.end());
+                    stats.meanUs = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size() / NS_PER_US;
+                    stats.p50Us = samples[samples.size() / 2] / NS_PER_US;
+                    stats.p99Us = samples[std::min(samples.size() - 1, samples.size() * 99 / 100)] / NS_PER_US;
+                    stats.maxUs = samples.back() / NS_PER_US;
+                    return stats;
+                }
+
+                Learner makeLearner(const SimulationOptions& options, std::size_t index)
+                {
+                    std::mt19937 rng(options.seed + static_cast<uint32_t>(index));
+                    const double accuracy = std::clamp(std::normal_distribution<double>(options.accuracy, ACCURACY_SPREAD)(rng), MIN_ACCURACY, 1.0);
+                    const double forgetting = std::max(1.0, options.forgetting * std::uniform_real_distribution<double>(0.5, 1.5)(rng));
+                    return Learner(accuracy, forgetting, options.familiarity, static_cast<uint32_t>(rng()));
+                }
+
+                // Learners are asked the kana and answer the translation, like in the multiple choice quizzes
+                std::unique_ptr<VocabularyQuiz> makeQuiz(std::vector<Word> words, int requiredCorrectAnswers, bool shuffle, bool adaptive)
+                {
+                    if( adaptive )
+                    {
+                        return makeVocabularyQuiz<KanaField, TranslationField, AdaptiveSelection>(std::move(words), requiredCorrectAnswers);
+                    }
+                    if( shuffle )
+                    {
+                        return makeVocabularyQuiz<KanaField, TranslationField, RandomSelection>(std::move(words), requiredCorrectAnswers);
+                    }
+                    return makeVocabularyQuiz<KanaField, TranslationField, SequentialSelection>(std::move(words), requiredCorrectAnswers);
+                }
+
+                std::unordered_map<int, std::string> toTranslations(const std::vector<Lesson>& deck)
+                {
+                    std::unordered_map<int, std::string> translations;
+                    for( const auto& lesson : deck )
+                    {
+                        for( const auto& word : lesson.words )
+                        {
+                            translations.emplace(word.id, word.translation);
+                        }
+                    }
+                    return translations;
+                }
+
+                QuizOrder simulatedOrder(const SimulationOptions& options)
+                {
+                    return options.adaptive ? QuizOrder::Adaptive : QuizOrder::Random;
+                }
+
+                MultipleChoiceQuiz::SessionFactory multipleChoiceFactory(const SimulationOptions& options)
+                {
+                    if( options.adaptive )
+                    {
+                        return &makeMultipleChoiceSession<KanaField, TranslationField, AdaptiveSelection>;
+                    }
+                    return &makeMultipleChoiceSession<KanaField, TranslationField, SequentialSelection>;
+                }
+
+                bool isValidOptionSet(const std::vector<std::string>& options, int correctIndex, const std::string& expected)
+                {
+                    const std::unordered_set<std::string> distinct(options.begin(), options.end());
+                    return options.size() == MultipleChoiceQuiz::OPTION_COUNT && distinct.size() == options.size()
+                        && correctIndex >= 0 && correctIndex < static_cast<int>(options.size()) && options[correctIndex] == expected;
+                }
+
+                Samples playVocabulary(SharedState& state, const std::vector<Lesson>& deck, std::size_t learners)
+                {
+                    const SimulationOptions& options = state.options;
+                    const std::vector<Word> words = collectWords(deck);
+                    Samples samples;
+                    samples.answer.reserve(learners * options.answersPerLearner);
+
+                    for( std::size_t index = 0; index < learners; ++index )
+                    {
+                        Learner learner = makeLearner(options, index);
+                        const AllocationStats beforeSetup = AllocationTracker::stats(AllocationTag::Quiz);
+                        const auto setupStart = Clock::now();
+                        std::unique_ptr<VocabularyQuiz> quiz;
+                        {
+                            AllocationScope scope(AllocationTag::Quiz);
+                            quiz = makeQuiz(words, options.requiredCorrectAnswers, true, options.adaptive);
+                        }
+                        samples.setup.push_back(elapsedNs(setupStart));
+                        const AllocationStats afterSetup = AllocationTracker::stats(AllocationTag::Quiz);
+                        samples.quizBytes = std::max(samples.quizBytes, afterSetup.liveBytes() - beforeSetup.liveBytes());
+                        state.progress.fetch_add(1, std::memory_order_relaxed);
+
+                        for( std::size_t answer = 0; answer < options.answersPerLearner && !quiz->isQuizComplete(); ++answer )
+                        {
+                            const int wordId = quiz->getCurrentWord().id;
+                            const std::string response = learner.recalls(wordId) ? quiz->getExpectedAnswer() : std::string();
+                            bool correct = false;
+                            {
+                                AllocationScope scope(AllocationTag::Quiz);
+                                const auto start = Clock::now();
+                                correct = quiz->advance(response);
+                                samples.answer.push_back(elapsedNs(start));
+                            }
+                            learner.learn(wordId, correct);
+                            samples.correct += correct ? 1 : 0;
+                            state.progress.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        const AllocationStats afterAnswers = AllocationTracker::stats(AllocationTag::Quiz);
+                        samples.allocations += afterAnswers.allocations - afterSetup.allocations;
+                        samples.allocatedBytes += afterAnswers.bytes - afterSetup.bytes;
+                    }
+                    return samples;
+                }
+
+                Samples playMultipleChoice(SharedState& state, const std::vector<Lesson>& deck, std::size_t learners)
+                {
+                    const SimulationOptions& options = state.options;
+                    const std::unordered_map<int, std::string> translations = toTranslations(deck);
+                    Samples samples;
+                    samples.answer.reserve(learners * options.answersPerLearner);
+
+                    for( std::size_t index = 0; index < learners; ++index )
+                    {
+                        Learner learner = makeLearner(options, index);
+                        const AllocationStats beforeSetup = AllocationTracker::stats(AllocationTag::Quiz);
+                        const auto setupStart = Clock::now();
+                        std::unique_ptr<MultipleChoiceQuiz> quiz;
+                        {
+                            AllocationScope scope(AllocationTag::Quiz);
+                            quiz = std::make_unique<MultipleChoiceQuiz>(multipleChoiceFactory(options), deck, state.logger, simulatedOrder(options));
+                            quiz->start();
+                        }
+                        samples.setup.push_back(elapsedNs(setupStart));
+                        const AllocationStats afterSetup = AllocationTracker::stats(AllocationTag::Quiz);
+                        samples.quizBytes = std::max(samples.quizBytes, afterSetup.liveBytes() - beforeSetup.liveBytes());
+                        state.progress.fetch_add(1, std::memory_order_relaxed);
+
+                        for( std::size_t answer = 0; answer < options.answersPerLearner && !quiz->isFinished(); ++answer )
+                        {
+                            const int wordId = quiz->getCurrentWordId();
+                            const int correctIndex = quiz->getCorrectAnswerIndex();
+                            if( !isValidOptionSet(quiz->getCurrentOptions(), correctIndex, translations.at(wordId)) )
+                            {
+                                ++samples.invalidOptionSets;
+                            }
+                            const std::size_t choice = learner.recalls(wordId) ? static_cast<std::size_t>(correctIndex) : learner.guess(MultipleChoiceQuiz::OPTION_COUNT);
+                            {
+                                AllocationScope scope(AllocationTag::Quiz);
+                                const auto start = Clock::now();
+                                quiz->advance(static_cast<char>('a' + choice));
+                                samples.answer.push_back(elapsedNs(start));
+                            }
+                            const bool correct = choice == static_cast<std::size_t>(correctIndex);
+                            learner.learn(wordId, correct);
+                            samples.correct += correct ? 1 : 0;
+                            state.progress.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        const AllocationStats afterAnswers = AllocationTracker::stats(AllocationTag::Quiz);
+                        samples.allocations += afterAnswers.allocations - afterSetup.allocations;
+                        samples.allocatedBytes += afterAnswers.bytes - afterSetup.bytes;
+                    }
+                    return samples;
+                }
+
+                /**
+                 * @brief Plays quizzes without mistakes to the end, alternating shuffled and ordered vocabulary quizzes.
+                 */
+                void checkCompletion(SharedState& state, EngineReport& vocabulary, EngineReport& multipleChoice)
+                {
+                    const SimulationOptions& options = state.options;
+                    const std::vector<Lesson> deck = LearnerSimulator::generateDeck(options.completionQuizSize, COMPLETION_ANSWERS, options.seed);
+                    const std::unordered_map<int, std::string> translations = toTranslations(deck);
+                    const std::vector<Word> words = collectWords(deck);
+                    const std::size_t answerLimit = options.completionQuizSize * options.maxAnswersPerWord;
+                    const std::size_t quizzes = std::min(options.learners, LearnerSimulator::COMPLETION_QUIZZES);
+
+                    state.engine = "vocabulary quiz";
+                    for( std::size_t index = 0; index < quizzes; ++index )
+                    {
+                        const std::unique_ptr<VocabularyQuiz> quiz = makeQuiz(words, options.requiredCorrectAnswers, index % 2 == 0, options.adaptive);
+                        for( std::size_t answer = 0; answer < answerLimit && !quiz->isQuizComplete(); ++answer )
+                        {
+                            quiz->advance(std::string(quiz->getExpectedAnswer()));
+                            state.progress.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        vocabulary.unfinishedQuizzes += quiz->isQuizComplete() ? 0 : 1;
+                    }
+
+                    state.engine = "multiple choice quiz";
+                    for( std::size_t index = 0; index < quizzes; ++index )
+                    {
+                        MultipleChoiceQuiz quiz(multipleChoiceFactory(options), deck, state.logger, simulatedOrder(options));
+                        quiz.start();
+                        for( std::size_t answer = 0; answer < answerLimit && !quiz.isFinished(); ++answer )
+                        {
+                            const int correctIndex = quiz.getCorrectAnswerIndex();
+                            if( !isValidOptionSet(quiz.getCurrentOptions(), correctIndex, translations.at(quiz.getCurrentWordId())) )
+                            {
+                                ++multipleChoice.invalidOptionSets;
+                            }
+                            quiz.advance(static_cast<char>('a' + correctIndex));
+                            state.progress.fetch_add(1, std::memory_order_relaxed);
+                        }
+                        multipleChoice.unfinishedQuizzes += quiz.isFinished() ? 0 : 1;
+                    }
+                }
+
+                void fillReport(EngineReport& report, const Samples& samples, const Samples& small, const Samples& large)
+                {
+                    report.answers = samples.answer.size();
+                    report.correct = samples.correct;
+                    report.setup = summarize(samples.setup);
+                    report.answer = summarize(samples.answer);
+                    report.invalidOptionSets += samples.invalidOptionSets;
+                    const double smallMean = small.meanAnswerNs();
+                    report.scaling = smallMean > 0.0 ? large.meanAnswerNs() / smallMean : 0.0;
+                    if( AllocationTracker::ENABLED && report.answers > 0 )
+                    {
+                        report.allocations = samples.allocations / report.answers;
+                        report.allocatedBytes = samples.allocatedBytes / report.answers;
+                        report.quizBytes = samples.quizBytes;
+                    }
+                }
+
+                void addProblems(SimulationReport& report, const EngineReport& engine, const SimulationOptions& options)
+                {
+                    if( engine.unfinishedQuizzes > 0 )
+                    {
+                        report.problems.push_back(std::format("{}: {} quizzes answered without mistakes did not end within {} answers per word",
+                            engine.engine, engine.unfinishedQuizzes, options.maxAnswersPerWord));
+                    }
+                    if( engine.invalidOptionSets > 0 )
+                    {
+                        report.problems.push_back(std::format("{}: {} questions with repeated options or without the correct answer", engine.engine, engine.invalidOptionSets));
+                    }
+                    if( engine.scaling > options.scalingLimit )
+                    {
+                        report.problems.push_back(std::format("{}: answer latency grows {:.1f}x on a {}x larger deck", engine.engine, engine.scaling, LearnerSimulator::SCALING_FACTOR));
+                    }
+                }
+
+                void simulate(SharedState& state)
+                {
+                    const SimulationOptions& options = state.options;
+                    SimulationReport& report = state.report;
+                    report.vocabulary.engine = "vocabulary quiz";
+                    report.multipleChoice.engine = "multiple choice quiz";
+
+                    // The bounded checks run first, so an engine which loops forever is caught before the long runs
+                    checkCompletion(state, report.vocabulary, report.multipleChoice);
+
+                    const std::vector<Lesson> deck = LearnerSimulator::generateDeck(options.deckSize, options.distinctAnswers, options.seed);
+                    const std::vector<Lesson> largeDeck = LearnerSimulator::generateDeck(options.deckSize * LearnerSimulator::SCALING_FACTOR, options.distinctAnswers * LearnerSimulator::SCALING_FACTOR, options.seed);
+                    const std::size_t probeLearners = std::min(options.learners, LearnerSimulator::SCALING_LEARNERS);
+
+                    state.engine = "vocabulary quiz";
+                    const Samples vocabulary = playVocabulary(state, deck, options.learners);
+                    const Samples vocabularySmall = playVocabulary(state, deck, probeLearners);
+                    const Samples vocabularyLarge = playVocabulary(state, largeDeck, probeLearners);
+                    fillReport(report.vocabulary, vocabulary, vocabularySmall, vocabularyLarge);
+
+                    state.engine = "multiple choice quiz";
+                    const Samples multipleChoice = playMultipleChoice(state, deck, options.learners);
+                    const Samples multipleChoiceSmall = playMultipleChoice(state, deck, probeLearners);
+                    const Samples multipleChoiceLarge = playMultipleChoice(state, largeDeck, probeLearners);
+                    fillReport(report.multipleChoice, multipleChoice, multipleChoiceSmall, multipleChoiceLarge);
+
+                    addProblems(report, report.vocabulary, options);
+                    addProblems(report, report.multipleChoice, options);
+                }
+            }
+
+            LearnerSimulator::LearnerSimulator(const SimulationOptions& options) : m_options(options)
+            {
+                if( m_options.learners == 0 || m_options.deckSize == 0 || m_options.completionQuizSize == 0 )
+                {
+                    throw std::invalid_argument("A simulation needs at least one learner and one word.");
+                }
+            }
+
+            SimulationReport LearnerSimulator::run()
+            {
+                auto state = std::make_shared<SharedState>();
+                state->options = m_options;
+
+                std::packaged_task<void()> task([state] { simulate(*state); });
+                std::future<void> done = task.get_future();
+                std::thread worker(std::move(task));
+
+                uint64_t lastProgress = state->progress.load();
+                auto lastChange = Clock::now();
+                while( done.wait_for(WATCHDOG_INTERVAL) != std::future_status::ready )
+                {
+                    const uint64_t progress = state->progress.load();
+                    if( progress != lastProgress )
+                    {
+                        lastProgress = progress;
+                        lastChange = Clock::now();
+                    }
+                    else if( Clock::now() - lastChange > std::chrono::milliseconds(m_options.stallTimeoutMs) )
+                    {
+                        // The worker cannot be stopped, it keeps the shared state alive until the process ends
+                        worker.detach();
+                        SimulationReport report;
+                        report.stalled = true;
+                        report.problems.push_back(std::format("{}: no answer for {} ms, the engine is probably stuck in an endless loop",
+                            state->engine.load(), m_options.stallTimeoutMs));
+                        return report;
+                    }
+                }
+
+                worker.join();
+                done.get();
+                return state->report;
+            }
+
+            std::vector<Lesson> LearnerSimulator::generateDeck(std::size_t words, std::size_t distinctAnswers, uint32_t seed)
+            {
+                std::vector<int> ranks(words);
+                std::iota(ranks.begin(), ranks.end(), 1);
+                std::shuffle(ranks.begin(), ranks.end(), std::mt19937(seed));
+
+                std::vector<Lesson> deck;
+                deck.reserve((words + LESSON_SIZE - 1) / LESSON_SIZE);
+                for( std::size_t index = 0; index < words; ++index )
+                {
+                    if( index % LESSON_SIZE == 0 )
+                    {
+                        Lesson lesson;
+                        lesson.id = static_cast<int>(deck.size() + 1);
+                        lesson.mainName = "Simulation";
+                        lesson.subName = std::format("Lesson {}", deck.size() + 1);
+                        lesson.words.reserve(LESSON_SIZE);
+                        deck.push_back(std::move(lesson));
+                    }
+                    const std::size_t answer = distinctAnswers > 0 ? index % distinctAnswers : index;
+                    Word word(static_cast<int>(index + 1), std::format("kana{}", index), std::format("word{}", answer), std::format("romaji{}", index), "", {});
+                    word.frequencyRank = ranks[index];
+                    deck.back().words.push_back(std::move(word));
+                }
+                return deck;
+            }
+        }
+    }
+}
@@ -0,0 +1,128 @@
+/**
+ * @file LearnerSimulator.h
+ * @brief Declares the LearnerSimulator class which load-tests the quiz engines with synthetic learners.
+ */
+
+#pragma once
+
+#include "lessons/Lesson.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace quiz
+        {
+            /**
+             * @brief Parameters of a simulation.
+             */
+            struct SimulationOptions
+            {
+                std::size_t learners = 1000;            /**< Number of simulated learners. */
+                std::size_t deckSize = 5000;            /**< Number of words of the generated deck. */
+                std::size_t distinctAnswers = 0;        /**< Number of distinct translations in the deck, 0 for all distinct. */
+                std::size_t answersPerLearner = 200;    /**< Questions every learner answers in each engine. */
+                double accuracy = 0.85;                 /**< Mean chance that a learner recalls a word right after seeing it. */
+                double forgetting = 30.0;               /**< Mean number of questions after which recall drops to 1/e of the accuracy. */
+                double familiarity = 0.5;               /**< Share of the deck a learner studied before the simulation. */
+                int requiredCorrectAnswers = 2;         /**< Correct answers needed to learn a word in the vocabulary quiz. */
+                std::size_t completionQuizSize = 20;    /**< Words of the quizzes which must be played to the end. */
+                std::size_t maxAnswersPerWord = 50;     /**< Answers per word after which a quiz counts as endless. */
+                double scalingLimit = 3.0;              /**< Growth of the answer latency on a four times larger deck which is reported. */
+                uint32_t stallTimeoutMs = 5000;         /**< Time without a single answer after which the engine counts as stuck. */
+                uint32_t seed = 1;                      /**< Seed of the deck and the learners. */
+                bool adaptive = false;                  /**< Draw the words of both engines weighted by the learner's mistakes. */
+            };
+
+            /**
+             * @brief Distribution of measured durations.
+             */
+            struct LatencyStats
+            {
+                std::size_t samples = 0;    /**< Number of measurements. */
+                double meanUs = 0.0;        /**< Mean duration in microseconds. */
+                double p50Us = 0.0;         /**< Median duration in microseconds. */
+                double p99Us = 0.0;         /**< 99th percentile in microseconds. */
+                double maxUs = 0.0;         /**< Longest duration in microseconds. */
+            };
+
+            /**
+             * @brief Measurements of one quiz engine.
+             */
+            struct EngineReport
+            {
+                std::string engine;                 /**< Name of the engine. */
+                std::size_t answers = 0;            /**< Number of simulated answers. */
+                std::size_t correct = 0;            /**< Number of correct answers. */
+                LatencyStats setup;                 /**< Construction and start of a quiz over the deck. */
+                LatencyStats answer;                /**< One answer, including the options of the next question for multiple choice. */
+                double scaling = 0.0;               /**< Mean answer latency on a four times larger deck divided by the mean on the deck. */
+                uint64_t allocations = 0;           /**< Heap allocations per answer, 0 unless allocations are tracked. */
+                uint64_t allocatedBytes = 0;        /**< Allocated bytes per answer, 0 unless allocations are tracked. */
+                uint64_t quizBytes = 0;             /**< Heap bytes held by one quiz over the deck, 0 unless allocations are tracked. */
+                std::size_t invalidOptionSets = 0;  /**< Questions with repeated options or without the correct answer. */
+                std::size_t unfinishedQuizzes = 0;  /**< Quizzes which did not end within the answer limit. */
+            };
+
+            /**
+             * @brief Result of a simulation.
+             */
+            struct SimulationReport
+            {
+                EngineReport vocabulary;            /**< Measurements of the vocabulary quiz. */
+                EngineReport multipleChoice;        /**< Measurements of the multiple choice quiz. */
+                bool stalled = false;               /**< True if an engine stopped answering and the simulation was abandoned. */
+                std::vector<std::string> problems;  /**< Descriptions of the detected pathological behaviour. */
+            };
+
+            /**
+             * @brief The LearnerSimulator class lets synthetic learners answer VocabularyQuiz and MultipleChoiceQuiz over a
+             * generated deck and measures the engines.
+             *
+             * Every learner has its own accuracy and forgetting speed drawn around the configured means. A word the learner
+             * saw is recalled with the accuracy decayed exponentially by the number of questions since, more slowly after
+             * each correct answer. Part of the deck counts as studied before the simulation; any other word is answered
+             * wrong or, with multiple choice, guessed the first time. Besides the latencies
+             * the simulator checks the engines for pathological behaviour: a quiz played by a perfect learner on a deck with
+             * only two distinct answers must end within the answer limit, every multiple choice question must offer distinct
+             * options including the answer, and the answer latency must not grow with the size of the deck. The engines run
+             * on a worker thread, an engine stuck in an endless loop is abandoned after the stall timeout.
+             */
+            class LearnerSimulator
+            {
+            public:
+                static constexpr std::size_t SCALING_FACTOR = 4; /**< Deck size multiplier of the scaling probe. */
+                static constexpr std::size_t SCALING_LEARNERS = 50; /**< Most learners simulated by the scaling probe. */
+                static constexpr std::size_t COMPLETION_QUIZZES = 10; /**< Most quizzes played to the end per engine. */
+
+                /**
+                 * @brief Constructs a simulator.
+                 * @param options Parameters of the simulation.
+                 */
+                explicit LearnerSimulator(const SimulationOptions& options);
+
+                /**
+                 * @brief Runs the simulation.
+                 * @return The measurements and the detected problems.
+                 */
+                SimulationReport run();
+
+                /**
+                 * @brief Generates a deck of synthetic words in lessons of 100 words.
+                 * @param words Number of words.
+                 * @param distinctAnswers Number of distinct translations, 0 for all distinct.
+                 * @param seed Seed of the frequency ranks.
+                 * @return The lessons.
+                 */
+                static std::vector<Lesson> generateDeck(std::size_t words, std::size_t distinctAnswers, uint32_t seed);
+
+            private:
+                SimulationOptions m_options; /**< Parameters of the simulation. */
+            };
+        }
+    }
+}
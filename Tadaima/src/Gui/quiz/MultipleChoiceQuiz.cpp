@@ -1,7 +1,10 @@
 #include "MultipleChoiceQuiz.h"
-#include <unordered_set>
+#include "lessons/FrequencyTable.h"
+#include <algorithm>
+#include <random>
 #include <stdexcept>
 #include <sstream>
+#include <unordered_map>
 
 namespace tadaima
 {
@@ -9,127 +12,64 @@ namespace tadaima
     {
         namespace quiz
         {
-
-            MultipleChoiceQuiz::MultipleChoiceQuiz(quiz::WordType base, quiz::WordType desired, const std::vector<Lesson>& lessons, tools::Logger& logger)
-                : m_baseWord(base), m_inputWord(desired), m_logger(logger), rng(std::random_device{}()), currentWordIndex(0), correctCount(0)
-            {
-                initialize(lessons);
-                if( !m_quizWords.empty() )
-                {
-                    shuffleWords();
-                }
-                else
-                {
-                    throw std::invalid_argument("No words available in the provided lessons.");
-                }
-            }
-
-            std::string getTranslation(const Word& word, quiz::WordType type)
-            {
-                std::string correctAnswer;
-
-                switch( type )
-                {
-                    case quiz::WordType::BaseWord:
-                        correctAnswer = word.translation;
-                        break;
-
-                    case quiz::WordType::Kana:
-                        correctAnswer = word.kana;
-                        break;
-
-                    case quiz::WordType::Romaji:
-                        correctAnswer = word.romaji;
-                        break;
-
-                    default:
-                        break;
-                }
-
-                return correctAnswer;
-            }
-
-            void MultipleChoiceQuiz::initialize(const std::vector<Lesson>& lessons)
+            namespace
             {
-                for( const auto& lesson : lessons )
+                // Resolves the confusions to word indices once, words outside the quiz are skipped
+                ConfusedWords resolveConfusions(const std::vector<Word>& words, const review::ConfusionTable* confusions)
                 {
-                    for( const auto& word : lesson.words )
+                    ConfusedWords confused;
+                    if( nullptr == confusions || 0 == confusions->size() )
                     {
-                        m_quizWords.push_back(word);
+                        return confused;
                     }
-                }
-                if( m_quizWords.empty() )
-                {
-                    throw std::invalid_argument("No words available in the provided lessons.");
-                }
-            }
 
-            std::vector<std::string> MultipleChoiceQuiz::generateOptions(const Word& correctWord)
-            {
-                std::string correctWordTranslation = getTranslation(correctWord, m_inputWord);
-
-                std::vector<std::string> options;
-                options.push_back(correctWordTranslation);
-
-                if( m_quizWords.size() < 4 )
-                {
-                    for( const auto& quizWord : m_quizWords )
-                    {
-                        if( getTranslation(quizWord, m_baseWord) != correctWordTranslation && options.size() < 4 )
-                        {
-                            options.push_back(correctWordTranslation);
-                        }
-                    }
-                    while( options.size() < 4 )
+                    std::unordered_map<int, std::size_t> indices;
+                    indices.reserve(words.size());
+                    for( std::size_t index = 0; index < words.size(); ++index )
                     {
-                        options.push_back("dummy_option_" + std::to_string(options.size()));
+                        indices.emplace(words[index].id, index);
                     }
-                }
-                else
-                {
-                    std::unordered_set<std::string> usedTranslations{ getTranslation(correctWord, m_inputWord) };
-                    while( options.size() < 4 )
+
+                    confused.resize(words.size());
+                    for( std::size_t index = 0; index < words.size(); ++index )
                     {
-                        const Word& randomWord = m_quizWords[rng() % m_quizWords.size()];
-                        auto optionstring = getTranslation(randomWord, m_inputWord);
-                        if( optionstring == "" )
-                        {
-                            optionstring = "dummy_option_" + std::to_string(options.size());
-                        }
-                        if( usedTranslations.find(optionstring) == usedTranslations.end() )
+                        for( const auto& confusion : confusions->confusedWith(words[index].id) )
                         {
-                            options.push_back(optionstring);
-                            usedTranslations.insert(optionstring);
+                            auto it = indices.find(confusion.chosenId);
+                            if( it != indices.end() )
+                            {
+                                confused[index].push_back(it->second);
+                            }
                         }
                     }
+                    return confused;
                 }
-
-                std::shuffle(options.begin(), options.end(), rng);
-
-                // Store the correct answer index
-                auto it = std::find(options.begin(), options.end(), correctWordTranslation);
-                correctAnswerIndex = std::distance(options.begin(), it);
-
-                return options;
             }
 
-            void MultipleChoiceQuiz::shuffleWords()
+            MultipleChoiceQuiz::MultipleChoiceQuiz(SessionFactory makeSession, const std::vector<Lesson>& lessons, tools::Logger& logger, QuizOrder order,
+                const review::ConfusionTable* confusions)
+                : m_order(order), m_logger(logger)
             {
-                std::shuffle(m_quizWords.begin(), m_quizWords.end(), rng);
-            }
-
-            void MultipleChoiceQuiz::start()
-            {
-                currentWordIndex = 0;
-                correctCount = 0;
-                if( !m_quizWords.empty() )
+                std::vector<Word> words = collectWords(lessons);
+                if( words.empty() )
                 {
-                    currentOptions = generateOptions(m_quizWords[currentWordIndex]);
+                    throw std::invalid_argument("No words available in the provided lessons.");
                 }
-                else
+
+                // With frequency order the most common words are moved to the front, words of equal rank stay shuffled
+                std::mt19937 rng(std::random_device{}());
+                std::shuffle(words.begin(), words.end(), rng);
+                if( QuizOrder::Frequency == m_order )
                 {
-                    throw std::runtime_error("No words available to start the quiz.");
+                    std::stable_sort(words.begin(), words.end(), FrequencyTable::isMoreCommon);
                 }
+                ConfusedWords confused = resolveConfusions(words, confusions);
+                m_session = makeSession(std::move(words), rng(), std::move(confused));
+            }
+
+            void MultipleChoiceQuiz::start()
+            {
+                m_session->start();
             }
 
             void MultipleChoiceQuiz::advance(char answer)
@@ -140,64 +80,65 @@ namespace tadaima
                 }
 
                 int answerIndex = answer - 'a';
-                if( answerIndex < 0 || answerIndex >= (int)currentOptions.size() )
+                if( answerIndex < 0 || answerIndex >= (int)m_session->options().size() )
                 {
                     throw std::out_of_range("Invalid answer choice.");
                 }
 
-                if( currentOptions[answerIndex] == getTranslation(m_quizWords[currentWordIndex], m_inputWord) )
-                {
-                    correctCount++;
-                }
-
-                currentWordIndex++;
-
-                if( !isFinished() )
-                {
-                    currentOptions = generateOptions(m_quizWords[currentWordIndex]);
-                }
+                m_session->submit(static_cast<std::size_t>(answerIndex));
             }
 
             bool MultipleChoiceQuiz::isFinished() const
             {
-                return currentWordIndex >= m_quizWords.size();
+                return m_session->isFinished();
             }
 
             std::string MultipleChoiceQuiz::getCurrentQuestion() const
             {
                 if( !isFinished() )
                 {
-                    return "Translate the word: " + getTranslation(m_quizWords[currentWordIndex], m_baseWord);
+                    return "Translate the word: " + m_session->prompt();
                 }
                 return "";
             }
 
             std::vector<std::string> MultipleChoiceQuiz::getCurrentOptions() const
             {
-                return currentOptions;
+                return m_session->options();
             }
 
             std::string MultipleChoiceQuiz::getResults() const
             {
                 std::ostringstream oss;
-                oss << "Quiz finished!\nYou got " << correctCount << " out of " << m_quizWords.size() << " correct!";
+                oss << "Quiz finished!\nYou got " << m_session->correctCount() << " out of " << m_session->questionCount() << " correct!";
                 return oss.str();
             }
 
             int MultipleChoiceQuiz::getCurrentQuestionIndex() const
             {
-                return static_cast<int>(currentWordIndex);
+                return static_cast<int>(m_session->asked());
             }
 
             int MultipleChoiceQuiz::getTotalQuestions() const
             {
-                return static_cast<int>(m_quizWords.size());
+                return static_cast<int>(m_session->questionCount());
             }
 
             int MultipleChoiceQuiz::getCorrectAnswerIndex() const
             {
-                return correctAnswerIndex;
+                return m_session->correctOption();
+            }
+
+            int MultipleChoiceQuiz::getCurrentWordId() const
+            {
+                return isFinished() ? -1 : m_session->currentWord().id;
+            }
+
+            int MultipleChoiceQuiz::getOptionWordId(char answer) const
+            {
+                const int answerIndex = answer - 'a';
+                return isFinished() || answerIndex < 0 ? -1 : m_session->optionWordId(static_cast<std::size_t>(answerIndex));
             }
         }
     }
-}
\ No newline at end of file
+}
@@ -6,10 +6,13 @@
 #pragma once
 
 #include "lessons/Lesson.h"
-#include <vector>
-#include <string>
+#include "review/ConfusionTable.h"
 #include <algorithm>
+#include <memory>
 #include <random>
+#include <vector>
+#include <string>
+#include "QuizEngine.h"
 #include "QuizType.h"
 
 namespace tools { class Logger; }
@@ -20,21 +23,117 @@ namespace tadaima
     {
         namespace quiz
         {
+            using ConfusedWords = std::vector<std::vector<std::size_t>>; ///< Indices of the words mixed up with every word, most frequent first.
+
+            /**
+             * @brief Questions of a multiple choice quiz for one combination of asked field, answer field and order.
+             *
+             * The implementations are MultipleChoiceEngine instantiations chosen by whoever creates the quiz, so only the calls
+             * of MultipleChoiceQuiz go through this interface and a question itself is resolved at compile time.
+             */
+            class MultipleChoiceSession
+            {
+            public:
+                virtual ~MultipleChoiceSession() = default;
+
+                /**
+                 * @brief Starts the session over with the first question.
+                 */
+                virtual void start() = 0;
+
+                /**
+                 * @brief Answers the current question with one of its options.
+                 * @param option Index of the chosen option.
+                 */
+                virtual void submit(std::size_t option) = 0;
+
+                /**
+                 * @brief Checks if the session is over.
+                 * @return True if there is no question left.
+                 */
+                virtual bool isFinished() const = 0;
+
+                /**
+                 * @brief Gets the word of the current question.
+                 * @return The word.
+                 */
+                virtual const Word& currentWord() const = 0;
+
+                /**
+                 * @brief Gets the asked text of the current question.
+                 * @return The prompt.
+                 */
+                virtual const std::string& prompt() const = 0;
+
+                /**
+                 * @brief Gets the options of the current question.
+                 * @return The options.
+                 */
+                virtual const std::vector<std::string>& options() const = 0;
+
+                /**
+                 * @brief Gets the index of the correct option of the current question.
+                 * @return The index.
+                 */
+                virtual int correctOption() const = 0;
+
+                /**
+                 * @brief Gets the word an option of the current question was taken from.
+                 * @param option Index of the option.
+                 * @return The ID of the word, or -1 for placeholders.
+                 */
+                virtual int optionWordId(std::size_t option) const = 0;
+
+                /**
+                 * @brief Gets the number of answered questions.
+                 * @return The number of answers.
+                 */
+                virtual std::size_t asked() const = 0;
+
+                /**
+                 * @brief Gets the number of correct answers.
+                 * @return The number of correct answers.
+                 */
+                virtual std::size_t correctCount() const = 0;
+
+                /**
+                 * @brief Gets the number of questions of the session.
+                 * @return The number of words.
+                 */
+                virtual std::size_t questionCount() const = 0;
+            };
+
             /**
              * @class QuizGame
              * @brief Manages the logic of the quiz game, including question generation, answer evaluation, and results.
+             *
+             * Every word is asked once in shuffled or frequency order. With adaptive order each question draws its word
+             * from the whole deck by an AdaptiveSelector instead, so words answered wrong come back. The questions are run
+             * by a MultipleChoiceSession from the factory the caller instantiated for the word types and the order.
+             *
+             * Words the learner mixed up with the asked word before are offered as distractors first. Their indices are
+             * resolved once when the quiz is created, so a question only reads the list of its word.
              */
             class MultipleChoiceQuiz
             {
             public:
+                static constexpr std::size_t OPTION_COUNT = 4; ///< Number of options of every question.
+                static constexpr std::size_t MAX_RANDOM_DRAWS = 32; ///< Random draws of distractors before the words are scanned in order.
+                static constexpr std::size_t CONFUSED_OPTIONS = 2; ///< Distractors taken from the confusions of the asked word.
+
+                using SessionFactory = std::unique_ptr<MultipleChoiceSession>(*)(std::vector<Word>, uint32_t, ConfusedWords); ///< E.g. makeMultipleChoiceSession<KanaField, TranslationField, SequentialSelection>.
 
                 /**
                  * @brief Constructs a new QuizGame object.
                  *
-                 * @param logger A reference to a Logger instance for logging.
+                 * @param makeSession Creates the session of the asked field, answer field and selection of the quiz.
                  * @param lessons A vector containing Lesson objects to initialize the game.
+                 * @param logger A reference to a Logger instance for logging.
+                 * @param order The order in which the words are prepared: shuffled, or the most common first.
+                 * @param confusions Words mixed up before, or nullptr. Only read while the quiz is created.
                  */
-                MultipleChoiceQuiz(quiz::WordType base, quiz::WordType desired, const std::vector<Lesson>& lessons, tools::Logger& logger);
+                MultipleChoiceQuiz(SessionFactory makeSession, const std::vector<Lesson>& lessons, tools::Logger& logger, QuizOrder order = QuizOrder::Random,
+                    const review::ConfusionTable* confusions = nullptr);
 
                 /**
                  * @brief Starts the quiz game.
@@ -115,44 +214,199 @@ namespace tadaima
                  */
                 int getCorrectAnswerIndex() const;
 
-            private:
-
                 /**
-                 * @brief Initializes the quiz game by extracting words from lessons.
-                 *
-                 * Prepares the list of words to be used in the quiz.
+                 * @brief Gets the ID of the word asked in the current question.
                  *
-                 * @param lessons The vector of lessons.
+                 * @return The ID of the current word, or -1 if the quiz is finished.
                  */
-                void initialize(const std::vector<Lesson>& lessons);
+                int getCurrentWordId() const;
 
                 /**
-                 * @brief Generates multiple-choice options.
-                 *
-                 * Creates a set of options including the correct word and random incorrect options.
+                 * @brief Gets the ID of the word an option of the current question was taken from.
                  *
-                 * @param correctWord The correct word.
-                 * @return A vector of multiple-choice options including the correct word.
+                 * @param answer The option (a/b/c/d).
+                 * @return The ID of the word, or -1 for placeholders and invalid options.
                  */
-                std::vector<std::string> generateOptions(const Word& correctWord);
+                int getOptionWordId(char answer) const;
 
+            private:
+                QuizOrder m_order; ///< The order in which the words are asked.
+                tools::Logger& m_logger; /**< Reference to the Logger instance for logging. */
+                std::unique_ptr<MultipleChoiceSession> m_session; /**< Questions of the quiz. */
+            };
+
+            /**
+             * @brief MultipleChoiceSession running the questions through a QuizEngine.
+             *
+             * The options are read through the answer field policy like the expected answer.
+             *
+             * @tparam PromptField Field policy of the asked text.
+             * @tparam AnswerField Field policy of the answer and the options.
+             * @tparam Selection Selection policy, SequentialSelection asks every word once.
+             */
+            template<typename PromptField, typename AnswerField, typename Selection>
+            class MultipleChoiceEngine final : public MultipleChoiceSession
+            {
+            public:
                 /**
-                 * @brief Shuffles the words vector to randomize the quiz order.
+                 * @brief Constructs the session; start() asks the first question.
+                 * @param words The words in the order they are asked.
+                 * @param seed Seed of the random number generator.
+                 * @param confused Indices of the words mixed up with every word, or empty.
+                 */
+                MultipleChoiceEngine(std::vector<Word> words, uint32_t seed, ConfusedWords confused)
+                    : m_engine(std::move(words), seed), m_confused(std::move(confused))
+                {
+                    m_options.reserve(MultipleChoiceQuiz::OPTION_COUNT);
+                    m_optionWords.reserve(MultipleChoiceQuiz::OPTION_COUNT);
+                }
+
+                void start() override
+                {
+                    m_engine.start();
+                    generateOptions();
+                }
+
+                void submit(std::size_t option) override
+                {
+                    m_engine.submit(m_options[option]);
+                    if( !m_engine.isFinished() )
+                    {
+                        generateOptions();
+                    }
+                }
+
+                bool isFinished() const override
+                {
+                    return m_engine.isFinished();
+                }
+
+                const Word& currentWord() const override
+                {
+                    return m_engine.currentWord();
+                }
+
+                const std::string& prompt() const override
+                {
+                    return m_engine.prompt();
+                }
+
+                const std::vector<std::string>& options() const override
+                {
+                    return m_options;
+                }
+
+                int correctOption() const override
+                {
+                    return m_correctOption;
+                }
+
+                int optionWordId(std::size_t option) const override
+                {
+                    return option < m_optionWords.size() ? m_optionWords[option] : -1;
+                }
+
+                std::size_t asked() const override
+                {
+                    return m_engine.asked();
+                }
+
+                std::size_t correctCount() const override
+                {
+                    return m_engine.scoring().correctCount();
+                }
+
+                std::size_t questionCount() const override
+                {
+                    return m_engine.words().size();
+                }
+
+            private:
+                /**
+                 * @brief Generates the options of the current question.
                  *
-                 * Ensures that questions are presented in a random order.
+                 * Options are distinct and never empty; decks with too few distinct answers are completed with
+                 * placeholders.
                  */
-                void shuffleWords();
+                void generateOptions()
+                {
+                    const std::vector<Word>& words = m_engine.words();
+                    std::mt19937& generator = m_engine.generator();
+                    const std::string& correctAnswer = m_engine.expectedAnswer();
 
-                quiz::WordType m_baseWord; ///< The mother language type.
-                quiz::WordType m_inputWord; ///< The learning language type.
-                tools::Logger& m_logger; /**< Reference to the Logger instance for logging. */
-                std::vector<Word> m_quizWords; /**< Vector of words extracted from lessons for the quiz. */
-                std::mt19937 rng; /**< Random number generator for shuffling words and generating options. */
-                size_t currentWordIndex; /**< Index of the current word in the quiz. */
-                int correctCount; /**< Count of correctly answered questions. */
-                std::vector<std::string> currentOptions; /**< Vector of multiple-choice options for the current question. */
-                int correctAnswerIndex; /**< Index of the correct answer within the current options. */
+                    m_options.clear();
+                    m_optionWords.clear();
+                    m_options.push_back(correctAnswer);
+                    m_optionWords.push_back(m_engine.currentWord().id);
+                    auto addOption = [this](const Word& word)
+                        {
+                            const std::string& option = AnswerField::get(word);
+                            if( !option.empty() && std::find(m_options.begin(), m_options.end(), option) == m_options.end() )
+                            {
+                                m_options.push_back(option);
+                                m_optionWords.push_back(word.id);
+                            }
+                        };
+
+                    // Answers picked for this word before come first, the rest stays random so the confused ones
+                    // are not recognized by always being there
+                    if( !m_confused.empty() )
+                    {
+                        const std::vector<std::size_t>& confused = m_confused[m_engine.currentIndex()];
+                        for( std::size_t index = 0; index < confused.size() && m_options.size() <= MultipleChoiceQuiz::CONFUSED_OPTIONS; ++index )
+                        {
+                            addOption(words[confused[index]]);
+                        }
+                    }
+
+                    // Random draws find distinct answers at once in real decks. They are limited, because a deck with
+                    // fewer than four distinct answers would never provide enough of them.
+                    for( std::size_t draw = 0; draw < MultipleChoiceQuiz::MAX_RANDOM_DRAWS && m_options.size() < MultipleChoiceQuiz::OPTION_COUNT && words.size() >= MultipleChoiceQuiz::OPTION_COUNT; ++draw )
+                    {
+                        addOption(words[generator() % words.size()]);
+                    }
+                    for( std::size_t index = 0; index < words.size() && m_options.size() < MultipleChoiceQuiz::OPTION_COUNT; ++index )
+                    {
+                        addOption(words[index]);
+                    }
+                    while( m_options.size() < MultipleChoiceQuiz::OPTION_COUNT )
+                    {
+                        m_options.push_back("dummy_option_" + std::to_string(m_options.size()));
+                        m_optionWords.push_back(-1);
+                    }
+
+                    // Fisher-Yates over both lists, so every option keeps its word
+                    for( std::size_t index = m_options.size() - 1; index > 0; --index )
+                    {
+                        const std::size_t other = std::uniform_int_distribution<std::size_t>(0, index)(generator);
+                        std::swap(m_options[index], m_options[other]);
+                        std::swap(m_optionWords[index], m_optionWords[other]);
+                    }
+                    m_correctOption = static_cast<int>(std::find(m_options.begin(), m_options.end(), correctAnswer) - m_options.begin());
+                }
+
+                QuizEngine<PromptField, AnswerField, Selection> m_engine; /**< Questions and answers. */
+                ConfusedWords m_confused; /**< Indices of the words mixed up with every word, empty without confusions. */
+                std::vector<std::string> m_options; /**< Options of the current question. */
+                std::vector<int> m_optionWords; /**< IDs of the words the options were taken from. */
+                int m_correctOption = 0; /**< Index of the correct answer within the options. */
             };
+
+            /**
+             * @brief Creates the session of one combination of asked field, answer field and order.
+             *
+             * Its address is a MultipleChoiceQuiz::SessionFactory, so the caller choosing the combination instantiates it.
+             *
+             * @param words The words in the order they are asked.
+             * @param seed Seed of the random number generator.
+             * @param confused Indices of the words mixed up with every word, or empty.
+             * @return The session.
+             */
+            template<typename PromptField, typename AnswerField, typename Selection>
+            std::unique_ptr<MultipleChoiceSession> makeMultipleChoiceSession(std::vector<Word> words, uint32_t seed, ConfusedWords confused)
+            {
+                return std::make_unique<MultipleChoiceEngine<PromptField, AnswerField, Selection>>(std::move(words), seed, std::move(confused));
+            }
         }
     }
 }
@@ -0,0 +1,784 @@
+/**
+ * @file QuizEngine.h
+ * @brief Declares the QuizEngine template which runs the questions of a quiz from compile-time policies.
+ */
+
+#pragma once
+
+#include "AdaptiveSelector.h"
+#include "QuizType.h"
+#include "lessons/Lesson.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace tadaima
+{
+    namespace gui
+    {
+        namespace quiz
+        {
+            /**
+             * @brief Field policy reading the translation of a word.
+             */
+            struct TranslationField
+            {
+                static constexpr WordType TYPE = WordType::BaseWord; /**< Word type the policy stands for. */
+
+                /**
+                 * @brief Reads the field.
+                 * @param word The word.
+                 * @return The translation.
+                 */
+                static const std::string& get(const Word& word) { return word.translation; }
+            };
+
+            /**
+             * @brief Field policy reading the kana of a word.
+             */
+            struct KanaField
+            {
+                static constexpr WordType TYPE = WordType::Kana; /**< Word type the policy stands for. */
+
+                /**
+                 * @brief Reads the field.
+                 * @param word The word.
+                 * @return The kana.
+                 */
+                static const std::string& get(const Word& word) { return word.kana; }
+            };
+
+            /**
+             * @brief Field policy reading the romaji of a word.
+             */
+            struct RomajiField
+            {
+                static constexpr WordType TYPE = WordType::Romaji; /**< Word type the policy stands for. */
+
+                /**
+                 * @brief Reads the field.
+                 * @param word The word.
+                 * @return The romaji.
+                 */
+                static const std::string& get(const Word& word) { return word.romaji; }
+            };
+
+            /**
+             * @brief Field policy reading the kanji of a word.
+             *
+             * The GUI has no word type for kanji, so only withField() of a field name picks it, as the command line quiz does.
+             */
+            struct KanjiField
+            {
+                /**
+                 * @brief Reads the field.
+                 * @param word The word.
+                 * @return The kanji.
+                 */
+                static const std::string& get(const Word& word) { return word.kanji; }
+            };
+
+            /**
+             * @brief Calls a visitor with the field policy of a word type.
+             *
+             * Quizzes choose their fields at runtime; dispatching once when the quiz is created lets every question
+             * read the fields without a switch.
+             *
+             * @param type The word type, unknown types read the translation.
+             * @param visitor Callable taking a field policy object.
+             * @return What the visitor returns.
+             */
+            template<typename Visitor>
+            decltype(auto) withField(WordType type, Visitor&& visitor)
+            {
+                switch( type )
+                {
+                    case WordType::Kana:
+                        return visitor(KanaField{});
+
+                    case WordType::Romaji:
+                        return visitor(RomajiField{});
+
+                    default:
+                        return visitor(TranslationField{});
+                }
+            }
+
+            /**
+             * @brief Calls a visitor with the field policy named like the word types in the settings.
+             *
+             * @param name "Kana", "Romaji" or "Kanji", other names read the translation.
+             * @param visitor Callable taking a field policy object.
+             * @return What the visitor returns.
+             */
+            template<typename Visitor>
+            decltype(auto) withField(std::string_view name, Visitor&& visitor)
+            {
+                if( name == "Kana" )
+                {
+                    return visitor(KanaField{});
+                }
+                if( name == "Romaji" )
+                {
+                    return visitor(RomajiField{});
+                }
+                if( name == "Kanji" )
+                {
+                    return visitor(KanjiField{});
+                }
+                return visitor(TranslationField{});
+            }
+
+            /**
+             * @brief Reads the field of a word type, for code outside the questions.
+             * @param word The word.
+             * @param type The word type.
+             * @return The field.
+             */
+            inline const std::string& wordField(const Word& word, WordType type)
+            {
+                return withField(type, [&word](auto field) -> const std::string& { return decltype(field)::get(word); });
+            }
+
+            /**
+             * @brief Reads the field of a field name, for code outside the questions.
+             * @param word The word.
+             * @param name The name of the field, as accepted by withField().
+             * @return The field.
+             */
+            inline const std::string& wordField(const Word& word, std::string_view name)
+            {
+                return withField(name, [&word](auto field) -> const std::string& { return decltype(field)::get(word); });
+            }
+
+            /**
+             * @brief Collects the words of lessons in lesson order.
+             * @param lessons The lessons.
+             * @return The words.
+             */
+            inline std::vector<Word> collectWords(const std::vector<Lesson>& lessons)
+            {
+                std::vector<Word> words;
+                for( const auto& lesson : lessons )
+                {
+                    words.insert(words.end(), lesson.words.begin(), lesson.words.end());
+                }
+                return words;
+            }
+
+            /**
+             * @brief Checks if a scoring policy no longer asks a word, e.g. because it was learnt.
+             *
+             * Scoring policies without isRetired() retire no word, so the selection policies skip the check for them
+             * at compile time.
+             *
+             * @param scoring The scoring policy.
+             * @param index Index of the word.
+             * @return True if the word must not be asked again.
+             */
+            template<typename Scoring>
+            bool isRetired(const Scoring& scoring, std::size_t index)
+            {
+                if constexpr( requires { scoring.isRetired(index); } )
+                {
+                    return scoring.isRetired(index);
+                }
+                else
+                {
+                    return false;
+                }
+            }
+
+            /**
+             * @brief Selection policy asking the words in their order.
+             *
+             * Retired words are skipped for the rest of a pass and dropped when the next pass starts, so a pass only
+             * visits the words still asked.
+             */
+            class SequentialSelection
+            {
+            public:
+                /**
+                 * @brief Starts a new pass over the words.
+                 * @param wordCount Number of words.
+                 */
+                void reset(std::size_t wordCount)
+                {
+                    m_pending.resize(wordCount);
+                    std::iota(m_pending.begin(), m_pending.end(), std::size_t{ 0 });
+                    m_position = 0;
+                }
+
+                /**
+                 * @brief Picks the next word which is not retired, starting over after the last one.
+                 * @param scoring Scoring policy deciding which words are retired.
+                 * @return Index of the word.
+                 */
+                template<typename Generator, typename Scoring>
+                std::size_t next(Generator&, const Scoring& scoring)
+                {
+                    while( true )
+                    {
+                        if( m_position >= m_pending.size() )
+                        {
+                            std::erase_if(m_pending, [&scoring](std::size_t index) { return isRetired(scoring, index); });
+                            m_position = 0;
+                        }
+                        const std::size_t index = m_pending[m_position++];
+                        if( !isRetired(scoring, index) )
+                        {
+                            return index;
+                        }
+                    }
+                }
+
+                /**
+                 * @brief Ignores the answer, the order is fixed.
+                 */
+                void record(std::size_t, bool) {}
+
+                /**
+                 * @brief Continues the pass after a word, e.g. when a quiz is restored.
+                 * @param wordCount Number of words.
+                 * @param current Index of the word asked last.
+                 * @param scoring Scoring policy deciding which words are retired.
+                 */
+                template<typename Scoring>
+                void resume(std::size_t wordCount, std::size_t current, const Scoring& scoring)
+                {
+                    reset(wordCount);
+                    std::erase_if(m_pending, [&scoring](std::size_t index) { return isRetired(scoring, index); });
+                    const auto it = std::lower_bound(m_pending.begin(), m_pending.end(), current);
+                    m_position = it != m_pending.end() && *it == current ? static_cast<std::size_t>(it - m_pending.begin()) + 1 : 0;
+                }
+
+            private:
+                std::vector<std::size_t> m_pending; /**< Indices of the words of the pass, in word order. */
+                std::size_t m_position = 0; /**< Position of the next word in m_pending. */
+            };
+
+            /**
+             * @brief Selection policy drawing every word with the same chance.
+             *
+             * A drawn word which was retired meanwhile is dropped and the draw repeated, so answering costs the same
+             * for any number of words.
+             */
+            class RandomSelection
+            {
+            public:
+                /**
+                 * @brief Makes every word drawable.
+                 * @param wordCount Number of words.
+                 */
+                void reset(std::size_t wordCount)
+                {
+                    m_pending.resize(wordCount);
+                    std::iota(m_pending.begin(), m_pending.end(), std::size_t{ 0 });
+                }
+
+                /**
+                 * @brief Draws the next word which is not retired.
+                 * @param generator Random number generator.
+                 * @param scoring Scoring policy deciding which words are retired.
+                 * @return Index of the word.
+                 */
+                template<typename Generator, typename Scoring>
+                std::size_t next(Generator& generator, const Scoring& scoring)
+                {
+                    while( true )
+                    {
+                        const std::size_t position = std::uniform_int_distribution<std::size_t>(0, m_pending.size() - 1)(generator);
+                        const std::size_t index = m_pending[position];
+                        if( !isRetired(scoring, index) )
+                        {
+                            return index;
+                        }
+                        m_pending[position] = m_pending.back();
+                        m_pending.pop_back();
+                    }
+                }
+
+                /**
+                 * @brief Ignores the answer, every word has the same chance.
+                 */
+                void record(std::size_t, bool) {}
+
+                /**
+                 * @brief Makes the words drawable which are not retired, e.g. when a quiz is restored.
+                 * @param wordCount Number of words.
+                 * @param scoring Scoring policy deciding which words are retired.
+                 */
+                template<typename Scoring>
+                void resume(std::size_t wordCount, std::size_t, const Scoring& scoring)
+                {
+                    reset(wordCount);
+                    std::erase_if(m_pending, [&scoring](std::size_t index) { return isRetired(scoring, index); });
+                }
+
+            private:
+                std::vector<std::size_t> m_pending; /**< Indices of the words which were not retired when last drawn. */
+            };
+
+            /**
+             * @brief Selection policy drawing the words by an AdaptiveSelector, so words answered wrong come back.
+             */
+            class AdaptiveSelection
+            {
+            public:
+                /**
+                 * @brief Forgets the answers.
+                 * @param wordCount Number of words.
+                 */
+                void reset(std::size_t wordCount)
+                {
+                    m_selector = AdaptiveSelector(wordCount);
+                }
+
+                /**
+                 * @brief Draws the next word which is not retired.
+                 *
+                 * Like with RandomSelection, a retired word leaves the selector only once it is drawn.
+                 *
+                 * @param generator Random number generator.
+                 * @param scoring Scoring policy deciding which words are retired.
+                 * @return Index of the word.
+                 */
+                template<typename Generator, typename Scoring>
+                std::size_t next(Generator& generator, const Scoring& scoring)
+                {
+                    while( true )
+                    {
+                        const std::size_t index = m_selector.next(generator);
+                        if( !isRetired(scoring, index) )
+                        {
+                            return index;
+                        }
+                        m_selector.retire(index);
+                    }
+                }
+
+                /**
+                 * @brief Updates the weight of the answered word.
+                 * @param index Index of the word.
+                 * @param correct True if the answer was correct.
+                 */
+                void record(std::size_t index, bool correct)
+                {
+                    m_selector.recordAnswer(index, correct);
+                }
+
+                /**
+                 * @brief Rebuilds the weights from the attempts counted by the scoring, e.g. when a quiz is restored.
+                 * @param wordCount Number of words.
+                 * @param scoring Scoring policy with statistics() of every word.
+                 */
+                template<typename Scoring>
+                void resume(std::size_t wordCount, std::size_t, const Scoring& scoring)
+                {
+                    reset(wordCount);
+                    for( std::size_t index = 0; index < wordCount; ++index )
+                    {
+                        if( isRetired(scoring, index) )
+                        {
+                            m_selector.retire(index);
+                        }
+                        else
+                        {
+                            m_selector.setAttempts(index, scoring.statistics(index).goodAttempts, scoring.statistics(index).badAttempts);
+                        }
+                    }
+                }
+
+            private:
+                AdaptiveSelector m_selector; /**< Weights of the words. */
+            };
+
+            /**
+             * @brief Scoring policy of a session asking as many questions as there are words.
+             */
+            class SessionScoring
+            {
+            public:
+                /**
+                 * @brief Starts a new session.
+                 * @param wordCount Number of words, which is also the number of questions.
+                 */
+                void reset(std::size_t wordCount)
+                {
+                    m_questions = wordCount;
+                    m_correct = 0;
+                }
+
+                /**
+                 * @brief Counts an answer.
+                 * @param index Index of the word.
+                 * @param correct True if the answer was correct.
+                 */
+                void record([[maybe_unused]] std::size_t index, bool correct)
+                {
+                    m_correct += correct ? 1 : 0;
+                }
+
+                /**
+                 * @brief Checks if the session is over.
+                 * @param asked Number of answered questions.
+                 * @return True once every question was answered.
+                 */
+                bool isComplete(std::size_t asked) const
+                {
+                    return asked >= m_questions;
+                }
+
+                /**
+                 * @brief Gets the number of correct answers.
+                 * @return The number of correct answers.
+                 */
+                std::size_t correctCount() const
+                {
+                    return m_correct;
+                }
+
+            private:
+                std::size_t m_questions = 0; /**< Number of questions of the session. */
+                std::size_t m_correct = 0; /**< Number of correct answers. */
+            };
+
+            /**
+             * @brief Scoring policy of a quiz asking every word until it is learnt.
+             *
+             * A word is learnt once its correct answers exceed its mistakes by the required number, after that it is
+             * retired. The quiz ends when every word is learnt.
+             */
+            class MasteryScoring
+            {
+            public:
+                /**
+                 * @brief Answers of one word.
+                 */
+                struct WordStatistics
+                {
+                    int goodAttempts = 0; ///< Number of good attempts.
+                    int badAttempts = 0; ///< Number of bad attempts.
+                    bool learnt = false; ///< Whether the word has been learnt.
+                };
+
+                /**
+                 * @brief Constructs the policy.
+                 * @param requiredCorrectAnswers Correct answers a word needs beyond its mistakes.
+                 */
+                explicit MasteryScoring(int requiredCorrectAnswers = 1) : m_requiredCorrectAnswers(requiredCorrectAnswers) {}
+
+                /**
+                 * @brief Forgets the answers.
+                 * @param wordCount Number of words.
+                 */
+                void reset(std::size_t wordCount)
+                {
+                    m_statistics.assign(wordCount, WordStatistics());
+                    m_remainingWords = wordCount;
+                    m_correct = 0;
+                }
+
+                /**
+                 * @brief Counts an answer and marks the word learnt once it has enough correct answers.
+                 * @param index Index of the word.
+                 * @param correct True if the answer was correct.
+                 */
+                void record(std::size_t index, bool correct)
+                {
+                    WordStatistics& statistics = m_statistics[index];
+                    if( !correct )
+                    {
+                        ++statistics.badAttempts;
+                        return;
+                    }
+
+                    ++m_correct;
+                    ++statistics.goodAttempts;
+                    if( !statistics.learnt && statistics.goodAttempts >= statistics.badAttempts + m_requiredCorrectAnswers )
+                    {
+                        statistics.learnt = true;
+                        --m_remainingWords;
+                    }
+                }
+
+                /**
+                 * @brief Sets the answers of a word, e.g. when a quiz is restored.
+                 * @param index Index of the word.
+                 * @param statistics The answers.
+                 */
+                void restore(std::size_t index, const WordStatistics& statistics)
+                {
+                    m_remainingWords += m_statistics[index].learnt ? 1 : 0;
+                    m_remainingWords -= statistics.learnt ? 1 : 0;
+                    m_correct += static_cast<std::size_t>(statistics.goodAttempts) - static_cast<std::size_t>(m_statistics[index].goodAttempts);
+                    m_statistics[index] = statistics;
+                }
+
+                /**
+                 * @brief Checks if the quiz is over.
+                 * @return True once every word is learnt.
+                 */
+                bool isComplete(std::size_t) const
+                {
+                    return 0 == m_remainingWords;
+                }
+
+                /**
+                 * @brief Checks if a word is no longer asked.
+                 * @param index Index of the word.
+                 * @return True if the word is learnt.
+                 */
+                bool isRetired(std::size_t index) const
+                {
+                    return m_statistics[index].learnt;
+                }
+
+                /**
+                 * @brief Gets the number of correct answers.
+                 * @return The number of correct answers.
+                 */
+                std::size_t correctCount() const
+                {
+                    return m_correct;
+                }
+
+                /**
+                 * @brief Gets the number of learnt words.
+                 * @return The number of learnt words.
+                 */
+                std::size_t learntCount() const
+                {
+                    return m_statistics.size() - m_remainingWords;
+                }
+
+                /**
+                 * @brief Gets the answers of a word.
+                 * @param index Index of the word.
+                 * @return The answers.
+                 */
+                const WordStatistics& statistics(std::size_t index) const
+                {
+                    return m_statistics[index];
+                }
+
+                /**
+                 * @brief Gets the answers of every word.
+                 * @return The answers, in word order.
+                 */
+                const std::vector<WordStatistics>& statistics() const
+                {
+                    return m_statistics;
+                }
+
+                /**
+                 * @brief Gets the number of correct answers a word needs beyond its mistakes.
+                 * @return The number of answers.
+                 */
+                int requiredCorrectAnswers() const
+                {
+                    return m_requiredCorrectAnswers;
+                }
+
+            private:
+                std::vector<WordStatistics> m_statistics; /**< Answers of every word, in word order. */
+                std::size_t m_remainingWords = 0; /**< Number of words not learnt yet. */
+                std::size_t m_correct = 0; /**< Number of correct answers. */
+                int m_requiredCorrectAnswers = 1; /**< Correct answers a word needs beyond its mistakes. */
+            };
+
+            /**
+             * @brief The QuizEngine class runs the questions of a quiz over a list of words.
+             *
+             * Which fields are asked and expected, how the next word is picked and when the quiz ends are template
+             * policies, so answering a question calls no virtual function and switches on no word type. A new quiz mode
+             * is a new policy or a new combination of the existing ones.
+             *
+             * @tparam PromptField Field policy of the asked text, e.g. KanaField.
+             * @tparam AnswerField Field policy of the expected answer.
+             * @tparam Selection Selection policy with reset(), next() and record(), and resume() for restored quizzes.
+             * @tparam Scoring Scoring policy with reset(), record(), isComplete() and correctCount(), and optionally
+             *         isRetired().
+             */
+            template<typename PromptField, typename AnswerField, typename Selection, typename Scoring = SessionScoring>
+            class QuizEngine
+            {
+            public:
+                using Prompt = PromptField; /**< Field policy of the asked text. */
+                using Answer = AnswerField; /**< Field policy of the expected answer. */
+
+                /**
+                 * @brief Constructs an engine; start() asks the first question.
+                 * @param words The words in the order the selection sees them.
+                 * @param seed Seed of the random number generator.
+                 * @param scoring The scoring policy, e.g. with its number of required answers.
+                 */
+                QuizEngine(std::vector<Word> words, uint32_t seed, Scoring scoring = Scoring())
+                    : m_words(std::move(words)), m_generator(seed), m_scoring(std::move(scoring))
+                {
+                }
+
+                /**
+                 * @brief Starts the quiz over with the first question.
+                 */
+                void start()
+                {
+                    m_asked = 0;
+                    m_current = 0;
+                    m_selection.reset(m_words.size());
+                    m_scoring.reset(m_words.size());
+                    if( !m_words.empty() )
+                    {
+                        m_current = m_selection.next(m_generator, m_scoring);
+                    }
+                }
+
+                /**
+                 * @brief Continues a quiz whose answers were restored into scoring(), e.g. from a snapshot.
+                 * @param current Index of the word of the current question.
+                 * @param asked Number of answered questions.
+                 */
+                void resume(std::size_t current, std::size_t asked)
+                {
+                    m_asked = asked;
+                    m_current = current < m_words.size() ? current : 0;
+                    m_selection.resume(m_words.size(), m_current, m_scoring);
+                }
+
+                /**
+                 * @brief Answers the current question and moves to the next one.
+                 * @param response The answer.
+                 * @return True if the answer was correct.
+                 */
+                bool submit(std::string_view response)
+                {
+                    const bool correct = response == AnswerField::get(m_words[m_current]);
+                    submitOutcome(correct);
+                    return correct;
+                }
+
+                /**
+                 * @brief Counts the current question as answered and moves to the next one.
+                 *
+                 * For quizzes which judge the answer themselves, e.g. a cloze quiz accepting several spellings.
+                 *
+                 * @param correct True if the answer was correct.
+                 */
+                void submitOutcome(bool correct)
+                {
+                    m_scoring.record(m_current, correct);
+                    m_selection.record(m_current, correct);
+                    ++m_asked;
+                    if( !isFinished() )
+                    {
+                        m_current = m_selection.next(m_generator, m_scoring);
+                    }
+                }
+
+                /**
+                 * @brief Checks if the quiz is over.
+                 * @return True if there is no question left.
+                 */
+                bool isFinished() const
+                {
+                    return m_words.empty() || m_scoring.isComplete(m_asked);
+                }
+
+                /**
+                 * @brief Gets the word of the current question.
+                 * @return The word.
+                 */
+                const Word& currentWord() const
+                {
+                    return m_words[m_current];
+                }
+
+                /**
+                 * @brief Gets the index of the word of the current question.
+                 * @return The index within words().
+                 */
+                std::size_t currentIndex() const
+                {
+                    return m_current;
+                }
+
+                /**
+                 * @brief Gets the asked text of the current question.
+                 * @return The prompt field of the current word.
+                 */
+                const std::string& prompt() const
+                {
+                    return PromptField::get(m_words[m_current]);
+                }
+
+                /**
+                 * @brief Gets the expected answer of the current question.
+                 * @return The answer field of the current word.
+                 */
+                const std::string& expectedAnswer() const
+                {
+                    return AnswerField::get(m_words[m_current]);
+                }
+
+                /**
+                 * @brief Gets the number of answered questions.
+                 * @return The number of answers.
+                 */
+                std::size_t asked() const
+                {
+                    return m_asked;
+                }
+
+                /**
+                 * @brief Gets the words of the quiz.
+                 * @return The words.
+                 */
+                const std::vector<Word>& words() const
+                {
+                    return m_words;
+                }
+
+                /**
+                 * @brief Gets the scoring policy.
+                 * @return The scoring.
+                 */
+                const Scoring& scoring() const
+                {
+                    return m_scoring;
+                }
+
+                /**
+                 * @brief Gets the scoring policy to restore its answers before resume().
+                 * @return The scoring.
+                 */
+                Scoring& scoring()
+                {
+                    return m_scoring;
+                }
+
+                /**
+                 * @brief Gets the random number generator, e.g. to draw distractors.
+                 * @return The generator.
+                 */
+                std::mt19937& generator()
+                {
+                    return m_generator;
+                }
+
+            private:
+                std::vector<Word> m_words; /**< Words of the quiz. */
+                std::mt19937 m_generator; /**< Random number generator of the selection. */
+                Selection m_selection; /**< Picks the word of every question. */
+                Scoring m_scoring; /**< Counts the answers and ends the quiz. */
+                std::size_t m_current = 0; /**< Index of the word of the current question. */
+                std::size_t m_asked = 0; /**< Number of answered questions. */
+            };
+        }
+    }
+}
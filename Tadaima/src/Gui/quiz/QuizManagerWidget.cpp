@@ -1,6 +1,10 @@
 #include "QuizManagerWidget.h"
 #include "widgets/VocabularyQuizWidget.h"
+#include "widgets/ClozeQuizWidget.h"
 #include "widgets/packages/SettingsDataPackage.h"
+#include "widgets/packages/ReviewDataPackage.h"
+#include "widgets/packages/ConfusionDataPackage.h"
+#include "tools/AllocationTracker.h"
 
 namespace tadaima
 {
@@ -8,25 +12,44 @@ namespace tadaima
     {
         namespace quiz
         {
-            QuizManagerWidget::QuizManagerWidget(tools::Logger& logger) :m_logger(logger), quizWidgetOpen(false)
+            QuizManagerWidget::QuizManagerWidget(tools::Logger& logger) : Widget(widget::Type::QuizManager), m_logger(logger), quizWidgetOpen(false)
             {
-
+                m_quiz = widget::VocabularyQuizWidget::loadSnapshot(widget::VocabularyQuizWidget::SNAPSHOT_PATH, m_logger, &vocabularyQuizFactory<WordType>);
+                if( m_quiz )
+                {
+                    m_logger.log("Resuming unfinished VocabularyQuiz.", tools::LogLevel::INFO);
+                    m_quizType = QuizType::VocabularyQuiz;
+                    m_quiz->setObserver(std::bind(&QuizManagerWidget::handleQuizEvent, this, std::placeholders::_1));
+                    quizWidgetOpen = true;
+                }
             }
 
             void QuizManagerWidget::startQuiz(QuizType type, const std::vector<Lesson>& lesson)
             {
+                AllocationScope scope(AllocationTag::Quiz);
                 if( QuizType::MultipleChoiceQuiz == type )
                 {
                     m_quiz.reset();
                     m_logger.log("Starting MultipleChoiceQuiz.", tools::LogLevel::INFO);
-                    m_quiz = std::make_unique<widget::QuizWidget>(m_askedWordType, m_answerWordType, lesson, m_logger);
+                    m_quiz = std::make_unique<widget::QuizWidget>(multipleChoiceFactory(m_askedWordType, m_answerWordType, m_order), lesson, m_logger, m_order, &m_confusions);
+                    m_quiz->setObserver(std::bind(&QuizManagerWidget::handleQuizEvent, this, std::placeholders::_1));
                     quizWidgetOpen = true;
                 }
                 else if( QuizType::VocabularyQuiz == type )
                 {
                     m_quiz.reset();
                     m_logger.log("Starting VocabularyQuiz.", tools::LogLevel::INFO);
-                    m_quiz = std::make_unique<widget::VocabularyQuizWidget>(m_askedWordType, m_answerWordType , lesson, m_logger );
+                    m_quiz = std::make_unique<widget::VocabularyQuizWidget>(m_askedWordType, m_answerWordType, m_order, vocabularyQuizFactory(m_askedWordType, m_answerWordType, m_order),
+                        lesson, m_logger);
+                    m_quiz->setObserver(std::bind(&QuizManagerWidget::handleQuizEvent, this, std::placeholders::_1));
+                    quizWidgetOpen = true;
+                }
+                else if( QuizType::ClozeQuiz == type )
+                {
+                    m_quiz.reset();
+                    m_logger.log("Starting ClozeQuiz.", tools::LogLevel::INFO);
+                    m_quiz = std::make_unique<widget::ClozeQuizWidget>(lesson, m_logger, m_order);
+                    m_quiz->setObserver(std::bind(&QuizManagerWidget::handleQuizEvent, this, std::placeholders::_1));
                     quizWidgetOpen = true;
                 }
             }
@@ -35,10 +58,37 @@ namespace tadaima
             {
                 if( quizWidgetOpen && m_quiz )
                 {
+                    AllocationScope scope(AllocationTag::Quiz);
                     m_quiz->draw(&quizWidgetOpen);
                 }
             }
 
+            MultipleChoiceQuiz::SessionFactory QuizManagerWidget::multipleChoiceFactory(WordType asked, WordType answer, QuizOrder order)
+            {
+                return withField(asked, [order, answer](auto prompt)
+                    {
+                        using Prompt = decltype(prompt);
+                        return withField(answer, [order](auto expected) -> MultipleChoiceQuiz::SessionFactory
+                            {
+                                using Answer = decltype(expected);
+                                if( QuizOrder::Adaptive == order )
+                                {
+                                    return &makeMultipleChoiceSession<Prompt, Answer, AdaptiveSelection>;
+                                }
+                                return &makeMultipleChoiceSession<Prompt, Answer, SequentialSelection>;
+                            });
+                    });
+            }
+
+            void QuizManagerWidget::handleQuizEvent(const widget::WidgetEvent& event)
+            {
+                widget::ReviewDataPackage* package = dynamic_cast<widget::ReviewDataPackage*>(event.getEventData());
+                if( nullptr != package )
+                {
+                    emitEvent(widget::WidgetEvent(*this, QuizManagerWidgetEvent::OnWordReviewed, package));
+                }
+            }
+
             void QuizManagerWidget::initialize(const tools::DataPackage& r_package)
             {
                 try
@@ -50,6 +100,17 @@ namespace tadaima
 
                         m_answerWordType = package->get< quiz::WordType>(widget::SettingsPackageKey::AnswerWordType);
                         m_askedWordType = package->get<quiz::WordType>(widget::SettingsPackageKey::AskedWordType);
+                        m_order = package->get<bool>(widget::SettingsPackageKey::FrequencyOrder) ? QuizOrder::Frequency : QuizOrder::Random;
+                        if( package->get<bool>(widget::SettingsPackageKey::AdaptiveOrder) )
+                        {
+                            m_order = QuizOrder::Adaptive;
+                        }
+                    }
+
+                    const widget::ConfusionDataPackage* confusionPackage = dynamic_cast<const widget::ConfusionDataPackage*>(&r_package);
+                    if( confusionPackage )
+                    {
+                        m_confusions.load(confusionPackage->decode());
                     }
                 }
                 catch( std::exception& exception )
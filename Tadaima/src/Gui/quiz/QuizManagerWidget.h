@@ -8,7 +8,9 @@
 #include "QuizType.h"
 #include "widgets/Widget.h"
 #include "widgets/QuizWidget.h"
+#include "VocabularyQuiz.h"
 #include "lessons/Lesson.h"
+#include "review/ConfusionTable.h"
 #include <memory>
 #include <vector>
 
@@ -23,11 +25,22 @@ namespace tadaima
             /**
              * @class QuizManager
              * @brief Manages the lifecycle and display of quiz widgets.
+             *
+             * The word types and the order chosen in the settings are resolved here into the QuizEngine instantiation
+             * of the quiz, so the quizzes themselves never switch on them.
              */
             class QuizManagerWidget : public widget::Widget
             {
             public:
 
+                /**
+                 * @brief Enum representing events emitted by the QuizManagerWidget.
+                 */
+                enum QuizManagerWidgetEvent : uint8_t
+                {
+                    OnWordReviewed  /**< Event emitted when a word was answered in any quiz. */
+                };
+
                 /**
                  * @brief Constructs a new QuizManagerWidget object.
                  *
@@ -63,8 +76,29 @@ namespace tadaima
 
             private:
 
+                /**
+                 * @brief Finds the multiple choice session instantiation of a combination of word types and order.
+                 *
+                 * Random and frequency order ask every word once, in the order the quiz prepared.
+                 *
+                 * @param asked The asked word type.
+                 * @param answer The expected word type.
+                 * @param order The order in which the words are asked.
+                 * @return The factory of the session.
+                 */
+                static MultipleChoiceQuiz::SessionFactory multipleChoiceFactory(WordType asked, WordType answer, QuizOrder order);
+
+                /**
+                 * @brief Forwards events emitted by the running quiz widget.
+                 *
+                 * @param event The event emitted by the quiz widget.
+                 */
+                void handleQuizEvent(const widget::WidgetEvent& event);
+
                 quiz::WordType m_answerWordType = quiz::WordType::BaseWord; /**< Input option for word type. */
                 quiz::WordType m_askedWordType = quiz::WordType::Romaji; /**< Translation option for word type. */
+                QuizOrder m_order = QuizOrder::Random; /**< Order in which the words are asked. */
+                review::ConfusionTable m_confusions; /**< Words mixed up in earlier quizzes, offered as distractors. */
 
                 QuizType m_quizType; /**< The current quiz type. */
                 tools::Logger& m_logger; /**< Reference to the Logger instance for logging. */
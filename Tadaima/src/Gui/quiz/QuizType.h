@@ -1,6 +1,6 @@
 #pragma once
 
-#include <widemath.h>
+#include <cstdint>
 
 namespace tadaima
 {
@@ -14,7 +14,8 @@ namespace tadaima
             enum class QuizType : uint8_t
             {
                 MultipleChoiceQuiz, ///< A quiz with multiple choice questions.
-                VocabularyQuiz      ///< A quiz focusing on vocabulary.
+                VocabularyQuiz,     ///< A quiz focusing on vocabulary.
+                ClozeQuiz           ///< A quiz blanking words in their example sentences.
             };
 
             /**
@@ -26,6 +27,16 @@ namespace tadaima
                 Kana,        ///< Answer in Kana (Japanese syllabaries including Hiragana and Katakana).
                 Romaji,      ///< Answer in Romaji (Latin script representation of Japanese).
             };
+
+            /**
+             * @brief Enum class representing the order in which words are asked.
+             */
+            enum class QuizOrder : uint8_t
+            {
+                Random,     ///< Words are shuffled.
+                Frequency,  ///< The most common words are asked first.
+                Adaptive    ///< Words answered wrong are asked more often.
+            };
       
         }
     }
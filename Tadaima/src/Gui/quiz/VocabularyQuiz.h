@@ -3,18 +3,20 @@
  * @brief Declaration of the VocabularyQuiz class for managing vocabulary quizzes.
  *
  * This file contains the declaration of the VocabularyQuiz class, which is used
- * to manage the state and progress of a vocabulary quiz. The quiz uses flashcards
- * to test the user's knowledge and keeps track of correct answers and mistakes.
+ * to manage the state and progress of a vocabulary quiz. The quiz asks every word
+ * until it is learnt and keeps track of correct answers and mistakes.
  */
 
 #pragma once
 
-#include "QuizWord.h"
-#include <vector>
-#include <unordered_map>
+#include "QuizEngine.h"
+#include "tools/BinaryBuffer.h"
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
 #include <string>
-
-
+#include <vector>
 
 namespace tadaima
 {
@@ -24,128 +26,337 @@ namespace tadaima
         {
             /**
              * @class VocabularyQuiz
-             * @brief A class to manage a vocabulary quiz using flashcards.
+             * @brief A quiz asking every word until its correct answers exceed its mistakes by a required number.
              *
-             * The VocabularyQuiz class provides functionality to conduct a vocabulary
-             * quiz using a set of flashcards. It tracks the user's progress, manages
-             * correct answers, and provides information about flashcards with mistakes.
+             * The questions are run by a VocabularyEngine, a QuizEngine instantiation chosen by whoever creates the quiz,
+             * so only the calls of the widget go through this interface. The words are kept in the order they were given,
+             * statistics and snapshots refer to them by their index.
              */
             class VocabularyQuiz
             {
             public:
+                using WordStatistics = MasteryScoring::WordStatistics; ///< Answers of one word.
+                using Factory = std::unique_ptr<VocabularyQuiz>(*)(std::vector<Word>, int); ///< E.g. makeVocabularyQuiz<KanaField, TranslationField, RandomSelection>.
+
+                virtual ~VocabularyQuiz() = default;
 
                 /**
-                 * @struct WordStatistics
-                 * @brief A structure to hold statistics for each word in the quiz.
+                 * @brief Answers the current word and moves to the next one.
                  *
-                 * This structure keeps track of the number of good and bad attempts
-                 * for each word and whether the word has been learnt.
+                 * @param userAnswer The answer provided by the user.
+                 * @return True if the user's answer was correct, false otherwise.
                  */
-                struct WordStatistics
-                {
-                    int goodAttempts; ///< Number of good attempts.
-                    int badAttempts; ///< Number of bad attempts.
-                    bool learnt; ///< Whether the word has been learnt.
-
-                    /**
-                     * @brief Constructor for WordStatistics.
-                     *
-                     * Initializes the statistics with zero attempts and not learnt status.
-                     */
-                    WordStatistics() : goodAttempts(0), badAttempts(0), learnt(false) {}
-                };
+                virtual bool advance(const std::string& userAnswer) = 0;
 
                 /**
-                 * @brief Constructor for the VocabularyQuiz class.
+                 * @brief Checks if the user's answer is correct.
                  *
-                 * Initializes the quiz with a set of flashcards, the required number of correct
-                 * answers for each flashcard, and an option to shuffle the flashcards.
+                 * @param userAnswer The answer provided by the user.
+                 * @return True if the user's answer was correct, false otherwise.
+                 */
+                virtual bool isCorrect(const std::string& userAnswer) const = 0;
+
+                /**
+                 * @brief Checks if the quiz is complete.
                  *
-                 * @param flashcards Reference to a vector of flashcards to be used in the quiz.
-                 * @param requiredCorrectAnswers The number of correct answers required for each flashcard.
-                 * @param enableShuffle Boolean indicating whether to shuffle the flashcards.
+                 * @return True once every word is learnt, false otherwise.
                  */
-                VocabularyQuiz(std::vector<QuizWord>& flashcards, int requiredCorrectAnswers, bool enableShuffle = true);
+                virtual bool isQuizComplete() const = 0;
 
                 /**
-                 * @brief Advances the quiz to the next flashcard based on the user's answer.
+                 * @brief Retrieves the number of words in the quiz.
                  *
-                 * This function checks the user's answer against the current flashcard and updates
-                 * the progress of the quiz accordingly.
+                 * @return The number of words.
+                 */
+                virtual uint32_t getNumberOflashcards() const = 0;
+
+                /**
+                 * @brief Retrieves the number of learnt words in the quiz.
                  *
-                 * @param userAnswer The answer provided by the user.
-                 * @return True if the user's answer was correct, false otherwise.
+                 * @return The number of learnt words.
                  */
-                bool advance(const std::string& userAnswer);
+                virtual uint32_t getLearntWords() const = 0;
 
                 /**
-                 * @brief Checks if the user's answer is correct.
+                 * @brief Retrieves the words of the quiz.
                  *
-                 * @param userAnswer The answer provided by the user.
-                 * @return True if the user's answer was correct, false otherwise.
+                 * @return The words, in the order of getStatistics().
                  */
-                bool isCorrect(const std::string& userAnswer);
+                virtual const std::vector<Word>& getWords() const = 0;
 
                 /**
-                 * @brief Checks if the quiz is complete.
+                 * @brief Retrieves the statistics of every word in the quiz.
                  *
-                 * This function returns true if all flashcards have been answered correctly the
-                 * required number of times.
+                 * @return The statistics, indexed like getWords().
+                 */
+                virtual const std::vector<WordStatistics>& getStatistics() const = 0;
+
+                /**
+                 * @brief Retrieves the index of the current word.
                  *
-                 * @return True if the quiz is complete, false otherwise.
+                 * @return The index within getWords().
+                 * @throws std::invalid_argument If the quiz is complete.
                  */
-                bool isQuizComplete() const;
+                virtual std::size_t getCurrentIndex() const = 0;
 
                 /**
-                 * @brief Retrieves the number of flashcards in the quiz.
+                 * @brief Retrieves the current word.
                  *
-                 * @return The number of flashcards.
+                 * @return The word.
+                 * @throws std::invalid_argument If the quiz is complete.
                  */
-                uint32_t getNumberOflashcards() const;
+                virtual const Word& getCurrentWord() const = 0;
 
                 /**
-                 * @brief Retrieves the number of learnt words in the quiz.
+                 * @brief Retrieves the asked text of the current word.
                  *
-                 * @return The number of learnt words.
+                 * @return The prompt.
+                 * @throws std::invalid_argument If the quiz is complete.
                  */
-                uint32_t getLearntWords() const;
+                virtual const std::string& getPrompt() const = 0;
 
                 /**
-                 * @brief Retrieves the statistics for each word in the quiz.
+                 * @brief Retrieves the expected answer of the current word.
                  *
-                 * @return A const reference to an unordered map of word statistics.
+                 * @return The answer.
+                 * @throws std::invalid_argument If the quiz is complete.
                  */
-                const std::unordered_map<int, WordStatistics>& getStatistics() const;
+                virtual const std::string& getExpectedAnswer() const = 0;
 
                 /**
-                 * @brief Retrieves the current flashcard.
+                 * @brief Appends the state of the quiz to a binary buffer.
                  *
-                 * This function returns a reference to the current flashcard.
+                 * Only the number of required answers, the index of the current word and the statistics by word index are
+                 * written. The words are stored by the caller, which creates the same instantiation to restore them.
                  *
-                 * @return A reference to the current flashcard.
+                 * @param buffer The buffer to append to.
                  */
-                const QuizWord& getCurrentFlashCard() const;
+                virtual void serialize(std::string& buffer) const = 0;
 
-            private:
+                /**
+                 * @brief Restores the state written by serialize() into a quiz over the same words.
+                 *
+                 * @param reader Reader positioned at the start of the quiz state.
+                 * @throws std::runtime_error If the data is truncated or does not match the words.
+                 */
+                virtual void restore(binary::Reader& reader) = 0;
+            };
+
+            /**
+             * @brief VocabularyQuiz running its questions through a QuizEngine with MasteryScoring.
+             *
+             * @tparam PromptField Field policy of the asked text.
+             * @tparam AnswerField Field policy of the expected answer.
+             * @tparam Selection Selection policy, e.g. RandomSelection.
+             */
+            template<typename PromptField, typename AnswerField, typename Selection>
+            class VocabularyEngine final : public VocabularyQuiz
+            {
+            public:
+                static constexpr uint32_t NO_CURRENT_WORD = 0xFFFFFFFF; ///< Stored instead of the current word when the quiz is complete.
 
                 /**
-                 * @brief Moves to the next flashcard in the quiz.
+                 * @brief Constructs the quiz and asks the first word.
                  *
-                 * This function advances the quiz to the next flashcard, updating the current index
-                 * and selecting the next flashcard.
+                 * @param words The words; words without an answer are never learnt, so the caller leaves them out.
+                 * @param requiredCorrectAnswers The number of correct answers a word needs beyond its mistakes.
+                 * @param seed Seed of the random number generator.
                  */
-                void moveToNextFlashcard();
+                VocabularyEngine(std::vector<Word> words, int requiredCorrectAnswers, uint32_t seed = std::random_device{}())
+                    : m_engine(std::move(words), seed, MasteryScoring(requiredCorrectAnswers))
+                {
+                    m_engine.start();
+                }
 
-                std::vector<QuizWord> m_flashcards; ///< The vector of flashcards used in the quiz.
-                std::unordered_map<int, WordStatistics> m_statistics; ///< Map of word IDs to their statistics.
-                std::unordered_map<int, bool> learntStatus; ///< Map of word IDs to their learnt status.
+                bool advance(const std::string& userAnswer) override
+                {
+                    if( m_engine.isFinished() )
+                    {
+                        return false;
+                    }
+                    return m_engine.submit(userAnswer);
+                }
 
-                QuizWord* m_currentFlashcard = nullptr; ///< Pointer to the current flashcard.
+                bool isCorrect(const std::string& userAnswer) const override
+                {
+                    return !m_engine.isFinished() && userAnswer == m_engine.expectedAnswer();
+                }
+
+                bool isQuizComplete() const override
+                {
+                    return m_engine.isFinished();
+                }
+
+                uint32_t getNumberOflashcards() const override
+                {
+                    return static_cast<uint32_t>(m_engine.words().size());
+                }
+
+                uint32_t getLearntWords() const override
+                {
+                    return static_cast<uint32_t>(m_engine.scoring().learntCount());
+                }
+
+                const std::vector<Word>& getWords() const override
+                {
+                    return m_engine.words();
+                }
+
+                const std::vector<WordStatistics>& getStatistics() const override
+                {
+                    return m_engine.scoring().statistics();
+                }
+
+                std::size_t getCurrentIndex() const override
+                {
+                    requireCurrentWord();
+                    return m_engine.currentIndex();
+                }
+
+                const Word& getCurrentWord() const override
+                {
+                    requireCurrentWord();
+                    return m_engine.currentWord();
+                }
+
+                const std::string& getPrompt() const override
+                {
+                    requireCurrentWord();
+                    return m_engine.prompt();
+                }
+
+                const std::string& getExpectedAnswer() const override
+                {
+                    requireCurrentWord();
+                    return m_engine.expectedAnswer();
+                }
+
+                void serialize(std::string& buffer) const override
+                {
+                    const MasteryScoring& scoring = m_engine.scoring();
+                    binary::appendNumber(buffer, static_cast<uint32_t>(scoring.requiredCorrectAnswers()));
+                    binary::appendNumber(buffer, m_engine.isFinished() ? NO_CURRENT_WORD : static_cast<uint32_t>(m_engine.currentIndex()));
+                    binary::appendNumber(buffer, static_cast<uint32_t>(m_engine.asked()));
+                    binary::appendNumber(buffer, static_cast<uint32_t>(m_engine.words().size()));
+
+                    // Words never answered keep the default statistics
+                    uint32_t answered = 0;
+                    for( const auto& statistics : scoring.statistics() )
+                    {
+                        answered += statistics.goodAttempts + statistics.badAttempts > 0 ? 1 : 0;
+                    }
+                    binary::appendNumber(buffer, answered);
+                    for( std::size_t index = 0; index < scoring.statistics().size(); ++index )
+                    {
+                        const WordStatistics& statistics = scoring.statistics(index);
+                        if( statistics.goodAttempts + statistics.badAttempts > 0 )
+                        {
+                            binary::appendNumber(buffer, static_cast<uint32_t>(index));
+                            binary::appendNumber(buffer, static_cast<uint32_t>(statistics.goodAttempts));
+                            binary::appendNumber(buffer, static_cast<uint32_t>(statistics.badAttempts));
+                            binary::appendNumber(buffer, statistics.learnt ? 1 : 0);
+                        }
+                    }
+                }
 
-                int m_currentIndex = 0; ///< Index of the current flashcard.
-                int m_requiredCorrectAnswers; ///< The number of correct answers required for each flashcard.
-                bool m_shuffleEnabled; ///< Boolean indicating whether shuffling is enabled.
+                void restore(binary::Reader& reader) override
+                {
+                    const int requiredCorrectAnswers = static_cast<int>(reader.number());
+                    const uint32_t current = reader.number();
+                    const uint32_t asked = reader.number();
+                    const std::size_t wordCount = m_engine.words().size();
+                    if( reader.number() != wordCount )
+                    {
+                        throw std::runtime_error("VocabularyQuiz::restore: number of words does not match.");
+                    }
+
+                    m_engine.scoring() = MasteryScoring(requiredCorrectAnswers);
+                    m_engine.scoring().reset(wordCount);
+                    const uint32_t answered = reader.number();
+                    for( uint32_t entry = 0; entry < answered; ++entry )
+                    {
+                        const uint32_t index = reader.number();
+                        WordStatistics statistics;
+                        statistics.goodAttempts = static_cast<int>(reader.number());
+                        statistics.badAttempts = static_cast<int>(reader.number());
+                        statistics.learnt = reader.number() != 0;
+                        if( index >= wordCount )
+                        {
+                            throw std::runtime_error("VocabularyQuiz::restore: word out of range.");
+                        }
+                        m_engine.scoring().restore(index, statistics);
+                    }
+
+                    if( current != NO_CURRENT_WORD && (current >= wordCount || m_engine.scoring().isRetired(current)) )
+                    {
+                        throw std::runtime_error("VocabularyQuiz::restore: current word out of range.");
+                    }
+                    m_engine.resume(current, asked);
+                }
+
+            private:
+                // Keeps the accessors of a complete quiz from reading a word which is no longer asked
+                void requireCurrentWord() const
+                {
+                    if( m_engine.isFinished() )
+                    {
+                        throw std::invalid_argument("VocabularyQuiz: the quiz is complete, there is no current word.");
+                    }
+                }
+
+                QuizEngine<PromptField, AnswerField, Selection, MasteryScoring> m_engine; ///< Questions and answers.
             };
+
+            /**
+             * @brief Creates the quiz of one combination of asked field, answer field and order.
+             *
+             * Its address is a VocabularyQuiz::Factory, so the caller choosing the combination instantiates it.
+             *
+             * @param words The words of the quiz.
+             * @param requiredCorrectAnswers The number of correct answers a word needs beyond its mistakes.
+             * @return The quiz, asking its first word.
+             */
+            template<typename PromptField, typename AnswerField, typename Selection>
+            std::unique_ptr<VocabularyQuiz> makeVocabularyQuiz(std::vector<Word> words, int requiredCorrectAnswers)
+            {
+                return std::make_unique<VocabularyEngine<PromptField, AnswerField, Selection>>(std::move(words), requiredCorrectAnswers);
+            }
+
+            /**
+             * @brief Finds the quiz instantiation of a combination of asked field, expected field and order.
+             *
+             * Frequency order asks the words in their order, random order draws them with the same chance and adaptive
+             * order draws the words answered wrong more often.
+             *
+             * @tparam FieldKey WordType, or the name of a field as accepted by withField().
+             * @param asked The asked field.
+             * @param answer The expected field.
+             * @param order The order in which the words are asked.
+             * @return The factory of the quiz.
+             */
+            template<typename FieldKey>
+            VocabularyQuiz::Factory vocabularyQuizFactory(FieldKey asked, FieldKey answer, QuizOrder order)
+            {
+                return withField(asked, [answer, order](auto prompt)
+                    {
+                        using Prompt = decltype(prompt);
+                        return withField(answer, [order](auto expected) -> VocabularyQuiz::Factory
+                            {
+                                using Answer = decltype(expected);
+                                switch( order )
+                                {
+                                    case QuizOrder::Adaptive:
+                                        return &makeVocabularyQuiz<Prompt, Answer, AdaptiveSelection>;
+
+                                    case QuizOrder::Frequency:
+                                        return &makeVocabularyQuiz<Prompt, Answer, SequentialSelection>;
+
+                                    default:
+                                        return &makeVocabularyQuiz<Prompt, Answer, RandomSelection>;
+                                }
+                            });
+                    });
+            }
         }
     }
 }
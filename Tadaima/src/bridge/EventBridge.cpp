@@ -6,6 +6,15 @@
 #include "Widgets/LessonTreeViewWidget.h"
 #include "widgets/packages/SettingsDataPackage.h"
 #include "widgets/ApplicationSettingsWidget.h"
+#include "widgets/packages/ReviewDataPackage.h"
+#include "widgets/packages/ForecastDataPackage.h"
+#include "widgets/packages/OptimizationDataPackage.h"
+#include "widgets/packages/DeckDataPackage.h"
+#include "widgets/packages/WordOperationDataPackage.h"
+#include "widgets/packages/ConfusionDataPackage.h"
+#include "widgets/packages/CommitResultDataPackage.h"
+#include "widgets/MainDashboardWidget.h"
+#include "quiz/QuizManagerWidget.h"
 
 namespace tadaima
 {
@@ -18,6 +27,9 @@ namespace tadaima
 
         m_gui->addListener(gui::widget::Type::LessonTreeView, std::bind(&EventBridge::handleEvent, this, std::placeholders::_1));
         m_gui->addListener(gui::widget::Type::ApplicationSettings, std::bind(&EventBridge::handleEvent, this, std::placeholders::_1));
+        m_gui->addListener(gui::widget::Type::QuizManager, std::bind(&EventBridge::handleEvent, this, std::placeholders::_1));
+        m_gui->addListener(gui::widget::Type::Dashboard, std::bind(&EventBridge::handleEvent, this, std::placeholders::_1));
+        m_gui->setActivityListener([this] { m_app->noteUserActivity(); });
     }
 
     void EventBridge::initializeGui(const std::vector<Lesson>& lessons)
@@ -26,6 +38,18 @@ namespace tadaima
         m_gui->initializeWidget(lessonsPackage);
     }
 
+    void EventBridge::refreshLessons(const std::vector<Lesson>& lessons, const std::vector<int>& changedLessonIds)
+    {
+        gui::widget::LessonDataPackage lessonsPackage(lessons, changedLessonIds);
+        m_gui->initializeWidget(lessonsPackage);
+    }
+
+    void EventBridge::reportLessonChanges(const std::vector<application::GroupCommitResult>& results)
+    {
+        gui::widget::CommitResultDataPackage package(results);
+        m_gui->initializeWidget(package);
+    }
+
     void EventBridge::initializeSettings(const application::ApplicationSettings& settings)
     {
         gui::widget::SettingsDataPackage package;
@@ -36,10 +60,34 @@ namespace tadaima
         package.set(gui::widget::SettingsPackageKey::AskedWordType, stringToWordType(settings.inputWord));
         package.set(gui::widget::SettingsPackageKey::AnswerWordType, stringToWordType(settings.translatedWord));
         package.set(gui::widget::SettingsPackageKey::ShowLogs, settings.showLogs);
+        package.set(gui::widget::SettingsPackageKey::MemoryModel, settings.memoryModel);
+        package.set(gui::widget::SettingsPackageKey::FrequencyListPath, settings.frequencyListPath);
+        package.set(gui::widget::SettingsPackageKey::FrequencyOrder, settings.frequencyOrder);
+        package.set(gui::widget::SettingsPackageKey::AdaptiveOrder, settings.adaptiveOrder);
+        package.set(gui::widget::SettingsPackageKey::Leech, settings.leech);
+        package.set(gui::widget::SettingsPackageKey::GroupCommit, settings.groupCommit);
 
         m_gui->initializeWidget(package);
     }
 
+    void EventBridge::initializeForecast(const review::Forecast& forecast)
+    {
+        gui::widget::ForecastDataPackage package(forecast);
+        m_gui->initializeWidget(package);
+    }
+
+    void EventBridge::initializeOptimization(bool running, float progress, double loss)
+    {
+        gui::widget::OptimizationDataPackage package(running, progress, static_cast<float>(loss));
+        m_gui->initializeWidget(package);
+    }
+
+    void EventBridge::initializeConfusions(const std::vector<review::Confusion>& confusions, const std::vector<std::string>& descriptions)
+    {
+        gui::widget::ConfusionDataPackage package(confusions, descriptions);
+        m_gui->initializeWidget(package);
+    }
+
     void EventBridge::handleEvent(const gui::widget::WidgetEvent* data)
     {
         if( data == nullptr )
@@ -74,6 +122,24 @@ namespace tadaima
                     break;
                 }
 
+                case gui::widget::LessonTreeViewWidget::LessonTreeViewWidgetEvent::OnDeckImport:
+                {
+                    onDeckImport(data->getEventData());
+                    break;
+                }
+
+                case gui::widget::LessonTreeViewWidget::LessonTreeViewWidgetEvent::OnDeckExport:
+                {
+                    onDeckExport(data->getEventData());
+                    break;
+                }
+
+                case gui::widget::LessonTreeViewWidget::LessonTreeViewWidgetEvent::OnWordsChanged:
+                {
+                    onWordsChanged(data->getEventData());
+                    break;
+                }
+
                 default:
                     throw std::invalid_argument("Unhandled event type in handleEvent.");
             }
@@ -89,6 +155,48 @@ namespace tadaima
                     break;
                 }
 
+                case gui::widget::ApplicationSettingsWidget::ApplicationSettingsWidgetEvent::OnMemoryModelFitRequested:
+                {
+                    onMemoryModelFitRequested(data->getEventData());
+                    break;
+                }
+
+                case gui::widget::ApplicationSettingsWidget::ApplicationSettingsWidgetEvent::OnFrequencyListImport:
+                {
+                    onFrequencyListImport(data->getEventData());
+                    break;
+                }
+
+                default:
+                    throw std::invalid_argument("Unhandled event type in handleEvent.");
+            }
+        }
+
+        if( gui::widget::Type::QuizManager == data->getWidget().getType() )
+        {
+            switch( data->getEventType() )
+            {
+                case gui::quiz::QuizManagerWidget::QuizManagerWidgetEvent::OnWordReviewed:
+                {
+                    onWordReviewed(data->getEventData());
+                    break;
+                }
+
+                default:
+                    throw std::invalid_argument("Unhandled event type in handleEvent.");
+            }
+        }
+
+        if( gui::widget::Type::Dashboard == data->getWidget().getType() )
+        {
+            switch( data->getEventType() )
+            {
+                case gui::widget::MainDashboardWidget::MainDashboardWidgetEvent::OnForecastRequested:
+                {
+                    onForecastRequested(data->getEventData());
+                    break;
+                }
+
                 default:
                     throw std::invalid_argument("Unhandled event type in handleEvent.");
             }
@@ -143,11 +251,84 @@ namespace tadaima
             settings.inputWord = wordTypeToString(package->get<gui::quiz::WordType>(gui::widget::SettingsPackageKey::AskedWordType));
             settings.translatedWord = wordTypeToString(package->get<gui::quiz::WordType>(gui::widget::SettingsPackageKey::AnswerWordType));
             settings.showLogs = package->get<bool>(gui::widget::SettingsPackageKey::ShowLogs);
+            settings.memoryModel = package->get<review::MemoryModelParameters>(gui::widget::SettingsPackageKey::MemoryModel);
+            settings.frequencyListPath = package->get<std::string>(gui::widget::SettingsPackageKey::FrequencyListPath);
+            settings.frequencyOrder = package->get<bool>(gui::widget::SettingsPackageKey::FrequencyOrder);
+            settings.adaptiveOrder = package->get<bool>(gui::widget::SettingsPackageKey::AdaptiveOrder);
+            settings.leech = package->get<review::LeechOptions>(gui::widget::SettingsPackageKey::Leech);
+            settings.groupCommit = package->get<application::GroupCommitOptions>(gui::widget::SettingsPackageKey::GroupCommit);
 
             m_app->setEvent(application::ApplicationEvent::OnSettingsChanged, settings);
         }
     }
 
+    void EventBridge::onWordReviewed(const tools::DataPackage* dataPackage)
+    {
+        const gui::widget::ReviewDataPackage* package = dynamic_cast<const gui::widget::ReviewDataPackage*>(dataPackage);
+        if( nullptr != package )
+        {
+            m_app->setEvent(application::ApplicationEvent::OnWordReviewed, package->decode());
+        }
+    }
+
+    void EventBridge::onForecastRequested(const tools::DataPackage* dataPackage)
+    {
+        const gui::widget::ForecastDataPackage* package = dynamic_cast<const gui::widget::ForecastDataPackage*>(dataPackage);
+        if( nullptr != package )
+        {
+            m_app->setEvent(application::ApplicationEvent::OnForecastRequested, package->decodeOptions());
+        }
+    }
+
+    void EventBridge::onMemoryModelFitRequested(const tools::DataPackage* dataPackage)
+    {
+        const gui::widget::SettingsDataPackage* package = dynamic_cast<const gui::widget::SettingsDataPackage*>(dataPackage);
+        if( nullptr != package )
+        {
+            m_app->setEvent(application::ApplicationEvent::OnMemoryModelFitRequested, package->get<review::MemoryModelParameters>(gui::widget::SettingsPackageKey::MemoryModel));
+        }
+    }
+
+    void EventBridge::onFrequencyListImport(const tools::DataPackage* dataPackage)
+    {
+        const gui::widget::SettingsDataPackage* package = dynamic_cast<const gui::widget::SettingsDataPackage*>(dataPackage);
+        if( nullptr != package )
+        {
+            m_app->setEvent(application::ApplicationEvent::OnFrequencyListImported, package->get<std::string>(gui::widget::SettingsPackageKey::FrequencyListPath));
+        }
+    }
+
+    void EventBridge::onDeckImport(const tools::DataPackage* dataPackage)
+    {
+        const gui::widget::DeckDataPackage* package = dynamic_cast<const gui::widget::DeckDataPackage*>(dataPackage);
+        if( nullptr != package )
+        {
+            m_app->setEvent(application::ApplicationEvent::OnDeckImported, package->get<std::string>(gui::widget::DeckPackageKey::Path));
+        }
+    }
+
+    void EventBridge::onDeckExport(const tools::DataPackage* dataPackage)
+    {
+        const gui::widget::DeckDataPackage* package = dynamic_cast<const gui::widget::DeckDataPackage*>(dataPackage);
+        if( nullptr != package )
+        {
+            DeckExportRequest request;
+            request.path = package->get<std::string>(gui::widget::DeckPackageKey::Path);
+            request.name = package->get<std::string>(gui::widget::DeckPackageKey::Name);
+            request.lessonIds = package->get<std::vector<int>>(gui::widget::DeckPackageKey::LessonIds);
+            m_app->setEvent(application::ApplicationEvent::OnDeckExportRequested, request);
+        }
+    }
+
+    void EventBridge::onWordsChanged(const tools::DataPackage* dataPackage)
+    {
+        const gui::widget::WordOperationDataPackage* package = dynamic_cast<const gui::widget::WordOperationDataPackage*>(dataPackage);
+        if( nullptr != package )
+        {
+            m_app->setEvent(application::ApplicationEvent::OnWordsChanged, package->decode());
+        }
+    }
+
     gui::quiz::WordType EventBridge::stringToWordType(const std::string& str)
     {
         static const std::unordered_map<std::string, gui::quiz::WordType> stringToWordTypeMap = {
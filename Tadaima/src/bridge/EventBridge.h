@@ -20,7 +20,8 @@
 namespace tadaima
 {
     namespace gui { class Gui; }
-    namespace application { class Application; struct ApplicationSettings; }
+    namespace application { class Application; struct ApplicationSettings; struct GroupCommitResult; }
+    namespace review { struct Forecast; struct Confusion; }
 
     /**
      * @brief The EventBridge class bridges events between the GUI and the application logic.
@@ -47,12 +48,49 @@ namespace tadaima
          */
         void initializeGui(const std::vector<Lesson>& lessons);
 
+        /**
+         * @brief Refreshes the lessons touched by a batch of changes in the GUI.
+         *
+         * Unlike initializeGui() the rest of the library is kept as the GUI has it.
+         *
+         * @param lessons The touched lessons which still exist.
+         * @param changedLessonIds IDs of all touched lessons, the ones missing from the lessons were removed.
+         */
+        void refreshLessons(const std::vector<Lesson>& lessons, const std::vector<int>& changedLessonIds);
+
+        /**
+         * @brief Informs the GUI about the outcome of committed lesson changes.
+         * @param results The outcome of every change of the group commit.
+         */
+        void reportLessonChanges(const std::vector<application::GroupCommitResult>& results);
+
         /**
          * @brief Initializes the GUI with application settings.
          * @param settings The application settings to initialize in the GUI.
          */
         void initializeSettings(const application::ApplicationSettings& settings);
 
+        /**
+         * @brief Initializes the GUI with a review forecast.
+         * @param forecast The forecast to show in the GUI.
+         */
+        void initializeForecast(const review::Forecast& forecast);
+
+        /**
+         * @brief Informs the GUI about the progress of memory model fitting.
+         * @param running True if fitting is still in progress.
+         * @param progress Progress of fitting in range [0, 1].
+         * @param loss The current mean log loss.
+         */
+        void initializeOptimization(bool running, float progress, double loss);
+
+        /**
+         * @brief Initializes the GUI with the words mixed up in quizzes.
+         * @param confusions All stored confusions, most frequent first.
+         * @param descriptions Descriptions of the first confusions, one per confusion.
+         */
+        void initializeConfusions(const std::vector<review::Confusion>& confusions, const std::vector<std::string>& descriptions);
+
         /**
          * @brief Handles an event from the GUI.
          *
@@ -115,5 +153,64 @@ namespace tadaima
          * @param dataPackage The data package containing the changed settings information.
          */
         void onSettingsChanged(const tools::DataPackage* dataPackage);
+
+        /**
+         * @brief Handles the answers given during a quiz.
+         *
+         * This method processes the data package when words were reviewed in a quiz.
+         *
+         * @param dataPackage The data package containing the reviews.
+         */
+        void onWordReviewed(const tools::DataPackage* dataPackage);
+
+        /**
+         * @brief Handles a request for a new review forecast.
+         *
+         * This method processes the data package when the user asks for a forecast with new options.
+         *
+         * @param dataPackage The data package containing the forecast options.
+         */
+        void onForecastRequested(const tools::DataPackage* dataPackage);
+
+        /**
+         * @brief Handles a request for fitting the memory model.
+         *
+         * This method processes the data package when the user asks to fit the memory model to the review history.
+         *
+         * @param dataPackage The data package containing the current memory model parameters.
+         */
+        void onMemoryModelFitRequested(const tools::DataPackage* dataPackage);
+
+        /**
+         * @brief Handles the import of a word frequency list.
+         *
+         * This method processes the data package when the user imports a frequency list in the settings.
+         *
+         * @param dataPackage The data package containing the path to the frequency list.
+         */
+        void onFrequencyListImport(const tools::DataPackage* dataPackage);
+
+        /**
+         * @brief Handles the import of a deck pack.
+         *
+         * This method processes the data package when a deck pack is selected for import in the lesson tree.
+         *
+         * @param dataPackage The data package containing the path to the deck pack.
+         */
+        void onDeckImport(const tools::DataPackage* dataPackage);
+
+        /**
+         * @brief Handles the export of lessons as a deck pack.
+         *
+         * @param dataPackage The data package containing the path, deck name and lesson IDs.
+         */
+        void onDeckExport(const tools::DataPackage* dataPackage);
+
+        /**
+         * @brief Handles a change of the words marked in the lesson tree.
+         *
+         * @param dataPackage The data package containing the change.
+         */
+        void onWordsChanged(const tools::DataPackage* dataPackage);
     };
 }
@@ -0,0 +1,606 @@
+#include "CommandLineInterface.h"
+#include "Application/ApplicationDatabase.h"
+#include "Application/ApplicationSettings.h"
+#include "Application/QueryProfiler.h"
+#include "Application/ReviewRecorder.h"
+#include "Gui/Widgets/packages/LessonDataPackage.h"
+#include "Gui/quiz/ClozeQuiz.h"
+#include "Gui/quiz/LearnerSimulator.h"
+#include "Gui/quiz/VocabularyQuiz.h"
+#include "lessons/AnkiExporter.h"
+#include "lessons/FrequencyTable.h"
+#include "lessons/LessonManager.h"
+#include "lessons/LessonSerializer.h"
+#include "review/LeechDetector.h"
+#include "review/MemoryModel.h"
+#include "tools/AllocationTracker.h"
+#include "Tools/Logger.h"
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace tadaima
+{
+    namespace cli
+    {
+        namespace
+        {
+            constexpr double SECONDS_PER_DAY = 86400.0;
+
+            int64_t now()
+            {
+                return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            }
+
+            /**
+             * @brief Reads one answer line, without the carriage return of Windows line endings.
+             */
+            bool readAnswer(std::istream& input, std::string& answer)
+            {
+                if( !std::getline(input, answer) )
+                {
+                    return false;
+                }
+                if( answer.ends_with('\r') )
+                {
+                    answer.pop_back();
+                }
+                return true;
+            }
+        }
+
+        CommandLineInterface::CommandLineInterface(std::istream& input, std::ostream& output) : m_input(input), m_output(output)
+        {
+        }
+
+        bool CommandLineInterface::isRequested() const
+        {
+            return find(CLI_OPTION) != nullptr;
+        }
+
+        int CommandLineInterface::run()
+        {
+            static const std::unordered_map<std::string, Command> COMMANDS =
+            {
+                { "import", &CommandLineInterface::importLessons },
+                { "export", &CommandLineInterface::exportLessons },
+                { "dedupe", &CommandLineInterface::dedupe },
+                { "backup", &CommandLineInterface::backup },
+                { "stats", &CommandLineInterface::stats },
+                { "quiz", &CommandLineInterface::quiz },
+                { "cloze", &CommandLineInterface::cloze },
+                { "benchmark", &CommandLineInterface::benchmark },
+                { "maintain", &CommandLineInterface::maintain },
+                { "similar", &CommandLineInterface::similar },
+                { "confusions", &CommandLineInterface::confusions },
+                { "simulate", &CommandLineInterface::simulate }
+            };
+
+            const std::string command = option(CLI_OPTION);
+            auto it = COMMANDS.find(command);
+            if( it == COMMANDS.end() )
+            {
+                displayHelp("Tadaima");
+                return command == "help" ? 0 : 1;
+            }
+
+            tools::ConsoleLogger logger(find("verbose") ? tools::LogLevel::INFO : tools::LogLevel::WARNING);
+            application::ApplicationDatabase database(databaseFiles(), logger);
+            return (this->*it->second)(database);
+        }
+
+        application::DatabaseFiles CommandLineInterface::databaseFiles() const
+        {
+            application::DatabaseFiles files;
+            files.deckPath = option("db", files.deckPath);
+            files.progressPath = option("progress", files.progressPath);
+            files.readOnlyDeck = find("readonly-deck") != nullptr;
+            return files;
+        }
+
+        void CommandLineInterface::displayHelp(const std::string& programName)
+        {
+            m_output << "Usage: " << programName << " --cli <command> [--db <deck>] [--progress <path>] [--readonly-deck] [--verbose] [options]\n"
+                << "Commands:\n"
+                << "  import --file <path>                   Import lessons from an .xml or .csv file.\n"
+                << "  export --file <path> [--lessons <ids>] Export lessons to an .xml, .csv or .apkg file.\n"
+                << "  dedupe                                 Merge repeated words of a lesson.\n"
+                << "  backup --file <path> [--progress-file <path>]\n"
+                << "                                         Copy the deck and optionally the progress database.\n"
+                << "  stats                                  Print lesson and review statistics.\n"
+                << "  quiz [--lessons <ids>] [--ask <type>] [--answer <type>] [--repeat <n>] [--ordered] [--adaptive]\n"
+                << "                                         Ask words and read one answer per line from stdin.\n"
+                << "  cloze [--lessons <ids>] [--adaptive]   Blank words in their example sentences and read the missing words.\n"
+                << "  benchmark [--iterations <n>]           Time bulk reads and conversions of the lessons.\n"
+                << "  maintain                               Analyze, vacuum and check the databases.\n"
+                << "  similar --text <kana> [--distance <n>] [--limit <n>]\n"
+                << "                                         List words spelled like the kana or romaji.\n"
+                << "  confusions [--limit <n>]               List the words mixed up most often in multiple choice quizzes.\n"
+                << "  simulate [--learners <n>] [--words <n>] [--distinct <n>] [--answers <n>]\n"
+                << "           [--accuracy <p>] [--forgetting <n>] [--familiarity <p>] [--seed <n>] [--adaptive]\n"
+                << "                                         Time the quiz engines with synthetic learners on a generated deck.\n"
+                << "Lesson IDs are comma separated, word types are BaseWord, Kana, Romaji or Kanji.\n"
+                << "Reviews and settings are kept in the progress database, so profiles can share a deck.\n";
+        }
+
+        const std::string* CommandLineInterface::find(const std::string& key) const
+        {
+            for( const auto& [name, value] : getAllArguments() )
+            {
+                if( name == key )
+                {
+                    return &value;
+                }
+            }
+            return nullptr;
+        }
+
+        std::string CommandLineInterface::option(const std::string& key, const std::string& fallback) const
+        {
+            const std::string* value = find(key);
+            return value != nullptr && !value->empty() ? *value : fallback;
+        }
+
+        std::vector<int> CommandLineInterface::lessonIds() const
+        {
+            std::vector<int> ids;
+            std::istringstream stream(option("lessons"));
+            std::string id;
+            while( std::getline(stream, id, ',') )
+            {
+                if( !id.empty() )
+                {
+                    ids.push_back(std::stoi(id));
+                }
+            }
+            return ids;
+        }
+
+        std::vector<Lesson> CommandLineInterface::selectedLessons(application::ApplicationDatabase& database) const
+        {
+            std::vector<Lesson> lessons = database.getAllLessons();
+            const std::vector<int> ids = lessonIds();
+            if( !ids.empty() )
+            {
+                std::erase_if(lessons, [&ids](const Lesson& lesson) { return std::find(ids.begin(), ids.end(), lesson.id) == ids.end(); });
+            }
+            return lessons;
+        }
+
+        int CommandLineInterface::importLessons(application::ApplicationDatabase& database)
+        {
+            const std::string path = option("file");
+            std::vector<Lesson> lessons;
+            if( path.empty() || !LessonSerializer::read(path, lessons) )
+            {
+                m_output << "Could not read lessons from '" << path << "'.\n";
+                return 1;
+            }
+
+            FrequencyTable frequencyTable;
+            if( frequencyTable.open(option("frequency", DEFAULT_FREQUENCY_TABLE_PATH)) )
+            {
+                frequencyTable.annotate(lessons);
+            }
+
+            std::size_t words = 0;
+            for( const auto& lesson : lessons )
+            {
+                words += lesson.words.size();
+            }
+            // One transaction for the whole file, so a failed import leaves the deck unchanged
+            if( !database.beginTransaction() || !LessonManager(database).addLessons(lessons) || !database.commitTransaction() )
+            {
+                database.rollbackTransaction();
+                m_output << "Could not import lessons from '" << path << "'.\n";
+                return 1;
+            }
+            m_output << std::format("Imported {} lessons with {} words.\n", lessons.size(), words);
+            return 0;
+        }
+
+        int CommandLineInterface::exportLessons(application::ApplicationDatabase& database)
+        {
+            const std::string path = option("file");
+            if( path.empty() )
+            {
+                m_output << "Missing --file.\n";
+                return 1;
+            }
+
+            if( path.ends_with(AnkiExporter::FILE_EXTENSION) )
+            {
+                AnkiExporter exporter;
+                bool failed = !exporter.begin(path);
+                if( !failed )
+                {
+                    database.forEachWord(lessonIds(), [&](const Lesson& lesson, const Word& word)
+                        {
+                            failed = failed || !exporter.addWord(lesson, word);
+                        });
+                }
+                if( failed || !exporter.finish() )
+                {
+                    exporter.cancel();
+                    m_output << "Could not write Anki package '" << path << "'.\n";
+                    return 1;
+                }
+                m_output << std::format("Exported {} notes.\n", exporter.noteCount());
+                return 0;
+            }
+
+            const std::vector<Lesson> lessons = selectedLessons(database);
+            if( !LessonSerializer::write(path, lessons) )
+            {
+                m_output << "Could not write lessons to '" << path << "'.\n";
+                return 1;
+            }
+            m_output << std::format("Exported {} lessons.\n", lessons.size());
+            return 0;
+        }
+
+        int CommandLineInterface::dedupe(application::ApplicationDatabase& database)
+        {
+            const int removed = database.removeDuplicateWords();
+            if( removed < 0 )
+            {
+                m_output << "Could not remove duplicate words.\n";
+                return 1;
+            }
+
+            if( removed > 0 )
+            {
+                // Reviews of the removed words were moved to the kept ones, so their states are replayed
+                const review::MemoryModel model(database.loadSettings().memoryModel);
+                std::vector<review::MemoryState> states;
+                for( const auto& record : database.getReviews() )
+                {
+                    if( states.empty() || states.back().wordId != record.wordId )
+                    {
+                        states.emplace_back();
+                    }
+                    model.applyReview(states.back(), record);
+                }
+                database.saveMemoryStates(states);
+            }
+            m_output << std::format("Removed {} duplicate words.\n", removed);
+            return 0;
+        }
+
+        int CommandLineInterface::backup(application::ApplicationDatabase& database)
+        {
+            const std::string path = option("file");
+            if( path.empty() || !database.backup(path, application::ApplicationDatabase::CONTENT_SCHEMA) )
+            {
+                m_output << "Could not back up the deck to '" << path << "'.\n";
+                return 1;
+            }
+            m_output << "Deck backed up to '" << path << "'.\n";
+
+            const std::string progressPath = option("progress-file");
+            if( progressPath.empty() )
+            {
+                return 0;
+            }
+            if( !database.backup(progressPath, "main") )
+            {
+                m_output << "Could not back up the progress database to '" << progressPath << "'.\n";
+                return 1;
+            }
+            m_output << "Progress database backed up to '" << progressPath << "'.\n";
+            return 0;
+        }
+
+        int CommandLineInterface::stats(application::ApplicationDatabase& database)
+        {
+            const std::vector<Lesson> lessons = database.getAllLessons();
+            std::size_t words = 0;
+            std::size_t withKanji = 0;
+            std::size_t leeches = 0;
+            for( const auto& lesson : lessons )
+            {
+                words += lesson.words.size();
+                for( const auto& word : lesson.words )
+                {
+                    withKanji += word.kanji.empty() ? 0 : 1;
+                    leeches += std::count(word.tags.begin(), word.tags.end(), review::LeechDetector::LEECH_TAG) > 0 ? 1 : 0;
+                }
+            }
+
+            const std::vector<review::ReviewRecord> reviews = database.getReviews();
+            const auto correct = std::count_if(reviews.begin(), reviews.end(), [](const review::ReviewRecord& record) { return record.correct; });
+
+            const application::ApplicationSettings settings = database.loadSettings();
+            const review::MemoryModel model(settings.memoryModel);
+            const std::vector<review::MemoryState> states = database.getMemoryStates();
+            const int64_t timestamp = now();
+            double stability = 0.0;
+            std::size_t due = 0;
+            for( const auto& state : states )
+            {
+                stability += state.stability;
+                const double elapsedDays = (timestamp - state.lastReview) / SECONDS_PER_DAY;
+                due += model.retrievability(state, elapsedDays) < settings.memoryModel.desiredRetention ? 1 : 0;
+            }
+
+            m_output << std::format("Lessons: {}\n", lessons.size())
+                << std::format("Words: {} (with kanji: {}, leeches: {})\n", words, withKanji, leeches)
+                << std::format("Reviews: {} (correct: {:.1f}%)\n", reviews.size(), reviews.empty() ? 0.0 : 100.0 * correct / reviews.size())
+                << std::format("Reviewed words: {} (due: {}, average stability: {:.1f} days)\n", states.size(), due, states.empty() ? 0.0 : stability / states.size());
+            return 0;
+        }
+
+        int CommandLineInterface::quiz(application::ApplicationDatabase& database)
+        {
+            const application::ApplicationSettings settings = database.loadSettings();
+            const std::string askedType = option("ask", settings.inputWord);
+            const std::string answerType = option("answer", settings.translatedWord);
+
+            std::vector<Word> words = gui::quiz::collectWords(selectedLessons(database));
+            std::erase_if(words, [&answerType](const Word& word) { return gui::quiz::wordField(word, answerType).empty(); });
+            if( words.empty() )
+            {
+                m_output << "No words to ask.\n";
+                return 1;
+            }
+
+            const gui::quiz::QuizOrder order = find("adaptive") != nullptr ? gui::quiz::QuizOrder::Adaptive
+                : find("ordered") != nullptr ? gui::quiz::QuizOrder::Frequency : gui::quiz::QuizOrder::Random;
+            const gui::quiz::VocabularyQuiz::Factory makeQuiz = gui::quiz::vocabularyQuizFactory<std::string_view>(askedType, answerType, order);
+            const std::unique_ptr<gui::quiz::VocabularyQuiz> vocabularyQuiz = makeQuiz(std::move(words), std::max(1, std::stoi(option("repeat", "2"))));
+            const review::MemoryModel model(settings.memoryModel);
+            const review::LeechDetector leechDetector(settings.leech);
+            tools::ConsoleLogger logger(find("verbose") ? tools::LogLevel::INFO : tools::LogLevel::WARNING);
+            application::ReviewRecorder recorder(database, model, leechDetector, logger);
+
+            std::string answer;
+            while( !vocabularyQuiz->isQuizComplete() )
+            {
+                const Word& word = vocabularyQuiz->getCurrentWord();
+                const std::string& expected = vocabularyQuiz->getExpectedAnswer();
+                m_output << vocabularyQuiz->getPrompt() << "\n> " << std::flush;
+                if( !readAnswer(m_input, answer) )
+                {
+                    break;
+                }
+
+                review::ReviewRecord record;
+                record.wordId = word.id;
+                record.timestamp = now();
+                record.correct = vocabularyQuiz->advance(answer);
+                m_output << (record.correct ? std::string("Correct!\n") : "Wrong, the answer is: " + expected + "\n");
+                recorder.record({ record });
+            }
+
+            m_output << std::format("Learnt {} of {} words.\n", vocabularyQuiz->getLearntWords(), vocabularyQuiz->getNumberOflashcards());
+            return 0;
+        }
+
+        int CommandLineInterface::cloze(application::ApplicationDatabase& database)
+        {
+            const application::ApplicationSettings settings = database.loadSettings();
+            const gui::quiz::QuizOrder order = find("adaptive") != nullptr ? gui::quiz::QuizOrder::Adaptive : gui::quiz::QuizOrder::Random;
+            std::unique_ptr<gui::quiz::ClozeQuiz> clozeQuiz;
+            try
+            {
+                clozeQuiz = std::make_unique<gui::quiz::ClozeQuiz>(selectedLessons(database), order);
+            }
+            catch( const std::invalid_argument& )
+            {
+                m_output << "No example sentence contains its word.\n";
+                return 1;
+            }
+
+            const review::MemoryModel model(settings.memoryModel);
+            const review::LeechDetector leechDetector(settings.leech);
+            tools::ConsoleLogger logger(find("verbose") ? tools::LogLevel::INFO : tools::LogLevel::WARNING);
+            application::ReviewRecorder recorder(database, model, leechDetector, logger);
+            clozeQuiz->start();
+
+            std::string answer;
+            while( !clozeQuiz->isFinished() )
+            {
+                const gui::quiz::ClozeCard card = clozeQuiz->currentCard();
+                m_output << card.sentence << " (" << card.translation << ")\n> " << std::flush;
+                if( !readAnswer(m_input, answer) )
+                {
+                    break;
+                }
+
+                review::ReviewRecord record;
+                record.wordId = card.wordId;
+                record.timestamp = now();
+                record.correct = clozeQuiz->submit(answer);
+                m_output << (record.correct ? std::string("Correct!\n") : "Wrong, the answer is: " + card.answer + "\n");
+                recorder.record({ record });
+            }
+
+            m_output << std::format("Answered {} of {} sentences correctly.\n", clozeQuiz->correctCount(), clozeQuiz->questionCount());
+            return 0;
+        }
+
+        int CommandLineInterface::benchmark(application::ApplicationDatabase& database)
+        {
+            /**
+             * @brief A timed operation.
+             */
+            struct Case
+            {
+                const char* name;
+                std::function<void()> body;
+            };
+
+            const int iterations = std::max(1, std::stoi(option("iterations", "10")));
+            const std::vector<Lesson> lessons = database.getAllLessons();
+            const gui::widget::LessonDataPackage package(lessons);
+            std::size_t visited = 0;
+
+            const Case cases[] =
+            {
+                { "load lessons", [&] { database.getAllLessons(); } },
+                { "stream words", [&] { database.forEachWord({}, [&visited](const Lesson&, const Word&) { ++visited; }); } },
+                { "encode package", [&] { gui::widget::LessonDataPackage encoded(lessons); } },
+                { "decode package", [&] { package.decode(); } },
+                { "write xml", [&] { std::ostringstream output; LessonSerializer::writeXml(output, lessons); } },
+                { "write csv", [&] { std::ostringstream output; LessonSerializer::writeCsv(output, lessons); } }
+            };
+
+            application::QueryProfiler::reset();
+            m_output << std::format("{} lessons, {} iterations\n", lessons.size(), iterations)
+                << std::format("{:<16}{:>12}{:>16}{:>16}\n", "Case", "ms/iter", "allocs/iter", "bytes/iter");
+            for( const auto& benchmarkCase : cases )
+            {
+                AllocationTracker::reset();
+                const auto start = std::chrono::steady_clock::now();
+                for( int iteration = 0; iteration < iterations; ++iteration )
+                {
+                    benchmarkCase.body();
+                }
+                const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+                const AllocationStats allocations = AllocationTracker::total();
+                if( AllocationTracker::ENABLED )
+                {
+                    m_output << std::format("{:<16}{:>12.3f}{:>16}{:>16}\n", benchmarkCase.name, elapsed.count() / iterations,
+                        allocations.allocations / iterations, allocations.bytes / iterations);
+                }
+                else
+                {
+                    m_output << std::format("{:<16}{:>12.3f}{:>16}{:>16}\n", benchmarkCase.name, elapsed.count() / iterations, "-", "-");
+                }
+            }
+
+            if( !AllocationTracker::ENABLED )
+            {
+                m_output << "Build with TadaimaTrackAllocations=true, or the CMake option TADAIMA_TRACK_ALLOCATIONS, to count allocations.\n";
+            }
+
+            constexpr std::size_t SHOWN_QUERIES = 5;
+            constexpr double NS_PER_MS = 1e6;
+            m_output << std::format("\n{:>12}{:>10}{:>14}  {}\n", "total ms", "calls", "vm steps", "Query");
+            for( const auto& stats : application::QueryProfiler::topQueries(SHOWN_QUERIES) )
+            {
+                m_output << std::format("{:>12.3f}{:>10}{:>14}  {}\n", stats.totalNs / NS_PER_MS, stats.calls, stats.vmSteps, stats.sql);
+            }
+            return 0;
+        }
+
+        int CommandLineInterface::similar(application::ApplicationDatabase& database)
+        {
+            const std::string text = option("text");
+            if( text.empty() )
+            {
+                m_output << "No text to look for.\n";
+                return 1;
+            }
+
+            const int distance = std::max(0, std::stoi(option("distance", "2")));
+            const int limit = std::max(1, std::stoi(option("limit", "20")));
+            for( const auto& word : database.findSimilarWords(text, distance, limit) )
+            {
+                m_output << std::format("{}\t{}\t{}\t{}\n", word.id, word.kana, word.romaji, word.translation);
+            }
+            return 0;
+        }
+
+        int CommandLineInterface::confusions(application::ApplicationDatabase& database)
+        {
+            const std::size_t limit = static_cast<std::size_t>(std::max(1, std::stoi(option("limit", "20"))));
+            std::vector<review::Confusion> confusions = database.getConfusions();
+            confusions.resize(std::min(limit, confusions.size()));
+
+            std::unordered_map<int, Word> words;
+            for( const auto& confusion : confusions )
+            {
+                words.emplace(confusion.targetId, Word{});
+                words.emplace(confusion.chosenId, Word{});
+            }
+            database.forEachWord({}, [&words](const Lesson&, const Word& word)
+                {
+                    auto it = words.find(word.id);
+                    if( it != words.end() )
+                    {
+                        it->second = word;
+                    }
+                });
+
+            for( const auto& confusion : confusions )
+            {
+                const Word& target = words[confusion.targetId];
+                const Word& chosen = words[confusion.chosenId];
+                m_output << std::format("{}\t{}\t{}\t{}\t{}\n", confusion.count, target.kana, target.translation, chosen.kana, chosen.translation);
+            }
+            return 0;
+        }
+
+        int CommandLineInterface::maintain(application::ApplicationDatabase& database)
+        {
+            // Nobody is waiting for the connection, so every task runs to the end without a deadline
+            const application::MaintenanceBudget budget{ std::chrono::steady_clock::time_point::max(), nullptr };
+            int failed = 0;
+            for( auto& task : database.maintenanceTasks() )
+            {
+                const auto start = std::chrono::steady_clock::now();
+                application::MaintenanceStatus status = application::MaintenanceStatus::Pending;
+                while( status == application::MaintenanceStatus::Pending )
+                {
+                    status = task.step(budget);
+                }
+                const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+                const bool done = status == application::MaintenanceStatus::Done;
+                failed += done ? 0 : 1;
+                database.saveMaintenanceRun(task.name, now());
+                m_output << std::format("{:<18}{:<8}{:>10.1f} ms\n", task.name, done ? "done" : "failed", elapsed.count());
+            }
+            return failed == 0 ? 0 : 1;
+        }
+
+        int CommandLineInterface::simulate(application::ApplicationDatabase&)
+        {
+            gui::quiz::SimulationOptions options;
+            options.learners = std::max(1, std::stoi(option("learners", std::to_string(options.learners))));
+            options.deckSize = std::max(1, std::stoi(option("words", std::to_string(options.deckSize))));
+            options.distinctAnswers = std::max(0, std::stoi(option("distinct", "0")));
+            options.answersPerLearner = std::max(1, std::stoi(option("answers", std::to_string(options.answersPerLearner))));
+            options.accuracy = std::clamp(std::stod(option("accuracy", std::to_string(options.accuracy))), 0.0, 1.0);
+            options.forgetting = std::max(1.0, std::stod(option("forgetting", std::to_string(options.forgetting))));
+            options.familiarity = std::clamp(std::stod(option("familiarity", std::to_string(options.familiarity))), 0.0, 1.0);
+            options.seed = static_cast<uint32_t>(std::stoul(option("seed", std::to_string(options.seed))));
+            options.adaptive = find("adaptive") != nullptr;
+
+            m_output << std::format("{} learners, {} words, {} answers per learner\n", options.learners, options.deckSize, options.answersPerLearner);
+            const gui::quiz::SimulationReport report = gui::quiz::LearnerSimulator(options).run();
+            if( !report.stalled )
+            {
+                m_output << std::format("{:<22}{:>10}{:>9}{:>11}{:>9}{:>9}{:>9}{:>9}{:>12}{:>12}{:>12}{:>12}\n", "Engine", "answers", "correct", "setup us",
+                    "mean us", "p50 us", "p99 us", "max us", "x4 words", "allocs/ans", "bytes/ans", "quiz bytes");
+                for( const auto* engine : { &report.vocabulary, &report.multipleChoice } )
+                {
+                    const double correct = engine->answers > 0 ? 100.0 * engine->correct / engine->answers : 0.0;
+                    m_output << std::format("{:<22}{:>10}{:>8.1f}%{:>11.1f}{:>9.2f}{:>9.2f}{:>9.2f}{:>9.1f}{:>11.2f}x", engine->engine, engine->answers, correct,
+                        engine->setup.meanUs, engine->answer.meanUs, engine->answer.p50Us, engine->answer.p99Us, engine->answer.maxUs, engine->scaling);
+                    if( AllocationTracker::ENABLED )
+                    {
+                        m_output << std::format("{:>12}{:>12}{:>12}\n", engine->allocations, engine->allocatedBytes, engine->quizBytes);
+                    }
+                    else
+                    {
+                        m_output << std::format("{:>12}{:>12}{:>12}\n", "-", "-", "-");
+                    }
+                }
+            }
+
+            for( const auto& problem : report.problems )
+            {
+                m_output << "Problem: " << problem << "\n";
+            }
+            return report.problems.empty() ? 0 : 1;
+        }
+    }
+}
@@ -0,0 +1,193 @@
+/**
+ * @file CommandLineInterface.h
+ * @brief Declares the CommandLineInterface class which runs batch operations on a lesson database without a window.
+ */
+
+#pragma once
+
+#include "Tools/CommandLineParser.h"
+#include "lessons/Lesson.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace tadaima
+{
+    namespace application
+    {
+        class ApplicationDatabase;
+        struct DatabaseFiles;
+    }
+
+    namespace cli
+    {
+        /**
+         * @brief The CommandLineInterface class runs a single command given as "--cli <command>" and exits.
+         *
+         * Commands work directly on the deck given with --db and the progress database given with --progress, without the GUI, the event bridge or the worker
+         * thread, so they can be scripted. Results are written to the output stream; log messages below the warning
+         * level are hidden unless --verbose is given. The sources only depend on the database, the lesson and review
+         * modules and the portable tools, so the interface can be built on its own for other platforms.
+         */
+        class CommandLineInterface : public tools::CommandLineParser
+        {
+        public:
+            static constexpr const char* CLI_OPTION = "cli"; /**< Option selecting the command, e.g. "--cli stats". */
+            static constexpr const char* DEFAULT_FREQUENCY_TABLE_PATH = "frequency.bin"; /**< Frequency table used to rank imported words. */
+
+            /**
+             * @brief Constructs the interface.
+             * @param input Stream answers of scripted quizzes are read from.
+             * @param output Stream results are written to.
+             */
+            explicit CommandLineInterface(std::istream& input = std::cin, std::ostream& output = std::cout);
+
+            /**
+             * @brief Checks if a command was given.
+             * @return True if the application should run a command instead of the GUI.
+             */
+            bool isRequested() const;
+
+            /**
+             * @brief Runs the requested command.
+             * @return The exit code of the process, 0 on success.
+             */
+            int run();
+
+            /**
+             * @brief Gets the databases selected with --db, --progress and --readonly-deck.
+             *
+             * The options also apply when the GUI starts, so each profile can keep its own progress database.
+             * @return The database files, defaults for missing options.
+             */
+            application::DatabaseFiles databaseFiles() const;
+
+            /**
+             * @brief Writes the list of commands and options.
+             * @param programName Name of the executable.
+             */
+            void displayHelp(const std::string& programName) override;
+
+        private:
+            /**
+             * @brief Pointer to a command handler.
+             */
+            using Command = int (CommandLineInterface::*)(application::ApplicationDatabase&);
+
+            /**
+             * @brief Finds the value of an option.
+             * @param key Name of the option without dashes.
+             * @return Pointer to the value, or nullptr if the option was not given.
+             */
+            const std::string* find(const std::string& key) const;
+
+            /**
+             * @brief Gets the value of an option.
+             * @param key Name of the option without dashes.
+             * @param fallback Value returned when the option was not given.
+             * @return The value.
+             */
+            std::string option(const std::string& key, const std::string& fallback = "") const;
+
+            /**
+             * @brief Gets the lesson IDs given with --lessons as a comma separated list.
+             * @return The IDs, empty if the option was not given.
+             */
+            std::vector<int> lessonIds() const;
+
+            /**
+             * @brief Gets the lessons selected with --lessons, or all lessons.
+             * @param database The database.
+             * @return The lessons with their words.
+             */
+            std::vector<Lesson> selectedLessons(application::ApplicationDatabase& database) const;
+
+            /**
+             * @brief Imports lessons from the XML or CSV file given with --file.
+             * @param database The database.
+             * @return The exit code.
+             */
+            int importLessons(application::ApplicationDatabase& database);
+
+            /**
+             * @brief Exports lessons to the XML, CSV or Anki package file given with --file.
+             * @param database The database.
+             * @return The exit code.
+             */
+            int exportLessons(application::ApplicationDatabase& database);
+
+            /**
+             * @brief Merges repeated words of a lesson and rebuilds the memory states.
+             * @param database The database.
+             * @return The exit code.
+             */
+            int dedupe(application::ApplicationDatabase& database);
+
+            /**
+             * @brief Copies the deck to the file given with --file and the progress database to the one given with --progress-file.
+             * @param database The database.
+             * @return The exit code.
+             */
+            int backup(application::ApplicationDatabase& database);
+
+            /**
+             * @brief Writes statistics of the lessons and the review history.
+             * @param database The database.
+             * @return The exit code.
+             */
+            int stats(application::ApplicationDatabase& database);
+
+            /**
+             * @brief Runs a vocabulary quiz reading one answer per line and stores the reviews.
+             * @param database The database.
+             * @return The exit code.
+             */
+            int quiz(application::ApplicationDatabase& database);
+
+            /**
+             * @brief Runs a cloze quiz over the example sentences reading one answer per line and stores the reviews.
+             * @param database The database.
+             * @return The exit code.
+             */
+            int cloze(application::ApplicationDatabase& database);
+
+            /**
+             * @brief Times the bulk reads and conversions of the lessons and reports their allocations.
+             * @param database The database.
+             * @return The exit code.
+             */
+            int benchmark(application::ApplicationDatabase& database);
+
+            /**
+             * @brief Prints the words spelled like the given kana or romaji, closest first.
+             * @param database The database.
+             * @return The exit code, 1 if no text was given.
+             */
+            int similar(application::ApplicationDatabase& database);
+
+            /**
+             * @brief Prints the words mixed up most often in multiple choice quizzes.
+             * @param database The database.
+             * @return The exit code.
+             */
+            int confusions(application::ApplicationDatabase& database);
+
+            /**
+             * @brief Runs every database maintenance task to the end and records the runs.
+             * @param database The database.
+             * @return The exit code, 1 if a task failed.
+             */
+            int maintain(application::ApplicationDatabase& database);
+
+            /**
+             * @brief Lets synthetic learners answer the quiz engines over a generated deck and reports latencies and problems.
+             * @param database The database, which the simulation does not use.
+             * @return The exit code, 1 if a problem was detected.
+             */
+            int simulate(application::ApplicationDatabase& database);
+
+            std::istream& m_input; /**< Stream answers are read from. */
+            std::ostream& m_output; /**< Stream results are written to. */
+        };
+    }
+}
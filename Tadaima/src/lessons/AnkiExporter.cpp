@@ -0,0 +1,350 @@
+#include "AnkiExporter.h"
+#include "tools/Sha1.h"
+#include "tools/ZipWriter.h"
+#include <Libraries/SQLite3/sqlite3.h>
+#include <chrono>
+#include <cstdio>
+
+namespace tadaima
+{
+    namespace
+    {
+        constexpr char FIELD_SEPARATOR = '\x1f';
+        constexpr int SORT_FIELD = 1; // Kana
+        constexpr int CARD_COUNT = 2; // Recognition and recall
+        constexpr int64_t DEFAULT_DECK_ID = 1;
+
+        const char* COLLECTION_SCHEMA =
+            "CREATE TABLE col (id integer primary key, crt integer not null, mod integer not null, scm integer not null, "
+            "ver integer not null, dty integer not null, usn integer not null, ls integer not null, conf text not null, "
+            "models text not null, decks text not null, dconf text not null, tags text not null);"
+            "CREATE TABLE notes (id integer primary key, guid text not null, mid integer not null, mod integer not null, "
+            "usn integer not null, tags text not null, flds text not null, sfld integer not null, csum integer not null, "
+            "flags integer not null, data text not null);"
+            "CREATE TABLE cards (id integer primary key, nid integer not null, did integer not null, ord integer not null, "
+            "mod integer not null, usn integer not null, type integer not null, queue integer not null, due integer not null, "
+            "ivl integer not null, factor integer not null, reps integer not null, lapses integer not null, left integer not null, "
+            "odue integer not null, odid integer not null, flags integer not null, data text not null);"
+            "CREATE TABLE revlog (id integer primary key, cid integer not null, usn integer not null, ease integer not null, "
+            "ivl integer not null, lastIvl integer not null, factor integer not null, time integer not null, type integer not null);"
+            "CREATE TABLE graves (usn integer not null, oid integer not null, type integer not null);"
+            "CREATE INDEX ix_notes_usn ON notes (usn);"
+            "CREATE INDEX ix_cards_usn ON cards (usn);"
+            "CREATE INDEX ix_revlog_usn ON revlog (usn);"
+            "CREATE INDEX ix_cards_nid ON cards (nid);"
+            "CREATE INDEX ix_cards_sched ON cards (did, queue, due);"
+            "CREATE INDEX ix_revlog_cid ON revlog (cid);"
+            "CREATE INDEX ix_notes_csum ON notes (csum);";
+
+        const char* RECOGNITION_FRONT = "{{#Kanji}}<div class=jp>{{Kanji}}</div>{{/Kanji}}{{^Kanji}}<div class=jp>{{Kana}}</div>{{/Kanji}}";
+        const char* RECOGNITION_BACK = "{{FrontSide}}<hr id=answer>{{#Kanji}}<div class=jp>{{Kana}}</div>{{/Kanji}}"
+            "<div>{{Romaji}}</div><div>{{Translation}}</div>{{#Example}}<div class=example>{{Example}}</div>{{/Example}}";
+        const char* RECALL_FRONT = "<div>{{Translation}}</div>";
+        const char* RECALL_BACK = "{{FrontSide}}<hr id=answer><div class=jp>{{Kanji}}</div><div class=jp>{{Kana}}</div>"
+            "<div>{{Romaji}}</div>{{#Example}}<div class=example>{{Example}}</div>{{/Example}}";
+        const char* CARD_CSS = ".card { font-family: arial; font-size: 20px; text-align: center; color: black; background-color: white; }\n"
+            ".jp { font-size: 40px; }\n.example { font-size: 16px; color: #666; }";
+
+        std::string escapeHtml(const std::string& text)
+        {
+            std::string escaped;
+            escaped.reserve(text.size());
+            for( char character : text )
+            {
+                switch( character )
+                {
+                    case '&': escaped += "&amp;"; break;
+                    case '<': escaped += "&lt;"; break;
+                    case '>': escaped += "&gt;"; break;
+                    case FIELD_SEPARATOR: escaped += ' '; break;
+                    default: escaped += character; break;
+                }
+            }
+            return escaped;
+        }
+
+        std::string quoteJson(const std::string& text)
+        {
+            std::string quoted = "\"";
+            for( char character : text )
+            {
+                switch( character )
+                {
+                    case '"': quoted += "\\\""; break;
+                    case '\\': quoted += "\\\\"; break;
+                    case '\n': quoted += "\\n"; break;
+                    case '\r': quoted += "\\r"; break;
+                    case '\t': quoted += "\\t"; break;
+                    default:
+                        if( static_cast<unsigned char>(character) < 0x20 )
+                        {
+                            char escaped[8];
+                            std::snprintf(escaped, sizeof(escaped), "\\u%04x", character);
+                            quoted += escaped;
+                        }
+                        else
+                        {
+                            quoted += character;
+                        }
+                        break;
+                }
+            }
+            return quoted + "\"";
+        }
+
+        std::string tagList(const std::vector<std::string>& tags)
+        {
+            std::string list;
+            for( std::string tag : tags )
+            {
+                for( char& character : tag )
+                {
+                    if( character == ' ' || character == '\t' )
+                    {
+                        character = '_'; // Anki tags are separated by spaces
+                    }
+                }
+                if( !tag.empty() )
+                {
+                    list += ' ' + tag;
+                }
+            }
+            return list.empty() ? list : list + ' ';
+        }
+
+        int64_t checksum(const std::string& sortField)
+        {
+            const Sha1::Digest digest = Sha1::digest(sortField.data(), sortField.size());
+            return (int64_t(digest[0]) << 24) | (int64_t(digest[1]) << 16) | (int64_t(digest[2]) << 8) | int64_t(digest[3]);
+        }
+
+        std::string templateJson(const char* name, int ord, const char* front, const char* back)
+        {
+            return "{\"name\":" + quoteJson(name) + ",\"ord\":" + std::to_string(ord) + ",\"qfmt\":" + quoteJson(front) +
+                ",\"afmt\":" + quoteJson(back) + ",\"did\":null,\"bqfmt\":\"\",\"bafmt\":\"\"}";
+        }
+
+        std::string fieldJson(const char* name, int ord)
+        {
+            return "{\"name\":" + quoteJson(name) + ",\"ord\":" + std::to_string(ord) +
+                ",\"sticky\":false,\"rtl\":false,\"font\":\"Arial\",\"size\":20,\"media\":[]}";
+        }
+
+        std::string deckJson(int64_t id, const std::string& name, int64_t modified)
+        {
+            return quoteJson(std::to_string(id)) + ":{\"id\":" + std::to_string(id) + ",\"name\":" + quoteJson(name) +
+                ",\"mod\":" + std::to_string(modified) + ",\"usn\":-1,\"desc\":\"\",\"dyn\":0,\"conf\":1,\"collapsed\":false,"
+                "\"browserCollapsed\":false,\"extendNew\":10,\"extendRev\":50,\"newToday\":[0,0],\"revToday\":[0,0],"
+                "\"lrnToday\":[0,0],\"timeToday\":[0,0]}";
+        }
+    }
+
+    AnkiExporter::~AnkiExporter()
+    {
+        cancel();
+    }
+
+    bool AnkiExporter::begin(const std::string& path)
+    {
+        cancel();
+
+        m_path = path;
+        m_collectionPath = path + ".collection.tmp";
+        m_timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        m_nextId = m_timestamp;
+        m_noteCount = 0;
+        std::remove(m_collectionPath.c_str());
+
+        const char* insertNoteSql = "INSERT INTO notes VALUES (?, ?, ?, ?, -1, ?, ?, ?, ?, 0, '');";
+        const char* insertCardSql = "INSERT INTO cards VALUES (?, ?, ?, ?, ?, -1, 0, 0, ?, 0, 0, 0, 0, 0, 0, 0, 0, '');";
+
+        if( sqlite3_open(m_collectionPath.c_str(), &m_db) != SQLITE_OK
+            || sqlite3_exec(m_db, "PRAGMA journal_mode = OFF; PRAGMA synchronous = OFF;", 0, 0, 0) != SQLITE_OK
+            || sqlite3_exec(m_db, COLLECTION_SCHEMA, 0, 0, 0) != SQLITE_OK
+            || sqlite3_exec(m_db, "BEGIN TRANSACTION;", 0, 0, 0) != SQLITE_OK
+            || sqlite3_prepare_v2(m_db, insertNoteSql, -1, &m_insertNote, 0) != SQLITE_OK
+            || sqlite3_prepare_v2(m_db, insertCardSql, -1, &m_insertCard, 0) != SQLITE_OK )
+        {
+            cancel();
+            return false;
+        }
+        return true;
+    }
+
+    bool AnkiExporter::addWord(const Lesson& lesson, const Word& word)
+    {
+        if( !m_db )
+        {
+            return false;
+        }
+
+        const std::string fields[] = { word.kanji, word.kana, word.romaji, word.translation, word.exampleSentence };
+        std::string joinedFields;
+        for( const auto& field : fields )
+        {
+            if( &field != fields )
+            {
+                joinedFields += FIELD_SEPARATOR;
+            }
+            joinedFields += escapeHtml(field);
+        }
+
+        const std::string& sortField = fields[SORT_FIELD];
+        const std::string guid = "tadaima/" + std::to_string(word.id >= 0 ? word.id : -static_cast<int64_t>(m_noteCount) - 1);
+        const std::string tags = tagList(word.tags);
+        const int64_t noteId = m_nextId++;
+        const int64_t modified = m_timestamp / 1000;
+
+        sqlite3_reset(m_insertNote);
+        sqlite3_bind_int64(m_insertNote, 1, noteId);
+        sqlite3_bind_text(m_insertNote, 2, guid.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(m_insertNote, 3, NOTE_TYPE_ID);
+        sqlite3_bind_int64(m_insertNote, 4, modified);
+        sqlite3_bind_text(m_insertNote, 5, tags.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(m_insertNote, 6, joinedFields.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_text(m_insertNote, 7, sortField.c_str(), -1, SQLITE_TRANSIENT);
+        sqlite3_bind_int64(m_insertNote, 8, checksum(sortField));
+        if( sqlite3_step(m_insertNote) != SQLITE_DONE )
+        {
+            return false;
+        }
+
+        const int64_t deck = deckId(lesson);
+        for( int ord = 0; ord < CARD_COUNT; ++ord )
+        {
+            sqlite3_reset(m_insertCard);
+            sqlite3_bind_int64(m_insertCard, 1, m_nextId++);
+            sqlite3_bind_int64(m_insertCard, 2, noteId);
+            sqlite3_bind_int64(m_insertCard, 3, deck);
+            sqlite3_bind_int(m_insertCard, 4, ord);
+            sqlite3_bind_int64(m_insertCard, 5, modified);
+            sqlite3_bind_int64(m_insertCard, 6, static_cast<int64_t>(m_noteCount) + 1); // New cards are due in export order
+            if( sqlite3_step(m_insertCard) != SQLITE_DONE )
+            {
+                return false;
+            }
+        }
+
+        ++m_noteCount;
+        return true;
+    }
+
+    bool AnkiExporter::finish()
+    {
+        if( !m_db )
+        {
+            return false;
+        }
+
+        const bool collectionWritten = writeCollection() && sqlite3_exec(m_db, "COMMIT;", 0, 0, 0) == SQLITE_OK;
+        closeCollection();
+
+        ZipWriter archive;
+        const bool written = collectionWritten
+            && archive.open(m_path)
+            && archive.addFile("collection.anki2", m_collectionPath)
+            && archive.addEntry("media", "{}")
+            && archive.close();
+
+        std::remove(m_collectionPath.c_str());
+        if( !written )
+        {
+            std::remove(m_path.c_str());
+        }
+        return written;
+    }
+
+    void AnkiExporter::cancel()
+    {
+        if( m_db )
+        {
+            closeCollection();
+            std::remove(m_collectionPath.c_str());
+        }
+        m_decks.clear();
+        m_deckOrder.clear();
+    }
+
+    std::size_t AnkiExporter::noteCount() const
+    {
+        return m_noteCount;
+    }
+
+    int64_t AnkiExporter::deckId(const Lesson& lesson)
+    {
+        auto it = m_decks.find(lesson.id);
+        if( it == m_decks.end() )
+        {
+            Deck deck;
+            deck.id = m_timestamp + static_cast<int64_t>(m_deckOrder.size()) + 1;
+            deck.name = lesson.subName.empty() || lesson.subName == lesson.mainName ? lesson.mainName : lesson.mainName + "::" + lesson.subName;
+            it = m_decks.emplace(lesson.id, deck).first;
+            m_deckOrder.push_back(lesson.id);
+        }
+        return it->second.id;
+    }
+
+    bool AnkiExporter::writeCollection()
+    {
+        const int64_t modified = m_timestamp / 1000;
+        const int64_t firstDeck = m_deckOrder.empty() ? DEFAULT_DECK_ID : m_decks.at(m_deckOrder.front()).id;
+
+        const std::string model = "{" + quoteJson(std::to_string(NOTE_TYPE_ID)) + ":{\"id\":" + std::to_string(NOTE_TYPE_ID) +
+            ",\"name\":" + quoteJson(NOTE_TYPE_NAME) + ",\"type\":0,\"mod\":" + std::to_string(modified) + ",\"usn\":-1,\"sortf\":" +
+            std::to_string(SORT_FIELD) + ",\"did\":" + std::to_string(firstDeck) + ",\"tmpls\":[" +
+            templateJson("Recognition", 0, RECOGNITION_FRONT, RECOGNITION_BACK) + "," + templateJson("Recall", 1, RECALL_FRONT, RECALL_BACK) +
+            "],\"flds\":[" + fieldJson("Kanji", 0) + "," + fieldJson("Kana", 1) + "," + fieldJson("Romaji", 2) + "," +
+            fieldJson("Translation", 3) + "," + fieldJson("Example", 4) + "],\"css\":" + quoteJson(CARD_CSS) +
+            ",\"latexPre\":" + quoteJson("\\documentclass[12pt]{article}\n\\special{papersize=3in,5in}\n\\usepackage[utf8]{inputenc}\n"
+                "\\usepackage{amssymb,amsmath}\n\\pagestyle{empty}\n\\setlength{\\parindent}{0in}\n\\begin{document}\n") +
+            ",\"latexPost\":" + quoteJson("\\end{document}") + ",\"latexsvg\":false,\"tags\":[],\"vers\":[],"
+            "\"req\":[[0,\"any\",[0,1]],[1,\"all\",[3]]]}}";
+
+        std::string decks = "{" + deckJson(DEFAULT_DECK_ID, "Default", modified);
+        for( int lessonId : m_deckOrder )
+        {
+            const Deck& deck = m_decks.at(lessonId);
+            decks += "," + deckJson(deck.id, deck.name, modified);
+        }
+        decks += "}";
+
+        const std::string deckOptions = "{\"1\":{\"id\":1,\"name\":\"Default\",\"mod\":0,\"usn\":0,\"maxTaken\":60,\"autoplay\":true,"
+            "\"timer\":0,\"replayq\":true,\"dyn\":false,"
+            "\"new\":{\"delays\":[1,10],\"ints\":[1,4,7],\"initialFactor\":2500,\"order\":1,\"perDay\":20,\"bury\":true,\"separate\":true},"
+            "\"lapse\":{\"delays\":[10],\"mult\":0,\"minInt\":1,\"leechFails\":8,\"leechAction\":0},"
+            "\"rev\":{\"perDay\":100,\"ease4\":1.3,\"fuzz\":0.05,\"minSpace\":1,\"ivlFct\":1,\"maxIvl\":36500,\"bury\":true}}}";
+
+        const std::string configuration = "{\"activeDecks\":[" + std::to_string(firstDeck) + "],\"curDeck\":" + std::to_string(firstDeck) +
+            ",\"newSpread\":0,\"collapseTime\":1200,\"timeLim\":0,\"estTimes\":true,\"dueCounts\":true,\"curModel\":" +
+            quoteJson(std::to_string(NOTE_TYPE_ID)) + ",\"nextPos\":" + std::to_string(m_noteCount + 1) +
+            ",\"sortType\":\"noteFld\",\"sortBackwards\":false,\"addToCur\":true}";
+
+        const char* sql = "INSERT INTO col VALUES (1, ?, ?, ?, 11, 0, 0, 0, ?, ?, ?, ?, '{}');";
+        sqlite3_stmt* stmt;
+        if( sqlite3_prepare_v2(m_db, sql, -1, &stmt, 0) != SQLITE_OK )
+        {
+            return false;
+        }
+
+        sqlite3_bind_int64(stmt, 1, modified - modified % 86400);
+        sqlite3_bind_int64(stmt, 2, m_timestamp);
+        sqlite3_bind_int64(stmt, 3, m_timestamp);
+        sqlite3_bind_text(stmt, 4, configuration.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 5, model.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 6, decks.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 7, deckOptions.c_str(), -1, SQLITE_STATIC);
+        const bool written = sqlite3_step(stmt) == SQLITE_DONE;
+        sqlite3_finalize(stmt);
+        return written;
+    }
+
+    void AnkiExporter::closeCollection()
+    {
+        sqlite3_finalize(m_insertNote);
+        sqlite3_finalize(m_insertCard);
+        sqlite3_close(m_db);
+        m_insertNote = nullptr;
+        m_insertCard = nullptr;
+        m_db = nullptr;
+    }
+}
@@ -0,0 +1,117 @@
+/**
+ * @file AnkiExporter.h
+ * @brief Declares the AnkiExporter class which writes lessons as an Anki package.
+ */
+
+#pragma once
+
+#include "Lesson.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct sqlite3;
+struct sqlite3_stmt;
+
+namespace tadaima
+{
+    /**
+     * @brief The AnkiExporter class writes an Anki package (.apkg) word by word.
+     *
+     * Words are inserted into a temporary collection.anki2 database as they arrive, so a library can be streamed from
+     * a database cursor without holding it in memory. Every word becomes a note of the "Tadaima Word" note type with
+     * a recognition and a recall card, and every lesson becomes a "Main::Sub" deck. Note GUIDs are derived from the
+     * word IDs, so importing a newer export updates the notes instead of duplicating them. finish() packs the
+     * collection into the zip archive Anki expects.
+     */
+    class AnkiExporter
+    {
+    public:
+        static constexpr const char* FILE_EXTENSION = ".apkg"; /**< Extension of Anki packages. */
+        static constexpr const char* NOTE_TYPE_NAME = "Tadaima Word"; /**< Name of the exported note type. */
+        static constexpr int64_t NOTE_TYPE_ID = 1724688600000; /**< Fixed ID of the note type so repeated exports share it. */
+
+        AnkiExporter() = default;
+
+        /**
+         * @brief Destroys the exporter and discards an unfinished package.
+         */
+        ~AnkiExporter();
+
+        AnkiExporter(const AnkiExporter&) = delete;
+        AnkiExporter& operator=(const AnkiExporter&) = delete;
+
+        /**
+         * @brief Starts a new package.
+         * @param path Path of the package to write.
+         * @return True if the temporary collection was created, false otherwise.
+         */
+        bool begin(const std::string& path);
+
+        /**
+         * @brief Adds a word as a note with its cards.
+         * @param lesson The lesson of the word. Only the ID and names are used.
+         * @param word The word to add.
+         * @return True if the note was added, false otherwise.
+         */
+        bool addWord(const Lesson& lesson, const Word& word);
+
+        /**
+         * @brief Completes the collection and writes the package.
+         * @return True if the package was written, false otherwise.
+         */
+        bool finish();
+
+        /**
+         * @brief Discards the package being written.
+         */
+        void cancel();
+
+        /**
+         * @brief Gets the number of notes added to the package.
+         * @return The number of notes.
+         */
+        std::size_t noteCount() const;
+
+    private:
+        /**
+         * @brief An exported lesson.
+         */
+        struct Deck
+        {
+            int64_t id;         /**< Anki deck ID. */
+            std::string name;   /**< Anki deck name. */
+        };
+
+        /**
+         * @brief Gets the Anki deck of a lesson, creating it on first use.
+         * @param lesson The lesson.
+         * @return The Anki deck ID.
+         */
+        int64_t deckId(const Lesson& lesson);
+
+        /**
+         * @brief Writes the collection row holding the configuration, note type and decks.
+         * @return True if the row was written, false otherwise.
+         */
+        bool writeCollection();
+
+        /**
+         * @brief Closes the temporary collection.
+         */
+        void closeCollection();
+
+        std::string m_path; /**< Path of the package. */
+        std::string m_collectionPath; /**< Path of the temporary collection. */
+        sqlite3* m_db = nullptr; /**< The temporary collection. */
+        sqlite3_stmt* m_insertNote = nullptr; /**< Prepared note insertion. */
+        sqlite3_stmt* m_insertCard = nullptr; /**< Prepared card insertion. */
+        std::unordered_map<int, Deck> m_decks; /**< Anki decks by lesson ID. */
+        std::vector<int> m_deckOrder; /**< Lesson IDs in the order their decks were created. */
+        int64_t m_timestamp = 0; /**< Creation time of the package in milliseconds. */
+        int64_t m_nextId = 0; /**< Next note and card ID. */
+        std::size_t m_noteCount = 0; /**< Number of notes added. */
+    };
+}
@@ -0,0 +1,110 @@
+#include "ClozeLocator.h"
+#include <algorithm>
+#include <cctype>
+
+namespace tadaima
+{
+    namespace
+    {
+        bool isContinuationByte(char byte)
+        {
+            return (static_cast<unsigned char>(byte) & 0xC0) == 0x80;
+        }
+
+        std::size_t countCodePoints(std::string_view text)
+        {
+            return static_cast<std::size_t>(std::count_if(text.begin(), text.end(), [](char byte) { return !isContinuationByte(byte); }));
+        }
+
+        // The form without its last code point, or an empty view if too little would remain
+        std::string_view stem(std::string_view form)
+        {
+            std::size_t end = form.size();
+            while( end > 0 && isContinuationByte(form[end - 1]) )
+            {
+                --end;
+            }
+            if( end == 0 )
+            {
+                return {};
+            }
+            std::string_view shortened = form.substr(0, end - 1);
+            return countCodePoints(shortened) >= ClozeLocator::MIN_STEM_LENGTH ? shortened : std::string_view();
+        }
+
+        std::string lowercase(std::string_view text)
+        {
+            std::string lowered(text);
+            std::transform(lowered.begin(), lowered.end(), lowered.begin(), [](unsigned char character) { return static_cast<char>(std::tolower(character)); });
+            return lowered;
+        }
+
+        bool findForm(std::string_view sentence, std::string_view form, Word& word)
+        {
+            const std::size_t position = form.empty() ? std::string_view::npos : sentence.find(form);
+            if( position == std::string_view::npos )
+            {
+                return false;
+            }
+            word.clozeStart = static_cast<int>(position);
+            word.clozeLength = static_cast<int>(form.size());
+            return true;
+        }
+    }
+
+    void ClozeLocator::locate(Word& word)
+    {
+        word.clozeStart = -1;
+        word.clozeLength = 0;
+
+        const std::string& sentence = word.exampleSentence;
+        if( sentence.empty() )
+        {
+            return;
+        }
+
+        // Lowercasing ASCII keeps the byte offsets, so a romaji match points into the original sentence
+        if( findForm(sentence, word.kanji, word) || findForm(sentence, word.kana, word) || findForm(lowercase(sentence), lowercase(word.romaji), word) )
+        {
+            return;
+        }
+        findForm(sentence, stem(word.kanji), word) || findForm(sentence, stem(word.kana), word);
+    }
+
+    void ClozeLocator::annotate(std::vector<Lesson>& lessons)
+    {
+        for( auto& lesson : lessons )
+        {
+            for( auto& word : lesson.words )
+            {
+                locate(word);
+            }
+        }
+    }
+
+    bool ClozeLocator::hasCloze(const Word& word)
+    {
+        return word.clozeStart >= 0 && word.clozeLength > 0
+            && static_cast<std::size_t>(word.clozeStart) + static_cast<std::size_t>(word.clozeLength) <= word.exampleSentence.size();
+    }
+
+    std::string_view ClozeLocator::answer(const Word& word)
+    {
+        return hasCloze(word) ? std::string_view(word.exampleSentence).substr(word.clozeStart, word.clozeLength) : std::string_view();
+    }
+
+    std::string ClozeLocator::blank(const Word& word)
+    {
+        if( !hasCloze(word) )
+        {
+            return {};
+        }
+
+        std::string sentence;
+        sentence.reserve(word.exampleSentence.size() - word.clozeLength + std::char_traits<char>::length(BLANK));
+        sentence.append(word.exampleSentence, 0, word.clozeStart);
+        sentence.append(BLANK);
+        sentence.append(word.exampleSentence, word.clozeStart + word.clozeLength);
+        return sentence;
+    }
+}
@@ -0,0 +1,64 @@
+/**
+ * @file ClozeLocator.h
+ * @brief Declares the ClozeLocator class which finds words inside their example sentences.
+ */
+
+#pragma once
+
+#include "Lesson.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tadaima
+{
+    /**
+     * @brief The ClozeLocator class finds where a word appears in its example sentence, so it can be blanked.
+     *
+     * The kanji spelling is looked for first, then the kana and then the romaji, which is matched regardless of
+     * case. Sentences usually inflect verbs and adjectives, so a form that is not found is looked for again
+     * without its last character, e.g. 食べ of 食べる in 食べます, as long as two characters remain.
+     *
+     * Searching is done once when a word is stored and the span is kept in Word::clozeStart and Word::clozeLength,
+     * so cloze quizzes only cut the sentence at the stored offsets.
+     */
+    class ClozeLocator
+    {
+    public:
+        static constexpr const char* BLANK = "____"; /**< Text replacing the word in the sentence. */
+        static constexpr std::size_t MIN_STEM_LENGTH = 2; /**< Minimal number of characters of a shortened form. */
+
+        /**
+         * @brief Locates a word in its example sentence and stores the span in the word.
+         * @param word The word, clozeStart and clozeLength are updated.
+         */
+        static void locate(Word& word);
+
+        /**
+         * @brief Locates every word of the lessons, e.g. before they are imported.
+         * @param lessons The lessons.
+         */
+        static void annotate(std::vector<Lesson>& lessons);
+
+        /**
+         * @brief Checks if a word was located in its example sentence.
+         * @param word The word.
+         * @return True if the stored span lies within the sentence.
+         */
+        static bool hasCloze(const Word& word);
+
+        /**
+         * @brief Gets the part of the example sentence covered by the word.
+         * @param word A located word.
+         * @return The blanked text, or an empty view if the word has no cloze.
+         */
+        static std::string_view answer(const Word& word);
+
+        /**
+         * @brief Gets the example sentence with the word replaced by BLANK.
+         * @param word A located word.
+         * @return The sentence with the blank, or an empty string if the word has no cloze.
+         */
+        static std::string blank(const Word& word);
+    };
+}
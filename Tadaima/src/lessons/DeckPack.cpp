@@ -0,0 +1,475 @@
+#include "DeckPack.h"
+#include "tools/JapaneseText.h"
+#include "tools/BinaryBuffer.h"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace tadaima
+{
+    namespace
+    {
+        constexpr char FILE_MAGIC[4] = { 'T', 'D', 'C', 'K' };
+        constexpr uint64_t CHUNK_BOUNDARY_MASK = 63;   // Cuts after about every 64th word
+        constexpr uint32_t MAX_CHUNK_WORDS = 256;
+
+        /**
+         * @brief Header of a deck pack. Fields are little-endian, as on all supported targets.
+         */
+        struct PackHeader
+        {
+            char magic[4];
+            uint32_t version;
+            uint32_t chunkCount;
+            uint32_t lessonCount;
+            uint8_t deckVersion[20];
+            uint8_t baseVersion[20];
+            uint32_t namesSize;
+            uint32_t reserved;
+        };
+
+        static_assert(sizeof(PackHeader) == 64, "Header must keep the chunk table 8-byte aligned");
+
+        uint64_t alignUp(uint64_t value)
+        {
+            return (value + 7) & ~uint64_t(7);
+        }
+
+        using binary::appendNumber;
+        using binary::appendString;
+        using binary::Reader;
+
+        void appendWord(std::string& buffer, const Word& word)
+        {
+            appendString(buffer, word.kana);
+            appendString(buffer, word.kanji);
+            appendString(buffer, word.translation);
+            appendString(buffer, word.romaji);
+            appendString(buffer, word.exampleSentence);
+            appendNumber(buffer, static_cast<uint32_t>(word.tags.size()));
+            for( const auto& tag : word.tags )
+            {
+                appendString(buffer, tag);
+            }
+        }
+
+        std::string digestKey(const DeckPack::Digest& digest)
+        {
+            return std::string(reinterpret_cast<const char*>(digest.data()), digest.size());
+        }
+    }
+
+    bool DeckPack::write(const std::string& path, const std::string& name, const std::vector<Lesson>& lessons, const DeckPack* base)
+    {
+        std::string names;
+        appendString(names, name);
+        for( const auto& lesson : lessons )
+        {
+            appendString(names, lesson.mainName);
+            appendString(names, lesson.subName);
+        }
+
+        std::vector<ChunkEntry> entries;
+        std::vector<std::string> payloads;
+        for( std::size_t lessonIndex = 0; lessonIndex < lessons.size(); ++lessonIndex )
+        {
+            const std::size_t firstChunk = entries.size();
+            std::string words;
+            uint32_t wordCount = 0;
+
+            auto flush = [&]()
+                {
+                    std::string payload;
+                    appendNumber(payload, wordCount);
+                    payload += words;
+
+                    ChunkEntry entry{};
+                    entry.digest = Sha1::digest(payload.data(), payload.size());
+                    entry.lesson = static_cast<uint32_t>(lessonIndex);
+                    entry.size = static_cast<uint32_t>(payload.size());
+                    entries.push_back(entry);
+                    payloads.push_back(std::move(payload));
+
+                    words.clear();
+                    wordCount = 0;
+                };
+
+            // Boundaries depend only on the words themselves, so an edit does not shift the following chunks
+            for( const auto& word : lessons[lessonIndex].words )
+            {
+                appendWord(words, word);
+                ++wordCount;
+                if( wordCount == MAX_CHUNK_WORDS || (hashText(word.kana + '\t' + word.translation) & CHUNK_BOUNDARY_MASK) == 0 )
+                {
+                    flush();
+                }
+            }
+            if( wordCount > 0 || entries.size() == firstChunk )
+            {
+                flush();
+            }
+        }
+
+        // Chunks the base version carries itself are only referenced
+        std::vector<std::string_view> views;
+        for( std::size_t i = 0; i < entries.size(); ++i )
+        {
+            bool inBase = false;
+            if( base )
+            {
+                auto it = base->m_chunkIndex.find(digestKey(entries[i].digest));
+                inBase = it != base->m_chunkIndex.end() && base->m_chunks[it->second].offset != 0;
+            }
+            views.push_back(inBase ? std::string_view() : std::string_view(payloads[i]));
+        }
+
+        return writePack(path, names, std::move(entries), views, base ? base->version() : Digest{});
+    }
+
+    bool DeckPack::writePack(const std::string& path, std::string_view names, std::vector<ChunkEntry> entries,
+        const std::vector<std::string_view>& payloads, const Digest& baseVersion)
+    {
+        const uint64_t tableOffset = alignUp(sizeof(PackHeader) + names.size());
+        uint64_t payloadOffset = tableOffset + entries.size() * sizeof(ChunkEntry);
+
+        std::unordered_map<std::string, uint64_t> stored;
+        std::vector<std::string_view> written;
+        for( std::size_t i = 0; i < entries.size(); ++i )
+        {
+            entries[i].reserved = 0;
+            entries[i].offset = 0;
+            if( payloads[i].empty() )
+            {
+                continue;
+            }
+
+            auto [it, inserted] = stored.emplace(digestKey(entries[i].digest), payloadOffset);
+            if( inserted )
+            {
+                written.push_back(payloads[i]);
+                payloadOffset += payloads[i].size();
+            }
+            entries[i].offset = it->second;
+        }
+
+        PackHeader header{};
+        std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+        header.version = FILE_VERSION;
+        header.chunkCount = static_cast<uint32_t>(entries.size());
+        Reader reader(names);
+        reader.string();
+        while( !reader.atEnd() )
+        {
+            reader.string();
+            reader.string();
+            ++header.lessonCount;
+        }
+        const Digest version = computeVersion(names, entries);
+        std::memcpy(header.deckVersion, version.data(), version.size());
+        std::memcpy(header.baseVersion, baseVersion.data(), baseVersion.size());
+        header.namesSize = static_cast<uint32_t>(names.size());
+
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        if( !output )
+        {
+            return false;
+        }
+
+        const char padding[8] = {};
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        output.write(names.data(), names.size());
+        output.write(padding, tableOffset - sizeof(header) - names.size());
+        output.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(ChunkEntry));
+        for( const auto& payload : written )
+        {
+            output.write(payload.data(), payload.size());
+        }
+
+        return static_cast<bool>(output);
+    }
+
+    DeckPack::Digest DeckPack::computeVersion(std::string_view names, const std::vector<ChunkEntry>& entries)
+    {
+        Sha1 sha;
+        sha.update(names);
+        for( const auto& entry : entries )
+        {
+            sha.update(entry.digest.data(), entry.digest.size());
+            sha.update(&entry.lesson, sizeof(entry.lesson));
+        }
+        return sha.finalize();
+    }
+
+    bool DeckPack::open(const std::string& path)
+    {
+        close();
+        if( !m_file.open(path) || m_file.size() < sizeof(PackHeader) )
+        {
+            close();
+            return false;
+        }
+
+        try
+        {
+            PackHeader header;
+            std::memcpy(&header, m_file.data(), sizeof(header));
+            if( std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || header.version != FILE_VERSION )
+            {
+                throw std::runtime_error("Deck pack: unknown format.");
+            }
+
+            const uint64_t tableOffset = alignUp(sizeof(PackHeader) + uint64_t(header.namesSize));
+            const uint64_t payloadOffset = tableOffset + uint64_t(header.chunkCount) * sizeof(ChunkEntry);
+            if( payloadOffset > m_file.size() )
+            {
+                throw std::runtime_error("Deck pack: truncated file.");
+            }
+
+            // Every lesson stores at least the lengths of its two names, so a corrupt count fails before the lessons are allocated
+            if( uint64_t(header.lessonCount) * 2 * sizeof(uint32_t) > header.namesSize )
+            {
+                throw std::runtime_error("Deck pack: truncated lesson names.");
+            }
+
+            const std::string_view names(reinterpret_cast<const char*>(m_file.data()) + sizeof(PackHeader), header.namesSize);
+            Reader reader(names);
+            m_name = reader.string();
+            m_lessons.resize(header.lessonCount);
+            for( auto& lesson : m_lessons )
+            {
+                lesson.mainName = reader.string();
+                lesson.subName = reader.string();
+            }
+            m_lessonChunks.resize(header.lessonCount);
+
+            m_chunks.resize(header.chunkCount);
+            std::memcpy(m_chunks.data(), m_file.data() + tableOffset, m_chunks.size() * sizeof(ChunkEntry));
+            for( std::size_t i = 0; i < m_chunks.size(); ++i )
+            {
+                const ChunkEntry& entry = m_chunks[i];
+                // Compared as the space left after the offset, the sum of a corrupt offset and size could wrap around
+                const bool validPayload = entry.offset == 0 || (entry.offset >= payloadOffset && entry.offset <= m_file.size() && entry.size <= m_file.size() - entry.offset);
+                if( entry.lesson >= m_lessons.size() || !validPayload )
+                {
+                    throw std::runtime_error("Deck pack: invalid chunk table.");
+                }
+                m_chunkIndex.emplace(digestKey(entry.digest), i);
+                m_lessonChunks[entry.lesson].push_back(i);
+            }
+
+            std::memcpy(m_version.data(), header.deckVersion, m_version.size());
+            std::memcpy(m_baseVersion.data(), header.baseVersion, m_baseVersion.size());
+            if( computeVersion(names, m_chunks) != m_version )
+            {
+                throw std::runtime_error("Deck pack: manifest checksum mismatch.");
+            }
+        }
+        catch( const std::runtime_error& )
+        {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void DeckPack::close()
+    {
+        m_file.close();
+        m_name.clear();
+        m_version = Digest{};
+        m_baseVersion = Digest{};
+        m_chunks.clear();
+        m_lessons.clear();
+        m_lessonChunks.clear();
+        m_chunkIndex.clear();
+    }
+
+    bool DeckPack::isOpen() const
+    {
+        return m_file.isOpen();
+    }
+
+    const std::string& DeckPack::name() const
+    {
+        return m_name;
+    }
+
+    const DeckPack::Digest& DeckPack::version() const
+    {
+        return m_version;
+    }
+
+    const DeckPack::Digest& DeckPack::baseVersion() const
+    {
+        return m_baseVersion;
+    }
+
+    bool DeckPack::isDelta() const
+    {
+        return m_baseVersion != Digest{};
+    }
+
+    std::size_t DeckPack::chunkCount() const
+    {
+        return m_chunks.size();
+    }
+
+    bool DeckPack::containsChunk(const Digest& digest) const
+    {
+        return m_chunkIndex.count(digestKey(digest)) > 0;
+    }
+
+    std::vector<Lesson> DeckPack::lessons(const DeckPack* base) const
+    {
+        checkBase(base);
+
+        std::vector<Lesson> result;
+        for( std::size_t i = 0; i < m_lessons.size(); ++i )
+        {
+            result.push_back(decodeLesson(i, base));
+        }
+        return result;
+    }
+
+    DeckUpdate DeckPack::update(const DeckPack* base) const
+    {
+        checkBase(base);
+
+        DeckUpdate update;
+        std::unordered_map<std::string, std::vector<std::size_t>> baseLessons;
+        std::vector<bool> matched;
+        if( base )
+        {
+            matched.resize(base->m_lessons.size(), false);
+            for( std::size_t i = base->m_lessons.size(); i-- > 0; )
+            {
+                baseLessons[base->m_lessons[i].mainName + '\n' + base->m_lessons[i].subName].push_back(i);
+            }
+        }
+
+        for( std::size_t i = 0; i < m_lessons.size(); ++i )
+        {
+            auto it = baseLessons.find(m_lessons[i].mainName + '\n' + m_lessons[i].subName);
+            if( it != baseLessons.end() && !it->second.empty() )
+            {
+                const std::size_t baseLesson = it->second.back();
+                it->second.pop_back();
+                matched[baseLesson] = true;
+                if( sameChunks(i, *base, baseLesson) )
+                {
+                    continue;
+                }
+            }
+            update.changedLessons.push_back(decodeLesson(i, base));
+        }
+
+        for( std::size_t i = 0; i < matched.size(); ++i )
+        {
+            if( !matched[i] )
+            {
+                update.removedLessons.push_back(base->m_lessons[i]);
+            }
+        }
+
+        for( const auto& entry : m_chunks )
+        {
+            if( !base || !base->containsChunk(entry.digest) )
+            {
+                ++update.changedChunks;
+            }
+        }
+
+        return update;
+    }
+
+    bool DeckPack::materialize(const std::string& path, const DeckPack* base) const
+    {
+        checkBase(base);
+
+        std::vector<std::string_view> payloads;
+        for( std::size_t i = 0; i < m_chunks.size(); ++i )
+        {
+            payloads.push_back(payload(i, base));
+        }
+
+        PackHeader header;
+        std::memcpy(&header, m_file.data(), sizeof(header));
+        const std::string_view names(reinterpret_cast<const char*>(m_file.data()) + sizeof(PackHeader), header.namesSize);
+        return writePack(path, names, m_chunks, payloads, Digest{});
+    }
+
+    bool DeckPack::sameChunks(std::size_t lesson, const DeckPack& base, std::size_t baseLesson) const
+    {
+        const auto& chunks = m_lessonChunks[lesson];
+        const auto& baseChunks = base.m_lessonChunks[baseLesson];
+        if( chunks.size() != baseChunks.size() )
+        {
+            return false;
+        }
+        for( std::size_t i = 0; i < chunks.size(); ++i )
+        {
+            if( m_chunks[chunks[i]].digest != base.m_chunks[baseChunks[i]].digest )
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Lesson DeckPack::decodeLesson(std::size_t index, const DeckPack* base) const
+    {
+        Lesson lesson = m_lessons[index];
+        for( std::size_t chunk : m_lessonChunks[index] )
+        {
+            Reader reader(payload(chunk, base));
+            const uint32_t wordCount = reader.number();
+            for( uint32_t i = 0; i < wordCount; ++i )
+            {
+                Word word;
+                word.id = 0;
+                word.kana = reader.string();
+                word.kanji = reader.string();
+                word.translation = reader.string();
+                word.romaji = reader.string();
+                word.exampleSentence = reader.string();
+                const uint32_t tagCount = reader.number();
+                for( uint32_t j = 0; j < tagCount; ++j )
+                {
+                    word.tags.push_back(reader.string());
+                }
+                lesson.words.push_back(word);
+            }
+        }
+        return lesson;
+    }
+
+    std::string_view DeckPack::payload(std::size_t index, const DeckPack* base) const
+    {
+        const ChunkEntry& entry = m_chunks[index];
+        if( entry.offset == 0 )
+        {
+            auto it = base ? base->m_chunkIndex.find(digestKey(entry.digest)) : m_chunkIndex.end();
+            if( !base || it == base->m_chunkIndex.end() || base->m_chunks[it->second].offset == 0 )
+            {
+                throw std::runtime_error("Deck pack: chunk " + Sha1::toHex(entry.digest) + " is missing.");
+            }
+            return base->payload(it->second, nullptr);
+        }
+
+        const std::string_view data(reinterpret_cast<const char*>(m_file.data()) + entry.offset, entry.size);
+        if( Sha1::digest(data.data(), data.size()) != entry.digest )
+        {
+            throw std::runtime_error("Deck pack: chunk " + Sha1::toHex(entry.digest) + " is corrupted.");
+        }
+        return data;
+    }
+
+    void DeckPack::checkBase(const DeckPack* base) const
+    {
+        if( isDelta() && (!base || base->version() != m_baseVersion) )
+        {
+            throw std::runtime_error("Deck pack: update of " + m_name + " needs the version it was made against.");
+        }
+    }
+}
@@ -0,0 +1,226 @@
+/**
+ * @file DeckPack.h
+ * @brief Declares the DeckPack class which reads and writes shareable, content-addressed deck packs.
+ */
+
+#pragma once
+
+#include "Lesson.h"
+#include "tools/MappedFile.h"
+#include "tools/Sha1.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tadaima
+{
+    /**
+     * @brief Lessons of a deck which differ between two versions of the deck.
+     */
+    struct DeckUpdate
+    {
+        std::vector<Lesson> changedLessons; /**< Lessons which are new or have different words. Word IDs are not set. */
+        std::vector<Lesson> removedLessons; /**< Lessons missing in the new version. Only the names are set. */
+        std::size_t changedChunks = 0; /**< Number of chunks which were not part of the base version. */
+    };
+
+    /**
+     * @brief Request to export lessons as a deck pack.
+     */
+    struct DeckExportRequest
+    {
+        std::string path; /**< Path of the pack to write. */
+        std::string name; /**< Name of the deck. */
+        std::vector<int> lessonIds; /**< IDs of the exported lessons. */
+    };
+
+    /**
+     * @brief The DeckPack class reads and writes deck packs.
+     *
+     * A deck pack stores the lessons of a deck as a sequence of chunks. Each chunk holds a run of words of a single
+     * lesson and is addressed by the SHA-1 digest of its content. Chunk boundaries are chosen by the content of the
+     * words, so editing, inserting or removing a word only changes the chunk it lives in. The digest of all chunk
+     * digests identifies a version of the deck.
+     *
+     * A delta pack lists every chunk of the new version but only carries the payload of chunks missing in the base
+     * version it was made against. Reading a delta pack needs that base pack. Packs are memory mapped and a chunk is
+     * verified against its digest when it is decoded, so only the chunks that are actually used are read.
+     */
+    class DeckPack
+    {
+    public:
+        using Digest = Sha1::Digest; /**< Digest addressing a chunk or a deck version. */
+
+        static constexpr uint32_t FILE_VERSION = 2; /**< Version of the binary file format. */
+        static constexpr const char* FILE_EXTENSION = ".tdeck"; /**< Extension of deck pack files. */
+
+        /**
+         * @brief Writes a deck pack.
+         * @param path Path of the pack to write.
+         * @param name Name of the deck.
+         * @param lessons Lessons of the deck.
+         * @param base Previous version of the deck. If given, a delta pack is written which omits the chunks of the base.
+         * @return True if the pack was written, false otherwise.
+         */
+        static bool write(const std::string& path, const std::string& name, const std::vector<Lesson>& lessons, const DeckPack* base = nullptr);
+
+        /**
+         * @brief Maps a deck pack into memory and verifies its structure and manifest digest.
+         * @param path Path of the pack.
+         * @return True if the pack is valid and was opened, false otherwise.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Releases the pack.
+         */
+        void close();
+
+        /**
+         * @brief Checks if a pack is open.
+         * @return True if a pack is open, false otherwise.
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Gets the name of the deck.
+         * @return The name of the deck.
+         */
+        const std::string& name() const;
+
+        /**
+         * @brief Gets the digest identifying this version of the deck.
+         * @return The digest of all chunk digests.
+         */
+        const Digest& version() const;
+
+        /**
+         * @brief Gets the version of the deck this delta pack was made against.
+         * @return The base version, all zeros for a full pack.
+         */
+        const Digest& baseVersion() const;
+
+        /**
+         * @brief Checks if the pack is a delta pack.
+         * @return True if some chunks must be taken from the base version.
+         */
+        bool isDelta() const;
+
+        /**
+         * @brief Gets the number of chunks of this version of the deck.
+         * @return The number of chunks.
+         */
+        std::size_t chunkCount() const;
+
+        /**
+         * @brief Checks if the pack contains the given chunk, either with its payload or as a reference.
+         * @param digest The digest of the chunk.
+         * @return True if the chunk is part of this version of the deck.
+         */
+        bool containsChunk(const Digest& digest) const;
+
+        /**
+         * @brief Decodes all lessons of the deck.
+         * @param base The base version, required for delta packs.
+         * @return The lessons of the deck. Word and lesson IDs are not set.
+         * @throws std::runtime_error If a chunk is missing or corrupted.
+         */
+        std::vector<Lesson> lessons(const DeckPack* base = nullptr) const;
+
+        /**
+         * @brief Decodes only the lessons which differ from the base version.
+         * @param base The previously installed version, or nullptr if the deck is new.
+         * @return The changed and removed lessons.
+         * @throws std::runtime_error If a chunk is missing or corrupted, or the base does not match a delta pack.
+         */
+        DeckUpdate update(const DeckPack* base) const;
+
+        /**
+         * @brief Writes this version of the deck as a full pack, taking missing chunks from the base version.
+         * @param path Path of the pack to write.
+         * @param base The base version, required for delta packs.
+         * @return True if the pack was written, false otherwise.
+         * @throws std::runtime_error If a chunk is missing.
+         */
+        bool materialize(const std::string& path, const DeckPack* base = nullptr) const;
+
+    private:
+        /**
+         * @brief Entry of the chunk table.
+         */
+        struct ChunkEntry
+        {
+            Digest digest;          /**< Digest of the chunk payload. */
+            uint32_t lesson;        /**< Index of the lesson the words of the chunk belong to. */
+            uint32_t size;          /**< Size of the payload in bytes. */
+            uint32_t reserved;      /**< Padding, always 0. */
+            uint64_t offset;        /**< Offset of the payload in the file, 0 if the payload is in the base version. */
+        };
+
+        static_assert(sizeof(ChunkEntry) == 40, "Chunk entries are stored as they are laid out in memory");
+
+        /**
+         * @brief Writes a pack file, storing every distinct payload once.
+         * @param path Path of the pack to write.
+         * @param names Encoded deck and lesson names.
+         * @param entries The chunk table. Offsets are assigned while writing.
+         * @param payloads Payload of every entry, empty for chunks kept in the base version.
+         * @param baseVersion Version the pack is made against, all zeros for a full pack.
+         * @return True if the pack was written, false otherwise.
+         */
+        static bool writePack(const std::string& path, std::string_view names, std::vector<ChunkEntry> entries,
+            const std::vector<std::string_view>& payloads, const Digest& baseVersion);
+
+        /**
+         * @brief Computes the digest identifying a version of a deck.
+         * @param names Encoded deck and lesson names.
+         * @param entries The chunk table.
+         * @return The digest of the names and all chunk digests.
+         */
+        static Digest computeVersion(std::string_view names, const std::vector<ChunkEntry>& entries);
+
+        /**
+         * @brief Checks if the chunks of a lesson are the same in both versions.
+         * @param lesson Index of the lesson in this pack.
+         * @param base The base version.
+         * @param baseLesson Index of the lesson in the base version.
+         * @return True if both versions consist of the same chunks.
+         */
+        bool sameChunks(std::size_t lesson, const DeckPack& base, std::size_t baseLesson) const;
+
+        /**
+         * @brief Decodes the words of a lesson.
+         * @param index Index of the lesson.
+         * @param base The base version.
+         * @return The lesson with its names and words.
+         */
+        Lesson decodeLesson(std::size_t index, const DeckPack* base) const;
+
+        /**
+         * @brief Gets the payload of a chunk from this pack or the base version.
+         * @param index Index of the chunk in the chunk table.
+         * @param base The base version.
+         * @return The verified payload.
+         * @throws std::runtime_error If the chunk is missing or corrupted.
+         */
+        std::string_view payload(std::size_t index, const DeckPack* base) const;
+
+        /**
+         * @brief Checks that a delta pack is read together with its base version.
+         * @param base The base version.
+         * @throws std::runtime_error If the base does not match.
+         */
+        void checkBase(const DeckPack* base) const;
+
+        MappedFile m_file; /**< The mapped pack. */
+        std::string m_name; /**< Name of the deck. */
+        Digest m_version{}; /**< Digest of all chunk digests. */
+        Digest m_baseVersion{}; /**< Version a delta pack was made against. */
+        std::vector<ChunkEntry> m_chunks; /**< The chunk table. */
+        std::vector<Lesson> m_lessons; /**< Names of the lessons, without words. */
+        std::vector<std::vector<std::size_t>> m_lessonChunks; /**< Chunk table indices of every lesson in order. */
+        std::unordered_map<std::string, std::size_t> m_chunkIndex; /**< Chunk table index by digest bytes. */
+    };
+}
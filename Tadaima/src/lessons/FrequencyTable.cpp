@@ -0,0 +1,240 @@
+#include "FrequencyTable.h"
+#include "tools/JapaneseText.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <unordered_set>
+
+namespace tadaima
+{
+    namespace
+    {
+        constexpr char FILE_MAGIC[4] = { 'T', 'F', 'R', 'Q' };
+
+        /**
+         * @brief Header of the binary frequency table.
+         */
+        struct FileHeader
+        {
+            char magic[4];
+            uint32_t version;
+            uint64_t count;
+        };
+
+        static_assert(sizeof(FileHeader) == 16, "Hashes must stay 8-byte aligned");
+
+        /**
+         * @brief A word read from a frequency list.
+         */
+        struct ListEntry
+        {
+            std::string text;
+            double count = 0.0;
+            bool hasCount = false;
+        };
+
+        bool parseNumber(std::string_view field, double& value)
+        {
+            const auto result = std::from_chars(field.data(), field.data() + field.size(), value);
+            return result.ec == std::errc() && result.ptr == field.data() + field.size();
+        }
+
+        bool parseLine(std::string_view line, ListEntry& entry)
+        {
+            if( !line.empty() && line.back() == '\r' )
+            {
+                line.remove_suffix(1);
+            }
+            if( line.empty() || line.front() == '#' )
+            {
+                return false;
+            }
+
+            const char* separators = line.find('\t') != std::string_view::npos ? "\t" : " ";
+            std::size_t begin = 0;
+            while( begin <= line.size() )
+            {
+                const std::size_t end = std::min(line.find_first_of(separators, begin), line.size());
+                const std::string_view field = line.substr(begin, end - begin);
+                begin = end + 1;
+
+                double number = 0.0;
+                if( field.empty() )
+                {
+                    continue;
+                }
+                if( parseNumber(field, number) )
+                {
+                    if( !entry.hasCount && !entry.text.empty() )
+                    {
+                        entry.count = number;
+                        entry.hasCount = true;
+                    }
+                }
+                else if( entry.text.empty() )
+                {
+                    entry.text = normalizeJapanese(field);
+                }
+            }
+
+            return !entry.text.empty();
+        }
+    }
+
+    std::size_t FrequencyTable::build(std::istream& input, const std::string& outputPath)
+    {
+        std::vector<ListEntry> entries;
+        bool allCounted = true;
+
+        std::string line;
+        while( std::getline(input, line) )
+        {
+            if( entries.empty() && line.rfind("\xEF\xBB\xBF", 0) == 0 )
+            {
+                line.erase(0, 3);
+            }
+
+            ListEntry entry;
+            if( parseLine(line, entry) )
+            {
+                allCounted = allCounted && entry.hasCount;
+                entries.push_back(std::move(entry));
+            }
+        }
+
+        if( entries.empty() )
+        {
+            return 0;
+        }
+
+        if( allCounted )
+        {
+            std::stable_sort(entries.begin(), entries.end(), [](const ListEntry& lhs, const ListEntry& rhs) { return lhs.count > rhs.count; });
+        }
+
+        // Ranks follow the list order, variants folded by normalization keep the first (best) rank
+        std::vector<std::pair<uint64_t, uint32_t>> table;
+        table.reserve(entries.size());
+        std::unordered_set<uint64_t> seen;
+        for( const auto& entry : entries )
+        {
+            const uint64_t hash = hashText(entry.text);
+            if( seen.insert(hash).second )
+            {
+                table.emplace_back(hash, static_cast<uint32_t>(table.size() + 1));
+            }
+        }
+        std::sort(table.begin(), table.end());
+
+        std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+        if( !output )
+        {
+            return 0;
+        }
+
+        FileHeader header{};
+        std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+        header.version = FILE_VERSION;
+        header.count = table.size();
+        output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        for( const auto& [hash, rank] : table )
+        {
+            output.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+        }
+        for( const auto& [hash, rank] : table )
+        {
+            output.write(reinterpret_cast<const char*>(&rank), sizeof(rank));
+        }
+
+        return output ? table.size() : 0;
+    }
+
+    bool FrequencyTable::open(const std::string& path)
+    {
+        close();
+        if( !m_file.open(path) || m_file.size() < sizeof(FileHeader) )
+        {
+            m_file.close();
+            return false;
+        }
+
+        FileHeader header;
+        std::memcpy(&header, m_file.data(), sizeof(header));
+        const uint64_t expectedSize = sizeof(FileHeader) + header.count * (sizeof(uint64_t) + sizeof(uint32_t));
+        if( std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0 || header.version != FILE_VERSION || m_file.size() != expectedSize )
+        {
+            m_file.close();
+            return false;
+        }
+
+        m_count = static_cast<std::size_t>(header.count);
+        m_hashes = reinterpret_cast<const uint64_t*>(m_file.data() + sizeof(FileHeader));
+        m_ranks = reinterpret_cast<const uint32_t*>(m_file.data() + sizeof(FileHeader) + m_count * sizeof(uint64_t));
+        return true;
+    }
+
+    void FrequencyTable::close()
+    {
+        m_file.close();
+        m_hashes = nullptr;
+        m_ranks = nullptr;
+        m_count = 0;
+    }
+
+    bool FrequencyTable::isOpen() const
+    {
+        return m_file.isOpen();
+    }
+
+    std::size_t FrequencyTable::size() const
+    {
+        return m_count;
+    }
+
+    int FrequencyTable::rank(std::string_view text) const
+    {
+        if( m_count == 0 || text.empty() )
+        {
+            return UNKNOWN_RANK;
+        }
+
+        const uint64_t hash = hashText(normalizeJapanese(text));
+        const uint64_t* it = std::lower_bound(m_hashes, m_hashes + m_count, hash);
+        return it != m_hashes + m_count && *it == hash ? static_cast<int>(m_ranks[it - m_hashes]) : UNKNOWN_RANK;
+    }
+
+    int FrequencyTable::rank(const Word& word) const
+    {
+        const int kanaRank = rank(word.kana);
+        const int kanjiRank = rank(word.kanji);
+        if( kanaRank == UNKNOWN_RANK || kanjiRank == UNKNOWN_RANK )
+        {
+            return std::max(kanaRank, kanjiRank);
+        }
+        return std::min(kanaRank, kanjiRank);
+    }
+
+    bool FrequencyTable::isMoreCommon(const Word& lhs, const Word& rhs)
+    {
+        const unsigned int lhsRank = static_cast<unsigned int>(lhs.frequencyRank - 1);
+        const unsigned int rhsRank = static_cast<unsigned int>(rhs.frequencyRank - 1);
+        return lhsRank < rhsRank;
+    }
+
+    void FrequencyTable::annotate(std::vector<Lesson>& lessons) const
+    {
+        if( !isOpen() )
+        {
+            return;
+        }
+
+        for( auto& lesson : lessons )
+        {
+            for( auto& word : lesson.words )
+            {
+                word.frequencyRank = rank(word);
+            }
+        }
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * @file FrequencyTable.h
+ * @brief Declares the FrequencyTable class providing frequency ranks of Japanese words.
+ */
+
+#pragma once
+
+#include "Lesson.h"
+#include "tools/MappedFile.h"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tadaima
+{
+    /**
+     * @brief The FrequencyTable class maps words to their frequency rank in a corpus.
+     *
+     * Tables are built from tab separated frequency lists and stored in a compact binary file: a header followed
+     * by sorted 64-bit hashes of the normalized words and their ranks. The file is memory-mapped, so opening
+     * a table is instant and a lookup is a binary search without any allocation besides normalization of the key.
+     */
+    class FrequencyTable
+    {
+    public:
+        static constexpr uint32_t FILE_VERSION = 1; /**< Version of the binary file format. */
+        static constexpr int UNKNOWN_RANK = 0; /**< Rank of words missing in the table. */
+
+        /**
+         * @brief Builds a binary frequency table from a frequency list.
+         *
+         * Each line holds a word and optionally a number (count or frequency per million) separated by tabs.
+         * Lines starting with '#' are ignored. If every line has a number, words are ranked by it in descending
+         * order, otherwise by their position in the list. Spelling variants keep the best rank.
+         *
+         * @param input Stream with the frequency list.
+         * @param outputPath Path of the binary table to write.
+         * @return Number of distinct words in the table, or 0 on failure.
+         */
+        static std::size_t build(std::istream& input, const std::string& outputPath);
+
+        /**
+         * @brief Maps a binary frequency table into memory.
+         * @param path Path of the binary table.
+         * @return True if the table is valid and was opened, false otherwise.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Releases the table.
+         */
+        void close();
+
+        /**
+         * @brief Checks if a table is open.
+         * @return True if a table is open, false otherwise.
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Gets the number of words in the table.
+         * @return The number of words.
+         */
+        std::size_t size() const;
+
+        /**
+         * @brief Gets the frequency rank of a text.
+         * @param text The text to look up. It is normalized before the lookup.
+         * @return The rank starting at 1 for the most frequent word, or UNKNOWN_RANK.
+         */
+        int rank(std::string_view text) const;
+
+        /**
+         * @brief Gets the frequency rank of a word, the better of its kana and kanji spellings.
+         * @param word The word to look up.
+         * @return The rank starting at 1 for the most frequent word, or UNKNOWN_RANK.
+         */
+        int rank(const Word& word) const;
+
+        /**
+         * @brief Sets the frequency rank of every word in the lessons.
+         * @param lessons The lessons to annotate.
+         */
+        void annotate(std::vector<Lesson>& lessons) const;
+
+        /**
+         * @brief Orders words from the most to the least common, words without a rank come last.
+         * @param lhs The first word.
+         * @param rhs The second word.
+         * @return True if lhs should be asked before rhs.
+         */
+        static bool isMoreCommon(const Word& lhs, const Word& rhs);
+
+    private:
+        MappedFile m_file; /**< The mapped binary table. */
+        const uint64_t* m_hashes = nullptr; /**< Sorted hashes of the normalized words. */
+        const uint32_t* m_ranks = nullptr; /**< Ranks matching the hashes. */
+        std::size_t m_count = 0; /**< Number of words in the table. */
+    };
+}
@@ -0,0 +1,195 @@
+#include "KanjiIndex.h"
+#include "tools/JapaneseText.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace tadaima
+{
+    namespace
+    {
+        template <typename T>
+        void sortUnique(std::vector<T>& values)
+        {
+            std::sort(values.begin(), values.end());
+            values.erase(std::unique(values.begin(), values.end()), values.end());
+        }
+
+        template <typename T>
+        std::vector<T> intersect(const std::vector<T>& lhs, const std::vector<T>& rhs)
+        {
+            std::vector<T> result;
+            std::set_intersection(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::back_inserter(result));
+            return result;
+        }
+
+        bool isSeparator(char32_t codePoint)
+        {
+            return codePoint == U' ' || codePoint == U'\t' || codePoint == U'\r' || codePoint == U'\n' || codePoint == 0x3000;
+        }
+    }
+
+    std::size_t KanjiIndex::loadRadicals(std::istream& input)
+    {
+        m_radicalKanji.clear();
+
+        std::size_t kanjiCount = 0;
+        std::string line;
+        while( std::getline(input, line) )
+        {
+            if( line.empty() || line[0] == '#' )
+            {
+                continue;
+            }
+
+            const std::size_t separator = line.find(':');
+            if( separator == std::string::npos )
+            {
+                continue;
+            }
+
+            const std::u32string kanji = toCodePoints(std::string_view(line).substr(0, separator));
+            const auto kanjiIt = std::find_if_not(kanji.begin(), kanji.end(), isSeparator);
+            if( kanjiIt == kanji.end() )
+            {
+                continue;
+            }
+
+            for( char32_t radical : toCodePoints(std::string_view(line).substr(separator + 1)) )
+            {
+                if( !isSeparator(radical) )
+                {
+                    m_radicalKanji[radical].push_back(*kanjiIt);
+                }
+            }
+            ++kanjiCount;
+        }
+
+        for( auto& [radical, kanji] : m_radicalKanji )
+        {
+            sortUnique(kanji);
+        }
+        return kanjiCount;
+    }
+
+    bool KanjiIndex::loadRadicals(const std::string& path)
+    {
+        std::ifstream input(path, std::ios::binary);
+        return input && loadRadicals(input) > 0;
+    }
+
+    bool KanjiIndex::hasRadicals() const
+    {
+        return !m_radicalKanji.empty();
+    }
+
+    void KanjiIndex::build(const std::vector<Lesson>& lessons)
+    {
+        m_words.clear();
+
+        for( const auto& lesson : lessons )
+        {
+            for( const auto& word : lesson.words )
+            {
+                for( const std::string* text : { &word.kanji, &word.kana } )
+                {
+                    for( char32_t codePoint : toCodePoints(*text) )
+                    {
+                        if( isKanji(codePoint) )
+                        {
+                            m_words[codePoint].push_back(word.id);
+                        }
+                    }
+                }
+            }
+        }
+
+        for( auto& [kanji, wordIds] : m_words )
+        {
+            sortUnique(wordIds);
+        }
+    }
+
+    std::size_t KanjiIndex::kanjiCount() const
+    {
+        return m_words.size();
+    }
+
+    const std::vector<int>& KanjiIndex::wordsWithKanji(char32_t kanji) const
+    {
+        static const std::vector<int> NO_WORDS;
+
+        auto it = m_words.find(kanji);
+        return it != m_words.end() ? it->second : NO_WORDS;
+    }
+
+    std::vector<int> KanjiIndex::findWords(std::string_view query) const
+    {
+        std::vector<char32_t> kanji;
+        for( char32_t codePoint : toCodePoints(query) )
+        {
+            if( isKanji(codePoint) )
+            {
+                kanji.push_back(codePoint);
+            }
+        }
+        sortUnique(kanji);
+
+        if( kanji.empty() )
+        {
+            return {};
+        }
+
+        // Start with the rarest kanji so the intermediate results stay small
+        std::sort(kanji.begin(), kanji.end(), [this](char32_t lhs, char32_t rhs)
+            {
+                return wordsWithKanji(lhs).size() < wordsWithKanji(rhs).size();
+            });
+
+        std::vector<int> result = wordsWithKanji(kanji.front());
+        for( std::size_t i = 1; i < kanji.size() && !result.empty(); ++i )
+        {
+            result = intersect(result, wordsWithKanji(kanji[i]));
+        }
+        return result;
+    }
+
+    std::vector<char32_t> KanjiIndex::kanjiWithRadicals(std::string_view radicals) const
+    {
+        std::vector<char32_t> result;
+        bool first = true;
+        for( char32_t radical : toCodePoints(radicals) )
+        {
+            if( isSeparator(radical) )
+            {
+                continue;
+            }
+
+            auto it = m_radicalKanji.find(radical);
+            if( it == m_radicalKanji.end() )
+            {
+                return {};
+            }
+
+            result = first ? it->second : intersect(result, it->second);
+            first = false;
+            if( result.empty() )
+            {
+                break;
+            }
+        }
+        return result;
+    }
+
+    std::vector<int> KanjiIndex::findWordsByRadicals(std::string_view radicals) const
+    {
+        std::vector<int> result;
+        for( char32_t kanji : kanjiWithRadicals(radicals) )
+        {
+            const std::vector<int>& wordIds = wordsWithKanji(kanji);
+            result.insert(result.end(), wordIds.begin(), wordIds.end());
+        }
+        sortUnique(result);
+        return result;
+    }
+}
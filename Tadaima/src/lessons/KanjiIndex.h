@@ -0,0 +1,98 @@
+/**
+ * @file KanjiIndex.h
+ * @brief Declares the KanjiIndex class which finds words by the kanji and radicals they are written with.
+ */
+
+#pragma once
+
+#include "Lesson.h"
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tadaima
+{
+    /**
+     * @brief The KanjiIndex class is an inverted index from kanji and radicals to word IDs.
+     *
+     * Every kanji of a word (taken from its kanji spelling and, for words typed in by hand, its kana field) maps to the
+     * sorted IDs of the words containing it, so a lookup is a hash probe and queries with several kanji are merges of
+     * sorted lists. Radicals are resolved through a KRADFILE style table which lists the components of each kanji.
+     */
+    class KanjiIndex
+    {
+    public:
+        static constexpr const char* RADICAL_TABLE_PATH = "kradfile"; /**< Default location of the radical table. */
+
+        /**
+         * @brief Loads the radical decomposition of kanji.
+         *
+         * Each line has the form "kanji : radical radical ...". Lines starting with '#' are ignored.
+         * The table must be UTF-8 encoded (the original KRADFILE is EUC-JP and has to be converted first).
+         *
+         * @param input Stream with the radical table.
+         * @return Number of kanji read from the table.
+         */
+        std::size_t loadRadicals(std::istream& input);
+
+        /**
+         * @brief Loads the radical decomposition of kanji from a file.
+         * @param path Path of the radical table.
+         * @return True if the table contained at least one kanji, false otherwise.
+         */
+        bool loadRadicals(const std::string& path);
+
+        /**
+         * @brief Checks if a radical table is loaded.
+         * @return True if radical lookups are possible.
+         */
+        bool hasRadicals() const;
+
+        /**
+         * @brief Rebuilds the index for the given lessons.
+         * @param lessons All lessons of the library.
+         */
+        void build(const std::vector<Lesson>& lessons);
+
+        /**
+         * @brief Gets the number of distinct kanji in the index.
+         * @return The number of indexed kanji.
+         */
+        std::size_t kanjiCount() const;
+
+        /**
+         * @brief Gets the words containing a kanji.
+         * @param kanji The kanji code point.
+         * @return Sorted word IDs, empty if no word contains the kanji.
+         */
+        const std::vector<int>& wordsWithKanji(char32_t kanji) const;
+
+        /**
+         * @brief Finds the words containing every kanji of the query. Characters other than kanji are ignored.
+         * @param query UTF-8 text with one or more kanji.
+         * @return Sorted word IDs.
+         */
+        std::vector<int> findWords(std::string_view query) const;
+
+        /**
+         * @brief Finds the kanji which contain every radical of the query.
+         * @param radicals UTF-8 text with one or more radicals. Whitespace is ignored.
+         * @return Sorted kanji code points, including kanji no word is written with.
+         */
+        std::vector<char32_t> kanjiWithRadicals(std::string_view radicals) const;
+
+        /**
+         * @brief Finds the words containing a kanji which contains every radical of the query.
+         * @param radicals UTF-8 text with one or more radicals. Whitespace is ignored.
+         * @return Sorted word IDs.
+         */
+        std::vector<int> findWordsByRadicals(std::string_view radicals) const;
+
+    private:
+        std::unordered_map<char32_t, std::vector<int>> m_words; /**< Sorted word IDs by kanji. */
+        std::unordered_map<char32_t, std::vector<char32_t>> m_radicalKanji; /**< Sorted kanji by radical. */
+    };
+}
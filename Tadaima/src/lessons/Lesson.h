@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -17,10 +18,14 @@ namespace tadaima
     {
         int id; /**< The ID of the word. */
         std::string kana; /**< The kana representation of the word. */
+        std::string kanji; /**< The kanji spelling of the word, empty for words written in kana only. */
         std::string translation; /**< The translation of the word. */
         std::string romaji; /**< The romaji representation of the word. */
         std::string exampleSentence; /**< An example sentence using the word. */
         std::vector<std::string> tags; /**< Tags associated with the word. */
+        int frequencyRank = 0; /**< Rank of the word in the imported frequency list, 0 if unknown. */
+        int clozeStart = -1; /**< Byte offset of the word within the example sentence, -1 if it does not appear. */
+        int clozeLength = -1; /**< Length in bytes of the word within the example sentence, -1 until it was located. */
 
         // Default constructor
         Word() : id(-1) {}
@@ -31,17 +36,12 @@ namespace tadaima
         {
         }
 
-        // Copy constructor
-        Word(const Word& other)
-            : id(other.id), kana(other.kana), translation(other.translation), romaji(other.romaji), exampleSentence(other.exampleSentence), tags(other.tags)
-        {
-        }
-
 
         // Comparison operators
         bool operator==(const Word& other) const
         {
             return kana == other.kana &&
+                kanji == other.kanji &&
                 translation == other.translation &&
                 romaji == other.romaji &&
                 exampleSentence == other.exampleSentence &&
@@ -84,4 +84,27 @@ namespace tadaima
             return mainName.empty() && subName.empty() && words.empty();
         }
     };
+
+    /**
+     * @brief Struct describing a change applied to a selection of words at once.
+     */
+    struct WordOperation
+    {
+        /**
+         * @brief The kind of change.
+         */
+        enum class Type : uint8_t
+        {
+            Move,   /**< Moves the words to the target lesson. */
+            Copy,   /**< Copies the words with their tags to the target lesson. */
+            Delete, /**< Deletes the words. */
+            Retag   /**< Adds and removes tags of the words. */
+        };
+
+        Type type = Type::Move; /**< The kind of change. */
+        std::vector<int> wordIds; /**< IDs of the selected words. */
+        Lesson target; /**< Lesson the words are moved or copied to. A lesson with ID 0 is created from its names. */
+        std::vector<std::string> addedTags; /**< Tags added to the words by a retag. */
+        std::vector<std::string> removedTags; /**< Tags removed from the words by a retag. */
+    };
 }
@@ -1,5 +1,6 @@
 #include "LessonManager.h"
 #include "tools/Database.h"
+#include <algorithm>
 
 namespace tadaima
 {
@@ -7,36 +8,52 @@ namespace tadaima
 
     int LessonManager::addLesson(const std::string& mainName, const std::string& subName)
     {
-        return m_database.addLesson(mainName, subName);
+        const int lessonId = m_database.addLesson(mainName, subName);
+        if( lessonId != -1 )
+        {
+            m_changedLessons.push_back(lessonId);
+        }
+        return lessonId;
     }
 
     int LessonManager::editLesson(const Lesson& lesson)
     {
-        return m_database.editLesson(lesson);
+        // A lesson which did not exist yet is stored under a new ID, which is the one the GUI has to read
+        const int lessonId = m_database.editLesson(lesson);
+        m_changedLessons.push_back(lessonId != -1 ? lessonId : lesson.id);
+        return lessonId;
     }
 
-    void LessonManager::editLessons(const std::vector<Lesson>& lessons)
+    bool LessonManager::editLessons(const std::vector<Lesson>& lessons)
     {
         // Iterate over each lesson and add it to the database
+        bool edited = true;
         for( const auto& lesson : lessons )
         {
-            editLesson(lesson);
+            edited = editLesson(lesson) != -1 && edited;
         }
+        return edited;
     }
 
-    void LessonManager::addWordToLesson(int lessonId, const Word& word)
+    bool LessonManager::addWordToLesson(int lessonId, const Word& word)
     {
+        m_changedLessons.push_back(lessonId);
         int wordId = m_database.addWord(lessonId, word);
+        if( wordId == -1 )
+        {
+            return false;
+        }
         for( const auto& tag : word.tags )
         {
             m_database.addTag(wordId, tag);
         }
+        return true;
     }
 
     int LessonManager::addLesson(const Lesson& lesson)
     {
         // Add the lesson to the database
-        int lessonId = m_database.addLesson(lesson.mainName, lesson.subName);
+        int lessonId = addLesson(lesson.mainName, lesson.subName);
 
         // Add all words associated with the lesson
         for( const auto& word : lesson.words )
@@ -47,36 +64,111 @@ namespace tadaima
         return lessonId;
     }
 
-    void LessonManager::addLessons(const std::vector<Lesson>& lessons)
+    bool LessonManager::addLessons(const std::vector<Lesson>& lessons)
     {
         // Iterate over each lesson and add it to the database
+        bool added = true;
         for( const auto& lesson : lessons )
         {
-            addLesson(lesson);
+            const int lessonId = addLesson(lesson.mainName, lesson.subName);
+            added = lessonId != -1 && added;
+            for( const auto& word : lesson.words )
+            {
+                added = lessonId != -1 && addWordToLesson(lessonId, word) && added;
+            }
         }
+        return added;
     }
 
-    void LessonManager::renameLessons(const std::vector<Lesson>& lessons)
+    bool LessonManager::renameLessons(const std::vector<Lesson>& lessons)
     {
         // Iterate over each lesson and add it to the database
+        bool renamed = true;
         for( const auto& lesson : lessons )
         {
-            renameLesson(lesson.id, lesson.mainName, lesson.subName);
+            renamed = renameLesson(lesson.id, lesson.mainName, lesson.subName) && renamed;
         }
+        return renamed;
     }
 
-    void LessonManager::removeLessons(const std::vector<Lesson>& lessons)
+    bool LessonManager::removeLessons(const std::vector<Lesson>& lessons)
     {
         // Iterate over each lesson and delete it from the database
+        bool removed = true;
         for( const auto& lesson : lessons )
         {
-            m_database.deleteLesson(lesson.id);
+            m_changedLessons.push_back(lesson.id);
+            removed = m_database.deleteLesson(lesson.id) && removed;
+        }
+        return removed;
+    }
+
+    bool LessonManager::renameLesson(int lessonId, const std::string& newMainName, const std::string& newSubName)
+    {
+        m_changedLessons.push_back(lessonId);
+        return m_database.updateLesson(lessonId, newMainName, newSubName);
+    }
+
+    bool LessonManager::moveWords(const std::vector<int>& wordIds, const Lesson& target)
+    {
+        const int lessonId = targetLessonId(target);
+        if( lessonId == -1 )
+        {
+            return false;
         }
+        noteLessonsOfWords(wordIds);
+        return m_database.moveWords(wordIds, lessonId);
+    }
+
+    bool LessonManager::copyWords(const std::vector<int>& wordIds, const Lesson& target)
+    {
+        const int lessonId = targetLessonId(target);
+        return lessonId != -1 && m_database.copyWords(wordIds, lessonId);
+    }
+
+    bool LessonManager::deleteWords(const std::vector<int>& wordIds)
+    {
+        noteLessonsOfWords(wordIds);
+        return m_database.deleteWords(wordIds);
     }
 
-    void LessonManager::renameLesson(int lessonId, const std::string& newMainName, const std::string& newSubName)
+    bool LessonManager::retagWords(const std::vector<int>& wordIds, const std::vector<std::string>& addedTags, const std::vector<std::string>& removedTags)
     {
-        m_database.updateLesson(lessonId, newMainName, newSubName);
+        noteLessonsOfWords(wordIds);
+        return m_database.retagWords(wordIds, addedTags, removedTags);
+    }
+
+    bool LessonManager::applyWordOperation(const WordOperation& operation)
+    {
+        switch( operation.type )
+        {
+            case WordOperation::Type::Move:
+                return moveWords(operation.wordIds, operation.target);
+            case WordOperation::Type::Copy:
+                return copyWords(operation.wordIds, operation.target);
+            case WordOperation::Type::Delete:
+                return deleteWords(operation.wordIds);
+            case WordOperation::Type::Retag:
+                return retagWords(operation.wordIds, operation.addedTags, operation.removedTags);
+            default:
+                return false;
+        }
+    }
+
+    int LessonManager::targetLessonId(const Lesson& target)
+    {
+        if( target.id != 0 )
+        {
+            m_changedLessons.push_back(target.id);
+            return target.id;
+        }
+        return addLesson(target.mainName, target.subName);
+    }
+
+    void LessonManager::noteLessonsOfWords(const std::vector<int>& wordIds)
+    {
+        const std::vector<int> lessonIds = m_database.getLessonIdsOfWords(wordIds);
+        m_changedLessons.insert(m_changedLessons.end(), lessonIds.begin(), lessonIds.end());
     }
 
     std::vector<std::string> LessonManager::getLessonNames() const
@@ -94,4 +186,18 @@ namespace tadaima
         return m_database.getAllLessons();
     }
 
+    std::vector<Lesson> LessonManager::getLessons(const std::vector<int>& lessonIds) const
+    {
+        return m_database.getLessons(lessonIds);
+    }
+
+    std::vector<int> LessonManager::takeChangedLessons()
+    {
+        std::vector<int> lessonIds;
+        lessonIds.swap(m_changedLessons);
+        std::sort(lessonIds.begin(), lessonIds.end());
+        lessonIds.erase(std::unique(lessonIds.begin(), lessonIds.end()), lessonIds.end());
+        return lessonIds;
+    }
+
 }
\ No newline at end of file
@@ -5,7 +5,7 @@
 
 #pragma once
 
-#include "Tools/Database.h"
+#include "tools/Database.h"
 #include "Lesson.h"
 #include <vector>
 #include <string>
@@ -34,41 +34,85 @@ namespace tadaima
 
         /**
          * @brief Edits a lesson in the database.
-         * @param lesson The lesson to edit.
-         * @return The ID of the edited lesson.
+         * @param lesson The lesson to edit, stored as a new lesson if it does not exist.
+         * @return The ID of the stored lesson, or -1 on failure.
          */
         int editLesson(const Lesson& lesson);
 
         /**
          * @brief Edits multiple lessons in the database.
          * @param lessons The vector of lessons to edit.
+         * @return True if every lesson was stored, false otherwise.
          */
-        void editLessons(const std::vector<Lesson>& lessons);
+        bool editLessons(const std::vector<Lesson>& lessons);
 
         /**
          * @brief Adds a word to a lesson in the database.
          * @param lessonId The ID of the lesson.
          * @param word The word to add to the lesson.
+         * @return True if the word was added, false otherwise.
          */
-        void addWordToLesson(int lessonId, const Word& word);
+        bool addWordToLesson(int lessonId, const Word& word);
 
         /**
          * @brief Adds multiple lessons to the database.
          * @param lessons The vector of lessons to add.
+         * @return True if every lesson and word was added, false otherwise.
          */
-        void addLessons(const std::vector<Lesson>& lessons);
+        bool addLessons(const std::vector<Lesson>& lessons);
 
         /**
          * @brief Renames multiple lessons in the database.
          * @param lessons The vector of lessons to rename.
+         * @return True if every lesson was renamed, false otherwise.
          */
-        void renameLessons(const std::vector<Lesson>& lessons);
+        bool renameLessons(const std::vector<Lesson>& lessons);
 
         /**
          * @brief Removes multiple lessons from the database.
          * @param lessons The vector of lessons to remove.
+         * @return True if every lesson was removed, false otherwise.
          */
-        void removeLessons(const std::vector<Lesson>& lessons);
+        bool removeLessons(const std::vector<Lesson>& lessons);
+
+        /**
+         * @brief Moves words to a lesson.
+         * @param wordIds IDs of the words to move.
+         * @param target The target lesson, created from its names if its ID is 0.
+         * @return True if the words were moved, false otherwise.
+         */
+        bool moveWords(const std::vector<int>& wordIds, const Lesson& target);
+
+        /**
+         * @brief Copies words with their tags to a lesson.
+         * @param wordIds IDs of the words to copy.
+         * @param target The target lesson, created from its names if its ID is 0.
+         * @return True if the words were copied, false otherwise.
+         */
+        bool copyWords(const std::vector<int>& wordIds, const Lesson& target);
+
+        /**
+         * @brief Deletes words from their lessons.
+         * @param wordIds IDs of the words to delete.
+         * @return True if the words were deleted, false otherwise.
+         */
+        bool deleteWords(const std::vector<int>& wordIds);
+
+        /**
+         * @brief Adds and removes tags of words.
+         * @param wordIds IDs of the words to retag.
+         * @param addedTags Tags added to the words.
+         * @param removedTags Tags removed from the words.
+         * @return True if the tags were changed, false otherwise.
+         */
+        bool retagWords(const std::vector<int>& wordIds, const std::vector<std::string>& addedTags, const std::vector<std::string>& removedTags);
+
+        /**
+         * @brief Applies a change to a selection of words.
+         * @param operation The change to apply.
+         * @return True if the change was applied, false otherwise.
+         */
+        bool applyWordOperation(const WordOperation& operation);
 
         /**
          * @brief Retrieves all lessons from the database.
@@ -89,6 +133,22 @@ namespace tadaima
          */
         std::vector<Word> getWordsInLesson(int lessonId) const;
 
+        /**
+         * @brief Retrieves the lessons with the given IDs.
+         * @param lessonIds The IDs of the lessons, unknown IDs are skipped.
+         * @return A vector containing the found lessons, ordered by ID.
+         */
+        std::vector<Lesson> getLessons(const std::vector<int>& lessonIds) const;
+
+        /**
+         * @brief Gets the IDs of the lessons created, changed or removed since the last call and forgets them.
+         *
+         * Lessons touched by changes which were rolled back afterwards are included, reading them again is harmless.
+         *
+         * @return The sorted lesson IDs.
+         */
+        std::vector<int> takeChangedLessons();
+
     private:
 
         /**
@@ -104,12 +164,31 @@ namespace tadaima
          * @param lessonId The ID of the lesson to rename.
          * @param newMainName The new main name of the lesson.
          * @param newSubName The new sub name of the lesson.
+         * @return True if the lesson was renamed, false otherwise.
          */
-        void renameLesson(int lessonId, const std::string& newMainName, const std::string& newSubName);
+        bool renameLesson(int lessonId, const std::string& newMainName, const std::string& newSubName);
+
+        /**
+         * @brief Gets the ID of the lesson words are moved or copied to, creating the lesson if needed.
+         * @param target The target lesson.
+         * @return The ID of the lesson, or -1 if it could not be created.
+         */
+        int targetLessonId(const Lesson& target);
+
+        /**
+         * @brief Remembers the lessons holding words before they are moved, deleted or retagged.
+         * @param wordIds IDs of the words.
+         */
+        void noteLessonsOfWords(const std::vector<int>& wordIds);
 
         /**
          * @brief Reference to the database object.
          */
         Database& m_database;
+
+        /**
+         * @brief IDs of the lessons touched since the last takeChangedLessons(), with repetitions.
+         */
+        std::vector<int> m_changedLessons;
     };
 }
@@ -0,0 +1,279 @@
+#include "LessonSerializer.h"
+#include "Tools/pugixml.hpp"
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <unordered_set>
+
+namespace tadaima
+{
+    namespace
+    {
+        constexpr std::size_t CSV_COLUMNS = 8;
+
+        /**
+         * @brief Reads one CSV record, which may span several lines when a quoted field contains line breaks.
+         * @param input The stream to read.
+         * @param fields Receives the fields of the record.
+         * @return False at the end of the input, true otherwise.
+         */
+        bool readCsvRecord(std::istream& input, std::vector<std::string>& fields)
+        {
+            fields.clear();
+            if( input.peek() == std::char_traits<char>::eof() )
+            {
+                return false;
+            }
+
+            std::string field;
+            bool quoted = false;
+            char character;
+            while( input.get(character) )
+            {
+                if( quoted )
+                {
+                    if( character == '"' )
+                    {
+                        if( input.peek() == '"' )
+                        {
+                            field += '"';
+                            input.get();
+                        }
+                        else
+                        {
+                            quoted = false;
+                        }
+                    }
+                    else
+                    {
+                        field += character;
+                    }
+                }
+                else if( character == '"' )
+                {
+                    quoted = true;
+                }
+                else if( character == ',' )
+                {
+                    fields.push_back(std::move(field));
+                    field.clear();
+                }
+                else if( character == '\n' )
+                {
+                    break;
+                }
+                else if( character != '\r' )
+                {
+                    field += character;
+                }
+            }
+            fields.push_back(std::move(field));
+            return true;
+        }
+
+        void writeCsvField(std::ostream& output, const std::string& field)
+        {
+            if( field.find_first_of(",\"\r\n") == std::string::npos )
+            {
+                output << field;
+                return;
+            }
+
+            output << '"';
+            for( char character : field )
+            {
+                if( character == '"' )
+                {
+                    output << '"';
+                }
+                output << character;
+            }
+            output << '"';
+        }
+
+        std::vector<std::string> splitTags(const std::string& tags)
+        {
+            std::vector<std::string> result;
+            std::string tag;
+            std::istringstream stream(tags);
+            while( std::getline(stream, tag, LessonSerializer::TAG_SEPARATOR) )
+            {
+                if( !tag.empty() )
+                {
+                    result.push_back(tag);
+                }
+            }
+            return result;
+        }
+    }
+
+    bool LessonSerializer::read(const std::string& path, std::vector<Lesson>& lessons)
+    {
+        std::ifstream input(path, std::ios::binary);
+        if( !input )
+        {
+            return false;
+        }
+        return path.ends_with(CSV_EXTENSION) ? readCsv(input, lessons) : readXml(input, lessons);
+    }
+
+    bool LessonSerializer::write(const std::string& path, const std::vector<Lesson>& lessons)
+    {
+        std::ofstream output(path, std::ios::binary | std::ios::trunc);
+        if( !output )
+        {
+            return false;
+        }
+        return path.ends_with(CSV_EXTENSION) ? writeCsv(output, lessons) : writeXml(output, lessons);
+    }
+
+    bool LessonSerializer::readXml(std::istream& input, std::vector<Lesson>& lessons)
+    {
+        pugi::xml_document doc;
+        if( !doc.load(input) )
+        {
+            return false;
+        }
+
+        std::unordered_set<std::string> uniqueLessons; // To track unique lessons
+        for( pugi::xml_node lessonNode : doc.child("lessons").children("lesson") )
+        {
+            std::string lessonName = lessonNode.attribute("name").as_string();
+
+            for( pugi::xml_node subnameNode : lessonNode.children("subname") )
+            {
+                Lesson lesson;
+                lesson.mainName = lessonName;
+                lesson.subName = subnameNode.attribute("name").as_string();
+                if( !uniqueLessons.insert(lesson.mainName + ":" + lesson.subName).second )
+                {
+                    continue;
+                }
+
+                for( pugi::xml_node wordNode : subnameNode.children("word") )
+                {
+                    Word word;
+                    word.translation = wordNode.attribute("translation").as_string();
+                    word.romaji = wordNode.attribute("romaji").as_string();
+                    word.kana = wordNode.attribute("kana").as_string();
+                    word.kanji = wordNode.attribute("kanji").as_string();
+                    lesson.words.push_back(word);
+                }
+                lessons.push_back(lesson);
+            }
+        }
+        return true;
+    }
+
+    bool LessonSerializer::writeXml(std::ostream& output, const std::vector<Lesson>& lessons)
+    {
+        pugi::xml_document doc;
+        pugi::xml_node root = doc.append_child("lessons");
+
+        for( const auto& lesson : lessons )
+        {
+            pugi::xml_node lessonNode = root.append_child("lesson");
+            lessonNode.append_attribute("name") = lesson.mainName.c_str();
+
+            pugi::xml_node subnameNode = lessonNode.append_child("subname");
+            subnameNode.append_attribute("name") = lesson.subName.c_str();
+
+            for( const auto& word : lesson.words )
+            {
+                pugi::xml_node wordNode = subnameNode.append_child("word");
+                wordNode.append_attribute("translation") = word.translation.c_str();
+                wordNode.append_attribute("romaji") = word.romaji.c_str();
+                wordNode.append_attribute("kana") = word.kana.c_str();
+                if( !word.kanji.empty() )
+                {
+                    wordNode.append_attribute("kanji") = word.kanji.c_str();
+                }
+            }
+        }
+
+        doc.save(output);
+        return output.good();
+    }
+
+    bool LessonSerializer::readCsv(std::istream& input, std::vector<Lesson>& lessons)
+    {
+        std::vector<std::string> fields;
+        if( !readCsvRecord(input, fields) )
+        {
+            return false;
+        }
+
+        std::string header;
+        for( std::size_t index = 0; index < fields.size(); ++index )
+        {
+            header += (index == 0 ? "" : ",") + fields[index];
+        }
+        if( header.starts_with("\xEF\xBB\xBF") )
+        {
+            header.erase(0, 3);
+        }
+        if( header != CSV_HEADER )
+        {
+            return false;
+        }
+
+        std::map<std::pair<std::string, std::string>, std::size_t> lessonIndices;
+        while( readCsvRecord(input, fields) )
+        {
+            if( fields.size() == 1 && fields[0].empty() )
+            {
+                continue; // Blank line
+            }
+            if( fields.size() != CSV_COLUMNS )
+            {
+                return false;
+            }
+
+            auto [it, inserted] = lessonIndices.try_emplace({ fields[0], fields[1] }, lessons.size());
+            if( inserted )
+            {
+                Lesson& lesson = lessons.emplace_back();
+                lesson.mainName = fields[0];
+                lesson.subName = fields[1];
+            }
+
+            Word word;
+            word.kana = fields[2];
+            word.kanji = fields[3];
+            word.romaji = fields[4];
+            word.translation = fields[5];
+            word.exampleSentence = fields[6];
+            word.tags = splitTags(fields[7]);
+            lessons[it->second].words.push_back(word);
+        }
+        return true;
+    }
+
+    bool LessonSerializer::writeCsv(std::ostream& output, const std::vector<Lesson>& lessons)
+    {
+        output << CSV_HEADER << "\r\n";
+        for( const auto& lesson : lessons )
+        {
+            for( const auto& word : lesson.words )
+            {
+                std::string tags;
+                for( const auto& tag : word.tags )
+                {
+                    tags += (tags.empty() ? "" : std::string(1, TAG_SEPARATOR)) + tag;
+                }
+
+                const std::string* fields[CSV_COLUMNS] = { &lesson.mainName, &lesson.subName, &word.kana, &word.kanji, &word.romaji, &word.translation, &word.exampleSentence, &tags };
+                for( std::size_t index = 0; index < CSV_COLUMNS; ++index )
+                {
+                    if( index > 0 )
+                    {
+                        output << ',';
+                    }
+                    writeCsvField(output, *fields[index]);
+                }
+                output << "\r\n";
+            }
+        }
+        return output.good();
+    }
+}
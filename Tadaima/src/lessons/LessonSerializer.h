@@ -0,0 +1,79 @@
+/**
+ * @file LessonSerializer.h
+ * @brief Declares the LessonSerializer class which reads and writes lessons as XML and CSV files.
+ */
+
+#pragma once
+
+#include "Lesson.h"
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace tadaima
+{
+    /**
+     * @brief The LessonSerializer class converts lessons from and to the interchange formats.
+     *
+     * XML files hold <lesson name> elements with <subname name> children listing the words; only the kana, kanji,
+     * romaji and translation are stored. CSV files hold one word per row with the columns of CSV_HEADER, fields are
+     * quoted as in RFC 4180 and tags are separated by TAG_SEPARATOR. In both formats a lesson is identified by its
+     * main and sub name; repeated lessons are merged into the first one for CSV and skipped for XML.
+     */
+    class LessonSerializer
+    {
+    public:
+        static constexpr const char* XML_EXTENSION = ".xml"; /**< Extension of XML lesson files. */
+        static constexpr const char* CSV_EXTENSION = ".csv"; /**< Extension of CSV lesson files. */
+        static constexpr const char* CSV_HEADER = "main_name,sub_name,kana,kanji,romaji,translation,example_sentence,tags"; /**< First row of CSV files. */
+        static constexpr char TAG_SEPARATOR = ';'; /**< Separator of the tags in the CSV tags column. */
+
+        /**
+         * @brief Reads lessons from a file, choosing the format by extension. Files not ending with CSV_EXTENSION are read as XML.
+         * @param path Path of the file.
+         * @param lessons Receives the lessons. Lesson and word IDs are not set.
+         * @return True if the file was read, false otherwise.
+         */
+        static bool read(const std::string& path, std::vector<Lesson>& lessons);
+
+        /**
+         * @brief Writes lessons to a file, choosing the format by extension. Files not ending with CSV_EXTENSION are written as XML.
+         * @param path Path of the file.
+         * @param lessons The lessons to write.
+         * @return True if the file was written, false otherwise.
+         */
+        static bool write(const std::string& path, const std::vector<Lesson>& lessons);
+
+        /**
+         * @brief Reads lessons in the XML format.
+         * @param input The stream to read.
+         * @param lessons Receives the lessons.
+         * @return True if the document was parsed, false otherwise.
+         */
+        static bool readXml(std::istream& input, std::vector<Lesson>& lessons);
+
+        /**
+         * @brief Writes lessons in the XML format.
+         * @param output The stream to write.
+         * @param lessons The lessons to write.
+         * @return True if the document was written, false otherwise.
+         */
+        static bool writeXml(std::ostream& output, const std::vector<Lesson>& lessons);
+
+        /**
+         * @brief Reads lessons in the CSV format.
+         * @param input The stream to read.
+         * @param lessons Receives the lessons.
+         * @return True if the header matched and every row was complete, false otherwise.
+         */
+        static bool readCsv(std::istream& input, std::vector<Lesson>& lessons);
+
+        /**
+         * @brief Writes lessons in the CSV format.
+         * @param output The stream to write.
+         * @param lessons The lessons to write.
+         * @return True if the rows were written, false otherwise.
+         */
+        static bool writeCsv(std::ostream& output, const std::vector<Lesson>& lessons);
+    };
+}
@@ -0,0 +1,270 @@
+#include "TrigramIndex.h"
+#include "tools/JapaneseText.h"
+#include <algorithm>
+#include <iterator>
+
+namespace tadaima
+{
+    namespace
+    {
+        constexpr char FIELD_SEPARATOR = '\x1f';
+        constexpr int CODE_POINT_BITS = 21;
+        constexpr std::size_t MIN_COMPACTED_SLOTS = 1024; // Freed slots tolerated regardless of the size of the index
+
+        uint64_t gramKey(const char32_t* codePoints, std::size_t length)
+        {
+            uint64_t key = 0;
+            for( std::size_t i = 0; i < length; ++i )
+            {
+                key |= static_cast<uint64_t>(codePoints[i]) << (CODE_POINT_BITS * i);
+            }
+            return key;
+        }
+
+        uint64_t sourceHash(const Word& word)
+        {
+            return (hashText(word.translation) * 31 + hashText(word.kana)) * 31 + hashText(word.romaji);
+        }
+
+        std::string indexedText(const Word& word)
+        {
+            return normalizeJapanese(word.translation) + FIELD_SEPARATOR + normalizeJapanese(word.kana) + FIELD_SEPARATOR + normalizeJapanese(word.romaji);
+        }
+    }
+
+    void TrigramIndex::build(const std::vector<Lesson>& lessons)
+    {
+        m_entries.clear();
+        for( const auto& lesson : lessons )
+        {
+            for( const auto& word : lesson.words )
+            {
+                m_entries.push_back({ word.id, sourceHash(word), indexedText(word) });
+            }
+        }
+        compact();
+    }
+
+    std::size_t TrigramIndex::update(const std::vector<Lesson>& lessons)
+    {
+        std::size_t changed = 0;
+        std::vector<int> present;
+        present.reserve(m_slots.size());
+
+        for( const auto& lesson : lessons )
+        {
+            for( const auto& word : lesson.words )
+            {
+                present.push_back(word.id);
+                auto it = m_slots.find(word.id);
+                if( it == m_slots.end() || m_entries[it->second].sourceHash != sourceHash(word) )
+                {
+                    addWord(word);
+                    ++changed;
+                }
+            }
+        }
+
+        if( present.size() < m_slots.size() )
+        {
+            std::sort(present.begin(), present.end());
+            std::vector<int> removed;
+            for( const auto& [wordId, slot] : m_slots )
+            {
+                if( !std::binary_search(present.begin(), present.end(), wordId) )
+                {
+                    removed.push_back(wordId);
+                }
+            }
+            for( const int wordId : removed )
+            {
+                removeWord(wordId);
+            }
+            changed += removed.size();
+        }
+        return changed;
+    }
+
+    void TrigramIndex::addWord(const Word& word)
+    {
+        auto it = m_slots.find(word.id);
+        if( it != m_slots.end() )
+        {
+            // Edited words keep their slot, so the posting lists stay sorted
+            unindexSlot(it->second);
+            m_entries[it->second] = { word.id, sourceHash(word), indexedText(word) };
+            indexSlot(it->second);
+            return;
+        }
+
+        const uint32_t slot = static_cast<uint32_t>(m_entries.size());
+        m_entries.push_back({ word.id, sourceHash(word), indexedText(word) });
+        m_slots.emplace(word.id, slot);
+        indexSlot(slot);
+    }
+
+    void TrigramIndex::removeWord(int wordId)
+    {
+        auto it = m_slots.find(wordId);
+        if( it == m_slots.end() )
+        {
+            return;
+        }
+
+        unindexSlot(it->second);
+        m_entries[it->second] = { -1, 0, {} };
+        m_slots.erase(it);
+        if( ++m_freeSlots > std::max(MIN_COMPACTED_SLOTS, m_slots.size()) )
+        {
+            compact();
+        }
+    }
+
+    std::vector<int> TrigramIndex::find(std::string_view query) const
+    {
+        const std::string normalized = normalizeJapanese(query);
+        const std::u32string codePoints = toCodePoints(normalized);
+        if( codePoints.empty() )
+        {
+            return {};
+        }
+
+        std::vector<uint32_t> slots;
+        if( codePoints.size() <= MAX_GRAM_LENGTH )
+        {
+            auto it = m_postings.find(gramKey(codePoints.data(), codePoints.size()));
+            if( it != m_postings.end() )
+            {
+                slots = it->second;
+            }
+        }
+        else
+        {
+            std::vector<const std::vector<uint32_t>*> lists;
+            for( std::size_t i = 0; i + MAX_GRAM_LENGTH <= codePoints.size(); ++i )
+            {
+                auto it = m_postings.find(gramKey(codePoints.data() + i, MAX_GRAM_LENGTH));
+                if( it == m_postings.end() )
+                {
+                    return {};
+                }
+                lists.push_back(&it->second);
+            }
+            std::sort(lists.begin(), lists.end(), [](const auto* lhs, const auto* rhs) { return lhs->size() < rhs->size(); });
+
+            // Intersecting from the rarest trigram keeps the intermediate lists short
+            slots = *lists.front();
+            std::vector<uint32_t> intersection;
+            for( auto it = lists.begin() + 1; it != lists.end() && !slots.empty(); ++it )
+            {
+                intersection.clear();
+                std::set_intersection(slots.begin(), slots.end(), (*it)->begin(), (*it)->end(), std::back_inserter(intersection));
+                slots.swap(intersection);
+            }
+
+            // Having every trigram does not mean having them in order
+            std::erase_if(slots, [this, &normalized](uint32_t slot) { return m_entries[slot].text.find(normalized) == std::string::npos; });
+        }
+
+        std::vector<int> wordIds;
+        wordIds.reserve(slots.size());
+        for( const uint32_t slot : slots )
+        {
+            wordIds.push_back(m_entries[slot].wordId);
+        }
+        if( !std::is_sorted(wordIds.begin(), wordIds.end()) )
+        {
+            std::sort(wordIds.begin(), wordIds.end());
+        }
+        return wordIds;
+    }
+
+    std::size_t TrigramIndex::wordCount() const
+    {
+        return m_slots.size();
+    }
+
+    std::size_t TrigramIndex::gramCount() const
+    {
+        return m_postings.size();
+    }
+
+    std::vector<uint64_t> TrigramIndex::grams(std::string_view text)
+    {
+        std::vector<uint64_t> keys;
+        for( std::size_t begin = 0; begin <= text.size(); )
+        {
+            const std::size_t end = std::min(text.find(FIELD_SEPARATOR, begin), text.size());
+            const std::u32string field = toCodePoints(text.substr(begin, end - begin));
+            for( std::size_t i = 0; i < field.size(); ++i )
+            {
+                for( std::size_t length = 1; length <= MAX_GRAM_LENGTH && i + length <= field.size(); ++length )
+                {
+                    keys.push_back(gramKey(field.data() + i, length));
+                }
+            }
+            begin = end + 1;
+        }
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        return keys;
+    }
+
+    void TrigramIndex::indexSlot(uint32_t slot)
+    {
+        for( const uint64_t key : grams(m_entries[slot].text) )
+        {
+            std::vector<uint32_t>& slots = m_postings[key];
+            if( slots.empty() || slots.back() < slot )
+            {
+                slots.push_back(slot);
+            }
+            else
+            {
+                slots.insert(std::lower_bound(slots.begin(), slots.end(), slot), slot);
+            }
+        }
+    }
+
+    void TrigramIndex::unindexSlot(uint32_t slot)
+    {
+        for( const uint64_t key : grams(m_entries[slot].text) )
+        {
+            auto posting = m_postings.find(key);
+            if( posting == m_postings.end() )
+            {
+                continue;
+            }
+            std::vector<uint32_t>& slots = posting->second;
+            auto position = std::lower_bound(slots.begin(), slots.end(), slot);
+            if( position != slots.end() && *position == slot )
+            {
+                slots.erase(position);
+            }
+            if( slots.empty() )
+            {
+                m_postings.erase(posting);
+            }
+        }
+    }
+
+    void TrigramIndex::compact()
+    {
+        std::erase_if(m_entries, [](const Entry& entry) { return entry.wordId < 0; });
+        std::stable_sort(m_entries.begin(), m_entries.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.wordId < rhs.wordId; });
+        m_entries.erase(std::unique(m_entries.begin(), m_entries.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.wordId == rhs.wordId; }), m_entries.end());
+
+        // Slots are assigned in ascending order, so appending keeps every posting list sorted
+        m_slots.clear();
+        m_postings.clear();
+        m_freeSlots = 0;
+        for( uint32_t slot = 0; slot < m_entries.size(); ++slot )
+        {
+            m_slots.emplace(m_entries[slot].wordId, slot);
+            for( const uint64_t key : grams(m_entries[slot].text) )
+            {
+                m_postings[key].push_back(slot);
+            }
+        }
+    }
+}
@@ -0,0 +1,117 @@
+/**
+ * @file TrigramIndex.h
+ * @brief Declares the TrigramIndex class which finds words by substrings of their translation, kana and romaji.
+ */
+
+#pragma once
+
+#include "Lesson.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tadaima
+{
+    /**
+     * @brief The TrigramIndex class is an inverted index from character n-grams to word IDs.
+     *
+     * The translation, kana and romaji of every word are normalized, so a query matches regardless of case, width and
+     * script, and every sequence of one to three characters within a field maps to the words containing it. Queries of
+     * up to three characters are a single lookup; longer ones intersect the lists of their trigrams and check the
+     * remaining candidates for the whole query. The lists hold positions in a flat array of the indexed words rather
+     * than word IDs, so checking candidates reads adjacent memory. The index can follow edits word by word instead of
+     * being rebuilt.
+     */
+    class TrigramIndex
+    {
+    public:
+        static constexpr std::size_t MAX_GRAM_LENGTH = 3; /**< Longest indexed character sequence. */
+
+        /**
+         * @brief Rebuilds the index for the given lessons.
+         * @param lessons All lessons of the library.
+         */
+        void build(const std::vector<Lesson>& lessons);
+
+        /**
+         * @brief Brings the index in line with the given lessons, reindexing only words which were added, removed or edited.
+         * @param lessons All lessons of the library.
+         * @return The number of words which were reindexed or removed.
+         */
+        std::size_t update(const std::vector<Lesson>& lessons);
+
+        /**
+         * @brief Adds a word or reindexes it if it is already in the index.
+         * @param word The word.
+         */
+        void addWord(const Word& word);
+
+        /**
+         * @brief Removes a word from the index.
+         * @param wordId ID of the word.
+         */
+        void removeWord(int wordId);
+
+        /**
+         * @brief Finds the words whose translation, kana or romaji contains the query.
+         * @param query UTF-8 text, normalized like the indexed fields.
+         * @return Sorted word IDs, empty for an empty query.
+         */
+        std::vector<int> find(std::string_view query) const;
+
+        /**
+         * @brief Gets the number of indexed words.
+         * @return The number of words.
+         */
+        std::size_t wordCount() const;
+
+        /**
+         * @brief Gets the number of distinct indexed character sequences.
+         * @return The number of n-grams.
+         */
+        std::size_t gramCount() const;
+
+    private:
+        /**
+         * @brief The indexed text of a word.
+         */
+        struct Entry
+        {
+            int wordId;             /**< ID of the word, -1 if the slot was freed. */
+            uint64_t sourceHash;    /**< Hash of the unnormalized fields, to detect edits. */
+            std::string text;       /**< Normalized fields separated by FIELD_SEPARATOR. */
+        };
+
+        /**
+         * @brief Gets the n-grams of a normalized text, each once.
+         * @param text Normalized fields separated by FIELD_SEPARATOR.
+         * @return The distinct n-gram keys.
+         */
+        static std::vector<uint64_t> grams(std::string_view text);
+
+        /**
+         * @brief Adds the n-grams of an entry to the posting lists.
+         * @param slot Slot of the entry.
+         */
+        void indexSlot(uint32_t slot);
+
+        /**
+         * @brief Removes the n-grams of an entry from the posting lists.
+         * @param slot Slot of the entry.
+         */
+        void unindexSlot(uint32_t slot);
+
+        /**
+         * @brief Rebuilds the slots and posting lists from the live entries, once many slots were freed.
+         */
+        void compact();
+
+        std::vector<Entry> m_entries; /**< Indexed words, ordered by word ID except for words added out of order. */
+        std::unordered_map<int, uint32_t> m_slots; /**< Slot of every indexed word by word ID. */
+        std::unordered_map<uint64_t, std::vector<uint32_t>> m_postings; /**< Sorted slots by n-gram. */
+        std::size_t m_freeSlots = 0; /**< Number of freed slots in the entries. */
+    };
+}
@@ -3,11 +3,13 @@
  * @brief Entry point for the application.
  */
 
-#include "Tools/CommandLineParser.h" 
+#include "cli/CommandLineInterface.h"
 #include "Tools/Logger.h"
+#ifndef TADAIMA_CLI_ONLY
 #include "Gui/Gui.h"
 #include "Application/Application.h"
-#include <iostream>
+#endif
+#include <format>
 #include <iostream>
 
 int main(int argc, char* argv[])
@@ -16,9 +18,17 @@ int main(int argc, char* argv[])
 
     try
     {
-        // Command line argument parsing
-        tools::CommandLineParser parser;
-        parser.parse(argc, argv);
+        // Command line argument parsing, a command runs headless instead of the GUI
+        tadaima::cli::CommandLineInterface commandLine;
+        commandLine.parse(argc, argv);
+#ifdef TADAIMA_CLI_ONLY
+        // Built without the GUI, so a start without a command prints the usage
+        return commandLine.run();
+#else
+        if( commandLine.isRequested() )
+        {
+            return commandLine.run();
+        }
 
         // Create EventBridge
         tadaima::EventBridge bridge;
@@ -28,7 +38,7 @@ int main(int argc, char* argv[])
         tadaima::gui::Gui gui(logger, config);
 
         // Create and configure the application
-        tadaima::application::Application application(logger, bridge);
+        tadaima::application::Application application(logger, bridge, commandLine.databaseFiles());
 
         bridge.initialize(application, gui);
         application.Initialize();
@@ -36,6 +46,7 @@ int main(int argc, char* argv[])
 
         // Run the GUI
         gui.run();
+#endif
     }
 
     // Catch any exceptions and display error message
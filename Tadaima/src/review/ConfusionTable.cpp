@@ -0,0 +1,99 @@
+#include "ConfusionTable.h"
+#include <algorithm>
+
+namespace tadaima
+{
+    namespace review
+    {
+        void ConfusionTable::record(int targetId, int chosenId, int64_t timestamp)
+        {
+            if( targetId < 0 || chosenId < 0 || targetId == chosenId )
+            {
+                return;
+            }
+
+            std::vector<Confusion>& confusions = m_confusions[targetId];
+            auto it = std::find_if(confusions.begin(), confusions.end(), [chosenId](const Confusion& confusion) { return confusion.chosenId == chosenId; });
+            if( it == confusions.end() )
+            {
+                if( confusions.size() >= MAX_PER_WORD )
+                {
+                    confusions.pop_back();
+                    --m_size;
+                }
+                confusions.push_back(Confusion{ targetId, chosenId, 0, timestamp });
+                it = confusions.end() - 1;
+                ++m_size;
+            }
+            ++it->count;
+            it->lastSeen = std::max(it->lastSeen, timestamp);
+
+            // Only the updated entry moved up, so bubbling it keeps the list sorted
+            while( it != confusions.begin() && isMoreConfused(*it, *(it - 1)) )
+            {
+                std::iter_swap(it, it - 1);
+                --it;
+            }
+        }
+
+        const std::vector<Confusion>& ConfusionTable::confusedWith(int targetId) const
+        {
+            static const std::vector<Confusion> NO_CONFUSIONS;
+            auto it = m_confusions.find(targetId);
+            return it != m_confusions.end() ? it->second : NO_CONFUSIONS;
+        }
+
+        std::vector<Confusion> ConfusionTable::mostConfused(std::size_t limit) const
+        {
+            std::vector<Confusion> all = pairs();
+            const std::size_t count = std::min(limit, all.size());
+            std::partial_sort(all.begin(), all.begin() + count, all.end(), isMoreConfused);
+            all.resize(count);
+            return all;
+        }
+
+        void ConfusionTable::load(const std::vector<Confusion>& confusions)
+        {
+            m_confusions.clear();
+            m_size = 0;
+            for( const auto& confusion : confusions )
+            {
+                if( confusion.targetId >= 0 && confusion.chosenId >= 0 && confusion.count > 0 )
+                {
+                    m_confusions[confusion.targetId].push_back(confusion);
+                }
+            }
+
+            for( auto& [targetId, list] : m_confusions )
+            {
+                std::sort(list.begin(), list.end(), isMoreConfused);
+                if( list.size() > MAX_PER_WORD )
+                {
+                    list.resize(MAX_PER_WORD);
+                }
+                m_size += list.size();
+            }
+        }
+
+        std::vector<Confusion> ConfusionTable::pairs() const
+        {
+            std::vector<Confusion> all;
+            all.reserve(m_size);
+            for( const auto& [targetId, list] : m_confusions )
+            {
+                all.insert(all.end(), list.begin(), list.end());
+            }
+            return all;
+        }
+
+        std::size_t ConfusionTable::size() const
+        {
+            return m_size;
+        }
+
+        bool ConfusionTable::isMoreConfused(const Confusion& lhs, const Confusion& rhs)
+        {
+            return lhs.count != rhs.count ? lhs.count > rhs.count : lhs.lastSeen > rhs.lastSeen;
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file ConfusionTable.h
+ * @brief Declares the ConfusionTable class which remembers which words the learner mixes up.
+ */
+
+#pragma once
+
+#include "Review.h"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace tadaima
+{
+    namespace review
+    {
+        /**
+         * @brief The ConfusionTable class counts the wrong answers picked for every asked word.
+         *
+         * Only the most frequent confusions of a word are kept, so the table stays proportional to the number of
+         * words, and the confusions of a word are found with a single hash lookup. When a word already has the
+         * maximum number of confusions, a new one replaces the least frequent and oldest one. The database trims
+         * its rows by the same order, so both keep the same pairs.
+         */
+        class ConfusionTable
+        {
+        public:
+            static constexpr std::size_t MAX_PER_WORD = 8; /**< Number of confusions kept per asked word. */
+
+            /**
+             * @brief Counts a wrong answer.
+             * @param targetId The ID of the asked word.
+             * @param chosenId The ID of the word whose answer was picked.
+             * @param timestamp Unix time (in seconds) of the answer.
+             */
+            void record(int targetId, int chosenId, int64_t timestamp);
+
+            /**
+             * @brief Gets the confusions of a word.
+             * @param targetId The ID of the asked word.
+             * @return The confusions, most frequent first, or an empty vector.
+             */
+            const std::vector<Confusion>& confusedWith(int targetId) const;
+
+            /**
+             * @brief Gets the most frequent confusions of all words.
+             * @param limit Maximum number of confusions.
+             * @return The confusions, most frequent first.
+             */
+            std::vector<Confusion> mostConfused(std::size_t limit) const;
+
+            /**
+             * @brief Replaces the table, e.g. with the confusions stored in the database.
+             * @param confusions The confusions.
+             */
+            void load(const std::vector<Confusion>& confusions);
+
+            /**
+             * @brief Gets all confusions.
+             * @return The confusions grouped by asked word.
+             */
+            std::vector<Confusion> pairs() const;
+
+            /**
+             * @brief Gets the number of confusions.
+             * @return The number of kept pairs.
+             */
+            std::size_t size() const;
+
+            /**
+             * @brief Checks if a confusion is kept ahead of another one of the same word.
+             * @param lhs The first confusion.
+             * @param rhs The second confusion.
+             * @return True if lhs was picked more often, or as often but later.
+             */
+            static bool isMoreConfused(const Confusion& lhs, const Confusion& rhs);
+
+        private:
+            std::unordered_map<int, std::vector<Confusion>> m_confusions; /**< Confusions by asked word, most frequent first. */
+            std::size_t m_size = 0; /**< Number of kept pairs. */
+        };
+    }
+}
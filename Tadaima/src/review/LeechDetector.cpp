@@ -0,0 +1,40 @@
+#include "LeechDetector.h"
+#include <algorithm>
+
+namespace tadaima
+{
+    namespace review
+    {
+        LeechDetector::LeechDetector(const LeechOptions& options)
+            : m_options(options)
+        {
+            m_options.lapseThreshold = std::max(1, m_options.lapseThreshold);
+            m_options.repeatInterval = std::max(0, m_options.repeatInterval);
+        }
+
+        bool LeechDetector::isLeech(const MemoryState& state) const
+        {
+            return state.lapses >= m_options.lapseThreshold;
+        }
+
+        bool LeechDetector::becameLeech(const MemoryState& before, const MemoryState& after) const
+        {
+            if( after.lapses <= before.lapses || !isLeech(after) )
+            {
+                return false;
+            }
+
+            const int beyond = after.lapses - m_options.lapseThreshold;
+            if( beyond == 0 )
+            {
+                return true;
+            }
+            return m_options.repeatInterval > 0 && beyond % m_options.repeatInterval == 0;
+        }
+
+        const LeechOptions& LeechDetector::getOptions() const
+        {
+            return m_options;
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/**
+ * @file LeechDetector.h
+ * @brief Declares the LeechDetector class which finds words the learner keeps failing.
+ */
+
+#pragma once
+
+#include "Review.h"
+
+namespace tadaima
+{
+    namespace review
+    {
+        /**
+         * @brief Thresholds of the leech detection.
+         */
+        struct LeechOptions
+        {
+            int lapseThreshold = 8;     /**< Number of failed reviews after which a word becomes a leech. */
+            int repeatInterval = 4;     /**< Number of further failures after which a leech is flagged again, 0 flags it only once. */
+        };
+
+        /**
+         * @brief The LeechDetector class decides whether a single answer turned a word into a leech.
+         *
+         * The check only compares the failure counter of the word before and after the answer, so it is evaluated
+         * incrementally while the reviews are stored instead of scanning the whole history. A leech is flagged when
+         * the lapses reach the threshold and again every repeat interval after that, so a word whose tag was cleared
+         * is flagged again if the learner keeps failing it.
+         */
+        class LeechDetector
+        {
+        public:
+            static constexpr const char* LEECH_TAG = "leech"; /**< Tag added to the leeches. */
+
+            /**
+             * @brief Constructs a LeechDetector object.
+             * @param options Thresholds of the detection.
+             */
+            explicit LeechDetector(const LeechOptions& options = LeechOptions());
+
+            /**
+             * @brief Checks whether a word has failed often enough to be a leech.
+             * @param state The memory state of the word.
+             * @return True if the word is a leech, false otherwise.
+             */
+            bool isLeech(const MemoryState& state) const;
+
+            /**
+             * @brief Checks whether a review should flag the word as a leech.
+             * @param before The memory state of the word before the review.
+             * @param after The memory state of the word after the review.
+             * @return True if the review was a failure reaching the threshold or one of its repeats, false otherwise.
+             */
+            bool becameLeech(const MemoryState& before, const MemoryState& after) const;
+
+            /**
+             * @brief Gets the thresholds of the detection.
+             * @return A const reference to the options.
+             */
+            const LeechOptions& getOptions() const;
+
+        private:
+            LeechOptions m_options; /**< Thresholds of the detection. */
+        };
+    }
+}
@@ -0,0 +1,75 @@
+#include "MemoryModel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace tadaima
+{
+    namespace review
+    {
+        MemoryModel::MemoryModel(const MemoryModelParameters& parameters) : m_parameters(parameters)
+        {
+        }
+
+        double MemoryModel::retrievability(const MemoryState& state, double elapsedDays) const
+        {
+            if( state.reviewCount == 0 || state.stability <= 0.0 )
+            {
+                return 0.0;
+            }
+
+            return std::exp(LOG_BASE_RETENTION * std::max(0.0, elapsedDays) / state.stability);
+        }
+
+        void MemoryModel::applyReview(MemoryState& state, bool correct, double elapsedDays) const
+        {
+            if( state.reviewCount == 0 )
+            {
+                state.stability = correct ? m_parameters.initialStability : m_parameters.initialStability * m_parameters.lapseFactor;
+                state.difficulty = correct ? INITIAL_DIFFICULTY : INITIAL_DIFFICULTY + DIFFICULTY_STEP_UP;
+            }
+            else if( correct )
+            {
+                const double recall = retrievability(state, elapsedDays);
+                const double growth = m_parameters.growthRate
+                    * ((MAX_DIFFICULTY + 1.0 - state.difficulty) / MAX_DIFFICULTY)
+                    * std::pow(state.stability, -m_parameters.stabilityDecay)
+                    * std::exp(m_parameters.retrievabilityGain * (1.0 - recall));
+
+                state.stability *= 1.0 + std::max(0.0, growth);
+                state.difficulty = std::max(MIN_DIFFICULTY, state.difficulty - DIFFICULTY_STEP_DOWN);
+            }
+            else
+            {
+                state.stability = std::max(MIN_STABILITY, state.stability * m_parameters.lapseFactor);
+                state.difficulty = std::min(MAX_DIFFICULTY, state.difficulty + DIFFICULTY_STEP_UP);
+            }
+
+            state.stability = std::max(MIN_STABILITY, state.stability);
+            state.reviewCount++;
+            if( !correct )
+            {
+                state.lapses++;
+            }
+        }
+
+        void MemoryModel::applyReview(MemoryState& state, const ReviewRecord& record) const
+        {
+            const double elapsedDays = state.reviewCount > 0 ? static_cast<double>(record.timestamp - state.lastReview) / SECONDS_PER_DAY : 0.0;
+
+            state.wordId = record.wordId;
+            applyReview(state, record.correct, elapsedDays);
+            state.lastReview = record.timestamp;
+        }
+
+        double MemoryModel::nextInterval(const MemoryState& state) const
+        {
+            const double retention = std::clamp(m_parameters.desiredRetention, 0.01, 0.99);
+            return std::max(MIN_STABILITY, state.stability) * std::log(retention) / LOG_BASE_RETENTION;
+        }
+
+        const MemoryModelParameters& MemoryModel::getParameters() const
+        {
+            return m_parameters;
+        }
+    }
+}
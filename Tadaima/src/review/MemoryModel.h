@@ -0,0 +1,91 @@
+/**
+ * @file MemoryModel.h
+ * @brief Declares the MemoryModel class which predicts recall probability and updates the memory state of words.
+ */
+
+#pragma once
+
+#include "Review.h"
+
+namespace tadaima
+{
+    namespace review
+    {
+        /**
+         * @brief Tunable parameters of the memory model.
+         */
+        struct MemoryModelParameters
+        {
+            double initialStability = 1.0;      /**< Stability (in days) after the first successful review. */
+            double growthRate = 2.5;            /**< Base growth of stability after a successful review. */
+            double stabilityDecay = 0.2;        /**< Exponent damping the growth of already stable memories. */
+            double retrievabilityGain = 1.0;    /**< Extra growth when a word is recalled while nearly forgotten. */
+            double lapseFactor = 0.3;           /**< Fraction of stability kept after a failed review. */
+            double desiredRetention = 0.9;      /**< Recall probability at which the next review is scheduled. */
+        };
+
+        /**
+         * @brief The MemoryModel class models forgetting of words with an exponential forgetting curve.
+         *
+         * Recall probability decays as 0.9^(t / S), where t is the time since the last review and S is the
+         * stability of the memory. Each review changes stability and difficulty of the word.
+         */
+        class MemoryModel
+        {
+        public:
+            static constexpr double SECONDS_PER_DAY = 86400.0; /**< Number of seconds in a day. */
+            static constexpr double LOG_BASE_RETENTION = -0.10536051565782630; /**< Natural logarithm of 0.9. */
+            static constexpr double MIN_STABILITY = 0.1; /**< Lower bound of stability (in days). */
+            static constexpr double MIN_DIFFICULTY = 1.0; /**< Lower bound of difficulty. */
+            static constexpr double MAX_DIFFICULTY = 10.0; /**< Upper bound of difficulty. */
+            static constexpr double INITIAL_DIFFICULTY = 5.0; /**< Difficulty after the first successful review. */
+            static constexpr double DIFFICULTY_STEP_DOWN = 0.3; /**< Decrease of difficulty after a successful review. */
+            static constexpr double DIFFICULTY_STEP_UP = 1.0; /**< Increase of difficulty after a failed review. */
+
+            /**
+             * @brief Constructs a MemoryModel object.
+             * @param parameters The parameters of the model.
+             */
+            explicit MemoryModel(const MemoryModelParameters& parameters = MemoryModelParameters());
+
+            /**
+             * @brief Calculates the probability of recalling a word.
+             * @param state The memory state of the word.
+             * @param elapsedDays Number of days since the last review.
+             * @return The recall probability in range [0, 1].
+             */
+            double retrievability(const MemoryState& state, double elapsedDays) const;
+
+            /**
+             * @brief Updates the memory state of a word after a review.
+             * @param state The memory state to update.
+             * @param correct True if the word was recalled correctly.
+             * @param elapsedDays Number of days since the last review.
+             */
+            void applyReview(MemoryState& state, bool correct, double elapsedDays) const;
+
+            /**
+             * @brief Updates the memory state of a word with a stored review.
+             * @param state The memory state to update.
+             * @param record The review to apply.
+             */
+            void applyReview(MemoryState& state, const ReviewRecord& record) const;
+
+            /**
+             * @brief Calculates the interval after which the word should be reviewed again.
+             * @param state The memory state of the word.
+             * @return The interval in days.
+             */
+            double nextInterval(const MemoryState& state) const;
+
+            /**
+             * @brief Gets the parameters of the model.
+             * @return A const reference to the model parameters.
+             */
+            const MemoryModelParameters& getParameters() const;
+
+        private:
+            MemoryModelParameters m_parameters; /**< Parameters of the model. */
+        };
+    }
+}
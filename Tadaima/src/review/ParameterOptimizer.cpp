@@ -0,0 +1,384 @@
+#include "ParameterOptimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace tadaima
+{
+    namespace review
+    {
+        namespace
+        {
+            using Parameters = std::array<double, ParameterOptimizer::PARAMETER_COUNT>;
+
+            constexpr std::size_t MIN_REVIEWS_PER_THREAD = 8192;
+            constexpr double PROBABILITY_EPSILON = 1e-6;
+            constexpr double ADAM_BETA1 = 0.9;
+            constexpr double ADAM_BETA2 = 0.999;
+            constexpr double ADAM_EPSILON = 1e-8;
+
+            /**
+             * @brief Bounds and step scale of a fitted parameter.
+             */
+            struct ParameterRange
+            {
+                double lower;
+                double upper;
+                double scale;
+            };
+
+            constexpr std::array<ParameterRange, ParameterOptimizer::PARAMETER_COUNT> PARAMETER_RANGES =
+            { {
+                { 0.1, 365.0, 1.0 },    // initialStability
+                { 0.01, 10.0, 0.5 },    // growthRate
+                { 0.0, 1.0, 0.05 },     // stabilityDecay
+                { 0.0, 5.0, 0.25 },     // retrievabilityGain
+                { 0.01, 1.0, 0.05 }     // lapseFactor
+            } };
+
+            Parameters toArray(const MemoryModelParameters& parameters)
+            {
+                return { parameters.initialStability, parameters.growthRate, parameters.stabilityDecay,
+                    parameters.retrievabilityGain, parameters.lapseFactor };
+            }
+
+            MemoryModelParameters fromArray(const Parameters& values, MemoryModelParameters parameters)
+            {
+                parameters.initialStability = values[0];
+                parameters.growthRate = values[1];
+                parameters.stabilityDecay = values[2];
+                parameters.retrievabilityGain = values[3];
+                parameters.lapseFactor = values[4];
+                return parameters;
+            }
+
+            Parameters clampToRanges(Parameters values)
+            {
+                for( std::size_t i = 0; i < values.size(); ++i )
+                {
+                    values[i] = std::clamp(values[i], PARAMETER_RANGES[i].lower, PARAMETER_RANGES[i].upper);
+                }
+                return values;
+            }
+
+            /**
+             * @brief A value together with its partial derivatives with respect to all fitted parameters.
+             *
+             * The fixed size gradient array lets the compiler vectorize every operation.
+             */
+            struct Dual
+            {
+                double value = 0.0;
+                Parameters gradient{};
+            };
+
+            Dual constant(double value)
+            {
+                return Dual{ value };
+            }
+
+            Dual variable(double value, std::size_t index)
+            {
+                Dual result{ value };
+                result.gradient[index] = 1.0;
+                return result;
+            }
+
+            Dual operator*(const Dual& lhs, const Dual& rhs)
+            {
+                Dual result{ lhs.value * rhs.value };
+                for( std::size_t i = 0; i < ParameterOptimizer::PARAMETER_COUNT; ++i )
+                {
+                    result.gradient[i] = lhs.gradient[i] * rhs.value + rhs.gradient[i] * lhs.value;
+                }
+                return result;
+            }
+
+            Dual operator*(const Dual& lhs, double rhs)
+            {
+                Dual result{ lhs.value * rhs };
+                for( std::size_t i = 0; i < ParameterOptimizer::PARAMETER_COUNT; ++i )
+                {
+                    result.gradient[i] = lhs.gradient[i] * rhs;
+                }
+                return result;
+            }
+
+            Dual operator+(const Dual& lhs, double rhs)
+            {
+                Dual result = lhs;
+                result.value += rhs;
+                return result;
+            }
+
+            Dual operator-(double lhs, const Dual& rhs)
+            {
+                return rhs * -1.0 + lhs;
+            }
+
+            Dual exp(const Dual& x)
+            {
+                const double value = std::exp(x.value);
+                Dual result{ value };
+                for( std::size_t i = 0; i < ParameterOptimizer::PARAMETER_COUNT; ++i )
+                {
+                    result.gradient[i] = x.gradient[i] * value;
+                }
+                return result;
+            }
+
+            Dual log(const Dual& x)
+            {
+                const double inverse = 1.0 / x.value;
+                Dual result{ std::log(x.value) };
+                for( std::size_t i = 0; i < ParameterOptimizer::PARAMETER_COUNT; ++i )
+                {
+                    result.gradient[i] = x.gradient[i] * inverse;
+                }
+                return result;
+            }
+
+            Dual reciprocal(const Dual& x)
+            {
+                const double inverse = 1.0 / x.value;
+                Dual result{ inverse };
+                for( std::size_t i = 0; i < ParameterOptimizer::PARAMETER_COUNT; ++i )
+                {
+                    result.gradient[i] = -x.gradient[i] * inverse * inverse;
+                }
+                return result;
+            }
+
+            bool isOrdered(const ReviewRecord& lhs, const ReviewRecord& rhs)
+            {
+                return lhs.wordId != rhs.wordId ? lhs.wordId < rhs.wordId : lhs.timestamp < rhs.timestamp;
+            }
+
+            std::vector<std::size_t> findWordStarts(const std::vector<ReviewRecord>& reviews)
+            {
+                std::vector<std::size_t> wordStarts;
+                for( std::size_t index = 0; index < reviews.size(); ++index )
+                {
+                    if( index == 0 || reviews[index].wordId != reviews[index - 1].wordId )
+                    {
+                        wordStarts.push_back(index);
+                    }
+                }
+                wordStarts.push_back(reviews.size());
+                return wordStarts;
+            }
+        }
+
+        ParameterOptimizer::ParameterOptimizer(unsigned int threadCount) : m_threadCount(threadCount)
+        {
+        }
+
+        OptimizationResult ParameterOptimizer::fit(const std::vector<ReviewRecord>& reviews, const MemoryModelParameters& initial,
+            const OptimizerOptions& options, const ProgressCallback& progress, const std::atomic<bool>* cancel) const
+        {
+            std::vector<ReviewRecord> sortedReviews;
+            const bool ordered = std::is_sorted(reviews.begin(), reviews.end(), isOrdered);
+            if( !ordered )
+            {
+                sortedReviews = reviews;
+                std::stable_sort(sortedReviews.begin(), sortedReviews.end(), isOrdered);
+            }
+            const std::vector<ReviewRecord>& history = ordered ? reviews : sortedReviews;
+            const std::vector<std::size_t> wordStarts = findWordStarts(history);
+
+            OptimizationResult result;
+            result.parameters = initial;
+
+            Parameters parameters = clampToRanges(toArray(initial));
+            Parameters firstMoment{};
+            Parameters secondMoment{};
+
+            Evaluation evaluation = evaluate(history, wordStarts, parameters);
+            result.predictions = evaluation.predictions;
+            if( evaluation.predictions == 0 )
+            {
+                return result;
+            }
+
+            const double count = static_cast<double>(evaluation.predictions);
+            result.initialLoss = evaluation.loss / count;
+            result.finalLoss = result.initialLoss;
+
+            Parameters best = parameters;
+            double previousLoss = result.initialLoss;
+            const int iterations = std::max(1, options.iterations);
+
+            for( int iteration = 1; iteration <= iterations; ++iteration )
+            {
+                if( cancel && cancel->load() )
+                {
+                    result.cancelled = true;
+                    break;
+                }
+
+                const double correction1 = 1.0 - std::pow(ADAM_BETA1, iteration);
+                const double correction2 = 1.0 - std::pow(ADAM_BETA2, iteration);
+                for( std::size_t i = 0; i < PARAMETER_COUNT; ++i )
+                {
+                    const double gradient = evaluation.gradient[i] / count;
+                    firstMoment[i] = ADAM_BETA1 * firstMoment[i] + (1.0 - ADAM_BETA1) * gradient;
+                    secondMoment[i] = ADAM_BETA2 * secondMoment[i] + (1.0 - ADAM_BETA2) * gradient * gradient;
+
+                    const double step = (firstMoment[i] / correction1) / (std::sqrt(secondMoment[i] / correction2) + ADAM_EPSILON);
+                    parameters[i] -= options.learningRate * PARAMETER_RANGES[i].scale * step;
+                }
+                parameters = clampToRanges(parameters);
+
+                evaluation = evaluate(history, wordStarts, parameters);
+                const double currentLoss = evaluation.loss / count;
+                result.iterations = iteration;
+
+                if( currentLoss < result.finalLoss )
+                {
+                    result.finalLoss = currentLoss;
+                    best = parameters;
+                }
+
+                if( progress )
+                {
+                    progress(static_cast<float>(iteration) / static_cast<float>(iterations), result.finalLoss);
+                }
+
+                if( std::abs(previousLoss - currentLoss) < options.tolerance )
+                {
+                    break;
+                }
+                previousLoss = currentLoss;
+            }
+
+            result.parameters = fromArray(best, initial);
+            return result;
+        }
+
+        double ParameterOptimizer::loss(const std::vector<ReviewRecord>& reviews, const MemoryModelParameters& parameters) const
+        {
+            std::vector<ReviewRecord> history = reviews;
+            std::stable_sort(history.begin(), history.end(), isOrdered);
+
+            const Evaluation evaluation = evaluate(history, findWordStarts(history), toArray(parameters));
+            return evaluation.predictions > 0 ? evaluation.loss / static_cast<double>(evaluation.predictions) : 0.0;
+        }
+
+        ParameterOptimizer::Evaluation ParameterOptimizer::evaluate(const std::vector<ReviewRecord>& reviews,
+            const std::vector<std::size_t>& wordStarts, const Parameters& parameters) const
+        {
+            const std::size_t wordCount = wordStarts.size() - 1;
+
+            unsigned int threadCount = m_threadCount != 0 ? m_threadCount : std::max(1u, std::thread::hardware_concurrency());
+            threadCount = static_cast<unsigned int>(std::clamp<std::size_t>(reviews.size() / MIN_REVIEWS_PER_THREAD, 1, threadCount));
+
+            std::vector<Evaluation> evaluations(threadCount);
+            if( threadCount == 1 )
+            {
+                evaluateRange(reviews, wordStarts, parameters, 0, wordCount, evaluations.front());
+            }
+            else
+            {
+                // Split words so that every thread replays roughly the same number of reviews
+                std::vector<std::thread> workers;
+                std::size_t begin = 0;
+                for( unsigned int index = 0; index < threadCount; ++index )
+                {
+                    const std::size_t target = reviews.size() * (index + 1) / threadCount;
+                    const std::size_t end = index + 1 == threadCount ? wordCount
+                        : static_cast<std::size_t>(std::lower_bound(wordStarts.begin(), wordStarts.end() - 1, target) - wordStarts.begin());
+
+                    workers.emplace_back(&ParameterOptimizer::evaluateRange, this, std::cref(reviews), std::cref(wordStarts), std::cref(parameters),
+                        begin, std::max(begin, end), std::ref(evaluations[index]));
+                    begin = std::max(begin, end);
+                }
+
+                for( auto& worker : workers )
+                {
+                    worker.join();
+                }
+            }
+
+            Evaluation total;
+            for( const auto& evaluation : evaluations )
+            {
+                total.loss += evaluation.loss;
+                total.predictions += evaluation.predictions;
+                for( std::size_t i = 0; i < PARAMETER_COUNT; ++i )
+                {
+                    total.gradient[i] += evaluation.gradient[i];
+                }
+            }
+            return total;
+        }
+
+        void ParameterOptimizer::evaluateRange(const std::vector<ReviewRecord>& reviews, const std::vector<std::size_t>& wordStarts,
+            const Parameters& parameters, std::size_t begin, std::size_t end, Evaluation& evaluation) const
+        {
+            const Dual initialStability = variable(parameters[0], 0);
+            const Dual growthRate = variable(parameters[1], 1);
+            const Dual stabilityDecay = variable(parameters[2], 2);
+            const Dual retrievabilityGain = variable(parameters[3], 3);
+            const Dual lapseFactor = variable(parameters[4], 4);
+
+            for( std::size_t word = begin; word < end; ++word )
+            {
+                // Replays MemoryModel::applyReview while tracking derivatives of the stability
+                const ReviewRecord& first = reviews[wordStarts[word]];
+                Dual stability = first.correct ? initialStability : initialStability * lapseFactor;
+                double difficulty = first.correct ? MemoryModel::INITIAL_DIFFICULTY : MemoryModel::INITIAL_DIFFICULTY + MemoryModel::DIFFICULTY_STEP_UP;
+                if( stability.value < MemoryModel::MIN_STABILITY )
+                {
+                    stability = constant(MemoryModel::MIN_STABILITY);
+                }
+                int64_t lastReview = first.timestamp;
+
+                for( std::size_t index = wordStarts[word] + 1; index < wordStarts[word + 1]; ++index )
+                {
+                    const ReviewRecord& record = reviews[index];
+                    const double elapsedDays = std::max(0.0, static_cast<double>(record.timestamp - lastReview) / MemoryModel::SECONDS_PER_DAY);
+
+                    const Dual recall = exp(reciprocal(stability) * (MemoryModel::LOG_BASE_RETENTION * elapsedDays));
+                    const double probability = std::clamp(recall.value, PROBABILITY_EPSILON, 1.0 - PROBABILITY_EPSILON);
+                    const double lossDerivative = record.correct ? -1.0 / probability : 1.0 / (1.0 - probability);
+
+                    evaluation.loss -= record.correct ? std::log(probability) : std::log(1.0 - probability);
+                    evaluation.predictions++;
+                    // A clamped probability does not move with the parameters, so neither does its loss
+                    if( probability == recall.value )
+                    {
+                        for( std::size_t i = 0; i < PARAMETER_COUNT; ++i )
+                        {
+                            evaluation.gradient[i] += lossDerivative * recall.gradient[i];
+                        }
+                    }
+
+                    if( record.correct )
+                    {
+                        const double difficultyFactor = (MemoryModel::MAX_DIFFICULTY + 1.0 - difficulty) / MemoryModel::MAX_DIFFICULTY;
+                        const Dual growth = growthRate * difficultyFactor
+                            * exp(stabilityDecay * log(stability) * -1.0)
+                            * exp(retrievabilityGain * (1.0 - recall));
+
+                        if( growth.value > 0.0 )
+                        {
+                            stability = stability * (growth + 1.0);
+                        }
+                        difficulty = std::max(MemoryModel::MIN_DIFFICULTY, difficulty - MemoryModel::DIFFICULTY_STEP_DOWN);
+                    }
+                    else
+                    {
+                        stability = stability * lapseFactor;
+                        difficulty = std::min(MemoryModel::MAX_DIFFICULTY, difficulty + MemoryModel::DIFFICULTY_STEP_UP);
+                    }
+
+                    if( stability.value < MemoryModel::MIN_STABILITY )
+                    {
+                        stability = constant(MemoryModel::MIN_STABILITY);
+                    }
+                    lastReview = record.timestamp;
+                }
+            }
+        }
+    }
+}
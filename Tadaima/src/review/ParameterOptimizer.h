@@ -0,0 +1,124 @@
+/**
+ * @file ParameterOptimizer.h
+ * @brief Declares the ParameterOptimizer class which fits memory model parameters to the review history.
+ */
+
+#pragma once
+
+#include "MemoryModel.h"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace tadaima
+{
+    namespace review
+    {
+        /**
+         * @brief Options of the parameter fitting.
+         */
+        struct OptimizerOptions
+        {
+            int iterations = 150;           /**< Maximum number of gradient descent iterations. */
+            double learningRate = 0.05;     /**< Step size, relative to the scale of each parameter. */
+            double tolerance = 1e-7;        /**< Fitting stops once the loss improves by less than this. */
+        };
+
+        /**
+         * @brief Result of the parameter fitting.
+         */
+        struct OptimizationResult
+        {
+            MemoryModelParameters parameters;   /**< The fitted parameters. */
+            double initialLoss = 0.0;           /**< Mean log loss of the initial parameters. */
+            double finalLoss = 0.0;             /**< Mean log loss of the fitted parameters. */
+            std::size_t predictions = 0;        /**< Number of reviews the loss was evaluated on. */
+            int iterations = 0;                 /**< Number of performed iterations. */
+            bool cancelled = false;             /**< True if the fitting was cancelled. */
+        };
+
+        /**
+         * @brief The ParameterOptimizer class fits MemoryModelParameters to recorded reviews.
+         *
+         * The review history of every word is replayed through the memory model and the recall probability
+         * predicted before each review is scored against its outcome with log loss. Derivatives with respect
+         * to all parameters are carried along the replay, so a single pass over the history yields the loss
+         * and its full gradient. Words are split across worker threads and the parameters are updated with Adam.
+         */
+        class ParameterOptimizer
+        {
+        public:
+            static constexpr std::size_t PARAMETER_COUNT = 5; /**< Number of fitted parameters. */
+
+            /**
+             * @brief Callback reporting progress in range [0, 1] and the current loss.
+             */
+            using ProgressCallback = std::function<void(float progress, double loss)>;
+
+            /**
+             * @brief Constructs a ParameterOptimizer object.
+             * @param threadCount Number of worker threads, 0 uses all available hardware threads.
+             */
+            explicit ParameterOptimizer(unsigned int threadCount = 0);
+
+            /**
+             * @brief Fits the memory model parameters to the given reviews.
+             * @param reviews The review history, preferably ordered by word and time.
+             * @param initial The parameters the fitting starts from. The desired retention is kept as is.
+             * @param options The options of the fitting.
+             * @param progress Optional callback invoked after every iteration.
+             * @param cancel Optional flag which stops the fitting when set.
+             * @return The result of the fitting.
+             */
+            OptimizationResult fit(const std::vector<ReviewRecord>& reviews, const MemoryModelParameters& initial,
+                const OptimizerOptions& options = OptimizerOptions(), const ProgressCallback& progress = nullptr,
+                const std::atomic<bool>* cancel = nullptr) const;
+
+            /**
+             * @brief Calculates the mean log loss of the parameters on the given reviews.
+             * @param reviews The review history, preferably ordered by word and time.
+             * @param parameters The parameters to evaluate.
+             * @return The mean log loss, or 0 if there is nothing to predict.
+             */
+            double loss(const std::vector<ReviewRecord>& reviews, const MemoryModelParameters& parameters) const;
+
+        private:
+
+            /**
+             * @brief Sum of the log loss and its gradient over a range of words.
+             */
+            struct Evaluation
+            {
+                double loss = 0.0;                                  /**< Sum of the log loss. */
+                std::array<double, PARAMETER_COUNT> gradient{};     /**< Sum of the gradient of the log loss. */
+                std::size_t predictions = 0;                        /**< Number of scored reviews. */
+            };
+
+            /**
+             * @brief Evaluates the loss and gradient over all words using the worker threads.
+             * @param reviews The review history ordered by word and time.
+             * @param wordStarts Indices of the first review of each word, terminated by the number of reviews.
+             * @param parameters The parameters to evaluate.
+             * @return The summed evaluation.
+             */
+            Evaluation evaluate(const std::vector<ReviewRecord>& reviews, const std::vector<std::size_t>& wordStarts,
+                const std::array<double, PARAMETER_COUNT>& parameters) const;
+
+            /**
+             * @brief Evaluates the loss and gradient of the words in range [begin, end).
+             * @param reviews The review history ordered by word and time.
+             * @param wordStarts Indices of the first review of each word, terminated by the number of reviews.
+             * @param parameters The parameters to evaluate.
+             * @param begin Index of the first evaluated word.
+             * @param end Index past the last evaluated word.
+             * @param evaluation Evaluation to add the results to.
+             */
+            void evaluateRange(const std::vector<ReviewRecord>& reviews, const std::vector<std::size_t>& wordStarts,
+                const std::array<double, PARAMETER_COUNT>& parameters, std::size_t begin, std::size_t end, Evaluation& evaluation) const;
+
+            unsigned int m_threadCount; /**< Number of worker threads. */
+        };
+    }
+}
@@ -0,0 +1,190 @@
+#include "RetentionForecaster.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <thread>
+
+namespace tadaima
+{
+    namespace review
+    {
+        namespace
+        {
+            constexpr size_t MIN_WORDS_PER_THREAD = 256;
+            constexpr double LOW_PERCENTILE = 0.1;
+            constexpr double HIGH_PERCENTILE = 0.9;
+
+            /**
+             * @brief SplitMix64 generator, cheap enough to be seeded for every simulated trajectory.
+             */
+            class SplitMix64
+            {
+            public:
+                explicit SplitMix64(uint64_t seed) : m_state(seed) {}
+
+                uint64_t next()
+                {
+                    uint64_t z = (m_state += 0x9E3779B97F4A7C15ull);
+                    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+                    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+                    return z ^ (z >> 31);
+                }
+
+                double uniform()
+                {
+                    return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+                }
+
+            private:
+                uint64_t m_state;
+            };
+
+            float percentile(std::vector<uint32_t>& values, double fraction)
+            {
+                const size_t index = static_cast<size_t>(std::lround(fraction * static_cast<double>(values.size() - 1)));
+                std::nth_element(values.begin(), values.begin() + index, values.end());
+                return static_cast<float>(values[index]);
+            }
+        }
+
+        RetentionForecaster::RetentionForecaster(const MemoryModel& model, unsigned int threadCount)
+            : m_model(model), m_threadCount(threadCount)
+        {
+        }
+
+        Forecast RetentionForecaster::forecast(const std::vector<MemoryState>& states, int64_t now, const ForecastOptions& options) const
+        {
+            Forecast result;
+            if( options.days <= 0 || options.trajectories <= 0 )
+            {
+                return result;
+            }
+
+            const size_t days = static_cast<size_t>(options.days);
+            const size_t trajectories = static_cast<size_t>(options.trajectories);
+            const size_t newWords = options.newWordsPerDay > 0 ? static_cast<size_t>(std::clamp(options.newWords, 0, options.newWordsPerDay * options.days)) : 0;
+            const size_t totalWords = states.size() + newWords;
+            const uint64_t seed = options.seed != 0 ? options.seed : (static_cast<uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+
+            unsigned int threadCount = m_threadCount != 0 ? m_threadCount : std::max(1u, std::thread::hardware_concurrency());
+            threadCount = static_cast<unsigned int>(std::clamp<size_t>(totalWords / MIN_WORDS_PER_THREAD, 1, threadCount));
+
+            std::vector<Accumulator> accumulators(threadCount);
+            for( auto& accumulator : accumulators )
+            {
+                accumulator.reviews.assign(trajectories * days, 0);
+                accumulator.retention.assign(days, 0.0);
+            }
+
+            const size_t chunk = (totalWords + threadCount - 1) / threadCount;
+            if( threadCount == 1 )
+            {
+                simulateRange(states, now, options, seed, 0, totalWords, accumulators.front());
+            }
+            else
+            {
+                std::vector<std::thread> workers;
+                for( unsigned int index = 0; index < threadCount; ++index )
+                {
+                    const size_t begin = std::min(totalWords, index * chunk);
+                    const size_t end = std::min(totalWords, begin + chunk);
+                    workers.emplace_back(&RetentionForecaster::simulateRange, this, std::cref(states), now, std::cref(options), seed, begin, end, std::ref(accumulators[index]));
+                }
+
+                for( auto& worker : workers )
+                {
+                    worker.join();
+                }
+            }
+
+            // Merge the per-thread sums
+            std::vector<uint32_t> reviews(trajectories * days, 0);
+            std::vector<double> retention(days, 0.0);
+            for( const auto& accumulator : accumulators )
+            {
+                std::transform(reviews.begin(), reviews.end(), accumulator.reviews.begin(), reviews.begin(), std::plus<uint32_t>());
+                std::transform(retention.begin(), retention.end(), accumulator.retention.begin(), retention.begin(), std::plus<double>());
+            }
+
+            result.expectedReviews.resize(days);
+            result.reviewsLow.resize(days);
+            result.reviewsHigh.resize(days);
+            result.expectedRetention.resize(days);
+
+            std::vector<uint32_t> dayReviews(trajectories);
+            for( size_t day = 0; day < days; ++day )
+            {
+                uint64_t sum = 0;
+                for( size_t trajectory = 0; trajectory < trajectories; ++trajectory )
+                {
+                    dayReviews[trajectory] = reviews[trajectory * days + day];
+                    sum += dayReviews[trajectory];
+                }
+
+                result.expectedReviews[day] = static_cast<float>(static_cast<double>(sum) / trajectories);
+                result.reviewsLow[day] = percentile(dayReviews, LOW_PERCENTILE);
+                result.reviewsHigh[day] = percentile(dayReviews, HIGH_PERCENTILE);
+
+                const size_t introduced = newWords > 0 ? std::min(newWords, (day + 1) * static_cast<size_t>(options.newWordsPerDay)) : 0;
+                const size_t studiedWords = states.size() + introduced;
+                result.expectedRetention[day] = studiedWords > 0 ? static_cast<float>(retention[day] / static_cast<double>(trajectories * studiedWords)) : 0.0f;
+            }
+
+            return result;
+        }
+
+        void RetentionForecaster::simulateRange(const std::vector<MemoryState>& states, int64_t now, const ForecastOptions& options,
+            uint64_t seed, size_t begin, size_t end, Accumulator& accumulator) const
+        {
+            const int days = options.days;
+
+            for( size_t index = begin; index < end; ++index )
+            {
+                const bool isNewWord = index >= states.size();
+                const MemoryState initialState = isNewWord ? MemoryState() : states[index];
+                const int firstDay = isNewWord ? static_cast<int>((index - states.size()) / options.newWordsPerDay) : 0;
+                const double initialLastReview = isNewWord ? 0.0 : static_cast<double>(initialState.lastReview - now) / MemoryModel::SECONDS_PER_DAY;
+
+                for( int trajectory = 0; trajectory < options.trajectories; ++trajectory )
+                {
+                    SplitMix64 rng(seed ^ (static_cast<uint64_t>(index) * static_cast<uint64_t>(options.trajectories) + trajectory + 1) * 0xD1B54A32D192ED03ull);
+                    MemoryState state = initialState;
+                    double lastReview = initialLastReview;
+                    int due = firstDay;
+                    double recall = 0.0;
+                    double dailyDecay = 1.0;
+
+                    if( !isNewWord )
+                    {
+                        due = std::max(0, static_cast<int>(std::ceil(lastReview + m_model.nextInterval(state))));
+                        dailyDecay = m_model.retrievability(state, 1.0);
+                        recall = m_model.retrievability(state, 1.0 - lastReview);
+                    }
+
+                    uint32_t* reviews = &accumulator.reviews[static_cast<size_t>(trajectory) * days];
+                    for( int day = firstDay; day < days; ++day )
+                    {
+                        if( day == due )
+                        {
+                            // A new word is studied on the day it is introduced, later reviews may fail
+                            const double elapsedDays = day - lastReview;
+                            const bool correct = state.reviewCount == 0 || rng.uniform() < m_model.retrievability(state, elapsedDays);
+                            m_model.applyReview(state, correct, elapsedDays);
+
+                            lastReview = day;
+                            due = day + std::max(1, static_cast<int>(std::lround(m_model.nextInterval(state))));
+                            dailyDecay = m_model.retrievability(state, 1.0);
+                            recall = dailyDecay;
+                            reviews[day]++;
+                        }
+
+                        // Recall probability decays geometrically between reviews, so no exp() is needed per day
+                        accumulator.retention[day] += recall;
+                        recall *= dailyDecay;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/**
+ * @file RetentionForecaster.h
+ * @brief Declares the RetentionForecaster class which predicts future review workload and retention.
+ */
+
+#pragma once
+
+#include "MemoryModel.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace tadaima
+{
+    namespace review
+    {
+        /**
+         * @brief Options of a single forecast.
+         */
+        struct ForecastOptions
+        {
+            int days = 30;              /**< Number of days to simulate. */
+            int trajectories = 64;      /**< Number of randomized trajectories simulated for each word. */
+            int newWords = 0;           /**< Number of not yet studied words added to the library. */
+            int newWordsPerDay = 20;    /**< Number of new words introduced per day. */
+            uint64_t seed = 0;          /**< Seed of the simulation, 0 picks a random one. */
+        };
+
+        /**
+         * @brief Result of a forecast, every vector holds one value per simulated day.
+         */
+        struct Forecast
+        {
+            std::vector<float> expectedReviews;     /**< Mean number of reviews per day. */
+            std::vector<float> reviewsLow;          /**< 10th percentile of reviews per day across trajectories. */
+            std::vector<float> reviewsHigh;         /**< 90th percentile of reviews per day across trajectories. */
+            std::vector<float> expectedRetention;   /**< Mean recall probability of the studied words at the end of each day. */
+        };
+
+        /**
+         * @brief The RetentionForecaster class runs Monte Carlo simulations of future reviews.
+         *
+         * Every word is simulated independently with its own random stream, so the words are split
+         * between worker threads and the result does not depend on the number of threads.
+         */
+        class RetentionForecaster
+        {
+        public:
+            /**
+             * @brief Constructs a RetentionForecaster object.
+             * @param model The memory model used to simulate reviews.
+             * @param threadCount Number of worker threads, 0 uses all available cores.
+             */
+            RetentionForecaster(const MemoryModel& model, unsigned int threadCount = 0);
+
+            /**
+             * @brief Simulates future reviews of the given words.
+             * @param states Memory states of the already studied words.
+             * @param now Unix time (in seconds) at which the simulation starts.
+             * @param options Options of the forecast.
+             * @return The forecast.
+             */
+            Forecast forecast(const std::vector<MemoryState>& states, int64_t now, const ForecastOptions& options) const;
+
+        private:
+            /**
+             * @brief Per-thread sums of the simulation.
+             */
+            struct Accumulator
+            {
+                std::vector<uint32_t> reviews;  /**< Reviews per trajectory and day, indexed by trajectory * days + day. */
+                std::vector<double> retention;  /**< Sum of recall probabilities per day. */
+            };
+
+            /**
+             * @brief Simulates all trajectories of the words in range [begin, end).
+             * @param states Memory states of the already studied words.
+             * @param now Unix time (in seconds) at which the simulation starts.
+             * @param options Options of the forecast.
+             * @param seed Seed of the simulation.
+             * @param begin Index of the first simulated word.
+             * @param end Index past the last simulated word.
+             * @param accumulator The accumulator to add the results to.
+             */
+            void simulateRange(const std::vector<MemoryState>& states, int64_t now, const ForecastOptions& options,
+                uint64_t seed, std::size_t begin, std::size_t end, Accumulator& accumulator) const;
+
+            MemoryModel m_model; /**< The memory model used to simulate reviews. */
+            unsigned int m_threadCount; /**< Number of worker threads. */
+        };
+    }
+}
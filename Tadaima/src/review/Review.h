@@ -0,0 +1,49 @@
+/**
+ * @file Review.h
+ * @brief Defines the ReviewRecord, MemoryState and Confusion structs used to track how well words are remembered.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace tadaima
+{
+    namespace review
+    {
+        /**
+         * @brief Struct representing a single answer given for a word during a quiz.
+         */
+        struct ReviewRecord
+        {
+            int wordId = -1; /**< The ID of the reviewed word. */
+            int64_t timestamp = 0; /**< Unix time (in seconds) of the review. */
+            bool correct = false; /**< True if the word was recalled correctly. */
+            int chosenWordId = -1; /**< The ID of the word whose answer was picked instead, or -1 if unknown. */
+        };
+
+        /**
+         * @brief Struct representing the memory model state of a single word.
+         */
+        struct MemoryState
+        {
+            int wordId = -1; /**< The ID of the word. */
+            double stability = 0.0; /**< Number of days after which recall probability drops to 90%. */
+            double difficulty = 0.0; /**< Difficulty of the word in range [1, 10]. */
+            int64_t lastReview = 0; /**< Unix time (in seconds) of the last review. */
+            int reviewCount = 0; /**< Number of reviews of the word. */
+            int lapses = 0; /**< Number of failed reviews of the word. */
+        };
+
+        /**
+         * @brief Struct representing how often the answer of one word was picked when another word was asked.
+         */
+        struct Confusion
+        {
+            int targetId = -1; /**< The ID of the asked word. */
+            int chosenId = -1; /**< The ID of the word whose answer was picked. */
+            int count = 0; /**< Number of times the answer was picked. */
+            int64_t lastSeen = 0; /**< Unix time (in seconds) of the last pick. */
+        };
+    }
+}
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include "AllocationTracker.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <new>
+
+namespace tadaima
+{
+    namespace
+    {
+        constexpr std::size_t MAX_SCOPE_DEPTH = 32;
+
+        /**
+         * @brief Counters of a tag. Constant-initialized, so they are usable by allocations made before main.
+         */
+        struct Counters
+        {
+            std::atomic<uint64_t> allocations;
+            std::atomic<uint64_t> bytes;
+            std::atomic<uint64_t> frees;
+            std::atomic<uint64_t> freedBytes;
+        };
+
+        std::array<Counters, AllocationTracker::TAG_COUNT> g_counters;
+
+        // Trivial thread-locals, so touching them never allocates.
+        thread_local AllocationTag t_scopes[MAX_SCOPE_DEPTH];
+        thread_local std::size_t t_depth = 0;
+
+        constexpr const char* TAG_NAMES[AllocationTracker::TAG_COUNT] = { "Untagged", "Database", "Packages", "GUI", "Quiz", "Dictionary" };
+    }
+
+    AllocationTag AllocationTracker::currentTag()
+    {
+        return t_depth == 0 ? AllocationTag::Untagged : t_scopes[std::min(t_depth, MAX_SCOPE_DEPTH) - 1];
+    }
+
+    void AllocationTracker::recordAllocation(AllocationTag tag, std::size_t size)
+    {
+        Counters& counters = g_counters[static_cast<std::size_t>(tag)];
+        counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        counters.bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    void AllocationTracker::recordFree(AllocationTag tag, std::size_t size)
+    {
+        Counters& counters = g_counters[static_cast<std::size_t>(tag)];
+        counters.frees.fetch_add(1, std::memory_order_relaxed);
+        counters.freedBytes.fetch_add(size, std::memory_order_relaxed);
+    }
+
+    AllocationStats AllocationTracker::stats(AllocationTag tag)
+    {
+        const Counters& counters = g_counters[static_cast<std::size_t>(tag)];
+        AllocationStats stats;
+        stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+        stats.bytes = counters.bytes.load(std::memory_order_relaxed);
+        stats.frees = counters.frees.load(std::memory_order_relaxed);
+        stats.freedBytes = counters.freedBytes.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    AllocationStats AllocationTracker::total()
+    {
+        AllocationStats total;
+        for( std::size_t index = 0; index < TAG_COUNT; ++index )
+        {
+            const AllocationStats tagStats = stats(static_cast<AllocationTag>(index));
+            total.allocations += tagStats.allocations;
+            total.bytes += tagStats.bytes;
+            total.frees += tagStats.frees;
+            total.freedBytes += tagStats.freedBytes;
+        }
+        return total;
+    }
+
+    void AllocationTracker::reset()
+    {
+        for( auto& counters : g_counters )
+        {
+            counters.allocations = 0;
+            counters.bytes = 0;
+            counters.frees = 0;
+            counters.freedBytes = 0;
+        }
+    }
+
+    const char* AllocationTracker::tagName(AllocationTag tag)
+    {
+        const std::size_t index = static_cast<std::size_t>(tag);
+        return index < TAG_COUNT ? TAG_NAMES[index] : "Unknown";
+    }
+
+    std::string AllocationTracker::report()
+    {
+        std::string report = std::format("{:<12}{:>14}{:>16}{:>16}\n", "Tag", "Allocations", "Bytes", "Live bytes");
+        for( std::size_t index = 0; index < TAG_COUNT; ++index )
+        {
+            const AllocationStats tagStats = stats(static_cast<AllocationTag>(index));
+            report += std::format("{:<12}{:>14}{:>16}{:>16}\n", tagName(static_cast<AllocationTag>(index)), tagStats.allocations, tagStats.bytes,
+                static_cast<int64_t>(tagStats.liveBytes()));
+        }
+        return report;
+    }
+
+    AllocationScope::AllocationScope(AllocationTag tag)
+    {
+        if( t_depth < MAX_SCOPE_DEPTH )
+        {
+            t_scopes[t_depth] = tag;
+        }
+        t_depth++;
+    }
+
+    AllocationScope::~AllocationScope()
+    {
+        t_depth--;
+    }
+}
+
+#ifdef TADAIMA_TRACK_ALLOCATIONS
+
+namespace
+{
+    /**
+     * @brief Header stored in front of every tracked allocation, it keeps the default alignment of the returned memory.
+     */
+    struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) BlockHeader
+    {
+        void* block;
+        std::size_t size;
+        tadaima::AllocationTag tag;
+    };
+
+    void* trackedAllocate(std::size_t size, std::size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__) noexcept
+    {
+        // Over-aligned memory is found by padding the block, the header then sits right in front of the aligned address
+        const std::size_t padding = alignment > alignof(BlockHeader) ? alignment : 0;
+        void* block = std::malloc(sizeof(BlockHeader) + padding + size);
+        if( nullptr == block )
+        {
+            return nullptr;
+        }
+        const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(block) + sizeof(BlockHeader);
+        const std::uintptr_t aligned = padding > 0 ? (first + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1) : first;
+        BlockHeader* header = reinterpret_cast<BlockHeader*>(aligned) - 1;
+        header->block = block;
+        header->size = size;
+        header->tag = tadaima::AllocationTracker::currentTag();
+        tadaima::AllocationTracker::recordAllocation(header->tag, size);
+        return header + 1;
+    }
+
+    void trackedFree(void* memory) noexcept
+    {
+        if( nullptr == memory )
+        {
+            return;
+        }
+        BlockHeader* header = static_cast<BlockHeader*>(memory) - 1;
+        tadaima::AllocationTracker::recordFree(header->tag, header->size);
+        std::free(header->block);
+    }
+
+    void* trackedAllocateOrThrow(std::size_t size, std::size_t alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+    {
+        void* memory = trackedAllocate(size, alignment);
+        while( nullptr == memory )
+        {
+            std::new_handler handler = std::get_new_handler();
+            if( nullptr == handler )
+            {
+                throw std::bad_alloc();
+            }
+            handler();
+            memory = trackedAllocate(size, alignment);
+        }
+        return memory;
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    return trackedAllocateOrThrow(size);
+}
+
+void* operator new[](std::size_t size)
+{
+    return trackedAllocateOrThrow(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return trackedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return trackedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    trackedFree(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    trackedFree(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    trackedFree(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    trackedFree(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    trackedFree(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    trackedFree(memory);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    return trackedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return trackedAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return trackedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+    return trackedAllocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+    trackedFree(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept
+{
+    trackedFree(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+    trackedFree(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept
+{
+    trackedFree(memory);
+}
+
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    trackedFree(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept
+{
+    trackedFree(memory);
+}
+
+#endif
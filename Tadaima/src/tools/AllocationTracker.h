@@ -0,0 +1,142 @@
+/**
+ * @file AllocationTracker.h
+ * @brief Declares the AllocationTracker class which counts heap allocations by subsystem.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace tadaima
+{
+    /**
+     * @brief Subsystems allocations are attributed to.
+     */
+    enum class AllocationTag : uint8_t
+    {
+        Untagged,   /**< Allocations outside of any tagged scope. */
+        Database,   /**< Queries and updates of the application database. */
+        Packages,   /**< Encoding and decoding of data packages. */
+        Gui,        /**< Drawing of the widgets. */
+        Quiz,       /**< Quiz engines and quiz widgets. */
+        Dictionary, /**< Dictionary lookups. */
+        Count       /**< Number of tags. */
+    };
+
+    /**
+     * @brief Allocation counters of a single tag.
+     */
+    struct AllocationStats
+    {
+        uint64_t allocations = 0;   /**< Number of allocations. */
+        uint64_t bytes = 0;         /**< Number of allocated bytes. */
+        uint64_t frees = 0;         /**< Number of freed allocations. */
+        uint64_t freedBytes = 0;    /**< Number of freed bytes. */
+
+        /**
+         * @brief Gets the number of bytes allocated and not freed yet.
+         * @return The number of bytes.
+         */
+        uint64_t liveBytes() const
+        {
+            return bytes - freedBytes;
+        }
+    };
+
+    /**
+     * @brief The AllocationTracker class collects allocation statistics per subsystem.
+     *
+     * The subsystem of an allocation is the innermost AllocationScope of the allocating thread. Frees are attributed to
+     * the tag the memory was allocated with, so live bytes of a tag reflect what it still holds. The global operator
+     * new and delete, including the aligned ones, are only replaced when TADAIMA_TRACK_ALLOCATIONS is defined, which the
+     * tests always do and the application only when built with TadaimaTrackAllocations=true or the CMake option of that
+     * name; otherwise the scopes cost a thread-local push and pop and all counters stay zero.
+     */
+    class AllocationTracker
+    {
+    public:
+#ifdef TADAIMA_TRACK_ALLOCATIONS
+        static constexpr bool ENABLED = true; /**< True if operator new and delete are tracked. */
+#else
+        static constexpr bool ENABLED = false; /**< True if operator new and delete are tracked. */
+#endif
+        static constexpr std::size_t TAG_COUNT = static_cast<std::size_t>(AllocationTag::Count); /**< Number of tags. */
+
+        /**
+         * @brief Gets the tag of the innermost scope of the calling thread.
+         * @return The current tag.
+         */
+        static AllocationTag currentTag();
+
+        /**
+         * @brief Records an allocation.
+         * @param tag The tag of the allocation.
+         * @param size Number of allocated bytes.
+         */
+        static void recordAllocation(AllocationTag tag, std::size_t size);
+
+        /**
+         * @brief Records a free.
+         * @param tag The tag the memory was allocated with.
+         * @param size Number of freed bytes.
+         */
+        static void recordFree(AllocationTag tag, std::size_t size);
+
+        /**
+         * @brief Gets the statistics of a tag.
+         * @param tag The tag.
+         * @return The statistics.
+         */
+        static AllocationStats stats(AllocationTag tag);
+
+        /**
+         * @brief Gets the statistics summed over all tags.
+         * @return The statistics.
+         */
+        static AllocationStats total();
+
+        /**
+         * @brief Clears all counters. Memory allocated before is then reported as negative live bytes once freed.
+         */
+        static void reset();
+
+        /**
+         * @brief Gets the name of a tag.
+         * @param tag The tag.
+         * @return The name.
+         */
+        static const char* tagName(AllocationTag tag);
+
+        /**
+         * @brief Formats the statistics of all tags as a table.
+         * @return The report.
+         */
+        static std::string report();
+    };
+
+    /**
+     * @brief The AllocationScope class attributes allocations of the current thread to a tag while it is alive.
+     *
+     * Scopes nest; the innermost one wins.
+     */
+    class AllocationScope
+    {
+    public:
+        /**
+         * @brief Pushes the tag onto the tag stack of the current thread.
+         * @param tag The tag.
+         */
+        explicit AllocationScope(AllocationTag tag);
+
+        /**
+         * @brief Pops the tag.
+         */
+        ~AllocationScope();
+
+        AllocationScope(const AllocationScope&) = delete;
+        AllocationScope& operator=(const AllocationScope&) = delete;
+    };
+}
@@ -0,0 +1,53 @@
+#include "BinaryBuffer.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace tadaima
+{
+    namespace binary
+    {
+        void appendNumber(std::string& buffer, uint32_t value)
+        {
+            buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+
+        void appendString(std::string& buffer, std::string_view text)
+        {
+            appendNumber(buffer, static_cast<uint32_t>(text.size()));
+            buffer += text;
+        }
+
+        Reader::Reader(std::string_view buffer)
+            : m_buffer(buffer)
+        {
+        }
+
+        uint32_t Reader::number()
+        {
+            uint32_t value;
+            std::memcpy(&value, take(sizeof(value)).data(), sizeof(value));
+            return value;
+        }
+
+        std::string Reader::string()
+        {
+            return std::string(take(number()));
+        }
+
+        std::string_view Reader::take(std::size_t size)
+        {
+            if( size > m_buffer.size() )
+            {
+                throw std::runtime_error("Binary buffer: truncated data.");
+            }
+            std::string_view result = m_buffer.substr(0, size);
+            m_buffer.remove_prefix(size);
+            return result;
+        }
+
+        bool Reader::atEnd() const
+        {
+            return m_buffer.empty();
+        }
+    }
+}
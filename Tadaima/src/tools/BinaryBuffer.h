@@ -0,0 +1,74 @@
+/**
+ * @file BinaryBuffer.h
+ * @brief Declares helpers which encode numbers and strings into compact binary buffers.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace tadaima
+{
+    namespace binary
+    {
+        /**
+         * @brief Appends a number to a buffer. Numbers are little-endian, as on all supported targets.
+         * @param buffer The buffer to append to.
+         * @param value The number to append.
+         */
+        void appendNumber(std::string& buffer, uint32_t value);
+
+        /**
+         * @brief Appends a length-prefixed string to a buffer.
+         * @param buffer The buffer to append to.
+         * @param text The string to append.
+         */
+        void appendString(std::string& buffer, std::string_view text);
+
+        /**
+         * @brief Reads numbers and strings from an encoded buffer.
+         *
+         * Reading past the end of the buffer throws std::runtime_error, so truncated data is never read as valid.
+         */
+        class Reader
+        {
+        public:
+            /**
+             * @brief Constructs a Reader object.
+             * @param buffer The buffer to read. It must outlive the reader.
+             */
+            explicit Reader(std::string_view buffer);
+
+            /**
+             * @brief Reads a number.
+             * @return The number.
+             */
+            uint32_t number();
+
+            /**
+             * @brief Reads a length-prefixed string.
+             * @return The string.
+             */
+            std::string string();
+
+            /**
+             * @brief Reads raw bytes.
+             * @param size Number of bytes to read.
+             * @return View of the bytes inside the buffer.
+             */
+            std::string_view take(std::size_t size);
+
+            /**
+             * @brief Checks if the whole buffer was read.
+             * @return True if no data is left, false otherwise.
+             */
+            bool atEnd() const;
+
+        private:
+            std::string_view m_buffer; /**< The data not read yet. */
+        };
+    }
+}
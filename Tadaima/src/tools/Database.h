@@ -6,6 +6,8 @@
 #pragma once
 
 #include "lessons/Lesson.h"
+#include "review/Review.h"
+#include <functional>
 #include <vector>
 #include <string>
 
@@ -36,11 +38,11 @@ namespace tadaima
         virtual int addLesson(const std::string& mainName, const std::string& subName) = 0;
 
         /**
-         * @brief Edits an existing lesson in the database.
+         * @brief Edits an existing lesson in the database, or stores it as a new lesson if it does not exist.
          * @param lesson The lesson to edit.
-         * @return True if the lesson was successfully edited, false otherwise.
+         * @return The ID of the stored lesson, or -1 on failure.
          */
-        virtual bool editLesson(const Lesson& lesson) = 0;
+        virtual int editLesson(const Lesson& lesson) = 0;
 
         /**
          * @brief Adds a word to a lesson in the database.
@@ -51,7 +53,7 @@ namespace tadaima
         virtual int addWord(int lessonId, const Word& word) = 0;
 
         /**
-         * @brief Adds a tag to a word in the database.
+         * @brief Adds a tag to a word in the database, unless the word already has it.
          * @param wordId The ID of the word.
          * @param tag The tag to add to the word.
          */
@@ -62,8 +64,9 @@ namespace tadaima
          * @param lessonId The ID of the lesson.
          * @param newMainName The new main name of the lesson.
          * @param newSubName The new sub name of the lesson.
+         * @return True if the lesson was updated, false otherwise.
          */
-        virtual void updateLesson(int lessonId, const std::string& newMainName, const std::string& newSubName) = 0;
+        virtual bool updateLesson(int lessonId, const std::string& newMainName, const std::string& newSubName) = 0;
 
         /**
          * @brief Updates an existing word in the database.
@@ -72,11 +75,19 @@ namespace tadaima
          */
         virtual void updateWord(int wordId, const Word& updatedWord) = 0;
 
+        /**
+         * @brief Updates the frequency ranks of many words.
+         * @param ranks Pairs of word ID and frequency rank.
+         * @return True if the ranks were stored in one transaction, false if it could not be started or committed.
+         */
+        virtual bool updateFrequencyRanks(const std::vector<std::pair<int, int>>& ranks) = 0;
+
         /**
          * @brief Deletes a lesson from the database.
          * @param lessonId The ID of the lesson to delete.
+         * @return True if the lesson was deleted, false otherwise.
          */
-        virtual void deleteLesson(int lessonId) = 0;
+        virtual bool deleteLesson(int lessonId) = 0;
 
         /**
          * @brief Deletes a word from the database.
@@ -84,6 +95,38 @@ namespace tadaima
          */
         virtual void deleteWord(int wordId) = 0;
 
+        /**
+         * @brief Moves words to another lesson with a single statement.
+         * @param wordIds IDs of the words to move.
+         * @param lessonId The ID of the target lesson.
+         * @return True if the words were moved, false otherwise.
+         */
+        virtual bool moveWords(const std::vector<int>& wordIds, int lessonId) = 0;
+
+        /**
+         * @brief Copies words and their tags to another lesson, one statement per table.
+         * @param wordIds IDs of the words to copy.
+         * @param lessonId The ID of the target lesson.
+         * @return True if the words were copied, false otherwise.
+         */
+        virtual bool copyWords(const std::vector<int>& wordIds, int lessonId) = 0;
+
+        /**
+         * @brief Deletes words with their tags, reviews, memory states and confusions, one statement per table.
+         * @param wordIds IDs of the words to delete.
+         * @return True if the words were deleted, false otherwise.
+         */
+        virtual bool deleteWords(const std::vector<int>& wordIds) = 0;
+
+        /**
+         * @brief Adds and removes tags of many words, one statement each.
+         * @param wordIds IDs of the words to retag.
+         * @param addedTags Tags added to every word which does not have them yet.
+         * @param removedTags Tags removed from every word.
+         * @return True if the tags were changed, false otherwise.
+         */
+        virtual bool retagWords(const std::vector<int>& wordIds, const std::vector<std::string>& addedTags, const std::vector<std::string>& removedTags) = 0;
+
         /**
          * @brief Retrieves the names of all lessons from the database.
          * @return A vector containing the names of all lessons.
@@ -97,12 +140,40 @@ namespace tadaima
          */
         virtual std::vector<Word> getWordsInLesson(int lessonId) const = 0;
 
+        /**
+         * @brief Retrieves the words with the given IDs.
+         * @param wordIds The IDs of the words, unknown IDs are skipped.
+         * @return A vector containing the found words in no particular order.
+         */
+        virtual std::vector<Word> getWords(const std::vector<int>& wordIds) const = 0;
+
         /**
          * @brief Retrieves all lessons from the database.
          * @return A vector containing all lessons.
          */
         virtual std::vector<Lesson> getAllLessons() const = 0;
 
+        /**
+         * @brief Retrieves the lessons with the given IDs.
+         * @param lessonIds The IDs of the lessons, unknown IDs are skipped.
+         * @return A vector containing the found lessons with their words, ordered by ID.
+         */
+        virtual std::vector<Lesson> getLessons(const std::vector<int>& lessonIds) const = 0;
+
+        /**
+         * @brief Retrieves the IDs of the lessons holding the given words.
+         * @param wordIds The IDs of the words, unknown IDs are skipped.
+         * @return A vector containing each lesson ID once.
+         */
+        virtual std::vector<int> getLessonIdsOfWords(const std::vector<int>& wordIds) const = 0;
+
+        /**
+         * @brief Visits words one at a time without loading the lessons into memory.
+         * @param lessonIds IDs of the lessons to visit, or empty to visit every lesson.
+         * @param visitor Called for every word with its lesson. The lesson's words are not loaded.
+         */
+        virtual void forEachWord(const std::vector<int>& lessonIds, const std::function<void(const Lesson&, const Word&)>& visitor) const = 0;
+
         /**
          * @brief Saves the application settings to the database.
          * @param settings The application settings to save.
@@ -114,5 +185,75 @@ namespace tadaima
          * @return The loaded application settings.
          */
         virtual application::ApplicationSettings loadSettings() = 0;
+
+        /**
+         * @brief Stores a review of a word in the database.
+         * @param record The review to store.
+         * @return True if the review was stored, false otherwise.
+         */
+        virtual bool addReview(const review::ReviewRecord& record) = 0;
+
+        /**
+         * @brief Retrieves the review history of the words in existing lessons, ordered by word and time.
+         * @return A vector containing all stored reviews.
+         */
+        virtual std::vector<review::ReviewRecord> getReviews() const = 0;
+
+        /**
+         * @brief Counts a wrong answer picked for a word, keeping only the most frequent confusions of the word.
+         * @param confusion The asked word, the word whose answer was picked and the time of the answer.
+         * @return True if the confusion was stored, false otherwise.
+         */
+        virtual bool addConfusion(const review::Confusion& confusion) = 0;
+
+        /**
+         * @brief Retrieves the stored confusions, most frequent first.
+         * @return A vector containing all stored confusions.
+         */
+        virtual std::vector<review::Confusion> getConfusions() const = 0;
+
+        /**
+         * @brief Saves the memory state of a word.
+         * @param state The memory state to save.
+         * @return True if the state was saved, false if the transaction could not be started or committed.
+         */
+        virtual bool saveMemoryState(const review::MemoryState& state) = 0;
+
+        /**
+         * @brief Saves the memory states of many words in a single transaction.
+         * @param states The memory states to save.
+         * @return True if the states were saved, false if the transaction could not be started or committed.
+         */
+        virtual bool saveMemoryStates(const std::vector<review::MemoryState>& states) = 0;
+
+        /**
+         * @brief Retrieves the memory state of a word.
+         * @param wordId The ID of the word.
+         * @return The memory state of the word, or an empty state if the word was never reviewed.
+         */
+        virtual review::MemoryState getMemoryState(int wordId) const = 0;
+
+        /**
+         * @brief Retrieves the memory states of all words in existing lessons which were reviewed at least once.
+         * @return A vector containing the memory states.
+         */
+        virtual std::vector<review::MemoryState> getMemoryStates() const = 0;
+
+        /**
+         * @brief Starts a transaction, or a nested one if a transaction is already open.
+         * @return True if the transaction was started, false otherwise.
+         */
+        virtual bool beginTransaction() = 0;
+
+        /**
+         * @brief Commits the innermost transaction. Nested transactions become part of the enclosing one.
+         * @return True if the transaction was committed, false otherwise.
+         */
+        virtual bool commitTransaction() = 0;
+
+        /**
+         * @brief Undoes the changes of the innermost transaction and ends it.
+         */
+        virtual void rollbackTransaction() = 0;
     };
 }
@@ -11,6 +11,7 @@
 #include <unordered_map>
 #include "tools/pugixml.hpp"
 #include "tools/SystemTools.h"
+#include "tools/AllocationTracker.h"
 #include "Lessons/Lesson.h"
 #include <filesystem>
 
@@ -44,6 +45,8 @@ namespace tadaima
          */
         Word getTranslation(const std::string& englishWord)
         {
+            tadaima::AllocationScope scope(tadaima::AllocationTag::Dictionary);
+
             // Translate the word and store it in the cache
             std::string xmlStr = translator.translate(englishWord);
             pugi::xml_document doc;
@@ -64,6 +67,11 @@ namespace tadaima
             word.translation = root.child("trs").child_value();
             word.romaji = root.child("romaji").child_value();
             word.kana = root.child("hiragana").child_value();
+            word.kanji = root.child("japanese").child_value();
+            if( word.kanji == word.kana )
+            {
+                word.kanji.clear(); // Written in kana only
+            }
             word.exampleSentence = ""; // This example doesn't provide sentences
             word.tags = {}; // This example doesn't provide tags
 
@@ -0,0 +1,424 @@
+﻿#include "JapaneseText.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace tadaima
+{
+    namespace
+    {
+        constexpr char32_t INVALID_CODE_POINT = 0xFFFD;
+        constexpr char32_t HALF_WIDTH_VOICED_MARK = 0xFF9E;
+        constexpr char32_t HALF_WIDTH_SEMI_VOICED_MARK = 0xFF9F;
+        constexpr char32_t COMBINING_VOICED_MARK = 0x3099;
+        constexpr char32_t COMBINING_SEMI_VOICED_MARK = 0x309A;
+        constexpr char32_t PROLONGED_SOUND_MARK = 0x30FC;
+        constexpr char32_t SMALL_TSU = 0x3063;
+        constexpr char32_t SYLLABIC_N = 0x3093;
+
+        // Hepburn consonants for the hiragana block U+3041 - U+3096, with を as "wo" like learners type it
+        constexpr std::array<std::string_view, 86> HIRAGANA_ROMAJI =
+        {
+            "a", "a", "i", "i", "u", "u", "e", "e", "o", "o",
+            "ka", "ga", "ki", "gi", "ku", "gu", "ke", "ge", "ko", "go",
+            "sa", "za", "shi", "ji", "su", "zu", "se", "ze", "so", "zo",
+            "ta", "da", "chi", "ji", "", "tsu", "zu", "te", "de", "to", "do",
+            "na", "ni", "nu", "ne", "no",
+            "ha", "ba", "pa", "hi", "bi", "pi", "fu", "bu", "pu", "he", "be", "pe", "ho", "bo", "po",
+            "ma", "mi", "mu", "me", "mo",
+            "ya", "ya", "yu", "yu", "yo", "yo",
+            "ra", "ri", "ru", "re", "ro",
+            "wa", "wa", "i", "e", "wo", "n", "vu", "ka", "ke"
+        };
+
+        // Full-width katakana (ヲ, ァ, ... ン) for the half-width block U+FF66 - U+FF9D
+        constexpr std::array<char16_t, 56> HALF_WIDTH_KATAKANA =
+        {
+            0x30F2, 0x30A1, 0x30A3, 0x30A5, 0x30A7, 0x30A9, 0x30E3, 0x30E5,
+            0x30E7, 0x30C3, 0x30FC, 0x30A2, 0x30A4, 0x30A6, 0x30A8, 0x30AA,
+            0x30AB, 0x30AD, 0x30AF, 0x30B1, 0x30B3, 0x30B5, 0x30B7, 0x30B9,
+            0x30BB, 0x30BD, 0x30BF, 0x30C1, 0x30C4, 0x30C6, 0x30C8, 0x30CA,
+            0x30CB, 0x30CC, 0x30CD, 0x30CE, 0x30CF, 0x30D2, 0x30D5, 0x30D8,
+            0x30DB, 0x30DE, 0x30DF, 0x30E0, 0x30E1, 0x30E2, 0x30E4, 0x30E6,
+            0x30E8, 0x30E9, 0x30EA, 0x30EB, 0x30EC, 0x30ED, 0x30EF, 0x30F3
+        };
+
+        char32_t decode(std::string_view text, std::size_t& index)
+        {
+            const unsigned char lead = static_cast<unsigned char>(text[index++]);
+            if( lead < 0x80 )
+            {
+                return lead;
+            }
+
+            const int length = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : -1;
+            if( length < 0 || index + length > text.size() )
+            {
+                return INVALID_CODE_POINT;
+            }
+
+            char32_t codePoint = lead & (0x3F >> length);
+            for( int i = 0; i < length; ++i )
+            {
+                codePoint = (codePoint << 6) | (static_cast<unsigned char>(text[index++]) & 0x3F);
+            }
+            return codePoint;
+        }
+
+        void encode(char32_t codePoint, std::string& output)
+        {
+            if( codePoint < 0x80 )
+            {
+                output += static_cast<char>(codePoint);
+            }
+            else if( codePoint < 0x800 )
+            {
+                output += static_cast<char>(0xC0 | (codePoint >> 6));
+                output += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else if( codePoint < 0x10000 )
+            {
+                output += static_cast<char>(0xE0 | (codePoint >> 12));
+                output += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                output += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else
+            {
+                output += static_cast<char>(0xF0 | (codePoint >> 18));
+                output += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                output += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                output += static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+        }
+
+        char32_t foldKana(char32_t codePoint)
+        {
+            if( codePoint >= 0xFF66 && codePoint <= 0xFF9D )
+            {
+                codePoint = HALF_WIDTH_KATAKANA[codePoint - 0xFF66];
+            }
+            if( (codePoint >= 0x30A1 && codePoint <= 0x30F6) || codePoint == 0x30FD || codePoint == 0x30FE )
+            {
+                return codePoint - 0x60; // Katakana to hiragana
+            }
+            return codePoint;
+        }
+
+        char32_t foldCharacter(char32_t codePoint)
+        {
+            codePoint = foldKana(codePoint);
+            if( codePoint >= 0xFF01 && codePoint <= 0xFF5E )
+            {
+                codePoint -= 0xFEE0; // Full-width ASCII
+            }
+            if( codePoint == 0x3000 )
+            {
+                return U' ';
+            }
+            if( codePoint >= U'A' && codePoint <= U'Z' )
+            {
+                return codePoint - U'A' + U'a';
+            }
+            return codePoint;
+        }
+
+        bool isVoiceable(char32_t hiragana)
+        {
+            return (hiragana >= 0x304B && hiragana <= 0x3062 && (hiragana - 0x304B) % 2 == 0)
+                || hiragana == 0x3064 || hiragana == 0x3066 || hiragana == 0x3068
+                || (hiragana >= 0x306F && hiragana <= 0x307B && (hiragana - 0x306F) % 3 == 0);
+        }
+
+        bool isSemiVoiceable(char32_t hiragana)
+        {
+            return hiragana >= 0x306F && hiragana <= 0x307B && (hiragana - 0x306F) % 3 == 0;
+        }
+
+        bool isSpace(char32_t codePoint)
+        {
+            return codePoint == U' ' || codePoint == U'\t' || codePoint == U'\r' || codePoint == U'\n';
+        }
+
+        bool isHiragana(char32_t codePoint)
+        {
+            return codePoint >= 0x3041 && codePoint <= 0x3096;
+        }
+
+        bool isVowel(char character)
+        {
+            return character == 'a' || character == 'i' || character == 'u' || character == 'e' || character == 'o';
+        }
+
+        // Decodes text, folding every character and merging separate voicing marks into the preceding kana
+        std::u32string foldText(std::string_view text, char32_t (*fold)(char32_t))
+        {
+            std::u32string codePoints;
+            codePoints.reserve(text.size());
+
+            for( std::size_t index = 0; index < text.size(); )
+            {
+                const char32_t codePoint = decode(text, index);
+
+                const bool voiced = codePoint == HALF_WIDTH_VOICED_MARK || codePoint == COMBINING_VOICED_MARK;
+                const bool semiVoiced = codePoint == HALF_WIDTH_SEMI_VOICED_MARK || codePoint == COMBINING_SEMI_VOICED_MARK;
+                if( (voiced || semiVoiced) && !codePoints.empty() )
+                {
+                    char32_t& previous = codePoints.back();
+                    if( voiced && previous == 0x3046 )
+                    {
+                        previous = 0x3094;
+                        continue;
+                    }
+                    if( voiced && isVoiceable(previous) )
+                    {
+                        previous += 1;
+                        continue;
+                    }
+                    if( semiVoiced && isSemiVoiceable(previous) )
+                    {
+                        previous += 2;
+                        continue;
+                    }
+                }
+
+                codePoints += fold(codePoint);
+            }
+            return codePoints;
+        }
+
+        // Plain large kana a hiragana sorts with in gojūon order
+        char32_t gojuonBase(char32_t hiragana)
+        {
+            if( hiragana <= 0x304A )
+            {
+                return (hiragana + 1) & ~1u; // Small vowels precede their large forms
+            }
+            if( hiragana <= 0x3062 )
+            {
+                return hiragana - (hiragana - 0x304B) % 2;
+            }
+            if( hiragana <= 0x3065 )
+            {
+                return 0x3064; // っ, つ, づ
+            }
+            if( hiragana <= 0x3069 )
+            {
+                return hiragana - (hiragana - 0x3066) % 2;
+            }
+            if( hiragana >= 0x306F && hiragana <= 0x307D )
+            {
+                return hiragana - (hiragana - 0x306F) % 3;
+            }
+            if( hiragana >= 0x3083 && hiragana <= 0x3087 )
+            {
+                return (hiragana + 1) & ~1u;
+            }
+            switch( hiragana )
+            {
+            case 0x308E: return 0x308F; // ゎ
+            case 0x3094: return 0x3046; // ゔ
+            case 0x3095: return 0x304B; // ゕ
+            case 0x3096: return 0x3051; // ゖ
+            default: return hiragana;
+            }
+        }
+
+        // Primary gojūon sort key, the plain kana of every character with ー read as the preceding vowel
+        std::u32string gojuonKey(const std::u32string& folded)
+        {
+            static constexpr char32_t VOWELS[] = { 0x3042, 0x3044, 0x3046, 0x3048, 0x304A };
+            std::u32string key;
+            key.reserve(folded.size());
+            for( const char32_t codePoint : folded )
+            {
+                if( isHiragana(codePoint) )
+                {
+                    key += gojuonBase(codePoint);
+                }
+                else if( codePoint == PROLONGED_SOUND_MARK && !key.empty() && isHiragana(key.back()) && key.back() != SYLLABIC_N )
+                {
+                    const char vowel = HIRAGANA_ROMAJI[key.back() - 0x3041].back();
+                    key += VOWELS[std::string_view("aiueo").find(vowel)];
+                }
+                else
+                {
+                    key += codePoint;
+                }
+            }
+            return key;
+        }
+    }
+
+    std::string normalizeJapanese(std::string_view text)
+    {
+        const std::u32string codePoints = foldText(text, foldCharacter);
+
+        const auto first = std::find_if_not(codePoints.begin(), codePoints.end(), isSpace);
+        const auto last = std::find_if_not(codePoints.rbegin(), codePoints.rend(), isSpace).base();
+
+        std::string output;
+        output.reserve(text.size());
+        for( auto it = first; it < last; ++it )
+        {
+            encode(*it, output);
+        }
+        return output;
+    }
+
+    std::string toHiragana(std::string_view text)
+    {
+        std::string output;
+        output.reserve(text.size());
+        for( const char32_t codePoint : foldText(text, foldKana) )
+        {
+            encode(codePoint, output);
+        }
+        return output;
+    }
+
+    std::string toRomaji(std::string_view text)
+    {
+        const std::u32string kana = toCodePoints(normalizeJapanese(text));
+        std::string output;
+        output.reserve(kana.size() * 2);
+
+        bool doubleConsonant = false;
+        bool syllabicN = false;
+        for( std::size_t index = 0; index < kana.size(); ++index )
+        {
+            const char32_t codePoint = kana[index];
+            if( codePoint == SMALL_TSU )
+            {
+                doubleConsonant = true;
+                continue;
+            }
+            if( !isHiragana(codePoint) )
+            {
+                if( codePoint == PROLONGED_SOUND_MARK && !output.empty() && isVowel(output.back()) )
+                {
+                    output += output.back();
+                }
+                else
+                {
+                    encode(codePoint, output);
+                }
+                doubleConsonant = syllabicN = false;
+                continue;
+            }
+
+            std::string syllable(HIRAGANA_ROMAJI[codePoint - 0x3041]);
+            const char32_t next = index + 1 < kana.size() ? kana[index + 1] : 0;
+            const bool smallY = next == 0x3083 || next == 0x3085 || next == 0x3087;
+            const bool smallVowel = next >= 0x3041 && next <= 0x3049 && next % 2 == 1;
+            if( smallY && syllable.size() > 1 && syllable.back() == 'i' )
+            {
+                // きゃ is "kya", but しゃ, じゃ and ちゃ drop the y
+                syllable.pop_back();
+                if( syllable.back() != 'h' && syllable != "j" )
+                {
+                    syllable += 'y';
+                }
+                syllable += HIRAGANA_ROMAJI[next - 0x3041].back();
+                ++index;
+            }
+            else if( smallVowel && (syllable.size() > 1 || codePoint == 0x3046) )
+            {
+                // ふぁ is "fa", てぃ "ti", うぃ "wi"
+                syllable.pop_back();
+                syllable = (syllable.empty() ? "w" : syllable) + std::string(HIRAGANA_ROMAJI[next - 0x3041]);
+                ++index;
+            }
+
+            if( syllabicN && (isVowel(syllable.front()) || syllable.front() == 'y') )
+            {
+                output += '\'';
+            }
+            if( doubleConsonant && !isVowel(syllable.front()) && syllable.front() != 'n' )
+            {
+                output += syllable.starts_with("ch") ? 't' : syllable.front();
+            }
+            output += syllable;
+            doubleConsonant = false;
+            syllabicN = codePoint == SYLLABIC_N;
+        }
+        return output;
+    }
+
+    int compareGojuon(std::string_view lhs, std::string_view rhs)
+    {
+        const std::u32string foldedLhs = foldText(lhs, foldCharacter);
+        const std::u32string foldedRhs = foldText(rhs, foldCharacter);
+
+        // Plain kana first, then voicing and size of the kana, then the spelling itself
+        const int primary = gojuonKey(foldedLhs).compare(gojuonKey(foldedRhs));
+        if( primary != 0 )
+        {
+            return primary;
+        }
+        const int secondary = foldedLhs.compare(foldedRhs);
+        return secondary != 0 ? secondary : lhs.compare(rhs);
+    }
+
+    std::size_t editDistance(std::string_view lhs, std::string_view rhs)
+    {
+        const std::u32string source = toCodePoints(lhs);
+        const std::u32string target = toCodePoints(rhs);
+
+        // Levenshtein distance keeping only the previous row of the table
+        std::vector<std::size_t> row(target.size() + 1);
+        for( std::size_t column = 0; column <= target.size(); ++column )
+        {
+            row[column] = column;
+        }
+        for( std::size_t line = 1; line <= source.size(); ++line )
+        {
+            std::size_t diagonal = row[0];
+            row[0] = line;
+            for( std::size_t column = 1; column <= target.size(); ++column )
+            {
+                const std::size_t above = row[column];
+                row[column] = std::min({ above + 1, row[column - 1] + 1, diagonal + (source[line - 1] == target[column - 1] ? 0 : 1) });
+                diagonal = above;
+            }
+        }
+        return row[target.size()];
+    }
+
+    uint64_t hashText(std::string_view text)
+    {
+        uint64_t hash = 14695981039346656037ull;
+        for( const char character : text )
+        {
+            hash ^= static_cast<unsigned char>(character);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::u32string toCodePoints(std::string_view text)
+    {
+        std::u32string codePoints;
+        codePoints.reserve(text.size());
+        for( std::size_t index = 0; index < text.size(); )
+        {
+            codePoints += decode(text, index);
+        }
+        return codePoints;
+    }
+
+    std::string toUtf8(char32_t codePoint)
+    {
+        std::string output;
+        encode(codePoint, output);
+        return output;
+    }
+
+    bool isKanji(char32_t codePoint)
+    {
+        return (codePoint >= 0x4E00 && codePoint <= 0x9FFF)     // CJK unified ideographs
+            || (codePoint >= 0x3400 && codePoint <= 0x4DBF)     // Extension A
+            || (codePoint >= 0xF900 && codePoint <= 0xFAFF)     // Compatibility ideographs
+            || (codePoint >= 0x20000 && codePoint <= 0x3134F)   // Extensions B and later
+            || codePoint == 0x3005;                             // Iteration mark
+    }
+}
@@ -0,0 +1,92 @@
+/**
+ * @file JapaneseText.h
+ * @brief Declares helpers normalizing Japanese text so that spelling variants compare equal.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace tadaima
+{
+    /**
+     * @brief Normalizes Japanese text for lookups.
+     *
+     * Katakana (including half-width katakana and combining voicing marks) is folded to hiragana,
+     * full-width ASCII is folded to ASCII, ASCII letters are lowercased and surrounding whitespace is trimmed.
+     *
+     * @param text UTF-8 encoded text.
+     * @return The normalized UTF-8 text.
+     */
+    std::string normalizeJapanese(std::string_view text);
+
+    /**
+     * @brief Converts katakana, including half-width katakana and combining voicing marks, to hiragana.
+     * @param text UTF-8 encoded text.
+     * @return The text with every katakana replaced, other characters are kept.
+     */
+    std::string toHiragana(std::string_view text);
+
+    /**
+     * @brief Transliterates kana to romaji as typed on a keyboard (wāpuro romaji).
+     *
+     * The text is normalized first. Consonants follow Hepburn ("shi", "chi", "tsu", "fu"), but long vowels are spelled
+     * out kana by kana ("kyouto"), ー repeats the preceding vowel ("koohii") and を is "wo". ん before a vowel or y is
+     * written "n'" and っ doubles the following consonant. Characters other than kana, such as kanji, are kept.
+     *
+     * @param text UTF-8 encoded text.
+     * @return The romaji of the text.
+     */
+    std::string toRomaji(std::string_view text);
+
+    /**
+     * @brief Compares two texts in gojūon order.
+     *
+     * Hiragana and katakana spellings sort together, voiced and small kana sort with their plain form and ー counts as
+     * the preceding vowel. Ties are broken by voicing and size, then by the spelling, so only equal texts compare equal.
+     *
+     * @param lhs UTF-8 encoded text.
+     * @param rhs UTF-8 encoded text.
+     * @return A negative value if lhs sorts first, zero if the texts are equal, a positive value otherwise.
+     */
+    int compareGojuon(std::string_view lhs, std::string_view rhs);
+
+    /**
+     * @brief Calculates the Levenshtein distance between two texts in code points.
+     * @param lhs UTF-8 encoded text.
+     * @param rhs UTF-8 encoded text.
+     * @return The number of inserted, removed or replaced characters turning one text into the other.
+     */
+    std::size_t editDistance(std::string_view lhs, std::string_view rhs);
+
+    /**
+     * @brief Calculates the 64-bit FNV-1a hash of the text.
+     * @param text The text to hash.
+     * @return The hash of the text.
+     */
+    uint64_t hashText(std::string_view text);
+
+    /**
+     * @brief Decodes UTF-8 text into code points. Malformed sequences become U+FFFD.
+     * @param text UTF-8 encoded text.
+     * @return The code points of the text.
+     */
+    std::u32string toCodePoints(std::string_view text);
+
+    /**
+     * @brief Encodes a single code point as UTF-8.
+     * @param codePoint The code point to encode.
+     * @return The UTF-8 encoded character.
+     */
+    std::string toUtf8(char32_t codePoint);
+
+    /**
+     * @brief Checks if a code point is a kanji, including the iteration mark 々.
+     * @param codePoint The code point to check.
+     * @return True if the code point is a CJK ideograph.
+     */
+    bool isKanji(char32_t codePoint);
+}
@@ -0,0 +1,155 @@
+#include "MappedFile.h"
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace tadaima
+{
+    MappedFile::~MappedFile()
+    {
+        close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept
+        : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)),
+        m_file(std::exchange(other.m_file, nullptr)), m_mapping(std::exchange(other.m_mapping, nullptr))
+    {
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if( this != &other )
+        {
+            close();
+            m_data = std::exchange(other.m_data, nullptr);
+            m_size = std::exchange(other.m_size, 0);
+            m_file = std::exchange(other.m_file, nullptr);
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+        }
+        return *this;
+    }
+
+#ifdef _WIN32
+    bool MappedFile::open(const std::string& path)
+    {
+        close();
+
+        HANDLE file = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if( file == INVALID_HANDLE_VALUE )
+        {
+            return false;
+        }
+
+        LARGE_INTEGER size;
+        if( !::GetFileSizeEx(file, &size) || size.QuadPart == 0 )
+        {
+            ::CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = ::CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if( mapping == nullptr )
+        {
+            ::CloseHandle(file);
+            return false;
+        }
+
+        const void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if( view == nullptr )
+        {
+            ::CloseHandle(mapping);
+            ::CloseHandle(file);
+            return false;
+        }
+
+        m_data = static_cast<const unsigned char*>(view);
+        m_size = static_cast<std::size_t>(size.QuadPart);
+        m_file = file;
+        m_mapping = mapping;
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if( m_data )
+        {
+            ::UnmapViewOfFile(m_data);
+        }
+        if( m_mapping )
+        {
+            ::CloseHandle(m_mapping);
+        }
+        if( m_file )
+        {
+            ::CloseHandle(m_file);
+        }
+
+        m_data = nullptr;
+        m_size = 0;
+        m_file = nullptr;
+        m_mapping = nullptr;
+    }
+#else
+    bool MappedFile::open(const std::string& path)
+    {
+        close();
+
+        const int file = ::open(path.c_str(), O_RDONLY);
+        if( file < 0 )
+        {
+            return false;
+        }
+
+        struct stat status;
+        if( ::fstat(file, &status) != 0 || status.st_size == 0 )
+        {
+            ::close(file);
+            return false;
+        }
+
+        void* view = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, file, 0);
+        ::close(file);
+        if( view == MAP_FAILED )
+        {
+            return false;
+        }
+
+        m_data = static_cast<const unsigned char*>(view);
+        m_size = static_cast<std::size_t>(status.st_size);
+        return true;
+    }
+
+    void MappedFile::close()
+    {
+        if( m_data )
+        {
+            ::munmap(const_cast<unsigned char*>(m_data), m_size);
+        }
+
+        m_data = nullptr;
+        m_size = 0;
+    }
+#endif
+
+    bool MappedFile::isOpen() const
+    {
+        return m_data != nullptr;
+    }
+
+    const unsigned char* MappedFile::data() const
+    {
+        return m_data;
+    }
+
+    std::size_t MappedFile::size() const
+    {
+        return m_size;
+    }
+}
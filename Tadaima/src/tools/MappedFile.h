@@ -0,0 +1,83 @@
+/**
+ * @file MappedFile.h
+ * @brief Declares the MappedFile class which maps a file into memory for reading.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace tadaima
+{
+    /**
+     * @brief The MappedFile class maps a whole file read-only into the address space of the process.
+     *
+     * The mapping is released when the object is destroyed or closed. The class is movable but not copyable.
+     */
+    class MappedFile
+    {
+    public:
+        /**
+         * @brief Constructs an empty MappedFile object.
+         */
+        MappedFile() = default;
+
+        /**
+         * @brief Destroys the MappedFile object and releases the mapping.
+         */
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /**
+         * @brief Move constructor.
+         * @param other The mapping to take over.
+         */
+        MappedFile(MappedFile&& other) noexcept;
+
+        /**
+         * @brief Move assignment operator.
+         * @param other The mapping to take over.
+         * @return A reference to this object.
+         */
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        /**
+         * @brief Maps the given file into memory, releasing the previous mapping.
+         * @param path The path of the file.
+         * @return True if the file was mapped, false otherwise.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Releases the mapping.
+         */
+        void close();
+
+        /**
+         * @brief Checks if a file is mapped.
+         * @return True if a file is mapped, false otherwise.
+         */
+        bool isOpen() const;
+
+        /**
+         * @brief Gets the mapped bytes.
+         * @return A pointer to the first mapped byte, or nullptr if nothing is mapped.
+         */
+        const unsigned char* data() const;
+
+        /**
+         * @brief Gets the size of the mapped file.
+         * @return The number of mapped bytes.
+         */
+        std::size_t size() const;
+
+    private:
+        const unsigned char* m_data = nullptr; /**< Pointer to the mapped bytes. */
+        std::size_t m_size = 0; /**< Number of mapped bytes. */
+        void* m_file = nullptr; /**< Native handle of the file. */
+        void* m_mapping = nullptr; /**< Native handle of the mapping. */
+    };
+}
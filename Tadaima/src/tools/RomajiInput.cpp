@@ -0,0 +1,287 @@
+﻿#include "RomajiInput.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <unordered_map>
+
+namespace tadaima
+{
+    namespace
+    {
+        constexpr std::string_view SYLLABIC_N = "ん";
+        constexpr std::string_view SMALL_TSU = "っ";
+        constexpr std::string_view PROLONGED_SOUND_MARK = "ー";
+
+        // Syllables of Hepburn and Kunrei-shiki romaji as typed with Japanese IMEs
+        constexpr std::array<std::pair<std::string_view, std::string_view>, 169> SYLLABLES =
+        { {
+            { "a", "あ" }, { "i", "い" }, { "u", "う" }, { "e", "え" }, { "o", "お" },
+            { "ka", "か" }, { "ki", "き" }, { "ku", "く" }, { "ke", "け" }, { "ko", "こ" },
+            { "kya", "きゃ" }, { "kyu", "きゅ" }, { "kyo", "きょ" },
+            { "ga", "が" }, { "gi", "ぎ" }, { "gu", "ぐ" }, { "ge", "げ" }, { "go", "ご" },
+            { "gya", "ぎゃ" }, { "gyu", "ぎゅ" }, { "gyo", "ぎょ" },
+            { "sa", "さ" }, { "si", "し" }, { "shi", "し" }, { "su", "す" }, { "se", "せ" }, { "so", "そ" },
+            { "sha", "しゃ" }, { "shu", "しゅ" }, { "she", "しぇ" }, { "sho", "しょ" }, { "sya", "しゃ" }, { "syu", "しゅ" }, { "syo", "しょ" },
+            { "za", "ざ" }, { "zi", "じ" }, { "ji", "じ" }, { "zu", "ず" }, { "ze", "ぜ" }, { "zo", "ぞ" },
+            { "ja", "じゃ" }, { "ju", "じゅ" }, { "je", "じぇ" }, { "jo", "じょ" }, { "jya", "じゃ" }, { "jyu", "じゅ" }, { "jyo", "じょ" },
+            { "zya", "じゃ" }, { "zyu", "じゅ" }, { "zyo", "じょ" },
+            { "ta", "た" }, { "ti", "ち" }, { "chi", "ち" }, { "tu", "つ" }, { "tsu", "つ" }, { "te", "て" }, { "to", "と" },
+            { "cha", "ちゃ" }, { "chu", "ちゅ" }, { "che", "ちぇ" }, { "cho", "ちょ" }, { "tya", "ちゃ" }, { "tyu", "ちゅ" }, { "tyo", "ちょ" },
+            { "cya", "ちゃ" }, { "cyu", "ちゅ" }, { "cyo", "ちょ" }, { "thi", "てぃ" }, { "tsa", "つぁ" },
+            { "da", "だ" }, { "di", "ぢ" }, { "du", "づ" }, { "de", "で" }, { "do", "ど" },
+            { "dya", "ぢゃ" }, { "dyu", "ぢゅ" }, { "dyo", "ぢょ" }, { "dhi", "でぃ" },
+            { "na", "な" }, { "ni", "に" }, { "nu", "ぬ" }, { "ne", "ね" }, { "no", "の" },
+            { "nya", "にゃ" }, { "nyu", "にゅ" }, { "nyo", "にょ" },
+            { "ha", "は" }, { "hi", "ひ" }, { "hu", "ふ" }, { "fu", "ふ" }, { "he", "へ" }, { "ho", "ほ" },
+            { "hya", "ひゃ" }, { "hyu", "ひゅ" }, { "hyo", "ひょ" },
+            { "fa", "ふぁ" }, { "fi", "ふぃ" }, { "fe", "ふぇ" }, { "fo", "ふぉ" }, { "fyu", "ふゅ" },
+            { "ba", "ば" }, { "bi", "び" }, { "bu", "ぶ" }, { "be", "べ" }, { "bo", "ぼ" },
+            { "bya", "びゃ" }, { "byu", "びゅ" }, { "byo", "びょ" },
+            { "pa", "ぱ" }, { "pi", "ぴ" }, { "pu", "ぷ" }, { "pe", "ぺ" }, { "po", "ぽ" },
+            { "pya", "ぴゃ" }, { "pyu", "ぴゅ" }, { "pyo", "ぴょ" },
+            { "ma", "ま" }, { "mi", "み" }, { "mu", "む" }, { "me", "め" }, { "mo", "も" },
+            { "mya", "みゃ" }, { "myu", "みゅ" }, { "myo", "みょ" },
+            { "ya", "や" }, { "yu", "ゆ" }, { "ye", "いぇ" }, { "yo", "よ" },
+            { "ra", "ら" }, { "ri", "り" }, { "ru", "る" }, { "re", "れ" }, { "ro", "ろ" },
+            { "rya", "りゃ" }, { "ryu", "りゅ" }, { "ryo", "りょ" },
+            { "wa", "わ" }, { "wi", "うぃ" }, { "we", "うぇ" }, { "wo", "を" },
+            { "va", "ゔぁ" }, { "vi", "ゔぃ" }, { "vu", "ゔ" }, { "ve", "ゔぇ" }, { "vo", "ゔぉ" },
+            { "xa", "ぁ" }, { "xi", "ぃ" }, { "xu", "ぅ" }, { "xe", "ぇ" }, { "xo", "ぉ" },
+            { "la", "ぁ" }, { "li", "ぃ" }, { "lu", "ぅ" }, { "le", "ぇ" }, { "lo", "ぉ" },
+            { "xya", "ゃ" }, { "xyu", "ゅ" }, { "xyo", "ょ" }, { "lya", "ゃ" }, { "lyu", "ゅ" }, { "lyo", "ょ" },
+            { "xtu", "っ" }, { "xtsu", "っ" }, { "ltu", "っ" }, { "ltsu", "っ" }, { "xwa", "ゎ" }, { "lwa", "ゎ" },
+            { "xka", "ゕ" }, { "xke", "ゖ" }
+        } };
+
+        // Vowels with a macron or a circumflex, which mark long vowels in Hepburn and Kunrei-shiki
+        struct LongVowel
+        {
+            std::string_view spelling;
+            char vowel;
+        };
+
+        constexpr std::array<LongVowel, 20> LONG_VOWELS =
+        { {
+            { "\xC4\x81", 'a' }, { "\xC4\xAB", 'i' }, { "\xC5\xAB", 'u' }, { "\xC4\x93", 'e' }, { "\xC5\x8D", 'o' },
+            { "\xC4\x80", 'A' }, { "\xC4\xAA", 'I' }, { "\xC5\xAA", 'U' }, { "\xC4\x92", 'E' }, { "\xC5\x8C", 'O' },
+            { "\xC3\xA2", 'a' }, { "\xC3\xAE", 'i' }, { "\xC3\xBB", 'u' }, { "\xC3\xAA", 'e' }, { "\xC3\xB4", 'o' },
+            { "\xC3\x82", 'A' }, { "\xC3\x8E", 'I' }, { "\xC3\x9B", 'U' }, { "\xC3\x8A", 'E' }, { "\xC3\x94", 'O' }
+        } };
+
+        const std::unordered_map<std::string_view, std::string_view>& syllables()
+        {
+            static const std::unordered_map<std::string_view, std::string_view> table(SYLLABLES.begin(), SYLLABLES.end());
+            return table;
+        }
+
+        bool isLetter(char character)
+        {
+            return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z');
+        }
+
+        bool isVowel(char character)
+        {
+            return character == 'a' || character == 'i' || character == 'u' || character == 'e' || character == 'o';
+        }
+
+        // Appends kana, as katakana if the romaji was typed in upper case
+        void appendKana(std::string& output, std::string_view hiragana, bool katakana)
+        {
+            const std::size_t start = output.size();
+            output += hiragana;
+            if( !katakana )
+            {
+                return;
+            }
+            // Hiragana U+3041 - U+3096 are E3 81 81 - E3 82 96, katakana lie 0x60 code points higher
+            for( std::size_t index = start; index + 2 < output.size(); index += 3 )
+            {
+                const unsigned char second = static_cast<unsigned char>(output[index + 1]);
+                const unsigned char third = static_cast<unsigned char>(output[index + 2]);
+                const int codePoint = 0x3000 + ((second & 0x3F) << 6) + (third & 0x3F);
+                if( static_cast<unsigned char>(output[index]) != 0xE3 || codePoint < 0x3041 || codePoint > 0x3096 )
+                {
+                    continue;
+                }
+                const int shifted = codePoint + 0x60;
+                output[index + 1] = static_cast<char>(0x80 | ((shifted >> 6) & 0x3F));
+                output[index + 2] = static_cast<char>(0x80 | (shifted & 0x3F));
+            }
+        }
+
+        // Converts letters from their start on; stops at letters which may still become a longer syllable
+        std::size_t convertLetters(std::string_view letters, std::string_view original, std::string& output)
+        {
+            std::size_t position = 0;
+            while( position < letters.size() )
+            {
+                const std::string_view rest = letters.substr(position);
+                const bool katakana = std::isupper(static_cast<unsigned char>(original[position])) != 0;
+                if( rest.size() >= 2 && rest[0] == 'n' )
+                {
+                    if( rest[1] == 'n' )
+                    {
+                        if( rest.size() < 3 )
+                        {
+                            break;
+                        }
+                        // "nna" is ん followed by な, "nnk" a single ん like the IMEs type it
+                        appendKana(output, SYLLABIC_N, katakana);
+                        position += isVowel(rest[2]) || rest[2] == 'y' ? 1 : 2;
+                        continue;
+                    }
+                    if( !isVowel(rest[1]) && rest[1] != 'y' )
+                    {
+                        appendKana(output, SYLLABIC_N, katakana);
+                        ++position;
+                        continue;
+                    }
+                }
+                if( rest.size() >= 2 && !isVowel(rest[0]) && (rest[0] == rest[1] || rest.starts_with("tch")) )
+                {
+                    appendKana(output, SMALL_TSU, katakana);
+                    ++position;
+                    continue;
+                }
+
+                auto it = syllables().find(rest);
+                if( it == syllables().end() )
+                {
+                    break;
+                }
+                appendKana(output, it->second, katakana);
+                position = letters.size();
+            }
+            return position;
+        }
+    }
+
+    bool RomajiInput::convert(std::string_view beforeCursor, Replacement& replacement)
+    {
+        if( beforeCursor.empty() )
+        {
+            return false;
+        }
+
+        const std::size_t end = beforeCursor.size();
+        if( beforeCursor.back() == '-' )
+        {
+            replacement = { end - 1, 1, std::string(PROLONGED_SOUND_MARK) };
+            return true;
+        }
+        if( beforeCursor.ends_with("n'") || beforeCursor.ends_with("N'") )
+        {
+            replacement.start = end - 2;
+            replacement.length = 2;
+            replacement.kana.clear();
+            appendKana(replacement.kana, SYLLABIC_N, beforeCursor[end - 2] == 'N');
+            return true;
+        }
+
+        // A vowel with a macron is typed as one character, it is converted like the plain vowel and then lengthened
+        std::size_t lettersEnd = end;
+        char longVowel = '\0';
+        for( const auto& vowel : LONG_VOWELS )
+        {
+            if( beforeCursor.ends_with(vowel.spelling) )
+            {
+                lettersEnd = end - vowel.spelling.size();
+                longVowel = vowel.vowel;
+                break;
+            }
+        }
+
+        std::size_t start = lettersEnd;
+        const std::size_t maxLetters = longVowel != '\0' ? MAX_PENDING - 1 : MAX_PENDING;
+        while( start > 0 && lettersEnd - start < maxLetters && isLetter(beforeCursor[start - 1]) )
+        {
+            --start;
+        }
+
+        std::string original(beforeCursor.substr(start, lettersEnd - start));
+        if( longVowel != '\0' )
+        {
+            original += longVowel;
+        }
+        if( original.empty() )
+        {
+            return false;
+        }
+        std::string letters(original);
+        std::transform(letters.begin(), letters.end(), letters.begin(), [](unsigned char character) { return static_cast<char>(std::tolower(character)); });
+
+        // Letters which form no syllable, e.g. a stray "q", are skipped so they do not block the ones typed after them
+        for( std::size_t skipped = 0; skipped < letters.size(); ++skipped )
+        {
+            std::string kana;
+            const std::size_t converted = convertLetters(std::string_view(letters).substr(skipped), std::string_view(original).substr(skipped), kana);
+            if( converted == 0 )
+            {
+                continue;
+            }
+
+            const bool wholeLongVowel = longVowel != '\0' && skipped + converted == letters.size();
+            if( wholeLongVowel )
+            {
+                const bool katakana = std::isupper(static_cast<unsigned char>(longVowel)) != 0;
+                const char vowel = static_cast<char>(std::tolower(static_cast<unsigned char>(longVowel)));
+                // ō is written おう, the other long vowels double the vowel
+                if( katakana )
+                {
+                    kana += PROLONGED_SOUND_MARK;
+                }
+                else
+                {
+                    const std::string_view lengthening = vowel == 'o' ? std::string_view("u") : std::string_view(&vowel, 1);
+                    appendKana(kana, syllables().at(lengthening), false);
+                }
+            }
+
+            replacement.start = start + skipped;
+            replacement.length = wholeLongVowel ? end - replacement.start : converted;
+            replacement.kana = std::move(kana);
+            return true;
+        }
+        return false;
+    }
+
+    bool RomajiInput::finish(std::string_view text, Replacement& replacement)
+    {
+        std::size_t count = 0;
+        while( count < 2 && count < text.size() && (text[text.size() - count - 1] == 'n' || text[text.size() - count - 1] == 'N') )
+        {
+            ++count;
+        }
+        if( count == 0 )
+        {
+            return false;
+        }
+
+        replacement.start = text.size() - count;
+        replacement.length = count;
+        replacement.kana.clear();
+        appendKana(replacement.kana, SYLLABIC_N, text[replacement.start] == 'N');
+        return true;
+    }
+
+    std::string RomajiInput::toKana(std::string_view romaji)
+    {
+        std::string text;
+        text.reserve(romaji.size() * 3);
+        Replacement replacement;
+        for( std::size_t index = 0; index < romaji.size(); ++index )
+        {
+            text += romaji[index];
+            const bool partial = index + 1 < romaji.size() && (static_cast<unsigned char>(romaji[index + 1]) & 0xC0) == 0x80;
+            if( !partial && convert(text, replacement) )
+            {
+                text.replace(replacement.start, replacement.length, replacement.kana);
+            }
+        }
+        if( finish(text, replacement) )
+        {
+            text.replace(replacement.start, replacement.length, replacement.kana);
+        }
+        return text;
+    }
+}
@@ -0,0 +1,66 @@
+/**
+ * @file RomajiInput.h
+ * @brief Declares the RomajiInput class converting romaji to kana while it is typed.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace tadaima
+{
+    /**
+     * @brief The RomajiInput class turns romaji into kana keystroke by keystroke, like an IME without conversion to kanji.
+     *
+     * Only the few letters before the cursor which are not kana yet are looked at, at most MAX_PENDING of them, so a
+     * keystroke costs the same for any length of text. Letters are replaced as soon as they form a syllable:
+     * - "ka" becomes か, "kya" きゃ, "shi" and "si" し, "tsu" and "tu" つ, "xa" or "la" the small ぁ;
+     * - a doubled consonant like "kk" or "tch" becomes っ;
+     * - "n" becomes ん before a consonant, "n'" and "nn" before a consonant do as well, and "nn" before a vowel keeps
+     *   the second n for the next syllable, so both "konnichiwa" and "konnnichiwa" give こんにちわ;
+     * - "-" becomes the long vowel mark ー, and vowels with a macron are lengthened, e.g. "kō" gives こう.
+     * Syllables typed in upper case give katakana, e.g. "KO-HI-" gives コーヒー.
+     *
+     * A trailing "n" may still become な or にゃ, so finish() turns it into ん once the text is submitted.
+     */
+    class RomajiInput
+    {
+    public:
+        static constexpr std::size_t MAX_PENDING = 4; /**< Maximal number of unconverted letters looked at. */
+
+        /**
+         * @brief A part of the text to be replaced.
+         */
+        struct Replacement
+        {
+            std::size_t start = 0; /**< Byte offset of the replaced text. */
+            std::size_t length = 0; /**< Length in bytes of the replaced text. */
+            std::string kana; /**< The replacing text. */
+        };
+
+        /**
+         * @brief Converts the romaji typed just before the cursor.
+         * @param beforeCursor The text from its start up to the cursor.
+         * @param replacement Receives the text to be replaced if there is any.
+         * @return True if something has to be replaced.
+         */
+        static bool convert(std::string_view beforeCursor, Replacement& replacement);
+
+        /**
+         * @brief Converts a trailing "n" or "nn", which convert() keeps while a vowel may follow.
+         * @param text The submitted text.
+         * @param replacement Receives the text to be replaced if there is any.
+         * @return True if something has to be replaced.
+         */
+        static bool finish(std::string_view text, Replacement& replacement);
+
+        /**
+         * @brief Converts a whole text as if it was typed, e.g. for tests and command line input.
+         * @param romaji The text.
+         * @return The text with every romaji syllable replaced by kana.
+         */
+        static std::string toKana(std::string_view romaji);
+    };
+}
@@ -0,0 +1,155 @@
+#include "Sha1.h"
+#include <algorithm>
+#include <cstring>
+
+namespace tadaima
+{
+    namespace
+    {
+        uint32_t rotateLeft(uint32_t value, int bits)
+        {
+            return (value << bits) | (value >> (32 - bits));
+        }
+    }
+
+    Sha1::Sha1()
+        : m_state{ 0x67452301u, 0xEFCDAB89u, 0x98BADCFEu, 0x10325476u, 0xC3D2E1F0u }
+    {
+    }
+
+    void Sha1::update(const void* data, std::size_t size)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        m_length += size;
+
+        if( m_bufferSize > 0 )
+        {
+            const std::size_t count = std::min(size, m_buffer.size() - m_bufferSize);
+            std::memcpy(m_buffer.data() + m_bufferSize, bytes, count);
+            m_bufferSize += count;
+            bytes += count;
+            size -= count;
+            if( m_bufferSize < m_buffer.size() )
+            {
+                return;
+            }
+            processBlock(m_buffer.data());
+            m_bufferSize = 0;
+        }
+
+        for( ; size >= m_buffer.size(); bytes += m_buffer.size(), size -= m_buffer.size() )
+        {
+            processBlock(bytes);
+        }
+
+        std::memcpy(m_buffer.data(), bytes, size);
+        m_bufferSize = size;
+    }
+
+    void Sha1::update(std::string_view text)
+    {
+        update(text.data(), text.size());
+    }
+
+    Sha1::Digest Sha1::finalize()
+    {
+        const uint64_t bitLength = m_length * 8;
+
+        uint8_t padding[72] = { 0x80 };
+        const std::size_t paddingSize = (m_bufferSize < 56 ? 56 : 120) - m_bufferSize;
+        for( int i = 0; i < 8; ++i )
+        {
+            padding[paddingSize + i] = static_cast<uint8_t>(bitLength >> (56 - 8 * i));
+        }
+        update(padding, paddingSize + 8);
+
+        Digest digest;
+        for( std::size_t i = 0; i < m_state.size(); ++i )
+        {
+            for( int j = 0; j < 4; ++j )
+            {
+                digest[i * 4 + j] = static_cast<uint8_t>(m_state[i] >> (24 - 8 * j));
+            }
+        }
+        return digest;
+    }
+
+    Sha1::Digest Sha1::digest(const void* data, std::size_t size)
+    {
+        Sha1 sha;
+        sha.update(data, size);
+        return sha.finalize();
+    }
+
+    std::string Sha1::toHex(const Digest& digest)
+    {
+        static const char* HEX_DIGITS = "0123456789abcdef";
+
+        std::string hex;
+        hex.reserve(digest.size() * 2);
+        for( uint8_t byte : digest )
+        {
+            hex += HEX_DIGITS[byte >> 4];
+            hex += HEX_DIGITS[byte & 0x0F];
+        }
+        return hex;
+    }
+
+    void Sha1::processBlock(const uint8_t* block)
+    {
+        uint32_t w[80];
+        for( int i = 0; i < 16; ++i )
+        {
+            w[i] = (uint32_t(block[i * 4]) << 24) | (uint32_t(block[i * 4 + 1]) << 16) | (uint32_t(block[i * 4 + 2]) << 8) | uint32_t(block[i * 4 + 3]);
+        }
+        for( int i = 16; i < 80; ++i )
+        {
+            w[i] = rotateLeft(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+
+        uint32_t a = m_state[0];
+        uint32_t b = m_state[1];
+        uint32_t c = m_state[2];
+        uint32_t d = m_state[3];
+        uint32_t e = m_state[4];
+
+        for( int i = 0; i < 80; ++i )
+        {
+            uint32_t f;
+            uint32_t k;
+            if( i < 20 )
+            {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999u;
+            }
+            else if( i < 40 )
+            {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1u;
+            }
+            else if( i < 60 )
+            {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDCu;
+            }
+            else
+            {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6u;
+            }
+
+            const uint32_t temp = rotateLeft(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotateLeft(b, 30);
+            b = a;
+            a = temp;
+        }
+
+        m_state[0] += a;
+        m_state[1] += b;
+        m_state[2] += c;
+        m_state[3] += d;
+        m_state[4] += e;
+    }
+}
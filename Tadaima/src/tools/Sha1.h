@@ -0,0 +1,77 @@
+/**
+ * @file Sha1.h
+ * @brief Declares the Sha1 class which computes SHA-1 digests of byte streams.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace tadaima
+{
+    /**
+     * @brief The Sha1 class computes SHA-1 digests incrementally.
+     *
+     * The digest is used to address and verify content, not to protect it against deliberate tampering.
+     */
+    class Sha1
+    {
+    public:
+        using Digest = std::array<uint8_t, 20>; /**< A SHA-1 digest. */
+
+        /**
+         * @brief Constructs a Sha1 object ready to receive data.
+         */
+        Sha1();
+
+        /**
+         * @brief Adds data to the digest.
+         * @param data Pointer to the data.
+         * @param size Number of bytes.
+         */
+        void update(const void* data, std::size_t size);
+
+        /**
+         * @brief Adds text to the digest.
+         * @param text The text to add.
+         */
+        void update(std::string_view text);
+
+        /**
+         * @brief Finishes the computation. The object must not be updated afterwards.
+         * @return The digest of all added data.
+         */
+        Digest finalize();
+
+        /**
+         * @brief Computes the digest of a block of data.
+         * @param data Pointer to the data.
+         * @param size Number of bytes.
+         * @return The digest of the data.
+         */
+        static Digest digest(const void* data, std::size_t size);
+
+        /**
+         * @brief Converts a digest to lowercase hexadecimal text.
+         * @param digest The digest to convert.
+         * @return The 40 character hexadecimal representation.
+         */
+        static std::string toHex(const Digest& digest);
+
+    private:
+        /**
+         * @brief Processes one 64-byte block of the message.
+         * @param block The block to process.
+         */
+        void processBlock(const uint8_t* block);
+
+        std::array<uint32_t, 5> m_state; /**< Intermediate hash value. */
+        std::array<uint8_t, 64> m_buffer{}; /**< Bytes of the incomplete block. */
+        std::size_t m_bufferSize = 0; /**< Number of bytes in the buffer. */
+        uint64_t m_length = 0; /**< Total number of added bytes. */
+    };
+}
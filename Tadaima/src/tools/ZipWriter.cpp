@@ -0,0 +1,187 @@
+#include "ZipWriter.h"
+#include <array>
+#include <limits>
+
+namespace tadaima
+{
+    namespace
+    {
+        constexpr uint32_t LOCAL_HEADER_SIGNATURE = 0x04034B50;
+        constexpr uint32_t CENTRAL_HEADER_SIGNATURE = 0x02014B50;
+        constexpr uint32_t END_OF_DIRECTORY_SIGNATURE = 0x06054B50;
+        constexpr uint16_t VERSION_NEEDED = 20;
+        constexpr uint16_t FLAG_UTF8_NAMES = 0x0800;
+        constexpr uint16_t METHOD_STORED = 0;
+        constexpr uint16_t DOS_TIME = 0;
+        constexpr uint16_t DOS_DATE = (1 << 5) | 1; // 1980-01-01
+        constexpr std::streamoff CRC_FIELD_OFFSET = 14;
+        constexpr std::size_t COPY_BLOCK_SIZE = 64 * 1024;
+
+        constexpr std::array<uint32_t, 256> makeCrcTable()
+        {
+            std::array<uint32_t, 256> table{};
+            for( uint32_t i = 0; i < table.size(); ++i )
+            {
+                uint32_t value = i;
+                for( int bit = 0; bit < 8; ++bit )
+                {
+                    value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+                }
+                table[i] = value;
+            }
+            return table;
+        }
+
+        constexpr std::array<uint32_t, 256> CRC_TABLE = makeCrcTable();
+
+        uint32_t updateCrc(uint32_t crc, const char* data, std::size_t size)
+        {
+            crc = ~crc;
+            for( std::size_t i = 0; i < size; ++i )
+            {
+                crc = CRC_TABLE[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+            }
+            return ~crc;
+        }
+
+        void write16(std::ostream& output, uint16_t value)
+        {
+            const char bytes[2] = { static_cast<char>(value), static_cast<char>(value >> 8) };
+            output.write(bytes, sizeof(bytes));
+        }
+
+        void write32(std::ostream& output, uint32_t value)
+        {
+            const char bytes[4] = { static_cast<char>(value), static_cast<char>(value >> 8), static_cast<char>(value >> 16), static_cast<char>(value >> 24) };
+            output.write(bytes, sizeof(bytes));
+        }
+    }
+
+    bool ZipWriter::open(const std::string& path)
+    {
+        m_entries.clear();
+        m_file.open(path, std::ios::binary | std::ios::trunc);
+        return m_file.is_open();
+    }
+
+    bool ZipWriter::addEntry(const std::string& name, std::string_view data)
+    {
+        return beginEntry(name) && writeData(data.data(), data.size()) && endEntry();
+    }
+
+    bool ZipWriter::addFile(const std::string& name, const std::string& sourcePath)
+    {
+        std::ifstream source(sourcePath, std::ios::binary);
+        if( !source || !beginEntry(name) )
+        {
+            return false;
+        }
+
+        std::vector<char> buffer(COPY_BLOCK_SIZE);
+        while( source )
+        {
+            source.read(buffer.data(), buffer.size());
+            if( !writeData(buffer.data(), static_cast<std::size_t>(source.gcount())) )
+            {
+                return false;
+            }
+        }
+        return !source.bad() && endEntry();
+    }
+
+    bool ZipWriter::close()
+    {
+        if( !m_file.is_open() )
+        {
+            return false;
+        }
+
+        const std::streamoff directoryOffset = m_file.tellp();
+        for( const auto& entry : m_entries )
+        {
+            write32(m_file, CENTRAL_HEADER_SIGNATURE);
+            write16(m_file, VERSION_NEEDED);
+            write16(m_file, VERSION_NEEDED);
+            write16(m_file, FLAG_UTF8_NAMES);
+            write16(m_file, METHOD_STORED);
+            write16(m_file, DOS_TIME);
+            write16(m_file, DOS_DATE);
+            write32(m_file, entry.crc);
+            write32(m_file, entry.size);
+            write32(m_file, entry.size);
+            write16(m_file, static_cast<uint16_t>(entry.name.size()));
+            write16(m_file, 0); // Extra field length
+            write16(m_file, 0); // Comment length
+            write16(m_file, 0); // Disk number
+            write16(m_file, 0); // Internal attributes
+            write32(m_file, 0); // External attributes
+            write32(m_file, entry.offset);
+            m_file.write(entry.name.data(), entry.name.size());
+        }
+        const std::streamoff directoryEnd = m_file.tellp();
+
+        write32(m_file, END_OF_DIRECTORY_SIGNATURE);
+        write16(m_file, 0); // Disk number
+        write16(m_file, 0); // Disk with the central directory
+        write16(m_file, static_cast<uint16_t>(m_entries.size()));
+        write16(m_file, static_cast<uint16_t>(m_entries.size()));
+        write32(m_file, static_cast<uint32_t>(directoryEnd - directoryOffset));
+        write32(m_file, static_cast<uint32_t>(directoryOffset));
+        write16(m_file, 0); // Comment length
+
+        const bool written = m_file.good() && directoryEnd <= std::numeric_limits<uint32_t>::max() && m_entries.size() <= std::numeric_limits<uint16_t>::max();
+        m_file.close();
+        return written;
+    }
+
+    bool ZipWriter::beginEntry(const std::string& name)
+    {
+        const std::streamoff offset = m_file.tellp();
+        if( !m_file.is_open() || offset < 0 || offset > std::numeric_limits<uint32_t>::max() || name.size() > std::numeric_limits<uint16_t>::max() )
+        {
+            return false;
+        }
+
+        Entry entry;
+        entry.name = name;
+        entry.offset = static_cast<uint32_t>(offset);
+        m_entries.push_back(entry);
+        m_entrySize = 0;
+
+        write32(m_file, LOCAL_HEADER_SIGNATURE);
+        write16(m_file, VERSION_NEEDED);
+        write16(m_file, FLAG_UTF8_NAMES);
+        write16(m_file, METHOD_STORED);
+        write16(m_file, DOS_TIME);
+        write16(m_file, DOS_DATE);
+        write32(m_file, 0); // CRC-32, patched by endEntry
+        write32(m_file, 0); // Compressed size
+        write32(m_file, 0); // Uncompressed size
+        write16(m_file, static_cast<uint16_t>(name.size()));
+        write16(m_file, 0); // Extra field length
+        m_file.write(name.data(), name.size());
+        return m_file.good();
+    }
+
+    bool ZipWriter::writeData(const char* data, std::size_t size)
+    {
+        m_entries.back().crc = updateCrc(m_entries.back().crc, data, size);
+        m_entrySize += size;
+        m_file.write(data, size);
+        return m_file.good() && m_entrySize <= std::numeric_limits<uint32_t>::max();
+    }
+
+    bool ZipWriter::endEntry()
+    {
+        Entry& entry = m_entries.back();
+        entry.size = static_cast<uint32_t>(m_entrySize);
+
+        const std::streamoff end = m_file.tellp();
+        m_file.seekp(entry.offset + CRC_FIELD_OFFSET);
+        write32(m_file, entry.crc);
+        write32(m_file, entry.size);
+        write32(m_file, entry.size);
+        m_file.seekp(end);
+        return m_file.good();
+    }
+}
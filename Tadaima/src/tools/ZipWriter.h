@@ -0,0 +1,92 @@
+/**
+ * @file ZipWriter.h
+ * @brief Declares the ZipWriter class which writes uncompressed zip archives.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tadaima
+{
+    /**
+     * @brief The ZipWriter class writes zip archives whose entries are stored without compression.
+     *
+     * Entry data is streamed to the archive as it is added; the checksum and sizes are patched into the local header
+     * once an entry is complete, so entries of any size up to 4 GiB are written with a small constant buffer.
+     * Zip64 is not supported. Entries carry a fixed timestamp so identical content gives identical archives.
+     */
+    class ZipWriter
+    {
+    public:
+        /**
+         * @brief Creates the archive, replacing an existing file.
+         * @param path Path of the archive.
+         * @return True if the file was created, false otherwise.
+         */
+        bool open(const std::string& path);
+
+        /**
+         * @brief Adds an entry with the given content.
+         * @param name Name of the entry inside the archive.
+         * @param data Content of the entry.
+         * @return True if the entry was written, false otherwise.
+         */
+        bool addEntry(const std::string& name, std::string_view data);
+
+        /**
+         * @brief Adds an entry with the content of a file, copying it in blocks.
+         * @param name Name of the entry inside the archive.
+         * @param sourcePath Path of the file to store.
+         * @return True if the entry was written, false otherwise.
+         */
+        bool addFile(const std::string& name, const std::string& sourcePath);
+
+        /**
+         * @brief Writes the central directory and closes the archive.
+         * @return True if the archive is complete, false otherwise.
+         */
+        bool close();
+
+    private:
+        /**
+         * @brief An entry already written to the archive.
+         */
+        struct Entry
+        {
+            std::string name;       /**< Name of the entry. */
+            uint32_t crc = 0;       /**< CRC-32 of the content. */
+            uint32_t size = 0;      /**< Size of the content in bytes. */
+            uint32_t offset = 0;    /**< Offset of the local header. */
+        };
+
+        /**
+         * @brief Writes the local header of a new entry with placeholder checksum and sizes.
+         * @param name Name of the entry.
+         * @return True if the header was written, false otherwise.
+         */
+        bool beginEntry(const std::string& name);
+
+        /**
+         * @brief Appends data to the current entry.
+         * @param data Pointer to the data.
+         * @param size Number of bytes.
+         * @return True if the data was written, false otherwise.
+         */
+        bool writeData(const char* data, std::size_t size);
+
+        /**
+         * @brief Patches the checksum and sizes of the current entry into its local header.
+         * @return True if the entry is complete, false otherwise.
+         */
+        bool endEntry();
+
+        std::ofstream m_file; /**< The archive being written. */
+        std::vector<Entry> m_entries; /**< Entries written so far, the last one may be incomplete. */
+        uint64_t m_entrySize = 0; /**< Number of bytes written to the current entry. */
+    };
+}